@@ -0,0 +1,298 @@
+// bdlb_loglinearhistogram.cpp                                        -*-C++-*-
+#include <bdlb_loglinearhistogram.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlb_loglinearhistogram_cpp,"$Id$ $CSID$")
+
+#include <bslim_printer.h>
+
+#include <bslma_default.h>
+
+#include <bsl_cstring.h>
+#include <bsl_ostream.h>
+
+namespace BloombergLP {
+namespace bdlb {
+
+                          // ------------------------
+                          // class LogLinearHistogram
+                          // ------------------------
+
+// PRIVATE MANIPULATORS
+void LogLinearHistogram::allocateCounts(int significantBits)
+{
+    const int numBuckets = numBucketsFor(significantBits);
+
+    Counter *counts = static_cast<Counter *>(
+                       d_allocator_p->allocate(numBuckets * sizeof(Counter)));
+    bsl::memset(counts, 0, numBuckets * sizeof(Counter));
+
+    if (d_counts_p) {
+        d_allocator_p->deallocate(d_counts_p);
+    }
+
+    d_significantBits = significantBits;
+    d_numBuckets      = numBuckets;
+    d_counts_p        = counts;
+}
+
+// PRIVATE ACCESSORS
+bsls::Types::Int64 LogLinearHistogram::highestValue(int index) const
+{
+    if (index < (1 << d_significantBits)) {
+        return index;                                                 // RETURN
+    }
+
+    const int shift = (index >> d_significantBits) - 1;
+
+    const bsls::Types::Uint64 width = static_cast<bsls::Types::Uint64>(1)
+                                                                     << shift;
+
+    return lowestValue(index) + static_cast<bsls::Types::Int64>(width - 1);
+}
+
+bsls::Types::Int64 LogLinearHistogram::lowestValue(int index) const
+{
+    const int numSubBuckets = 1 << d_significantBits;
+
+    if (index < numSubBuckets) {
+        return index;                                                 // RETURN
+    }
+
+    const int shift    = (index >> d_significantBits) - 1;
+    const int subIndex = index & (numSubBuckets - 1);
+
+    const bsls::Types::Uint64 mantissa =
+                   static_cast<bsls::Types::Uint64>(numSubBuckets + subIndex);
+
+    return static_cast<bsls::Types::Int64>(mantissa << shift);
+}
+
+// CREATORS
+LogLinearHistogram::LogLinearHistogram(bslma::Allocator *basicAllocator)
+: d_significantBits(0)
+, d_numBuckets(0)
+, d_counts_p(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    allocateCounts(k_DEFAULT_SIGNIFICANT_BITS);
+}
+
+LogLinearHistogram::LogLinearHistogram(int               significantBits,
+                                       bslma::Allocator *basicAllocator)
+: d_significantBits(0)
+, d_numBuckets(0)
+, d_counts_p(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(k_MIN_SIGNIFICANT_BITS <= significantBits);
+    BSLS_ASSERT(k_MAX_SIGNIFICANT_BITS >= significantBits);
+
+    allocateCounts(significantBits);
+}
+
+LogLinearHistogram::LogLinearHistogram(
+                                   const LogLinearHistogram&  original,
+                                   bslma::Allocator          *basicAllocator)
+: d_significantBits(0)
+, d_numBuckets(0)
+, d_counts_p(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    allocateCounts(original.d_significantBits);
+    add(original);
+}
+
+LogLinearHistogram::~LogLinearHistogram()
+{
+    d_allocator_p->deallocate(d_counts_p);
+}
+
+// MANIPULATORS
+LogLinearHistogram& LogLinearHistogram::operator=(
+                                                const LogLinearHistogram& rhs)
+{
+    if (this != &rhs) {
+        if (d_significantBits != rhs.d_significantBits) {
+            allocateCounts(rhs.d_significantBits);
+        }
+
+        for (int i = 0; i < d_numBuckets; ++i) {
+            bsls::AtomicOperations::setInt64Relaxed(&d_counts_p[i],
+                                                    rhs.bucketCount(i));
+        }
+    }
+    return *this;
+}
+
+void LogLinearHistogram::add(const LogLinearHistogram& other)
+{
+    BSLS_ASSERT(other.d_significantBits == d_significantBits);
+
+    for (int i = 0; i < d_numBuckets; ++i) {
+        const bsls::Types::Int64 count = other.bucketCount(i);
+        if (0 != count) {
+            bsls::AtomicOperations::addInt64Relaxed(&d_counts_p[i], count);
+        }
+    }
+}
+
+void LogLinearHistogram::reset()
+{
+    for (int i = 0; i < d_numBuckets; ++i) {
+        bsls::AtomicOperations::setInt64Relaxed(&d_counts_p[i], 0);
+    }
+}
+
+// ACCESSORS
+bsls::Types::Int64 LogLinearHistogram::count() const
+{
+    bsls::Types::Int64 result = 0;
+    for (int i = 0; i < d_numBuckets; ++i) {
+        result += bucketCount(i);
+    }
+    return result;
+}
+
+bsls::Types::Int64 LogLinearHistogram::maximum() const
+{
+    for (int i = d_numBuckets - 1; 0 <= i; --i) {
+        if (0 != bucketCount(i)) {
+            return highestValue(i);                                   // RETURN
+        }
+    }
+    return 0;
+}
+
+double LogLinearHistogram::mean() const
+{
+    bsls::Types::Int64 total = 0;
+    double             sum   = 0.0;
+
+    for (int i = 0; i < d_numBuckets; ++i) {
+        const bsls::Types::Int64 count = bucketCount(i);
+        if (0 != count) {
+            const double midpoint =
+                     (static_cast<double>(lowestValue(i)) +
+                      static_cast<double>(highestValue(i))) / 2.0;
+
+            total += count;
+            sum   += midpoint * static_cast<double>(count);
+        }
+    }
+    return 0 == total ? 0.0 : sum / static_cast<double>(total);
+}
+
+bsls::Types::Int64 LogLinearHistogram::minimum() const
+{
+    for (int i = 0; i < d_numBuckets; ++i) {
+        if (0 != bucketCount(i)) {
+            return lowestValue(i);                                    // RETURN
+        }
+    }
+    return 0;
+}
+
+bsls::Types::Int64 LogLinearHistogram::percentile(double percentile) const
+{
+    BSLS_ASSERT(0.0 <= percentile);
+    BSLS_ASSERT(100.0 >= percentile);
+
+    const bsls::Types::Int64 total = count();
+    if (0 == total) {
+        return 0;                                                     // RETURN
+    }
+
+    bsls::Types::Int64 rank = static_cast<bsls::Types::Int64>(
+                        percentile / 100.0 * static_cast<double>(total) + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+
+    // Values recorded concurrently may be counted below but not in 'total'
+    // (yielding the value at a slightly lower rank).  If the counts shrink
+    // concurrently (i.e., on 'reset'), return the highest non-empty bucket
+    // seen.
+
+    bsls::Types::Int64 cumulative = 0;
+    int                last       = 0;
+    for (int i = 0; i < d_numBuckets; ++i) {
+        const bsls::Types::Int64 count = bucketCount(i);
+        if (0 != count) {
+            cumulative += count;
+            last        = i;
+            if (rank <= cumulative) {
+                break;
+            }
+        }
+    }
+    return highestValue(last);
+}
+
+                                  // Aspects
+
+bsl::ostream& LogLinearHistogram::print(bsl::ostream& stream,
+                                        int           level,
+                                        int           spacesPerLevel) const
+{
+    if (stream.bad()) {
+        return stream;                                                // RETURN
+    }
+
+    bslim::Printer printer(&stream, level, spacesPerLevel);
+    printer.start();
+    printer.printAttribute("significantBits", d_significantBits);
+    printer.printAttribute("count",           count());
+    printer.printAttribute("minimum",         minimum());
+    printer.printAttribute("mean",            mean());
+    printer.printAttribute("p50",             percentile(50.0));
+    printer.printAttribute("p90",             percentile(90.0));
+    printer.printAttribute("p99",             percentile(99.0));
+    printer.printAttribute("p99.9",           percentile(99.9));
+    printer.printAttribute("maximum",         maximum());
+    printer.end();
+
+    return stream;
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+bool bdlb::operator==(const LogLinearHistogram& lhs,
+                      const LogLinearHistogram& rhs)
+{
+    if (lhs.d_significantBits != rhs.d_significantBits) {
+        return false;                                                 // RETURN
+    }
+
+    for (int i = 0; i < lhs.d_numBuckets; ++i) {
+        if (lhs.bucketCount(i) != rhs.bucketCount(i)) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+bsl::ostream& bdlb::operator<<(bsl::ostream&             stream,
+                               const LogLinearHistogram& object)
+{
+    return object.print(stream, 0, -1);
+}
+
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,613 @@
+// bdlb_loglinearhistogram.h                                          -*-C++-*-
+#ifndef INCLUDED_BDLB_LOGLINEARHISTOGRAM
+#define INCLUDED_BDLB_LOGLINEARHISTOGRAM
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a fixed-memory, mergeable histogram of integer values.
+//
+//@CLASSES:
+//  bdlb::LogLinearHistogram: log-linear histogram of non-negative values
+//
+//@SEE_ALSO: bsls_timeutil
+//
+//@DESCRIPTION: This component provides a class, 'bdlb::LogLinearHistogram',
+// that summarizes the distribution of a set of non-negative 64-bit integer
+// values (typically, latencies in nanoseconds) in a fixed amount of memory,
+// and reports its count, minimum, maximum, mean, and percentiles.  Recording a
+// value costs a single relaxed atomic increment, and is safe to perform from
+// several threads concurrently.  Histograms having the same precision can be
+// merged (e.g., per-thread histograms merged at report time), and streamed
+// using the 'bslx' protocol (e.g., to merge the histograms of several
+// processes).
+//
+///Buckets and Precision
+///---------------------
+// A histogram counts values in *buckets* whose width grows with the magnitude
+// of the values (as in the HdrHistogram scheme), so that each bucket covers
+// a bounded *relative* range of values.  The precision of a histogram is set
+// at construction by a number of *significant* *bits*, 'k': values less than
+// '2^k' each have their own bucket, and each range '[2^m, 2^(m+1))' (for
+// 'k <= m') is divided into '2^k' buckets of equal width '2^(m-k)'.
+// Therefore, every value reported by a histogram (its minimum, maximum, mean,
+// and percentiles) is within a relative error of '2^-k' of an actual value in
+// the histogram.  The histogram covers all non-negative 'bsls::Types::Int64'
+// values, and uses '(64 - k) * 2^k' counters, of 8 bytes each:
+//..
+//  +------------------+------------------+------------------+
+//  | significant bits | relative error   | memory           |
+//  +------------------+------------------+------------------+
+//  |         4        |   6.25%          |   7.5 KB         |
+//  |         6        |   1.56%          |  29.0 KB         |
+//  |         8        |   0.39%          | 112.0 KB         |
+//  |        10        |   0.10%          | 432.0 KB         |
+//  +------------------+------------------+------------------+
+//..
+// Values are reported as follows: 'minimum' returns the lowest value of the
+// lowest non-empty bucket, 'maximum' and 'percentile' return the highest value
+// of their bucket, and 'mean' weights the midpoint of each bucket by its
+// count.
+//
+///Thread Safety
+///-------------
+// 'record', 'recordMultiple', and 'add' (as a target) may be invoked
+// concurrently with each other and with the accessors of the same histogram.
+// An accessor invoked concurrently with recording reports the values recorded
+// up to some point during its execution (e.g., the count and a percentile
+// reported by distinct calls may reflect distinct sets of values).  All other
+// manipulators (and streaming in) require exclusive access to the histogram.
+//
+// Note that concurrent recording into the same histogram causes the cache line
+// holding a counter to move between cores.  Where recording is frequent,
+// per-thread histograms, merged with 'add' when reporting, scale better.
+//
+///BDEX Streaming
+///--------------
+// The version 1 BDEX format of a histogram is its number of significant bits,
+// followed by the number of its non-empty buckets, and the index and count of
+// each non-empty bucket, in increasing order of index, so that the size of a
+// streamed histogram is proportional to the number of distinct buckets used.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Reporting the Latency of a Service
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a service processes requests on two threads, and that we want
+// to report the distribution of the latency of the requests.
+//
+// First, each thread records the latency (in nanoseconds) of the requests it
+// processes in a histogram of its own, having 6 significant bits:
+//..
+//  bdlb::LogLinearHistogram thread1(6);
+//  bdlb::LogLinearHistogram thread2(6);
+//
+//  for (int i = 1; i <= 900; ++i) {
+//      thread1.record(10000 + i);          // about 10 microseconds
+//  }
+//  for (int i = 1; i <= 100; ++i) {
+//      thread2.record(1000000 + 10 * i);   // about 1 millisecond
+//  }
+//..
+// Then, at report time, we merge the histograms of the threads into a single
+// histogram:
+//..
+//  bdlb::LogLinearHistogram total(6);
+//  total.add(thread1);
+//  total.add(thread2);
+//
+//  assert(1000 == total.count());
+//..
+// Next, we query the distribution.  Each reported value is within 1/64 of an
+// actual latency:
+//..
+//  const bsls::Types::Int64 p50 = total.percentile(50.0);
+//  const bsls::Types::Int64 p99 = total.percentile(99.0);
+//
+//  assert(10000   <= p50 && p50 <= 10900 + 10900 / 64);
+//  assert(1000000 <= p99 && p99 <= 1001000 + 1001000 / 64);
+//  assert(10001 - 10001 / 64 <= total.minimum());
+//  assert(10001              >= total.minimum());
+//..
+// Finally, we ship the histogram to another process using BDEX streaming,
+// where it can be merged with the histograms of other processes:
+//..
+//  bslx::ByteOutStream out(20150101);
+//  total.bdexStreamOut(out, 1);
+//
+//  bdlb::LogLinearHistogram received;
+//  bslx::ByteInStream in(out.data(), out.length());
+//  received.bdexStreamIn(in, 1);
+//
+//  assert(in);
+//  assert(received == total);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLB_BITUTIL
+#include <bdlb_bitutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMICOPERATIONS
+#include <bsls_atomicoperations.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_IOSFWD
+#include <bsl_iosfwd.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlb {
+
+                          // ========================
+                          // class LogLinearHistogram
+                          // ========================
+
+class LogLinearHistogram {
+    // This class implements a histogram of non-negative 64-bit integer values,
+    // counted in log-linear buckets of bounded relative width, as described
+    // in the component-level documentation.  Values can be recorded
+    // concurrently from several threads.
+
+    // PRIVATE TYPES
+    typedef bsls::AtomicOperations::AtomicTypes::Int64 Counter;
+
+    // DATA
+    int               d_significantBits;  // number of significant bits of
+                                          // the bucketing
+
+    int               d_numBuckets;       // number of counters
+
+    Counter          *d_counts_p;         // count of each bucket (owned)
+
+    bslma::Allocator *d_allocator_p;      // memory allocator (held, not
+                                          // owned)
+
+    // FRIENDS
+    friend bool operator==(const LogLinearHistogram&,
+                           const LogLinearHistogram&);
+
+  private:
+    // PRIVATE CLASS METHODS
+    static int numBucketsFor(int significantBits);
+        // Return the number of buckets of a histogram having the specified
+        // 'significantBits'.
+
+    // PRIVATE MANIPULATORS
+    void allocateCounts(int significantBits);
+        // Allocate zeroed counters for the specified 'significantBits',
+        // releasing the current ones (if any).  If an exception is thrown,
+        // this object is unchanged.
+
+    // PRIVATE ACCESSORS
+    int bucketIndex(bsls::Types::Int64 value) const;
+        // Return the index of the bucket counting the specified 'value'.
+
+    bsls::Types::Int64 bucketCount(int index) const;
+        // Return the count of the bucket at the specified 'index'.
+
+    bsls::Types::Int64 highestValue(int index) const;
+        // Return the highest value counted by the bucket at the specified
+        // 'index'.
+
+    bsls::Types::Int64 lowestValue(int index) const;
+        // Return the lowest value counted by the bucket at the specified
+        // 'index'.
+
+  public:
+    // TYPES
+    enum {
+        k_MIN_SIGNIFICANT_BITS     = 1,   // minimum number of significant
+                                          // bits
+
+        k_MAX_SIGNIFICANT_BITS     = 10,  // maximum number of significant
+                                          // bits
+
+        k_DEFAULT_SIGNIFICANT_BITS = 6    // default number of significant
+                                          // bits
+    };
+
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(LogLinearHistogram,
+                                   bslma::UsesBslmaAllocator);
+
+    // CLASS METHODS
+    static int maxSupportedBdexVersion(int versionSelector);
+        // Return the maximum valid BDEX format version, as indicated by the
+        // specified 'versionSelector', to be passed to the 'bdexStreamOut'
+        // method.  Note that it is highly recommended that 'versionSelector'
+        // be formatted as "YYYYMMDD", a date representation.  Also note that
+        // 'versionSelector' should be a *compile*-time-chosen value that
+        // selects a format version supported by both externalizer and
+        // unexternalizer.  See the 'bslx' package-level documentation for more
+        // information on BDEX streaming of value-semantic types and
+        // containers.
+
+    // CREATORS
+    explicit
+    LogLinearHistogram(bslma::Allocator *basicAllocator = 0);
+    explicit
+    LogLinearHistogram(int               significantBits,
+                       bslma::Allocator *basicAllocator = 0);
+        // Create an empty histogram.  Optionally specify the number of
+        // 'significantBits' setting its precision (see {Buckets and
+        // Precision}).  If 'significantBits' is not specified,
+        // 'k_DEFAULT_SIGNIFICANT_BITS' is used.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless 'k_MIN_SIGNIFICANT_BITS <= significantBits' and
+        // 'significantBits <= k_MAX_SIGNIFICANT_BITS'.
+
+    LogLinearHistogram(const LogLinearHistogram&  original,
+                       bslma::Allocator          *basicAllocator = 0);
+        // Create a histogram having the same precision and counts as the
+        // specified 'original' histogram.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    ~LogLinearHistogram();
+        // Destroy this object.
+
+    // MANIPULATORS
+    LogLinearHistogram& operator=(const LogLinearHistogram& rhs);
+        // Assign to this object the precision and counts of the specified
+        // 'rhs' histogram, and return a reference providing modifiable access
+        // to this object.
+
+    void add(const LogLinearHistogram& other);
+        // Add the counts of the specified 'other' histogram to the counts of
+        // this histogram.  The behavior is undefined unless
+        // 'other.significantBits() == significantBits()'.
+
+    void record(bsls::Types::Int64 value);
+        // Record the specified 'value' in this histogram.  Negative values are
+        // recorded as 0.  Note that this method performs a single relaxed
+        // atomic increment.
+
+    void recordMultiple(bsls::Types::Int64 value, bsls::Types::Int64 count);
+        // Record the specified 'count' occurrences of the specified 'value' in
+        // this histogram.  Negative values are recorded as 0.  The behavior is
+        // undefined unless '0 <= count'.
+
+    void reset();
+        // Remove all values from this histogram.
+
+                                  // Aspects
+
+    template <class STREAM>
+    STREAM& bdexStreamIn(STREAM& stream, int version);
+        // Assign to this object the value read from the specified input
+        // 'stream' using the specified 'version' format, and return a
+        // reference to 'stream'.  If 'stream' is initially invalid, this
+        // operation has no effect.  If 'version' is not supported, this object
+        // is unaltered and 'stream' is invalidated, but otherwise unmodified.
+        // If 'version' is supported but 'stream' becomes invalid during this
+        // operation, this object is unaltered.  Note that no version is read
+        // from 'stream'.  See the 'bslx' package-level documentation for more
+        // information on BDEX streaming of value-semantic types and
+        // containers.
+
+    // ACCESSORS
+    bsls::Types::Int64 count() const;
+        // Return the number of values recorded in this histogram.
+
+    bsls::Types::Int64 maximum() const;
+        // Return the highest value of the highest non-empty bucket of this
+        // histogram, or 0 if this histogram is empty.
+
+    double mean() const;
+        // Return the mean of the values recorded in this histogram, with each
+        // value approximated by the midpoint of its bucket, or 0 if this
+        // histogram is empty.
+
+    bsls::Types::Int64 minimum() const;
+        // Return the lowest value of the lowest non-empty bucket of this
+        // histogram, or 0 if this histogram is empty.
+
+    bsls::Types::Int64 percentile(double percentile) const;
+        // Return the highest value of the bucket holding the value at the
+        // specified 'percentile' of the values recorded in this histogram
+        // (i.e., the value at rank 'percentile / 100 * count()', rounded to
+        // the nearest integer, and at least 1), or 0 if this histogram is
+        // empty.  The behavior is undefined unless
+        // '0.0 <= percentile <= 100.0'.
+
+    int significantBits() const;
+        // Return the number of significant bits setting the precision of this
+        // histogram.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this object to supply memory.
+
+    template <class STREAM>
+    STREAM& bdexStreamOut(STREAM& stream, int version) const;
+        // Write the value of this object, using the specified 'version'
+        // format, to the specified output 'stream', and return a reference to
+        // 'stream'.  If 'stream' is initially invalid, this operation has no
+        // effect.  If 'version' is not supported, 'stream' is invalidated, but
+        // otherwise unmodified.  Note that 'version' is not written to
+        // 'stream'.  See the 'bslx' package-level documentation for more
+        // information on BDEX streaming of value-semantic types and
+        // containers.
+
+    bsl::ostream& print(bsl::ostream& stream,
+                        int           level          = 0,
+                        int           spacesPerLevel = 4) const;
+        // Write a summary of this histogram (its count, minimum, mean,
+        // maximum, and common percentiles) to the specified output 'stream'
+        // in a human-readable format, and return a reference to 'stream'.
+        // Optionally specify an initial indentation 'level', whose absolute
+        // value is incremented recursively for nested objects.  If 'level' is
+        // specified, optionally specify 'spacesPerLevel', whose absolute value
+        // indicates the number of spaces per indentation level for this and
+        // all of its nested objects.  If 'level' is negative, suppress
+        // indentation of the first line.  If 'spacesPerLevel' is negative,
+        // format the entire output on one line, suppressing all but the
+        // initial indentation (as governed by 'level').  If 'stream' is not
+        // valid on entry, this operation has no effect.  Note that the format
+        // is not fully specified, and can change without notice.
+};
+
+// FREE OPERATORS
+bool operator==(const LogLinearHistogram& lhs, const LogLinearHistogram& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' histograms have the same
+    // value, and 'false' otherwise.  Two histograms have the same value if
+    // they have the same number of significant bits, and the same count in
+    // each bucket.
+
+bool operator!=(const LogLinearHistogram& lhs, const LogLinearHistogram& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' histograms do not have
+    // the same value, and 'false' otherwise.  Two histograms do not have the
+    // same value if they have a different number of significant bits, or a
+    // different count in any bucket.
+
+bsl::ostream& operator<<(bsl::ostream&             stream,
+                         const LogLinearHistogram& object);
+    // Write a summary of the specified 'object' to the specified output
+    // 'stream' in a single-line format, and return a reference providing
+    // modifiable access to 'stream'.  If 'stream' is not valid on entry, this
+    // operation has no effect.  Note that this human-readable format is not
+    // fully specified and can change without notice.  Also note that this
+    // method has the same behavior as 'object.print(stream, 0, -1)'.
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                          // ------------------------
+                          // class LogLinearHistogram
+                          // ------------------------
+
+// PRIVATE CLASS METHODS
+inline
+int LogLinearHistogram::numBucketsFor(int significantBits)
+{
+    return (64 - significantBits) << significantBits;
+}
+
+// PRIVATE ACCESSORS
+inline
+int LogLinearHistogram::bucketIndex(bsls::Types::Int64 value) const
+{
+    const bsls::Types::Uint64 v = value > 0
+                                  ? static_cast<bsls::Types::Uint64>(value)
+                                  : 0;
+    const bsls::Types::Uint64 numSubBuckets =
+                      static_cast<bsls::Types::Uint64>(1) << d_significantBits;
+
+    if (v < numSubBuckets) {
+        return static_cast<int>(v);                                   // RETURN
+    }
+
+    // 'v' is in '[2^m, 2^(m+1))', with 'd_significantBits <= m', divided into
+    // 'numSubBuckets' buckets of width '2^shift'.
+
+    const int m     = 63 - BitUtil::numLeadingUnsetBits(
+                                                   static_cast<uint64_t>(v));
+    const int shift = m - d_significantBits;
+
+    return ((shift + 1) << d_significantBits)
+         + static_cast<int>((v >> shift) - numSubBuckets);
+}
+
+inline
+bsls::Types::Int64 LogLinearHistogram::bucketCount(int index) const
+{
+    return bsls::AtomicOperations::getInt64Relaxed(&d_counts_p[index]);
+}
+
+// CLASS METHODS
+inline
+int LogLinearHistogram::maxSupportedBdexVersion(int /* versionSelector */)
+{
+    return 1;
+}
+
+// MANIPULATORS
+inline
+void LogLinearHistogram::record(bsls::Types::Int64 value)
+{
+    bsls::AtomicOperations::addInt64Relaxed(&d_counts_p[bucketIndex(value)],
+                                            1);
+}
+
+inline
+void LogLinearHistogram::recordMultiple(bsls::Types::Int64 value,
+                                        bsls::Types::Int64 count)
+{
+    BSLS_ASSERT_SAFE(0 <= count);
+
+    bsls::AtomicOperations::addInt64Relaxed(&d_counts_p[bucketIndex(value)],
+                                            count);
+}
+
+                                  // Aspects
+
+template <class STREAM>
+STREAM& LogLinearHistogram::bdexStreamIn(STREAM& stream, int version)
+{
+    if (stream) {
+        switch (version) { // switch on the schema version
+          case 1: {
+            char significantBits;
+            stream.getInt8(significantBits);
+
+            if (!stream
+             || k_MIN_SIGNIFICANT_BITS > significantBits
+             || k_MAX_SIGNIFICANT_BITS < significantBits) {
+                stream.invalidate();
+                return stream;                                        // RETURN
+            }
+
+            int numNonEmptyBuckets;
+            stream.getLength(numNonEmptyBuckets);
+
+            if (!stream
+             || numBucketsFor(significantBits) < numNonEmptyBuckets) {
+                stream.invalidate();
+                return stream;                                        // RETURN
+            }
+
+            LogLinearHistogram value(significantBits, d_allocator_p);
+
+            int previousIndex = -1;
+            for (int i = 0; i < numNonEmptyBuckets; ++i) {
+                int                index;
+                bsls::Types::Int64 count;
+
+                stream.getInt32(index);
+                stream.getInt64(count);
+
+                if (!stream
+                 || index <= previousIndex
+                 || value.d_numBuckets <= index
+                 || 0 >= count) {
+                    stream.invalidate();
+                    return stream;                                    // RETURN
+                }
+
+                bsls::AtomicOperations::setInt64Relaxed(
+                                                     &value.d_counts_p[index],
+                                                     count);
+                previousIndex = index;
+            }
+
+            *this = value;
+          } break;
+          default: {
+            stream.invalidate();  // unrecognized version number
+          }
+        }
+    }
+    return stream;
+}
+
+// ACCESSORS
+inline
+int LogLinearHistogram::significantBits() const
+{
+    return d_significantBits;
+}
+
+                                  // Aspects
+
+inline
+bslma::Allocator *LogLinearHistogram::allocator() const
+{
+    return d_allocator_p;
+}
+
+template <class STREAM>
+STREAM& LogLinearHistogram::bdexStreamOut(STREAM& stream, int version) const
+{
+    if (stream) {
+        switch (version) { // switch on the schema version
+          case 1: {
+            // Take a snapshot of the counts, as values may be recorded
+            // concurrently.
+
+            int numNonEmptyBuckets = 0;
+            for (int i = 0; i < d_numBuckets; ++i) {
+                if (0 != bucketCount(i)) {
+                    ++numNonEmptyBuckets;
+                }
+            }
+
+            stream.putInt8(d_significantBits);
+            stream.putLength(numNonEmptyBuckets);
+
+            for (int i = 0; i < d_numBuckets && 0 < numNonEmptyBuckets; ++i) {
+                const bsls::Types::Int64 count = bucketCount(i);
+                if (0 != count) {
+                    stream.putInt32(i);
+                    stream.putInt64(count);
+                    --numNonEmptyBuckets;
+                }
+            }
+          } break;
+          default: {
+            stream.invalidate();  // unrecognized version number
+          }
+        }
+    }
+    return stream;
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+inline
+bool bdlb::operator!=(const LogLinearHistogram& lhs,
+                      const LogLinearHistogram& rhs)
+{
+    return !(lhs == rhs);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
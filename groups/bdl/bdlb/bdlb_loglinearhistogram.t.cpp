@@ -0,0 +1,1263 @@
+// bdlb_loglinearhistogram.t.cpp                                      -*-C++-*-
+#include <bdlb_loglinearhistogram.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bslx_byteinstream.h>
+#include <bslx_byteoutstream.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                TEST PLAN
+// ----------------------------------------------------------------------------
+//                                 Overview
+//                                 --------
+// 'bdlb::LogLinearHistogram' is a value-semantic mechanism counting values in
+// buckets.  We first verify that each value is counted in a bucket whose
+// bounds contain it, and whose width is bounded relative to the value, for
+// small values, values near powers of two, and the extremes of the range.
+// We then verify the statistics computed from the counts, the copy,
+// assignment, merge, and comparison of histograms, and their BDEX streaming,
+// including the rejection of invalid input.  Finally, we verify that values
+// can be recorded concurrently without being lost.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 6] static int maxSupportedBdexVersion(int versionSelector);
+//
+// CREATORS
+// [ 2] LogLinearHistogram(bslma::Allocator *ba = 0);
+// [ 2] LogLinearHistogram(int significantBits, bslma::Allocator *ba = 0);
+// [ 5] LogLinearHistogram(const LogLinearHistogram& o, *ba = 0);
+// [ 2] ~LogLinearHistogram();
+//
+// MANIPULATORS
+// [ 5] LogLinearHistogram& operator=(const LogLinearHistogram& rhs);
+// [ 5] void add(const LogLinearHistogram& other);
+// [ 3] void record(bsls::Types::Int64 value);
+// [ 4] void recordMultiple(bsls::Types::Int64 value, Int64 count);
+// [ 4] void reset();
+// [ 6] STREAM& bdexStreamIn(STREAM& stream, int version);
+//
+// ACCESSORS
+// [ 4] bsls::Types::Int64 count() const;
+// [ 3] bsls::Types::Int64 maximum() const;
+// [ 4] double mean() const;
+// [ 3] bsls::Types::Int64 minimum() const;
+// [ 4] bsls::Types::Int64 percentile(double percentile) const;
+// [ 2] int significantBits() const;
+// [ 2] bslma::Allocator *allocator() const;
+// [ 6] STREAM& bdexStreamOut(STREAM& stream, int version) const;
+// [ 5] ostream& print(ostream& s, int level = 0, int sPL = 4) const;
+//
+// FREE OPERATORS
+// [ 5] bool operator==(const LogLinearHistogram&, const LLH&);
+// [ 5] bool operator!=(const LogLinearHistogram&, const LLH&);
+// [ 5] ostream& operator<<(ostream&, const LogLinearHistogram&);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 8] USAGE EXAMPLE
+// [ 7] CONCERN: Values can be recorded concurrently.
+// [ *] CONCERN: In no case does memory come from the global allocator.
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL VARIABLES / TYPEDEFS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlb::LogLinearHistogram Obj;
+typedef bsls::Types::Int64       Int64;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+const Int64 k_MAX_INT64 = ~(static_cast<bsls::Types::Uint64>(1) << 63);
+
+// ============================================================================
+//                   HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+bool isBracketed(Int64 value, int significantBits)
+    // Return 'true' if a histogram having the specified 'significantBits' and
+    // holding only the specified 'value' reports a minimum and maximum
+    // bracketing 'value' within the documented relative error, and 'false'
+    // otherwise.
+{
+    Obj mX(significantBits);  const Obj& X = mX;
+    mX.record(value);
+
+    const Int64 lo = X.minimum();
+    const Int64 hi = X.maximum();
+
+    if (lo > value || hi < value) {
+        return false;                                                 // RETURN
+    }
+
+    // The width of the bucket, 'hi - lo + 1', is at most 'value / 2^k' (and
+    // is 1 for values below '2^k').
+
+    const Int64 width = hi - lo + 1;
+    return width == 1 || width <= (value >> significantBits);
+}
+
+struct RecordArgs {
+    // This 'struct' holds the arguments of 'recordThread'.
+
+    Obj *d_histogram_p;  // histogram to record into
+    int  d_numValues;    // number of values to record
+};
+
+extern "C"
+void *recordThread(void *arg)
+    // Record the values '0 .. d_numValues - 1' into the histogram described by
+    // the specified 'arg' (a 'RecordArgs' object).
+{
+    RecordArgs *args = static_cast<RecordArgs *>(arg);
+
+    for (int i = 0; i < args->d_numValues; ++i) {
+        args->d_histogram_p->record(i);
+    }
+    return 0;
+}
+
+// ============================================================================
+//                              MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da(veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Reporting the Latency of a Service
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a service processes requests on two threads, and that we want
+// to report the distribution of the latency of the requests.
+//
+// First, each thread records the latency (in nanoseconds) of the requests it
+// processes in a histogram of its own, having 6 significant bits:
+//..
+    bdlb::LogLinearHistogram thread1(6);
+    bdlb::LogLinearHistogram thread2(6);
+
+    for (int i = 1; i <= 900; ++i) {
+        thread1.record(10000 + i);          // about 10 microseconds
+    }
+    for (int i = 1; i <= 100; ++i) {
+        thread2.record(1000000 + 10 * i);   // about 1 millisecond
+    }
+//..
+// Then, at report time, we merge the histograms of the threads into a single
+// histogram:
+//..
+    bdlb::LogLinearHistogram total(6);
+    total.add(thread1);
+    total.add(thread2);
+
+    ASSERT(1000 == total.count());
+//..
+// Next, we query the distribution.  Each reported value is within 1/64 of an
+// actual latency:
+//..
+    const bsls::Types::Int64 p50 = total.percentile(50.0);
+    const bsls::Types::Int64 p99 = total.percentile(99.0);
+
+    ASSERT(10000   <= p50 && p50 <= 10900 + 10900 / 64);
+    ASSERT(1000000 <= p99 && p99 <= 1001000 + 1001000 / 64);
+    ASSERT(10001 - 10001 / 64 <= total.minimum());
+    ASSERT(10001              >= total.minimum());
+//..
+// Finally, we ship the histogram to another process using BDEX streaming,
+// where it can be merged with the histograms of other processes:
+//..
+    bslx::ByteOutStream out(20150101);
+    total.bdexStreamOut(out, 1);
+
+    bdlb::LogLinearHistogram received;
+    bslx::ByteInStream in(out.data(), out.length());
+    received.bdexStreamIn(in, 1);
+
+    ASSERT(in);
+    ASSERT(received == total);
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCURRENT RECORDING
+        //
+        // Concerns:
+        //: 1 Values recorded concurrently into the same histogram, including
+        //:   into the same bucket, are all counted.
+        //:
+        //: 2 Accessors can be invoked while values are recorded.
+        //
+        // Plan:
+        //: 1 Record the same values from several threads into one histogram,
+        //:   while querying its count from the main thread.  Verify that the
+        //:   count observed never decreases, and that the final histogram
+        //:   equals a histogram in which the values were recorded
+        //:   sequentially, once per thread.  (C-1..2)
+        //
+        // Testing:
+        //   CONCERN: Values can be recorded concurrently.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT RECORDING" << endl
+                          << "====================" << endl;
+
+        enum { k_NUM_THREADS = 4, k_NUM_VALUES = 100000 };
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        Obj mX(&ta);  const Obj& X = mX;
+
+        RecordArgs args = { &mX, k_NUM_VALUES };
+
+        ThreadId threads[k_NUM_THREADS];
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            threads[i] = createThread(&recordThread, &args);
+        }
+
+        Int64 previous = 0;
+        for (int i = 0; i < 100; ++i) {
+            const Int64 count = X.count();
+            ASSERTV(previous, count, previous <= count);
+            previous = count;
+
+            const Int64 p99 = X.percentile(99.0);
+            ASSERTV(p99, 0 <= p99 && p99 < k_NUM_VALUES + k_NUM_VALUES / 64);
+        }
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            joinThread(threads[i]);
+        }
+
+        Obj mY(&ta);  const Obj& Y = mY;
+        for (int t = 0; t < k_NUM_THREADS; ++t) {
+            for (int i = 0; i < k_NUM_VALUES; ++i) {
+                mY.record(i);
+            }
+        }
+
+        ASSERTV(X.count(), k_NUM_THREADS * k_NUM_VALUES == X.count());
+        ASSERT(Y == X);
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // BDEX STREAMING
+        //
+        // Concerns:
+        //: 1 A histogram streamed out and back in has the same value,
+        //:   whatever the number of significant bits of the target.
+        //:
+        //: 2 The size of the streamed histogram depends on its number of
+        //:   non-empty buckets.
+        //:
+        //: 3 Streaming in from an invalid stream, or with an unsupported
+        //:   version, has no effect on the target.
+        //:
+        //: 4 Invalid or truncated input invalidates the stream and leaves the
+        //:   target unchanged.
+        //:
+        //: 5 Streaming out with an unsupported version invalidates the
+        //:   stream.
+        //
+        // Plan:
+        //: 1 Stream out and back in histograms of various contents and
+        //:   precisions, into targets of another precision.  (C-1)
+        //:
+        //: 2 Compare the length of the streams of histograms having one and
+        //:   two non-empty buckets.  (C-2)
+        //:
+        //: 3 Stream in with version 2, and from an invalidated stream.  (C-3)
+        //:
+        //: 4 Build streams by hand having an invalid precision, too many
+        //:   buckets, out-of-order or out-of-range indices, or non-positive
+        //:   counts, and stream in every truncation of a valid stream.  (C-4)
+        //:
+        //: 5 Stream out with version 0 and 2.  (C-5)
+        //
+        // Testing:
+        //   static int maxSupportedBdexVersion(int versionSelector);
+        //   STREAM& bdexStreamIn(STREAM& stream, int version);
+        //   STREAM& bdexStreamOut(STREAM& stream, int version) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BDEX STREAMING" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        ASSERT(1 == Obj::maxSupportedBdexVersion(0));
+        ASSERT(1 == Obj::maxSupportedBdexVersion(20150101));
+
+        if (verbose) cout << "\tRound trip." << endl;
+        {
+            static const struct {
+                int d_line;
+                int d_significantBits;
+                int d_numValues;
+            } DATA[] = {
+                //LINE  BITS  NUM
+                //----  ----  -----
+                { L_,     1,      0 },
+                { L_,     1,    100 },
+                { L_,     6,      0 },
+                { L_,     6,      1 },
+                { L_,     6,  10000 },
+                { L_,    10,  10000 },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int LINE = DATA[ti].d_line;
+                const int BITS = DATA[ti].d_significantBits;
+                const int NUM  = DATA[ti].d_numValues;
+
+                Obj mX(BITS, &ta);  const Obj& X = mX;
+                for (int i = 0; i < NUM; ++i) {
+                    mX.record(static_cast<Int64>(i) * i * 1237);
+                }
+                mX.record(k_MAX_INT64);
+
+                bslx::ByteOutStream out(20150101, &ta);
+                ASSERTV(LINE, &out == &X.bdexStreamOut(out, 1));
+                ASSERTV(LINE, out);
+
+                Obj mY(BITS == 6 ? 4 : 6, &ta);  const Obj& Y = mY;
+                mY.record(3);
+
+                bslx::ByteInStream in(out.data(), out.length());
+                ASSERTV(LINE, &in == &mY.bdexStreamIn(in, 1));
+                ASSERTV(LINE, in);
+                ASSERTV(LINE, in.isEmpty());
+                ASSERTV(LINE, X == Y);
+                ASSERTV(LINE, BITS == Y.significantBits());
+            }
+        }
+
+        if (verbose) cout << "\tStream size." << endl;
+        {
+            Obj mX(&ta);
+            mX.recordMultiple(5, 1000000);
+
+            bslx::ByteOutStream out1(20150101, &ta);
+            mX.bdexStreamOut(out1, 1);
+
+            mX.record(1000000);
+
+            bslx::ByteOutStream out2(20150101, &ta);
+            mX.bdexStreamOut(out2, 1);
+
+            // precision, length, and one index and count per bucket
+
+            ASSERTV(out1.length(), 1 + 1 + 12     == out1.length());
+            ASSERTV(out2.length(), 1 + 1 + 12 * 2 == out2.length());
+        }
+
+        if (verbose) cout << "\tUnsupported version or invalid stream."
+                          << endl;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+            mX.record(17);
+
+            Obj mY(4, &ta);  const Obj& Y = mY;
+            mY.record(3);
+
+            const Obj Z(Y, &ta);
+
+            bslx::ByteOutStream out(20150101, &ta);
+            X.bdexStreamOut(out, 1);
+
+            {
+                bslx::ByteInStream in(out.data(), out.length());
+                mY.bdexStreamIn(in, 2);
+                ASSERT(!in);
+                ASSERT(Z == Y);
+            }
+            {
+                bslx::ByteInStream in(out.data(), out.length());
+                in.invalidate();
+                mY.bdexStreamIn(in, 1);
+                ASSERT(!in);
+                ASSERT(Z == Y);
+            }
+            {
+                bslx::ByteOutStream out0(20150101, &ta);
+                X.bdexStreamOut(out0, 0);
+                ASSERT(!out0);
+
+                bslx::ByteOutStream out2(20150101, &ta);
+                X.bdexStreamOut(out2, 2);
+                ASSERT(!out2);
+                ASSERT(0 == out2.length());
+            }
+        }
+
+        if (verbose) cout << "\tInvalid input." << endl;
+        {
+            static const struct {
+                int   d_line;
+                int   d_significantBits;
+                int   d_length;
+                int   d_index1;
+                Int64 d_count1;
+                int   d_index2;
+                Int64 d_count2;
+                bool  d_isValid;
+            } DATA[] = {
+                //LINE  BITS  LEN  IDX1  CNT1  IDX2  CNT2  VALID
+                //----  ----  ---  ----  ----  ----  ----  -----
+                { L_,     6,   2,    3,    1,    5,    2,  true  },
+                { L_,     1,   2,    3,    1,   125,   2,  true  },
+                { L_,     0,   2,    3,    1,    5,    2,  false },
+                { L_,    11,   2,    3,    1,    5,    2,  false },
+                { L_,    -1,   2,    3,    1,    5,    2,  false },
+                { L_,     1, 127,    3,    1,    5,    2,  false },
+                { L_,     6,   2,    5,    1,    3,    2,  false },
+                { L_,     6,   2,    5,    1,    5,    2,  false },
+                { L_,     6,   2,   -1,    1,    5,    2,  false },
+                { L_,     1,   2,    3,    1,   126,    2,  false },
+                { L_,     6,   2,    3,    0,    5,    2,  false },
+                { L_,     6,   2,    3,    1,    5,   -2,  false },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int   LINE  = DATA[ti].d_line;
+                const int   BITS  = DATA[ti].d_significantBits;
+                const int   LEN   = DATA[ti].d_length;
+                const int   IDX1  = DATA[ti].d_index1;
+                const Int64 CNT1  = DATA[ti].d_count1;
+                const int   IDX2  = DATA[ti].d_index2;
+                const Int64 CNT2  = DATA[ti].d_count2;
+                const bool  VALID = DATA[ti].d_isValid;
+
+                bslx::ByteOutStream out(20150101, &ta);
+                out.putInt8(BITS);
+                out.putLength(LEN);
+                out.putInt32(IDX1);
+                out.putInt64(CNT1);
+                out.putInt32(IDX2);
+                out.putInt64(CNT2);
+
+                Obj mY(&ta);  const Obj& Y = mY;
+                mY.record(1);
+
+                const Obj Z(Y, &ta);
+
+                bslx::ByteInStream in(out.data(), out.length());
+                mY.bdexStreamIn(in, 1);
+
+                ASSERTV(LINE, VALID == !!in);
+                if (VALID) {
+                    ASSERTV(LINE, BITS == Y.significantBits());
+                    ASSERTV(LINE, CNT1 + CNT2 == Y.count());
+                }
+                else {
+                    ASSERTV(LINE, Z == Y);
+                }
+            }
+
+            // Every truncation of a valid stream is rejected.
+
+            Obj mX(&ta);  const Obj& X = mX;
+            mX.record(1);
+            mX.record(1000);
+            mX.record(k_MAX_INT64);
+
+            bslx::ByteOutStream out(20150101, &ta);
+            X.bdexStreamOut(out, 1);
+
+            for (int len = 0; len < out.length(); ++len) {
+                Obj mY(4, &ta);  const Obj& Y = mY;
+                mY.record(3);
+
+                const Obj Z(Y, &ta);
+
+                bslx::ByteInStream in(out.data(), len);
+                mY.bdexStreamIn(in, 1);
+
+                ASSERTV(len, !in);
+                ASSERTV(len, Z == Y);
+            }
+        }
+
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // COPY, ASSIGNMENT, MERGE, COMPARISON, AND PRINT
+        //
+        // Concerns:
+        //: 1 A copy has the value of the original, and uses the allocator
+        //:   supplied at construction (or the default allocator).
+        //:
+        //: 2 Assignment copies the precision and the counts of the source,
+        //:   and self-assignment has no effect.
+        //:
+        //: 3 'add' adds the counts of the source to the target, including
+        //:   when the source is the target.
+        //:
+        //: 4 Histograms compare equal if and only if they have the same
+        //:   precision and counts.
+        //:
+        //: 5 'add' with a source of another precision is detected in
+        //:   appropriate build modes.
+        //:
+        //: 6 'print' and 'operator<<' report the statistics of the histogram.
+        //
+        // Plan:
+        //: 1 Copy, assign, and merge histograms of various precisions and
+        //:   contents, and verify the results using the comparison operators
+        //:   and the accessors.  (C-1..4)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered.  (C-5)
+        //:
+        //: 3 Print a histogram on one line and on several lines.  (C-6)
+        //
+        // Testing:
+        //   LogLinearHistogram(const LogLinearHistogram& o, *ba = 0);
+        //   LogLinearHistogram& operator=(const LogLinearHistogram& rhs);
+        //   void add(const LogLinearHistogram& other);
+        //   bool operator==(const LogLinearHistogram&, const LLH&);
+        //   bool operator!=(const LogLinearHistogram&, const LLH&);
+        //   ostream& print(ostream& s, int level = 0, int sPL = 4) const;
+        //   ostream& operator<<(ostream&, const LogLinearHistogram&);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "COPY, ASSIGNMENT, MERGE, COMPARISON, AND PRINT"
+                          << endl
+                          << "=============================================="
+                          << endl;
+
+        bslma::TestAllocator da(veryVeryVerbose);
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        if (verbose) cout << "\tComparison." << endl;
+        {
+            Obj mX(6, &ta);  const Obj& X = mX;
+            Obj mY(6, &ta);  const Obj& Y = mY;
+            Obj mZ(5, &ta);  const Obj& Z = mZ;
+
+            ASSERT(X == Y);   ASSERT(!(X != Y));
+            ASSERT(X != Z);   ASSERT(!(X == Z));
+
+            mX.record(1000);
+            ASSERT(X != Y);
+
+            mY.record(1001);     // same bucket with 6 significant bits
+            ASSERT(X == Y);
+
+            mY.record(5000);
+            ASSERT(X != Y);
+
+            mX.record(5000);
+            ASSERT(X == Y);
+            ASSERT(X == X);
+        }
+
+        if (verbose) cout << "\tCopy construction." << endl;
+        {
+            Obj mX(3, &ta);  const Obj& X = mX;
+            mX.record(7);
+            mX.record(123456);
+
+            const Int64 NUM_DEFAULT = da.numBlocksTotal();
+            const Obj   Y(X);
+
+            ASSERT(X == Y);
+            ASSERT(&da == Y.allocator());
+            ASSERT(NUM_DEFAULT + 1 == da.numBlocksTotal());
+
+            const Obj Z(X, &ta);
+            ASSERT(X == Z);
+            ASSERT(&ta == Z.allocator());
+            ASSERT(NUM_DEFAULT + 1 == da.numBlocksTotal());
+
+            mX.record(8);
+            ASSERT(X != Y);
+            ASSERT(2 == Y.count());
+        }
+        ASSERT(0 == da.numBlocksInUse());
+
+        if (verbose) cout << "\tAssignment." << endl;
+        {
+            const int MIN_BITS = Obj::k_MIN_SIGNIFICANT_BITS;
+            const int MAX_BITS = Obj::k_MAX_SIGNIFICANT_BITS;
+
+            for (int i = MIN_BITS; i <= MAX_BITS; ++i) {
+                for (int j = MIN_BITS; j <= MAX_BITS; ++j) {
+                    Obj mX(i, &ta);  const Obj& X = mX;
+                    Obj mY(j, &ta);  const Obj& Y = mY;
+
+                    mX.record(i * 1000);
+                    mY.record(j);
+                    mY.record(j * 7777);
+
+                    const Obj Z(Y, &ta);
+
+                    ASSERTV(i, j, &mX == &(mX = Y));
+                    ASSERTV(i, j, Z == X);
+                    ASSERTV(i, j, j == X.significantBits());
+                    ASSERTV(i, j, 2 == X.count());
+
+                    mX = X;
+                    ASSERTV(i, j, Z == X);
+                }
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\tMerge." << endl;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+            Obj mY(&ta);  const Obj& Y = mY;
+
+            mX.record(1);
+            mX.record(2000);
+            mY.record(2000);
+            mY.record(k_MAX_INT64);
+
+            mX.add(Y);
+            ASSERT(4 == X.count());
+            ASSERT(1 == X.minimum());
+            ASSERT(k_MAX_INT64 == X.maximum());
+            ASSERT(2 == Y.count());
+
+            Obj mE(&ta);
+            mE.record(1);
+            mE.recordMultiple(2000, 2);
+            mE.record(k_MAX_INT64);
+            ASSERT(mE == X);
+
+            mX.add(X);
+            ASSERT(8 == X.count());
+
+            mE.add(mE);
+            ASSERT(mE == X);
+        }
+
+        if (verbose) cout << "\tPrint." << endl;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+            mX.record(10);
+            mX.record(20);
+
+            bsl::ostringstream oss(&ta);
+            oss << X;
+
+            const bsl::string EXP =
+                "[ significantBits = 6 count = 2 minimum = 10 mean = 15"
+                " p50 = 10 p90 = 20 p99 = 20 p99.9 = 20 maximum = 20 ]";
+            ASSERTV(oss.str(), EXP == oss.str());
+
+            bsl::ostringstream oss2(&ta);
+            X.print(oss2, 1, 2);
+            ASSERTV(oss2.str(), bsl::string::npos != oss2.str().find(
+                                                         "\n    count = 2\n"));
+            ASSERTV(oss2.str(), 0 == oss2.str().find("  [\n"));
+        }
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(6, &ta);
+            const Obj Y(6, &ta);
+            const Obj Z(5, &ta);
+
+            ASSERT_PASS(mX.add(Y));
+            ASSERT_FAIL(mX.add(Z));
+        }
+
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // STATISTICS
+        //
+        // Concerns:
+        //: 1 'count' returns the number of values recorded.
+        //:
+        //: 2 'percentile' returns the upper bound of the bucket holding the
+        //:   value at the nearest rank, with a minimum rank of 1.
+        //:
+        //: 3 'mean' weights the midpoint of each bucket by its count.
+        //:
+        //: 4 'recordMultiple' is equivalent to repeated calls to 'record'.
+        //:
+        //: 5 'reset' removes all values.
+        //:
+        //: 6 An empty histogram reports 0 for every statistic.
+        //:
+        //: 7 Percentiles out of '[0, 100]' are detected in appropriate build
+        //:   modes.
+        //
+        // Plan:
+        //: 1 Record values having their own bucket, and verify the
+        //:   statistics against values computed by hand.  (C-1..3, 6)
+        //:
+        //: 2 Record values with 'record' and 'recordMultiple' into two
+        //:   histograms, and compare them.  (C-4)
+        //:
+        //: 3 Reset a histogram, and verify that it is empty.  (C-5)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered.  (C-7)
+        //
+        // Testing:
+        //   void recordMultiple(bsls::Types::Int64 value, Int64 count);
+        //   void reset();
+        //   bsls::Types::Int64 count() const;
+        //   double mean() const;
+        //   bsls::Types::Int64 percentile(double percentile) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "STATISTICS" << endl
+                          << "==========" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        if (verbose) cout << "\tEmpty histogram." << endl;
+        {
+            const Obj X(&ta);
+
+            ASSERT(0   == X.count());
+            ASSERT(0   == X.minimum());
+            ASSERT(0   == X.maximum());
+            ASSERT(0.0 == X.mean());
+            ASSERT(0   == X.percentile(0.0));
+            ASSERT(0   == X.percentile(50.0));
+            ASSERT(0   == X.percentile(100.0));
+        }
+
+        if (verbose) cout << "\tExact values." << endl;
+        {
+            // Values '1 .. 100' each have their own bucket with 7 significant
+            // bits.
+
+            Obj mX(7, &ta);  const Obj& X = mX;
+            for (int i = 100; 1 <= i; --i) {
+                mX.record(i);
+            }
+
+            ASSERT(100 == X.count());
+            ASSERT(1   == X.minimum());
+            ASSERT(100 == X.maximum());
+            ASSERTV(X.mean(), 50.5 == X.mean());
+
+            static const struct {
+                int    d_line;
+                double d_percentile;
+                Int64  d_expected;
+            } DATA[] = {
+                //LINE  PERCENTILE  EXP
+                //----  ----------  ---
+                { L_,         0.0,    1 },
+                { L_,         0.4,    1 },
+                { L_,         1.0,    1 },
+                { L_,         1.6,    2 },
+                { L_,        50.0,   50 },
+                { L_,        90.0,   90 },
+                { L_,        99.0,   99 },
+                { L_,        99.4,   99 },
+                { L_,        99.6,  100 },
+                { L_,       100.0,  100 },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int    LINE = DATA[ti].d_line;
+                const double PCT  = DATA[ti].d_percentile;
+                const Int64  EXP  = DATA[ti].d_expected;
+
+                ASSERTV(LINE, X.percentile(PCT), EXP == X.percentile(PCT));
+            }
+        }
+
+        if (verbose) cout << "\tMean of wide buckets." << endl;
+        {
+            // With 1 significant bit, 8 is counted in '[8, 11]', and 16 in
+            // '[16, 23]'.
+
+            Obj mX(1, &ta);  const Obj& X = mX;
+            mX.record(8);
+            mX.recordMultiple(16, 3);
+
+            ASSERT(8  == X.minimum());
+            ASSERT(23 == X.maximum());
+            ASSERT(11 == X.percentile(25.0));
+            ASSERT(23 == X.percentile(40.0));
+            ASSERTV(X.mean(), (9.5 + 3 * 19.5) / 4 == X.mean());
+        }
+
+        if (verbose) cout << "\t'recordMultiple' and 'reset'." << endl;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+            Obj mY(&ta);  const Obj& Y = mY;
+
+            for (int i = 0; i < 5; ++i) {
+                mX.record(12345);
+                mX.record(-7);
+            }
+            mY.recordMultiple(12345, 5);
+            mY.recordMultiple(0, 5);
+            mY.recordMultiple(99, 0);
+
+            ASSERT(X == Y);
+            ASSERT(10 == Y.count());
+
+            mX.reset();
+            ASSERT(0 == X.count());
+            ASSERT(6 == X.significantBits());
+            ASSERT(X == Obj(&ta));
+        }
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(&ta);  const Obj& X = mX;
+            mX.record(1);
+
+            ASSERT_PASS(X.percentile(0.0));
+            ASSERT_PASS(X.percentile(100.0));
+            ASSERT_FAIL(X.percentile(-0.1));
+            ASSERT_FAIL(X.percentile(100.1));
+
+            ASSERT_SAFE_PASS(mX.recordMultiple(1, 0));
+            ASSERT_SAFE_FAIL(mX.recordMultiple(1, -1));
+        }
+
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // BUCKETING
+        //
+        // Concerns:
+        //: 1 Each value below '2^k' has its own bucket.
+        //:
+        //: 2 Each value is counted in a bucket whose bounds contain it, and
+        //:   whose width is at most 'value / 2^k'.
+        //:
+        //: 3 Adjacent buckets are contiguous: the value following the upper
+        //:   bound of a bucket is the lower bound of the next bucket.
+        //:
+        //: 4 Negative values are counted as 0, and the largest 'Int64' value
+        //:   is counted in the last bucket.
+        //
+        // Plan:
+        //: 1 For each supported number of significant bits, record every
+        //:   value below 'min(2^(k+2), 1000)', every power of two and its
+        //:   neighbors, and a sequence of pseudo-random values, in histograms
+        //:   holding one value, and verify their minimum and maximum.
+        //:   (C-1..2)
+        //:
+        //: 2 For each bucket reached when walking the values from 0 using
+        //:   the reported upper bounds, verify that the next value is the
+        //:   lower bound of another bucket.  (C-3)
+        //:
+        //: 3 Record negative values and the largest 'Int64' value.  (C-4)
+        //
+        // Testing:
+        //   void record(bsls::Types::Int64 value);
+        //   bsls::Types::Int64 maximum() const;
+        //   bsls::Types::Int64 minimum() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BUCKETING" << endl
+                          << "=========" << endl;
+
+        bslma::TestAllocator         da(veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        const int MIN_BITS = Obj::k_MIN_SIGNIFICANT_BITS;
+        const int MAX_BITS = Obj::k_MAX_SIGNIFICANT_BITS;
+
+        for (int k = MIN_BITS; k <= MAX_BITS; ++k) {
+            if (veryVerbose) { T_ P(k) }
+
+            for (Int64 v = 0; v < (4 << k) && v < 1000; ++v) {
+                ASSERTV(k, v, isBracketed(v, k));
+            }
+
+            for (int b = 1; b < 63; ++b) {
+                const Int64 V = static_cast<Int64>(1) << b;
+
+                ASSERTV(k, b, isBracketed(V - 1, k));
+                ASSERTV(k, b, isBracketed(V,     k));
+                ASSERTV(k, b, isBracketed(V + 1, k));
+            }
+
+            bsls::Types::Uint64 seed = 12345;
+            for (int i = 0; i < 1000; ++i) {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+                const Int64 V = static_cast<Int64>(seed >> (1 + i % 63));
+                ASSERTV(k, V, isBracketed(V, k));
+            }
+
+            // Walk the buckets (of the histograms small enough to do so
+            // quickly).
+
+            if (6 < k) {
+                continue;
+            }
+
+            Int64 value      = 0;
+            int   numBuckets = 0;
+            while (true) {
+                Obj mX(k);  const Obj& X = mX;
+                mX.record(value);
+
+                ASSERTV(k, value, value == X.minimum());
+
+                ++numBuckets;
+                if (k_MAX_INT64 == X.maximum()) {
+                    break;
+                }
+                value = X.maximum() + 1;
+            }
+            ASSERTV(k, numBuckets, (64 - k) << k == numBuckets);
+        }
+
+        if (verbose) cout << "\tExtremes." << endl;
+        {
+            Obj mX(&da);  const Obj& X = mX;
+
+            mX.record(-1);
+            mX.record(-k_MAX_INT64 - 1);
+            ASSERT(0 == X.minimum());
+            ASSERT(0 == X.maximum());
+            ASSERT(2 == X.count());
+
+            mX.record(k_MAX_INT64);
+            ASSERT(k_MAX_INT64 == X.maximum());
+            ASSERT(k_MAX_INT64 - (k_MAX_INT64 >> 6) <= X.percentile(100.0));
+        }
+
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 A default-constructed histogram is empty and has
+        //:   'k_DEFAULT_SIGNIFICANT_BITS' significant bits.
+        //:
+        //: 2 A histogram has the number of significant bits supplied at
+        //:   construction.
+        //:
+        //: 3 Memory is allocated from the supplied allocator (or the default
+        //:   allocator), in a single block of '(64 - k) * 2^k' counters, and
+        //:   released on destruction.
+        //:
+        //: 4 The allocator trait is declared.
+        //:
+        //: 5 Unsupported numbers of significant bits are detected in
+        //:   appropriate build modes.
+        //
+        // Plan:
+        //: 1 Create histograms with and without an allocator, for each
+        //:   supported number of significant bits, and verify the accessors
+        //:   and the allocated memory.  (C-1..4)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered.  (C-5)
+        //
+        // Testing:
+        //   LogLinearHistogram(bslma::Allocator *ba = 0);
+        //   LogLinearHistogram(int significantBits, bslma::Allocator *ba = 0);
+        //   ~LogLinearHistogram();
+        //   int significantBits() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND BASIC ACCESSORS" << endl
+                          << "============================" << endl;
+
+        bslma::TestAllocator da(veryVeryVerbose);
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        ASSERT(bslma::UsesBslmaAllocator<Obj>::value);
+
+        {
+            const Obj X;
+
+            ASSERT(Obj::k_DEFAULT_SIGNIFICANT_BITS == X.significantBits());
+            ASSERT(&da == X.allocator());
+            ASSERT(0   == X.count());
+            ASSERT(1   == da.numBlocksInUse());
+            ASSERT((64 - 6) * 64 * 8 == da.numBytesInUse());
+        }
+        ASSERT(0 == da.numBlocksInUse());
+
+        const int MIN_BITS = Obj::k_MIN_SIGNIFICANT_BITS;
+        const int MAX_BITS = Obj::k_MAX_SIGNIFICANT_BITS;
+
+        for (int k = MIN_BITS; k <= MAX_BITS; ++k) {
+            {
+                const Obj X(k, &ta);
+
+                ASSERTV(k, k   == X.significantBits());
+                ASSERTV(k, &ta == X.allocator());
+                ASSERTV(k, 0   == X.count());
+                ASSERTV(k, 1   == ta.numBlocksInUse());
+                ASSERTV(k, ((64 - k) << k) * 8 == ta.numBytesInUse());
+            }
+            ASSERTV(k, 0 == ta.numBlocksInUse());
+        }
+        ASSERT(1 == da.numBlocksTotal());
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_PASS(Obj(Obj::k_MIN_SIGNIFICANT_BITS, &ta));
+            ASSERT_PASS(Obj(Obj::k_MAX_SIGNIFICANT_BITS, &ta));
+            ASSERT_FAIL(Obj(Obj::k_MIN_SIGNIFICANT_BITS - 1, &ta));
+            ASSERT_FAIL(Obj(Obj::k_MAX_SIGNIFICANT_BITS + 1, &ta));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Record values, query statistics, and merge two histograms.
+        //:   (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        Obj mX(&ta);  const Obj& X = mX;
+        Obj mY(&ta);  const Obj& Y = mY;
+
+        ASSERT(0 == X.count());
+        ASSERT(X == Y);
+
+        for (int i = 1; i <= 1000; ++i) {
+            mX.record(i);
+        }
+        if (veryVerbose) { P(X) }
+
+        ASSERT(1000 == X.count());
+        ASSERT(1    == X.minimum());
+        ASSERT(1000 <= X.maximum() && X.maximum() <= 1000 + 1000 / 64);
+
+        const Int64 P50 = X.percentile(50.0);
+        ASSERTV(P50, 500 <= P50 && P50 <= 500 + 500 / 64);
+        ASSERTV(X.mean(), 495.0 <= X.mean() && X.mean() <= 505.0);
+
+        mY.add(X);
+        ASSERT(X == Y);
+
+        mY.add(X);
+        ASSERT(X != Y);
+        ASSERT(2000 == Y.count());
+
+        mY.reset();
+        ASSERT(0 == Y.count());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,256 @@
+// bdlma_accountingallocator.cpp                                      -*-C++-*-
+#include <bdlma_accountingallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_accountingallocator_cpp,"$Id$ $CSID$")
+
+#include <bslma_default.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_bslexceptionutil.h>
+#include <bsls_exceptionutil.h>
+#include <bsls_performancehint.h>
+
+#include <bsl_ostream.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+namespace {
+
+// LOCAL CONSTANTS
+
+// Define the number of bytes by which the address returned to the user is
+// *offset* from the actual address of the allocated memory block.
+
+const bslma::Allocator::size_type OFFSET =
+                                       bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+}  // close unnamed namespace
+
+                         // -------------------------
+                         // class AccountingAllocator
+                         // -------------------------
+
+// PRIVATE MANIPULATORS
+void *AccountingAllocator::chargeAndAllocate(bsls::Types::Int64  numBytes,
+                                             size_type           totalSize,
+                                             bslma::Allocator   *allocator)
+{
+    const bsls::Types::Int64 inUse = d_numBytesInUse.addRelaxed(numBytes);
+    const bsls::Types::Int64 hard  = d_hardLimit.loadRelaxed();
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(k_NO_LIMIT != hard
+                                              && inUse > hard)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        d_numBytesInUse.addRelaxed(-numBytes);
+        d_numRejections.addRelaxed(1);
+        bsls::BslExceptionUtil::throwBadAlloc();
+    }
+
+    // Charge the ancestors before allocating, so that a request exceeding a
+    // hard limit never reaches 'allocator'.
+
+    void *address;
+
+    BSLS_TRY {
+        address = d_parent_p
+                ? d_parent_p->chargeAndAllocate(numBytes, totalSize, allocator)
+                : allocator->allocate(totalSize);
+    }
+    BSLS_CATCH(...) {
+        d_numBytesInUse.addRelaxed(-numBytes);
+        BSLS_RETHROW;
+    }
+
+    // The block was obtained: update the remaining statistics, and notify a
+    // crossing of the soft limit.
+
+    d_numBytesTotal.addRelaxed(numBytes);
+
+    bsls::Types::Int64 max = d_numBytesMax.loadRelaxed();
+    while (inUse > max) {
+        const bsls::Types::Int64 prior = d_numBytesMax.testAndSwap(max,
+                                                                   inUse);
+        if (prior == max) {
+            break;
+        }
+        max = prior;
+    }
+
+    const bsls::Types::Int64 soft = d_softLimit.loadRelaxed();
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(k_NO_LIMIT != soft
+                                              && inUse > soft
+                                              && inUse - numBytes <= soft)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        if (d_callback) {
+            d_callback(*this, d_callbackContext);
+        }
+    }
+
+    return address;
+}
+
+void AccountingAllocator::uncharge(bsls::Types::Int64 numBytes)
+{
+    for (AccountingAllocator *node = this; node; node = node->d_parent_p) {
+        node->d_numBytesInUse.addRelaxed(-numBytes);
+    }
+}
+
+// CREATORS
+AccountingAllocator::AccountingAllocator(bslma::Allocator *basicAllocator)
+: d_name_p(0)
+, d_parent_p(0)
+, d_numBytesInUse(0)
+, d_numBytesMax(0)
+, d_numBytesTotal(0)
+, d_numRejections(0)
+, d_softLimit(k_NO_LIMIT)
+, d_hardLimit(k_NO_LIMIT)
+, d_callback(0)
+, d_callbackContext(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(d_allocator_p);
+}
+
+AccountingAllocator::AccountingAllocator(const char       *name,
+                                         bslma::Allocator *basicAllocator)
+: d_name_p(name)
+, d_parent_p(0)
+, d_numBytesInUse(0)
+, d_numBytesMax(0)
+, d_numBytesTotal(0)
+, d_numRejections(0)
+, d_softLimit(k_NO_LIMIT)
+, d_hardLimit(k_NO_LIMIT)
+, d_callback(0)
+, d_callbackContext(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(d_allocator_p);
+}
+
+AccountingAllocator::AccountingAllocator(AccountingAllocator *parent,
+                                         const char          *name,
+                                         bslma::Allocator    *basicAllocator)
+: d_name_p(name)
+, d_parent_p(parent)
+, d_numBytesInUse(0)
+, d_numBytesMax(0)
+, d_numBytesTotal(0)
+, d_numRejections(0)
+, d_softLimit(k_NO_LIMIT)
+, d_hardLimit(k_NO_LIMIT)
+, d_callback(0)
+, d_callbackContext(0)
+, d_allocator_p(basicAllocator || !parent
+                ? bslma::Default::allocator(basicAllocator)
+                : parent->d_allocator_p)
+{
+    BSLS_ASSERT(d_allocator_p);
+}
+
+AccountingAllocator::~AccountingAllocator()
+{
+    BSLS_ASSERT(0               <= numBytesInUse());
+    BSLS_ASSERT(numBytesInUse() <= numBytesMax());
+    BSLS_ASSERT(numBytesMax()   <= numBytesTotal());
+    BSLS_ASSERT(d_allocator_p);
+}
+
+// MANIPULATORS
+void *AccountingAllocator::allocate(size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    const bsls::Types::Int64 numBytes = static_cast<bsls::Types::Int64>(size);
+
+    // Round up 'size' for maximal alignment and add sufficient space to record
+    // 'size' in the allocated block.
+
+    const size_type totalSize =
+                 bsls::AlignmentUtil::roundUpToMaximalAlignment(size) + OFFSET;
+
+    void *address = chargeAndAllocate(numBytes, totalSize, d_allocator_p);
+
+    *static_cast<size_type *>(address) = size;
+
+    return static_cast<char *>(address) + OFFSET;
+}
+
+void AccountingAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return;                                                       // RETURN
+    }
+
+    address = static_cast<char *>(address) - OFFSET;
+
+    const size_type recordedSize = *static_cast<size_type *>(address);
+
+    uncharge(static_cast<bsls::Types::Int64>(recordedSize));
+
+    d_allocator_p->deallocate(address);
+}
+
+// ACCESSORS
+bsl::ostream& AccountingAllocator::print(bsl::ostream& stream) const
+{
+    stream << "----------------------------------------\n"
+           << "       Accounting Allocator State\n"
+           << "----------------------------------------\n";
+
+    if (d_name_p) {
+        stream << "Allocator name: " << name() << "\n";
+    }
+    if (d_parent_p && d_parent_p->name()) {
+        stream << "Parent name:    " << d_parent_p->name() << "\n";
+    }
+
+    stream << "Bytes in use:   " << numBytesInUse() << "\n"
+           << "Bytes maximum:  " << numBytesMax()   << "\n"
+           << "Bytes in total: " << numBytesTotal() << "\n";
+
+    const bsls::Types::Int64 soft = softLimit();
+    const bsls::Types::Int64 hard = hardLimit();
+
+    if (k_NO_LIMIT != soft) {
+        stream << "Soft limit:     " << soft << "\n";
+    }
+    if (k_NO_LIMIT != hard) {
+        stream << "Hard limit:     " << hard << "\n";
+    }
+
+    stream << "Rejections:     " << numRejections() << "\n";
+
+    return stream;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
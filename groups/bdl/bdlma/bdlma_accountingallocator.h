@@ -0,0 +1,474 @@
+// bdlma_accountingallocator.h                                        -*-C++-*-
+#ifndef INCLUDED_BDLMA_ACCOUNTINGALLOCATOR
+#define INCLUDED_BDLMA_ACCOUNTINGALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a hierarchical byte-accounting allocator with quotas.
+//
+//@CLASSES:
+//  bdlma::AccountingAllocator: allocator node in a tree of byte quotas
+//
+//@SEE_ALSO: bdlma_countingallocator, bslma_allocator
+//
+//@DESCRIPTION: This component provides a concrete allocator,
+// 'bdlma::AccountingAllocator', that implements the 'bslma::Allocator'
+// protocol, tracks the number of bytes allocated from it, and enforces
+// optional limits on the number of bytes in use.  Accounting allocators can be
+// arranged in a tree -- e.g., one per service, with one per session of that
+// service as its children, and one per cache of that session as theirs -- in
+// which the bytes allocated from a node are charged to that node *and* to each
+// of its ancestors:
+//..
+//   ,--------------------------.
+//  ( bdlma::AccountingAllocator )
+//   `--------------------------'
+//                |           ctor/dtor
+//                |           setHardLimit
+//                |           setSoftLimit
+//                |           setSoftLimitCallback
+//                |           hardLimit
+//                |           name
+//                |           numBytesInUse
+//                |           numBytesMax
+//                |           numBytesTotal
+//                |           numRejections
+//                |           parent
+//                |           print
+//                |           softLimit
+//                V
+//       ,----------------.
+//      ( bslma::Allocator )
+//       `----------------'
+//                            allocate
+//                            deallocate
+//..
+// A child node obtains its memory from the allocator supplied at its
+// construction or, if none is supplied, from the allocator of its parent; the
+// parent itself is used only for accounting, so that the depth of the tree
+// adds no per-block overhead beyond a single header.
+//
+///Byte Counts
+///-----------
+// The byte counts maintained by a 'bdlma::AccountingAllocator' are based
+// solely on the number of bytes requested in calls to 'allocate' on that
+// allocator or on any of its descendants.  'numBytesInUse' returns the number
+// of bytes currently allocated, 'numBytesMax' the largest value that
+// 'numBytesInUse' has ever had, and 'numBytesTotal' the cumulative number of
+// bytes ever allocated.  Each counter is a single atomic integer, updated
+// without locking, so that the counters are cheap enough for production use.
+//
+///Limits
+///------
+// Each node has an optional *soft* *limit* and an optional *hard* *limit* on
+// the number of bytes in use, either of which may be changed at any time (a
+// value of 'k_NO_LIMIT' disables a limit).
+//
+// An allocation that would take the number of bytes in use of a node, or of
+// any of its ancestors, beyond the hard limit of that node is rejected: no
+// memory is allocated, no byte count is changed, the number of rejections of
+// the node whose limit would have been exceeded is incremented, and a
+// 'bsl::bad_alloc' exception is thrown.
+//
+// An allocation that takes the number of bytes in use of a node from at or
+// below its soft limit to beyond it succeeds, but first invokes the soft-limit
+// callback of that node (if any), supplying the node and the user-defined
+// context pointer with which the callback was installed.  The callback is
+// invoked once per crossing: it is invoked again only after the number of
+// bytes in use has fallen back to the soft limit (or below), and has then
+// exceeded it anew.  The callback must not allocate memory from the node, or
+// from any of its descendants.
+//
+// Note that, because the byte counts are updated without locking, an
+// allocation may be rejected on account of a concurrent allocation that is
+// itself subsequently rejected.
+//
+///Thread Safety
+///-------------
+// 'bdlma::AccountingAllocator' is fully thread-safe (see 'bsldoc_glossary'),
+// provided that the underlying allocator is fully thread-safe, with the
+// exception of 'setSoftLimitCallback', which must not be invoked concurrently
+// with any allocation from the node or from any of its descendants.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Capping the Memory Used by the Caches of a Service
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a service maintains a number of caches, whose memory use is
+// unbounded in principle, and that we want to both attribute the memory used
+// by the service to each cache, and cap the total memory used by the caches.
+//
+// First, we define a soft-limit callback that records the name of the
+// allocator whose soft limit was exceeded (a real application might instead
+// log a warning, or trigger the eviction of entries from the caches):
+//..
+//  void noteSoftLimit(const bdlma::AccountingAllocator&  allocator,
+//                     void                              *context)
+//  {
+//      *static_cast<const char **>(context) = allocator.name();
+//  }
+//..
+// Then, we create the root of the tree, for the service, with a hard limit of
+// 64 kilobytes, and a soft limit, at which 'noteSoftLimit' is invoked, of 48
+// kilobytes:
+//..
+//  const char *warned = 0;
+//
+//  bdlma::AccountingAllocator service("service");
+//  service.setHardLimit(64 * 1024);
+//  service.setSoftLimit(48 * 1024);
+//  service.setSoftLimitCallback(&noteSoftLimit, &warned);
+//..
+// Next, we create a child of the service for each of two caches, and supply
+// them to the containers implementing the caches:
+//..
+//  bdlma::AccountingAllocator quotes(&service, "quotes");
+//  bdlma::AccountingAllocator trades(&service, "trades");
+//
+//  bsl::vector<char> quoteCache(&quotes);
+//  bsl::vector<char> tradeCache(&trades);
+//..
+// Now, we grow the caches, and observe that the bytes allocated from each
+// cache are attributed to that cache, and charged to the service:
+//..
+//  quoteCache.reserve(20 * 1024);
+//  tradeCache.reserve(30 * 1024);
+//
+//  assert(20 * 1024 == quotes.numBytesInUse());
+//  assert(30 * 1024 == trades.numBytesInUse());
+//  assert(50 * 1024 == service.numBytesInUse());
+//  assert(0 == bsl::strcmp("service", warned));
+//..
+// Finally, we observe that growing either cache beyond the remaining quota of
+// the service fails, leaving the cache (and the byte counts) unchanged:
+//..
+//  bool rejected = false;
+//  try {
+//      quoteCache.reserve(40 * 1024);
+//  }
+//  catch (const bsl::bad_alloc&) {
+//      rejected = true;
+//  }
+//  assert(rejected);
+//  assert(20 * 1024 == quoteCache.capacity());
+//  assert(50 * 1024 == service.numBytesInUse());
+//  assert(1         == service.numRejections());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_IOSFWD
+#include <bsl_iosfwd.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                          // =========================
+                          // class AccountingAllocator
+                          // =========================
+
+class AccountingAllocator : public bslma::Allocator {
+    // This class defines a concrete "accounting" allocator mechanism that
+    // implements the 'bslma::Allocator' protocol, tracks the number of bytes
+    // allocated from it and from its descendants, charges those bytes to its
+    // ancestors, and enforces optional soft and hard limits on the number of
+    // bytes in use (see {Limits}).
+
+  public:
+    // TYPES
+    typedef void (*SoftLimitCallback)(const AccountingAllocator&  allocator,
+                                      void                       *context);
+        // 'SoftLimitCallback' is an alias for a pointer to a function invoked
+        // when the number of bytes in use of the specified 'allocator' first
+        // exceeds its soft limit, supplied with the specified 'context'
+        // installed with the callback.
+
+    enum { k_NO_LIMIT = -1 };  // value of a disabled limit
+
+  private:
+    // DATA
+    const char          *d_name_p;          // optionally specified name of
+                                            // this allocator (or 0)
+
+    AccountingAllocator *d_parent_p;        // parent node (or 0 if root)
+
+    bsls::AtomicInt64    d_numBytesInUse;   // number of bytes currently
+                                            // allocated from this node and
+                                            // its descendants
+
+    bsls::AtomicInt64    d_numBytesMax;     // high-water mark of
+                                            // 'd_numBytesInUse'
+
+    bsls::AtomicInt64    d_numBytesTotal;   // cumulative number of bytes ever
+                                            // allocated
+
+    bsls::AtomicInt64    d_numRejections;   // number of allocations rejected
+                                            // by the hard limit of this node
+
+    bsls::AtomicInt64    d_softLimit;       // soft limit, or 'k_NO_LIMIT'
+
+    bsls::AtomicInt64    d_hardLimit;       // hard limit, or 'k_NO_LIMIT'
+
+    SoftLimitCallback    d_callback;        // soft-limit callback (or 0)
+
+    void                *d_callbackContext; // context supplied to
+                                            // 'd_callback'
+
+    bslma::Allocator    *d_allocator_p;     // memory allocator (held, not
+                                            // owned)
+
+  private:
+    // PRIVATE MANIPULATORS
+    void *chargeAndAllocate(bsls::Types::Int64  numBytes,
+                            size_type           totalSize,
+                            bslma::Allocator   *allocator);
+        // Add the specified 'numBytes' to the number of bytes in use of this
+        // node and of each of its ancestors, and return a block of the
+        // specified 'totalSize' (in bytes) supplied by the specified
+        // 'allocator'.  Once the block is obtained, update the remaining byte
+        // counts of each of these nodes, invoking the soft-limit callback of
+        // each node whose soft limit is thereby first exceeded.  If the hard
+        // limit of any of these nodes would be exceeded, leave all byte counts
+        // unchanged, increment the number of rejections of that node, and
+        // throw 'bsl::bad_alloc'.  If 'allocator' throws, leave all byte
+        // counts unchanged, invoke no callback, and propagate the exception.
+
+    void uncharge(bsls::Types::Int64 numBytes);
+        // Subtract the specified 'numBytes' from the number of bytes in use of
+        // this node and of each of its ancestors.
+
+    // NOT IMPLEMENTED
+    AccountingAllocator(const AccountingAllocator&);
+    AccountingAllocator& operator=(const AccountingAllocator&);
+
+  public:
+    // CREATORS
+    explicit
+    AccountingAllocator(bslma::Allocator *basicAllocator = 0);
+    explicit
+    AccountingAllocator(const char       *name,
+                        bslma::Allocator *basicAllocator = 0);
+        // Create an accounting allocator that is the root of a tree of
+        // accounting allocators, and that has no limits.  Optionally specify
+        // a 'name' (associated with this object) to be included in messages
+        // output by the 'print' method.  If 'name' is 0 (or not specified), no
+        // distinguishing name is incorporated in 'print' output.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
+    AccountingAllocator(AccountingAllocator *parent,
+                        const char          *name,
+                        bslma::Allocator    *basicAllocator = 0);
+        // Create an accounting allocator having the specified 'parent' node,
+        // if 'parent' is not 0, and the specified 'name' (which may be 0), and
+        // that has no limits.  Bytes allocated from this object are charged to
+        // 'parent' and to each of its ancestors.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the allocator used by 'parent' is used or, if 'parent' is 0, the
+        // currently installed default allocator is used.  The behavior is
+        // undefined unless 'parent' (if not 0) outlives this object.
+
+    virtual ~AccountingAllocator();
+        // Destroy this allocator object.  The behavior is undefined unless all
+        // memory allocated from this object has been deallocated.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return a newly-allocated block of memory of the specified 'size' (in
+        // bytes).  If 'size' is 0, a null pointer is returned with no other
+        // effect.  Otherwise, charge 'size' bytes to this node and to each of
+        // its ancestors, and throw 'bsl::bad_alloc' (with no effect on any
+        // byte count) if a hard limit would thereby be exceeded (see
+        // {Limits}).
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' back to this
+        // allocator, and decrease the number of bytes in use of this node and
+        // of each of its ancestors by the size originally requested for the
+        // block.  If 'address' is 0, this function has no effect.  The
+        // behavior is undefined unless 'address' was allocated using this
+        // allocator object and has not already been deallocated.
+
+    void setHardLimit(bsls::Types::Int64 limit);
+        // Set the hard limit of this node to the specified 'limit' (in bytes),
+        // or disable it if 'limit' is 'k_NO_LIMIT'.  Note that bytes already
+        // in use are not affected by a reduced limit.  The behavior is
+        // undefined unless '0 <= limit' or 'k_NO_LIMIT == limit'.
+
+    void setSoftLimit(bsls::Types::Int64 limit);
+        // Set the soft limit of this node to the specified 'limit' (in bytes),
+        // or disable it if 'limit' is 'k_NO_LIMIT'.  The behavior is undefined
+        // unless '0 <= limit' or 'k_NO_LIMIT == limit'.
+
+    void setSoftLimitCallback(SoftLimitCallback  callback,
+                              void              *context = 0);
+        // Set the soft-limit callback of this node to the specified
+        // 'callback', to be supplied with the optionally specified 'context',
+        // or remove the callback if 'callback' is 0.  The behavior is
+        // undefined if this method is invoked concurrently with an allocation
+        // from this node or from any of its descendants.
+
+    // ACCESSORS
+    bsls::Types::Int64 hardLimit() const;
+        // Return the hard limit of this node, or 'k_NO_LIMIT' if it has none.
+
+    const char *name() const;
+        // Return the name of this accounting allocator, or 0 if no name was
+        // specified at construction.
+
+    bsls::Types::Int64 numBytesInUse() const;
+        // Return the number of bytes currently allocated from this node and
+        // from its descendants.
+
+    bsls::Types::Int64 numBytesMax() const;
+        // Return the maximum number of bytes that have been in use from this
+        // node and from its descendants at any one time.
+
+    bsls::Types::Int64 numBytesTotal() const;
+        // Return the cumulative number of bytes ever allocated from this node
+        // and from its descendants.
+
+    bsls::Types::Int64 numRejections() const;
+        // Return the number of allocations that have been rejected because
+        // they would have exceeded the hard limit of this node.
+
+    AccountingAllocator *parent() const;
+        // Return the address of the parent of this node, or 0 if this node is
+        // the root of its tree.
+
+    bsl::ostream& print(bsl::ostream& stream) const;
+        // Write the accumulated state information held in this allocator to
+        // the specified 'stream' in some reasonable (multi-line) format, and
+        // return a reference to 'stream'.
+
+    bsls::Types::Int64 softLimit() const;
+        // Return the soft limit of this node, or 'k_NO_LIMIT' if it has none.
+};
+
+// ============================================================================
+//                         INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                          // -------------------------
+                          // class AccountingAllocator
+                          // -------------------------
+
+// MANIPULATORS
+inline
+void AccountingAllocator::setHardLimit(bsls::Types::Int64 limit)
+{
+    BSLS_ASSERT_SAFE(0 <= limit || k_NO_LIMIT == limit);
+
+    d_hardLimit.storeRelaxed(limit);
+}
+
+inline
+void AccountingAllocator::setSoftLimit(bsls::Types::Int64 limit)
+{
+    BSLS_ASSERT_SAFE(0 <= limit || k_NO_LIMIT == limit);
+
+    d_softLimit.storeRelaxed(limit);
+}
+
+inline
+void AccountingAllocator::setSoftLimitCallback(SoftLimitCallback  callback,
+                                               void              *context)
+{
+    d_callback        = callback;
+    d_callbackContext = context;
+}
+
+// ACCESSORS
+inline
+bsls::Types::Int64 AccountingAllocator::hardLimit() const
+{
+    return d_hardLimit.loadRelaxed();
+}
+
+inline
+const char *AccountingAllocator::name() const
+{
+    return d_name_p;
+}
+
+inline
+bsls::Types::Int64 AccountingAllocator::numBytesInUse() const
+{
+    return d_numBytesInUse.loadRelaxed();
+}
+
+inline
+bsls::Types::Int64 AccountingAllocator::numBytesMax() const
+{
+    return d_numBytesMax.loadRelaxed();
+}
+
+inline
+bsls::Types::Int64 AccountingAllocator::numBytesTotal() const
+{
+    return d_numBytesTotal.loadRelaxed();
+}
+
+inline
+bsls::Types::Int64 AccountingAllocator::numRejections() const
+{
+    return d_numRejections.loadRelaxed();
+}
+
+inline
+AccountingAllocator *AccountingAllocator::parent() const
+{
+    return d_parent_p;
+}
+
+inline
+bsls::Types::Int64 AccountingAllocator::softLimit() const
+{
+    return d_softLimit.loadRelaxed();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
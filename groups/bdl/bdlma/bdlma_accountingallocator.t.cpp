@@ -0,0 +1,978 @@
+// bdlma_accountingallocator.t.cpp                                    -*-C++-*-
+#include <bdlma_accountingallocator.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_new.h>
+#include <bsl_sstream.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                TEST PLAN
+// ----------------------------------------------------------------------------
+//                                 Overview
+//                                 --------
+// 'bdlma::AccountingAllocator' is an allocator mechanism that tracks the bytes
+// allocated from a node of a tree of such allocators, charges them to each
+// ancestor of that node, and enforces soft and hard limits on the bytes in use
+// of each node.  The primary concerns are that the byte counts are correctly
+// maintained throughout the tree, that an allocation exceeding a hard limit
+// anywhere in the tree is rejected with no effect other than the counting of
+// the rejection, that soft-limit callbacks are invoked once per crossing, and
+// that memory is supplied by (and returned to) the intended allocator.  We
+// make heavy use of 'bslma::TestAllocator' to ensure that these concerns are
+// satisfied.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] AccountingAllocator(Allocator *ba = 0);
+// [ 2] AccountingAllocator(const char *name, Allocator *ba = 0);
+// [ 2] AccountingAllocator(parent, const char *name, Allocator *ba = 0);
+// [ 2] ~AccountingAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 3] void deallocate(void *address);
+// [ 4] void setHardLimit(Int64 limit);
+// [ 5] void setSoftLimit(Int64 limit);
+// [ 5] void setSoftLimitCallback(SoftLimitCallback callback, void *ctx);
+//
+// ACCESSORS
+// [ 4] Int64 hardLimit() const;
+// [ 2] const char *name() const;
+// [ 3] Int64 numBytesInUse() const;
+// [ 3] Int64 numBytesMax() const;
+// [ 3] Int64 numBytesTotal() const;
+// [ 4] Int64 numRejections() const;
+// [ 2] AccountingAllocator *parent() const;
+// [ 6] bsl::ostream& print(bsl::ostream& stream) const;
+// [ 5] Int64 softLimit() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 8] USAGE EXAMPLE
+// [ 7] CONCERN: A throwing allocator leaves the tree unchanged.
+// [ *] CONCERN: In no case does memory come from the global allocator.
+// [ 4] CONCERN: Precondition violations are detected when enabled.
+
+// ============================================================================
+//                    STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL VARIABLES / TYPEDEFS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlma::AccountingAllocator Obj;
+typedef bsls::Types::Int64         Int64;
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+struct CallbackRecord {
+    // This 'struct' records the invocations of 'recordCallback'.
+
+    int        d_numCalls;     // number of invocations
+    const Obj *d_lastNode_p;   // node supplied to the last invocation
+    Int64      d_lastInUse;    // bytes in use of that node at the time
+};
+
+void recordCallback(const Obj& allocator, void *context)
+    // Record, in the 'CallbackRecord' at the specified 'context', the
+    // invocation of this function for the specified 'allocator'.
+{
+    CallbackRecord *record = static_cast<CallbackRecord *>(context);
+
+    ++record->d_numCalls;
+    record->d_lastNode_p = &allocator;
+    record->d_lastInUse  = allocator.numBytesInUse();
+}
+
+bool isRejected(Obj *allocator, bsls::Types::size_type size)
+    // Attempt to allocate a block of the specified 'size' from the specified
+    // 'allocator', and return 'true' if the allocation is rejected by a
+    // 'bsl::bad_alloc' exception, and 'false' (after deallocating the block)
+    // otherwise.
+{
+    try {
+        allocator->deallocate(allocator->allocate(size));
+    }
+    catch (const bsl::bad_alloc&) {
+        return true;                                                  // RETURN
+    }
+    return false;
+}
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Capping the Memory Used by the Caches of a Service
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a service maintains a number of caches, whose memory use is
+// unbounded in principle, and that we want to both attribute the memory used
+// by the service to each cache, and cap the total memory used by the caches.
+//
+// First, we define a soft-limit callback that records the name of the
+// allocator whose soft limit was exceeded (a real application might instead
+// log a warning, or trigger the eviction of entries from the caches):
+//..
+    void noteSoftLimit(const bdlma::AccountingAllocator&  allocator,
+                       void                              *context)
+    {
+        *static_cast<const char **>(context) = allocator.name();
+    }
+//..
+
+// ============================================================================
+//                                MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+    bool veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+// Then, we create the root of the tree, for the service, with a hard limit of
+// 64 kilobytes, and a soft limit, at which 'noteSoftLimit' is invoked, of 48
+// kilobytes:
+//..
+    const char *warned = 0;
+
+    bdlma::AccountingAllocator service("service");
+    service.setHardLimit(64 * 1024);
+    service.setSoftLimit(48 * 1024);
+    service.setSoftLimitCallback(&noteSoftLimit, &warned);
+//..
+// Next, we create a child of the service for each of two caches, and supply
+// them to the containers implementing the caches:
+//..
+    bdlma::AccountingAllocator quotes(&service, "quotes");
+    bdlma::AccountingAllocator trades(&service, "trades");
+
+    bsl::vector<char> quoteCache(&quotes);
+    bsl::vector<char> tradeCache(&trades);
+//..
+// Now, we grow the caches, and observe that the bytes allocated from each
+// cache are attributed to that cache, and charged to the service:
+//..
+    quoteCache.reserve(20 * 1024);
+    tradeCache.reserve(30 * 1024);
+
+    ASSERT(20 * 1024 == quotes.numBytesInUse());
+    ASSERT(30 * 1024 == trades.numBytesInUse());
+    ASSERT(50 * 1024 == service.numBytesInUse());
+    ASSERT(0 == bsl::strcmp("service", warned));
+//..
+// Finally, we observe that growing either cache beyond the remaining quota of
+// the service fails, leaving the cache (and the byte counts) unchanged:
+//..
+    bool rejected = false;
+    try {
+        quoteCache.reserve(40 * 1024);
+    }
+    catch (const bsl::bad_alloc&) {
+        rejected = true;
+    }
+    ASSERT(rejected);
+    ASSERT(20 * 1024 == quoteCache.capacity());
+    ASSERT(50 * 1024 == service.numBytesInUse());
+    ASSERT(1         == service.numRejections());
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // EXCEPTION NEUTRALITY
+        //
+        // Concerns:
+        //: 1 An allocation for which the underlying allocator throws leaves
+        //:   the bytes in use, the maximum, and the total of every node in
+        //:   the tree unchanged, and propagates the exception.
+        //:
+        //: 2 Such an allocation does not invoke a soft-limit callback, even
+        //:   if it would otherwise have crossed the soft limit.
+        //:
+        //: 3 Such an allocation is not counted as a rejection.
+        //:
+        //: 4 Once the underlying allocator recovers, the same allocation
+        //:   succeeds and updates every node as usual.
+        //
+        // Plan:
+        //: 1 Build a two-level tree supplied by a 'bslma::TestAllocator',
+        //:   and install on both nodes soft limits, and callbacks recording
+        //:   their invocations, that the allocation under test would cross.
+        //:
+        //: 2 Set the allocation limit of the test allocator to 0, attempt
+        //:   the allocation, and verify that the exception propagates and
+        //:   that no statistic or callback record has changed.  (C-1..3)
+        //:
+        //: 3 Lift the allocation limit, repeat the allocation, and verify
+        //:   the updated statistics and callback records.  (C-4)
+        //
+        // Testing:
+        //   CONCERN: A throwing allocator leaves the tree unchanged.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "EXCEPTION NEUTRALITY" << endl
+                          << "====================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        Obj mR("root", &ta);  const Obj& R = mR;
+        Obj mX(&mR, "child"); const Obj& X = mX;
+
+        CallbackRecord recR = { 0, 0, 0 };
+        CallbackRecord recX = { 0, 0, 0 };
+
+        mR.setSoftLimit(100);
+        mR.setSoftLimitCallback(&recordCallback, &recR);
+        mX.setSoftLimit(50);
+        mX.setSoftLimitCallback(&recordCallback, &recX);
+
+        void *p1 = mR.allocate(60);
+        void *p2 = mX.allocate(40);
+
+        ASSERT(0   == recR.d_numCalls);
+        ASSERT(0   == recX.d_numCalls);
+        ASSERT(100 == R.numBytesInUse());
+        ASSERT(100 == R.numBytesMax());
+        ASSERT(100 == R.numBytesTotal());
+        ASSERT(40  == X.numBytesInUse());
+        ASSERT(40  == X.numBytesMax());
+        ASSERT(40  == X.numBytesTotal());
+
+        if (verbose) cout << "\tUnderlying allocator throws." << endl;
+        {
+            bool caught = false;
+
+            ta.setAllocationLimit(0);
+            try {
+                mX.allocate(20);
+            }
+            catch (const bslma::TestAllocatorException&) {
+                caught = true;
+            }
+            ta.setAllocationLimit(-1);
+
+            ASSERT(caught);
+
+            ASSERTV(recR.d_numCalls, 0   == recR.d_numCalls);
+            ASSERTV(recX.d_numCalls, 0   == recX.d_numCalls);
+            ASSERTV(R.numBytesInUse(), 100 == R.numBytesInUse());
+            ASSERTV(R.numBytesMax(),   100 == R.numBytesMax());
+            ASSERTV(R.numBytesTotal(), 100 == R.numBytesTotal());
+            ASSERTV(X.numBytesInUse(), 40  == X.numBytesInUse());
+            ASSERTV(X.numBytesMax(),   40  == X.numBytesMax());
+            ASSERTV(X.numBytesTotal(), 40  == X.numBytesTotal());
+            ASSERT(0 == R.numRejections());
+            ASSERT(0 == X.numRejections());
+        }
+
+        if (verbose) cout << "\tUnderlying allocator recovers." << endl;
+        {
+            void *p3 = mX.allocate(20);
+            ASSERT(p3);
+
+            ASSERT(1   == recR.d_numCalls);
+            ASSERT(&R  == recR.d_lastNode_p);
+            ASSERT(120 == recR.d_lastInUse);
+            ASSERT(1   == recX.d_numCalls);
+            ASSERT(&X  == recX.d_lastNode_p);
+            ASSERT(60  == recX.d_lastInUse);
+            ASSERT(120 == R.numBytesMax());
+            ASSERT(120 == R.numBytesTotal());
+            ASSERT(60  == X.numBytesMax());
+            ASSERT(60  == X.numBytesTotal());
+
+            mX.deallocate(p3);
+        }
+
+        mR.deallocate(p1);
+        mX.deallocate(p2);
+
+        ASSERT(0 == R.numBytesInUse());
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // PRINT METHOD
+        //
+        // Concerns:
+        //: 1 The 'print' method writes the name of the allocator and of its
+        //:   parent (if named), the byte counts, the limits (if any), and the
+        //:   number of rejections, in the intended format.
+        //:
+        //: 2 The 'print' method returns the supplied 'ostream'.
+        //
+        // Plan:
+        //: 1 Configure a named child of a named root with limits, allocate a
+        //:   block from it, and print both objects to an 'ostringstream'.
+        //:   Verify the output and the returned reference.  (C-1..2)
+        //
+        // Testing:
+        //   bsl::ostream& print(bsl::ostream& stream) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PRINT METHOD" << endl
+                          << "============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        Obj mR("root", &ta);
+        Obj mX(&mR, "child");  const Obj& X = mX;
+
+        mX.setSoftLimit(100);
+        mX.setHardLimit(200);
+
+        void *p = mX.allocate(64);
+
+        bsl::ostringstream os;
+        ASSERT(&os == &X.print(os));
+
+        const char *EXP = "----------------------------------------\n"
+                          "       Accounting Allocator State\n"
+                          "----------------------------------------\n"
+                          "Allocator name: child\n"
+                          "Parent name:    root\n"
+                          "Bytes in use:   64\n"
+                          "Bytes maximum:  64\n"
+                          "Bytes in total: 64\n"
+                          "Soft limit:     100\n"
+                          "Hard limit:     200\n"
+                          "Rejections:     0\n";
+
+        ASSERTV(os.str(), EXP == os.str());
+
+        bsl::ostringstream osR;
+        mR.print(osR);
+
+        const char *EXP_R = "----------------------------------------\n"
+                            "       Accounting Allocator State\n"
+                            "----------------------------------------\n"
+                            "Allocator name: root\n"
+                            "Bytes in use:   64\n"
+                            "Bytes maximum:  64\n"
+                            "Bytes in total: 64\n"
+                            "Rejections:     0\n";
+
+        ASSERTV(osR.str(), EXP_R == osR.str());
+
+        if (veryVerbose) { X.print(cout); }
+
+        mX.deallocate(p);
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // SOFT LIMITS
+        //
+        // Concerns:
+        //: 1 The soft limit of a node is initially disabled, and 'softLimit'
+        //:   returns the value last set.
+        //:
+        //: 2 The callback of a node is invoked, with the node and the
+        //:   installed context, when an allocation from the node or from a
+        //:   descendant takes its bytes in use beyond its soft limit.
+        //:
+        //: 3 The callback is invoked once per crossing, and not again until
+        //:   the bytes in use have fallen back to the soft limit.
+        //:
+        //: 4 An allocation exceeding a soft limit succeeds, and exceeding a
+        //:   soft limit without a callback has no effect.
+        //:
+        //: 5 Removing the callback, or disabling the limit, stops the
+        //:   notifications.
+        //
+        // Plan:
+        //: 1 Build a two-level tree, set soft limits and callbacks recording
+        //:   their invocations, and perform a sequence of allocations and
+        //:   deallocations, verifying the recorded invocations after each.
+        //:   (C-1..5)
+        //
+        // Testing:
+        //   void setSoftLimit(Int64 limit);
+        //   void setSoftLimitCallback(SoftLimitCallback callback, void *ctx);
+        //   Int64 softLimit() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "SOFT LIMITS" << endl
+                          << "===========" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        Obj mR("root", &ta);  const Obj& R = mR;
+        Obj mX(&mR, "child"); const Obj& X = mX;
+
+        ASSERT(Obj::k_NO_LIMIT == R.softLimit());
+        ASSERT(Obj::k_NO_LIMIT == X.softLimit());
+
+        CallbackRecord recR = { 0, 0, 0 };
+        CallbackRecord recX = { 0, 0, 0 };
+
+        mR.setSoftLimit(100);
+        mR.setSoftLimitCallback(&recordCallback, &recR);
+        ASSERT(100 == R.softLimit());
+
+        if (verbose) cout << "\tCrossing from a child." << endl;
+
+        void *p1 = mX.allocate(60);
+        ASSERT(0 == recR.d_numCalls);
+
+        void *p2 = mX.allocate(40);           // exactly at the limit
+        ASSERT(0 == recR.d_numCalls);
+
+        void *p3 = mX.allocate(1);            // crossing
+        ASSERT(p3);
+        ASSERT(1   == recR.d_numCalls);
+        ASSERT(&R  == recR.d_lastNode_p);
+        ASSERT(101 == recR.d_lastInUse);
+
+        void *p4 = mR.allocate(50);           // still beyond: no callback
+        ASSERT(1 == recR.d_numCalls);
+
+        if (verbose) cout << "\tRe-arming below the limit." << endl;
+
+        mR.deallocate(p4);
+        mX.deallocate(p3);                    // back at the limit
+        p3 = mX.allocate(8);                  // crossing anew
+        ASSERT(2 == recR.d_numCalls);
+
+        if (verbose) cout << "\tSoft limit of the child." << endl;
+
+        mX.setSoftLimit(200);
+        mX.setSoftLimitCallback(&recordCallback, &recX);
+
+        void *p5 = mX.allocate(100);          // child crosses 200
+        ASSERT(1  == recX.d_numCalls);
+        ASSERT(&X == recX.d_lastNode_p);
+        ASSERT(2  == recR.d_numCalls);
+
+        if (verbose) cout << "\tRemoving the callback." << endl;
+
+        mX.deallocate(p5);
+        mR.setSoftLimitCallback(0);
+        mX.setSoftLimit(Obj::k_NO_LIMIT);
+
+        mX.deallocate(p3);
+        p3 = mX.allocate(100);
+        ASSERT(2 == recR.d_numCalls);
+        ASSERT(1 == recX.d_numCalls);
+
+        mX.deallocate(p1);
+        mX.deallocate(p2);
+        mX.deallocate(p3);
+
+        ASSERT(0 == R.numBytesInUse());
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // HARD LIMITS
+        //
+        // Concerns:
+        //: 1 The hard limit of a node is initially disabled, and 'hardLimit'
+        //:   returns the value last set.
+        //:
+        //: 2 An allocation that would take the bytes in use of a node beyond
+        //:   its hard limit -- whether requested from that node or from a
+        //:   descendant -- throws 'bsl::bad_alloc', allocates no memory, and
+        //:   leaves every byte count of every node unchanged.
+        //:
+        //: 3 The rejection is counted by the node whose hard limit would have
+        //:   been exceeded, and by no other node.
+        //:
+        //: 4 An allocation taking the bytes in use exactly to the hard limit
+        //:   succeeds.
+        //:
+        //: 5 If the underlying allocator throws, the byte counts of all nodes
+        //:   are restored.
+        //:
+        //: 6 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Build a three-level tree, set hard limits on the leaf and on the
+        //:   root, and verify that allocations exceeding either are rejected
+        //:   with no effect, while allocations up to the limits succeed.
+        //:   (C-1..4)
+        //:
+        //: 2 Use the allocation limit of a 'bslma::TestAllocator' to make the
+        //:   underlying allocator throw, and verify the byte counts.  (C-5)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-6)
+        //
+        // Testing:
+        //   void setHardLimit(Int64 limit);
+        //   Int64 hardLimit() const;
+        //   Int64 numRejections() const;
+        //   CONCERN: Precondition violations are detected when enabled.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "HARD LIMITS" << endl
+                          << "===========" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        Obj mR("root", &ta);    const Obj& R = mR;
+        Obj mS(&mR, "session"); const Obj& S = mS;
+        Obj mX(&mS, "cache");   const Obj& X = mX;
+
+        ASSERT(Obj::k_NO_LIMIT == R.hardLimit());
+        ASSERT(Obj::k_NO_LIMIT == X.hardLimit());
+
+        mX.setHardLimit(100);   ASSERT(100 == X.hardLimit());
+        mR.setHardLimit(150);   ASSERT(150 == R.hardLimit());
+
+        if (verbose) cout << "\tLimit of the node itself." << endl;
+
+        void *p1 = mX.allocate(60);
+
+        ASSERT(true == isRejected(&mX, 41));
+        ASSERT(1  == X.numRejections());
+        ASSERT(0  == S.numRejections());
+        ASSERT(0  == R.numRejections());
+        ASSERT(60 == X.numBytesInUse());
+        ASSERT(60 == S.numBytesInUse());
+        ASSERT(60 == R.numBytesInUse());
+        ASSERT(60 == X.numBytesTotal());
+        ASSERT(60 == R.numBytesMax());
+        ASSERT(1  == ta.numBlocksInUse());
+
+        void *p2 = mX.allocate(40);           // exactly at the limit
+        ASSERT(100 == X.numBytesInUse());
+
+        if (verbose) cout << "\tLimit of an ancestor." << endl;
+
+        void *p3 = mS.allocate(50);           // root exactly at its limit
+        ASSERT(150 == R.numBytesInUse());
+
+        mX.deallocate(p2);
+        void *p4 = mS.allocate(40);           // root at its limit again
+
+        ASSERT(true == isRejected(&mX, 1));   // rejected by the root
+        ASSERT(1   == X.numRejections());
+        ASSERT(0   == S.numRejections());
+        ASSERT(1   == R.numRejections());
+        ASSERT(60  == X.numBytesInUse());
+        ASSERT(150 == S.numBytesInUse());
+        ASSERT(150 == R.numBytesInUse());
+        ASSERT(100 == X.numBytesTotal());
+        ASSERT(190 == R.numBytesTotal());
+        ASSERT(150 == R.numBytesMax());
+
+        mS.deallocate(p4);
+
+        if (verbose) cout << "\tRaising and disabling limits." << endl;
+
+        mR.setHardLimit(Obj::k_NO_LIMIT);
+        ASSERT(false == isRejected(&mX, 40));
+        ASSERT(true  == isRejected(&mX, 41));
+
+        mX.setHardLimit(1000);
+        ASSERT(false == isRejected(&mX, 900));
+
+        if (verbose) cout << "\tUnderlying allocator throws." << endl;
+        {
+            const Int64 IN_USE = R.numBytesInUse();
+
+            bool caught = false;
+
+            ta.setAllocationLimit(0);
+            try {
+                mX.allocate(8);
+            }
+            catch (const bslma::TestAllocatorException&) {
+                caught = true;
+            }
+            ta.setAllocationLimit(-1);
+
+            ASSERT(caught);
+
+            ASSERT(IN_USE == R.numBytesInUse());
+            ASSERT(IN_USE == S.numBytesInUse());
+            ASSERT(60     == X.numBytesInUse());
+        }
+
+        mX.deallocate(p1);
+        mS.deallocate(p3);
+
+        ASSERT(0 == X.numBytesInUse());
+        ASSERT(0 == S.numBytesInUse());
+        ASSERT(0 == R.numBytesInUse());
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_SAFE_PASS(mX.setHardLimit(0));
+            ASSERT_SAFE_PASS(mX.setHardLimit(Obj::k_NO_LIMIT));
+            ASSERT_SAFE_FAIL(mX.setHardLimit(-2));
+
+            ASSERT_SAFE_PASS(mX.setSoftLimit(0));
+            ASSERT_SAFE_PASS(mX.setSoftLimit(Obj::k_NO_LIMIT));
+            ASSERT_SAFE_FAIL(mX.setSoftLimit(-2));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // ALLOCATE AND DEALLOCATE
+        //
+        // Concerns:
+        //: 1 'allocate' returns a maximally-aligned block of (at least) the
+        //:   requested size, obtained from the underlying allocator.
+        //:
+        //: 2 Allocating 0 bytes returns 0 and has no effect, as does
+        //:   deallocating a null address.
+        //:
+        //: 3 The bytes allocated from a node are counted (in use, maximum,
+        //:   and total) by the node and by each of its ancestors, but not by
+        //:   its siblings or descendants.
+        //:
+        //: 4 'deallocate' returns the block to the underlying allocator, and
+        //:   reduces the bytes in use of the node and of its ancestors by the
+        //:   size originally requested.
+        //
+        // Plan:
+        //: 1 Build a three-level tree having two leaves, and perform a
+        //:   sequence of allocations and deallocations from each node,
+        //:   verifying the byte counts of every node and the blocks in use of
+        //:   the test allocator after each.  (C-1..4)
+        //
+        // Testing:
+        //   void *allocate(size_type size);
+        //   void deallocate(void *address);
+        //   Int64 numBytesInUse() const;
+        //   Int64 numBytesMax() const;
+        //   Int64 numBytesTotal() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ALLOCATE AND DEALLOCATE" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        Obj mR(&ta);                        const Obj& R = mR;
+        Obj mS(&mR, "session");             const Obj& S = mS;
+        Obj mA(&mS, "a");                   const Obj& A = mA;
+        Obj mB(&mS, "b");                   const Obj& B = mB;
+
+        ASSERT(0 == mA.allocate(0));
+        mA.deallocate(0);
+        ASSERT(0 == R.numBytesTotal());
+        ASSERT(0 == ta.numBlocksTotal());
+
+        void *pA = mA.allocate(10);
+        ASSERT(0 == bsls::AlignmentUtil::calculateAlignmentOffset(
+                                     pA,
+                                     bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT));
+        bsl::memset(pA, 0xa5, 10);
+        ASSERT(1  == ta.numBlocksInUse());
+        ASSERT(10 == A.numBytesInUse());  ASSERT(0  == B.numBytesInUse());
+        ASSERT(10 == S.numBytesInUse());  ASSERT(10 == R.numBytesInUse());
+
+        void *pB = mB.allocate(20);
+        ASSERT(10 == A.numBytesInUse());  ASSERT(20 == B.numBytesInUse());
+        ASSERT(30 == S.numBytesInUse());  ASSERT(30 == R.numBytesInUse());
+
+        void *pS = mS.allocate(5);
+        ASSERT(10 == A.numBytesInUse());  ASSERT(20 == B.numBytesInUse());
+        ASSERT(35 == S.numBytesInUse());  ASSERT(35 == R.numBytesInUse());
+
+        void *pR = mR.allocate(7);
+        ASSERT(35 == S.numBytesInUse());  ASSERT(42 == R.numBytesInUse());
+        ASSERT(4  == ta.numBlocksInUse());
+
+        mB.deallocate(pB);
+        ASSERT(10 == A.numBytesInUse());  ASSERT( 0 == B.numBytesInUse());
+        ASSERT(15 == S.numBytesInUse());  ASSERT(22 == R.numBytesInUse());
+        ASSERT(20 == B.numBytesMax());    ASSERT(42 == R.numBytesMax());
+        ASSERT(20 == B.numBytesTotal());  ASSERT(42 == R.numBytesTotal());
+
+        pB = mB.allocate(3);
+        ASSERT(20 == B.numBytesMax());    ASSERT(23 == B.numBytesTotal());
+        ASSERT(35 == S.numBytesMax());    ASSERT(38 == S.numBytesTotal());
+
+        mA.deallocate(pA);
+        mB.deallocate(pB);
+        mS.deallocate(pS);
+        mR.deallocate(pR);
+
+        ASSERT(0 == A.numBytesInUse());   ASSERT(0 == B.numBytesInUse());
+        ASSERT(0 == S.numBytesInUse());   ASSERT(0 == R.numBytesInUse());
+        ASSERT(45 == R.numBytesTotal());
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS
+        //
+        // Concerns:
+        //: 1 Each constructor creates a node having the specified name and
+        //:   parent (or none), no limits, no rejections, and zero byte
+        //:   counts.
+        //:
+        //: 2 A root uses the supplied allocator, or the default allocator if
+        //:   none is supplied.
+        //:
+        //: 3 A child uses the supplied allocator or, if none is supplied, the
+        //:   allocator of its parent.
+        //:
+        //: 4 No memory is allocated at construction.
+        //
+        // Plan:
+        //: 1 Create objects using each constructor, with and without an
+        //:   allocator, verify their initial state, allocate a block from
+        //:   each, and verify which allocator supplied it.  (C-1..4)
+        //
+        // Testing:
+        //   AccountingAllocator(Allocator *ba = 0);
+        //   AccountingAllocator(const char *name, Allocator *ba = 0);
+        //   AccountingAllocator(parent, const char *name, Allocator *ba = 0);
+        //   ~AccountingAllocator();
+        //   const char *name() const;
+        //   AccountingAllocator *parent() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS" << endl
+                          << "========" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+        bslma::TestAllocator tb("other",  veryVeryVeryVerbose);
+
+        {
+            Obj mX;                          const Obj& X = mX;
+            Obj mY("y", &ta);                const Obj& Y = mY;
+            Obj mZ(&mY, "z");                const Obj& Z = mZ;
+            Obj mW(&mY, 0, &tb);             const Obj& W = mW;
+            Obj mV(0, "v");                  const Obj& V = mV;
+
+            ASSERT(0 == da.numBlocksTotal());
+            ASSERT(0 == ta.numBlocksTotal());
+
+            ASSERT(0 == X.name());
+            ASSERT(0 == bsl::strcmp("y", Y.name()));
+            ASSERT(0 == bsl::strcmp("z", Z.name()));
+            ASSERT(0 == W.name());
+            ASSERT(0 == bsl::strcmp("v", V.name()));
+
+            ASSERT(0   == X.parent());
+            ASSERT(0   == Y.parent());
+            ASSERT(&mY == Z.parent());
+            ASSERT(&mY == W.parent());
+            ASSERT(0   == V.parent());
+
+            const Obj *OBJS[] = { &X, &Y, &Z, &W, &V };
+            for (int i = 0; i < 5; ++i) {
+                ASSERTV(i, Obj::k_NO_LIMIT == OBJS[i]->softLimit());
+                ASSERTV(i, Obj::k_NO_LIMIT == OBJS[i]->hardLimit());
+                ASSERTV(i, 0 == OBJS[i]->numBytesInUse());
+                ASSERTV(i, 0 == OBJS[i]->numBytesMax());
+                ASSERTV(i, 0 == OBJS[i]->numBytesTotal());
+                ASSERTV(i, 0 == OBJS[i]->numRejections());
+            }
+
+            mX.deallocate(mX.allocate(1));
+            ASSERT(1 == da.numBlocksTotal());
+
+            mY.deallocate(mY.allocate(1));
+            ASSERT(1 == ta.numBlocksTotal());
+
+            mZ.deallocate(mZ.allocate(1));
+            ASSERT(2 == ta.numBlocksTotal());
+
+            mW.deallocate(mW.allocate(1));
+            ASSERT(1 == tb.numBlocksTotal());
+            ASSERT(2 == ta.numBlocksTotal());
+
+            mV.deallocate(mV.allocate(1));
+            ASSERT(2 == da.numBlocksTotal());
+        }
+        ASSERT(0 == da.numBlocksInUse());
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == tb.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Build a two-level tree, allocate from the child, and verify the
+        //:   byte counts of both nodes; then exceed the hard limit of the
+        //:   root.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        Obj mR("root", &ta);
+        Obj mX(&mR, "child");
+
+        void *p = mX.allocate(100);
+        ASSERT(100 == mX.numBytesInUse());
+        ASSERT(100 == mR.numBytesInUse());
+
+        mR.setHardLimit(150);
+        ASSERT(true == isRejected(&mX, 51));
+        ASSERT(100  == mR.numBytesInUse());
+        ASSERT(1    == mR.numRejections());
+
+        mX.deallocate(p);
+        ASSERT(0 == mR.numBytesInUse());
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -6,6 +6,8 @@ BSLS_IDENT_RCSID(bdlma_bufferedsequentialallocator_cpp,"$Id$ $CSID$")
 
 #include <bsls_performancehint.h>
 
+#include <bsl_climits.h>  // 'INT_MAX'
+
 namespace BloombergLP {
 namespace bdlma {
 
@@ -30,6 +32,27 @@ void *BufferedSequentialAllocator::allocate(size_type size)
     return d_pool.allocate(size);
 }
 
+bool BufferedSequentialAllocator::expandSized(void      *address,
+                                              size_type  size,
+                                              size_type  newSize)
+{
+    BSLS_ASSERT(address);
+    BSLS_ASSERT(0 < size);
+    BSLS_ASSERT(size <= newSize);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                  newSize > static_cast<size_type>(INT_MAX))) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return false;                                                 // RETURN
+    }
+
+    const int newSizeAsInt = static_cast<int>(newSize);
+
+    return newSizeAsInt == d_pool.expand(address,
+                                         static_cast<int>(size),
+                                         newSizeAsInt);
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
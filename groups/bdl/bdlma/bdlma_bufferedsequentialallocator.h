@@ -24,7 +24,7 @@ BSLS_IDENT("$Id: $")
 //  ( bdlma::BufferedSequentialAllocator )
 //   `----------------------------------'
 //                   |        ctor/dtor
-//                   |
+//                   |        expandSized
 //                   V
 //       ,-----------------------.
 //      ( bdlma::ManagedAllocator )
@@ -329,6 +329,20 @@ class BufferedSequentialAllocator : public ManagedAllocator {
         // behavior is undefined unless 'address' is 0, or was allocated by
         // this allocator and has not already been deallocated.
 
+    virtual bool expandSized(void     *address,
+                             size_type size,
+                             size_type newSize);
+        // Extend, in place, the memory block at the specified 'address',
+        // having the specified 'size' (in bytes), to the specified 'newSize'
+        // (in bytes) if it is the block returned by the most recent allocation
+        // request from this allocator and the current buffer has at least
+        // 'newSize - size' bytes of free space remaining.  Return 'true' if
+        // the block was extended, and 'false' (with no effect) otherwise.
+        // The behavior is undefined unless the memory at 'address' was
+        // originally allocated by this allocator, the size of the memory
+        // block at 'address' is 'size', '0 < size <= newSize', and 'release'
+        // was not called after allocating the memory block at 'address'.
+
     virtual void release();
         // Release all memory currently allocated through this allocator.  This
         // method deallocates all memory (if any) allocated with the allocator
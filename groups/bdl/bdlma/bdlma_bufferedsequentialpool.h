@@ -314,6 +314,10 @@ BSLS_IDENT("$Id: $")
 #include <bsls_alignment.h>
 #endif
 
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
 #ifndef INCLUDED_BSLS_BLOCKGROWTH
 #include <bsls_blockgrowth.h>
 #endif
@@ -477,6 +481,20 @@ class BufferedSequentialPool {
         // effect as the 'deleteObjectRaw' method (since no deallocation is
         // involved), and exists for consistency across memory pools.
 
+    int expand(void *address, int originalSize, int newSize);
+        // Increase the amount of memory allocated at the specified 'address'
+        // of the specified 'originalSize' (in bytes) to the specified
+        // 'newSize', without moving it.  Return 'newSize' after expanding, or
+        // 'originalSize' if the memory block at 'address' cannot be expanded.
+        // This method can only 'expand' the memory block returned by the most
+        // recent 'allocate' request from this pool, and only if the current
+        // buffer has sufficient free space; otherwise it has no effect.  The
+        // behavior is undefined unless the memory at 'address' was originally
+        // allocated by this pool, the size of the memory block at 'address' is
+        // 'originalSize', '0 < originalSize', 'originalSize <= newSize', and
+        // 'release' was not called after allocating the memory block at
+        // 'address'.
+
     void release();
         // Release all memory currently allocated through this pool.  This
         // method deallocates all memory (if any) allocated with the allocator
@@ -589,6 +607,18 @@ void BufferedSequentialPool::deleteObject(const TYPE *object)
     deleteObjectRaw(object);
 }
 
+inline
+int BufferedSequentialPool::expand(void *address,
+                                   int   originalSize,
+                                   int   newSize)
+{
+    BSLS_ASSERT_SAFE(address);
+    BSLS_ASSERT_SAFE(0 < originalSize);
+    BSLS_ASSERT_SAFE(originalSize <= newSize);
+
+    return d_buffer.expand(address, originalSize, newSize);
+}
+
 inline
 void BufferedSequentialPool::release()
 {
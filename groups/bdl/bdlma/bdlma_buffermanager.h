@@ -26,6 +26,13 @@ BSLS_IDENT("$Id: $")
 // request, 'allocate' will return 0 while 'allocateRaw' will result in
 // undefined behavior.
 //
+// The alignment strategy specified at construction aligns blocks to at most
+// 'bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT'.  A block requiring a stricter
+// alignment (e.g., that of a cache line or a page) can be obtained using
+// 'allocateAligned', which takes the required alignment explicitly, and (like
+// 'allocate') returns 0 if the request cannot be satisfied from the remaining
+// free memory space in the external buffer.
+//
 // The behavior of 'allocate' and 'allocateRaw' illustrates the main difference
 // between this buffer manager and a sequential pool.  Once the external buffer
 // runs out of memory, the buffer manager does not self-replenish, whereas a
@@ -243,6 +250,10 @@ BSLS_IDENT("$Id: $")
 #include <bsls_alignment.h>
 #endif
 
+#ifndef INCLUDED_BSLS_ALIGNMENTUTIL
+#include <bsls_alignmentutil.h>
+#endif
+
 #ifndef INCLUDED_BSLS_ASSERT
 #include <bsls_assert.h>
 #endif
@@ -335,6 +346,16 @@ class BufferManager {
         // behavior is undefined unless '0 < size' and this object is currently
         // managing a buffer.
 
+    void *allocateAligned(bsls::Types::size_type size, int alignment);
+        // Return the address of a contiguous block of memory of the specified
+        // 'size' (in bytes) that is a multiple of the specified 'alignment' on
+        // success, and 0 if the allocation request (including the padding
+        // needed to reach 'alignment') exceeds the remaining free memory space
+        // in the external buffer.  The behavior is undefined unless
+        // '0 < size', 'alignment' is a positive, integral power of 2, and this
+        // object is currently managing a buffer.  Note that the alignment
+        // strategy specified at construction is ignored by this method.
+
     void *allocateRaw(int size);
         // Return the address of a contiguous block of memory of the specified
         // 'size' (in bytes) according to the alignment strategy specified at
@@ -368,6 +389,22 @@ class BufferManager {
         // 'address' is 'size', and 'release' was not called after allocating
         // the memory at 'address'.
 
+    int expand(void *address, int originalSize, int newSize);
+        // Increase the amount of memory allocated at the specified 'address'
+        // of the specified 'originalSize' (in bytes) to the specified
+        // 'newSize' (in bytes).  Return 'newSize' after expanding, or
+        // 'originalSize' if the memory at 'address' cannot be expanded.  This
+        // method can only 'expand' the memory block returned by the most
+        // recent 'allocate' or 'allocateRaw' request from this object, and
+        // only if the buffer has at least 'newSize - originalSize' bytes
+        // remaining; otherwise it has no effect.  The behavior is undefined
+        // unless the memory at 'address' was originally allocated by this
+        // buffer manager, the size of the memory at 'address' is
+        // 'originalSize', '0 < originalSize <= newSize', and 'release' was not
+        // called after allocating the memory at 'address'.  Note that, unlike
+        // the two-argument 'expand', this method never grows the block beyond
+        // 'newSize'.
+
     char *replaceBuffer(char *newBuffer, int newBufferSize);
         // Replace the buffer currently managed by this object with the
         // specified 'newBuffer' of the specified 'newBufferSize' (in bytes);
@@ -483,6 +520,33 @@ void *BufferManager::allocate(bsls::Types::size_type size)
                            static_cast<int>(size));
 }
 
+inline
+void *BufferManager::allocateAligned(bsls::Types::size_type size,
+                                     int                    alignment)
+{
+    BSLS_ASSERT_SAFE(0 < size);
+    BSLS_ASSERT_SAFE(0 < alignment);
+    BSLS_ASSERT_SAFE(0 == (alignment & (alignment - 1)));
+    BSLS_ASSERT_SAFE(d_buffer_p);
+    BSLS_ASSERT_SAFE(0 <= d_cursor);
+    BSLS_ASSERT_SAFE(d_cursor <= d_bufferSize);
+
+    const int offset = bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                        d_buffer_p + d_cursor,
+                                                        alignment);
+    const int available = d_bufferSize - d_cursor - offset;
+
+    if (available < 0
+     || static_cast<bsls::Types::size_type>(available) < size) {
+        return 0;                                                     // RETURN
+    }
+
+    char *result = d_buffer_p + d_cursor + offset;
+    d_cursor += offset + static_cast<int>(size);
+
+    return result;
+}
+
 inline
 void *BufferManager::allocateRaw(int size)
 {
@@ -54,10 +54,12 @@ using namespace bsl;
 //
 // // MANIPULATORS
 // [ 3] void *allocate(size_type size);
+// [12] void *allocateAligned(size_type size, int alignment);
 // [ 3] void *allocateRaw(int size);
 // [ 8] void deleteObjectRaw(const TYPE *object);
 // [ 8] void deleteObject(const TYPE *object);
 // [ 9] int expand(void *address, int size);
+// [11] int expand(void *address, int originalSize, int newSize);
 // [ 4] char *replaceBuffer(char *newBuffer, int newBufferSize);
 // [ 5] void release();
 // [ 6] void reset();
@@ -69,7 +71,7 @@ using namespace bsl;
 // [ 7] bool hasSufficientCapacity(int size) const;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [11] USAGE EXAMPLE
+// [13] USAGE EXAMPLE
 
 //=============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -369,7 +371,7 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
-      case 11: {
+      case 13: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -399,6 +401,249 @@ int main(int argc, char *argv[])
         result = detectNOccurrences(3, array, 5);
         ASSERT(false == result);
 
+      } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // ALIGNED ALLOCATION TEST
+        //
+        // Concerns:
+        //: 1 'allocateAligned' returns a block aligned to the requested
+        //:   alignment, including alignments exceeding the maximal alignment
+        //:   of the platform, regardless of the alignment strategy.
+        //:
+        //: 2 The block immediately follows the padding required to reach the
+        //:   alignment, so that no memory is needlessly consumed.
+        //:
+        //: 3 'allocateAligned' returns 0, with no effect, if the request
+        //:   (including padding) exceeds the remaining free memory space.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For each alignment strategy, and for each alignment from 1 to
+        //:   256, allocate a 1-byte block to misalign the cursor, then
+        //:   allocate an aligned block and verify its address.  Verify that a
+        //:   subsequent 1-byte block of byte alignment immediately follows it.
+        //:   (C-1..2)
+        //:
+        //: 2 Request an aligned block exceeding the remaining space, and
+        //:   verify that 0 is returned and that the next allocation is
+        //:   unaffected.  (C-3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   void *allocateAligned(size_type size, int alignment);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "ALIGNED ALLOCATION TEST"
+                          << endl << "=======================" << endl;
+
+        enum { k_BUFFER_SIZE = 1024 };
+
+        bsls::AlignedBuffer<k_BUFFER_SIZE> buffer;
+
+        const bsls::Alignment::Strategy STRATEGIES[] = {
+            bsls::Alignment::BSLS_NATURAL,
+            bsls::Alignment::BSLS_MAXIMUM,
+            bsls::Alignment::BSLS_BYTEALIGNED
+        };
+        const int NUM_STRATEGIES = sizeof STRATEGIES / sizeof *STRATEGIES;
+
+        for (int ti = 0; ti < NUM_STRATEGIES; ++ti) {
+            const bsls::Alignment::Strategy STRATEGY = STRATEGIES[ti];
+
+            for (int alignment = 1; alignment <= 256; alignment <<= 1) {
+                Obj mX(buffer.buffer(), k_BUFFER_SIZE, STRATEGY);
+
+                char *p = static_cast<char *>(mX.allocate(1));
+                ASSERTV(ti, alignment, buffer.buffer() == p);
+
+                char *q = static_cast<char *>(mX.allocateAligned(8,
+                                                                 alignment));
+                ASSERTV(ti, alignment, q);
+                ASSERTV(ti, alignment, 0 ==
+                        bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                                  q,
+                                                                  alignment));
+                ASSERTV(ti, alignment, q - p >= 1);
+                ASSERTV(ti, alignment, q - p <= (alignment > 1
+                                                 ? alignment
+                                                 : 1));
+
+                char *r = static_cast<char *>(mX.allocateAligned(1, 1));
+                ASSERTV(ti, alignment, q + 8 == r);
+            }
+        }
+
+        if (verbose) cout << "\nTesting requests exceeding the buffer."
+                          << endl;
+        {
+            enum { k_USED = k_BUFFER_SIZE - 96 };
+
+            Obj mX(buffer.buffer(), k_BUFFER_SIZE);
+
+            ASSERT(0 != mX.allocate(k_USED));
+
+            const int OFFSET = bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                      buffer.buffer() + k_USED,
+                                                      64);
+
+            ASSERT(0 == mX.allocateAligned(97, 1));
+            ASSERT(0 == mX.allocateAligned(96 - OFFSET + 1, 64));
+
+            char *p = static_cast<char *>(mX.allocateAligned(96 - OFFSET, 64));
+            ASSERT(buffer.buffer() + k_USED + OFFSET == p);
+
+            ASSERT(0 == mX.allocateAligned(1, 1));
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(buffer.buffer(), k_BUFFER_SIZE);
+            Obj mY;
+
+            ASSERT_SAFE_PASS(mX.allocateAligned(8, 64));
+            ASSERT_SAFE_FAIL(mX.allocateAligned(0, 64));
+            ASSERT_SAFE_FAIL(mX.allocateAligned(8,  0));
+            ASSERT_SAFE_FAIL(mX.allocateAligned(8, 48));
+            ASSERT_SAFE_FAIL(mY.allocateAligned(8, 64));
+        }
+      } break;
+      case 11: {
+        // --------------------------------------------------------------------
+        // EXPAND TO SIZE TEST
+        //
+        // Concerns:
+        //   1. That the three-argument 'expand' grows the most recently
+        //      allocated block to exactly 'newSize', and returns 'newSize'.
+        //
+        //   2. That 'expand' returns 'originalSize', with no effect, if the
+        //      block is not the most recent allocation, or if the buffer has
+        //      insufficient space remaining.
+        //
+        //   3. QoI: Asserted precondition violations are detected when
+        //      enabled.
+        //
+        // Plan:
+        //   For concerns 1 and 2, using the table-driven technique, allocate
+        //   a block of an initial size from a buffer of a given size, attempt
+        //   to expand it to a new size, and verify the return value and the
+        //   offset of a subsequent 1-byte allocation.  Then, verify that
+        //   expanding a block that is no longer the most recent allocation
+        //   fails.
+        //
+        //   For concern 3, verify that, in appropriate build modes, defensive
+        //   checks are triggered.
+        //
+        // Testing:
+        //   int expand(void *address, int originalSize, int newSize);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "EXPAND TO SIZE TEST" << endl
+                                  << "===================" << endl;
+
+        char *buffer = bufferStorage.buffer();
+
+        static const struct {
+            int  d_line;         // line number
+            int  d_bufferSize;   // size of buffer
+            int  d_initialSize;  // size of initial allocation request
+            int  d_newSize;      // requested expanded size
+            int  d_expSize;      // expected return value
+        } DATA[] = {
+            // LINE   BUFSIZE   INITIALSIZE   NEWSIZE   EXPSIZE
+            // ----   -------   -----------   -------   -------
+            {  L_,         8,            1,        1,        1 },
+            {  L_,         8,            1,        2,        2 },
+            {  L_,         8,            1,        7,        7 },
+            {  L_,         8,            1,        8,        8 },
+            {  L_,         8,            1,        9,        1 },
+            {  L_,         8,            8,        8,        8 },
+            {  L_,         8,            8,        9,        8 },
+            {  L_,        16,            4,       12,       12 },
+            {  L_,        16,            4,       16,       16 },
+            {  L_,        16,            4,       17,        4 },
+            {  L_,        16,           15,       16,       16 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE        = DATA[ti].d_line;
+            const int BUFSIZE     = DATA[ti].d_bufferSize;
+            const int INITIALSIZE = DATA[ti].d_initialSize;
+            const int NEWSIZE     = DATA[ti].d_newSize;
+            const int EXPSIZE     = DATA[ti].d_expSize;
+
+            if (veryVerbose) {
+                T_ P_(LINE) P_(BUFSIZE) P_(INITIALSIZE) P_(NEWSIZE) P(EXPSIZE)
+            }
+
+            Obj mX(buffer, BUFSIZE, bsls::Alignment::BSLS_BYTEALIGNED);
+
+            void *addr1 = mX.allocate(INITIALSIZE);
+            ASSERTV(LINE, &buffer[0] == addr1);
+
+            int ret = mX.expand(addr1, INITIALSIZE, NEWSIZE);
+            ASSERTV(LINE, EXPSIZE, ret, EXPSIZE == ret);
+
+            void *addr2 = mX.allocate(1);
+            if (EXPSIZE < BUFSIZE) {
+                ASSERTV(LINE, &buffer[0] + EXPSIZE == addr2);
+
+                // Expanding a block that is no longer the most recent
+                // allocation fails.
+
+                ret = mX.expand(addr1, EXPSIZE, EXPSIZE + 1);
+                ASSERTV(LINE, ret, EXPSIZE == ret);
+            }
+            else {
+                ASSERTV(LINE, 0 == addr2);
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            if (veryVerbose) cout << "\t'0 != address'" << endl;
+            {
+                Obj mX(buffer, BUFFER_SIZE);
+
+                void *addr = mX.allocate(2);
+
+                ASSERT_SAFE_PASS(mX.expand(addr, 2, 3));
+
+                ASSERT_SAFE_FAIL(mX.expand(   0, 1, 2));
+            }
+
+            if (veryVerbose) cout << "\t'0 < originalSize'" << endl;
+            {
+                Obj mX(buffer, BUFFER_SIZE);
+
+                void *addr = mX.allocate(2);
+                (void)addr;
+
+                ASSERT_SAFE_FAIL(mX.expand(addr, 0, 2));
+            }
+
+            if (veryVerbose) cout << "\t'originalSize <= newSize'" << endl;
+            {
+                Obj mX(buffer, BUFFER_SIZE);
+
+                void *addr = mX.allocate(2);
+
+                ASSERT_SAFE_PASS(mX.expand(addr, 2, 2));
+
+                ASSERT_SAFE_FAIL(mX.expand(addr, 2, 1));
+            }
+        }
+
       } break;
       case 10: {
         // --------------------------------------------------------------------
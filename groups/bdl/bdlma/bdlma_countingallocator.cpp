@@ -34,9 +34,9 @@ const bslma::Allocator::size_type OFFSET =
 // CREATORS
 CountingAllocator::CountingAllocator(Allocator *basicAllocator)
 : d_name_p(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
 , d_numBytesInUse(0)
 , d_numBytesTotal(0)
-, d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     BSLS_ASSERT(0 == name());
     BSLS_ASSERT(0 == numBytesInUse());
@@ -47,9 +47,9 @@ CountingAllocator::CountingAllocator(Allocator *basicAllocator)
 CountingAllocator::CountingAllocator(const char *name,
                                      Allocator  *basicAllocator)
 : d_name_p(name)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
 , d_numBytesInUse(0)
 , d_numBytesTotal(0)
-, d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     BSLS_ASSERT(0 != this->name());
     BSLS_ASSERT(0 == numBytesInUse());
@@ -81,8 +81,8 @@ void *CountingAllocator::allocate(size_type size)
 
     void *address = d_allocator_p->allocate(totalSize);
 
-    d_numBytesInUse.addRelaxed(static_cast<bsls::Types::Int64>(size));
-    d_numBytesTotal.addRelaxed(static_cast<bsls::Types::Int64>(size));
+    d_numBytesInUse.add(static_cast<bsls::Types::Int64>(size));
+    d_numBytesTotal.add(static_cast<bsls::Types::Int64>(size));
 
     *static_cast<size_type *>(address) = size;
 
@@ -100,7 +100,7 @@ void CountingAllocator::deallocate(void *address)
 
     const size_type recordedSize = *static_cast<size_type *>(address);
 
-    d_numBytesInUse.addRelaxed(-static_cast<bsls::Types::Int64>(recordedSize));
+    d_numBytesInUse.add(-static_cast<bsls::Types::Int64>(recordedSize));
 
     d_allocator_p->deallocate(address);
 }
@@ -65,6 +65,26 @@
 // 'bsldoc_glossary') provided that the underlying allocator (established at
 // construction) is fully thread-safe.
 //
+// The byte counts, written by every call to 'allocate' and 'deallocate', are
+// 'bsls::ShardedCounter' objects: each thread updates its own shard of the
+// counts, alone in its cache line, so that threads allocating concurrently do
+// not contend on the counts (see 'bsls_shardedcounter').  'numBytesInUse' and
+// 'numBytesTotal' sum the shards, and are therefore more costly than
+// 'allocate' and 'deallocate'.
+//
+// The shards are read one at a time, with relaxed memory ordering, so the
+// byte counts read while other threads allocate or deallocate are only
+// approximate: a shard updated during the summation may or may not be
+// accounted for, and a block allocated by one thread and deallocated by
+// another is charged to one shard and credited to a different one.  In
+// particular, 'numBytesInUse' may then briefly return a negative value, or a
+// value inconsistent with that returned by 'numBytesTotal'.  The counts are
+// exact whenever no other thread is using the allocator.
+//
+// Note that each 'bsls::ShardedCounter' is about two kilobytes in size on
+// common platforms, so that a counting allocator, which holds two of them, is
+// about four kilobytes in size.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -272,8 +292,8 @@
 #include <bslma_allocator.h>
 #endif
 
-#ifndef INCLUDED_BSLS_ATOMIC
-#include <bsls_atomic.h>
+#ifndef INCLUDED_BSLS_SHARDEDCOUNTER
+#include <bsls_shardedcounter.h>
 #endif
 
 #ifndef INCLUDED_BSLS_TYPES
@@ -306,16 +326,17 @@ class CountingAllocator : public bslma::Allocator {
     // that it is fully thread-safe.
 
     // DATA
-    const char        *d_name_p;         // optionally specified name of this
-                                         // allocator object (or 0)
+    const char           *d_name_p;         // optionally specified name of
+                                            // this allocator object (or 0)
 
-    bsls::AtomicInt64  d_numBytesInUse;  // number of bytes currently allocated
-                                         // from this object
+    bslma::Allocator     *d_allocator_p;    // memory allocator (held, not
+                                            // owned)
 
-    bsls::AtomicInt64  d_numBytesTotal;  // cumulative number of bytes ever
-                                         // allocated from this object
+    bsls::ShardedCounter  d_numBytesInUse;  // number of bytes currently
+                                            // allocated from this object
 
-    bslma::Allocator  *d_allocator_p;    // memory allocator (held, not owned)
+    bsls::ShardedCounter  d_numBytesTotal;  // cumulative number of bytes ever
+                                            // allocated from this object
 
   private:
     // NOT IMPLEMENTED
@@ -366,11 +387,15 @@ class CountingAllocator : public bslma::Allocator {
 
     bsls::Types::Int64 numBytesInUse() const;
         // Return the number of bytes currently allocated from this object.
-        // Note that 'numBytesInUse() <= numBytesTotal()'.
+        // Note that 'numBytesInUse() <= numBytesTotal()' if no other thread
+        // is using this object; otherwise, the returned value is approximate,
+        // and may be negative (see {Thread Safety}).
 
     bsls::Types::Int64 numBytesTotal() const;
         // Return the cumulative number of bytes ever allocated from this
-        // object.  Note that 'numBytesInUse() <= numBytesTotal()'.
+        // object.  Note that 'numBytesInUse() <= numBytesTotal()' if no other
+        // thread is using this object; otherwise, the returned value is
+        // approximate (see {Thread Safety}).
 
     bsl::ostream& print(bsl::ostream& stream) const;
         // Write the accumulated state information held in this allocator to
@@ -396,13 +421,13 @@ const char *CountingAllocator::name() const
 inline
 bsls::Types::Int64 CountingAllocator::numBytesInUse() const
 {
-    return d_numBytesInUse.loadRelaxed();
+    return d_numBytesInUse.load();
 }
 
 inline
 bsls::Types::Int64 CountingAllocator::numBytesTotal() const
 {
-    return d_numBytesTotal.loadRelaxed();
+    return d_numBytesTotal.load();
 }
 
 }  // close package namespace
@@ -0,0 +1,287 @@
+// bdlma_epochreclaimer.cpp                                           -*-C++-*-
+#include <bdlma_epochreclaimer.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_epochreclaimer_cpp,"$Id$ $CSID$")
+
+#include <bsls_assert.h>
+
+#include <bsl_algorithm.h>
+
+// IMPLEMENTATION NOTES: The list of participants, the orphaned objects, and
+// the global epoch are modified only while the lock of the reclaimer is held,
+// so that at most one thread at a time advances the epoch.  The state word of
+// each participant, its hazard pointer slots, and the global epoch are
+// accessed using sequentially consistent operations wherever a store must be
+// ordered before a subsequent load in another location (the announcement of
+// an epoch before reading shared data, the publication of a hazard pointer
+// before re-reading its source, and the unlinking of an object before the
+// scan that decides whether it can be disposed of).
+
+namespace BloombergLP {
+namespace bdlma {
+
+                            // --------------------
+                            // class EpochReclaimer
+                            // --------------------
+
+// PRIVATE MANIPULATORS
+bsls::Types::Int64 EpochReclaimer::advance()
+{
+    const bsls::Types::Int64 epoch = d_epoch.load();
+    const bsls::Types::Int64 state = 2 * epoch + 1;
+
+    for (const EpochReclaimerParticipant *participant = d_participants_p;
+         participant;
+         participant = participant->d_next_p) {
+        const bsls::Types::Int64 announced = participant->d_state.load();
+        if (0 != announced && state != announced) {
+            return epoch;                                             // RETURN
+        }
+    }
+
+    d_epoch = epoch + 1;
+    return epoch + 1;
+}
+
+// PRIVATE ACCESSORS
+bool EpochReclaimer::isProtected(const void *address) const
+{
+    for (const EpochReclaimerParticipant *participant = d_participants_p;
+         participant;
+         participant = participant->d_next_p) {
+        for (int i = 0; i < k_NUM_HAZARD_POINTERS; ++i) {
+            if (address == bsls::AtomicOperations::getPtr(
+                                               &participant->d_hazards[i])) {
+                return true;                                          // RETURN
+            }
+        }
+    }
+    return false;
+}
+
+// CREATORS
+EpochReclaimer::EpochReclaimer(bslma::Allocator *basicAllocator)
+: d_epoch(0)
+, d_participants_p(0)
+, d_numParticipants(0)
+, d_orphans(basicAllocator)
+, d_reclaimThreshold(k_DEFAULT_RECLAIM_THRESHOLD)
+{
+}
+
+EpochReclaimer::EpochReclaimer(int               reclaimThreshold,
+                               bslma::Allocator *basicAllocator)
+: d_epoch(0)
+, d_participants_p(0)
+, d_numParticipants(0)
+, d_orphans(basicAllocator)
+, d_reclaimThreshold(reclaimThreshold)
+{
+    BSLS_ASSERT(0 < reclaimThreshold);
+}
+
+EpochReclaimer::~EpochReclaimer()
+{
+    BSLS_ASSERT(0 == d_participants_p);
+    BSLS_ASSERT(0 == d_numParticipants);
+
+    for (bsl::size_t i = 0; i < d_orphans.size(); ++i) {
+        const EpochReclaimer_Entry& entry = d_orphans[i];
+        entry.d_deleter(entry.d_object_p, entry.d_context_p);
+    }
+}
+
+// ACCESSORS
+int EpochReclaimer::numParticipants() const
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    return d_numParticipants;
+}
+
+                      // -------------------------------
+                      // class EpochReclaimerParticipant
+                      // -------------------------------
+
+// PRIVATE CLASS METHODS
+void EpochReclaimerParticipant::deallocateBlock(void *address,
+                                                void *allocator)
+{
+    static_cast<bslma::Allocator *>(allocator)->deallocate(address);
+}
+
+// CREATORS
+EpochReclaimerParticipant::EpochReclaimerParticipant(
+                                            EpochReclaimer   *reclaimer,
+                                            bslma::Allocator *basicAllocator)
+: d_state(0)
+, d_depth(0)
+, d_isReclaiming(false)
+, d_reclaimSize(reclaimer->reclaimThreshold())
+, d_retired(basicAllocator)
+, d_ready(basicAllocator)
+, d_reclaimer_p(reclaimer)
+, d_next_p(0)
+{
+    BSLS_ASSERT(reclaimer);
+
+    for (int i = 0; i < EpochReclaimer::k_NUM_HAZARD_POINTERS; ++i) {
+        bsls::AtomicOperations::initPointer(&d_hazards[i], 0);
+    }
+
+    d_retired.reserve(d_reclaimSize);
+
+    bsls::BslLockGuard guard(&d_reclaimer_p->d_lock);
+
+    d_next_p                        = d_reclaimer_p->d_participants_p;
+    d_reclaimer_p->d_participants_p = this;
+    ++d_reclaimer_p->d_numParticipants;
+}
+
+EpochReclaimerParticipant::~EpochReclaimerParticipant()
+{
+    BSLS_ASSERT(0 == d_depth);
+
+    for (int i = 0; i < EpochReclaimer::k_NUM_HAZARD_POINTERS; ++i) {
+        unprotect(i);
+    }
+
+    if (!d_retired.empty()) {
+        reclaim();
+    }
+
+    bsls::BslLockGuard guard(&d_reclaimer_p->d_lock);
+
+    EpochReclaimerParticipant **link = &d_reclaimer_p->d_participants_p;
+    while (*link != this) {
+        BSLS_ASSERT(*link);
+
+        link = &(*link)->d_next_p;
+    }
+    *link = d_next_p;
+    --d_reclaimer_p->d_numParticipants;
+
+    d_reclaimer_p->d_orphans.insert(d_reclaimer_p->d_orphans.end(),
+                                    d_retired.begin(),
+                                    d_retired.end());
+}
+
+// MANIPULATORS
+void EpochReclaimerParticipant::enter()
+{
+    if (0 != d_depth++) {
+        return;                                                       // RETURN
+    }
+
+    // Announce the current global epoch.  If the epoch advanced before the
+    // announcement became visible, announce the new epoch instead, so that a
+    // stale announcement does not hold back the next advance.
+
+    bsls::Types::Int64 epoch = d_reclaimer_p->d_epoch.loadRelaxed();
+    for (;;) {
+        d_state = 2 * epoch + 1;
+
+        const bsls::Types::Int64 current = d_reclaimer_p->d_epoch.load();
+        if (current == epoch) {
+            return;                                                   // RETURN
+        }
+        epoch = current;
+    }
+}
+
+int EpochReclaimerParticipant::reclaim()
+{
+    if (d_isReclaiming) {
+        // Called (indirectly) from a deleter; the outer call will complete.
+
+        return 0;                                                     // RETURN
+    }
+
+    BSLS_ASSERT(d_ready.empty());
+
+    {
+        bsls::BslLockGuard guard(&d_reclaimer_p->d_lock);
+
+        const bsls::Types::Int64 epoch = d_reclaimer_p->advance();
+
+        bsl::vector<EpochReclaimer_Entry>& orphans = d_reclaimer_p->d_orphans;
+        if (!orphans.empty()) {
+            d_retired.insert(d_retired.end(), orphans.begin(), orphans.end());
+            orphans.clear();
+        }
+
+        d_ready.reserve(d_retired.size());
+
+        bsl::size_t numPending = 0;
+        for (bsl::size_t i = 0; i < d_retired.size(); ++i) {
+            const EpochReclaimer_Entry& entry = d_retired[i];
+            if (entry.d_epoch + 2 <= epoch
+             && !d_reclaimer_p->isProtected(entry.d_object_p)) {
+                d_ready.push_back(entry);
+            }
+            else {
+                d_retired[numPending++] = entry;
+            }
+        }
+        d_retired.resize(numPending);
+    }
+
+    d_reclaimSize = bsl::max(
+                   static_cast<bsl::size_t>(d_reclaimer_p->reclaimThreshold()),
+                   2 * d_retired.size());
+
+    // Dispose of the objects without holding the lock, as a deleter may
+    // retire further objects.
+
+    d_isReclaiming = true;
+
+    const int numReclaimed = static_cast<int>(d_ready.size());
+    for (int i = 0; i < numReclaimed; ++i) {
+        const EpochReclaimer_Entry& entry = d_ready[i];
+        entry.d_deleter(entry.d_object_p, entry.d_context_p);
+    }
+    d_ready.clear();
+
+    d_isReclaiming = false;
+
+    return numReclaimed;
+}
+
+void EpochReclaimerParticipant::retire(void                    *object,
+                                       EpochReclaimer::Deleter  deleter,
+                                       void                    *context)
+{
+    BSLS_ASSERT(deleter);
+
+    EpochReclaimer_Entry entry;
+    entry.d_object_p  = object;
+    entry.d_deleter   = deleter;
+    entry.d_context_p = context;
+    entry.d_epoch     = d_reclaimer_p->d_epoch.load();
+
+    d_retired.push_back(entry);
+
+    if (d_retired.size() >= d_reclaimSize) {
+        reclaim();
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,760 @@
+// bdlma_epochreclaimer.h                                             -*-C++-*-
+#ifndef INCLUDED_BDLMA_EPOCHRECLAIMER
+#define INCLUDED_BDLMA_EPOCHRECLAIMER
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide epoch-based reclamation of memory shared between threads.
+//
+//@CLASSES:
+//  bdlma::EpochReclaimer: domain of threads sharing retired memory
+//  bdlma::EpochReclaimerParticipant: per-thread handle on a reclaimer
+//  bdlma::EpochReclaimerGuard: critical section of a participant
+//
+//@SEE_ALSO: bsls_atomicoperations, bslma_allocator
+//
+//@DESCRIPTION: This component provides a mechanism, 'bdlma::EpochReclaimer',
+// that decides when memory removed from a lock-free data structure may be
+// returned to its allocator, along with a per-thread handle,
+// 'bdlma::EpochReclaimerParticipant', and a scoped guard,
+// 'bdlma::EpochReclaimerGuard'.  A thread that reads a shared structure does
+// so inside a *critical* *section* of its participant; a thread that unlinks
+// a node from the structure *retires* it through its participant instead of
+// deallocating it.  A retired node is deallocated (or otherwise disposed of)
+// only once no thread can still hold a reference to it.
+//
+// Each participant belongs to a single thread; all of its methods must be
+// called from that thread.  Participants register with a reclaimer at
+// construction and deregister at destruction.
+//
+///Epochs
+///------
+// A reclaimer maintains a global *epoch* counter.  On entering a critical
+// section a participant announces the current global epoch, and on leaving it
+// withdraws that announcement.  The global epoch advances only when every
+// participant inside a critical section has announced the current epoch.  A
+// node retired during epoch 'e' is therefore unreachable by all readers once
+// the global epoch reaches 'e + 2', since any reader that obtained a
+// reference to it before it was unlinked has left its critical section.
+//
+// Critical sections nest: only the outermost 'enter' and 'leave' of a
+// participant announce and withdraw its epoch.  Entering and leaving a
+// critical section each cost a single store (followed by a load, on entry) to
+// a word owned by the participant; readers perform no read-modify-write
+// operations on shared memory.
+//
+///Hazard Pointers
+///---------------
+// A thread that must hold a reference to a node for a long time (for example,
+// across a blocking call) would, inside a critical section, prevent the epoch
+// from advancing and thereby delay all reclamation.  Instead, such a thread
+// may publish the address of the node in one of the 'k_NUM_HAZARD_POINTERS'
+// *hazard* *pointer* slots of its participant, using 'protect', and leave (or
+// never enter) the critical section.  A retired node
+// whose address is published in any hazard pointer slot is not disposed of,
+// regardless of the epoch, until the slot is cleared with 'unprotect'.
+//
+///Reclamation
+///-----------
+// Retired nodes are recorded in a list owned by the retiring participant.
+// When the number of nodes in that list reaches the 'reclaimThreshold'
+// supplied to the reclaimer at construction, the participant attempts to
+// advance the global epoch, and then disposes of every node in its list that
+// was retired at least two epochs earlier and is not protected by a hazard
+// pointer.  Reclamation may also be requested explicitly with 'reclaim'.
+//
+// Provided that critical sections are short, and hazard pointers are not
+// held indefinitely, the number of nodes pending in the list of a participant
+// therefore remains bounded by a small multiple of the reclaim threshold, and
+// every retired node is disposed of after at most that many further calls to
+// 'retire' by its participant.  If nodes remain pending after a reclamation
+// attempt (because some thread is slow to leave its critical section),
+// further attempts are made only once the list has grown to twice its size
+// after the last attempt, so that the amortized cost of 'retire' remains
+// constant.
+//
+// Nodes still pending when a participant is destroyed are handed over to the
+// reclaimer, and are disposed of by a later reclamation attempt of another
+// participant or, at the latest, when the reclaimer is destroyed.
+//
+///Thread Safety
+///-------------
+// 'bdlma::EpochReclaimer' is fully thread-safe.  A
+// 'bdlma::EpochReclaimerParticipant' (and any 'bdlma::EpochReclaimerGuard'
+// using it) may be used only by the thread that created it, although it may
+// be created and destroyed concurrently with other participants of the same
+// reclaimer.  Reclamation attempts and the creation and destruction of
+// participants are serialized by a lock internal to the reclaimer; entering
+// and leaving critical sections, and publishing hazard pointers, take no
+// lock.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: A Lock-Free Stack
+/// - - - - - - - - - - - - - -
+// Suppose we want a stack of 'int' values that can be pushed and popped
+// concurrently without a lock.  Without a reclamation scheme, a popping
+// thread could not deallocate the node it removed, since another thread may
+// be reading the same node concurrently.
+//
+// First, we define the node type and the stack, which holds its top node in a
+// 'bsls::AtomicPointer':
+//..
+//  struct my_Node {
+//      int      d_value;
+//      my_Node *d_next_p;
+//  };
+//
+//  class my_Stack {
+//      // This class provides a lock-free stack of 'int' values.
+//
+//      // DATA
+//      bsls::AtomicPointer<my_Node>  d_top;          // top of stack
+//      bslma::Allocator             *d_allocator_p;  // held, not owned
+//
+//    public:
+//      // CREATORS
+//      explicit my_Stack(bslma::Allocator *basicAllocator = 0)
+//      : d_top(0)
+//      , d_allocator_p(bslma::Default::allocator(basicAllocator))
+//      {
+//      }
+//
+//      ~my_Stack()
+//      {
+//          while (my_Node *node = d_top.loadRelaxed()) {
+//              d_top.storeRelaxed(node->d_next_p);
+//              d_allocator_p->deallocate(node);
+//          }
+//      }
+//
+//      // MANIPULATORS
+//      void push(int value)
+//      {
+//          my_Node *node = static_cast<my_Node *>(
+//                                  d_allocator_p->allocate(sizeof(my_Node)));
+//          node->d_value = value;
+//
+//          my_Node *top = d_top.loadRelaxed();
+//          do {
+//              node->d_next_p = top;
+//              my_Node *previous = d_top.testAndSwapAcqRel(top, node);
+//              if (previous == top) {
+//                  break;
+//              }
+//              top = previous;
+//          } while (true);
+//      }
+//..
+// Then, we implement 'pop'.  The node is read inside a critical section of
+// the calling thread's participant, so that it cannot be deallocated by
+// another thread while it is being read, and, once unlinked, it is retired
+// rather than deallocated:
+//..
+//      bool pop(int                              *value,
+//               bdlma::EpochReclaimerParticipant *participant)
+//      {
+//          bdlma::EpochReclaimerGuard guard(participant);
+//
+//          my_Node *top = d_top.loadAcquire();
+//          while (top) {
+//              my_Node *previous = d_top.testAndSwapAcqRel(top,
+//                                                           top->d_next_p);
+//              if (previous == top) {
+//                  *value = top->d_value;
+//                  participant->retire(top, d_allocator_p);
+//                  return true;
+//              }
+//              top = previous;
+//          }
+//          return false;
+//      }
+//  };
+//..
+// Next, we create a reclaimer, with a small reclaim threshold to make
+// reclamation visible in this example, and a stack that obtains its nodes
+// from a test allocator:
+//..
+//  bslma::TestAllocator  ta;
+//  bdlma::EpochReclaimer reclaimer(4);
+//  my_Stack              stack(&ta);
+//..
+// Then, each thread using the stack creates its own participant (here, we use
+// only one thread):
+//..
+//  bdlma::EpochReclaimerParticipant participant(&reclaimer);
+//
+//  for (int i = 0; i < 8; ++i) {
+//      stack.push(i);
+//  }
+//  const bsls::Types::Int64 numBlocks = ta.numBlocksInUse();
+//..
+// Now, we pop the values.  The popped nodes are not deallocated immediately,
+// but once enough nodes have been retired the participant reclaims them:
+//..
+//  int value;
+//  for (int i = 7; i >= 0; --i) {
+//      assert(true == stack.pop(&value, &participant));
+//      assert(i    == value);
+//  }
+//  assert(false == stack.pop(&value, &participant));
+//
+//  assert(numBlocks - 8 <  ta.numBlocksInUse());
+//  assert(numBlocks     >  ta.numBlocksInUse());
+//..
+// Finally, we request reclamation explicitly.  Since no thread is in a
+// critical section, at most two attempts are needed to dispose of all retired
+// nodes:
+//..
+//  participant.reclaim();
+//  participant.reclaim();
+//
+//  assert(0             == participant.numRetired());
+//  assert(numBlocks - 8 == ta.numBlocksInUse());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DELETERHELPER
+#include <bslma_deleterhelper.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMICOPERATIONS
+#include <bsls_atomicoperations.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLLOCK
+#include <bsls_bsllock.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+class EpochReclaimerParticipant;
+
+                        // ===========================
+                        // struct EpochReclaimer_Entry
+                        // ===========================
+
+struct EpochReclaimer_Entry {
+    // This component-private 'struct' describes one retired object.
+
+    // DATA
+    void               *d_object_p;                  // retired object
+    void              (*d_deleter)(void *, void *);  // disposes of object
+    void               *d_context_p;                 // passed to deleter
+    bsls::Types::Int64  d_epoch;                     // epoch of retirement
+};
+
+                            // ====================
+                            // class EpochReclaimer
+                            // ====================
+
+class EpochReclaimer {
+    // This class provides a domain in which threads, each through its own
+    // 'EpochReclaimerParticipant', share access to objects that are retired
+    // rather than destroyed when unlinked, and disposed of once no
+    // participant can still refer to them.
+
+  public:
+    // TYPES
+    typedef void (*Deleter)(void *object, void *context);
+        // 'Deleter' is an alias for a function disposing of the specified
+        // retired 'object', given the specified 'context' supplied when the
+        // object was retired.
+
+    enum {
+        k_DEFAULT_RECLAIM_THRESHOLD = 64,  // default number of retired
+                                           // objects triggering reclamation
+
+        k_NUM_HAZARD_POINTERS       = 2    // hazard pointer slots of each
+                                           // participant
+    };
+
+  private:
+    // DATA
+    bsls::AtomicInt64                 d_epoch;            // global epoch
+
+    mutable bsls::BslLock             d_lock;             // serializes
+                                                          // reclamation and
+                                                          // registration
+
+    EpochReclaimerParticipant        *d_participants_p;   // registered
+                                                          // participants
+
+    int                               d_numParticipants;  // number of
+                                                          // registered
+                                                          // participants
+
+    bsl::vector<EpochReclaimer_Entry> d_orphans;          // objects retired by
+                                                          // destroyed
+                                                          // participants
+
+    int                               d_reclaimThreshold; // retired objects
+                                                          // triggering
+                                                          // reclamation
+
+    // FRIENDS
+    friend class EpochReclaimerParticipant;
+
+  private:
+    // NOT IMPLEMENTED
+    EpochReclaimer(const EpochReclaimer&);
+    EpochReclaimer& operator=(const EpochReclaimer&);
+
+    // PRIVATE MANIPULATORS
+    bsls::Types::Int64 advance();
+        // Advance the global epoch if every participant in a critical section
+        // has announced the current epoch, and return the resulting global
+        // epoch.  The behavior is undefined unless 'd_lock' is held.
+
+    // PRIVATE ACCESSORS
+    bool isProtected(const void *address) const;
+        // Return 'true' if the specified 'address' is published in a hazard
+        // pointer slot of any registered participant, and 'false' otherwise.
+        // The behavior is undefined unless 'd_lock' is held.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(EpochReclaimer,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    EpochReclaimer(bslma::Allocator *basicAllocator = 0);
+    explicit
+    EpochReclaimer(int reclaimThreshold, bslma::Allocator *basicAllocator = 0);
+        // Create a reclaimer having no participants.  Optionally specify a
+        // 'reclaimThreshold', the number of objects retired by a participant
+        // that triggers a reclamation attempt; if 'reclaimThreshold' is not
+        // specified, 'k_DEFAULT_RECLAIM_THRESHOLD' is used.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '0 < reclaimThreshold'.
+
+    ~EpochReclaimer();
+        // Dispose of all objects handed over by destroyed participants, and
+        // destroy this reclaimer.  The behavior is undefined unless this
+        // reclaimer has no participants.
+
+    // ACCESSORS
+    bsls::Types::Int64 epoch() const;
+        // Return the current global epoch of this reclaimer.
+
+    int numParticipants() const;
+        // Return the number of participants currently registered with this
+        // reclaimer.
+
+    int reclaimThreshold() const;
+        // Return the number of objects retired by a participant that triggers
+        // a reclamation attempt.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this reclaimer to supply memory.
+};
+
+                      // ===============================
+                      // class EpochReclaimerParticipant
+                      // ===============================
+
+class EpochReclaimerParticipant {
+    // This class provides the handle through which a single thread enters and
+    // leaves critical sections, publishes hazard pointers, and retires
+    // objects, within the domain of an 'EpochReclaimer'.  All methods must be
+    // called from the thread that created this object.
+
+    // PRIVATE TYPES
+    typedef bsls::AtomicOperations::AtomicTypes::Pointer HazardPointer;
+
+    // DATA
+    bsls::AtomicInt64                 d_state;         // twice the announced
+                                                       // epoch plus one
+                                                       // inside a critical
+                                                       // section, and 0
+                                                       // otherwise
+
+    HazardPointer                     d_hazards[EpochReclaimer::
+                                                k_NUM_HAZARD_POINTERS];
+                                                       // published addresses
+
+    int                               d_depth;         // critical section
+                                                       // nesting depth
+
+    bool                              d_isReclaiming;  // 'true' while
+                                                       // disposing of objects
+
+    bsl::size_t                       d_reclaimSize;   // size of 'd_retired'
+                                                       // triggering
+                                                       // reclamation
+
+    bsl::vector<EpochReclaimer_Entry> d_retired;       // pending objects
+
+    bsl::vector<EpochReclaimer_Entry> d_ready;         // objects being
+                                                       // disposed of
+
+    EpochReclaimer                   *d_reclaimer_p;   // reclaimer (held,
+                                                       // not owned)
+
+    EpochReclaimerParticipant        *d_next_p;        // next participant of
+                                                       // 'd_reclaimer_p'
+
+    // FRIENDS
+    friend class EpochReclaimer;
+
+  private:
+    // NOT IMPLEMENTED
+    EpochReclaimerParticipant(const EpochReclaimerParticipant&);
+    EpochReclaimerParticipant& operator=(const EpochReclaimerParticipant&);
+
+    // PRIVATE CLASS METHODS
+    static void deallocateBlock(void *address, void *allocator);
+        // Return the memory block at the specified 'address' to the specified
+        // 'allocator', which must be the address of a 'bslma::Allocator'.
+
+    template <class TYPE>
+    static void deleteObject(void *object, void *allocator);
+        // Destroy the specified 'object', which must be the address of a
+        // 'TYPE' object, and return its memory to the specified 'allocator',
+        // which must be the address of a 'bslma::Allocator'.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(EpochReclaimerParticipant,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    EpochReclaimerParticipant(EpochReclaimer   *reclaimer,
+                              bslma::Allocator *basicAllocator = 0);
+        // Create a participant of the specified 'reclaimer', outside any
+        // critical section and having no hazard pointers published.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless 'reclaimer' outlives this
+        // object.
+
+    ~EpochReclaimerParticipant();
+        // Attempt to reclaim the objects retired by this participant, hand
+        // over the objects still pending to the reclaimer, and destroy this
+        // participant.  The behavior is undefined unless this participant is
+        // outside any critical section.
+
+    // MANIPULATORS
+    void enter();
+        // Enter a critical section, during which no object retired by any
+        // participant of the reclaimer after this call can be disposed of.
+        // Critical sections may be nested; each call to 'enter' must be
+        // matched by a call to 'leave'.
+
+    void leave();
+        // Leave the critical section most recently entered.  The behavior is
+        // undefined unless this participant is inside a critical section.
+
+    template <class TYPE>
+    TYPE *protect(int index, const bsls::AtomicPointer<TYPE>& source);
+        // Publish the address currently held by the specified 'source' in the
+        // hazard pointer slot having the specified 'index', and return that
+        // address.  The returned object, if any, will not be disposed of
+        // until the slot is cleared or overwritten, even if it is retired.
+        // The behavior is undefined unless
+        // '0 <= index < EpochReclaimer::k_NUM_HAZARD_POINTERS', and the object
+        // addressed by 'source' was not already retired when the address was
+        // loaded from 'source'.  Note that the address is reloaded until it is
+        // observed in 'source' after being published, so that a concurrently
+        // retired object is never returned.
+
+    void unprotect(int index);
+        // Clear the hazard pointer slot having the specified 'index'.  The
+        // behavior is undefined unless
+        // '0 <= index < EpochReclaimer::k_NUM_HAZARD_POINTERS'.
+
+    int reclaim();
+        // Attempt to advance the global epoch, and dispose of the objects
+        // retired by this participant (and objects handed over to the
+        // reclaimer by destroyed participants) that can no longer be
+        // referenced by any participant.  Return the number of objects
+        // disposed of.
+
+    void retire(void *address, bslma::Allocator *allocator);
+        // Retire the memory block at the specified 'address', to be returned
+        // to the specified 'allocator' once no participant can refer to it.
+        // The behavior is undefined unless 'address' was allocated from
+        // 'allocator', is no longer reachable from any shared data structure,
+        // and has not already been retired.
+
+    void retire(void *object, EpochReclaimer::Deleter deleter, void *context);
+        // Retire the specified 'object', to be disposed of by calling the
+        // specified 'deleter' with 'object' and the specified 'context' once
+        // no participant can refer to it.  The behavior is undefined unless
+        // 'object' is no longer reachable from any shared data structure, and
+        // has not already been retired.
+
+    template <class TYPE>
+    void retireObject(TYPE *object, bslma::Allocator *allocator);
+        // Retire the specified 'object', to be destroyed and its memory
+        // returned to the specified 'allocator' once no participant can refer
+        // to it.  The behavior is undefined unless 'object' was created using
+        // memory from 'allocator', is no longer reachable from any shared data
+        // structure, and has not already been retired.
+
+    // ACCESSORS
+    bool isInCriticalSection() const;
+        // Return 'true' if this participant is inside a critical section, and
+        // 'false' otherwise.
+
+    int numRetired() const;
+        // Return the number of objects retired by this participant that have
+        // not yet been disposed of.
+
+    EpochReclaimer *reclaimer() const;
+        // Return the address of the reclaimer of this participant.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this participant to supply memory.
+};
+
+                         // =========================
+                         // class EpochReclaimerGuard
+                         // =========================
+
+class EpochReclaimerGuard {
+    // This class implements a guard that enters a critical section of a
+    // participant on construction, and leaves it on destruction.
+
+    // DATA
+    EpochReclaimerParticipant *d_participant_p;  // participant (held, not
+                                                 // owned)
+
+  private:
+    // NOT IMPLEMENTED
+    EpochReclaimerGuard(const EpochReclaimerGuard&);
+    EpochReclaimerGuard& operator=(const EpochReclaimerGuard&);
+
+  public:
+    // CREATORS
+    explicit
+    EpochReclaimerGuard(EpochReclaimerParticipant *participant);
+        // Create a guard that enters a critical section of the specified
+        // 'participant'.
+
+    ~EpochReclaimerGuard();
+        // Leave the critical section entered on construction, and destroy
+        // this guard.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                            // --------------------
+                            // class EpochReclaimer
+                            // --------------------
+
+// ACCESSORS
+inline
+bsls::Types::Int64 EpochReclaimer::epoch() const
+{
+    return d_epoch.loadAcquire();
+}
+
+inline
+int EpochReclaimer::reclaimThreshold() const
+{
+    return d_reclaimThreshold;
+}
+
+                                  // Aspects
+
+inline
+bslma::Allocator *EpochReclaimer::allocator() const
+{
+    return d_orphans.get_allocator().mechanism();
+}
+
+                      // -------------------------------
+                      // class EpochReclaimerParticipant
+                      // -------------------------------
+
+// PRIVATE CLASS METHODS
+template <class TYPE>
+void EpochReclaimerParticipant::deleteObject(void *object, void *allocator)
+{
+    bslma::DeleterHelper::deleteObject(
+                                   static_cast<TYPE *>(object),
+                                   static_cast<bslma::Allocator *>(allocator));
+}
+
+// MANIPULATORS
+inline
+void EpochReclaimerParticipant::leave()
+{
+    BSLS_ASSERT_SAFE(0 < d_depth);
+
+    if (0 == --d_depth) {
+        d_state.storeRelease(0);
+    }
+}
+
+template <class TYPE>
+TYPE *EpochReclaimerParticipant::protect(
+                                       int                              index,
+                                       const bsls::AtomicPointer<TYPE>& source)
+{
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(index < EpochReclaimer::k_NUM_HAZARD_POINTERS);
+
+    TYPE *address = source.loadAcquire();
+    for (;;) {
+        bsls::AtomicOperations::setPtr(
+                       &d_hazards[index],
+                       const_cast<void *>(static_cast<const void *>(address)));
+
+        TYPE *current = source.load();
+        if (current == address) {
+            return address;                                           // RETURN
+        }
+        address = current;
+    }
+}
+
+inline
+void EpochReclaimerParticipant::unprotect(int index)
+{
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(index < EpochReclaimer::k_NUM_HAZARD_POINTERS);
+
+    bsls::AtomicOperations::setPtrRelease(&d_hazards[index], 0);
+}
+
+inline
+void EpochReclaimerParticipant::retire(void             *address,
+                                       bslma::Allocator *allocator)
+{
+    BSLS_ASSERT_SAFE(allocator);
+
+    retire(address, &deallocateBlock, allocator);
+}
+
+template <class TYPE>
+inline
+void EpochReclaimerParticipant::retireObject(TYPE             *object,
+                                             bslma::Allocator *allocator)
+{
+    BSLS_ASSERT_SAFE(allocator);
+
+    retire(const_cast<void *>(static_cast<const volatile void *>(object)),
+           &deleteObject<TYPE>,
+           allocator);
+}
+
+// ACCESSORS
+inline
+bool EpochReclaimerParticipant::isInCriticalSection() const
+{
+    return 0 < d_depth;
+}
+
+inline
+int EpochReclaimerParticipant::numRetired() const
+{
+    return static_cast<int>(d_retired.size());
+}
+
+inline
+EpochReclaimer *EpochReclaimerParticipant::reclaimer() const
+{
+    return d_reclaimer_p;
+}
+
+                                  // Aspects
+
+inline
+bslma::Allocator *EpochReclaimerParticipant::allocator() const
+{
+    return d_retired.get_allocator().mechanism();
+}
+
+                         // -------------------------
+                         // class EpochReclaimerGuard
+                         // -------------------------
+
+// CREATORS
+inline
+EpochReclaimerGuard::EpochReclaimerGuard(
+                                        EpochReclaimerParticipant *participant)
+: d_participant_p(participant)
+{
+    BSLS_ASSERT_SAFE(participant);
+
+    d_participant_p->enter();
+}
+
+inline
+EpochReclaimerGuard::~EpochReclaimerGuard()
+{
+    d_participant_p->leave();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
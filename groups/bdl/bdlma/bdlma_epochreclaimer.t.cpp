@@ -0,0 +1,1100 @@
+// bdlma_epochreclaimer.t.cpp                                         -*-C++-*-
+#include <bdlma_epochreclaimer.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_platform.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                TEST PLAN
+// ----------------------------------------------------------------------------
+//                                 Overview
+//                                 --------
+// 'bdlma::EpochReclaimer' decides when objects retired by its participants
+// may be disposed of.  The primary concerns are that a retired object is
+// never disposed of while a participant that may refer to it is in a critical
+// section or protects it with a hazard pointer, that every retired object is
+// eventually disposed of exactly once (using the deleter supplied when it was
+// retired), and that reclamation is attempted as described in the component
+// documentation.  We drive the global epoch deterministically from a single
+// thread using several participants, and use a test allocator to observe
+// when memory is returned.  Finally, we use a lock-free stack shared by
+// several threads to verify that no node is disposed of while being read.
+// ----------------------------------------------------------------------------
+// EpochReclaimer
+// [ 2] EpochReclaimer(Allocator *ba = 0);
+// [ 2] EpochReclaimer(int reclaimThreshold, Allocator *ba = 0);
+// [ 2] ~EpochReclaimer();
+// [ 3] Int64 epoch() const;
+// [ 2] int numParticipants() const;
+// [ 2] int reclaimThreshold() const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// EpochReclaimerParticipant
+// [ 2] EpochReclaimerParticipant(EpochReclaimer *r, Allocator *ba = 0);
+// [ 2] ~EpochReclaimerParticipant();
+// [ 3] void enter();
+// [ 3] void leave();
+// [ 5] TYPE *protect(int index, const bsls::AtomicPointer<TYPE>& source);
+// [ 5] void unprotect(int index);
+// [ 4] int reclaim();
+// [ 4] void retire(void *address, bslma::Allocator *allocator);
+// [ 4] void retire(void *object, Deleter deleter, void *context);
+// [ 4] void retireObject(TYPE *object, bslma::Allocator *allocator);
+// [ 3] bool isInCriticalSection() const;
+// [ 4] int numRetired() const;
+// [ 2] EpochReclaimer *reclaimer() const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// EpochReclaimerGuard
+// [ 3] EpochReclaimerGuard(EpochReclaimerParticipant *participant);
+// [ 3] ~EpochReclaimerGuard();
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] USAGE EXAMPLE
+// [ 6] CONCERN: Nodes of a shared lock-free stack are not disposed early.
+// [ 3] CONCERN: Precondition violations are detected when enabled.
+
+// ============================================================================
+//                    STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL VARIABLES / TYPEDEFS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bdlma::EpochReclaimer            Obj;
+typedef bdlma::EpochReclaimerParticipant Participant;
+typedef bdlma::EpochReclaimerGuard       Guard;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+void countDeletion(void *object, void *counter)
+    // Increment the 'int' at the specified 'counter' and ignore the specified
+    // 'object'.
+{
+    (void)object;
+    ++*static_cast<int *>(counter);
+}
+
+struct Counted {
+    // This 'struct' counts the number of its live instances.
+
+    // CLASS DATA
+    static int s_numLive;
+
+    // CREATORS
+    Counted()
+    {
+        ++s_numLive;
+    }
+
+    ~Counted()
+    {
+        --s_numLive;
+    }
+};
+
+int Counted::s_numLive = 0;
+
+namespace TestCase6 {
+
+enum {
+    k_ALIVE = 0x600d,  // marks a node not yet disposed of
+    k_DEAD  = 0xdead   // marks a disposed-of node
+};
+
+struct Node {
+    int   d_magic;
+    int   d_value;
+    Node *d_next_p;
+};
+
+struct ThreadInfo {
+    Obj                       *d_reclaimer_p;
+    bsls::AtomicPointer<Node> *d_top_p;
+    bslma::Allocator          *d_allocator_p;
+    bsls::AtomicInt            d_numErrors;
+    int                        d_numIterations;
+};
+
+static
+void disposeNode(void *node, void *allocator)
+    // Mark the specified 'node' as dead and return it to the specified
+    // 'allocator'.
+{
+    static_cast<Node *>(node)->d_magic = k_DEAD;
+    static_cast<bslma::Allocator *>(allocator)->deallocate(node);
+}
+
+extern "C" void *threadFunction(void *arg)
+    // Repeatedly push nodes onto, and pop nodes from, the stack described by
+    // the 'ThreadInfo' addressed by the specified 'arg', verifying that every
+    // node read is alive.
+{
+    ThreadInfo  *info = static_cast<ThreadInfo *>(arg);
+    Participant  participant(info->d_reclaimer_p, info->d_allocator_p);
+
+    for (int i = 0; i < info->d_numIterations; ++i) {
+        Node *node = static_cast<Node *>(
+                                info->d_allocator_p->allocate(sizeof(Node)));
+        node->d_magic = k_ALIVE;
+        node->d_value = i;
+
+        Node *top = info->d_top_p->loadRelaxed();
+        for (;;) {
+            node->d_next_p = top;
+            Node *previous = info->d_top_p->testAndSwapAcqRel(top, node);
+            if (previous == top) {
+                break;
+            }
+            top = previous;
+        }
+
+        Guard guard(&participant);
+
+        top = info->d_top_p->loadAcquire();
+        while (top) {
+            if (k_ALIVE != top->d_magic) {
+                ++info->d_numErrors;
+                return 0;                                             // RETURN
+            }
+            Node *previous = info->d_top_p->testAndSwapAcqRel(top,
+                                                              top->d_next_p);
+            if (previous == top) {
+                participant.retire(top, &disposeNode, info->d_allocator_p);
+                break;
+            }
+            top = previous;
+        }
+    }
+    return 0;
+}
+
+}  // close namespace TestCase6
+
+// ============================================================================
+//                             USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: A Lock-Free Stack
+/// - - - - - - - - - - - - - -
+// Suppose we want a stack of 'int' values that can be pushed and popped
+// concurrently without a lock.  Without a reclamation scheme, a popping
+// thread could not deallocate the node it removed, since another thread may
+// be reading the same node concurrently.
+//
+// First, we define the node type and the stack, which holds its top node in a
+// 'bsls::AtomicPointer':
+//..
+    struct my_Node {
+        int      d_value;
+        my_Node *d_next_p;
+    };
+
+    class my_Stack {
+        // This class provides a lock-free stack of 'int' values.
+
+        // DATA
+        bsls::AtomicPointer<my_Node>  d_top;          // top of stack
+        bslma::Allocator             *d_allocator_p;  // held, not owned
+
+      public:
+        // CREATORS
+        explicit my_Stack(bslma::Allocator *basicAllocator = 0)
+        : d_top(0)
+        , d_allocator_p(bslma::Default::allocator(basicAllocator))
+        {
+        }
+
+        ~my_Stack()
+        {
+            while (my_Node *node = d_top.loadRelaxed()) {
+                d_top.storeRelaxed(node->d_next_p);
+                d_allocator_p->deallocate(node);
+            }
+        }
+
+        // MANIPULATORS
+        void push(int value)
+        {
+            my_Node *node = static_cast<my_Node *>(
+                                    d_allocator_p->allocate(sizeof(my_Node)));
+            node->d_value = value;
+
+            my_Node *top = d_top.loadRelaxed();
+            do {
+                node->d_next_p = top;
+                my_Node *previous = d_top.testAndSwapAcqRel(top, node);
+                if (previous == top) {
+                    break;
+                }
+                top = previous;
+            } while (true);
+        }
+//..
+// Then, we implement 'pop'.  The node is read inside a critical section of
+// the calling thread's participant, so that it cannot be deallocated by
+// another thread while it is being read, and, once unlinked, it is retired
+// rather than deallocated:
+//..
+        bool pop(int                              *value,
+                 bdlma::EpochReclaimerParticipant *participant)
+        {
+            bdlma::EpochReclaimerGuard guard(participant);
+
+            my_Node *top = d_top.loadAcquire();
+            while (top) {
+                my_Node *previous = d_top.testAndSwapAcqRel(top,
+                                                             top->d_next_p);
+                if (previous == top) {
+                    *value = top->d_value;
+                    participant->retire(top, d_allocator_p);
+                    return true;
+                }
+                top = previous;
+            }
+            return false;
+        }
+    };
+//..
+
+// ============================================================================
+//                              MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+    bool veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Next, we create a reclaimer, with a small reclaim threshold to make
+// reclamation visible in this example, and a stack that obtains its nodes
+// from a test allocator:
+//..
+    bslma::TestAllocator  ta;
+    bdlma::EpochReclaimer reclaimer(4);
+    my_Stack              stack(&ta);
+//..
+// Then, each thread using the stack creates its own participant (here, we use
+// only one thread):
+//..
+    bdlma::EpochReclaimerParticipant participant(&reclaimer);
+
+    for (int i = 0; i < 8; ++i) {
+        stack.push(i);
+    }
+    const bsls::Types::Int64 numBlocks = ta.numBlocksInUse();
+//..
+// Now, we pop the values.  The popped nodes are not deallocated immediately,
+// but once enough nodes have been retired the participant reclaims them:
+//..
+    int value;
+    for (int i = 7; i >= 0; --i) {
+        ASSERT(true == stack.pop(&value, &participant));
+        ASSERT(i    == value);
+    }
+    ASSERT(false == stack.pop(&value, &participant));
+
+    ASSERT(numBlocks - 8 <  ta.numBlocksInUse());
+    ASSERT(numBlocks     >  ta.numBlocksInUse());
+//..
+// Finally, we request reclamation explicitly.  Since no thread is in a
+// critical section, at most two attempts are needed to dispose of all retired
+// nodes:
+//..
+    participant.reclaim();
+    participant.reclaim();
+
+    ASSERT(0             == participant.numRetired());
+    ASSERT(numBlocks - 8 == ta.numBlocksInUse());
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCURRENT LOCK-FREE STACK
+        //
+        // Concerns:
+        //: 1 A node retired by one thread is not disposed of while another
+        //:   thread may read it inside a critical section.
+        //:
+        //: 2 All retired nodes are disposed of once every participant and the
+        //:   reclaimer are destroyed.
+        //
+        // Plan:
+        //: 1 In several threads, each having its own participant, repeatedly
+        //:   push a node onto a shared lock-free stack and pop a node from it
+        //:   inside a critical section, retiring the popped node with a
+        //:   deleter that marks it dead.  Verify that no thread reads a dead
+        //:   node.  (C-1)
+        //:
+        //: 2 Verify, using a test allocator, that no memory remains in use
+        //:   once the reclaimer is destroyed.  (C-2)
+        //
+        // Testing:
+        //   CONCERN: Nodes of a shared lock-free stack are not disposed early.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT LOCK-FREE STACK" << endl
+                          << "==========================" << endl;
+
+        using namespace TestCase6;
+
+        enum { k_NUM_THREADS = 4 };
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+        {
+            Obj                       mX(16, &ta);
+            bsls::AtomicPointer<Node> top(0);
+
+            ThreadInfo info;
+            info.d_reclaimer_p   = &mX;
+            info.d_top_p         = &top;
+            info.d_allocator_p   = &ta;
+            info.d_numErrors     = 0;
+            info.d_numIterations = veryVerbose ? 200000 : 20000;
+
+            ThreadId threads[k_NUM_THREADS];
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                threads[i] = createThread(&threadFunction, &info);
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                joinThread(threads[i]);
+            }
+
+            ASSERTV(info.d_numErrors, 0 == info.d_numErrors);
+            ASSERTV(mX.numParticipants(), 0 == mX.numParticipants());
+            ASSERTV(top.load(), 0 == top.load());
+
+            if (veryVerbose) {
+                P_(mX.epoch()) P(ta.numBlocksInUse())
+            }
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // HAZARD POINTERS
+        //
+        // Concerns:
+        //: 1 'protect' returns the address held by the source, and publishes
+        //:   it.
+        //:
+        //: 2 A retired object whose address is published by any participant
+        //:   is not disposed of, regardless of the epoch, until the slot is
+        //:   cleared or overwritten.
+        //:
+        //: 3 Each slot is independent.
+        //
+        // Plan:
+        //: 1 Protect objects held by atomic pointers in each slot of one
+        //:   participant, retire them from another participant, and advance
+        //:   the epoch.  Verify that the objects are disposed of only after
+        //:   their slots are cleared or overwritten.  (C-1..3)
+        //
+        // Testing:
+        //   TYPE *protect(int index, const bsls::AtomicPointer<TYPE>& source);
+        //   void unprotect(int index);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "HAZARD POINTERS" << endl
+                          << "===============" << endl;
+
+        ASSERT(2 == Obj::k_NUM_HAZARD_POINTERS);
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+        {
+            Obj         mX(&ta);
+            Participant reader(&mX, &ta);
+            Participant writer(&mX, &ta);
+
+            int objects[3] = { 0, 1, 2 };
+            bsls::AtomicPointer<int> source0(&objects[0]);
+            bsls::AtomicPointer<int> source1(&objects[1]);
+
+            ASSERT(&objects[0] == reader.protect(0, source0));
+            ASSERT(&objects[1] == reader.protect(1, source1));
+
+            int numDeleted = 0;
+            source0 = &objects[2];
+            writer.retire(&objects[0], &countDeletion, &numDeleted);
+            source1 = 0;
+            writer.retire(&objects[1], &countDeletion, &numDeleted);
+
+            for (int i = 0; i < 4; ++i) {
+                ASSERT(0 == writer.reclaim());
+            }
+            ASSERT(0 == numDeleted);
+            ASSERT(2 == writer.numRetired());
+
+            if (veryVerbose) cout << "\tOverwrite slot 0." << endl;
+
+            ASSERT(&objects[2] == reader.protect(0, source0));
+            ASSERT(1 == writer.reclaim());
+            ASSERT(1 == numDeleted);
+            ASSERT(1 == writer.numRetired());
+
+            if (veryVerbose) cout << "\tClear slot 1." << endl;
+
+            reader.unprotect(1);
+            ASSERT(1 == writer.reclaim());
+            ASSERT(2 == numDeleted);
+            ASSERT(0 == writer.numRetired());
+
+            if (veryVerbose) cout << "\tNull source." << endl;
+
+            ASSERT(0 == reader.protect(1, source1));
+
+            if (veryVerbose) cout << "\tProtected by the retiring thread."
+                                  << endl;
+
+            writer.protect(0, source0);
+            source0 = 0;
+            writer.retire(&objects[2], &countDeletion, &numDeleted);
+            writer.reclaim();
+            writer.reclaim();
+            ASSERT(2 == numDeleted);
+            writer.unprotect(0);
+            reader.unprotect(0);
+            ASSERT(1 == writer.reclaim());
+            ASSERT(3 == numDeleted);
+
+            if (veryVerbose) cout << "\tNegative testing." << endl;
+            {
+                bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+                ASSERT_SAFE_PASS(reader.unprotect(0));
+                ASSERT_SAFE_PASS(reader.unprotect(1));
+                ASSERT_SAFE_FAIL(reader.unprotect(-1));
+                ASSERT_SAFE_FAIL(reader.unprotect(2));
+                ASSERT_SAFE_FAIL(reader.protect(2, source0));
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // RETIRE AND RECLAIM
+        //
+        // Concerns:
+        //: 1 An object retired during epoch 'e' is disposed of by the first
+        //:   reclamation attempt once the global epoch is at least 'e + 2',
+        //:   and not before.
+        //:
+        //: 2 Each object is disposed of exactly once, using the means supplied
+        //:   to 'retire' or 'retireObject'.
+        //:
+        //: 3 'reclaim' returns the number of objects disposed of, and
+        //:   'numRetired' the number pending.
+        //:
+        //: 4 A reclamation attempt is made when the number of pending objects
+        //:   reaches the reclaim threshold and, if objects remain pending,
+        //:   not again until their number has doubled.
+        //:
+        //: 5 Objects still pending when a participant is destroyed are
+        //:   disposed of by a later reclamation attempt of another
+        //:   participant, or by the destructor of the reclaimer.
+        //:
+        //: 6 A deleter may retire further objects.
+        //
+        // Plan:
+        //: 1 Retire objects of each kind, and advance the epoch by calling
+        //:   'reclaim', verifying the number of objects disposed of and the
+        //:   blocks in use after each step.  (C-1..3)
+        //:
+        //: 2 Keep a second participant inside a critical section to hold the
+        //:   epoch back, and verify when reclamation is triggered by
+        //:   'retire'.  (C-4)
+        //:
+        //: 3 Destroy participants having pending objects, and verify when the
+        //:   objects are disposed of.  (C-5)
+        //:
+        //: 4 Retire an object whose deleter retires another object.  (C-6)
+        //
+        // Testing:
+        //   int reclaim();
+        //   void retire(void *address, bslma::Allocator *allocator);
+        //   void retire(void *object, Deleter deleter, void *context);
+        //   void retireObject(TYPE *object, bslma::Allocator *allocator);
+        //   int numRetired() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "RETIRE AND RECLAIM" << endl
+                          << "==================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tDisposal after two epochs." << endl;
+        {
+            Obj         mX(&ta);  const Obj& X = mX;
+            Participant mP(&mX, &ta);
+
+            int numDeleted = 0;
+
+            void *block = sa.allocate(16);
+            mP.retire(block, &sa);
+            mP.retireObject(new (sa) Counted(), &sa);
+            mP.retire(&numDeleted, &countDeletion, &numDeleted);
+            ASSERT(3 == mP.numRetired());
+            ASSERT(2 == sa.numBlocksInUse());
+            ASSERT(1 == Counted::s_numLive);
+
+            ASSERT(0 == mP.reclaim());
+            ASSERT(1 == X.epoch());
+            ASSERT(3 == mP.numRetired());
+
+            ASSERT(3 == mP.reclaim());
+            ASSERT(2 == X.epoch());
+            ASSERT(0 == mP.numRetired());
+            ASSERT(0 == sa.numBlocksInUse());
+            ASSERT(0 == Counted::s_numLive);
+            ASSERT(1 == numDeleted);
+
+            ASSERT(0 == mP.reclaim());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tReclamation triggered by 'retire'." << endl;
+        {
+            Obj         mX(4, &ta);  const Obj& X = mX;
+            Participant mP(&mX, &ta);
+            Participant mQ(&mX, &ta);
+
+            int numDeleted = 0;
+            int dummy[32];
+
+            mQ.enter();    // announces epoch 0
+
+            for (int i = 0; i < 3; ++i) {
+                mP.retire(&dummy[i], &countDeletion, &numDeleted);
+            }
+            ASSERT(0 == X.epoch());
+            ASSERT(3 == mP.numRetired());
+
+            mP.retire(&dummy[3], &countDeletion, &numDeleted);  // attempt
+            ASSERT(1 == X.epoch());
+            ASSERT(4 == mP.numRetired());
+            ASSERT(0 == numDeleted);
+
+            // Held back by 'mQ': no attempt until 8 are pending.
+
+            for (int i = 4; i < 7; ++i) {
+                mP.retire(&dummy[i], &countDeletion, &numDeleted);
+            }
+            ASSERT(1 == X.epoch());
+
+            mP.retire(&dummy[7], &countDeletion, &numDeleted);  // attempt
+            ASSERT(1 == X.epoch());
+            ASSERT(8 == mP.numRetired());
+            ASSERT(0 == numDeleted);
+
+            mQ.leave();
+
+            for (int i = 8; i < 15; ++i) {
+                mP.retire(&dummy[i], &countDeletion, &numDeleted);
+            }
+            ASSERT(1 == X.epoch());
+
+            mP.retire(&dummy[15], &countDeletion, &numDeleted);  // attempt
+            ASSERT(2 == X.epoch());
+            ASSERT(4 == numDeleted);
+            ASSERT(12 == mP.numRetired());
+
+            ASSERT(12 == mP.reclaim());
+            ASSERT(3  == X.epoch());
+            ASSERT(16 == numDeleted);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tObjects of destroyed participants." << endl;
+        {
+            int numDeleted = 0;
+            int dummy[4];
+            {
+                Obj mX(&ta);  const Obj& X = mX;
+
+                Participant mP(&mX, &ta);
+                {
+                    Participant mQ(&mX, &ta);
+
+                    mP.enter();
+
+                    mQ.retire(&dummy[0], &countDeletion, &numDeleted);
+                    mQ.retire(&dummy[1], &countDeletion, &numDeleted);
+                }
+                ASSERT(1 == X.numParticipants());
+                ASSERT(0 == numDeleted);
+
+                mP.leave();
+
+                ASSERT(2 == mP.reclaim());    // the epoch advanced when
+                ASSERT(2 == numDeleted);      // 'mQ' was destroyed
+
+                mP.enter();
+                {
+                    Participant mQ(&mX, &ta);
+
+                    mQ.retire(&dummy[2], &countDeletion, &numDeleted);
+                    mQ.retire(&dummy[3], &countDeletion, &numDeleted);
+                }
+                mP.leave();
+                ASSERT(2 == numDeleted);
+            }
+            ASSERT(4 == numDeleted);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tDeleter retiring an object." << endl;
+        {
+            Obj         mX(&ta);
+            Participant mP(&mX, &ta);
+
+            struct Local {
+                static void retireNext(void *object, void *participant)
+                {
+                    static_cast<Participant *>(participant)->retireObject(
+                                              static_cast<Counted *>(object),
+                                              bslma::Default::allocator());
+                }
+            };
+
+            bslma::DefaultAllocatorGuard dag(&sa);
+
+            Counted *counted = new (sa) Counted();
+            mP.retire(counted, &Local::retireNext, &mP);
+            mP.reclaim();
+            ASSERT(1 == mP.reclaim());
+            ASSERT(1 == mP.numRetired());
+            ASSERT(1 == Counted::s_numLive);
+            mP.reclaim();
+            ASSERT(1 == mP.reclaim());
+            ASSERT(0 == Counted::s_numLive);
+            ASSERT(0 == sa.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CRITICAL SECTIONS
+        //
+        // Concerns:
+        //: 1 'enter' and 'leave' (and the guard) enter and leave a critical
+        //:   section, and critical sections nest.
+        //:
+        //: 2 The global epoch advances only if no participant is inside a
+        //:   critical section that it entered during an earlier epoch.
+        //:
+        //: 3 Precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Enter and leave (nested) critical sections of two participants,
+        //:   calling 'reclaim' to attempt to advance the epoch, and verify
+        //:   the results of 'isInCriticalSection' and 'epoch'.  (C-1..2)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered by calling 'leave' outside a critical section.  (C-3)
+        //
+        // Testing:
+        //   void enter();
+        //   void leave();
+        //   bool isInCriticalSection() const;
+        //   Int64 epoch() const;
+        //   EpochReclaimerGuard(EpochReclaimerParticipant *participant);
+        //   ~EpochReclaimerGuard();
+        //   CONCERN: Precondition violations are detected when enabled.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CRITICAL SECTIONS" << endl
+                          << "=================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+        {
+            Obj         mX(&ta);  const Obj& X = mX;
+            Participant mP(&mX, &ta);  const Participant& P = mP;
+            Participant mQ(&mX, &ta);  const Participant& Q = mQ;
+
+            ASSERT(0 == X.epoch());
+            ASSERT(false == P.isInCriticalSection());
+
+            mP.enter();
+            ASSERT(true == P.isInCriticalSection());
+            mP.enter();
+            ASSERT(true == P.isInCriticalSection());
+
+            // 'mP' announced epoch 0: the epoch advances only once.
+
+            mQ.reclaim();
+            ASSERT(1 == X.epoch());
+            mQ.reclaim();
+            ASSERT(1 == X.epoch());
+
+            mP.leave();
+            ASSERT(true == P.isInCriticalSection());
+            mQ.reclaim();
+            ASSERT(1 == X.epoch());
+
+            mP.leave();
+            ASSERT(false == P.isInCriticalSection());
+            mQ.reclaim();
+            ASSERT(2 == X.epoch());
+
+            // A critical section entered during the current epoch does not
+            // hold it back.
+
+            mP.enter();
+            mQ.reclaim();
+            ASSERT(3 == X.epoch());
+            mQ.reclaim();
+            ASSERT(3 == X.epoch());
+            mP.leave();
+
+            if (verbose) cout << "\tGuard." << endl;
+            {
+                Guard guard(&mQ);
+                ASSERT(true == Q.isInCriticalSection());
+                {
+                    Guard guard(&mQ);
+                    ASSERT(true == Q.isInCriticalSection());
+                }
+                ASSERT(true == Q.isInCriticalSection());
+
+                mP.reclaim();
+                ASSERT(4 == X.epoch());
+                mP.reclaim();
+                ASSERT(4 == X.epoch());
+            }
+            ASSERT(false == Q.isInCriticalSection());
+            mP.reclaim();
+            ASSERT(5 == X.epoch());
+
+            if (verbose) cout << "\tNegative testing." << endl;
+            {
+                bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+                ASSERT_SAFE_FAIL(mP.leave());
+                mP.enter();
+                ASSERT_SAFE_PASS(mP.leave());
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 A reclaimer is created with epoch 0, no participants, and the
+        //:   specified (or default) reclaim threshold and allocator.
+        //:
+        //: 2 Participants register at construction and deregister at
+        //:   destruction, in any order, and refer to their reclaimer.
+        //:
+        //: 3 Memory comes from the allocators supplied at construction, or
+        //:   the default allocator.
+        //:
+        //: 4 Precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create reclaimers with and without a threshold and allocator, and
+        //:   verify their attributes.  (C-1)
+        //:
+        //: 2 Create and destroy participants in various orders, verifying the
+        //:   number of participants and the blocks in use by each allocator.
+        //:   (C-2..3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   EpochReclaimer(Allocator *ba = 0);
+        //   EpochReclaimer(int reclaimThreshold, Allocator *ba = 0);
+        //   ~EpochReclaimer();
+        //   int numParticipants() const;
+        //   int reclaimThreshold() const;
+        //   bslma::Allocator *allocator() const;
+        //   EpochReclaimerParticipant(EpochReclaimer *r, Allocator *ba = 0);
+        //   ~EpochReclaimerParticipant();
+        //   EpochReclaimer *reclaimer() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND BASIC ACCESSORS" << endl
+                          << "============================" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+        {
+            Obj mX;  const Obj& X = mX;
+            ASSERT(0  == X.epoch());
+            ASSERT(0  == X.numParticipants());
+            ASSERT(Obj::k_DEFAULT_RECLAIM_THRESHOLD == X.reclaimThreshold());
+            ASSERT(&da == X.allocator());
+
+            Obj mY(8, &ta);  const Obj& Y = mY;
+            ASSERT(8   == Y.reclaimThreshold());
+            ASSERT(&ta == Y.allocator());
+            ASSERT(0   == ta.numBlocksInUse());
+
+            Obj mZ(&ta);  const Obj& Z = mZ;
+            ASSERT(Obj::k_DEFAULT_RECLAIM_THRESHOLD == Z.reclaimThreshold());
+            ASSERT(&ta == Z.allocator());
+
+            {
+                Participant mP(&mY, &ta);  const Participant& P = mP;
+                ASSERT(1   == Y.numParticipants());
+                ASSERT(&mY == P.reclaimer());
+                ASSERT(&ta == P.allocator());
+                ASSERT(0   == P.numRetired());
+                ASSERT(false == P.isInCriticalSection());
+                ASSERT(0   <  ta.numBlocksInUse());
+                ASSERT(0   == da.numBlocksInUse());
+
+                Participant *mQ = new (ta) Participant(&mY);
+                ASSERT(2   == Y.numParticipants());
+                ASSERT(&da == mQ->allocator());
+
+                Participant *mR = new (ta) Participant(&mY, &ta);
+                ASSERT(3   == Y.numParticipants());
+
+                ta.deleteObject(mQ);
+                ASSERT(2   == Y.numParticipants());
+                ASSERT(0   == da.numBlocksInUse());
+
+                ta.deleteObject(mR);
+                ASSERT(1   == Y.numParticipants());
+            }
+            ASSERT(0 == Y.numParticipants());
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+        ASSERT(0 == da.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_SAFE_FAIL(Obj(0, &ta));
+            ASSERT_SAFE_PASS(Obj(1, &ta));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a reclaimer and a participant, retire blocks inside and
+        //:   outside critical sections, and reclaim them.
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+        {
+            Obj         mX(&ta);
+            Participant mP(&mX, &ta);
+
+            {
+                Guard guard(&mP);
+                mP.retire(sa.allocate(8), &sa);
+            }
+            mP.retire(sa.allocate(8), &sa);
+            ASSERT(2 == sa.numBlocksInUse());
+
+            mP.reclaim();
+            mP.reclaim();
+            ASSERT(0 == sa.numBlocksInUse());
+
+            mP.retire(sa.allocate(8), &sa);
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
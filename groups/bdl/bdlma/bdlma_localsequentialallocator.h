@@ -0,0 +1,296 @@
+// bdlma_localsequentialallocator.h                                   -*-C++-*-
+#ifndef INCLUDED_BDLMA_LOCALSEQUENTIALALLOCATOR
+#define INCLUDED_BDLMA_LOCALSEQUENTIALALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an efficient managed allocator using a local buffer.
+//
+//@CLASSES:
+//  bdlma::LocalSequentialAllocator: allocator using an owned, aligned buffer
+//
+//@SEE_ALSO: bdlma_bufferedsequentialallocator, bsls_alignedbuffer
+//
+//@DESCRIPTION: This component provides a concrete mechanism,
+// 'bdlma::LocalSequentialAllocator', that implements the
+// 'bdlma::ManagedAllocator' protocol to very efficiently allocate
+// heterogeneous memory blocks (of varying, user-specified sizes) from a
+// maximally-aligned buffer, of a size specified as a template parameter, that
+// is part of the allocator object itself:
+//..
+//   ,-------------------------------.
+//  ( bdlma::LocalSequentialAllocator )
+//   `-------------------------------'
+//                   |        ctor
+//                   V
+//   ,----------------------------------.
+//  ( bdlma::BufferedSequentialAllocator )
+//   `----------------------------------'
+//                   |        dtor
+//                   |        expandSized
+//                   V
+//       ,-----------------------.
+//      ( bdlma::ManagedAllocator )
+//       `-----------------------'
+//                   |        release
+//                   V
+//          ,----------------.
+//         ( bslma::Allocator )
+//          `----------------'
+//                            allocate
+//                            deallocate
+//..
+// A 'bdlma::LocalSequentialAllocator' behaves exactly as a
+// 'bdlma::BufferedSequentialAllocator' whose external buffer is a
+// 'bsls::AlignedBuffer' of the same size: if an allocation request exceeds the
+// remaining free memory space in the local buffer, the allocator falls back to
+// a sequence of dynamically-allocated buffers obtained from the (optional)
+// allocator supplied at construction.  The 'release' method releases all
+// dynamically-allocated memory and makes the entire local buffer available
+// again, as does the destructor.  Individually allocated memory blocks cannot
+// be separately deallocated.
+//
+// Because the buffer is owned by the allocator and is maximally aligned, the
+// allocator can be declared in a single line -- typically as a local variable
+// in the scope that creates short-lived containers -- without the risk of
+// supplying a misaligned or undersized buffer, or of the buffer outliving (or
+// being outlived by) the allocator.  Note that the 'sizeof' a
+// 'bdlma::LocalSequentialAllocator' is (at least) its 'BUFFER_SIZE', so it
+// should be sized with the available stack space in mind.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Allocation-Free Temporary Containers
+///- - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we need to implement a function, 'countDistinctWords', that
+// splits a short text message into words, and returns the number of distinct
+// words.  The function builds a temporary 'bsl::vector' of 'bsl::string'
+// objects that is discarded on return, so its memory need not come from the
+// heap.
+//
+// First, we declare a 'bdlma::LocalSequentialAllocator' having enough
+// capacity for the typical message, and supply it to the temporary containers:
+//..
+//  int countDistinctWords(const char *message)
+//  {
+//      bdlma::LocalSequentialAllocator<2048> localAllocator;
+//
+//      bsl::vector<bsl::string> words(&localAllocator);
+//      bsl::string              word(&localAllocator);
+//..
+// Then, we split the message into words:
+//..
+//      for (const char *p = message; ; ++p) {
+//          if (' ' == *p || 0 == *p) {
+//              if (!word.empty()) {
+//                  words.push_back(word);
+//                  word.clear();
+//              }
+//              if (0 == *p) {
+//                  break;
+//              }
+//          }
+//          else {
+//              word.push_back(*p);
+//          }
+//      }
+//..
+// Finally, we sort the words and count the distinct ones:
+//..
+//      bsl::sort(words.begin(), words.end());
+//
+//      return static_cast<int>(bsl::unique(words.begin(), words.end())
+//                                                            - words.begin());
+//  }
+//..
+// For a message whose words fit in the 2048-byte local buffer, this function
+// performs no dynamic memory allocation at all; longer messages are handled
+// correctly using memory from the default allocator.
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_BUFFEREDSEQUENTIALALLOCATOR
+#include <bdlma_bufferedsequentialallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ASSERT
+#include <bslmf_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNEDBUFFER
+#include <bsls_alignedbuffer.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENT
+#include <bsls_alignment.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BLOCKGROWTH
+#include <bsls_blockgrowth.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                      // ==============================
+                      // class LocalSequentialAllocator
+                      // ==============================
+
+template <int BUFFER_SIZE>
+class LocalSequentialAllocator : public BufferedSequentialAllocator {
+    // This class implements the 'ManagedAllocator' protocol to provide a fast
+    // allocator that dispenses heterogeneous blocks of memory (of varying,
+    // user-specified sizes) from a maximally-aligned local buffer of the
+    // (template parameter) 'BUFFER_SIZE' bytes.  If an allocation request
+    // exceeds the remaining free memory space in the local buffer, memory will
+    // be supplied by an (optional) allocator supplied at construction; if no
+    // allocator is supplied, the currently installed default allocator is
+    // used.  This class is *exception* *neutral*: If memory cannot be
+    // allocated, the behavior is defined by the (optional) allocator supplied
+    // at construction.
+
+    BSLMF_ASSERT(0 < BUFFER_SIZE);
+
+    // DATA
+    bsls::AlignedBuffer<BUFFER_SIZE> d_buffer;  // local buffer (initially
+                                                // supplying all memory)
+
+  private:
+    // NOT IMPLEMENTED
+    LocalSequentialAllocator(const LocalSequentialAllocator&);
+    LocalSequentialAllocator& operator=(const LocalSequentialAllocator&);
+
+  public:
+    // CREATORS
+    explicit
+    LocalSequentialAllocator(bslma::Allocator *basicAllocator = 0);
+    explicit
+    LocalSequentialAllocator(bsls::BlockGrowth::Strategy  growthStrategy,
+                             bslma::Allocator            *basicAllocator = 0);
+    explicit
+    LocalSequentialAllocator(bsls::Alignment::Strategy  alignmentStrategy,
+                             bslma::Allocator          *basicAllocator = 0);
+    LocalSequentialAllocator(bsls::BlockGrowth::Strategy  growthStrategy,
+                             bsls::Alignment::Strategy    alignmentStrategy,
+                             bslma::Allocator            *basicAllocator = 0);
+        // Create a local sequential allocator for allocating memory blocks
+        // from a local buffer of 'BUFFER_SIZE' bytes.  Optionally specify a
+        // 'growthStrategy' used to control the growth of the buffers obtained
+        // once the local buffer is exhausted.  If a 'growthStrategy' is not
+        // specified, geometric growth is used.  Optionally specify an
+        // 'alignmentStrategy' used to align allocated memory blocks.  If an
+        // 'alignmentStrategy' is not specified, natural alignment is used.
+        // Optionally specify a 'basicAllocator' used to supply memory should
+        // the capacity of the local buffer be exhausted.  If 'basicAllocator'
+        // is 0, the currently installed default allocator is used.  Note that
+        // the local buffer is maximally aligned, so (unlike an arbitrary
+        // external buffer) none of its bytes are lost to the alignment of the
+        // first allocation.
+
+    //! virtual ~LocalSequentialAllocator() = default;
+        // Destroy this local sequential allocator.  All memory allocated from
+        // this allocator is released.
+
+    // ACCESSORS
+    int bufferSize() const;
+        // Return the size (in bytes) of the local buffer of this allocator,
+        // i.e., 'BUFFER_SIZE'.
+};
+
+// ============================================================================
+//                        INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                      // ------------------------------
+                      // class LocalSequentialAllocator
+                      // ------------------------------
+
+// Note that 'd_buffer' is constructed after the base class, but it is a POD
+// whose address (which is all the base class stores) is fixed beforehand.
+
+// CREATORS
+template <int BUFFER_SIZE>
+inline
+LocalSequentialAllocator<BUFFER_SIZE>::LocalSequentialAllocator(
+                                              bslma::Allocator *basicAllocator)
+: BufferedSequentialAllocator(d_buffer.buffer(), BUFFER_SIZE, basicAllocator)
+{
+}
+
+template <int BUFFER_SIZE>
+inline
+LocalSequentialAllocator<BUFFER_SIZE>::LocalSequentialAllocator(
+                                   bsls::BlockGrowth::Strategy  growthStrategy,
+                                   bslma::Allocator            *basicAllocator)
+: BufferedSequentialAllocator(d_buffer.buffer(),
+                              BUFFER_SIZE,
+                              growthStrategy,
+                              basicAllocator)
+{
+}
+
+template <int BUFFER_SIZE>
+inline
+LocalSequentialAllocator<BUFFER_SIZE>::LocalSequentialAllocator(
+                                  bsls::Alignment::Strategy  alignmentStrategy,
+                                  bslma::Allocator          *basicAllocator)
+: BufferedSequentialAllocator(d_buffer.buffer(),
+                              BUFFER_SIZE,
+                              alignmentStrategy,
+                              basicAllocator)
+{
+}
+
+template <int BUFFER_SIZE>
+inline
+LocalSequentialAllocator<BUFFER_SIZE>::LocalSequentialAllocator(
+                                bsls::BlockGrowth::Strategy  growthStrategy,
+                                bsls::Alignment::Strategy    alignmentStrategy,
+                                bslma::Allocator            *basicAllocator)
+: BufferedSequentialAllocator(d_buffer.buffer(),
+                              BUFFER_SIZE,
+                              growthStrategy,
+                              alignmentStrategy,
+                              basicAllocator)
+{
+}
+
+// ACCESSORS
+template <int BUFFER_SIZE>
+inline
+int LocalSequentialAllocator<BUFFER_SIZE>::bufferSize() const
+{
+    return BUFFER_SIZE;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,543 @@
+// bdlma_localsequentialallocator.t.cpp                               -*-C++-*-
+#include <bdlma_localsequentialallocator.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                             Overview
+//                             --------
+// A 'bdlma::LocalSequentialAllocator' is a
+// 'bdlma::BufferedSequentialAllocator' that owns its (aligned) buffer.  All
+// allocation behavior is inherited, so our concerns are that the owned buffer
+// is the one supplied to the base class, that it has the expected size and
+// alignment, that the constructor arguments are forwarded, that no memory is
+// obtained from the fallback allocator until the local buffer is exhausted,
+// and that 'release' makes the local buffer available again.
+//
+// As in the test driver of the base class, the global, default, and object
+// allocators are distinct test allocators, so that we can determine the
+// source of every dynamic allocation.
+//-----------------------------------------------------------------------------
+// // CREATORS
+// [ 2] bdlma::LocalSequentialAllocator<N>(*a = 0);
+// [ 2] bdlma::LocalSequentialAllocator<N>(GS, *a = 0);
+// [ 2] bdlma::LocalSequentialAllocator<N>(AS, *a = 0);
+// [ 2] bdlma::LocalSequentialAllocator<N>(GS, AS, *a = 0);
+// [ 3] ~bdlma::LocalSequentialAllocator<N>();
+//
+// // MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 3] void release();
+//
+// // ACCESSORS
+// [ 2] int bufferSize() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] CONCERN: STANDARD CONTAINERS DO NOT ALLOCATE DYNAMICALLY
+// [ 5] USAGE EXAMPLE
+
+//=============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+//=============================================================================
+//                  GLOBAL VARIABLES / TYPEDEF FOR TESTING
+//-----------------------------------------------------------------------------
+
+enum { BUFFER_SIZE = 256 };
+
+typedef bdlma::LocalSequentialAllocator<BUFFER_SIZE> Obj;
+
+typedef bsls::Alignment::Strategy                    Strat;
+typedef bsls::BlockGrowth::Strategy                  Growth;
+
+template <int SIZE>
+bool isWithin(const void                                   *address,
+              const bdlma::LocalSequentialAllocator<SIZE>&  allocator)
+    // Return 'true' if the specified 'address' lies within the footprint of
+    // the specified 'allocator' object (and thus within its local buffer),
+    // and 'false' otherwise.
+{
+    const char *p     = static_cast<const char *>(address);
+    const char *begin = reinterpret_cast<const char *>(&allocator);
+    return begin <= p && p < begin + sizeof allocator;
+}
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Allocation-Free Temporary Containers
+///- - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we need to implement a function, 'countDistinctWords', that
+// splits a short text message into words, and returns the number of distinct
+// words.  The function builds a temporary 'bsl::vector' of 'bsl::string'
+// objects that is discarded on return, so its memory need not come from the
+// heap.
+//
+// First, we declare a 'bdlma::LocalSequentialAllocator' having enough
+// capacity for the typical message, and supply it to the temporary containers:
+//..
+    int countDistinctWords(const char *message)
+    {
+        bdlma::LocalSequentialAllocator<2048> localAllocator;
+
+        bsl::vector<bsl::string> words(&localAllocator);
+        bsl::string              word(&localAllocator);
+//..
+// Then, we split the message into words:
+//..
+        for (const char *p = message; ; ++p) {
+            if (' ' == *p || 0 == *p) {
+                if (!word.empty()) {
+                    words.push_back(word);
+                    word.clear();
+                }
+                if (0 == *p) {
+                    break;
+                }
+            }
+            else {
+                word.push_back(*p);
+            }
+        }
+//..
+// Finally, we sort the words and count the distinct ones:
+//..
+        bsl::sort(words.begin(), words.end());
+
+        return static_cast<int>(bsl::unique(words.begin(), words.end())
+                                                              - words.begin());
+    }
+//..
+// For a message whose words fit in the 2048-byte local buffer, this function
+// performs no dynamic memory allocation at all; longer messages are handled
+// correctly using memory from the default allocator.
+
+//=============================================================================
+//                                MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // As part of our overall allocator testing strategy, we will create
+    // three test allocators.
+
+    // Object Test Allocator
+    bslma::TestAllocator objectAllocator("Object Allocator",
+                                         veryVeryVeryVerbose);
+
+    // Default Test Allocator
+    bslma::TestAllocator defaultAllocator("Default Allocator",
+                                          veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    // Global Test Allocator
+    bslma::TestAllocator globalAllocator("Global Allocator",
+                                         veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "USAGE EXAMPLE" << endl
+                                  << "=============" << endl;
+
+        ASSERT(0 == countDistinctWords(""));
+        ASSERT(5 == countDistinctWords("the cat and the hat and the bat"));
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+
+        // A long message spills over into the default allocator, and all of
+        // that memory is returned.
+
+        bsl::string message(&objectAllocator);
+        for (int i = 0; i < 200; ++i) {
+            message += "word";
+            message += static_cast<char>('a' + i % 26);
+            message += static_cast<char>('a' + i / 26);
+            message += ' ';
+        }
+        ASSERT(200 == countDistinctWords(message.c_str()));
+        ASSERT(0 <  defaultAllocator.numBlocksTotal());
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CONCERN: STANDARD CONTAINERS DO NOT ALLOCATE DYNAMICALLY
+        //
+        // Concerns:
+        //: 1 Temporary 'bsl::vector' and 'bsl::string' objects that use a
+        //:   local sequential allocator, and whose memory requirements fit in
+        //:   its local buffer, do not allocate from the default, global, or
+        //:   fallback allocator, even when they grow.
+        //
+        // Plan:
+        //: 1 Create a local sequential allocator with a fallback test
+        //:   allocator, and use it to grow a 'bsl::vector<int>' and a
+        //:   'bsl::string' one element at a time.  Verify that no allocator
+        //:   other than the local sequential allocator is used.  (C-1)
+        //
+        // Testing:
+        //   CONCERN: STANDARD CONTAINERS DO NOT ALLOCATE DYNAMICALLY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                 << "CONCERN: STANDARD CONTAINERS DO NOT ALLOCATE DYNAMICALLY"
+                 << endl
+                 << "========================================================"
+                 << endl;
+
+        {
+            bdlma::LocalSequentialAllocator<1024> mX(&objectAllocator);
+
+            bsl::vector<int> v(&mX);
+            bsl::string      s(&mX);
+
+            for (int i = 0; i < 64; ++i) {
+                v.push_back(i);
+                s.push_back(static_cast<char>('a' + i % 26));
+            }
+            ASSERT(64 == v.size());
+            ASSERT(64 == s.size());
+            ASSERT(isWithin(&v[0], mX));
+            ASSERT(isWithin(s.data(), mX));
+        }
+        ASSERTV(objectAllocator.numBlocksTotal(),
+                0 == objectAllocator.numBlocksTotal());
+        ASSERTV(defaultAllocator.numBlocksTotal(),
+                0 == defaultAllocator.numBlocksTotal());
+        ASSERTV(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // OVERFLOW, RELEASE, AND DTOR TEST
+        //
+        // Concerns:
+        //: 1 Memory is dispensed from the local buffer until it is exhausted,
+        //:   without use of the fallback allocator.
+        //:
+        //: 2 Once the local buffer is exhausted, memory is obtained from the
+        //:   fallback allocator.
+        //:
+        //: 3 'release' returns all fallback memory and makes the whole local
+        //:   buffer available again.
+        //:
+        //: 4 The destructor returns all fallback memory.
+        //
+        // Plan:
+        //: 1 Allocate fixed-size blocks from an object until the fallback
+        //:   allocator is used, verifying that each prior block lies within
+        //:   the object.  (C-1..2)
+        //:
+        //: 2 Invoke 'release' and verify that the fallback allocator has no
+        //:   blocks in use and that the next allocation is at the start of
+        //:   the local buffer.  (C-3)
+        //:
+        //: 3 Overflow again, let the object go out of scope, and verify that
+        //:   the fallback allocator has no blocks in use.  (C-4)
+        //
+        // Testing:
+        //   ~bdlma::LocalSequentialAllocator<N>();
+        //   void *allocate(size_type size);
+        //   void release();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "OVERFLOW, RELEASE, AND DTOR TEST" << endl
+                          << "================================" << endl;
+
+        enum { ALLOC_SIZE = 16 };
+
+        {
+            Obj        mX(&objectAllocator);
+            const Obj& X = mX;
+
+            void *first = mX.allocate(ALLOC_SIZE);
+            ASSERT(isWithin(first, X));
+
+            int numLocal = 1;
+            while (0 == objectAllocator.numBlocksTotal()) {
+                void *p = mX.allocate(ALLOC_SIZE);
+                if (0 == objectAllocator.numBlocksTotal()) {
+                    ASSERT(isWithin(p, X));
+                    ++numLocal;
+                }
+                else {
+                    ASSERT(!isWithin(p, X));
+                }
+            }
+            ASSERTV(numLocal, BUFFER_SIZE / ALLOC_SIZE == numLocal);
+
+            if (verbose) cout << "\nTesting 'release'." << endl;
+
+            mX.release();
+            ASSERT(0 == objectAllocator.numBlocksInUse());
+            ASSERT(first == mX.allocate(ALLOC_SIZE));
+
+            mX.allocate(BUFFER_SIZE);
+            ASSERT(0 < objectAllocator.numBlocksInUse());
+        }
+        ASSERT(0 == objectAllocator.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CTOR AND ACCESSOR TEST
+        //
+        // Concerns:
+        //: 1 Each constructor creates an object whose first allocation comes
+        //:   from the start of its (maximally-aligned) local buffer.
+        //:
+        //: 2 The alignment strategy supplied at construction is honored.
+        //:
+        //: 3 The growth strategy supplied at construction is honored once the
+        //:   local buffer is exhausted.
+        //:
+        //: 4 If no allocator is supplied, the default allocator is used as the
+        //:   fallback allocator.
+        //:
+        //: 5 'bufferSize' returns 'BUFFER_SIZE'.
+        //
+        // Plan:
+        //: 1 Construct objects with each constructor, and verify that the
+        //:   first allocation is maximally aligned and within the object, and
+        //:   that the second allocation follows the specified alignment
+        //:   strategy.  (C-1..2, 5)
+        //:
+        //: 2 Exhaust the local buffer of objects created with constant and
+        //:   geometric growth, and compare the sizes of the blocks obtained
+        //:   from the fallback allocator.  (C-3)
+        //:
+        //: 3 Exhaust the local buffer of an object created without an
+        //:   allocator, and verify that the default allocator is used.  (C-4)
+        //
+        // Testing:
+        //   bdlma::LocalSequentialAllocator<N>(*a = 0);
+        //   bdlma::LocalSequentialAllocator<N>(GS, *a = 0);
+        //   bdlma::LocalSequentialAllocator<N>(AS, *a = 0);
+        //   bdlma::LocalSequentialAllocator<N>(GS, AS, *a = 0);
+        //   int bufferSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CTOR AND ACCESSOR TEST" << endl
+                                  << "======================" << endl;
+
+        const int MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+        const Strat  MAX = bsls::Alignment::BSLS_MAXIMUM;
+        const Strat  BYT = bsls::Alignment::BSLS_BYTEALIGNED;
+        const Growth GEO = bsls::BlockGrowth::BSLS_GEOMETRIC;
+        const Growth CON = bsls::BlockGrowth::BSLS_CONSTANT;
+
+        if (verbose) cout << "\nTesting alignment strategies." << endl;
+        {
+            Obj mA(&objectAllocator);
+            Obj mB(GEO, &objectAllocator);
+            Obj mC(MAX, &objectAllocator);
+            Obj mD(CON, BYT, &objectAllocator);
+
+            Obj *const OBJS[] = { &mA, &mB, &mC, &mD };
+            const int  NUM_OBJS = sizeof OBJS / sizeof *OBJS;
+
+            for (int i = 0; i < NUM_OBJS; ++i) {
+                Obj& mX = *OBJS[i];
+
+                ASSERTV(i, BUFFER_SIZE == mX.bufferSize());
+
+                char *p = static_cast<char *>(mX.allocate(1));
+                char *q = static_cast<char *>(mX.allocate(8));
+
+                ASSERTV(i, isWithin(p, mX));
+                ASSERTV(i, 0 == bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                               p, MAX_ALIGN));
+
+                const bsls::Types::IntPtr OFFSET = q - p;
+                if (veryVerbose) { T_ P_(i) P(OFFSET) }
+
+                switch (i) {
+                  case 2: ASSERTV(i, OFFSET, MAX_ALIGN == OFFSET); break;
+                  case 3: ASSERTV(i, OFFSET,         1 == OFFSET); break;
+                  default: ASSERTV(i, OFFSET,        8 == OFFSET);
+                }
+            }
+            ASSERT(0 == objectAllocator.numBlocksTotal());
+        }
+
+        if (verbose) cout << "\nTesting growth strategies." << endl;
+        {
+            bslma::TestAllocator taG(veryVeryVeryVerbose);
+            bslma::TestAllocator taC(veryVeryVeryVerbose);
+
+            Obj mG(GEO, &taG);
+            Obj mC(CON, &taC);
+
+            for (int i = 0; i < 4 * BUFFER_SIZE; ++i) {
+                mG.allocate(16);
+                mC.allocate(16);
+            }
+            ASSERTV(taG.numBlocksTotal(), taC.numBlocksTotal(),
+                    taG.numBlocksTotal() < taC.numBlocksTotal());
+        }
+
+        if (verbose) cout << "\nTesting default fallback allocator." << endl;
+        {
+            Obj mX;
+
+            mX.allocate(BUFFER_SIZE);
+            ASSERT(0 == defaultAllocator.numBlocksTotal());
+
+            mX.allocate(1);
+            ASSERT(1 == defaultAllocator.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an object, allocate from its local buffer, overflow it,
+        //:   and destroy it, verifying the source of each allocation.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST" << endl
+                                  << "==============" << endl;
+
+        ASSERT(BUFFER_SIZE <= static_cast<int>(sizeof(Obj)));
+
+        {
+            Obj mX(&objectAllocator);
+
+            void *addr1 = mX.allocate(4);
+            void *addr2 = mX.allocate(8);
+
+            ASSERT(isWithin(addr1, mX));
+            ASSERT(isWithin(addr2, mX));
+            ASSERT(static_cast<char *>(addr1) + 4 <= addr2);
+            ASSERT(0 == objectAllocator.numBlocksTotal());
+
+            void *addr3 = mX.allocate(BUFFER_SIZE);
+            ASSERT(!isWithin(addr3, mX));
+            ASSERT(1 == objectAllocator.numBlocksInUse());
+        }
+        ASSERT(0 == objectAllocator.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+        ASSERT(0 == globalAllocator.numBlocksTotal());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -10,10 +10,15 @@ BSLS_IDENT_RCSID(bdlma_multipool_cpp,"$Id$ $CSID$")
 #include <bslma_deallocatorproctor.h>
 #include <bslma_default.h>
 
+#include <bsls_alignmentfromtype.h>
+#include <bsls_alignmentutil.h>
 #include <bsls_assert.h>
+#include <bsls_exceptionutil.h>
 #include <bsls_performancehint.h>
 #include <bsls_platform.h>
+#include <bsls_types.h>
 
+#include <bsl_climits.h>  // 'INT_MAX'
 #include <bsl_new.h>
 
 namespace BloombergLP {
@@ -25,7 +30,10 @@ enum {
 
     DEFAULT_MAX_CHUNK_SIZE = 32,  // default maximum number of blocks per chunk
 
-    MIN_BLOCK_SIZE         =  8   // minimum block size (in bytes)
+    MIN_BLOCK_SIZE         =  8,  // minimum block size (in bytes)
+
+    BLOCK_ALIGNMENT        = bsls::AlignmentFromType<void *>::VALUE
+                                  // alignment guaranteed for a sized block
 };
 
                       // ---------------
@@ -62,6 +70,8 @@ void Multipool::initialize(bsls::BlockGrowth::Strategy growthStrategy,
 
     autoDtor.release();
     autoPoolsDeallocator.release();
+
+    initializeAlignedPools();
 }
 
 void Multipool::initialize(
@@ -95,6 +105,8 @@ void Multipool::initialize(
 
     autoDtor.release();
     autoPoolsDeallocator.release();
+
+    initializeAlignedPools();
 }
 
 void Multipool::initialize(bsls::BlockGrowth::Strategy  growthStrategy,
@@ -126,6 +138,8 @@ void Multipool::initialize(bsls::BlockGrowth::Strategy  growthStrategy,
 
     autoDtor.release();
     autoPoolsDeallocator.release();
+
+    initializeAlignedPools();
 }
 
 void Multipool::initialize(
@@ -159,6 +173,26 @@ void Multipool::initialize(
 
     autoDtor.release();
     autoPoolsDeallocator.release();
+
+    initializeAlignedPools();
+}
+
+void Multipool::initializeAlignedPools()
+{
+    // The blocks of a pool are spaced by its block size from a maximally
+    // aligned address, so they are aligned to 'alignment' if the block size
+    // is a multiple of 'alignment' (e.g., the 24-byte blocks of the first
+    // pool are not aligned for a 16-byte 'long double').
+
+    for (int alignment = 1;
+         alignment <= bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+         alignment *= 2) {
+        int pool = d_numPools;
+        while (0 < pool && 0 == d_pools_p[pool - 1].blockSize() % alignment) {
+            --pool;
+        }
+        d_alignedPools[alignment] = pool;
+    }
 }
 
 // PRIVATE ACCESSORS
@@ -195,6 +229,33 @@ int Multipool::findPool(int size) const
 #endif
 }
 
+int Multipool::findSizedPool(int size) const
+{
+    BSLS_ASSERT_SAFE(1 <= size);
+
+    // Each pool dispenses blocks large enough to hold a 'Header' followed by
+    // a 'Header'-less request of its nominal block size.
+
+    const int headerSize = static_cast<int>(sizeof(Header));
+
+    if (size - headerSize > d_maxBlockSize) {
+        return -1;                                                    // RETURN
+    }
+
+    const int sizePool    = size <= headerSize
+                          ? 0
+                          : findPool(size - headerSize);
+    const int alignedPool = d_alignedPools[
+                        bsls::AlignmentUtil::calculateAlignmentFromSize(size)];
+
+    // The pools from 'alignedPool' are all aligned for 'size', so the first
+    // pool large enough and aligned for 'size' is the later of the two.
+
+    const int pool = sizePool < alignedPool ? alignedPool : sizePool;
+
+    return pool < d_numPools ? pool : -1;
+}
+
 // CREATORS
 Multipool::Multipool(bslma::Allocator *basicAllocator)
 : d_numPools(DEFAULT_NUM_POOLS)
@@ -358,6 +419,134 @@ void Multipool::deallocate(void *address)
     }
 }
 
+void *Multipool::allocateSized(int size)
+{
+    BSLS_ASSERT(1 <= size);
+
+    const int pool = findSizedPool(size);
+
+    if (-1 == pool) {
+        return d_blockList.allocate(size);                            // RETURN
+    }
+
+    return d_pools_p[pool].allocate();
+}
+
+void Multipool::deallocateSized(void *address, int size)
+{
+    BSLS_ASSERT(address);
+    BSLS_ASSERT(1 <= size);
+
+    const int pool = findSizedPool(size);
+
+    if (-1 == pool) {
+        d_blockList.deallocate(address);
+    }
+    else {
+        d_pools_p[pool].deallocate(address);
+    }
+}
+
+void Multipool::allocateBatch(void **addresses, int numBlocks, int size)
+{
+    BSLS_ASSERT(addresses || 0 == numBlocks);
+    BSLS_ASSERT(0 <= numBlocks);
+    BSLS_ASSERT(1 <= size);
+
+    const int pool = findSizedPool(size);
+
+    if (-1 == pool) {
+        int i = 0;
+
+        BSLS_TRY {
+            for (; i < numBlocks; ++i) {
+                addresses[i] = d_blockList.allocate(size);
+            }
+        }
+        BSLS_CATCH(...) {
+            while (i > 0) {
+                d_blockList.deallocate(addresses[--i]);
+            }
+            BSLS_RETHROW;
+        }
+        return;                                                       // RETURN
+    }
+
+    // Reserving first guarantees that the loop below does not throw.
+
+    bdlma::Pool& sizedPool = d_pools_p[pool];
+    sizedPool.reserveCapacity(numBlocks);
+
+    for (int i = 0; i < numBlocks; ++i) {
+        addresses[i] = sizedPool.allocate();
+    }
+}
+
+void Multipool::deallocateBatch(void *const *addresses,
+                                int          numBlocks,
+                                int          size)
+{
+    BSLS_ASSERT(addresses || 0 == numBlocks);
+    BSLS_ASSERT(0 <= numBlocks);
+    BSLS_ASSERT(1 <= size);
+
+    const int pool = findSizedPool(size);
+
+    if (-1 == pool) {
+        for (int i = 0; i < numBlocks; ++i) {
+            d_blockList.deallocate(addresses[i]);
+        }
+        return;                                                       // RETURN
+    }
+
+    bdlma::Pool& sizedPool = d_pools_p[pool];
+
+    for (int i = 0; i < numBlocks; ++i) {
+        BSLS_ASSERT_SAFE(addresses[i]);
+
+        sizedPool.deallocate(addresses[i]);
+    }
+}
+
+void *Multipool::allocateAligned(int size, int alignment)
+{
+    BSLS_ASSERT(1 <= size);
+    BSLS_ASSERT(0 < alignment);
+    BSLS_ASSERT(0 == (alignment & (alignment - 1)));
+    BSLS_ASSERT(size <= INT_MAX - alignment);
+
+    if (alignment <= BLOCK_ALIGNMENT) {
+        return allocateSized(size);                                   // RETURN
+    }
+
+    // 'block' is aligned to (at least) 'BLOCK_ALIGNMENT', so the aligned
+    // address is at least 'BLOCK_ALIGNMENT' (and at most 'alignment') bytes
+    // beyond it, leaving room to store 'block' immediately before the aligned
+    // address.
+
+    char *block   = static_cast<char *>(allocateSized(size + alignment));
+    char *address = block + alignment
+                  - (reinterpret_cast<bsls::Types::UintPtr>(block)
+                                                          & (alignment - 1));
+
+    reinterpret_cast<void **>(address)[-1] = block;
+    return address;
+}
+
+void Multipool::deallocateAligned(void *address, int size, int alignment)
+{
+    BSLS_ASSERT(address);
+    BSLS_ASSERT(1 <= size);
+    BSLS_ASSERT(0 < alignment);
+
+    if (alignment <= BLOCK_ALIGNMENT) {
+        deallocateSized(address, size);
+        return;                                                       // RETURN
+    }
+
+    deallocateSized(reinterpret_cast<void **>(address)[-1], size + alignment);
+}
+
 void Multipool::release()
 {
     for (int i = 0; i < d_numPools; ++i) {
@@ -372,8 +561,34 @@ void Multipool::reserveCapacity(int size, int numBlocks)
     BSLS_ASSERT(size <= d_maxBlockSize);
     BSLS_ASSERT(0    <= numBlocks);
 
+    // Requests made by 'allocate' and by 'allocateSized' for the same 'size'
+    // may be served by different pools: reserve in both.
+
     const int pool = findPool(size);
     d_pools_p[pool].reserveCapacity(numBlocks);
+
+    const int sizedPool = findSizedPool(size);
+    if (-1 != sizedPool && pool != sizedPool) {
+        d_pools_p[sizedPool].reserveCapacity(numBlocks);
+    }
+}
+
+void Multipool::setReclaimThreshold(int numFreeBlocks)
+{
+    BSLS_ASSERT(Pool::k_NO_RECLAIM <= numFreeBlocks);
+
+    for (int i = 0; i < d_numPools; ++i) {
+        d_pools_p[i].setReclaimThreshold(numFreeBlocks);
+    }
+}
+
+int Multipool::shrink()
+{
+    int numReclaimed = 0;
+    for (int i = 0; i < d_numPools; ++i) {
+        numReclaimed += d_pools_p[i].shrink();
+    }
+    return numReclaimed;
 }
 
 }  // close package namespace
@@ -26,6 +26,31 @@ BSLS_IDENT("$Id: $")
 // sufficient size exists.  Both the 'release' method and the destructor of a
 // 'bdlma::Multipool' release all memory currently allocated via the object.
 //
+// Each block dispensed by 'allocate' is prefixed with a (maximally-aligned)
+// header identifying the pool that supplied it, so that 'deallocate' can
+// return the block to that pool.  Clients that know the size of each block
+// they return (e.g., containers) can instead use 'allocateSized' and
+// 'deallocateSized', which locate the pool from the size, and therefore
+// store no header.  Blocks from the two pairs of methods are supplied by the
+// same pools, but must not be mixed: a block obtained from 'allocateSized'
+// must be returned using 'deallocateSized' (with the same size), and a block
+// obtained from 'allocate' must be returned using 'deallocate'.
+//
+// By default, the chunks obtained by the pools are returned to the underlying
+// allocator only by 'release' or the destructor.  Clients expecting bursts of
+// allocation can call 'setReclaimThreshold' to have the chunks of every pool
+// tracked, and returned to the underlying allocator once entirely free, either
+// by an explicit call to 'shrink', or automatically (see "Chunk Reclamation"
+// in 'bdlma_pool').
+//
+// Blocks supplied by the pools are aligned only to the alignment of a pointer.
+// Clients requiring a stricter alignment (e.g., that of a cache line) use
+// 'allocateAligned' and 'deallocateAligned', which obtain a sized block
+// padded by the requested alignment from the pools, and store the address of
+// the padded block immediately before the aligned address they return.  As
+// padded blocks are returned to (and reused from) the pools, over-aligned
+// requests do not defeat pooling.
+//
 // A 'bdlma::Multipool' can be depicted visually:
 //..
 //                    +-----+--- memory blocks of 8 bytes
@@ -525,6 +550,13 @@ class Multipool {
                                        // by the 'd_numPools - 1'th pool;
                                        // always a power of 2
 
+    int               d_alignedPools[
+                              bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT + 1];
+                                       // index, for each power-of-2
+                                       // alignment, of the first pool from
+                                       // which the blocks of all pools are so
+                                       // aligned, or 'd_numPools' if none
+
     BlockList         d_blockList;     // memory manager for "large" memory
                                        // blocks
 
@@ -546,6 +578,12 @@ class Multipool {
         // with the corresponding growth strategy or max blocks per chunk entry
         // within the array.
 
+    void initializeAlignedPools();
+        // Load into 'd_alignedPools' the index of the first pool, for each
+        // power-of-2 alignment, from which the blocks of all pools of this
+        // multipool are so aligned.  The behavior is undefined unless the
+        // pools of this multipool are initialized.
+
     // PRIVATE ACCESSORS
     int findPool(int size) const;
         // Return the index of the memory pool in this multipool for an
@@ -554,6 +592,15 @@ class Multipool {
         // the index of the memory pool managing memory blocks having the
         // minimum block size is 0.
 
+    int findSizedPool(int size) const;
+        // Return the index of the memory pool in this multipool for a sized
+        // allocation request (see 'allocateSized') of the specified 'size' (in
+        // bytes), or -1 if the request is to be satisfied from the list of
+        // large blocks.  The behavior is undefined unless '1 <= size'.  Note
+        // that, since sized requests are not prefixed with a 'Header', the
+        // size of the 'Header' is available to the block returned.  Also note
+        // that this function runs in constant time.
+
   private:
     // NOT IMPLEMENTED
     Multipool(const Multipool&);
@@ -676,8 +723,71 @@ class Multipool {
     void deallocate(void *address);
         // Relinquish the memory block at the specified 'address' back to this
         // multipool object for reuse.  The behavior is undefined unless
-        // 'address' is non-zero, was allocated by this multipool object, and
-        // has not already been deallocated.
+        // 'address' is non-zero, was allocated by this multipool object using
+        // 'allocate', and has not already been deallocated.
+
+    void *allocateSized(int size);
+        // Return the address of a contiguous block of memory of (at least) the
+        // specified 'size' (in bytes), aligned for any object of 'size' bytes
+        // (see 'bsls::AlignmentUtil::calculateAlignmentFromSize'), that must
+        // be returned to this multipool using 'deallocateSized' supplying the
+        // same 'size'.
+        // Unlike 'allocate', no header identifying the supplying pool is
+        // stored with the block, hence a sized request can be satisfied from
+        // a pool whose blocks are smaller (by the size of the header) than
+        // those needed by an equivalent call to 'allocate'.  If 'size' is
+        // large enough that the request cannot be pooled, the memory
+        // allocation is managed directly by the underlying allocator, but
+        // will be deallocated when the 'release' method is called, or when
+        // this object is destroyed.  The behavior is undefined unless
+        // '1 <= size'.
+
+    void deallocateSized(void *address, int size);
+        // Relinquish the memory block at the specified 'address', having the
+        // specified 'size' (in bytes), back to this multipool object for
+        // reuse.  The behavior is undefined unless 'address' was allocated by
+        // a call to 'allocateSized' on this multipool object supplying the
+        // same 'size', and has not already been deallocated.
+
+    void allocateBatch(void **addresses, int numBlocks, int size);
+        // Load into the specified 'addresses' array the addresses of the
+        // specified 'numBlocks' blocks of memory, each of (at least) the
+        // specified 'size' (in bytes) and obtained as if by 'allocateSized',
+        // that must be returned to this multipool using 'deallocateBatch' or
+        // 'deallocateSized' supplying the same 'size'.  The supplying pool is
+        // located once for the whole batch, and is replenished (if needed)
+        // with a single chunk.  If an exception is thrown, no blocks are
+        // allocated.  The behavior is undefined unless 'addresses' refers to
+        // an array of at least 'numBlocks' elements, '0 <= numBlocks', and
+        // '1 <= size'.
+
+    void deallocateBatch(void *const *addresses, int numBlocks, int size);
+        // Relinquish the specified 'numBlocks' memory blocks whose addresses
+        // are held in the specified 'addresses' array, each having the
+        // specified 'size' (in bytes), back to this multipool object for
+        // reuse.  The behavior is undefined unless each block was allocated by
+        // a call to 'allocateSized' or 'allocateBatch' on this multipool
+        // object supplying the same 'size', and has not already been
+        // deallocated.
+
+    void *allocateAligned(int size, int alignment);
+        // Return the address of a contiguous block of memory of (at least)
+        // the specified 'size' (in bytes), that is a multiple of the specified
+        // 'alignment', and that must be returned to this multipool using
+        // 'deallocateAligned' supplying the same 'size' and 'alignment'.  If
+        // 'alignment' does not exceed the alignment of a pointer, the block is
+        // obtained as if by 'allocateSized(size)'; otherwise, it lies within a
+        // block obtained as if by 'allocateSized(size + alignment)'.  The
+        // behavior is undefined unless '1 <= size', 'alignment' is a positive,
+        // integral power of 2, and 'size + alignment <= INT_MAX'.
+
+    void deallocateAligned(void *address, int size, int alignment);
+        // Relinquish the memory block at the specified 'address', having the
+        // specified 'size' (in bytes) and 'alignment', back to this multipool
+        // object for reuse.  The behavior is undefined unless 'address' was
+        // allocated by a call to 'allocateAligned' on this multipool object
+        // supplying the same 'size' and 'alignment', and has not already been
+        // deallocated.
 
     template <class TYPE>
     void deleteObject(const TYPE *object);
@@ -705,8 +815,29 @@ class Multipool {
     void reserveCapacity(int size, int numBlocks);
         // Reserve memory from this multipool to satisfy memory requests for at
         // least the specified 'numBlocks' having the specified 'size' (in
-        // bytes) before the pool replenishes.  The behavior is undefined
+        // bytes) before the pool replenishes, whether the requests are made
+        // by 'allocate' or by 'allocateSized'.  The behavior is undefined
         // unless '1 <= size <= maxPooledBlockSize()' and '0 <= numBlocks'.
+        // Note that if the two kinds of request for 'size' are served by
+        // different pools, 'numBlocks' blocks are reserved in each.
+
+    void setReclaimThreshold(int numFreeBlocks);
+        // Set the reclamation threshold of each pool managed by this multipool
+        // to the specified 'numFreeBlocks' (see 'bdlma_pool').  If
+        // 'numFreeBlocks' is
+        // 'bdlma::Pool::k_NO_RECLAIM', chunks subsequently obtained by the
+        // pools are not tracked for reclamation; otherwise they are, and, if
+        // '0 < numFreeBlocks', a pool is shrunk automatically once more than
+        // 'numFreeBlocks' of its blocks are free.  The behavior is undefined
+        // unless 'bdlma::Pool::k_NO_RECLAIM <= numFreeBlocks'.
+
+    int shrink();
+        // Return to the underlying allocator each chunk of the pools managed
+        // by this multipool, obtained while reclamation was enabled, none of
+        // whose blocks is outstanding, and return the number of chunks so
+        // reclaimed.  Note that memory blocks too large to be pooled are
+        // returned to the underlying allocator on deallocation, and are
+        // therefore unaffected.
 
     // ACCESSORS
     int numPools() const;
@@ -15,6 +15,7 @@
 #include <bsls_types.h>
 
 #include <bsl_algorithm.h>
+#include <bsl_climits.h>
 #include <bsl_cstdio.h>
 #include <bsl_cstdlib.h>
 #include <bsl_cstring.h>
@@ -57,15 +58,23 @@ using namespace bsl;
 // [ 2] ~bdlma::Multipool();
 // [ 3] void *allocate(int size);
 // [ 4] void deallocate(void *address);
+// [10] void *allocateSized(int size);
+// [10] void deallocateSized(void *address, int size);
+// [11] void allocateBatch(void **addresses, int numBlocks, int size);
+// [11] void deallocateBatch(void *const *addr, int numBlocks, int size);
+// [12] void *allocateAligned(int size, int alignment);
+// [12] void deallocateAligned(void *address, int size, int alignment);
 // [ 8] template <class TYPE> void deleteObject(const TYPE *object);
 // [ 8] template <class TYPE> void deleteObjectRaw(const TYPE *object);
 // [ 5] void release();
 // [ 6] void reserveCapacity(int size, int numBlocks);
+// [13] void setReclaimThreshold(int numFreeBlocks);
+// [13] int shrink();
 // [ 9] int numPools() const;
 // [ 9] int maxPooledBlockSize() const;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [10] USAGE EXAMPLE
+// [14] USAGE EXAMPLE
 // [ *] CONCERN: Precondition violations are detected when enabled.
 
 //=============================================================================
@@ -620,7 +629,7 @@ int main(int argc, char *argv[])
     bslma::Allocator     *Z = &testAllocator;
 
     switch (test) { case 0:
-      case 10: {
+      case 14: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -669,6 +678,532 @@ int main(int argc, char *argv[])
         }
 
       } break;
+      case 13: {
+        // --------------------------------------------------------------------
+        // TESTING CHUNK RECLAMATION
+        //
+        // Concerns:
+        //: 1 'shrink' has no effect unless reclamation is enabled.
+        //:
+        //: 2 'setReclaimThreshold' applies to every pool, and 'shrink'
+        //:   returns the entirely free chunks of every pool, reporting their
+        //:   total number.
+        //:
+        //: 3 Blocks that are still outstanding, and their chunks, are
+        //:   unaffected.
+        //:
+        //: 4 With a positive threshold, the pools shrink automatically.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Using a multipool with constant growth, supplied with a test
+        //:   allocator, allocate and deallocate blocks of several sizes, and
+        //:   verify the number of blocks in use by the test allocator before
+        //:   and after calls to 'shrink', with and without reclamation
+        //:   enabled, and with a block outstanding.  (C-1..3)
+        //:
+        //: 2 Set a positive threshold, and verify that the footprint drops
+        //:   as blocks are deallocated.  (C-4)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-5)
+        //
+        // Testing:
+        //   void setReclaimThreshold(int numFreeBlocks);
+        //   int shrink();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING CHUNK RECLAMATION"
+                          << endl << "=========================" << endl;
+
+        const bsls::BlockGrowth::Strategy CON =
+                                             bsls::BlockGrowth::BSLS_CONSTANT;
+
+        enum { NUM_POOLS = 5, CHUNK = 4, NUM_BLOCKS = 4 * CHUNK };
+
+        static const int SIZES[] = { 8, 16, 64 };
+        const int NUM_SIZES = static_cast<int>(sizeof SIZES / sizeof *SIZES);
+
+        void *blocks[NUM_SIZES][NUM_BLOCKS];
+
+        for (int tr = 0; tr < 2; ++tr) {
+            const bool RECLAIM = tr;
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj mX(NUM_POOLS, CON, CHUNK, &ta);
+
+            if (RECLAIM) {
+                mX.setReclaimThreshold(bdlma::Pool::k_RECLAIM_ON_DEMAND);
+            }
+
+            const bsls::Types::Int64 BASE = ta.numBlocksInUse();
+
+            for (int ti = 0; ti < NUM_SIZES; ++ti) {
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    blocks[ti][i] = mX.allocateSized(SIZES[ti]);
+                }
+            }
+
+            const bsls::Types::Int64 NUM_CHUNKS = ta.numBlocksInUse() - BASE;
+            ASSERTV(RECLAIM, NUM_CHUNKS,
+                    NUM_SIZES * NUM_BLOCKS / CHUNK == NUM_CHUNKS);
+
+            ASSERTV(RECLAIM, 0 == mX.shrink());
+
+            // Keep the first block of each size outstanding.
+
+            for (int ti = 0; ti < NUM_SIZES; ++ti) {
+                for (int i = 1; i < NUM_BLOCKS; ++i) {
+                    mX.deallocateSized(blocks[ti][i], SIZES[ti]);
+                }
+            }
+
+            const int NUM_RECLAIMED = mX.shrink();
+            ASSERTV(RECLAIM, NUM_RECLAIMED,
+                    (RECLAIM ? NUM_CHUNKS - NUM_SIZES : 0) == NUM_RECLAIMED);
+            ASSERTV(RECLAIM,
+                    BASE + NUM_CHUNKS - NUM_RECLAIMED == ta.numBlocksInUse());
+
+            for (int ti = 0; ti < NUM_SIZES; ++ti) {
+                mX.deallocateSized(blocks[ti][0], SIZES[ti]);
+            }
+            ASSERTV(RECLAIM, (RECLAIM ? NUM_SIZES : 0) == mX.shrink());
+            ASSERTV(RECLAIM, (RECLAIM ? BASE : BASE + NUM_CHUNKS)
+                                                     == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nTesting automatic reclamation." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj mX(NUM_POOLS, CON, CHUNK, &ta);
+
+            mX.setReclaimThreshold(CHUNK);
+
+            const bsls::Types::Int64 BASE = ta.numBlocksInUse();
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks[0][i] = mX.allocate(SIZES[0]);
+            }
+            const bsls::Types::Int64 PEAK = ta.numBlocksInUse();
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                mX.deallocate(blocks[0][i]);
+            }
+            ASSERTV(PEAK, ta.numBlocksInUse(), PEAK > ta.numBlocksInUse());
+
+            mX.shrink();
+            ASSERTV(BASE == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(2);
+
+            ASSERT_PASS(mX.setReclaimThreshold(bdlma::Pool::k_NO_RECLAIM));
+            ASSERT_PASS(mX.setReclaimThreshold(0));
+            ASSERT_FAIL(mX.setReclaimThreshold(-2));
+        }
+      } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocateAligned' AND 'deallocateAligned'
+        //
+        // Concerns:
+        //: 1 'allocateAligned' returns a block of the requested size that is
+        //:   aligned to the requested alignment, for alignments both below and
+        //:   above the alignment of pooled blocks.
+        //:
+        //: 2 Over-aligned blocks returned by 'deallocateAligned' are reused,
+        //:   so that repeated over-aligned requests do not allocate memory
+        //:   from the underlying allocator.
+        //:
+        //: 3 Over-aligned requests too large to be pooled are supplied from
+        //:   the list of large blocks, and are returned there.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For a range of sizes and each alignment from 1 to 4096, allocate
+        //:   a number of blocks, verify their alignment, scribble over them,
+        //:   and return them.  Then verify that allocating the same blocks
+        //:   again does not allocate from the test allocator.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   void *allocateAligned(int size, int alignment);
+        //   void deallocateAligned(void *address, int size, int alignment);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                        << endl
+                        << "TESTING 'allocateAligned' AND 'deallocateAligned'"
+                        << endl
+                        << "================================================="
+                        << endl;
+
+        enum { NUM_BLOCKS = 10 };
+
+        void *blocks[NUM_BLOCKS];
+
+        static const int SIZES[] = { 1, 7, 8, 24, 63, 64, 100, 256, 1000 };
+        const int NUM_SIZES = static_cast<int>(sizeof SIZES / sizeof *SIZES);
+
+        if (verbose) cout << "\nAligned blocks of each size." << endl;
+        {
+            const int NUM_POOLS = 8;
+
+            Obj mX(NUM_POOLS, Z);
+
+            for (int ti = 0; ti < NUM_SIZES; ++ti) {
+                const int SIZE = SIZES[ti];
+
+                for (int alignment = 1; alignment <= 4096; alignment <<= 1) {
+                    for (int i = 0; i < NUM_BLOCKS; ++i) {
+                        blocks[i] = mX.allocateAligned(SIZE, alignment);
+
+                        ASSERTV(SIZE, alignment, i, blocks[i]);
+                        ASSERTV(SIZE, alignment, i, 0 ==
+                                bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                                 blocks[i],
+                                                                 alignment));
+                        scribble(static_cast<char *>(blocks[i]), SIZE);
+                    }
+                    for (int i = 0; i < NUM_BLOCKS; ++i) {
+                        mX.deallocateAligned(blocks[i], SIZE, alignment);
+                    }
+
+                    // Pooled blocks are reused: a second round of requests
+                    // allocates no memory from the underlying allocator.
+
+                    const bsls::Types::Int64 NUM_ALLOCS =
+                                                testAllocator.numBlocksTotal();
+                    const bsls::Types::Int64 NUM_IN_USE =
+                                                testAllocator.numBlocksInUse();
+
+                    const bool POOLED =
+                                SIZE + alignment <= mX.maxPooledBlockSize();
+
+                    for (int i = 0; i < NUM_BLOCKS; ++i) {
+                        blocks[i] = mX.allocateAligned(SIZE, alignment);
+                    }
+                    if (POOLED) {
+                        ASSERTV(SIZE, alignment,
+                                NUM_ALLOCS == testAllocator.numBlocksTotal());
+                    }
+                    for (int i = 0; i < NUM_BLOCKS; ++i) {
+                        mX.deallocateAligned(blocks[i], SIZE, alignment);
+                    }
+                    ASSERTV(SIZE, alignment,
+                            NUM_IN_USE == testAllocator.numBlocksInUse());
+                }
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(2);
+
+            void *p = mX.allocateAligned(8, 64);
+
+            ASSERT_FAIL(mX.allocateAligned( 0, 64));
+            ASSERT_FAIL(mX.allocateAligned( 8,  0));
+            ASSERT_FAIL(mX.allocateAligned( 8, 48));
+            ASSERT_FAIL(mX.allocateAligned(INT_MAX, 64));
+
+            ASSERT_FAIL(mX.deallocateAligned(0, 8, 64));
+            ASSERT_FAIL(mX.deallocateAligned(p, 0, 64));
+            ASSERT_FAIL(mX.deallocateAligned(p, 8,  0));
+            ASSERT_PASS(mX.deallocateAligned(p, 8, 64));
+        }
+      } break;
+      case 11: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocateBatch' AND 'deallocateBatch'
+        //
+        // Concerns:
+        //: 1 'allocateBatch' supplies blocks from the pool that serves
+        //:   'allocateSized' requests of the same size, replenishing it at
+        //:   most once.
+        //:
+        //: 2 Blocks obtained from 'allocateBatch' may be returned using
+        //:   either 'deallocateBatch' or 'deallocateSized', and vice versa.
+        //:
+        //: 3 Batches too large to be pooled are supplied from the list of
+        //:   large blocks, and are returned there.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For a range of sizes, allocate a batch, verify the number of
+        //:   allocations from the test allocator, scribble over and return
+        //:   the blocks, and verify that 'allocateSized' reuses a returned
+        //:   block.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   void allocateBatch(void **addresses, int numBlocks, int size);
+        //   void deallocateBatch(void *const *addr, int numBlocks, int size);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'allocateBatch' AND 'deallocateBatch'"
+                          << endl
+                          << "============================================="
+                          << endl;
+
+        const int HEADER_SIZE = static_cast<int>(sizeof(Header));
+
+        enum { NUM_BLOCKS = 50 };
+
+        void *blocks[NUM_BLOCKS];
+
+        if (verbose) cout << "\nBatches of each size." << endl;
+        {
+            const int NUM_POOLS = 4;
+
+            Obj mX(NUM_POOLS, Z);
+
+            const int MAX_SIZE = mX.maxPooledBlockSize() + HEADER_SIZE;
+
+            for (int size = 1; size <= MAX_SIZE + 16; ++size) {
+                const bsls::Types::Int64 NUM_ALLOCS =
+                                                testAllocator.numBlocksTotal();
+                const bsls::Types::Int64 NUM_IN_USE =
+                                               testAllocator.numBlocksInUse();
+
+                mX.allocateBatch(blocks, NUM_BLOCKS, size);
+
+                if (size <= MAX_SIZE) {
+                    ASSERTV(size, testAllocator.numBlocksTotal() <=
+                                                              NUM_ALLOCS + 1);
+                }
+                else {
+                    ASSERTV(size, NUM_IN_USE + NUM_BLOCKS ==
+                                               testAllocator.numBlocksInUse());
+                }
+
+                // Consecutive pooled blocks are (only) as aligned as the
+                // pool's internal block size, a multiple of 'sizeof(void *)'.
+
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    ASSERTV(size, i, blocks[i]);
+                    ASSERTV(size, i,
+                            0 == bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                             blocks[i],
+                                                             sizeof(void *)));
+                    scribble(static_cast<char *>(blocks[i]), size);
+                }
+
+                // Return the first block individually, and the rest as a
+                // batch.
+
+                mX.deallocateSized(blocks[0], size);
+                mX.deallocateBatch(blocks + 1, NUM_BLOCKS - 1, size);
+
+                if (size > MAX_SIZE) {
+                    ASSERTV(size, NUM_IN_USE ==
+                                               testAllocator.numBlocksInUse());
+                    continue;
+                }
+
+                void *p = mX.allocateSized(size);
+                ASSERTV(size, blocks + NUM_BLOCKS !=
+                                bsl::find(blocks, blocks + NUM_BLOCKS, p));
+                mX.deallocateBatch(&p, 1, size);
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(2);
+
+            ASSERT_PASS(mX.allocateBatch(blocks, 0, 8));
+            ASSERT_PASS(mX.allocateBatch(0, 0, 8));
+            ASSERT_FAIL(mX.allocateBatch(0, 1, 8));
+            ASSERT_FAIL(mX.allocateBatch(blocks, -1, 8));
+            ASSERT_FAIL(mX.allocateBatch(blocks, 1, 0));
+
+            ASSERT_PASS(mX.deallocateBatch(blocks, 0, 8));
+            ASSERT_FAIL(mX.deallocateBatch(0, 1, 8));
+            ASSERT_FAIL(mX.deallocateBatch(blocks, -1, 8));
+            ASSERT_FAIL(mX.deallocateBatch(blocks, 1, 0));
+        }
+      } break;
+      case 10: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocateSized' AND 'deallocateSized'
+        //
+        // Concerns:
+        //: 1 A sized request is satisfied by the pool whose blocks (which have
+        //:   room for a 'Header') are the smallest that can hold the request,
+        //:   and no 'Header' is written: the address returned is the address
+        //:   of the block in the pool.
+        //:
+        //: 2 Sized requests too large for any pool are satisfied from the
+        //:   list of large blocks, and 'deallocateSized' returns them there.
+        //:
+        //: 3 'deallocateSized' returns the block to the pool from which it
+        //:   was allocated, making it available for reuse by both sized and
+        //:   unsized requests.
+        //:
+        //: 4 No portion of a sized block is used for bookkeeping.
+        //:
+        //: 5 Every block returned for a sized request is aligned for any
+        //:   object of the requested size, including blocks that are not the
+        //:   first of their chunk.
+        //:
+        //: 6 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate a block using 'allocate', then allocate
+        //:   a block using 'allocateSized' whose size is that of the first
+        //:   request plus the size of the 'Header', and verify that the
+        //:   address returned is that of the header of the first block.
+        //:   (C-1, 3)
+        //:
+        //: 2 For a multipool having several pools, make sized requests of
+        //:   every size up to (and beyond) the largest pooled size, scribble
+        //:   over each block, return it using 'deallocateSized', and verify
+        //:   that a subsequent request of the same size returns the same
+        //:   address, and that no memory is obtained from the underlying
+        //:   allocator for blocks returned to a pool.  (C-1..4)
+        //:
+        //: 3 For every size up to (and beyond) the largest pooled size, make
+        //:   several sized requests without returning the blocks, and verify
+        //:   that each block is aligned as
+        //:   'bsls::AlignmentUtil::calculateAlignmentFromSize' requires for
+        //:   that size.  (C-5)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-6)
+        //
+        // Testing:
+        //   void *allocateSized(int size);
+        //   void deallocateSized(void *address, int size);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'allocateSized' AND 'deallocateSized'"
+                          << endl
+                          << "============================================="
+                          << endl;
+
+        const int HEADER_SIZE = static_cast<int>(sizeof(Header));
+
+        if (verbose) cout << "\nSized and unsized requests share pools."
+                          << endl;
+        {
+            Obj mX(1, Z);
+
+            char *p = static_cast<char *>(mX.allocate(8));
+            mX.deallocate(p);
+
+            const bsls::Types::Int64 NUM_BLOCKS =
+                                               testAllocator.numBlocksTotal();
+
+            char *q = static_cast<char *>(mX.allocateSized(8 + HEADER_SIZE));
+            ASSERTV(p - HEADER_SIZE == q);
+            ASSERTV(NUM_BLOCKS == testAllocator.numBlocksTotal());
+
+            scribble(q, 8 + HEADER_SIZE);
+            mX.deallocateSized(q, 8 + HEADER_SIZE);
+
+            char *r = static_cast<char *>(mX.allocate(8));
+            ASSERTV(p == r);
+            mX.deallocate(r);
+        }
+
+        if (verbose) cout << "\nReuse of sized blocks." << endl;
+        {
+            const int NUM_POOLS = 4;
+
+            Obj mX(NUM_POOLS, Z);
+
+            const int MAX_SIZE = mX.maxPooledBlockSize() + HEADER_SIZE;
+
+            for (int size = 1; size <= MAX_SIZE + 16; ++size) {
+                char *p = static_cast<char *>(mX.allocateSized(size));
+                ASSERTV(size, p);
+                scribble(p, size);
+                mX.deallocateSized(p, size);
+
+                const bsls::Types::Int64 NUM_BLOCKS =
+                                               testAllocator.numBlocksInUse();
+
+                char *q = static_cast<char *>(mX.allocateSized(size));
+                if (size <= MAX_SIZE) {
+                    ASSERTV(size, p == q);
+                    ASSERTV(size, NUM_BLOCKS ==
+                                               testAllocator.numBlocksInUse());
+                }
+                else {
+                    ASSERTV(size, NUM_BLOCKS + 1 ==
+                                               testAllocator.numBlocksInUse());
+                }
+                mX.deallocateSized(q, size);
+                ASSERTV(size, NUM_BLOCKS == testAllocator.numBlocksInUse());
+            }
+        }
+
+        if (verbose) cout << "\nAlignment of sized blocks." << endl;
+        {
+            const int NUM_POOLS  = 4;
+            const int NUM_BLOCKS = 10;
+
+            Obj mX(NUM_POOLS, Z);
+
+            const int MAX_SIZE = mX.maxPooledBlockSize() + HEADER_SIZE;
+
+            for (int size = 1; size <= MAX_SIZE + 16; ++size) {
+                const int ALIGNMENT =
+                        bsls::AlignmentUtil::calculateAlignmentFromSize(size);
+
+                void *blocks[NUM_BLOCKS];
+
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    blocks[i] = mX.allocateSized(size);
+                    ASSERTV(size, i, ALIGNMENT,
+                            0 == bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                                  blocks[i],
+                                                                  ALIGNMENT));
+                    scribble(static_cast<char *>(blocks[i]), size);
+                }
+
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    mX.deallocateSized(blocks[i], size);
+                }
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(2);
+
+            ASSERT_FAIL(mX.allocateSized(0));
+            ASSERT_PASS(mX.deallocateSized(mX.allocateSized(8), 8));
+
+            ASSERT_FAIL(mX.deallocateSized(0, 8));
+        }
+      } break;
       case 9: {
         // --------------------------------------------------------------------
         // TESTING 'numPools' and 'maxPooledBlockSize'
@@ -1937,7 +2472,8 @@ int main(int argc, char *argv[])
         // Concerns:
         //   Our primary concern is that 'reserveCapacity(sz, n)' reserves
         //   sufficient memory to satisfy 'n' allocation requests from the
-        //   pool managing objects of size 'sz'.
+        //   pool managing objects of size 'sz', for both unsized ('allocate')
+        //   and sized ('allocateSized') requests.
         //
         //   QoI: Asserted precondition violations are detected when enabled.
         //
@@ -1949,7 +2485,11 @@ int main(int argc, char *argv[])
         //   bring the size of the pool under test to the specified number of
         //   elements and use 'bslma::TestAllocator' to verify that no
         //   additional allocations have occurred.  Perform each test in the
-        //   standard 'bslma' exception-testing macro block.
+        //   standard 'bslma' exception-testing macro block.  Then, for a table
+        //   of sizes (including sizes whose sized and unsized requests are
+        //   served by different pools), reserve capacity, make as many sized
+        //   and unsized requests, and verify that no additional allocations
+        //   have occurred.
         //
         // Testing:
         //   void reserveCapacity(int size, int numBlocks);
@@ -2003,6 +2543,58 @@ int main(int argc, char *argv[])
             }
         }
 
+        if (verbose) cout << "\nSized and unsized requests." << endl;
+        {
+            static const int SIZES[] = {
+                1, 2, 7, 8, 12, 16, 24, 32, 40, 48, 56, 64
+            };
+            const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+            static const int NUM_ELEMENTS[] = { 1, 5, 17 };
+            const int NUM_NUM_ELEMENTS =
+                                sizeof NUM_ELEMENTS / sizeof *NUM_ELEMENTS;
+
+            const int NUM_POOLS = 4;  // largest pooled block size is 64
+
+            for (int ti = 0; ti < NUM_SIZES; ++ti) {
+                const int SIZE = SIZES[ti];
+
+                for (int ni = 0; ni < NUM_NUM_ELEMENTS; ++ni) {
+                    const int NE = NUM_ELEMENTS[ni];
+
+                    if (veryVerbose) { T_ P_(SIZE) P(NE) }
+
+                    bslma::TestAllocator ta(veryVeryVerbose);
+
+                    Obj mX(NUM_POOLS, &ta);
+                    ASSERTV(SIZE, SIZE <= mX.maxPooledBlockSize());
+
+                    mX.reserveCapacity(SIZE, NE);
+
+                    const bsls::Types::Int64 NUM_BLOCKS =
+                                                     ta.numBlocksTotal();
+
+                    void *blocks[17];  // largest of 'NUM_ELEMENTS'
+                    for (int i = 0; i < NE; ++i) {
+                        blocks[i] = mX.allocateSized(SIZE);
+                    }
+                    ASSERTV(SIZE, NE, NUM_BLOCKS == ta.numBlocksTotal());
+
+                    // Return the sized blocks, in case both kinds of request
+                    // are served by the same pool.
+
+                    for (int i = 0; i < NE; ++i) {
+                        mX.deallocateSized(blocks[i], SIZE);
+                    }
+
+                    for (int i = 0; i < NE; ++i) {
+                        mX.allocate(SIZE);
+                    }
+                    ASSERTV(SIZE, NE, NUM_BLOCKS == ta.numBlocksTotal());
+                }
+            }
+        }
+
         if (verbose) cout << "\nNegative Testing." << endl;
         {
             bsls::AssertFailureHandlerGuard hG(
@@ -6,6 +6,7 @@ BSLS_IDENT_RCSID(bdlma_multipoolallocator_cpp,"$Id$ $CSID$")
 
 #include <bdlma_bufferedsequentialallocator.h>  // for testing only
 
+#include <bsls_assert.h>
 #include <bsls_performancehint.h>
 
 namespace BloombergLP {
@@ -39,6 +40,67 @@ void MultipoolAllocator::deallocate(void *address)
     BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
 }
 
+void *MultipoolAllocator::allocateSized(size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    return d_multipool.allocateSized(static_cast<int>(size));
+}
+
+void MultipoolAllocator::deallocateSized(void *address, size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(address != 0)) {
+        d_multipool.deallocateSized(address, static_cast<int>(size));
+    }
+    BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+}
+
+void MultipoolAllocator::allocateBatch(void      **addresses,
+                                       size_type   numBlocks,
+                                       size_type   size)
+{
+    BSLS_ASSERT(0 < size);
+
+    d_multipool.allocateBatch(addresses,
+                              static_cast<int>(numBlocks),
+                              static_cast<int>(size));
+}
+
+void MultipoolAllocator::deallocateBatch(void *const *addresses,
+                                         size_type    numBlocks,
+                                         size_type    size)
+{
+    d_multipool.deallocateBatch(addresses,
+                                static_cast<int>(numBlocks),
+                                static_cast<int>(size));
+}
+
+void *MultipoolAllocator::allocateAligned(size_type size, size_type alignment)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    return d_multipool.allocateAligned(static_cast<int>(size),
+                                       static_cast<int>(alignment));
+}
+
+void MultipoolAllocator::deallocateAligned(void      *address,
+                                           size_type  size,
+                                           size_type  alignment)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(address != 0)) {
+        d_multipool.deallocateAligned(address,
+                                      static_cast<int>(size),
+                                      static_cast<int>(alignment));
+    }
+    BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+}
+
 void MultipoolAllocator::reserveCapacity(size_type size, size_type numObjects)
 {
     if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
@@ -46,7 +46,23 @@ BSLS_IDENT("$Id: $")
 //       `----------------'
 //                          allocate
 //                          deallocate
-//..
+//                          allocateSized
+//                          deallocateSized
+//                          allocateBatch
+//                          deallocateBatch
+//                          allocateAligned
+//                          deallocateAligned
+//..
+// Memory obtained using 'allocateSized' and returned using 'deallocateSized'
+// (as is done by 'bsl::allocator', and hence by all standard containers) is
+// not prefixed with the per-block header that 'allocate' must store to locate
+// the supplying pool on 'deallocate' (see 'bdlma_multipool').  The batch
+// methods, 'allocateBatch' and 'deallocateBatch', locate the supplying pool
+// once for an entire array of equally-sized blocks.  Over-aligned memory,
+// obtained using 'allocateAligned' and returned using 'deallocateAligned' (as
+// is done by 'bsl::allocator' for over-aligned element types), is likewise
+// supplied by the pools (see 'bdlma::Multipool::allocateAligned').
+//
 // The main difference between a 'bdlma::MultipoolAllocator' and a
 // 'bdlma::Multipool' is that, very often, a 'bdlma::MultipoolAllocator' is
 // managed through a 'bslma::Allocator' pointer.  Hence, every call to the
@@ -775,7 +791,65 @@ class MultipoolAllocator : public ManagedAllocator {
         // Return the memory block at the specified 'address' back to this
         // allocator for reuse.  If 'address' is 0, this method has no effect.
         // The behavior is undefined unless 'address' was allocated by this
-        // allocator, and has not already been deallocated.
+        // allocator using 'allocate', and has not already been deallocated.
+
+    virtual void *allocateSized(size_type size);
+        // Return the address of a contiguous block of memory of (at least) the
+        // specified 'size' (in bytes), aligned for any object of 'size' bytes
+        // (see 'bsls::AlignmentUtil::calculateAlignmentFromSize'), that must
+        // be returned to this allocator using 'deallocateSized' supplying the
+        // same 'size'.  If 'size' is 0, no memory is allocated and 0 is
+        // returned.  No per-block header is stored for blocks dispensed by
+        // this method (see 'bdlma::Multipool::allocateSized').
+
+    virtual void deallocateSized(void *address, size_type size);
+        // Return the memory block at the specified 'address', having the
+        // specified 'size' (in bytes), back to this allocator for reuse.  If
+        // 'address' is 0, this method has no effect.  The behavior is
+        // undefined unless 'address' was allocated by a call to
+        // 'allocateSized' on this allocator supplying the same 'size', and has
+        // not already been deallocated.
+
+    virtual void allocateBatch(void      **addresses,
+                               size_type   numBlocks,
+                               size_type   size);
+        // Load into the specified 'addresses' array the addresses of the
+        // specified 'numBlocks' blocks of memory, each of (at least) the
+        // specified positive 'size' (in bytes) and obtained as if by
+        // 'allocateSized', that must be returned to this allocator using
+        // 'deallocateBatch' or 'deallocateSized' supplying the same 'size'.
+        // If an exception is thrown, no blocks are allocated.  The behavior is
+        // undefined unless 'addresses' refers to an array of at least
+        // 'numBlocks' elements (see 'bdlma::Multipool::allocateBatch').
+
+    virtual void deallocateBatch(void *const *addresses,
+                                 size_type    numBlocks,
+                                 size_type    size);
+        // Return the specified 'numBlocks' memory blocks whose addresses are
+        // held in the specified 'addresses' array, each having the specified
+        // 'size' (in bytes), back to this allocator for reuse.  The behavior
+        // is undefined unless each block was allocated by a call to
+        // 'allocateSized' or 'allocateBatch' on this allocator supplying the
+        // same 'size', and has not already been deallocated.
+
+    virtual void *allocateAligned(size_type size, size_type alignment);
+        // Return the address of a contiguous block of memory of (at least) the
+        // specified 'size' (in bytes), that is a multiple of the specified
+        // 'alignment', and that must be returned to this allocator using
+        // 'deallocateAligned' supplying the same 'size' and 'alignment'.  If
+        // 'size' is 0, no memory is allocated and 0 is returned.  The behavior
+        // is undefined unless 'alignment' is a positive, integral power of 2
+        // (see 'bdlma::Multipool::allocateAligned').
+
+    virtual void deallocateAligned(void      *address,
+                                   size_type  size,
+                                   size_type  alignment);
+        // Return the memory block at the specified 'address', having the
+        // specified 'size' (in bytes) and 'alignment', back to this allocator
+        // for reuse.  If 'address' is 0, this method has no effect.  The
+        // behavior is undefined unless 'address' was allocated by a call to
+        // 'allocateAligned' on this allocator supplying the same 'size' and
+        // 'alignment', and has not already been deallocated.
 
     virtual void release();
         // Release all memory currently allocated through this multipool
@@ -26,6 +26,7 @@
 #include <bsl_map.h>
 #include <bsl_set.h>
 #include <bsl_string.h>
+#include <bsl_vector.h>
 
 using namespace BloombergLP;
 using namespace bsl;
@@ -57,12 +58,18 @@ using namespace bsl;
 // [ 6] void reserveCapacity(size_type size, size_type numObjects);
 // [ 2] void *allocate(size);
 // [ 4] void deallocate(address);
+// [ 8] void *allocateSized(size);
+// [ 8] void deallocateSized(address, size);
+// [ 9] void allocateBatch(addresses, numBlocks, size);
+// [ 9] void deallocateBatch(addresses, numBlocks, size);
+// [10] void *allocateAligned(size, alignment);
+// [10] void deallocateAligned(address, size, alignment);
 // [ 5] void release();
 // [ 7] int numPools() const;
 // [ 7] int maxPooledBlockSize() const;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 8] USAGE EXAMPLE
+// [11] USAGE EXAMPLE
 // [ *] CONCERN: Precondition violations are detected when enabled.
 
 //=============================================================================
@@ -136,6 +143,19 @@ struct Header {
     } d_header;
 };
 
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#define TEST_ALIGNAS_64 __declspec(align(64))
+#else
+#define TEST_ALIGNAS_64 __attribute__((aligned(64)))
+#endif
+
+struct TEST_ALIGNAS_64 CacheLineAligned {
+    // This 'struct' has an alignment of 64 bytes, exceeding the maximal
+    // fundamental alignment.
+
+    int d_value;
+};
+
 //=============================================================================
 //                      HELPER FUNCTIONS FOR TESTING
 //-----------------------------------------------------------------------------
@@ -180,6 +200,34 @@ int recPool(char *address)
     return h->d_header.d_pool;
 }
 
+class UnsizedAllocator : public bslma::Allocator {
+    // This class implements the 'bslma::Allocator' protocol by forwarding
+    // 'allocate' and 'deallocate' to an allocator supplied at construction.
+    // 'allocateSized' and 'deallocateSized' are *not* overridden, so that
+    // sized requests are satisfied by 'allocate' and 'deallocate'.
+
+    // DATA
+    bslma::Allocator *d_allocator_p;  // allocator (held, not owned)
+
+  public:
+    // CREATORS
+    explicit UnsizedAllocator(bslma::Allocator *allocator)
+    : d_allocator_p(allocator)
+    {
+    }
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size)
+    {
+        return d_allocator_p->allocate(size);
+    }
+
+    virtual void deallocate(void *address)
+    {
+        d_allocator_p->deallocate(address);
+    }
+};
+
 void stretchRemoveAll(Obj *object, int numElements, int objSize)
    // Using only primary manipulators, extend the capacity of the specified
    // 'object' to (at least) the specified 'numElements' each of the specified
@@ -715,7 +763,7 @@ int main(int argc, char *argv[])
     bslma::Allocator     *Z = &testAllocator;
 
     switch (test) { case 0:
-      case 8: {
+      case 11: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -759,6 +807,363 @@ int main(int argc, char *argv[])
 //..
 
       } break;
+      case 10: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocateAligned' AND 'deallocateAligned'
+        //
+        // Concerns:
+        //: 1 'allocateAligned', invoked through the 'bslma::Allocator'
+        //:   protocol, returns a block aligned to the requested alignment,
+        //:   which is reused once returned by 'deallocateAligned'.
+        //:
+        //: 2 'allocateAligned' returns 0 for a 0 size, and 'deallocateAligned'
+        //:   has no effect for a null address.
+        //:
+        //: 3 A 'bsl::vector' of an over-aligned type supplied with the
+        //:   allocator stores suitably aligned elements, and returns all of
+        //:   its memory to the allocator.
+        //
+        // Plan:
+        //: 1 Allocate a number of blocks for alignments up to 4096 through a
+        //:   'bslma::Allocator' reference, verify their alignment, return
+        //:   them, and verify that allocating them again does not allocate
+        //:   from the underlying allocator.  (C-1)
+        //:
+        //: 2 Invoke 'allocateAligned' with a 0 size and 'deallocateAligned'
+        //:   with a null address.  (C-2)
+        //:
+        //: 3 Grow a 'bsl::vector<CacheLineAligned>' and verify the alignment
+        //:   of its storage.  Destroy the vector and verify that the next
+        //:   request for its final capacity is satisfied without allocating
+        //:   from the underlying allocator.  (C-3)
+        //
+        // Testing:
+        //   void *allocateAligned(size, alignment);
+        //   void deallocateAligned(address, size, alignment);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                        << endl
+                        << "TESTING 'allocateAligned' AND 'deallocateAligned'"
+                        << endl
+                        << "================================================="
+                        << endl;
+
+        enum { NUM_BLOCKS = 10 };
+
+        void *blocks[NUM_BLOCKS];
+
+        if (verbose) cout << "\nAligned blocks through the protocol." << endl;
+        {
+            Obj               mX(8, Z);
+            bslma::Allocator& protocol = mX;
+
+            for (int alignment = 1; alignment <= 4096; alignment <<= 1) {
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    blocks[i] = protocol.allocateAligned(24, alignment);
+
+                    ASSERTV(alignment, i, blocks[i]);
+                    ASSERTV(alignment, i, 0 ==
+                            bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                                 blocks[i],
+                                                                 alignment));
+                    memset(blocks[i], 0xa5, 24);
+                }
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    protocol.deallocateAligned(blocks[i], 24, alignment);
+                }
+
+                const bsls::Types::Int64 NUM_ALLOCS =
+                                                testAllocator.numBlocksTotal();
+
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    blocks[i] = protocol.allocateAligned(24, alignment);
+                }
+                if (24 + alignment <= mX.maxPooledBlockSize()) {
+                    ASSERTV(alignment,
+                            NUM_ALLOCS == testAllocator.numBlocksTotal());
+                }
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    protocol.deallocateAligned(blocks[i], 24, alignment);
+                }
+            }
+
+            ASSERT(0 == protocol.allocateAligned(0, 64));
+            protocol.deallocateAligned(0, 8, 64);
+        }
+        ASSERTV(testAllocator.numBlocksInUse(),
+                0 == testAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\n'bsl::vector' of an over-aligned type."
+                          << endl;
+        {
+            Obj mX(12, Z);  // pools blocks of up to 16K
+
+            bsl::vector<CacheLineAligned>::size_type capacity;
+            {
+                bsl::vector<CacheLineAligned> mV(&mX);
+
+                for (int i = 0; i < 20; ++i) {
+                    CacheLineAligned element;
+                    element.d_value = i;
+                    mV.push_back(element);
+
+                    ASSERTV(i, 0 ==
+                            bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                                   mV.data(),
+                                                                   64));
+                }
+                for (int i = 0; i < 20; ++i) {
+                    ASSERTV(i, mV[i].d_value, i == mV[i].d_value);
+                }
+                capacity = mV.capacity();
+            }
+
+            const bsls::Types::Int64 NUM_ALLOCS =
+                                                testAllocator.numBlocksTotal();
+
+            bsl::vector<CacheLineAligned> mV(&mX);
+            mV.reserve(capacity);
+
+            ASSERT(NUM_ALLOCS == testAllocator.numBlocksTotal());
+        }
+        ASSERTV(testAllocator.numBlocksInUse(),
+                0 == testAllocator.numBlocksInUse());
+      } break;
+      case 9: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocateBatch' AND 'deallocateBatch'
+        //
+        // Concerns:
+        //: 1 'allocateBatch' loads the requested number of distinct, aligned
+        //:   blocks, obtained from the same pool that serves 'allocateSized'
+        //:   requests of the same size.
+        //:
+        //: 2 A pooled batch replenishes the pool at most once.
+        //:
+        //: 3 'deallocateBatch' returns the blocks to the pool for reuse.
+        //:
+        //: 4 Batches too large to be pooled are obtained from, and returned
+        //:   to, the underlying allocator.
+        //:
+        //: 5 'allocateBatch' is exception-neutral, and allocates no blocks if
+        //:   an exception is thrown.
+        //
+        // Plan:
+        //: 1 Through a base class reference, allocate batches of various
+        //:   sizes, verify that the blocks are distinct and aligned, and that
+        //:   the number of allocations from the test allocator increases by
+        //:   at most one.  Return the batch, and verify that a subsequent
+        //:   'allocateSized' request is served from the batch.  (C-1..3)
+        //:
+        //: 2 Repeat for a size greater than 'maxPooledBlockSize', and verify
+        //:   that the blocks are returned to the test allocator.  (C-4)
+        //:
+        //: 3 Allocate batches within the 'bslma::TestAllocator' exception
+        //:   test macros, and verify that no memory is leaked.  (C-5)
+        //
+        // Testing:
+        //   void allocateBatch(addresses, numBlocks, size);
+        //   void deallocateBatch(addresses, numBlocks, size);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'allocateBatch' AND 'deallocateBatch'"
+                          << endl
+                          << "============================================="
+                          << endl;
+
+        enum { MAX_BLOCKS = 300 };
+
+        void *blocks[MAX_BLOCKS];
+
+        const int NUM_BLOCKS[] = { 0, 1, 2, 31, 32, 33, 100, MAX_BLOCKS };
+        const int NUM_DATA     = sizeof NUM_BLOCKS / sizeof *NUM_BLOCKS;
+
+        const int SIZES[]   = { 1, 8, 24, 100 };
+        const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+        if (verbose) cout << "\nTesting pooled batches." << endl;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int N = NUM_BLOCKS[ti];
+
+            for (int si = 0; si < NUM_SIZES; ++si) {
+                const int SIZE = SIZES[si];
+
+                Obj mX(Z);  bslma::Allocator& base = mX;
+
+                const bsls::Types::Int64 NUM_ALLOCS =
+                                                testAllocator.numBlocksTotal();
+
+                base.allocateBatch(blocks, N, SIZE);
+
+                ASSERTV(N, SIZE,
+                        testAllocator.numBlocksTotal() <= NUM_ALLOCS + 1);
+
+                // Consecutive pooled blocks are (only) as aligned as the
+                // pool's internal block size, a multiple of 'sizeof(void *)'.
+
+                for (int i = 0; i < N; ++i) {
+                    ASSERTV(N, SIZE, i, blocks[i]);
+                    ASSERTV(N, SIZE, i,
+                            0 == bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                             blocks[i],
+                                                             sizeof(void *)));
+
+                    bsl::memset(blocks[i], 0xa5, SIZE);
+                }
+
+                bsl::sort(blocks, blocks + N);
+                ASSERTV(N, SIZE,
+                        blocks + N == bsl::adjacent_find(blocks, blocks + N));
+
+                base.deallocateBatch(blocks, N, SIZE);
+
+                if (0 < N) {
+                    void *p = base.allocateSized(SIZE);
+                    ASSERTV(N, SIZE,
+                            bsl::binary_search(blocks, blocks + N, p));
+                    base.deallocateSized(p, SIZE);
+                }
+            }
+        }
+
+        if (verbose) cout << "\nTesting unpooled batches." << endl;
+        {
+            Obj mX(1, Z);  bslma::Allocator& base = mX;
+
+            const int SIZE = mX.maxPooledBlockSize() * 4;
+
+            const bsls::Types::Int64 NUM_IN_USE =
+                                                testAllocator.numBlocksInUse();
+
+            base.allocateBatch(blocks, 10, SIZE);
+            ASSERTV(testAllocator.numBlocksInUse(),
+                    NUM_IN_USE + 10 == testAllocator.numBlocksInUse());
+
+            base.deallocateBatch(blocks, 10, SIZE);
+            ASSERTV(testAllocator.numBlocksInUse(),
+                    NUM_IN_USE == testAllocator.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nTesting exception neutrality." << endl;
+        {
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int N = NUM_BLOCKS[ti];
+
+                BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(testAllocator) {
+                    Obj mX(1, Z);
+
+                    mX.allocateBatch(blocks, N, 8);
+                    mX.allocateBatch(blocks, N, mX.maxPooledBlockSize() + 1);
+                    mX.deallocateBatch(blocks,
+                                       N,
+                                       mX.maxPooledBlockSize() + 1);
+                } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+                ASSERTV(N, 0 == testAllocator.numBlocksInUse());
+            }
+        }
+      } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocateSized' AND 'deallocateSized'
+        //
+        // Concerns:
+        //: 1 'allocateSized' returns 0 if 'size' is 0, and 'deallocateSized'
+        //:   has no effect if 'address' is 0.
+        //:
+        //: 2 Sized requests made through the 'bslma::Allocator' protocol are
+        //:   forwarded to the sized methods of the underlying multipool, and
+        //:   hence do not store a per-block header.
+        //:
+        //: 3 Containers using 'bsl::allocator' make sized requests, and so
+        //:   consume less memory than when the same multipool is accessed
+        //:   through 'allocate' and 'deallocate' only.
+        //
+        // Plan:
+        //: 1 Invoke the methods with 0 size or 0 address.  (C-1)
+        //:
+        //: 2 Allocate and deallocate a block using 'allocate' through a base
+        //:   class pointer, then allocate a block using 'allocateSized' whose
+        //:   size includes room for the header, and verify that the address
+        //:   returned is that of the header of the first block.  (C-2)
+        //:
+        //: 3 Populate two 'bsl::list' objects, one using a multipool
+        //:   allocator directly, and the other using the same kind of
+        //:   allocator accessed through an adaptor that does not override the
+        //:   sized methods, and verify that the former consumes fewer bytes
+        //:   from its underlying test allocator.  (C-3)
+        //
+        // Testing:
+        //   void *allocateSized(size);
+        //   void deallocateSized(address, size);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'allocateSized' AND 'deallocateSized'"
+                          << endl
+                          << "============================================="
+                          << endl;
+
+        const int HEADER_SIZE = static_cast<int>(sizeof(Header));
+
+        if (verbose) cout << "\nTesting 0 size and 0 address." << endl;
+        {
+            Obj mX(Z);
+
+            const bsls::Types::Int64 NUM_BLOCKS =
+                                               testAllocator.numBlocksTotal();
+
+            ASSERT(0 == mX.allocateSized(0));
+            mX.deallocateSized(0, 8);
+            ASSERT(NUM_BLOCKS == testAllocator.numBlocksTotal());
+        }
+
+        if (verbose) cout << "\nTesting the protocol." << endl;
+        {
+            Obj mX(1, Z);  bslma::Allocator& base = mX;
+
+            char *p = static_cast<char *>(base.allocate(8));
+            base.deallocate(p);
+
+            char *q = static_cast<char *>(base.allocateSized(8 + HEADER_SIZE));
+            ASSERTV(p - HEADER_SIZE == q);
+
+            base.deallocateSized(q, 8 + HEADER_SIZE);
+        }
+
+        if (verbose) cout << "\nTesting container memory use." << endl;
+        {
+            const int NUM_ELEMENTS = 1000;
+
+            bslma::TestAllocator sizedTa(veryVeryVerbose);
+            bslma::TestAllocator unsizedTa(veryVeryVerbose);
+
+            Obj              sizedMp(&sizedTa);
+            Obj              unsizedMp(&unsizedTa);
+            UnsizedAllocator unsized(&unsizedMp);
+
+            {
+                bsl::list<int> sizedList(&sizedMp);
+                bsl::list<int> unsizedList(&unsized);
+
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    sizedList.push_back(i);
+                    unsizedList.push_back(i);
+                }
+
+                if (veryVerbose) {
+                    P_(sizedTa.numBytesInUse()); P(unsizedTa.numBytesInUse());
+                }
+
+                ASSERTV(sizedTa.numBytesInUse(),
+                        unsizedTa.numBytesInUse(),
+                        sizedTa.numBytesInUse() < unsizedTa.numBytesInUse());
+            }
+        }
+      } break;
       case 7: {
         // --------------------------------------------------------------------
         // TESTING 'numPools' and 'maxPooledBlockSize'
@@ -0,0 +1,910 @@
+// bdlma_objectpool.h                                                 -*-C++-*-
+#ifndef INCLUDED_BDLMA_OBJECTPOOL
+#define INCLUDED_BDLMA_OBJECTPOOL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a pool of reusable objects with creation and reset hooks.
+//
+//@CLASSES:
+//  bdlma::ObjectPool: pool of reusable objects of a parameterized type
+//  bdlma::ObjectPoolFunctors: namespace for commonly used creators/resetters
+//
+//@SEE_ALSO: bdlma_pool
+//
+//@DESCRIPTION: This component provides a mechanism, 'bdlma::ObjectPool', that
+// manages a pool of reusable objects of a parameterized 'TYPE' using the
+// acquire-release idiom: 'getObject' returns an object from the pool
+// (creating a new one only if no object is available), and 'releaseObject'
+// resets an object and returns it to the pool for further reuse.  Reusing
+// objects avoids the cost of their construction and destruction and, for
+// objects that own memory (e.g., containers and strings), preserves the
+// capacity they have acquired, so that an object reused in a steady state
+// typically performs no allocation at all.
+//
+// Objects can also be obtained with 'getSharedObject', which returns a
+// 'bsl::shared_ptr' that releases the object to the pool when its last
+// (shared and weak) reference is dropped.  The shared pointer representation
+// is embedded in the pooled node along with the object, so that
+// 'getSharedObject' performs no allocation when an object is available.
+//
+///Creator and Resetter
+///--------------------
+// The way objects are created and reset is specified by two functors, the
+// 'CREATOR' and the 'RESETTER', supplied as template parameters (and,
+// optionally, as constructor arguments, to carry state).  The 'CREATOR' must
+// be invocable as:
+//..
+//  void operator()(void *arena, bslma::Allocator *allocator);
+//..
+// and construct an object of 'TYPE' in the uninitialized memory at 'arena',
+// passing 'allocator' (the allocator of the pool) to the object if it uses
+// one.  The 'RESETTER' must be invocable as:
+//..
+//  void operator()(TYPE *object);
+//..
+// and restore 'object' to a state suitable for reuse; it is invoked each time
+// an object is returned to the pool, and must not throw.
+//
+// 'bdlma::ObjectPoolFunctors' provides the default creator, 'DefaultCreator',
+// which default-constructs objects (passing the allocator of the pool if
+// 'TYPE' uses 'bslma::Allocator'), and the resetters 'Reset' (the default,
+// invoking the 'reset' method of the object), 'Clear' (invoking 'clear', as
+// for standard containers), and 'Nil' (doing nothing).
+//
+///Growth Strategy
+///---------------
+// The memory of the pooled objects is supplied by a 'bdlma::Pool', in chunks
+// whose size is controlled by a 'bsls::BlockGrowth::Strategy' and a maximum
+// number of objects per chunk, both optionally specified at construction.
+// With geometric growth (the default), the chunk size doubles from one object
+// up to the maximum; with constant growth, every chunk holds the maximum
+// number of objects.  Either way, the memory obtained by a single
+// replenishment is bounded by the maximum number of objects per chunk.  Note
+// that objects themselves are created one at a time, on demand (or by
+// 'reserveCapacity'): a chunk reserves memory for objects, but does not
+// construct them.
+//
+///Thread Safety
+///-------------
+// By default, a 'bdlma::ObjectPool' is *not* thread-safe: distinct objects may
+// be used concurrently, but access to the same object must be synchronized by
+// the caller.  If 'e_THREAD_SAFE' is supplied at construction, all of the
+// manipulators and accessors of the pool may be invoked concurrently, and
+// objects (and shared pointers to them) may be released from any thread.
+// Objects are created and reset outside of the lock of the pool.  In either
+// case, the creator and the resetter must be safe to invoke concurrently on
+// distinct objects.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Reusing Expensive Message Objects
+///- - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a server decodes each request it receives into a message
+// object holding several strings and containers.  Constructing such an object
+// for every request, and destroying it afterwards, is expensive: each of its
+// members allocates as the message is populated.  We can instead reuse
+// messages from an object pool, keeping the capacity of their members.
+//
+// First, we define the message class, providing a 'reset' method restoring it
+// to its default-constructed value (but not releasing its memory):
+//..
+//  class Message {
+//      // This class represents a decoded request.
+//
+//      // DATA
+//      bsl::string                           d_topic;
+//      bsl::map<bsl::string, bsl::string>    d_headers;
+//      bsl::vector<char>                     d_payload;
+//
+//    public:
+//      // TRAITS
+//      BSLMF_NESTED_TRAIT_DECLARATION(Message, bslma::UsesBslmaAllocator);
+//
+//      // CREATORS
+//      explicit Message(bslma::Allocator *basicAllocator = 0)
+//      : d_topic(basicAllocator)
+//      , d_headers(basicAllocator)
+//      , d_payload(basicAllocator)
+//      {
+//      }
+//
+//      // MANIPULATORS
+//      void reset()
+//      {
+//          d_topic.clear();
+//          d_headers.clear();
+//          d_payload.clear();
+//      }
+//
+//      void decode(const char *topic, int payloadSize)
+//      {
+//          d_topic = topic;
+//          d_headers["content-length"] = "0";
+//          d_payload.resize(payloadSize);
+//      }
+//
+//      // ACCESSORS
+//      const bsl::string& topic() const { return d_topic; }
+//  };
+//..
+// Then, we create a thread-safe pool of messages:
+//..
+//  bdlma::ObjectPool<Message> pool(bdlma::ObjectPool<Message>::e_THREAD_SAFE);
+//..
+// Next, we process a request with a message obtained from the pool, releasing
+// the message when we are done:
+//..
+//  Message *message = pool.getObject();
+//  message->decode("orders", 512);
+//
+//  // ... process the request ...
+//
+//  pool.releaseObject(message);
+//
+//  assert(1 == pool.numObjects());
+//  assert(1 == pool.numAvailableObjects());
+//..
+// Now, we process the next request, which reuses the same message (already
+// reset by the pool):
+//..
+//  Message *next = pool.getObject();
+//  assert(message == next);
+//  assert(next->topic().empty());
+//
+//  pool.releaseObject(next);
+//..
+// Finally, when the lifetime of a message is not confined to a single scope
+// (e.g., when it is handed off to another thread), we obtain it as a shared
+// pointer, which returns it to the pool when the last reference is dropped:
+//..
+//  {
+//      bsl::shared_ptr<Message> shared = pool.getSharedObject();
+//      shared->decode("quotes", 128);
+//
+//      bsl::shared_ptr<Message> copy = shared;
+//      assert(0 == pool.numAvailableObjects());
+//  }
+//  assert(1 == pool.numAvailableObjects());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_POOL
+#include <bdlma_pool.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SCALARDESTRUCTIONPRIMITIVES
+#include <bslalg_scalardestructionprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SCALARPRIMITIVES
+#include <bslalg_scalarprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_SHAREDPTRREP
+#include <bslma_sharedptrrep.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BLOCKGROWTH
+#include <bsls_blockgrowth.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLLOCK
+#include <bsls_bsllock.h>
+#endif
+
+#ifndef INCLUDED_BSLS_EXCEPTIONUTIL
+#include <bsls_exceptionutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_OBJECTBUFFER
+#include <bsls_objectbuffer.h>
+#endif
+
+#ifndef INCLUDED_BSL_MEMORY
+#include <bsl_memory.h>
+#endif
+
+#ifndef INCLUDED_TYPEINFO
+#include <typeinfo>
+#define INCLUDED_TYPEINFO
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                         // =========================
+                         // struct ObjectPoolFunctors
+                         // =========================
+
+struct ObjectPoolFunctors {
+    // This 'struct' provides a namespace for the creator and resetter functors
+    // commonly supplied to 'ObjectPool'.
+
+    template <class TYPE>
+    class DefaultCreator {
+        // This class provides a creator constructing default-initialized
+        // objects of the parameterized 'TYPE'.
+
+      public:
+        void operator()(void *arena, bslma::Allocator *allocator) const;
+            // Construct a default-initialized object of 'TYPE' in the
+            // uninitialized memory at the specified 'arena', passing the
+            // specified 'allocator' to its constructor if 'TYPE' uses
+            // 'bslma::Allocator'.
+    };
+
+    template <class TYPE>
+    class Nil {
+        // This class provides a resetter doing nothing.
+
+      public:
+        void operator()(TYPE *object) const;
+            // Do nothing with the specified 'object'.
+    };
+
+    template <class TYPE>
+    class Reset {
+        // This class provides a resetter invoking the 'reset' method of the
+        // objects of the parameterized 'TYPE'.
+
+      public:
+        void operator()(TYPE *object) const;
+            // Invoke 'reset' on the specified 'object'.
+    };
+
+    template <class TYPE>
+    class Clear {
+        // This class provides a resetter invoking the 'clear' method of the
+        // objects of the parameterized 'TYPE'.
+
+      public:
+        void operator()(TYPE *object) const;
+            // Invoke 'clear' on the specified 'object'.
+    };
+};
+
+                        // ==========================
+                        // class ObjectPool_LockGuard
+                        // ==========================
+
+class ObjectPool_LockGuard {
+    // This component-private class implements a guard locking an optional
+    // lock for the duration of its lifetime.
+
+    // DATA
+    bsls::BslLock *d_lock_p;  // guarded lock, or 0 (held, not owned)
+
+    // NOT IMPLEMENTED
+    ObjectPool_LockGuard(const ObjectPool_LockGuard&);
+    ObjectPool_LockGuard& operator=(const ObjectPool_LockGuard&);
+
+  public:
+    // CREATORS
+    explicit
+    ObjectPool_LockGuard(bsls::BslLock *lock);
+        // Create a guard locking the specified 'lock', unless 'lock' is 0.
+
+    ~ObjectPool_LockGuard();
+        // Unlock the lock guarded by this object (if any), and destroy it.
+};
+
+                         // ====================
+                         // class ObjectPool_Rep
+                         // ====================
+
+template <class TYPE, class POOL>
+class ObjectPool_Rep : public bslma::SharedPtrRep {
+    // This component-private class implements the shared pointer
+    // representation of an object of the parameterized 'TYPE' managed by an
+    // object pool of the parameterized 'POOL' type: the object is reset when
+    // its last shared reference is released, and returned to the pool when
+    // its last (shared or weak) reference is released.
+
+    // DATA
+    POOL *d_pool_p;    // pool of the object (held, not owned)
+    TYPE *d_object_p;  // shared object (held, not owned)
+
+    // NOT IMPLEMENTED
+    ObjectPool_Rep(const ObjectPool_Rep&);
+    ObjectPool_Rep& operator=(const ObjectPool_Rep&);
+
+  public:
+    // CREATORS
+    ObjectPool_Rep(POOL *pool, TYPE *object);
+        // Create a representation of the specified 'object' managed by the
+        // specified 'pool'.
+
+    // MANIPULATORS
+    virtual void disposeObject();
+        // Reset the shared object.
+
+    virtual void disposeRep();
+        // Return the shared object to its pool.
+
+    virtual void *getDeleter(const std::type_info& type);
+        // Return 0.  Note that the specified 'type' is ignored, as this
+        // representation has no deleter.
+
+    // ACCESSORS
+    virtual void *originalPtr() const;
+        // Return the address of the shared object.
+};
+
+                            // ================
+                            // class ObjectPool
+                            // ================
+
+template <class TYPE,
+          class CREATOR  = ObjectPoolFunctors::DefaultCreator<TYPE>,
+          class RESETTER = ObjectPoolFunctors::Reset<TYPE> >
+class ObjectPool {
+    // This class provides a pool of reusable objects of the parameterized
+    // 'TYPE', created by the parameterized 'CREATOR' and reset, when returned
+    // to the pool, by the parameterized 'RESETTER' (see the component-level
+    // documentation).  All of the objects created by a pool are destroyed when
+    // the pool is destroyed.
+
+  public:
+    // TYPES
+    typedef TYPE ObjectType;
+
+    enum ConcurrencyPolicy {
+        // Enumerate the synchronization of the operations of a pool.
+
+        e_SINGLE_THREADED,  // the pool is not thread-safe
+        e_THREAD_SAFE       // the pool is fully thread-safe
+    };
+
+  private:
+    // PRIVATE TYPES
+    typedef ObjectPool_Rep<TYPE, ObjectPool> Rep;
+
+    struct Node {
+        // This 'struct' holds a pooled object, followed by the links and
+        // shared pointer representation of the object.  Note that the object
+        // is the first member, so that the address of the object is the
+        // address of its node.
+
+        bsls::ObjectBuffer<TYPE>  d_object;      // pooled object
+
+        Node                     *d_nextFree_p;  // next available node
+
+        Node                     *d_nextAll_p;   // next created node
+
+        bsls::ObjectBuffer<Rep>   d_rep;         // representation of the
+                                                 // object when shared
+    };
+
+    // DATA
+    Pool                   d_pool;                 // supplies node memory
+
+    Node                  *d_freeList_p;           // available objects
+
+    Node                  *d_allObjects_p;         // all created objects
+
+    int                    d_numObjects;           // number of created
+                                                   // objects
+
+    int                    d_numAvailableObjects;  // number of objects on
+                                                   // 'd_freeList_p'
+
+    CREATOR                d_creator;              // creates objects
+
+    RESETTER               d_resetter;             // resets released objects
+
+    bool                   d_isThreadSafe;         // 'true' if operations
+                                                   // are synchronized
+
+    mutable bsls::BslLock  d_lock;                 // synchronizes operations
+                                                   // if 'd_isThreadSafe'
+
+    bslma::Allocator      *d_allocator_p;          // memory allocator (held,
+                                                   // not owned)
+
+    // FRIENDS
+    friend class ObjectPool_Rep<TYPE, ObjectPool>;
+
+    // NOT IMPLEMENTED
+    ObjectPool(const ObjectPool&);
+    ObjectPool& operator=(const ObjectPool&);
+
+  private:
+    // PRIVATE MANIPULATORS
+    Node *acquireNode();
+        // Return a node holding an object available for use, removed from the
+        // free list, or created (and added to the list of all objects) if no
+        // object is available.
+
+    Node *createNode();
+        // Return a node holding a newly-created object, not yet added to any
+        // list.  If the creator throws, the node memory is returned to the
+        // pool and the exception is propagated.
+
+    void pushObject(TYPE *object);
+        // Add the specified 'object', already reset, to the free list.
+
+    void resetObject(TYPE *object);
+        // Reset the specified 'object' with the resetter of this pool.
+
+    // PRIVATE ACCESSORS
+    bsls::BslLock *lock() const;
+        // Return the address of the lock synchronizing the operations of this
+        // pool, or 0 if this pool is not thread-safe.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(ObjectPool, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    ObjectPool(bslma::Allocator *basicAllocator = 0);
+    explicit
+    ObjectPool(ConcurrencyPolicy  concurrencyPolicy,
+               bslma::Allocator  *basicAllocator = 0);
+    ObjectPool(const CREATOR&     creator,
+               const RESETTER&    resetter,
+               bslma::Allocator  *basicAllocator = 0);
+    ObjectPool(const CREATOR&               creator,
+               const RESETTER&              resetter,
+               bsls::BlockGrowth::Strategy  growthStrategy,
+               int                          maxObjectsPerChunk,
+               ConcurrencyPolicy            concurrencyPolicy,
+               bslma::Allocator            *basicAllocator = 0);
+        // Create an empty object pool.  Optionally specify the 'creator' and
+        // 'resetter' functors used to create and reset objects.  If 'creator'
+        // and 'resetter' are not specified, default-constructed functors are
+        // used.  Optionally specify a 'growthStrategy' and a
+        // 'maxObjectsPerChunk' controlling the growth of the chunks of memory
+        // from which objects are created (see {Growth Strategy}).  If
+        // 'growthStrategy' is not specified, geometric growth is used, up to
+        // an implementation-defined number of objects per chunk.  Optionally
+        // specify a 'concurrencyPolicy'.  If 'concurrencyPolicy' is not
+        // specified, the pool is not thread-safe.  Optionally specify a
+        // 'basicAllocator' used to supply memory, and supplied to the
+        // creator.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  The behavior is undefined unless
+        // '1 <= maxObjectsPerChunk'.
+
+    ~ObjectPool();
+        // Destroy this object pool, and all of the objects it created.  The
+        // behavior is undefined unless all of the objects obtained from this
+        // pool (including through shared pointers) have been released.
+
+    // MANIPULATORS
+    TYPE *getObject();
+        // Return the address of a modifiable object from this pool, creating
+        // a new object if no object is available.  The object is
+        // freshly-created, or was reset when it was last released.
+
+    bsl::shared_ptr<TYPE> getSharedObject();
+        // Return a shared pointer to a modifiable object from this pool,
+        // creating a new object if no object is available, such that the
+        // object is reset when its last shared reference is released, and
+        // returned to this pool when its last (shared or weak) reference is
+        // released.  The behavior is undefined unless all references to the
+        // object are released before this pool is destroyed.
+
+    void releaseObject(TYPE *object);
+        // Reset the specified 'object' and return it to this pool for further
+        // reuse.  The behavior is undefined unless 'object' was obtained from
+        // this pool by 'getObject', and has not already been released.
+
+    void reserveCapacity(int numObjects);
+        // Create objects, if needed, so that at least the specified
+        // 'numObjects' objects are available from this pool.  The behavior
+        // is undefined unless '0 <= numObjects'.
+
+    // ACCESSORS
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this pool to supply memory.
+
+    bool isThreadSafe() const;
+        // Return 'true' if the operations of this pool are synchronized, and
+        // 'false' otherwise.
+
+    int numAvailableObjects() const;
+        // Return the number of objects available from this pool without
+        // creating new objects.
+
+    int numObjects() const;
+        // Return the number of objects created by this pool.
+};
+
+// ============================================================================
+//                          INLINE DEFINITIONS
+// ============================================================================
+
+                         // -------------------------
+                         // struct ObjectPoolFunctors
+                         // -------------------------
+
+// ACCESSORS
+template <class TYPE>
+inline
+void ObjectPoolFunctors::DefaultCreator<TYPE>::operator()(
+                                             void             *arena,
+                                             bslma::Allocator *allocator) const
+{
+    bslalg::ScalarPrimitives::defaultConstruct(static_cast<TYPE *>(arena),
+                                               allocator);
+}
+
+template <class TYPE>
+inline
+void ObjectPoolFunctors::Nil<TYPE>::operator()(TYPE *) const
+{
+}
+
+template <class TYPE>
+inline
+void ObjectPoolFunctors::Reset<TYPE>::operator()(TYPE *object) const
+{
+    object->reset();
+}
+
+template <class TYPE>
+inline
+void ObjectPoolFunctors::Clear<TYPE>::operator()(TYPE *object) const
+{
+    object->clear();
+}
+
+                        // --------------------------
+                        // class ObjectPool_LockGuard
+                        // --------------------------
+
+// CREATORS
+inline
+ObjectPool_LockGuard::ObjectPool_LockGuard(bsls::BslLock *lock)
+: d_lock_p(lock)
+{
+    if (d_lock_p) {
+        d_lock_p->lock();
+    }
+}
+
+inline
+ObjectPool_LockGuard::~ObjectPool_LockGuard()
+{
+    if (d_lock_p) {
+        d_lock_p->unlock();
+    }
+}
+
+                         // --------------------
+                         // class ObjectPool_Rep
+                         // --------------------
+
+// CREATORS
+template <class TYPE, class POOL>
+inline
+ObjectPool_Rep<TYPE, POOL>::ObjectPool_Rep(POOL *pool, TYPE *object)
+: d_pool_p(pool)
+, d_object_p(object)
+{
+}
+
+// MANIPULATORS
+template <class TYPE, class POOL>
+void ObjectPool_Rep<TYPE, POOL>::disposeObject()
+{
+    d_pool_p->resetObject(d_object_p);
+}
+
+template <class TYPE, class POOL>
+void ObjectPool_Rep<TYPE, POOL>::disposeRep()
+{
+    d_pool_p->pushObject(d_object_p);
+}
+
+template <class TYPE, class POOL>
+void *ObjectPool_Rep<TYPE, POOL>::getDeleter(const std::type_info&)
+{
+    return 0;
+}
+
+// ACCESSORS
+template <class TYPE, class POOL>
+void *ObjectPool_Rep<TYPE, POOL>::originalPtr() const
+{
+    return d_object_p;
+}
+
+                            // ----------------
+                            // class ObjectPool
+                            // ----------------
+
+// PRIVATE MANIPULATORS
+template <class TYPE, class CREATOR, class RESETTER>
+typename ObjectPool<TYPE, CREATOR, RESETTER>::Node *
+ObjectPool<TYPE, CREATOR, RESETTER>::acquireNode()
+{
+    {
+        ObjectPool_LockGuard guard(lock());
+
+        if (d_freeList_p) {
+            Node *node    = d_freeList_p;
+            d_freeList_p  = node->d_nextFree_p;
+            --d_numAvailableObjects;
+            return node;                                              // RETURN
+        }
+    }
+
+    Node *node = createNode();
+
+    ObjectPool_LockGuard guard(lock());
+
+    node->d_nextAll_p = d_allObjects_p;
+    d_allObjects_p    = node;
+    ++d_numObjects;
+
+    return node;
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+typename ObjectPool<TYPE, CREATOR, RESETTER>::Node *
+ObjectPool<TYPE, CREATOR, RESETTER>::createNode()
+{
+    Node *node;
+    {
+        ObjectPool_LockGuard guard(lock());
+
+        node = static_cast<Node *>(d_pool.allocate());
+    }
+
+    // Create the object outside of the lock, as creation may be expensive.
+
+    BSLS_TRY {
+        d_creator(static_cast<void *>(node->d_object.buffer()),
+                  d_allocator_p);
+    }
+    BSLS_CATCH(...) {
+        ObjectPool_LockGuard guard(lock());
+
+        d_pool.deallocate(node);
+        BSLS_RETHROW;
+    }
+
+    new (node->d_rep.buffer()) Rep(this, &node->d_object.object());
+
+    return node;
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+void ObjectPool<TYPE, CREATOR, RESETTER>::pushObject(TYPE *object)
+{
+    Node *node = reinterpret_cast<Node *>(object);
+
+    ObjectPool_LockGuard guard(lock());
+
+    node->d_nextFree_p = d_freeList_p;
+    d_freeList_p       = node;
+    ++d_numAvailableObjects;
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+void ObjectPool<TYPE, CREATOR, RESETTER>::resetObject(TYPE *object)
+{
+    d_resetter(object);
+}
+
+// PRIVATE ACCESSORS
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+bsls::BslLock *ObjectPool<TYPE, CREATOR, RESETTER>::lock() const
+{
+    return d_isThreadSafe ? &d_lock : 0;
+}
+
+// CREATORS
+template <class TYPE, class CREATOR, class RESETTER>
+ObjectPool<TYPE, CREATOR, RESETTER>::ObjectPool(
+                                              bslma::Allocator *basicAllocator)
+: d_pool(sizeof(Node), basicAllocator)
+, d_freeList_p(0)
+, d_allObjects_p(0)
+, d_numObjects(0)
+, d_numAvailableObjects(0)
+, d_creator()
+, d_resetter()
+, d_isThreadSafe(false)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+ObjectPool<TYPE, CREATOR, RESETTER>::ObjectPool(
+                                    ConcurrencyPolicy  concurrencyPolicy,
+                                    bslma::Allocator  *basicAllocator)
+: d_pool(sizeof(Node), basicAllocator)
+, d_freeList_p(0)
+, d_allObjects_p(0)
+, d_numObjects(0)
+, d_numAvailableObjects(0)
+, d_creator()
+, d_resetter()
+, d_isThreadSafe(e_THREAD_SAFE == concurrencyPolicy)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+ObjectPool<TYPE, CREATOR, RESETTER>::ObjectPool(
+                                             const CREATOR&     creator,
+                                             const RESETTER&    resetter,
+                                             bslma::Allocator  *basicAllocator)
+: d_pool(sizeof(Node), basicAllocator)
+, d_freeList_p(0)
+, d_allObjects_p(0)
+, d_numObjects(0)
+, d_numAvailableObjects(0)
+, d_creator(creator)
+, d_resetter(resetter)
+, d_isThreadSafe(false)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+ObjectPool<TYPE, CREATOR, RESETTER>::ObjectPool(
+                               const CREATOR&               creator,
+                               const RESETTER&              resetter,
+                               bsls::BlockGrowth::Strategy  growthStrategy,
+                               int                          maxObjectsPerChunk,
+                               ConcurrencyPolicy            concurrencyPolicy,
+                               bslma::Allocator            *basicAllocator)
+: d_pool(sizeof(Node), growthStrategy, maxObjectsPerChunk, basicAllocator)
+, d_freeList_p(0)
+, d_allObjects_p(0)
+, d_numObjects(0)
+, d_numAvailableObjects(0)
+, d_creator(creator)
+, d_resetter(resetter)
+, d_isThreadSafe(e_THREAD_SAFE == concurrencyPolicy)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+ObjectPool<TYPE, CREATOR, RESETTER>::~ObjectPool()
+{
+    BSLS_ASSERT(d_numObjects == d_numAvailableObjects);
+
+    for (Node *node = d_allObjects_p; node; node = node->d_nextAll_p) {
+        bslalg::ScalarDestructionPrimitives::destroy(
+                                                    &node->d_object.object());
+    }
+}
+
+// MANIPULATORS
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+TYPE *ObjectPool<TYPE, CREATOR, RESETTER>::getObject()
+{
+    return &acquireNode()->d_object.object();
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+bsl::shared_ptr<TYPE> ObjectPool<TYPE, CREATOR, RESETTER>::getSharedObject()
+{
+    Node *node = acquireNode();
+    Rep  *rep  = &node->d_rep.object();
+
+    rep->resetCountsRaw(1, 0);
+
+    return bsl::shared_ptr<TYPE>(&node->d_object.object(), rep);
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+void ObjectPool<TYPE, CREATOR, RESETTER>::releaseObject(TYPE *object)
+{
+    BSLS_ASSERT(object);
+
+    resetObject(object);
+    pushObject(object);
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+void ObjectPool<TYPE, CREATOR, RESETTER>::reserveCapacity(int numObjects)
+{
+    BSLS_ASSERT(0 <= numObjects);
+
+    while (numAvailableObjects() < numObjects) {
+        Node *node = createNode();
+
+        ObjectPool_LockGuard guard(lock());
+
+        node->d_nextAll_p  = d_allObjects_p;
+        d_allObjects_p     = node;
+        ++d_numObjects;
+
+        node->d_nextFree_p = d_freeList_p;
+        d_freeList_p       = node;
+        ++d_numAvailableObjects;
+    }
+}
+
+// ACCESSORS
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+bslma::Allocator *ObjectPool<TYPE, CREATOR, RESETTER>::allocator() const
+{
+    return d_allocator_p;
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+bool ObjectPool<TYPE, CREATOR, RESETTER>::isThreadSafe() const
+{
+    return d_isThreadSafe;
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+int ObjectPool<TYPE, CREATOR, RESETTER>::numAvailableObjects() const
+{
+    ObjectPool_LockGuard guard(lock());
+
+    return d_numAvailableObjects;
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+int ObjectPool<TYPE, CREATOR, RESETTER>::numObjects() const
+{
+    ObjectPool_LockGuard guard(lock());
+
+    return d_numObjects;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
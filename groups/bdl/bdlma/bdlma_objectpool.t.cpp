@@ -0,0 +1,1111 @@
+// bdlma_objectpool.t.cpp                                             -*-C++-*-
+#include <bdlma_objectpool.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_blockgrowth.h>
+#include <bsls_exceptionutil.h>
+#include <bsls_platform.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_map.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                TEST PLAN
+// ----------------------------------------------------------------------------
+//                                 Overview
+//                                 --------
+// 'bdlma::ObjectPool' is a mechanism managing a pool of reusable objects
+// created by a creator functor and reset by a resetter functor.  We verify
+// that objects are created only when none is available, that released objects
+// are reset and reused, that all objects are destroyed with the pool, that a
+// throwing creator leaves the pool unchanged, and that shared objects are
+// reset and returned to the pool when their last shared and weak references
+// are released.  Finally, we verify that a thread-safe pool can be used
+// concurrently.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] ObjectPool(bslma::Allocator *ba = 0);
+// [ 2] ObjectPool(ConcurrencyPolicy cp, bslma::Allocator *ba = 0);
+// [ 2] ObjectPool(const C& c, const R& r, bslma::Allocator *ba = 0);
+// [ 2] ObjectPool(const C&, const R&, Strategy, int, Policy, *ba);
+// [ 3] ~ObjectPool();
+//
+// MANIPULATORS
+// [ 3] TYPE *getObject();
+// [ 4] bsl::shared_ptr<TYPE> getSharedObject();
+// [ 3] void releaseObject(TYPE *object);
+// [ 3] void reserveCapacity(int numObjects);
+//
+// ACCESSORS
+// [ 2] bslma::Allocator *allocator() const;
+// [ 2] bool isThreadSafe() const;
+// [ 3] int numAvailableObjects() const;
+// [ 3] int numObjects() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] USAGE EXAMPLE
+// [ 3] CONCERN: A throwing creator leaves the pool unchanged.
+// [ 5] CONCERN: A thread-safe pool can be used concurrently.
+// [ *] CONCERN: In no case does memory come from the global allocator.
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+#define ASSERT_PASS_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_PASS_RAW(EXPR)
+#define ASSERT_FAIL_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_FAIL_RAW(EXPR)
+
+// ============================================================================
+//                  GLOBAL VARIABLES / TYPEDEFS FOR TESTING
+// ----------------------------------------------------------------------------
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+static bsls::AtomicInt g_numCreated;    // number of 'Item' objects
+                                        // constructed
+
+static bsls::AtomicInt g_numDestroyed;  // number of 'Item' objects destroyed
+
+// ============================================================================
+//                   HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+class Item {
+    // This class provides an allocator-aware object type counting its
+    // constructions and destructions, and holding a value and a string.
+
+    // DATA
+    int               d_value;       // value set by the creator or the test
+    int               d_numResets;   // number of calls to 'reset'
+    bsl::string       d_text;        // allocating member
+    bslma::Allocator *d_allocator_p; // memory allocator (held, not owned)
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(Item, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    Item(bslma::Allocator *basicAllocator = 0)
+    : d_value(0)
+    , d_numResets(0)
+    , d_text(basicAllocator)
+    , d_allocator_p(bslma::Default::allocator(basicAllocator))
+    {
+        ++g_numCreated;
+    }
+
+    Item(int value, bslma::Allocator *basicAllocator = 0)
+    : d_value(value)
+    , d_numResets(0)
+    , d_text(basicAllocator)
+    , d_allocator_p(bslma::Default::allocator(basicAllocator))
+    {
+        ++g_numCreated;
+    }
+
+    ~Item()
+    {
+        ++g_numDestroyed;
+    }
+
+    // MANIPULATORS
+    void reset()
+    {
+        ++d_numResets;
+        d_text.clear();
+    }
+
+    void setText(const char *text)
+    {
+        d_text = text;
+    }
+
+    void setValue(int value)
+    {
+        d_value = value;
+    }
+
+    // ACCESSORS
+    bslma::Allocator *allocator() const
+    {
+        return d_allocator_p;
+    }
+
+    int numResets() const
+    {
+        return d_numResets;
+    }
+
+    const bsl::string& text() const
+    {
+        return d_text;
+    }
+
+    int value() const
+    {
+        return d_value;
+    }
+};
+
+class ItemCreator {
+    // This class provides a creator constructing 'Item' objects having a
+    // configured value, and throwing when a configured number of objects have
+    // been created.
+
+    // DATA
+    int d_value;         // value of the created objects
+    int d_numRemaining;  // number of objects to create before throwing, or
+                         // negative for no limit
+
+  public:
+    // CREATORS
+    explicit
+    ItemCreator(int value = 0, int numRemaining = -1)
+    : d_value(value)
+    , d_numRemaining(numRemaining)
+    {
+    }
+
+    // MANIPULATORS
+    void operator()(void *arena, bslma::Allocator *allocator)
+    {
+        if (0 == d_numRemaining) {
+            BSLS_THROW(d_value);
+        }
+        if (0 < d_numRemaining) {
+            --d_numRemaining;
+        }
+        new (arena) Item(d_value, allocator);
+    }
+};
+
+class ItemResetter {
+    // This class provides a resetter setting the value of 'Item' objects to a
+    // configured value.
+
+    // DATA
+    int d_value;  // value set on reset
+
+  public:
+    // CREATORS
+    explicit
+    ItemResetter(int value = -1)
+    : d_value(value)
+    {
+    }
+
+    // ACCESSORS
+    void operator()(Item *object) const
+    {
+        object->setValue(d_value);
+        object->reset();
+    }
+};
+
+enum {
+    k_NUM_THREADS    = 8,
+    k_NUM_ITERATIONS = 10000
+};
+
+typedef bdlma::ObjectPool<Item> ThreadPool;
+
+extern "C"
+void *threadFunction(void *arg)
+    // Repeatedly obtain and release objects, directly and through shared
+    // pointers, from the thread-safe pool at the specified 'arg'.
+{
+    ThreadPool *pool = static_cast<ThreadPool *>(arg);
+
+    for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+        Item *object = pool->getObject();
+        ASSERT(object->text().empty());
+        object->setText("thread");
+
+        {
+            bsl::shared_ptr<Item> shared = pool->getSharedObject();
+            ASSERT(shared->text().empty());
+            shared->setText("shared");
+
+            bsl::shared_ptr<Item> copy = shared;
+        }
+
+        pool->releaseObject(object);
+    }
+    return 0;
+}
+
+                              // ==============
+                              // Usage Example
+                              // ==============
+
+namespace Usage {
+
+class Message {
+    // This class represents a decoded request.
+
+    // DATA
+    bsl::string                           d_topic;
+    bsl::map<bsl::string, bsl::string>    d_headers;
+    bsl::vector<char>                     d_payload;
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(Message, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit Message(bslma::Allocator *basicAllocator = 0)
+    : d_topic(basicAllocator)
+    , d_headers(basicAllocator)
+    , d_payload(basicAllocator)
+    {
+    }
+
+    // MANIPULATORS
+    void reset()
+    {
+        d_topic.clear();
+        d_headers.clear();
+        d_payload.clear();
+    }
+
+    void decode(const char *topic, int payloadSize)
+    {
+        d_topic = topic;
+        d_headers["content-length"] = "0";
+        d_payload.resize(payloadSize);
+    }
+
+    // ACCESSORS
+    const bsl::string& topic() const { return d_topic; }
+};
+
+}  // close namespace Usage
+
+// ============================================================================
+//                                MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+
+    (void)veryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da(veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        using namespace Usage;
+
+// Then, we create a thread-safe pool of messages:
+//..
+  bdlma::ObjectPool<Message> pool(bdlma::ObjectPool<Message>::e_THREAD_SAFE);
+//..
+// Next, we process a request with a message obtained from the pool, releasing
+// the message when we are done:
+//..
+  Message *message = pool.getObject();
+  message->decode("orders", 512);
+
+  // ... process the request ...
+
+  pool.releaseObject(message);
+
+  ASSERT(1 == pool.numObjects());
+  ASSERT(1 == pool.numAvailableObjects());
+//..
+// Now, we process the next request, which reuses the same message (already
+// reset by the pool):
+//..
+  Message *next = pool.getObject();
+  ASSERT(message == next);
+  ASSERT(next->topic().empty());
+
+  pool.releaseObject(next);
+//..
+// Finally, when the lifetime of a message is not confined to a single scope
+// (e.g., when it is handed off to another thread), we obtain it as a shared
+// pointer, which returns it to the pool when the last reference is dropped:
+//..
+  {
+      bsl::shared_ptr<Message> shared = pool.getSharedObject();
+      shared->decode("quotes", 128);
+
+      bsl::shared_ptr<Message> copy = shared;
+      ASSERT(0 == pool.numAvailableObjects());
+  }
+  ASSERT(1 == pool.numAvailableObjects());
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING CONCURRENCY
+        //
+        // Concerns:
+        //: 1 A thread-safe pool can be used by several threads concurrently,
+        //:   directly and through shared pointers.
+        //:
+        //: 2 An object is never in use by two threads at once, and objects
+        //:   are reset whenever they are released.
+        //:
+        //: 3 No more objects are created than are concurrently in use.
+        //
+        // Plan:
+        //: 1 Run several threads repeatedly obtaining, modifying, and
+        //:   releasing objects from the same thread-safe pool, verifying that
+        //:   each object obtained is reset.  (C-1..2)
+        //:
+        //: 2 Verify that the number of objects created is at most twice the
+        //:   number of threads, and that all objects are available at the
+        //:   end.  (C-3)
+        //
+        // Testing:
+        //   CONCERN: A thread-safe pool can be used concurrently.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING CONCURRENCY"
+                          << endl << "===================" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        {
+            ThreadPool mX(ThreadPool::e_THREAD_SAFE, &ta);
+            const ThreadPool& X = mX;
+
+            ThreadId ids[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ids[i] = createThread(&threadFunction, &mX);
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                joinThread(ids[i]);
+            }
+
+            ASSERTV(X.numObjects(), 2 * k_NUM_THREADS >= X.numObjects());
+            ASSERT(X.numObjects() == X.numAvailableObjects());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'getSharedObject'
+        //
+        // Concerns:
+        //: 1 'getSharedObject' returns a shared pointer to an object of the
+        //:   pool, reusing available objects.
+        //:
+        //: 2 The object is reset when its last shared reference is released,
+        //:   and returned to the pool when its last weak reference is
+        //:   released (so that a weak pointer cannot observe a reused
+        //:   object).
+        //:
+        //: 3 Obtaining a shared pointer to an available object allocates no
+        //:   memory.
+        //:
+        //: 4 Objects obtained by 'getSharedObject' and by 'getObject' come
+        //:   from the same pool.
+        //
+        // Plan:
+        //: 1 Obtain shared objects, copy and release the shared pointers, and
+        //:   verify the number of resets and the number of available objects.
+        //:   (C-1..2)
+        //:
+        //: 2 Hold a weak pointer past the release of the last shared pointer,
+        //:   and verify that the object is reset but not available until the
+        //:   weak pointer is released.  (C-2)
+        //:
+        //: 3 Verify that the test allocator is not used when a shared pointer
+        //:   to an available object is obtained.  (C-3)
+        //:
+        //: 4 Release a shared object and obtain it with 'getObject'.  (C-4)
+        //
+        // Testing:
+        //   bsl::shared_ptr<TYPE> getSharedObject();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING 'getSharedObject'"
+                          << endl << "=========================" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        typedef bdlma::ObjectPool<Item> Obj;
+
+        g_numCreated   = 0;
+        g_numDestroyed = 0;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            Item *address;
+            {
+                bsl::shared_ptr<Item> s1 = mX.getSharedObject();
+                ASSERT(s1);
+                ASSERT(1 == s1.use_count());
+                ASSERT(1 == X.numObjects());
+                ASSERT(0 == X.numAvailableObjects());
+                ASSERT(&ta == s1->allocator());
+
+                address = s1.get();
+                s1->setText("a string long enough to allocate memory");
+
+                bsl::shared_ptr<Item> s2 = s1;
+                ASSERT(2 == s1.use_count());
+
+                s1.reset();
+                ASSERT(0 == address->numResets());
+                ASSERT(0 == X.numAvailableObjects());
+            }
+            ASSERT(1 == address->numResets());
+            ASSERT(address->text().empty());
+            ASSERT(1 == X.numAvailableObjects());
+
+            if (verbose) cout << "\tReuse without allocation." << endl;
+            {
+                const bsls::Types::Int64 NUM_ALLOCATIONS = ta.numAllocations();
+
+                bsl::shared_ptr<Item> s1 = mX.getSharedObject();
+                ASSERT(address == s1.get());
+                ASSERT(1 == X.numObjects());
+                ASSERT(NUM_ALLOCATIONS == ta.numAllocations());
+            }
+            ASSERT(2 == address->numResets());
+
+            if (verbose) cout << "\tWeak references." << endl;
+            {
+                bsl::weak_ptr<Item> weak;
+                {
+                    bsl::shared_ptr<Item> s1 = mX.getSharedObject();
+                    ASSERT(address == s1.get());
+                    weak = s1;
+                    ASSERT(!weak.expired());
+                }
+                ASSERT(weak.expired());
+                ASSERT(!weak.lock());
+                ASSERT(3 == address->numResets());
+                ASSERT(0 == X.numAvailableObjects());
+
+                bsl::shared_ptr<Item> s2 = mX.getSharedObject();
+                ASSERT(address != s2.get());
+                ASSERT(2 == X.numObjects());
+                ASSERT(weak.expired());
+            }
+            ASSERT(2 == X.numAvailableObjects());
+
+            if (verbose) cout << "\tMixed with 'getObject'." << endl;
+            {
+                bsl::shared_ptr<Item> s1 = mX.getSharedObject();
+                bsl::shared_ptr<Item> s2 = mX.getSharedObject();
+                ASSERT(2 == X.numObjects());
+                ASSERT(0 == X.numAvailableObjects());
+
+                Item *object = s1.get();
+                s1.reset();
+                ASSERT(1 == X.numAvailableObjects());
+
+                Item *p = mX.getObject();
+                ASSERT(object == p);
+                mX.releaseObject(p);
+            }
+            ASSERT(2 == X.numObjects());
+            ASSERT(2 == X.numAvailableObjects());
+        }
+        ASSERT(2 == g_numCreated);
+        ASSERT(2 == g_numDestroyed);
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'getObject', 'releaseObject', 'reserveCapacity'
+        //
+        // Concerns:
+        //: 1 'getObject' creates an object, with the creator, only if no
+        //:   object is available.
+        //:
+        //: 2 'releaseObject' resets the object, with the resetter, and makes
+        //:   it available for reuse.
+        //:
+        //: 3 'reserveCapacity' creates objects until the requested number of
+        //:   objects is available, and no more.
+        //:
+        //: 4 The destructor destroys all of the objects created by the pool,
+        //:   and releases all memory.
+        //:
+        //: 5 If the creator throws, the exception is propagated, and the pool
+        //:   is unchanged.
+        //:
+        //: 6 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Obtain and release objects from pools using the default and
+        //:   custom functors, verifying the values of the objects and the
+        //:   accessors of the pool.  (C-1..2)
+        //:
+        //: 2 Reserve capacity, and verify the number of objects.  (C-3)
+        //:
+        //: 3 Count the constructions and destructions of objects, and verify
+        //:   that all memory is returned to the test allocator.  (C-4)
+        //:
+        //: 4 Use a creator throwing after a number of objects, and verify
+        //:   that the pool is unchanged by the failed creation.  (C-5)
+        //:
+        //: 5 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid argument values.  (C-6)
+        //
+        // Testing:
+        //   ~ObjectPool();
+        //   TYPE *getObject();
+        //   void releaseObject(TYPE *object);
+        //   void reserveCapacity(int numObjects);
+        //   int numAvailableObjects() const;
+        //   int numObjects() const;
+        //   CONCERN: A throwing creator leaves the pool unchanged.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                << endl
+                << "TESTING 'getObject', 'releaseObject', 'reserveCapacity'"
+                << endl
+                << "======================================================="
+                << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        if (verbose) cout << "\tDefault functors." << endl;
+
+        g_numCreated   = 0;
+        g_numDestroyed = 0;
+        {
+            typedef bdlma::ObjectPool<Item> Obj;
+
+            Obj mX(&ta);  const Obj& X = mX;
+
+            Item *p1 = mX.getObject();
+            Item *p2 = mX.getObject();
+            ASSERT(p1 != p2);
+            ASSERT(2 == X.numObjects());
+            ASSERT(0 == X.numAvailableObjects());
+            ASSERT(2 == g_numCreated);
+            ASSERT(&ta == p1->allocator());
+            ASSERT(0 == p1->numResets());
+
+            p1->setText("a string long enough to allocate memory");
+            mX.releaseObject(p1);
+            ASSERT(1 == p1->numResets());
+            ASSERT(p1->text().empty());
+            ASSERT(1 == X.numAvailableObjects());
+
+            Item *p3 = mX.getObject();
+            ASSERT(p1 == p3);
+            ASSERT(2 == X.numObjects());
+            ASSERT(0 == X.numAvailableObjects());
+
+            mX.releaseObject(p2);
+            mX.releaseObject(p3);
+            ASSERT(2 == X.numAvailableObjects());
+
+            // Objects are reused in LIFO order.
+
+            ASSERT(p3 == mX.getObject());
+            ASSERT(p2 == mX.getObject());
+            mX.releaseObject(p2);
+            mX.releaseObject(p3);
+
+            if (verbose) cout << "\tReserve capacity." << endl;
+
+            mX.reserveCapacity(1);
+            ASSERT(2 == X.numObjects());
+            ASSERT(2 == X.numAvailableObjects());
+
+            mX.reserveCapacity(5);
+            ASSERT(5 == X.numObjects());
+            ASSERT(5 == X.numAvailableObjects());
+            ASSERT(5 == g_numCreated);
+
+            mX.reserveCapacity(0);
+            ASSERT(5 == X.numObjects());
+        }
+        ASSERT(5 == g_numDestroyed);
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tCustom functors." << endl;
+
+        g_numCreated   = 0;
+        g_numDestroyed = 0;
+        {
+            typedef bdlma::ObjectPool<Item, ItemCreator, ItemResetter> Obj;
+
+            Obj mX(ItemCreator(7), ItemResetter(-3), &ta);
+            const Obj& X = mX;
+
+            Item *p1 = mX.getObject();
+            ASSERT(7 == p1->value());
+            ASSERT(&ta == p1->allocator());
+
+            mX.releaseObject(p1);
+            ASSERT(-3 == p1->value());
+            ASSERT( 1 == p1->numResets());
+
+            ASSERT(p1 == mX.getObject());
+            ASSERT(-3 == p1->value());
+            ASSERT( 1 == X.numObjects());
+
+            // Objects left in use at destruction are not supported; release.
+
+            mX.releaseObject(p1);
+        }
+        ASSERT(1 == g_numCreated);
+        ASSERT(1 == g_numDestroyed);
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\t'Nil' and 'Clear' resetters." << endl;
+        {
+            typedef bdlma::ObjectPoolFunctors::DefaultCreator<bsl::string>
+                                                                     Creator;
+            typedef bdlma::ObjectPoolFunctors::Clear<bsl::string>    Clear;
+            typedef bdlma::ObjectPoolFunctors::Nil<bsl::string>      Nil;
+
+            bdlma::ObjectPool<bsl::string, Creator, Clear> mX(Creator(),
+                                                              Clear(),
+                                                              &ta);
+            bsl::string *s = mX.getObject();
+            ASSERT(&ta == s->get_allocator().mechanism());
+
+            s->assign(100, 'x');
+            const bsl::string::size_type CAPACITY = s->capacity();
+
+            mX.releaseObject(s);
+            ASSERT(s->empty());
+            ASSERT(CAPACITY == s->capacity());
+
+            bdlma::ObjectPool<bsl::string, Creator, Nil> mY(Creator(),
+                                                            Nil(),
+                                                            &ta);
+            bsl::string *t = mY.getObject();
+            t->assign("abc");
+            mY.releaseObject(t);
+            ASSERT("abc" == *mY.getObject());
+            mY.releaseObject(t);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+#ifdef BDE_BUILD_TARGET_EXC
+        if (verbose) cout << "\tThrowing creator." << endl;
+
+        g_numCreated   = 0;
+        g_numDestroyed = 0;
+        {
+            typedef bdlma::ObjectPool<Item, ItemCreator, ItemResetter> Obj;
+
+            Obj mX(ItemCreator(9, 2), ItemResetter(), &ta);
+            const Obj& X = mX;
+
+            Item *p1 = mX.getObject();
+            Item *p2 = mX.getObject();
+            ASSERT(2 == X.numObjects());
+
+            const bsls::Types::Int64 NUM_BLOCKS = ta.numBlocksInUse();
+
+            bool caught = false;
+            try {
+                mX.getObject();
+            }
+            catch (int value) {
+                ASSERT(9 == value);
+                caught = true;
+            }
+            ASSERT(caught);
+            ASSERT(2          == X.numObjects());
+            ASSERT(0          == X.numAvailableObjects());
+            ASSERT(NUM_BLOCKS == ta.numBlocksInUse());
+
+            caught = false;
+            try {
+                mX.reserveCapacity(1);
+            }
+            catch (int) {
+                caught = true;
+            }
+            ASSERT(caught);
+            ASSERT(2 == X.numObjects());
+            ASSERT(0 == X.numAvailableObjects());
+
+            mX.releaseObject(p1);
+            ASSERT(p1 == mX.getObject());
+
+            mX.releaseObject(p1);
+            mX.releaseObject(p2);
+        }
+        ASSERT(2 == g_numCreated);
+        ASSERT(2 == g_numDestroyed);
+        ASSERT(0 == ta.numBlocksInUse());
+#endif
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            typedef bdlma::ObjectPool<Item> Obj;
+
+            Obj mX(&ta);
+
+            ASSERT_PASS(mX.reserveCapacity(0));
+            ASSERT_FAIL(mX.reserveCapacity(-1));
+
+            ASSERT_FAIL(mX.releaseObject(0));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor creates an empty pool using the specified (or
+        //:   default) allocator, functors, and concurrency policy.
+        //:
+        //: 2 The objects created by the pool are supplied the allocator of the
+        //:   pool.
+        //:
+        //: 3 The growth strategy and maximum number of objects per chunk bound
+        //:   the memory obtained for objects.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create pools with each constructor, and verify the accessors.
+        //:   (C-1..2)
+        //:
+        //: 2 Create a pool with constant growth, and verify that objects are
+        //:   obtained from the allocator in chunks of the specified size.
+        //:   (C-3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid argument values.  (C-4)
+        //
+        // Testing:
+        //   ObjectPool(bslma::Allocator *ba = 0);
+        //   ObjectPool(ConcurrencyPolicy cp, bslma::Allocator *ba = 0);
+        //   ObjectPool(const C& c, const R& r, bslma::Allocator *ba = 0);
+        //   ObjectPool(const C&, const R&, Strategy, int, Policy, *ba);
+        //   bslma::Allocator *allocator() const;
+        //   bool isThreadSafe() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING CREATORS AND BASIC ACCESSORS" << endl
+                          << "====================================" << endl;
+
+        bslma::TestAllocator da(veryVeryVerbose);
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        typedef bdlma::ObjectPool<Item, ItemCreator, ItemResetter> Obj;
+
+        {
+            Obj mX;  const Obj& X = mX;
+            ASSERT(&da   == X.allocator());
+            ASSERT(false == X.isThreadSafe());
+            ASSERT(0     == X.numObjects());
+            ASSERT(0     == X.numAvailableObjects());
+
+            Item *p = mX.getObject();
+            ASSERT(&da == p->allocator());
+            mX.releaseObject(p);
+        }
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+            ASSERT(&ta   == X.allocator());
+            ASSERT(false == X.isThreadSafe());
+        }
+        {
+            Obj mX(Obj::e_THREAD_SAFE);  const Obj& X = mX;
+            ASSERT(&da  == X.allocator());
+            ASSERT(true == X.isThreadSafe());
+        }
+        {
+            Obj mX(Obj::e_SINGLE_THREADED, &ta);  const Obj& X = mX;
+            ASSERT(&ta   == X.allocator());
+            ASSERT(false == X.isThreadSafe());
+        }
+        {
+            Obj mX(ItemCreator(5), ItemResetter(6), &ta);  const Obj& X = mX;
+            ASSERT(&ta   == X.allocator());
+            ASSERT(false == X.isThreadSafe());
+
+            Item *p = mX.getObject();
+            ASSERT(5   == p->value());
+            ASSERT(&ta == p->allocator());
+            mX.releaseObject(p);
+            ASSERT(6   == p->value());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tGrowth strategy." << endl;
+        {
+            Obj mX(ItemCreator(),
+                   ItemResetter(),
+                   bsls::BlockGrowth::BSLS_CONSTANT,
+                   4,
+                   Obj::e_THREAD_SAFE,
+                   &ta);
+            const Obj& X = mX;
+            ASSERT(&ta  == X.allocator());
+            ASSERT(true == X.isThreadSafe());
+
+            // Items allocate nothing, so each chunk is one allocation.
+
+            const bsls::Types::Int64 NUM_INITIAL = ta.numAllocations();
+
+            Item *items[8];
+            items[0] = mX.getObject();
+            const bsls::Types::Int64 NUM_ALLOCATIONS = ta.numAllocations();
+            ASSERT(NUM_INITIAL + 1 == NUM_ALLOCATIONS);
+
+            for (int i = 1; i < 4; ++i) {
+                items[i] = mX.getObject();
+            }
+            ASSERT(NUM_ALLOCATIONS == ta.numAllocations());
+
+            for (int i = 4; i < 8; ++i) {
+                items[i] = mX.getObject();
+            }
+            ASSERT(NUM_ALLOCATIONS + 1 == ta.numAllocations());
+
+            for (int i = 0; i < 8; ++i) {
+                mX.releaseObject(items[i]);
+            }
+            ASSERT(8 == X.numAvailableObjects());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_PASS_RAW(Obj(ItemCreator(),
+                                ItemResetter(),
+                                bsls::BlockGrowth::BSLS_GEOMETRIC,
+                                1,
+                                Obj::e_SINGLE_THREADED,
+                                &ta));
+            ASSERT_FAIL_RAW(Obj(ItemCreator(),
+                                ItemResetter(),
+                                bsls::BlockGrowth::BSLS_GEOMETRIC,
+                                0,
+                                Obj::e_SINGLE_THREADED,
+                                &ta));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Obtain, release, and reuse objects, directly and through shared
+        //:   pointers.
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        g_numCreated   = 0;
+        g_numDestroyed = 0;
+        {
+            bdlma::ObjectPool<Item> mX(&ta);
+
+            Item *p = mX.getObject();
+            ASSERT(1 == mX.numObjects());
+
+            mX.releaseObject(p);
+            ASSERT(1 == p->numResets());
+            ASSERT(p == mX.getObject());
+            mX.releaseObject(p);
+
+            {
+                bsl::shared_ptr<Item> sp = mX.getSharedObject();
+                ASSERT(p == sp.get());
+            }
+            ASSERT(3 == p->numResets());
+            ASSERT(1 == mX.numAvailableObjects());
+        }
+        ASSERT(1 == g_numCreated);
+        ASSERT(1 == g_numDestroyed);
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
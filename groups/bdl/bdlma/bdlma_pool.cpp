@@ -5,9 +5,12 @@
 BSLS_IDENT_RCSID(bdlma_pool_cpp,"$Id$ $CSID$")
 
 #include <bsls_alignmentfromtype.h>
+#include <bsls_alignmentutil.h>
 #include <bsls_performancehint.h>
+#include <bsls_types.h>
 
 #include <bsl_algorithm.h>
+#include <bsl_functional.h>
 
 namespace BloombergLP {
 namespace bdlma {
@@ -36,24 +39,18 @@ enum {
 
 // LOCAL FUNCTIONS
 static
-void *replenishImp(BloombergLP::bdlma::InfrequentDeleteBlockList *blockList,
-                   int                                            blockSize,
-                   int                                            numBlocks,
-                   void                                          *nextList)
-    // Return the address of a linked list of modifiable free memory blocks
-    // having the specified 'numBlocks', with each memory block having the
-    // specified 'blockSize' (in bytes).  Append the specified 'nextList' to
-    // the newly-created linked list.  Allocate memory using the specified
-    // 'blockList'.  The behavior is undefined unless '1 <= blockSize' and
-    // '1 <= numBlocks'.
+void *linkBlocks(char *begin, int blockSize, int numBlocks, void *nextList)
+    // Return the address of a linked list of the specified 'numBlocks' memory
+    // blocks, each of the specified 'blockSize' (in bytes), laid out
+    // contiguously starting at the specified 'begin' address, and followed by
+    // the specified 'nextList'.  The behavior is undefined unless
+    // '1 <= blockSize' and '1 <= numBlocks'.
 {
-    BSLS_ASSERT(blockList);
+    BSLS_ASSERT(begin);
     BSLS_ASSERT(1 <= blockSize);
     BSLS_ASSERT(1 <= numBlocks);
 
-    char *begin = static_cast<char *>(
-                                   blockList->allocate(numBlocks * blockSize));
-    char *end   = begin + (numBlocks - 1) * blockSize;
+    char *end = begin + (numBlocks - 1) * blockSize;
 
     for (char *p = begin; p < end; p += blockSize) {
         reinterpret_cast<Link *>(p)->d_next_p =
@@ -64,6 +61,81 @@ void *replenishImp(BloombergLP::bdlma::InfrequentDeleteBlockList *blockList,
     return begin;
 }
 
+template <class NODE>
+NODE *sortByAddress(NODE *list)
+    // Sort the specified singly-linked 'list', of nodes linked through their
+    // 'd_next_p' member, in increasing address order, and return the address
+    // of the first node of the sorted list.  This function does not allocate
+    // memory.
+{
+    // Bottom-up merge sort: merge adjacent runs of length 'width' until a
+    // single run remains.
+
+    if (!list) {
+        return list;                                                  // RETURN
+    }
+
+    // The nodes belong to distinct chunks, so their addresses are compared
+    // with 'bsl::less', which (unlike the built-in '<') provides a total
+    // order on unrelated pointers.
+
+    const bsl::less<NODE *> isBefore = bsl::less<NODE *>();
+
+    for (int width = 1; ; width *= 2) {
+        NODE *remaining = list;
+        NODE *head      = 0;
+        NODE *tail      = 0;
+        int   numMerges = 0;
+
+        while (remaining) {
+            ++numMerges;
+
+            NODE *a     = remaining;
+            NODE *b     = remaining;
+            int   aSize = 0;
+            while (b && aSize < width) {
+                b = b->d_next_p;
+                ++aSize;
+            }
+            int bSize = width;
+
+            while (aSize || (bSize && b)) {
+                NODE *next;
+                if (0 == aSize) {
+                    next = b;
+                    b    = b->d_next_p;
+                    --bSize;
+                }
+                else if (0 == bSize || !b || isBefore(a, b)) {
+                    next = a;
+                    a    = a->d_next_p;
+                    --aSize;
+                }
+                else {
+                    next = b;
+                    b    = b->d_next_p;
+                    --bSize;
+                }
+
+                if (tail) {
+                    tail->d_next_p = next;
+                }
+                else {
+                    head = next;
+                }
+                tail = next;
+            }
+            remaining = b;
+        }
+        tail->d_next_p = 0;
+        list           = head;
+
+        if (numMerges <= 1) {
+            return list;                                              // RETURN
+        }
+    }
+}
+
 static inline
 int roundUp(int x, int y)
     // Round up the specified 'x' to the nearest whole integer multiple of the
@@ -75,19 +147,107 @@ int roundUp(int x, int y)
     return (x + y - 1) / y * y;
 }
 
+static
+int internalBlockSize(int blockSize, int blockAlignment)
+    // Return the size (in bytes) of the blocks maintained on the free list of
+    // a pool dispensing blocks of the specified 'blockSize' that are aligned
+    // to the specified 'blockAlignment' (or 0 if unspecified).  The behavior
+    // is undefined unless '1 <= blockSize' and 'blockAlignment' is 0 or an
+    // integral power of 2.
+{
+    const int linkAlignment = bsls::AlignmentFromType<Link>::VALUE;
+
+    return roundUp(bsl::max(static_cast<int>(sizeof(Link)), blockSize),
+                   bsl::max(linkAlignment, blockAlignment));
+}
+
 }  // close unnamed namepace
 
+                        // -----------------
+                        // struct Pool::Chunk
+                        // -----------------
+
+struct Pool::Chunk {
+    // This 'struct' overlays the beginning of each chunk obtained while
+    // reclamation is enabled, and records the extent of the blocks within the
+    // chunk.
+
+    Chunk *d_next_p;     // next reclaimable chunk
+
+    char  *d_begin_p;    // address of the first block in this chunk
+
+    int    d_numBlocks;  // number of blocks in this chunk
+
+    int    d_numFree;    // number of free blocks in this chunk (valid only
+                         // during 'shrink')
+};
+
                         // ----------
                         // class Pool
                         // ----------
 
 // PRIVATE MANIPULATORS
+Pool::Link *Pool::allocateChunk(int numBlocks, Link *nextList)
+{
+    BSLS_ASSERT(1 <= numBlocks);
+
+    // Memory from the block lists is maximally aligned, so a chunk needs
+    // padding only for an alignment exceeding the maximal alignment.
+
+    const int maxAlign = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+    const int padding  = d_blockAlignment > maxAlign
+                       ? d_blockAlignment - maxAlign
+                       : 0;
+    const int size     = numBlocks * d_internalBlockSize + padding;
+
+    char  *begin;
+    Chunk *chunk = 0;
+
+    if (k_NO_RECLAIM == d_reclaimThreshold) {
+        begin = static_cast<char *>(d_blockList.allocate(size));
+    }
+    else {
+        const int headerSize = roundUp(static_cast<int>(sizeof(Chunk)),
+                                       maxAlign);
+
+        chunk = static_cast<Chunk *>(d_chunkList.allocate(headerSize + size));
+        begin = reinterpret_cast<char *>(chunk) + headerSize;
+    }
+
+    if (padding) {
+        begin += bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                             begin,
+                                                             d_blockAlignment);
+    }
+
+    if (chunk) {
+        chunk->d_next_p    = d_chunks_p;
+        chunk->d_begin_p   = begin;
+        chunk->d_numBlocks = numBlocks;
+        chunk->d_numFree   = 0;
+        d_chunks_p         = chunk;
+
+        // The new chunk can be reclaimed: rearm the automatic call to
+        // 'shrink', which may have been deferred or disabled by a previous
+        // call.
+
+        if (0 < d_reclaimThreshold) {
+            d_shrinkTrigger = d_reclaimThreshold;
+        }
+    }
+
+    d_numFreeBlocks += numBlocks;
+    d_numBlocks     += numBlocks;
+
+    return static_cast<Link *>(linkBlocks(begin,
+                                          d_internalBlockSize,
+                                          numBlocks,
+                                          nextList));
+}
+
 void Pool::replenish()
 {
-    d_freeList_p = static_cast<Link *>(replenishImp(&d_blockList,
-                                                    d_internalBlockSize,
-                                                    d_chunkSize,
-                                                    0));
+    d_freeList_p = allocateChunk(d_chunkSize, 0);
 
     if (bsls::BlockGrowth::BSLS_GEOMETRIC == d_growthStrategy
      && d_chunkSize < d_maxBlocksPerChunk) {
@@ -106,36 +266,46 @@ void Pool::replenish()
 // CREATORS
 Pool::Pool(int blockSize, bslma::Allocator *basicAllocator)
 : d_blockSize(blockSize)
+, d_blockAlignment(0)
 , d_chunkSize(INITIAL_CHUNK_SIZE)
 , d_maxBlocksPerChunk(MAX_CHUNK_SIZE)
 , d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
 , d_freeList_p(0)
+, d_numFreeBlocks(0)
+, d_numBlocks(0)
+, d_reclaimThreshold(k_NO_RECLAIM)
+, d_shrinkTrigger(INT_MAX)
+, d_chunks_p(0)
 , d_blockList(basicAllocator)
+, d_chunkList(basicAllocator)
 {
     BSLS_ASSERT(1 <= blockSize);
 
-    d_internalBlockSize = bsl::max(
-                     static_cast<int>(sizeof(Link)),
-                     roundUp(blockSize, bsls::AlignmentFromType<Link>::VALUE));
+    d_internalBlockSize = internalBlockSize(blockSize, 0);
 }
 
 Pool::Pool(int                          blockSize,
            bsls::BlockGrowth::Strategy  growthStrategy,
            bslma::Allocator            *basicAllocator)
 : d_blockSize(blockSize)
+, d_blockAlignment(0)
 , d_chunkSize(bsls::BlockGrowth::BSLS_CONSTANT == growthStrategy
               ? MAX_CHUNK_SIZE
               : INITIAL_CHUNK_SIZE)
 , d_maxBlocksPerChunk(MAX_CHUNK_SIZE)
 , d_growthStrategy(growthStrategy)
 , d_freeList_p(0)
+, d_numFreeBlocks(0)
+, d_numBlocks(0)
+, d_reclaimThreshold(k_NO_RECLAIM)
+, d_shrinkTrigger(INT_MAX)
+, d_chunks_p(0)
 , d_blockList(basicAllocator)
+, d_chunkList(basicAllocator)
 {
     BSLS_ASSERT(1 <= blockSize);
 
-    d_internalBlockSize = bsl::max(
-                     static_cast<int>(sizeof(Link)),
-                     roundUp(blockSize, bsls::AlignmentFromType<Link>::VALUE));
+    d_internalBlockSize = internalBlockSize(blockSize, 0);
 }
 
 Pool::Pool(int                          blockSize,
@@ -143,20 +313,81 @@ Pool::Pool(int                          blockSize,
            int                          maxBlocksPerChunk,
            bslma::Allocator            *basicAllocator)
 : d_blockSize(blockSize)
+, d_blockAlignment(0)
 , d_chunkSize(bsls::BlockGrowth::BSLS_CONSTANT == growthStrategy
               ? maxBlocksPerChunk
               : INITIAL_CHUNK_SIZE)
 , d_maxBlocksPerChunk(maxBlocksPerChunk)
 , d_growthStrategy(growthStrategy)
 , d_freeList_p(0)
+, d_numFreeBlocks(0)
+, d_numBlocks(0)
+, d_reclaimThreshold(k_NO_RECLAIM)
+, d_shrinkTrigger(INT_MAX)
+, d_chunks_p(0)
 , d_blockList(basicAllocator)
+, d_chunkList(basicAllocator)
 {
     BSLS_ASSERT(1 <= blockSize);
     BSLS_ASSERT(1 <= maxBlocksPerChunk);
 
-    d_internalBlockSize = bsl::max(
-                     static_cast<int>(sizeof(Link)),
-                     roundUp(blockSize, bsls::AlignmentFromType<Link>::VALUE));
+    d_internalBlockSize = internalBlockSize(blockSize, 0);
+}
+
+Pool::Pool(int                          blockSize,
+           int                          blockAlignment,
+           bsls::BlockGrowth::Strategy  growthStrategy,
+           bslma::Allocator            *basicAllocator)
+: d_blockSize(blockSize)
+, d_blockAlignment(blockAlignment)
+, d_chunkSize(bsls::BlockGrowth::BSLS_CONSTANT == growthStrategy
+              ? MAX_CHUNK_SIZE
+              : INITIAL_CHUNK_SIZE)
+, d_maxBlocksPerChunk(MAX_CHUNK_SIZE)
+, d_growthStrategy(growthStrategy)
+, d_freeList_p(0)
+, d_numFreeBlocks(0)
+, d_numBlocks(0)
+, d_reclaimThreshold(k_NO_RECLAIM)
+, d_shrinkTrigger(INT_MAX)
+, d_chunks_p(0)
+, d_blockList(basicAllocator)
+, d_chunkList(basicAllocator)
+{
+    BSLS_ASSERT(1 <= blockSize);
+    BSLS_ASSERT(0 < blockAlignment);
+    BSLS_ASSERT(0 == (blockAlignment & (blockAlignment - 1)));
+
+    d_internalBlockSize = internalBlockSize(blockSize, blockAlignment);
+}
+
+Pool::Pool(int                          blockSize,
+           int                          blockAlignment,
+           bsls::BlockGrowth::Strategy  growthStrategy,
+           int                          maxBlocksPerChunk,
+           bslma::Allocator            *basicAllocator)
+: d_blockSize(blockSize)
+, d_blockAlignment(blockAlignment)
+, d_chunkSize(bsls::BlockGrowth::BSLS_CONSTANT == growthStrategy
+              ? maxBlocksPerChunk
+              : INITIAL_CHUNK_SIZE)
+, d_maxBlocksPerChunk(maxBlocksPerChunk)
+, d_growthStrategy(growthStrategy)
+, d_freeList_p(0)
+, d_numFreeBlocks(0)
+, d_numBlocks(0)
+, d_reclaimThreshold(k_NO_RECLAIM)
+, d_shrinkTrigger(INT_MAX)
+, d_chunks_p(0)
+, d_blockList(basicAllocator)
+, d_chunkList(basicAllocator)
+{
+    BSLS_ASSERT(1 <= blockSize);
+    BSLS_ASSERT(0 < blockAlignment);
+    BSLS_ASSERT(0 == (blockAlignment & (blockAlignment - 1)));
+    BSLS_ASSERT(1 <= maxBlocksPerChunk);
+
+    d_internalBlockSize = internalBlockSize(blockSize, blockAlignment);
 }
 
 Pool::~Pool()
@@ -177,11 +408,115 @@ void Pool::reserveCapacity(int numBlocks)
     }
 
     if (numBlocks) {
-        d_freeList_p = static_cast<Link *>(replenishImp(&d_blockList,
-                                                        d_internalBlockSize,
-                                                        numBlocks,
-                                                        d_freeList_p));
+        d_freeList_p = allocateChunk(numBlocks, d_freeList_p);
+    }
+}
+
+void Pool::setReclaimThreshold(int numFreeBlocks)
+{
+    BSLS_ASSERT(k_NO_RECLAIM <= numFreeBlocks);
+
+    d_reclaimThreshold = numFreeBlocks;
+    d_shrinkTrigger    = 0 < numFreeBlocks ? numFreeBlocks : INT_MAX;
+}
+
+int Pool::shrink()
+{
+    if (!d_chunks_p) {
+        // Nothing can be reclaimed until a chunk is tracked, which rearms the
+        // automatic call.
+
+        d_shrinkTrigger = INT_MAX;
+        return 0;                                                     // RETURN
     }
+
+    // Sort both the free list and the chunks by address, so that a single
+    // pass over the free list can attribute each free block to its chunk.
+    // Free blocks belonging to untracked chunks (obtained before reclamation
+    // was enabled) lie outside every tracked chunk, and are left alone.
+
+    d_freeList_p = sortByAddress(d_freeList_p);
+    d_chunks_p   = sortByAddress(d_chunks_p);
+
+    const bsls::Types::IntPtr blockSize = d_internalBlockSize;
+
+    Chunk *chunk = d_chunks_p;
+    for (Link *p = d_freeList_p; p && chunk; p = p->d_next_p) {
+        const char *address = reinterpret_cast<char *>(p);
+
+        while (chunk
+            && address >= chunk->d_begin_p + chunk->d_numBlocks * blockSize) {
+            chunk = chunk->d_next_p;
+        }
+        if (chunk && address >= chunk->d_begin_p) {
+            ++chunk->d_numFree;
+        }
+    }
+
+    // Unlink from the free list the blocks of the chunks that are entirely
+    // free, preserving the address order of the remaining blocks.
+
+    Link **prevNext = &d_freeList_p;
+    chunk = d_chunks_p;
+    for (Link *p = d_freeList_p; p; p = p->d_next_p) {
+        const char *address = reinterpret_cast<char *>(p);
+
+        while (chunk
+            && address >= chunk->d_begin_p + chunk->d_numBlocks * blockSize) {
+            chunk = chunk->d_next_p;
+        }
+        if (chunk
+         && address >= chunk->d_begin_p
+         && chunk->d_numFree == chunk->d_numBlocks) {
+            continue;
+        }
+        *prevNext = p;
+        prevNext  = &p->d_next_p;
+    }
+    *prevNext = 0;
+
+    // Return the entirely free chunks to the underlying allocator.
+
+    int numReclaimed = 0;
+
+    Chunk **prevChunkNext = &d_chunks_p;
+    while (*prevChunkNext) {
+        chunk = *prevChunkNext;
+
+        if (chunk->d_numFree == chunk->d_numBlocks) {
+            *prevChunkNext   = chunk->d_next_p;
+            d_numFreeBlocks -= chunk->d_numBlocks;
+            d_numBlocks     -= chunk->d_numBlocks;
+            d_chunkList.deallocate(chunk);
+            ++numReclaimed;
+        }
+        else {
+            chunk->d_numFree = 0;
+            prevChunkNext    = &chunk->d_next_p;
+        }
+    }
+
+    // Defer the next automatic call until the number of free blocks has
+    // doubled, so that the cost of this method is amortized even if little
+    // could be reclaimed, but no later than when every block is free (at
+    // which point every tracked chunk is reclaimable).  If no chunk remains
+    // tracked, the next automatic call is armed by 'allocateChunk'.
+
+    if (0 < d_reclaimThreshold) {
+        if (d_chunks_p) {
+            const int deferred = d_numFreeBlocks < INT_MAX / 2
+                               ? 2 * d_numFreeBlocks
+                               : INT_MAX;
+
+            d_shrinkTrigger = bsl::max(d_reclaimThreshold,
+                                       bsl::min(deferred, d_numBlocks - 1));
+        }
+        else {
+            d_shrinkTrigger = INT_MAX;
+        }
+    }
+
+    return numReclaimed;
 }
 
 }  // close package namespace
@@ -53,6 +53,14 @@ BSLS_IDENT("$Id: $")
 //: 3 BASIC ALLOCATOR -- the allocator used to supply memory to replenish the
 //:   internal pool.  If not specified, the currently installed default
 //:   allocator is used (see 'bslma_default').
+//: 4 BLOCK ALIGNMENT -- an alignment (an integral power of 2, possibly
+//:   exceeding the maximal alignment of the platform) to which every block
+//:   dispensed by the pool is aligned, e.g., to place each block on its own
+//:   cache line, or on its own page.  Blocks are padded to a multiple of the
+//:   alignment, and each chunk carries at most one alignment of padding, so
+//:   the cost of over-alignment is amortized across the chunk.  The alignment
+//:   is specified (immediately following the block size) only together with
+//:   a growth strategy.
 //
 // For example, if geometric growth is used and the maximum blocks per chunk is
 // specified as 30, the chunk size grows geometrically, starting from 1, until
@@ -127,6 +135,42 @@ BSLS_IDENT("$Id: $")
 // An overloaded operator 'delete' is supplied solely to allow the compiler to
 // arrange for it to be called in case of an exception.
 //
+///Chunk Reclamation
+///-----------------
+// By default, the chunks obtained by a 'bdlma::Pool' are returned to the
+// underlying allocator only by 'release' or the destructor, so the footprint
+// of a long-lived pool never falls below the largest number of blocks it has
+// had outstanding at once.  Clients can opt into *chunk* *reclamation* by
+// calling 'setReclaimThreshold'.  Chunks obtained while reclamation is enabled
+// are tracked individually, and the 'shrink' method returns every tracked
+// chunk none of whose blocks is outstanding to the underlying allocator
+// (chunks obtained before reclamation was enabled are never reclaimed before
+// 'release').
+//
+// The occupancy of each chunk is computed only when 'shrink' is invoked: the
+// free list is sorted by address, and matched against the (likewise sorted)
+// list of tracked chunks, so 'allocate' and 'deallocate' incur no per-chunk
+// bookkeeping, and a call to 'shrink' takes 'O(F * log(F))' time, where 'F' is
+// the number of free blocks.  As a side effect, the free blocks that remain
+// are dispensed in increasing address order.
+//
+// 'setReclaimThreshold' takes one of the following values:
+//
+//: 'k_NO_RECLAIM' (the default):
+//:   Chunks are not tracked, and are returned only by 'release'.
+//:
+//: 'k_RECLAIM_ON_DEMAND':
+//:   Chunks are tracked, and are returned only by an explicit call to
+//:   'shrink'.
+//:
+//: a positive number of blocks:
+//:   Chunks are tracked, and 'deallocate' calls 'shrink' once the number of
+//:   free blocks exceeds the threshold.  If free blocks cannot be reclaimed
+//:   (e.g., because each chunk has a block outstanding), the next automatic
+//:   call is deferred until the number of free blocks has doubled (or every
+//:   block is free, or a new chunk is obtained), so the cost of 'shrink' is
+//:   amortized over the deallocations that precede it.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -263,6 +307,10 @@ BSLS_IDENT("$Id: $")
 #include <bdlscm_version.h>
 #endif
 
+#ifndef INCLUDED_BDLMA_BLOCKLIST
+#include <bdlma_blocklist.h>
+#endif
+
 #ifndef INCLUDED_BDLMA_INFREQUENTDELETEBLOCKLIST
 #include <bdlma_infrequentdeleteblocklist.h>
 #endif
@@ -287,6 +335,14 @@ BSLS_IDENT("$Id: $")
 #include <bsls_blockgrowth.h>
 #endif
 
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSL_CLIMITS
+#include <bsl_climits.h>
+#endif
+
 #ifndef INCLUDED_BSL_CSTDDEF
 #include <bsl_cstddef.h>        // for 'bsl::size_t'
 #endif
@@ -316,10 +372,26 @@ class Pool {
         Link *d_next_p;  // pointer to next link
     };
 
+    struct Chunk;
+        // This 'struct', defined in 'bdlma_pool.cpp', overlays the beginning
+        // of each chunk obtained while reclamation is enabled (see 'shrink').
+
+  public:
+    // PUBLIC TYPES
+    enum {
+        k_NO_RECLAIM        = -1,  // chunks are returned only by 'release'
+
+        k_RECLAIM_ON_DEMAND =  0   // chunks are returned by 'shrink'
+    };
+
+  private:
     // DATA
     int   d_blockSize;          // size (in bytes) of each allocated memory
                                 // block returned to client
 
+    int   d_blockAlignment;     // alignment of each block, or 0 if
+                                // unspecified
+
     int   d_internalBlockSize;  // actual size of each block maintained on
                                 // free list (contains overhead for 'Link')
 
@@ -332,11 +404,35 @@ class Pool {
 
     Link *d_freeList_p;         // linked list of free memory blocks
 
+    int   d_numFreeBlocks;      // number of blocks on 'd_freeList_p'
+
+    int   d_numBlocks;          // number of blocks (free or outstanding) in
+                                // the chunks held by this pool
+
+    int   d_reclaimThreshold;   // 'k_NO_RECLAIM', 'k_RECLAIM_ON_DEMAND', or
+                                // number of free blocks triggering 'shrink'
+
+    int   d_shrinkTrigger;      // number of free blocks above which
+                                // 'deallocate' calls 'shrink' ('INT_MAX' if
+                                // never)
+
+    Chunk *d_chunks_p;          // list of reclaimable chunks
+
     InfrequentDeleteBlockList
           d_blockList;          // memory manager for allocated memory
 
+    BlockList
+          d_chunkList;          // memory manager for reclaimable chunks
+
   private:
     // PRIVATE MANIPULATORS
+    Link *allocateChunk(int numBlocks, Link *nextList);
+        // Dynamically allocate a new chunk of the specified 'numBlocks'
+        // blocks, and return the address of a linked list of the blocks in the
+        // chunk followed by the specified 'nextList'.  The chunk is tracked
+        // for reclamation if reclamation is enabled.  The behavior is
+        // undefined unless '1 <= numBlocks'.
+
     void replenish();
         // Dynamically allocate a new chunk using this pool's underlying growth
         // strategy, and use the chunk to replenish the free memory list of
@@ -376,6 +472,29 @@ class Pool {
         // used.  The behavior is undefined unless '1 <= blockSize' and
         // '1 <= maxBlocksPerChunk'.
 
+    Pool(int                          blockSize,
+         int                          blockAlignment,
+         bsls::BlockGrowth::Strategy  growthStrategy,
+         bslma::Allocator            *basicAllocator = 0);
+    Pool(int                          blockSize,
+         int                          blockAlignment,
+         bsls::BlockGrowth::Strategy  growthStrategy,
+         int                          maxBlocksPerChunk,
+         bslma::Allocator            *basicAllocator = 0);
+        // Create a memory pool that returns blocks of contiguous memory of the
+        // specified 'blockSize' (in bytes), each aligned to the specified
+        // 'blockAlignment', for each 'allocate' method invocation, using the
+        // specified 'growthStrategy' to control the growth of internal memory
+        // chunks.  Optionally specify 'maxBlocksPerChunk' as the maximum
+        // chunk size (see above).  If 'maxBlocksPerChunk' is not specified,
+        // an implementation-defined value is used.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '1 <= blockSize', 'blockAlignment' is a positive,
+        // integral power of 2, and '1 <= maxBlocksPerChunk'.  Note that
+        // 'blockAlignment' may exceed
+        // 'bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT'.
+
     ~Pool();
         // Destroy this pool, releasing all associated memory back to the
         // underlying allocator.
@@ -383,7 +502,8 @@ class Pool {
     // MANIPULATORS
     void *allocate();
         // Return the address of a contiguous block of maximally-aligned memory
-        // having the fixed block size specified at construction.
+        // having the fixed block size specified at construction, aligned to
+        // the block alignment specified at construction (if any).
 
     void deallocate(void *address);
         // Relinquish the memory block at the specified 'address' back to this
@@ -418,11 +538,34 @@ class Pool {
         // least the specified 'numBlocks' before the pool replenishes.  The
         // behavior is undefined unless '0 <= numBlocks'.
 
+    void setReclaimThreshold(int numFreeBlocks);
+        // Set the reclamation threshold of this pool to the specified
+        // 'numFreeBlocks'.  If 'numFreeBlocks' is 'k_NO_RECLAIM', chunks
+        // subsequently obtained by this pool are not tracked for reclamation;
+        // otherwise they are, and, if '0 < numFreeBlocks', 'shrink' is
+        // invoked automatically once more than 'numFreeBlocks' blocks are free
+        // (see "Chunk Reclamation" in the component-level documentation).  The
+        // behavior is undefined unless 'k_NO_RECLAIM <= numFreeBlocks'.  Note
+        // that chunks tracked before a call to this method remain
+        // reclaimable.
+
+    int shrink();
+        // Return to the underlying allocator each chunk, obtained while
+        // reclamation was enabled, none of whose blocks is outstanding, and
+        // return the number of chunks so reclaimed.  Note that this method
+        // does not allocate memory, and that the remaining free blocks are
+        // subsequently dispensed in increasing address order.
+
     // ACCESSORS
     int blockSize() const;
         // Return the size (in bytes) of the memory blocks allocated from this
         // pool object.  Note that all blocks dispensed by this pool have the
         // same size.
+
+    int reclaimThreshold() const;
+        // Return the reclamation threshold of this pool: 'k_NO_RECLAIM' (the
+        // default), 'k_RECLAIM_ON_DEMAND', or the number of free blocks above
+        // which 'shrink' is invoked automatically.
 };
 
 }  // close package namespace
@@ -512,6 +655,13 @@ void *Pool::allocate()
 
     Link *p      = d_freeList_p;
     d_freeList_p = p->d_next_p;
+    --d_numFreeBlocks;
+
+    // The next call reads the new head of the free list (which, once
+    // recycled, may be anywhere in memory) and its caller writes it: fetch it
+    // now.  Note that prefetching a null address has no effect.
+
+    bsls::PerformanceHint::prefetchForWriting(d_freeList_p);
     return p;
 }
 
@@ -522,6 +672,12 @@ void Pool::deallocate(void *address)
 
     static_cast<Link *>(address)->d_next_p = d_freeList_p;
     d_freeList_p = static_cast<Link *>(address);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                       ++d_numFreeBlocks > d_shrinkTrigger)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        shrink();
+    }
 }
 
 template <class TYPE>
@@ -542,7 +698,12 @@ inline
 void Pool::release()
 {
     d_blockList.release();
-    d_freeList_p = 0;
+    d_chunkList.release();
+    d_chunks_p      = 0;
+    d_freeList_p    = 0;
+    d_numFreeBlocks = 0;
+    d_numBlocks     = 0;
+    d_shrinkTrigger = 0 < d_reclaimThreshold ? d_reclaimThreshold : INT_MAX;
 }
 
 // ACCESSORS
@@ -552,6 +713,12 @@ int Pool::blockSize() const
     return d_blockSize;
 }
 
+inline
+int Pool::reclaimThreshold() const
+{
+    return d_reclaimThreshold;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
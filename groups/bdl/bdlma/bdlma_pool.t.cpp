@@ -14,6 +14,7 @@
 #include <bsls_asserttest.h>
 #include <bsls_blockgrowth.h>
 
+#include <bsl_algorithm.h>
 #include <bsl_cstdio.h>
 #include <bsl_cstdlib.h>
 #include <bsl_cstring.h>
@@ -55,6 +56,8 @@ using namespace bsl;
 // [ 4] Pool(bs, basicAllocator = 0);
 // [ 4] Pool(bs, gs, basicAllocator = 0);
 // [ 3] Pool(bs, gs, mbpc, basicAllocator = 0);
+// [12] Pool(bs, ba, gs, basicAllocator = 0);
+// [12] Pool(bs, ba, gs, mbpc, basicAllocator = 0);
 // [ 6] ~Pool();
 // [ 4] void *allocate();
 // [ 5] void deallocate(address);
@@ -62,11 +65,14 @@ using namespace bsl;
 // [10] template <class TYPE> void deleteObjectRaw(const TYPE *object);
 // [ 6] void release();
 // [11] void reserveCapacity(numBlocks);
+// [13] void setReclaimThreshold(int numFreeBlocks);
+// [13] int shrink();
 // [ 2] int blockSize() const;
+// [13] int reclaimThreshold() const;
 // [ 7] void *operator new(bsl::size_t size, bdlma::Pool& pool);
 // [ 8] void operator delete(void *address, bdlma::Pool& pool);
 //-----------------------------------------------------------------------------
-// [12] USAGE EXAMPLE
+// [14] USAGE EXAMPLE
 // [ 2] 'allocate' returns memory of the correct block size.
 // [ 1] int blockSize(numBytes);
 // [ 1] int poolBlockSize(size);
@@ -496,7 +502,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 12: {
+      case 14: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -552,6 +558,434 @@ int main(int argc, char *argv[])
         }
 
       } break;
+      case 13: {
+        // --------------------------------------------------------------------
+        // TESTING CHUNK RECLAMATION
+        //
+        // Concerns:
+        //: 1 By default, chunks are not reclaimed, and 'shrink' has no
+        //:   effect.
+        //:
+        //: 2 Once reclamation is enabled, 'shrink' returns exactly those
+        //:   chunks none of whose blocks is outstanding, and reports their
+        //:   number.
+        //:
+        //: 3 Outstanding blocks are unaffected by 'shrink', and the free
+        //:   blocks that remain are still dispensed (in increasing address
+        //:   order).
+        //:
+        //: 4 Chunks obtained before reclamation was enabled are not reclaimed.
+        //:
+        //: 5 With a positive threshold, 'deallocate' shrinks the pool
+        //:   automatically once the number of free blocks exceeds it, and
+        //:   keeps doing so however the blocks are deallocated: once every
+        //:   block is free, every chunk has been reclaimed.
+        //:
+        //: 6 Reclamation works for over-aligned blocks, and 'release' and the
+        //:   destructor return all memory.
+        //:
+        //: 7 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Using a pool with constant growth, supplied with a test
+        //:   allocator, allocate several chunks' worth of blocks, deallocate
+        //:   all but one block per chunk for some chunks and all blocks for
+        //:   the others, and verify the result of 'shrink' and the number of
+        //:   blocks in use by the test allocator.  Repeat without enabling
+        //:   reclamation, and after allocating chunks before enabling it.
+        //:   (C-1..4)
+        //:
+        //: 2 Set a positive threshold, and verify that the footprint drops as
+        //:   blocks are deallocated, without explicit calls to 'shrink'.
+        //:   Then, allocate 10,000 blocks from a pool having a threshold of
+        //:   100, deallocate them in a pseudo-random order, and verify that
+        //:   no memory remains in use.  Repeat, to verify that reclamation
+        //:   resumes for newly obtained chunks.  (C-5)
+        //:
+        //: 3 Repeat P-1 for a pool with a block alignment of 64, and verify
+        //:   that no memory is in use after 'release'.  (C-6)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-7)
+        //
+        // Testing:
+        //   void setReclaimThreshold(int numFreeBlocks);
+        //   int shrink();
+        //   int reclaimThreshold() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING CHUNK RECLAMATION"
+                          << endl << "=========================" << endl;
+
+        const Strategy CON = bsls::BlockGrowth::BSLS_CONSTANT;
+
+        enum { CHUNK = 8, NUM_CHUNKS = 6, NUM_BLOCKS = CHUNK * NUM_CHUNKS };
+
+        static const int ALIGNMENTS[] = { 0, 64 };
+        const int NUM_ALIGNMENTS = sizeof ALIGNMENTS / sizeof *ALIGNMENTS;
+
+        if (verbose) cout << "\nTesting 'shrink'." << endl;
+
+        for (int ti = 0; ti < NUM_ALIGNMENTS; ++ti) {
+            const int ALIGNMENT = ALIGNMENTS[ti];
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj        mX(24, ALIGNMENT ? ALIGNMENT : 8, CON, CHUNK, &ta);
+            const Obj& X = mX;
+
+            ASSERTV(ALIGNMENT, Obj::k_NO_RECLAIM == X.reclaimThreshold());
+            ASSERTV(ALIGNMENT, 0 == mX.shrink());
+
+            mX.setReclaimThreshold(Obj::k_RECLAIM_ON_DEMAND);
+            ASSERTV(ALIGNMENT,
+                    Obj::k_RECLAIM_ON_DEMAND == X.reclaimThreshold());
+
+            // Chunks are dispensed in full before the next one is obtained,
+            // so 'blocks[i]' lies in chunk 'i / CHUNK'.
+
+            char *blocks[NUM_BLOCKS];
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks[i] = static_cast<char *>(mX.allocate());
+                memset(blocks[i], i, 24);
+            }
+            ASSERTV(ALIGNMENT, NUM_CHUNKS == ta.numBlocksInUse());
+            ASSERTV(ALIGNMENT, 0 == mX.shrink());
+
+            // Free chunks 0, 2, and 4 entirely, and all but the last block of
+            // chunks 1, 3, and 5.
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                if ((i / CHUNK) % 2 == 0 || i % CHUNK != CHUNK - 1) {
+                    mX.deallocate(blocks[i]);
+                    blocks[i] = 0;
+                }
+            }
+            ASSERTV(ALIGNMENT, NUM_CHUNKS == ta.numBlocksInUse());
+
+            ASSERTV(ALIGNMENT, NUM_CHUNKS / 2 == mX.shrink());
+            ASSERTV(ALIGNMENT, NUM_CHUNKS / 2 == ta.numBlocksInUse());
+            ASSERTV(ALIGNMENT, 0 == mX.shrink());
+
+            // The outstanding blocks are intact.
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                if (blocks[i]) {
+                    for (int j = 0; j < 24; ++j) {
+                        ASSERTV(ALIGNMENT, i, j,
+                                static_cast<char>(i) == blocks[i][j]);
+                    }
+                }
+            }
+
+            // The remaining free blocks are dispensed in address order,
+            // before a new chunk is obtained.
+
+            const int NUM_FREE = NUM_CHUNKS / 2 * (CHUNK - 1);
+            char     *prev     = 0;
+            for (int i = 0; i < NUM_FREE; ++i) {
+                char *p = static_cast<char *>(mX.allocate());
+                ASSERTV(ALIGNMENT, i, prev < p);
+                if (ALIGNMENT) {
+                    ASSERTV(ALIGNMENT, i, 0 ==
+                            bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                                   p,
+                                                                   ALIGNMENT));
+                }
+                prev = p;
+            }
+            ASSERTV(ALIGNMENT, NUM_CHUNKS / 2 == ta.numBlocksInUse());
+
+            mX.allocate();
+            ASSERTV(ALIGNMENT, NUM_CHUNKS / 2 + 1 == ta.numBlocksInUse());
+
+            mX.release();
+            ASSERTV(ALIGNMENT, 0 == ta.numBlocksInUse());
+            ASSERTV(ALIGNMENT, 0 == mX.shrink());
+        }
+
+        if (verbose) cout << "\nTesting without reclamation." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj mX(24, CON, CHUNK, &ta);
+
+            void *blocks[NUM_BLOCKS];
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks[i] = mX.allocate();
+            }
+
+            // Chunks obtained before reclamation is enabled are untracked.
+
+            mX.setReclaimThreshold(Obj::k_RECLAIM_ON_DEMAND);
+
+            void *more[CHUNK];
+            for (int i = 0; i < CHUNK; ++i) {
+                more[i] = mX.allocate();
+            }
+            ASSERT(NUM_CHUNKS + 1 == ta.numBlocksInUse());
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+            ASSERT(0 == mX.shrink());
+            ASSERT(NUM_CHUNKS + 1 == ta.numBlocksInUse());
+
+            for (int i = 0; i < CHUNK; ++i) {
+                mX.deallocate(more[i]);
+            }
+            ASSERT(1 == mX.shrink());
+            ASSERT(NUM_CHUNKS == ta.numBlocksInUse());
+
+            // The blocks of the untracked chunks remain available.
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                mX.allocate();
+            }
+            ASSERT(NUM_CHUNKS == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nTesting automatic reclamation." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj        mX(24, CON, CHUNK, &ta);
+            const Obj& X = mX;
+
+            mX.setReclaimThreshold(CHUNK);
+            ASSERT(CHUNK == X.reclaimThreshold());
+
+            void *blocks[NUM_BLOCKS];
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks[i] = mX.allocate();
+            }
+            ASSERT(NUM_CHUNKS == ta.numBlocksInUse());
+
+            // Deallocating the first two chunks leaves 'CHUNK + 1' blocks
+            // free at the first deallocation of the second chunk, triggering
+            // the reclamation of the first chunk.
+
+            for (int i = 0; i < 2 * CHUNK; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+            ASSERTV(ta.numBlocksInUse(),
+                    NUM_CHUNKS - 1 == ta.numBlocksInUse());
+
+            for (int i = 2 * CHUNK; i < NUM_BLOCKS; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+            ASSERTV(ta.numBlocksInUse(), NUM_CHUNKS > ta.numBlocksInUse());
+
+            mX.shrink();
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+        {
+            // A pool whose blocks cannot be reclaimed does not shrink on
+            // every deallocation.
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj mX(24, CON, CHUNK, &ta);
+
+            mX.setReclaimThreshold(1);
+
+            void *blocks[NUM_BLOCKS];
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks[i] = mX.allocate();
+            }
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                if (i % CHUNK) {
+                    mX.deallocate(blocks[i]);
+                }
+            }
+            ASSERT(NUM_CHUNKS == ta.numBlocksInUse());
+
+            mX.setReclaimThreshold(Obj::k_NO_RECLAIM);
+            ASSERT(Obj::k_NO_RECLAIM == mX.reclaimThreshold());
+
+            for (int i = 0; i < NUM_BLOCKS; i += CHUNK) {
+                mX.deallocate(blocks[i]);
+            }
+            ASSERT(NUM_CHUNKS == ta.numBlocksInUse());
+
+            // Chunks tracked before reclamation was disabled can still be
+            // reclaimed on demand.
+
+            ASSERT(NUM_CHUNKS == mX.shrink());
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+        {
+            // Deallocating in a random order leaves each chunk with a block
+            // outstanding until late, so that the early automatic calls
+            // reclaim little; the pool must nevertheless be empty at the end.
+
+            enum { NUM_RANDOM_BLOCKS = 10000 };
+
+            static void *blocks[NUM_RANDOM_BLOCKS];
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj mX(64, &ta);
+
+            mX.setReclaimThreshold(100);
+
+            unsigned int seed = 12345;
+
+            for (int round = 0; round < 2; ++round) {
+                for (int i = 0; i < NUM_RANDOM_BLOCKS; ++i) {
+                    blocks[i] = mX.allocate();
+                }
+                ASSERTV(round, 0 < ta.numBlocksInUse());
+
+                for (int i = NUM_RANDOM_BLOCKS - 1; 0 < i; --i) {
+                    seed = seed * 1103515245 + 12345;
+                    const int j = static_cast<int>((seed >> 8) % (i + 1));
+                    bsl::swap(blocks[i], blocks[j]);
+                }
+
+                for (int i = 0; i < NUM_RANDOM_BLOCKS; ++i) {
+                    mX.deallocate(blocks[i]);
+                }
+                ASSERTV(round, ta.numBlocksInUse(),
+                        0 == ta.numBlocksInUse());
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj mX(8, &ta);
+
+            ASSERT_PASS(mX.setReclaimThreshold(Obj::k_NO_RECLAIM));
+            ASSERT_PASS(mX.setReclaimThreshold(Obj::k_RECLAIM_ON_DEMAND));
+            ASSERT_PASS(mX.setReclaimThreshold(100));
+            ASSERT_FAIL(mX.setReclaimThreshold(-2));
+        }
+      } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // TESTING BLOCK ALIGNMENT
+        //
+        // Concerns:
+        //: 1 Every block dispensed by a pool constructed with a block
+        //:   alignment is aligned to it, including alignments exceeding the
+        //:   maximal alignment of the platform.
+        //:
+        //: 2 Blocks are padded so that they do not overlap, and the block
+        //:   size reported by the pool is the requested one.
+        //:
+        //: 3 Deallocated blocks are reused, and all memory is returned to the
+        //:   underlying allocator on destruction.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For a set of block sizes and alignments (up to 4096), and for
+        //:   both growth strategies, allocate a number of blocks from a pool
+        //:   supplied with a test allocator, verify their alignment, and
+        //:   scribble over each of them in full.  Verify that a deallocated
+        //:   block is reused, and that no memory is in use after the pool is
+        //:   destroyed.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   Pool(bs, ba, gs, basicAllocator = 0);
+        //   Pool(bs, ba, gs, mbpc, basicAllocator = 0);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING BLOCK ALIGNMENT"
+                          << endl << "=======================" << endl;
+
+        typedef bsls::BlockGrowth::Strategy Strategy;
+
+        const Strategy GEO = bsls::BlockGrowth::BSLS_GEOMETRIC;
+        const Strategy CON = bsls::BlockGrowth::BSLS_CONSTANT;
+
+        static const int SIZES[]      = { 1, 8, 24, 64, 100 };
+        static const int ALIGNMENTS[] = { 1, 8, 16, 32, 64, 256, 4096 };
+
+        const int NUM_SIZES      = sizeof SIZES / sizeof *SIZES;
+        const int NUM_ALIGNMENTS = sizeof ALIGNMENTS / sizeof *ALIGNMENTS;
+
+        enum { NUM_BLOCKS = 20 };
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            const int SIZE = SIZES[ti];
+
+            for (int tj = 0; tj < NUM_ALIGNMENTS; ++tj) {
+                const int ALIGNMENT = ALIGNMENTS[tj];
+
+                for (int tk = 0; tk < 2; ++tk) {
+                    const Strategy STRATEGY = tk ? GEO : CON;
+
+                    bslma::TestAllocator ta(veryVeryVerbose);
+                    {
+                        Obj        mX(SIZE, ALIGNMENT, STRATEGY, 4, &ta);
+                        const Obj& X = mX;
+
+                        ASSERTV(SIZE, ALIGNMENT, SIZE == X.blockSize());
+
+                        char *blocks[NUM_BLOCKS];
+
+                        for (int i = 0; i < NUM_BLOCKS; ++i) {
+                            blocks[i] = static_cast<char *>(mX.allocate());
+
+                            ASSERTV(SIZE, ALIGNMENT, i, 0 ==
+                                bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                                 blocks[i],
+                                                                 ALIGNMENT));
+                            memset(blocks[i], i, SIZE);
+                        }
+                        for (int i = 0; i < NUM_BLOCKS; ++i) {
+                            for (int j = 0; j < SIZE; ++j) {
+                                ASSERTV(SIZE, ALIGNMENT, i, j,
+                                        static_cast<char>(i) == blocks[i][j]);
+                            }
+                        }
+
+                        mX.deallocate(blocks[NUM_BLOCKS / 2]);
+                        ASSERTV(SIZE, ALIGNMENT,
+                                blocks[NUM_BLOCKS / 2] == mX.allocate());
+                    }
+                    ASSERTV(SIZE, ALIGNMENT, 0 == ta.numBlocksInUse());
+                }
+            }
+        }
+
+        if (verbose) cout << "\nTesting the constructor without 'mbpc'."
+                          << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj mX(100, 64, GEO, &ta);
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                void *p = mX.allocate();
+                ASSERTV(i, 0 ==
+                        bsls::AlignmentUtil::calculateAlignmentOffset(p, 64));
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            ASSERT_PASS(Obj(8, 64, GEO, &ta));
+            ASSERT_FAIL(Obj(0, 64, GEO, &ta));
+            ASSERT_FAIL(Obj(8,  0, GEO, &ta));
+            ASSERT_FAIL(Obj(8, 48, GEO, &ta));
+            ASSERT_FAIL(Obj(8, 64, GEO, 0, &ta));
+        }
+      } break;
       case 11: {
         // --------------------------------------------------------------------
         // RESERVECAPACITY TEST
@@ -0,0 +1,839 @@
+// bdlma_samplingguardingallocator.cpp                                -*-C++-*-
+#include <bdlma_samplingguardingallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_samplingguardingallocator_cpp,"$Id$ $CSID$")
+
+#include <bslma_default.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_atomicoperations.h>
+#include <bsls_bslexceptionutil.h>
+#include <bsls_exceptionutil.h>
+#include <bsls_performancehint.h>
+#include <bsls_platform.h>
+
+#include <bsl_cstring.h>             // 'bsl::memset'
+#include <bsl_ostream.h>
+
+#include <stdarg.h>                  // 'va_list', 'va_start', 'va_end'
+#include <stdio.h>                   // 'vsnprintf', 'fwrite'
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+#include <windows.h>   // 'CaptureStackBackTrace', 'GetSystemInfo',
+                       // 'VirtualAlloc', 'VirtualFree', 'VirtualProtect'
+#else
+
+#include <signal.h>    // 'sigaction'
+#include <sys/mman.h>  // 'mmap', 'mprotect', 'munmap'
+#include <unistd.h>    // 'sysconf', 'write'
+
+#endif
+
+#if defined(BSLS_PLATFORM_OS_LINUX) || defined(BSLS_PLATFORM_OS_DARWIN)
+
+#include <execinfo.h>  // 'backtrace'
+
+#endif
+
+namespace BloombergLP {
+
+namespace {
+
+// LOCAL CONSTANTS
+const unsigned char k_PATTERN = 0xA5;  // fills the unused bytes of a slot
+
+enum {
+    k_REPORT_SIZE = 4096,  // size of the buffer holding a fault report
+
+    k_MAX_ALLOCATORS = 64  // maximum number of allocators whose faults are
+                           // reported by the fault handler
+};
+
+enum SlotState {
+    // Enumerate the states of a guarded slot.
+
+    e_UNUSED,  // the slot has never held a block
+    e_IN_USE,  // the slot holds an outstanding block
+    e_FREED    // the slot holds a deallocated block
+};
+
+// HELPER FUNCTIONS
+int getSystemPageSize()
+    // Return the size (in bytes) of a system memory page.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<int>(info.dwPageSize);                         // RETURN
+#else
+    return static_cast<int>(sysconf(_SC_PAGESIZE));                   // RETURN
+#endif
+}
+
+char *systemReserve(bsl::size_t size)
+    // Return the address of a page-aligned region of memory of the specified
+    // 'size' (in bytes) that is read/write protected, or 0 if the region
+    // cannot be allocated.  The behavior is undefined unless '0 < size'.
+{
+    BSLS_ASSERT(0 < size);
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    return static_cast<char *>(VirtualAlloc(0,
+                                            size,
+                                            MEM_COMMIT | MEM_RESERVE,
+                                            PAGE_NOACCESS));          // RETURN
+
+#else
+
+    void *address = mmap(0, size, PROT_NONE, MAP_ANON | MAP_PRIVATE, -1, 0);
+
+    return MAP_FAILED == address ? 0 : static_cast<char *>(address);
+                                                                      // RETURN
+
+#endif
+}
+
+void systemRelease(char *address, bsl::size_t size)
+    // Return the region of memory of the specified 'size' (in bytes) at the
+    // specified 'address' to the system.  The behavior is undefined unless
+    // 'address' and 'size' describe a region returned by 'systemReserve'.
+{
+    BSLS_ASSERT(address);
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    VirtualFree(address, 0, MEM_RELEASE);
+    (void)size;
+
+#else
+
+    munmap(address, size);
+
+#endif
+}
+
+int systemSetAccess(char *address, int pageSize, bool accessible)
+    // Make the page of memory at the specified 'address', having the
+    // specified 'pageSize' (in bytes), readable and writable if the specified
+    // 'accessible' is 'true', and read/write protected otherwise.  Return 0 on
+    // success, and a non-zero value otherwise.
+{
+    BSLS_ASSERT(address);
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    DWORD oldProtect;
+
+    return !VirtualProtect(address,
+                           pageSize,
+                           accessible ? PAGE_READWRITE : PAGE_NOACCESS,
+                           &oldProtect);                              // RETURN
+
+#else
+
+    return mprotect(address,
+                    pageSize,
+                    accessible ? PROT_READ | PROT_WRITE : PROT_NONE);
+                                                                      // RETURN
+
+#endif
+}
+
+int captureStack(void **frames, int maxFrames)
+    // Load into the specified 'frames' the return addresses of (at most) the
+    // specified 'maxFrames' innermost frames of the calling thread's stack,
+    // and return the number of addresses loaded.
+{
+#if defined(BSLS_PLATFORM_OS_LINUX) || defined(BSLS_PLATFORM_OS_DARWIN)
+
+    return backtrace(frames, maxFrames);                              // RETURN
+
+#elif defined(BSLS_PLATFORM_OS_WINDOWS)
+
+    return CaptureStackBackTrace(0, maxFrames, frames, 0);            // RETURN
+
+#else
+
+    (void)frames;
+    (void)maxFrames;
+    return 0;                                                         // RETURN
+
+#endif
+}
+
+void writeToStderr(const char *buffer, int length)
+    // Write the specified 'length' characters of the specified 'buffer' to
+    // the standard error stream, without allocating memory.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    fwrite(buffer, 1, length, stderr);
+    fflush(stderr);
+
+#else
+
+    while (0 < length) {
+        const ssize_t rc = ::write(STDERR_FILENO, buffer, length);
+        if (rc <= 0) {
+            break;
+        }
+        buffer += rc;
+        length -= static_cast<int>(rc);
+    }
+
+#endif
+}
+
+int appendFormat(char *buffer, int bufferSize, int length, const char *format,
+                 ...)
+    // Append to the null-terminated string of the specified 'length' held in
+    // the specified 'buffer' of the specified 'bufferSize' the text resulting
+    // from the specified 'format' and subsequent arguments (as if by
+    // 'printf'), truncating it if necessary, and return the new length.  The
+    // behavior is undefined unless '0 <= length < bufferSize'.
+{
+    BSLS_ASSERT(0 <= length);
+    BSLS_ASSERT(length < bufferSize);
+
+    va_list args;
+    va_start(args, format);
+    const int rc = vsnprintf(buffer + length,
+                             bufferSize - length,
+                             format,
+                             args);
+    va_end(args);
+
+    if (rc < 0 || length + rc >= bufferSize) {
+        return bufferSize - 1;                                        // RETURN
+    }
+    return length + rc;
+}
+
+}  // close unnamed namespace
+
+namespace bdlma {
+
+                   // --------------------------------------
+                   // struct SamplingGuardingAllocator::Slot
+                   // --------------------------------------
+
+struct SamplingGuardingAllocator::Slot {
+    // This 'struct' holds the state of a guarded slot, and the call stacks of
+    // the most recent allocation of its block and (if any) deallocation.
+
+    char        *d_block_p;         // address of the block (0 if unused)
+
+    bsl::size_t  d_size;            // size (in bytes) of the block
+
+    int          d_state;           // a 'SlotState'
+
+    int          d_numAllocFrames;  // number of frames in 'd_allocFrames'
+
+    int          d_numFreeFrames;   // number of frames in 'd_freeFrames'
+
+    void        *d_allocFrames[k_MAX_STACK_FRAMES];
+                                    // call stack of the allocation
+
+    void        *d_freeFrames[k_MAX_STACK_FRAMES];
+                                    // call stack of the deallocation
+};
+
+                 // -----------------------------------------
+                 // struct SamplingGuardingAllocator_Registry
+                 // -----------------------------------------
+
+struct SamplingGuardingAllocator_Registry {
+    // This component-private 'struct' provides a namespace for the registry
+    // of live allocators consulted by the fault handler.  The registry is a
+    // fixed array of atomic pointers, so that it can be read from a signal
+    // handler.
+
+    // CLASS DATA
+    static bsls::AtomicOperations::AtomicTypes::Pointer
+                                         s_allocators[k_MAX_ALLOCATORS];
+        // registered allocators (0 for an empty entry)
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+    static bsls::AtomicOperations::AtomicTypes::Int s_isInstalled;
+        // 1 once the fault handler is installed
+
+    static struct sigaction s_previousSegv;
+        // action for 'SIGSEGV' prior to installing the fault handler
+
+    static struct sigaction s_previousBus;
+        // action for 'SIGBUS' prior to installing the fault handler
+#endif
+
+    // CLASS METHODS
+    static void add(const SamplingGuardingAllocator *allocator);
+        // Register the specified 'allocator'.  If the registry is full, the
+        // faults of 'allocator' are not reported by the fault handler.
+
+    static void remove(const SamplingGuardingAllocator *allocator);
+        // Unregister the specified 'allocator', if registered.
+
+    static void report(const void *address);
+        // Write to 'stderr' a report of a fault at the specified 'address'
+        // if it lies within the slots of a registered allocator.
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+    static void restore(int signal);
+        // Restore the action for the specified 'signal' prior to the
+        // installation of the fault handler.
+#endif
+};
+
+bsls::AtomicOperations::AtomicTypes::Pointer
+          SamplingGuardingAllocator_Registry::s_allocators[k_MAX_ALLOCATORS];
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+bsls::AtomicOperations::AtomicTypes::Int
+                             SamplingGuardingAllocator_Registry::s_isInstalled;
+
+struct sigaction SamplingGuardingAllocator_Registry::s_previousSegv;
+struct sigaction SamplingGuardingAllocator_Registry::s_previousBus;
+#endif
+
+void SamplingGuardingAllocator_Registry::add(
+                                  const SamplingGuardingAllocator *allocator)
+{
+    for (int i = 0; i < k_MAX_ALLOCATORS; ++i) {
+        if (0 == bsls::AtomicOperations::testAndSwapPtr(
+                                  &s_allocators[i],
+                                  0,
+                                  const_cast<SamplingGuardingAllocator *>(
+                                                               allocator))) {
+            return;                                                   // RETURN
+        }
+    }
+}
+
+void SamplingGuardingAllocator_Registry::remove(
+                                  const SamplingGuardingAllocator *allocator)
+{
+    for (int i = 0; i < k_MAX_ALLOCATORS; ++i) {
+        if (allocator == bsls::AtomicOperations::testAndSwapPtr(
+                                   &s_allocators[i],
+                                   const_cast<SamplingGuardingAllocator *>(
+                                                                  allocator),
+                                   0)) {
+            return;                                                   // RETURN
+        }
+    }
+}
+
+void SamplingGuardingAllocator_Registry::report(const void *address)
+{
+    for (int i = 0; i < k_MAX_ALLOCATORS; ++i) {
+        const SamplingGuardingAllocator *allocator =
+                         static_cast<const SamplingGuardingAllocator *>(
+                           bsls::AtomicOperations::getPtrAcquire(
+                                                          &s_allocators[i]));
+
+        if (allocator && allocator->isGuarded(address)) {
+            char      buffer[k_REPORT_SIZE];
+            const int length = allocator->formatFault(buffer,
+                                                      sizeof buffer,
+                                                      0,
+                                                      address);
+            writeToStderr(buffer, length);
+            return;                                                   // RETURN
+        }
+    }
+}
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+void SamplingGuardingAllocator_Registry::restore(int signal)
+{
+    sigaction(signal,
+              SIGSEGV == signal ? &s_previousSegv : &s_previousBus,
+              0);
+}
+#endif
+
+}  // close package namespace
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+extern "C"
+void bdlma_SamplingGuardingAllocator_handleFault(int        signal,
+                                                 siginfo_t *info,
+                                                 void      *)
+    // Report the fault described by the specified 'info', then restore the
+    // previous action for the specified 'signal'.  Upon return, the faulting
+    // instruction is executed again, invoking the previous action.
+{
+    bdlma::SamplingGuardingAllocator_Registry::report(info->si_addr);
+    bdlma::SamplingGuardingAllocator_Registry::restore(signal);
+}
+#endif
+
+namespace bdlma {
+
+                      // -------------------------------
+                      // class SamplingGuardingAllocator
+                      // -------------------------------
+
+// PRIVATE MANIPULATORS
+void *SamplingGuardingAllocator::allocateGuarded(size_type size)
+{
+    BSLS_ASSERT(1 <= size);
+    BSLS_ASSERT(size <= static_cast<size_type>(d_pageSize));
+
+    int index;
+    {
+        bsls::BslLockGuard guard(&d_lock);
+
+        if (0 == d_numFree) {
+            return 0;                                                 // RETURN
+        }
+
+        index      = d_freeSlots_p[d_freeHead];
+        d_freeHead = (d_freeHead + 1) % d_numSlots;
+        --d_numFree;
+    }
+
+    Slot& slot = d_slots_p[index];
+    char *page = d_region_p + (2 * index + 1) * d_pageSize;
+
+    if (0 != systemSetAccess(page, d_pageSize, true)) {
+        bsls::BslLockGuard guard(&d_lock);
+
+        d_freeSlots_p[(d_freeHead + d_numFree) % d_numSlots] = index;
+        ++d_numFree;
+        return 0;                                                     // RETURN
+    }
+
+    // Place the block as close to the end of the page as its natural
+    // alignment allows, and fill the remainder of the page with the pattern.
+
+    const int alignment = bsls::AlignmentUtil::calculateAlignmentFromSize(
+                                                                         size);
+    char *block = page + ((d_pageSize - size) & ~(alignment - 1));
+
+    bsl::memset(page, k_PATTERN, block - page);
+    bsl::memset(block + size, k_PATTERN, page + d_pageSize - (block + size));
+
+    slot.d_block_p        = block;
+    slot.d_size           = size;
+    slot.d_numAllocFrames = captureStack(slot.d_allocFrames,
+                                         k_MAX_STACK_FRAMES);
+    slot.d_numFreeFrames  = 0;
+    slot.d_state          = e_IN_USE;
+
+    d_numGuarded.addRelaxed(1);
+
+    return block;
+}
+
+void SamplingGuardingAllocator::deallocateGuarded(void *address)
+{
+    BSLS_ASSERT(isGuarded(address));
+
+    char *p = static_cast<char *>(address);
+
+    const bsls::Types::IntPtr pageIndex = (p - d_region_p) / d_pageSize;
+
+    if (0 == pageIndex % 2) {
+        reportFault("invalid free of a guard page", address);
+        return;                                                       // RETURN
+    }
+
+    const int  index = static_cast<int>((pageIndex - 1) / 2);
+    Slot&      slot  = d_slots_p[index];
+    char      *page  = d_region_p + pageIndex * d_pageSize;
+    const char *error = 0;
+    {
+        bsls::BslLockGuard guard(&d_lock);
+
+        if (e_FREED == slot.d_state) {
+            error = "double free";
+        }
+        else if (e_IN_USE != slot.d_state || p != slot.d_block_p) {
+            error = "invalid free";
+        }
+        else {
+            slot.d_state = e_FREED;
+        }
+    }
+
+    if (error) {
+        reportFault(error, address);
+        return;                                                       // RETURN
+    }
+
+    // Verify the pattern surrounding the block before protecting the page.
+
+    bool isCorrupted = false;
+    for (const char *q = page; q < page + d_pageSize; ++q) {
+        if (q == slot.d_block_p) {
+            q += slot.d_size - 1;
+            continue;
+        }
+        if (k_PATTERN != static_cast<unsigned char>(*q)) {
+            isCorrupted = true;
+            break;
+        }
+    }
+
+    slot.d_numFreeFrames = captureStack(slot.d_freeFrames,
+                                        k_MAX_STACK_FRAMES);
+
+    const int rc = systemSetAccess(page, d_pageSize, false);
+    (void)rc;
+    BSLS_ASSERT_OPT(0 == rc);
+
+    {
+        bsls::BslLockGuard guard(&d_lock);
+
+        d_freeSlots_p[(d_freeHead + d_numFree) % d_numSlots] = index;
+        ++d_numFree;
+    }
+
+    if (isCorrupted) {
+        reportFault("memory surrounding the block overwritten "
+                    "(buffer overflow or underflow)",
+                    address);
+    }
+}
+
+// PRIVATE ACCESSORS
+int SamplingGuardingAllocator::formatFault(char       *buffer,
+                                           int         bufferSize,
+                                           const char *description,
+                                           const void *address) const
+{
+    BSLS_ASSERT(buffer);
+    BSLS_ASSERT(1 <= bufferSize);
+    BSLS_ASSERT(isGuarded(address));
+
+    const char *p = static_cast<const char *>(address);
+
+    const bsls::Types::IntPtr pageIndex = (p - d_region_p) / d_pageSize;
+
+    // Attribute the address to a slot: the slot itself, or, for a guard page,
+    // the used slot whose block is nearest.
+
+    const Slot *slot = 0;
+    if (1 == pageIndex % 2) {
+        slot = &d_slots_p[(pageIndex - 1) / 2];
+    }
+    else {
+        const bsls::Types::IntPtr left  = pageIndex / 2 - 1;
+        const bsls::Types::IntPtr right = pageIndex / 2;
+
+        const Slot *leftSlot  = 0 <= left
+                                    && e_UNUSED != d_slots_p[left].d_state
+                              ? &d_slots_p[left]
+                              : 0;
+        const Slot *rightSlot = right < d_numSlots
+                                    && e_UNUSED != d_slots_p[right].d_state
+                              ? &d_slots_p[right]
+                              : 0;
+
+        if (leftSlot && rightSlot) {
+            const bsls::Types::IntPtr afterLeft =
+                                  p - (leftSlot->d_block_p + leftSlot->d_size);
+            const bsls::Types::IntPtr beforeRight =
+                                                    rightSlot->d_block_p - p;
+            slot = afterLeft <= beforeRight ? leftSlot : rightSlot;
+        }
+        else {
+            slot = leftSlot ? leftSlot : rightSlot;
+        }
+    }
+
+    if (slot && e_UNUSED == slot->d_state) {
+        slot = 0;
+    }
+
+    if (!description) {
+        if (!slot) {
+            description = "invalid access";
+        }
+        else if (p < slot->d_block_p) {
+            description = "buffer underflow";
+        }
+        else if (p >= slot->d_block_p + slot->d_size) {
+            description = "buffer overflow";
+        }
+        else if (e_FREED == slot->d_state) {
+            description = "use-after-free";
+        }
+        else {
+            description = "invalid access";
+        }
+    }
+
+    int length = 0;
+    buffer[0]  = 0;
+
+    length = appendFormat(buffer,
+                          bufferSize,
+                          length,
+                          "*** bdlma::SamplingGuardingAllocator: %s at %p\n",
+                          description,
+                          address);
+
+    if (!slot) {
+        return length;                                                // RETURN
+    }
+
+    const unsigned long size = static_cast<unsigned long>(slot->d_size);
+
+    if (p < slot->d_block_p) {
+        length = appendFormat(buffer,
+                              bufferSize,
+                              length,
+                              "    %ld bytes before a %lu-byte block at %p\n",
+                              static_cast<long>(slot->d_block_p - p),
+                              size,
+                              static_cast<void *>(slot->d_block_p));
+    }
+    else if (p >= slot->d_block_p + slot->d_size) {
+        length = appendFormat(
+                         buffer,
+                         bufferSize,
+                         length,
+                         "    %ld bytes after the end of a %lu-byte block"
+                         " at %p\n",
+                         static_cast<long>(p - slot->d_block_p - slot->d_size),
+                         size,
+                         static_cast<void *>(slot->d_block_p));
+    }
+    else {
+        length = appendFormat(buffer,
+                              bufferSize,
+                              length,
+                              "    %ld bytes into a %lu-byte block at %p\n",
+                              static_cast<long>(p - slot->d_block_p),
+                              size,
+                              static_cast<void *>(slot->d_block_p));
+    }
+
+    length = appendFormat(buffer, bufferSize, length, "    allocated by:\n");
+    for (int i = 0; i < slot->d_numAllocFrames; ++i) {
+        length = appendFormat(buffer,
+                              bufferSize,
+                              length,
+                              "      #%d %p\n",
+                              i,
+                              slot->d_allocFrames[i]);
+    }
+
+    if (e_FREED == slot->d_state) {
+        length = appendFormat(buffer, bufferSize, length, "    freed by:\n");
+        for (int i = 0; i < slot->d_numFreeFrames; ++i) {
+            length = appendFormat(buffer,
+                                  bufferSize,
+                                  length,
+                                  "      #%d %p\n",
+                                  i,
+                                  slot->d_freeFrames[i]);
+        }
+    }
+
+    return length;
+}
+
+void SamplingGuardingAllocator::reportFault(const char *description,
+                                            const void *address) const
+{
+    char      buffer[k_REPORT_SIZE];
+    const int length = formatFault(buffer,
+                                   sizeof buffer,
+                                   description,
+                                   address);
+
+    writeToStderr(buffer, length);
+
+    bsls::Assert::invokeHandler(description, __FILE__, __LINE__);
+}
+
+// CLASS METHODS
+int SamplingGuardingAllocator::installFaultHandler()
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    return -1;                                                        // RETURN
+
+#else
+
+    typedef SamplingGuardingAllocator_Registry Registry;
+
+    if (0 != bsls::AtomicOperations::testAndSwapInt(&Registry::s_isInstalled,
+                                                    0,
+                                                    1)) {
+        return 0;                                                     // RETURN
+    }
+
+    struct sigaction action;
+    bsl::memset(&action, 0, sizeof action);
+    sigemptyset(&action.sa_mask);
+    action.sa_sigaction = &bdlma_SamplingGuardingAllocator_handleFault;
+    action.sa_flags     = SA_SIGINFO;
+
+    if (0 != sigaction(SIGSEGV, &action, &Registry::s_previousSegv)) {
+        bsls::AtomicOperations::setInt(&Registry::s_isInstalled, 0);
+        return -1;                                                    // RETURN
+    }
+    if (0 != sigaction(SIGBUS, &action, &Registry::s_previousBus)) {
+        Registry::restore(SIGSEGV);
+        bsls::AtomicOperations::setInt(&Registry::s_isInstalled, 0);
+        return -1;                                                    // RETURN
+    }
+
+    return 0;
+
+#endif
+}
+
+// CREATORS
+SamplingGuardingAllocator::SamplingGuardingAllocator(
+                                            int               sampleInterval,
+                                            int               numSlots,
+                                            bslma::Allocator *basicAllocator)
+: d_region_p(0)
+, d_regionSize(0)
+, d_pageSize(getSystemPageSize())
+, d_numSlots(numSlots)
+, d_sampleInterval(sampleInterval)
+, d_countdown(sampleInterval)
+, d_numGuarded(0)
+, d_slots_p(0)
+, d_freeSlots_p(0)
+, d_freeHead(0)
+, d_numFree(numSlots)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= sampleInterval);
+    BSLS_ASSERT(1 <= numSlots);
+
+    d_slots_p = static_cast<Slot *>(
+                             d_allocator_p->allocate(numSlots * sizeof(Slot)));
+    bsl::memset(d_slots_p, 0, numSlots * sizeof(Slot));
+
+    BSLS_TRY {
+        d_freeSlots_p = static_cast<int *>(
+                              d_allocator_p->allocate(numSlots * sizeof(int)));
+    }
+    BSLS_CATCH(...) {
+        d_allocator_p->deallocate(d_slots_p);
+        BSLS_RETHROW;
+    }
+
+    for (int i = 0; i < numSlots; ++i) {
+        d_freeSlots_p[i] = i;
+    }
+
+    d_regionSize = static_cast<bsls::Types::IntPtr>(2 * numSlots + 1)
+                                                                  * d_pageSize;
+    d_region_p   = systemReserve(d_regionSize);
+
+    if (!d_region_p) {
+        d_allocator_p->deallocate(d_freeSlots_p);
+        d_allocator_p->deallocate(d_slots_p);
+        d_regionSize = 0;
+        bsls::BslExceptionUtil::throwBadAlloc();
+    }
+
+    SamplingGuardingAllocator_Registry::add(this);
+}
+
+SamplingGuardingAllocator::~SamplingGuardingAllocator()
+{
+    SamplingGuardingAllocator_Registry::remove(this);
+
+    systemRelease(d_region_p, d_regionSize);
+
+    d_allocator_p->deallocate(d_freeSlots_p);
+    d_allocator_p->deallocate(d_slots_p);
+}
+
+// MANIPULATORS
+void *SamplingGuardingAllocator::allocate(size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    // Concurrent requests may both observe the end of the countdown, in which
+    // case both are sampled; this is harmless.
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                          0 >= d_countdown.addRelaxed(-1))) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        d_countdown.storeRelaxed(d_sampleInterval);
+
+        if (size <= static_cast<size_type>(d_pageSize)) {
+            void *address = allocateGuarded(size);
+            if (address) {
+                return address;                                       // RETURN
+            }
+        }
+    }
+
+    return d_allocator_p->allocate(size);
+}
+
+void SamplingGuardingAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return;                                                       // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(isGuarded(address))) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        deallocateGuarded(address);
+        return;                                                       // RETURN
+    }
+
+    d_allocator_p->deallocate(address);
+}
+
+// ACCESSORS
+int SamplingGuardingAllocator::describeFault(bsl::ostream& stream,
+                                             const void   *address) const
+{
+    if (!isGuarded(address)) {
+        return -1;                                                    // RETURN
+    }
+
+    char buffer[k_REPORT_SIZE];
+    formatFault(buffer, sizeof buffer, 0, address);
+
+    stream << buffer;
+    return 0;
+}
+
+int SamplingGuardingAllocator::numSlotsInUse() const
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    return d_numSlots - d_numFree;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
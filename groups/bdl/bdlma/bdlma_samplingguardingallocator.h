@@ -0,0 +1,422 @@
+// bdlma_samplingguardingallocator.h                                  -*-C++-*-
+#ifndef INCLUDED_BDLMA_SAMPLINGGUARDINGALLOCATOR
+#define INCLUDED_BDLMA_SAMPLINGGUARDINGALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an allocator guarding a sample of its allocations.
+//
+//@CLASSES:
+//  bdlma::SamplingGuardingAllocator: allocator guarding sampled blocks
+//
+//@SEE_ALSO: bdlma_guardingallocator, bslma_allocator
+//
+//@DESCRIPTION: This component provides a concrete allocation mechanism,
+// 'bdlma::SamplingGuardingAllocator', that implements the 'bslma::Allocator'
+// protocol, and that supplies one in every 'sampleInterval' memory blocks
+// (specified at construction) from a small, fixed number of *guarded* *slots*,
+// and every other block from a delegate allocator (also specified at
+// construction).  Unlike 'bdlma::GuardingAllocator', which surrounds *every*
+// block with protected memory, this allocator costs little more than its
+// delegate, and is therefore suitable for detecting rare heap corruptions in
+// production processes:
+//..
+//   ,---------------------------------.
+//  ( bdlma::SamplingGuardingAllocator )
+//   `---------------------------------'
+//                   |        ctor/dtor
+//                   |        describeFault
+//                   |        installFaultHandler
+//                   |        isGuarded
+//                   |        numGuardedAllocations
+//                   |        numSlots
+//                   |        numSlotsInUse
+//                   |        sampleInterval
+//                   V
+//           ,----------------.
+//          ( bslma::Allocator )
+//           `----------------'
+//                            allocate
+//                            deallocate
+//..
+//
+///Guarded Slots
+///-------------
+// At construction, the allocator reserves a single region of virtual memory
+// holding 'numSlots' slots of one memory page each, every slot being
+// surrounded by read/write protected guard pages:
+//..
+//  +-------+--------+-------+--------+-------+-- ... --+--------+-------+
+//  | guard | slot 0 | guard | slot 1 | guard |         | slot N | guard |
+//  +-------+--------+-------+--------+-------+-- ... --+--------+-------+
+//..
+// A sampled request for at most a page of memory is served from a free slot,
+// whose page is made accessible, and the block is placed at the *end* of the
+// page (as far as its natural alignment allows), so that a buffer overrun runs
+// into the following guard page.  The unused bytes at the start of the page
+// are filled with a known pattern, which is verified when the block is
+// deallocated, detecting underruns (and overruns within the alignment
+// padding).  When the block is deallocated, its slot is protected again, so
+// that any later use of the block faults, and the slot goes to the back of the
+// queue of free slots, so that it is reused as late as possible.  If no slot
+// is free, or the request exceeds a page, the request is supplied by the
+// delegate.  Memory supplied by a slot is aligned to the natural alignment of
+// the requested size (see 'bsls_alignmentutil'), which is sufficient for any
+// object of that size.
+//
+// Note that the sample is chosen by counting allocation requests, so, in a
+// workload repeating the same pattern of allocations, every block has the same
+// probability of being guarded over a long enough run.
+//
+///Fault Reports
+///-------------
+// For each slot, the allocator records the call stack of the most recent
+// allocation from, and deallocation to, the slot.  Given the address of an
+// invalid access (e.g., as reported by a debugger, or by the operating system
+// in a signal), 'describeFault' writes a report classifying the access as a
+// use-after-free, a buffer overflow, or a buffer underflow of a guarded block,
+// including both call stacks.
+//
+// On platforms supporting POSIX signals, 'installFaultHandler' installs a
+// handler for 'SIGSEGV' and 'SIGBUS' that writes such a report to 'stderr'
+// when the faulting address lies within the slots of any live
+// 'bdlma::SamplingGuardingAllocator', and then lets the signal take its
+// previous course (typically, terminating the process with a core file).
+// Deallocating a guarded block twice, or deallocating an address within a
+// slot that is not the address of its block, or finding the pattern around a
+// block overwritten when the block is deallocated, is reported to 'stderr' in
+// the same way, after which 'bsls::Assert::invokeHandler' is called.
+//
+// Call stacks are recorded as return addresses, and are symbolized (e.g., by
+// 'addr2line') offline.  Call stacks are not recorded on platforms lacking a
+// facility to obtain them.
+//
+///Thread Safety
+///-------------
+// The 'bdlma::SamplingGuardingAllocator' class is fully thread-safe (see
+// 'bsldoc_glossary'), provided that the delegate allocator is.  Unsampled
+// requests (the vast majority) are passed to the delegate after an atomic
+// decrement of a countdown, and without acquiring a lock.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Catching a Heap Corruption in Production
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a long-running service occasionally crashes in a context far
+// removed from the code corrupting the heap, and only under production load.
+// We install a sampling guarding allocator as the default allocator at the
+// start of 'main', delegating to the allocator that would otherwise have been
+// used.
+//
+// First, we create the allocator, guarding one in every 1000 allocations with
+// 32 slots, and install it as the default allocator:
+//..
+//  bslma::Allocator *delegate = bslma::Default::defaultAllocator();
+//
+//  bdlma::SamplingGuardingAllocator guardingAllocator(1000, 32, delegate);
+//
+//  bslma::Default::setDefaultAllocator(&guardingAllocator);
+//..
+// Then, we install the fault handler, so that a crash caused by a guarded
+// block is reported along with the call stacks of its allocation and
+// deallocation:
+//..
+//  bdlma::SamplingGuardingAllocator::installFaultHandler();
+//..
+// Next, we suppose that a component keeps a pointer to a buffer beyond its
+// lifetime:
+//..
+//  char *data = static_cast<char *>(guardingAllocator.allocate(100));
+//
+//  // ...
+//
+//  guardingAllocator.deallocate(data);
+//..
+// Now, if the memory of 'data' happened to be guarded, any access through
+// 'data' (such as '*data = 'x';') faults, and the process terminates with a
+// report on 'stderr' similar to:
+//..
+//  *** bdlma::SamplingGuardingAllocator: use-after-free at 0x7f3a1c0a4f9c
+//      0 bytes into a 100-byte block at 0x7f3a1c0a4f9c
+//      allocated by:
+//        #0 0x4a6f21
+//        ...
+//      freed by:
+//        #0 0x4a7042
+//        ...
+//..
+// Finally, we can check for a guarded address without faulting:
+//..
+//  if (guardingAllocator.isGuarded(data)) {
+//      guardingAllocator.describeFault(bsl::cerr, data);
+//  }
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLLOCK
+#include <bsls_bsllock.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_IOSFWD
+#include <bsl_iosfwd.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                      // ===============================
+                      // class SamplingGuardingAllocator
+                      // ===============================
+
+class SamplingGuardingAllocator : public bslma::Allocator {
+    // This class defines a concrete thread-safe allocator mechanism that
+    // implements the 'bslma::Allocator' protocol, supplying one in every
+    // 'sampleInterval' memory blocks (specified at construction) from a fixed
+    // number of page-sized slots surrounded by read/write protected guard
+    // pages, and every other block from a delegate allocator.  Deallocated
+    // guarded blocks are protected until their slot is reused, and the call
+    // stacks of the allocation and deallocation of each guarded block are
+    // recorded to report invalid accesses (see 'describeFault').
+
+  public:
+    // TYPES
+    enum {
+        k_MAX_STACK_FRAMES = 16  // maximum number of frames recorded for
+                                 // each call stack
+    };
+
+  private:
+    // PRIVATE TYPES
+    struct Slot;
+        // This 'struct', defined in 'bdlma_samplingguardingallocator.cpp',
+        // holds the state and the recorded call stacks of a slot.
+
+    // DATA
+    char               *d_region_p;        // first page of the region of
+                                           // slots and guard pages
+
+    bsls::Types::IntPtr d_regionSize;      // size (in bytes) of the region
+
+    int                 d_pageSize;        // size (in bytes) of a page
+
+    int                 d_numSlots;        // number of slots
+
+    int                 d_sampleInterval;  // one in 'd_sampleInterval'
+                                           // requests is guarded
+
+    bsls::AtomicInt     d_countdown;       // number of requests until the
+                                           // next sampled request
+
+    bsls::AtomicInt64   d_numGuarded;      // number of guarded allocations
+
+    Slot               *d_slots_p;         // array of 'd_numSlots' slots
+
+    int                *d_freeSlots_p;     // circular queue of the indices
+                                           // of free slots
+
+    int                 d_freeHead;        // index in 'd_freeSlots_p' of
+                                           // the least recently freed slot
+
+    int                 d_numFree;         // number of free slots
+
+    mutable bsls::BslLock
+                        d_lock;            // guards the slots and the queue
+
+    bslma::Allocator   *d_allocator_p;     // delegate allocator (held, not
+                                           // owned)
+
+  private:
+    // PRIVATE MANIPULATORS
+    void *allocateGuarded(size_type size);
+        // Return the address of a block of the specified 'size' (in bytes)
+        // supplied from a free slot, or 0 if no slot is free.  The behavior is
+        // undefined unless '1 <= size <= d_pageSize'.
+
+    void deallocateGuarded(void *address);
+        // Return the guarded block at the specified 'address' to its slot,
+        // reporting a double free, an invalid free, or a corruption of the
+        // memory surrounding the block.  The behavior is undefined unless
+        // 'isGuarded(address)'.
+
+    // PRIVATE ACCESSORS
+    int formatFault(char       *buffer,
+                    int         bufferSize,
+                    const char *description,
+                    const void *address) const;
+        // Write into the specified 'buffer' of the specified 'bufferSize' a
+        // null-terminated report of the fault at the specified 'address',
+        // headed by the specified 'description' (or by a classification of the
+        // access if 'description' is 0), truncated if necessary, and return
+        // the length of the report.  The behavior is undefined unless
+        // 'isGuarded(address)' and '1 <= bufferSize'.  Note that this method
+        // does not allocate memory, and may be called from a signal handler.
+
+    void reportFault(const char *description, const void *address) const;
+        // Write to 'stderr' a report of the fault at the specified 'address',
+        // headed by the specified 'description', and then invoke the
+        // currently installed assertion-failure handler (see 'bsls_assert').
+        // The behavior is undefined unless 'isGuarded(address)'.
+
+    // FRIENDS
+    friend struct SamplingGuardingAllocator_Registry;
+
+  private:
+    // NOT IMPLEMENTED
+    SamplingGuardingAllocator(const SamplingGuardingAllocator&);
+    SamplingGuardingAllocator& operator=(const SamplingGuardingAllocator&);
+
+  public:
+    // CLASS METHODS
+    static int installFaultHandler();
+        // Install a handler for 'SIGSEGV' and 'SIGBUS' that writes a report to
+        // 'stderr' if the faulting address lies within the slots of a live
+        // sampling guarding allocator, and then restores the previously
+        // installed handlers, letting the signal take its previous course.
+        // Return 0 on success, and a non-zero value if the platform does not
+        // support POSIX signals or the handler could not be installed.  Note
+        // that the handler is installed at most once per process, and that
+        // the report is produced on a best-effort basis.
+
+    // CREATORS
+    SamplingGuardingAllocator(int               sampleInterval,
+                              int               numSlots,
+                              bslma::Allocator *basicAllocator = 0);
+        // Create a sampling guarding allocator that supplies one in every
+        // specified 'sampleInterval' memory blocks of at most a page from one
+        // of the specified 'numSlots' guarded slots.  Optionally specify a
+        // 'basicAllocator' to which other requests are delegated, and that
+        // supplies the memory recording the state of the slots.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  If the memory for the slots cannot be reserved, a
+        // 'bsl::bad_alloc' exception is thrown.  The behavior is undefined
+        // unless '1 <= sampleInterval' and '1 <= numSlots'.  Note that a
+        // 'basicAllocator' must be supplied if this object is to be installed
+        // as the default allocator.
+
+    virtual ~SamplingGuardingAllocator();
+        // Destroy this allocator object, returning the memory of its slots to
+        // the system.  The behavior is undefined unless all guarded blocks
+        // allocated from this object have been deallocated.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return a newly-allocated block of memory of (at least) the specified
+        // 'size' (in bytes), supplied from a guarded slot if the request is
+        // sampled, 'size' does not exceed a page, and a slot is free, and from
+        // the delegate allocator otherwise.  If 'size' is 0, no memory is
+        // allocated and 0 is returned.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' back to this
+        // allocator.  If 'address' is 0, this method has no effect.  If
+        // 'address' lies within a guarded slot, the block is protected until
+        // the slot is reused, and a double free, an invalid free, or an
+        // overwrite of the memory surrounding the block is reported (see
+        // "Fault Reports" in the component-level documentation); otherwise,
+        // the block is returned to the delegate allocator.  The behavior is
+        // undefined unless 'address' was allocated from this allocator.
+
+    // ACCESSORS
+    int describeFault(bsl::ostream& stream, const void *address) const;
+        // Write to the specified 'stream' a report classifying an access to
+        // the specified 'address' as a use-after-free, buffer overflow, or
+        // buffer underflow of a guarded block, along with the call stacks of
+        // the allocation and (if any) deallocation of the block.  Return 0 on
+        // success, and a non-zero value (with no effect) if 'address' does not
+        // lie within the slots and guard pages of this allocator.
+
+    bool isGuarded(const void *address) const;
+        // Return 'true' if the specified 'address' lies within the slots and
+        // guard pages of this allocator, and 'false' otherwise.
+
+    bsls::Types::Int64 numGuardedAllocations() const;
+        // Return the number of blocks supplied from guarded slots by this
+        // allocator.
+
+    int numSlots() const;
+        // Return the number of guarded slots of this allocator.
+
+    int numSlotsInUse() const;
+        // Return the number of guarded slots currently holding a block.
+
+    int sampleInterval() const;
+        // Return the sample interval of this allocator: one in every
+        // 'sampleInterval()' requests is served from a guarded slot if
+        // possible.
+};
+
+// ============================================================================
+//                          INLINE DEFINITIONS
+// ============================================================================
+
+                      // -------------------------------
+                      // class SamplingGuardingAllocator
+                      // -------------------------------
+
+// ACCESSORS
+inline
+bool SamplingGuardingAllocator::isGuarded(const void *address) const
+{
+    const char *p = static_cast<const char *>(address);
+
+    return d_region_p <= p && p < d_region_p + d_regionSize;
+}
+
+inline
+bsls::Types::Int64 SamplingGuardingAllocator::numGuardedAllocations() const
+{
+    return d_numGuarded.loadRelaxed();
+}
+
+inline
+int SamplingGuardingAllocator::numSlots() const
+{
+    return d_numSlots;
+}
+
+inline
+int SamplingGuardingAllocator::sampleInterval() const
+{
+    return d_sampleInterval;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
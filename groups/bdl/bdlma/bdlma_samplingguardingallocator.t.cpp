@@ -0,0 +1,894 @@
+// bdlma_samplingguardingallocator.t.cpp                              -*-C++-*-
+#include <bdlma_samplingguardingallocator.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+
+#include <setjmp.h>
+#include <signal.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+  #include <windows.h>        // 'GetSystemInfo'
+#else
+  #include <sys/resource.h>   // 'setrlimit'
+  #include <sys/wait.h>       // 'waitpid'
+  #include <unistd.h>         // 'fork', 'pipe', 'sysconf'
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                TEST PLAN
+// ----------------------------------------------------------------------------
+//                                 Overview
+//                                 --------
+// 'bdlma::SamplingGuardingAllocator' is an allocator mechanism that supplies a
+// sample of its allocations from page-sized slots surrounded by read/write
+// protected guard pages, and all other allocations from a delegate allocator.
+// The primary concerns are that the sample is chosen as documented, that
+// guarded blocks are placed at the end of their slot, that guard pages and
+// deallocated blocks are protected, that each block is returned to the
+// allocator that supplied it, and that faults are reported accurately.
+// 'setjmp' and 'longjmp' are used in conjunction with a signal handler to
+// test that memory is protected, and a child process is used to test the
+// fault handler.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 6] static int installFaultHandler();
+//
+// CREATORS
+// [ 2] SamplingGuardingAllocator(int si, int ns, Allocator *ba = 0);
+// [ 2] ~SamplingGuardingAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 3] void deallocate(void *address);
+//
+// ACCESSORS
+// [ 5] int describeFault(bsl::ostream& stream, const void *address) const;
+// [ 3] bool isGuarded(const void *address) const;
+// [ 3] bsls::Types::Int64 numGuardedAllocations() const;
+// [ 2] int numSlots() const;
+// [ 3] int numSlotsInUse() const;
+// [ 2] int sampleInterval() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] USAGE EXAMPLE
+// [ 4] CONCERN: Guard pages and deallocated blocks are protected.
+// [ 5] CONCERN: Invalid deallocations are reported.
+// [ *] CONCERN: In no case does memory come from the global allocator.
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL VARIABLES / TYPEDEFS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::SamplingGuardingAllocator Obj;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef jmp_buf    JumpBuffer;
+#else
+typedef sigjmp_buf JumpBuffer;
+#endif
+
+static JumpBuffer g_jumpBuffer;
+static bool       g_withinTestFlag = false;  // see 'signalHandler' (below)
+
+// ============================================================================
+//                   HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+extern "C" {
+
+void signalHandler(int signal)
+    // Handle the specified 'signal'.  Note that this signal handler is
+    // intended for 'SIGSEGV' and 'SIGBUS' only.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    ASSERT(SIGSEGV == signal);
+#else
+    ASSERT(SIGSEGV == signal || SIGBUS == signal);
+#endif
+
+    if (g_withinTestFlag) {
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+        longjmp   (g_jumpBuffer, 1);
+#else
+        siglongjmp(g_jumpBuffer, 1);
+#endif
+    }
+    else {
+        ASSERT("Unexpected invocation of 'signalHandler'."  && 0);
+    }
+}
+
+}  // close extern "C"
+
+static
+bool causesMemoryFault(void *address, int offset, char value)
+    // Return 'true' if assigning the specified 'value' to the byte at the
+    // specified 'offset' from the specified 'address' causes a memory fault,
+    // and 'false' otherwise.
+{
+    bool faultFlag = false;
+
+    signal(SIGSEGV, signalHandler);
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+    signal(SIGBUS,  signalHandler);
+#endif
+
+    g_withinTestFlag = true;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    const int rc = setjmp(g_jumpBuffer);
+#else
+    const int rc = sigsetjmp(g_jumpBuffer, 1);
+#endif
+
+    if (0 == rc) {
+        *(static_cast<char *>(address) + offset) = value;
+    }
+    else if (1 == rc) {
+        faultFlag = true;
+    }
+    else {
+        ASSERT("Unexpected return value from 'setjmp' or 'sigsetjmp'."  && 0);
+    }
+
+    signal(SIGSEGV, SIG_DFL);
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+    signal(SIGBUS,  SIG_DFL);
+#endif
+
+    g_withinTestFlag = false;
+
+    return faultFlag;
+}
+
+static
+bool isReported(Obj *allocator, void *address)
+    // Deallocate the specified 'address' from the specified 'allocator', and
+    // return 'true' if the deallocation invokes the assertion-failure
+    // handler, and 'false' otherwise.
+{
+    bsls::AssertFailureHandlerGuard hG(bsls::AssertTest::failTestDriver);
+
+    try {
+        allocator->deallocate(address);
+    }
+    catch (const bsls::AssertTestException&) {
+        return true;                                                  // RETURN
+    }
+    return false;
+}
+
+static
+bool contains(const bsl::string& text, const char *pattern)
+    // Return 'true' if the specified 'text' contains the specified 'pattern',
+    // and 'false' otherwise.
+{
+    return bsl::string::npos != text.find(pattern);
+}
+
+// ============================================================================
+//                                MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const int pageSize = static_cast<int>(info.dwPageSize);
+#else
+    const int pageSize = static_cast<int>(sysconf(_SC_PAGESIZE));
+#endif
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown (without the invalid access).
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da(veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Catching a Heap Corruption in Production
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a long-running service occasionally crashes in a context far
+// removed from the code corrupting the heap, and only under production load.
+// We install a sampling guarding allocator as the default allocator at the
+// start of 'main', delegating to the allocator that would otherwise have been
+// used.
+//
+// First, we create the allocator, guarding one in every 1000 allocations with
+// 32 slots, and install it as the default allocator:
+//..
+    bslma::Allocator *delegate = bslma::Default::defaultAllocator();
+
+    bdlma::SamplingGuardingAllocator guardingAllocator(1000, 32, delegate);
+
+    bslma::Default::setDefaultAllocator(&guardingAllocator);
+//..
+// Then, we install the fault handler, so that a crash caused by a guarded
+// block is reported along with the call stacks of its allocation and
+// deallocation:
+//..
+    bdlma::SamplingGuardingAllocator::installFaultHandler();
+//..
+// Next, we suppose that a component keeps a pointer to a buffer beyond its
+// lifetime:
+//..
+    char *data = static_cast<char *>(guardingAllocator.allocate(100));
+
+    // ...
+
+    guardingAllocator.deallocate(data);
+//..
+// Now, if the memory of 'data' happened to be guarded, any access through
+// 'data' (such as '*data = 'x';') faults, and the process terminates with a
+// report on 'stderr' similar to:
+//..
+//  *** bdlma::SamplingGuardingAllocator: use-after-free at 0x7f3a1c0a4f9c
+//      0 bytes into a 100-byte block at 0x7f3a1c0a4f9c
+//      allocated by:
+//        #0 0x4a6f21
+//        ...
+//      freed by:
+//        #0 0x4a7042
+//        ...
+//..
+// Finally, we can check for a guarded address without faulting:
+//..
+    if (guardingAllocator.isGuarded(data)) {
+        guardingAllocator.describeFault(bsl::cerr, data);
+    }
+//..
+
+        ASSERT(!guardingAllocator.isGuarded(data));
+        ASSERT(0 == guardingAllocator.numSlotsInUse());
+
+        bslma::Default::setDefaultAllocator(&da);
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+        signal(SIGSEGV, SIG_DFL);
+        signal(SIGBUS,  SIG_DFL);
+#endif
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING 'installFaultHandler'
+        //
+        // Concerns:
+        //: 1 On platforms supporting POSIX signals, 'installFaultHandler'
+        //:   succeeds, and can be called repeatedly.
+        //:
+        //: 2 An access to a deallocated guarded block terminates the process
+        //:   with the signal raised by the access, after a report of the
+        //:   use-after-free, including both call stacks, is written to
+        //:   'stderr'.
+        //
+        // Plan:
+        //: 1 Call 'installFaultHandler' twice, and verify the result.  (C-1)
+        //:
+        //: 2 In a child process whose 'stderr' is a pipe, install the
+        //:   handler, allocate and deallocate a guarded block, and write to
+        //:   it.  Verify that the child is terminated by 'SIGSEGV' or
+        //:   'SIGBUS', and that the report read from the pipe identifies the
+        //:   use-after-free.  (C-2)
+        //
+        // Testing:
+        //   static int installFaultHandler();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING 'installFaultHandler'"
+                          << endl << "=============================" << endl;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+        ASSERT(0 != Obj::installFaultHandler());
+#else
+        int fds[2];
+        ASSERT(0 == pipe(fds));
+
+        cout << flush;
+
+        const pid_t pid = fork();
+        ASSERT(0 <= pid);
+
+        if (0 == pid) {
+            // Child: report into the pipe, and do not dump core.
+
+            struct rlimit noCore = { 0, 0 };
+            setrlimit(RLIMIT_CORE, &noCore);
+
+            close(fds[0]);
+            dup2(fds[1], 2);
+
+            if (0 != Obj::installFaultHandler()
+             || 0 != Obj::installFaultHandler()) {
+                _exit(1);
+            }
+
+            bslma::TestAllocator ta;
+            Obj                  mX(1, 1, &ta);
+
+            char *p = static_cast<char *>(mX.allocate(64));
+            if (!mX.isGuarded(p)) {
+                _exit(2);
+            }
+            mX.deallocate(p);
+
+            *static_cast<volatile char *>(p) = 'x';
+
+            _exit(3);
+        }
+
+        close(fds[1]);
+
+        bsl::string report;
+        char        buffer[256];
+        for (ssize_t n; 0 < (n = read(fds[0], buffer, sizeof buffer)); ) {
+            report.append(buffer, n);
+        }
+        close(fds[0]);
+
+        int status = 0;
+        ASSERT(pid == waitpid(pid, &status, 0));
+
+        if (veryVerbose) { P(report); }
+
+        ASSERTV(status, WIFSIGNALED(status));
+        ASSERTV(WTERMSIG(status),
+                SIGSEGV == WTERMSIG(status) || SIGBUS == WTERMSIG(status));
+        ASSERTV(report, contains(report, "use-after-free"));
+        ASSERTV(report, contains(report, "0 bytes into a 64-byte block"));
+        ASSERTV(report, contains(report, "allocated by:"));
+        ASSERTV(report, contains(report, "freed by:"));
+#endif
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING FAULT REPORTS
+        //
+        // Concerns:
+        //: 1 'describeFault' classifies accesses within a deallocated block,
+        //:   before an outstanding block, and after it, and reports the
+        //:   distance to the block and its size.
+        //:
+        //: 2 The report includes the allocation call stack, and the
+        //:   deallocation call stack for a deallocated block only.
+        //:
+        //: 3 'describeFault' fails, with no effect, for addresses outside the
+        //:   slots and guard pages.
+        //:
+        //: 4 Double frees, frees of addresses other than that of a guarded
+        //:   block, and overwrites of the memory surrounding a block are
+        //:   reported, by invoking the assertion-failure handler.
+        //
+        // Plan:
+        //: 1 Allocate guarded blocks, and verify the reports produced by
+        //:   'describeFault' for addresses around them, before and after
+        //:   deallocation.  (C-1..3)
+        //:
+        //: 2 Perform each kind of invalid deallocation with the test driver's
+        //:   assertion-failure handler installed, and verify that it is
+        //:   invoked.  (C-4)
+        //
+        // Testing:
+        //   int describeFault(bsl::ostream& stream, const void *address);
+        //   CONCERN: Invalid deallocations are reported.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING FAULT REPORTS"
+                          << endl << "=====================" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        if (verbose) cout << "\nTesting 'describeFault'." << endl;
+        {
+            Obj mX(1, 4, &ta);  const Obj& X = mX;
+
+            char *p = static_cast<char *>(mX.allocate(40));
+            ASSERT(X.isGuarded(p));
+
+            {
+                bsl::ostringstream oss;
+                ASSERT(0 == X.describeFault(oss, p + 40 + 8));
+
+                const bsl::string R = oss.str();
+                if (veryVerbose) { P(R); }
+
+                ASSERTV(R, contains(R, "buffer overflow"));
+                ASSERTV(R, contains(R, "8 bytes after the end of a 40-byte"));
+                ASSERTV(R, contains(R, "allocated by:"));
+                ASSERTV(R, !contains(R, "freed by:"));
+            }
+            {
+                bsl::ostringstream oss;
+                ASSERT(0 == X.describeFault(oss, p - 16));
+
+                const bsl::string R = oss.str();
+                if (veryVerbose) { P(R); }
+
+                ASSERTV(R, contains(R, "buffer underflow"));
+                ASSERTV(R, contains(R, "16 bytes before a 40-byte block"));
+            }
+
+            mX.deallocate(p);
+
+            {
+                bsl::ostringstream oss;
+                ASSERT(0 == X.describeFault(oss, p + 5));
+
+                const bsl::string R = oss.str();
+                if (veryVerbose) { P(R); }
+
+                ASSERTV(R, contains(R, "use-after-free"));
+                ASSERTV(R, contains(R, "5 bytes into a 40-byte block"));
+                ASSERTV(R, contains(R, "allocated by:"));
+                ASSERTV(R, contains(R, "freed by:"));
+            }
+
+            char *q = static_cast<char *>(ta.allocate(8));
+            {
+                bsl::ostringstream oss;
+                ASSERT(0 != X.describeFault(oss, q));
+                ASSERT(oss.str().empty());
+            }
+            ta.deallocate(q);
+        }
+
+        if (verbose) cout << "\nTesting invalid deallocations." << endl;
+        {
+            Obj mX(1, 4, &ta);  const Obj& X = mX;
+
+            if (veryVerbose) cout << "\tDouble free." << endl;
+
+            char *p = static_cast<char *>(mX.allocate(40));
+            ASSERT(X.isGuarded(p));
+            ASSERT(!isReported(&mX, p));
+            ASSERT( isReported(&mX, p));
+            ASSERT(0 == X.numSlotsInUse());
+
+            if (veryVerbose) cout << "\tInterior address." << endl;
+
+            p = static_cast<char *>(mX.allocate(40));
+            ASSERT(X.isGuarded(p));
+            ASSERT( isReported(&mX, p + 8));
+            ASSERT(1 == X.numSlotsInUse());
+            ASSERT(!isReported(&mX, p));
+
+            if (veryVerbose) cout << "\tUnderflow." << endl;
+
+            p = static_cast<char *>(mX.allocate(40));
+            p[-1] = 'x';
+            ASSERT( isReported(&mX, p));
+            ASSERT(0 == X.numSlotsInUse());
+
+            if (veryVerbose) cout << "\tWild write at the slot start." << endl;
+
+            p = static_cast<char *>(mX.allocate(13));
+            ASSERT(X.isGuarded(p));
+            p[13 - pageSize] = 'x';
+            ASSERT( isReported(&mX, p));
+            ASSERT(0 == X.numSlotsInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING PROTECTION
+        //
+        // Concerns:
+        //: 1 The guard page following a guarded block is protected, and a
+        //:   block whose size is a multiple of its alignment ends at its
+        //:   guard page.
+        //:
+        //: 2 The guard page preceding a slot is protected.
+        //:
+        //: 3 A deallocated guarded block is protected, and becomes
+        //:   accessible again only when its slot is reused.
+        //:
+        //: 4 Free slots are reused in the order in which they were freed.
+        //
+        // Plan:
+        //: 1 Allocate guarded blocks of several sizes, write over them in
+        //:   full, and verify that the bytes following the (rounded) block,
+        //:   and the bytes preceding its slot, cannot be written.  (C-1..2)
+        //:
+        //: 2 Deallocate the blocks, and verify that they cannot be written.
+        //:   Allocate again, and verify the order in which the slots are
+        //:   reused.  (C-3..4)
+        //
+        // Testing:
+        //   CONCERN: Guard pages and deallocated blocks are protected.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING PROTECTION"
+                          << endl << "==================" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        static const int SIZES[] = { 1, 8, 13, 64, 100, 1000 };
+        const int NUM_SIZES = static_cast<int>(sizeof SIZES / sizeof *SIZES);
+
+        Obj mX(1, NUM_SIZES, &ta);  const Obj& X = mX;
+
+        char *blocks[NUM_SIZES];
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            const int SIZE      = SIZES[ti];
+            const int ALIGNMENT =
+                       bsls::AlignmentUtil::calculateAlignmentFromSize(SIZE);
+            const int PADDED    = (SIZE + ALIGNMENT - 1) / ALIGNMENT
+                                                                   * ALIGNMENT;
+
+            char *p = static_cast<char *>(mX.allocate(SIZE));
+            ASSERTV(SIZE, X.isGuarded(p));
+            ASSERTV(SIZE, 0 ==
+                    bsls::AlignmentUtil::calculateAlignmentOffset(p,
+                                                                  ALIGNMENT));
+
+            bsl::memset(p, 'a', SIZE);
+
+            const int TO_PAGE_END = pageSize - static_cast<int>(
+                         reinterpret_cast<bsls::Types::UintPtr>(p) % pageSize);
+
+            ASSERTV(SIZE, TO_PAGE_END, PADDED == TO_PAGE_END);
+            ASSERTV(SIZE, causesMemoryFault(p, TO_PAGE_END, 'x'));
+            ASSERTV(SIZE, causesMemoryFault(p, TO_PAGE_END + pageSize - 1,
+                                            'x'));
+            ASSERTV(SIZE, causesMemoryFault(p, TO_PAGE_END - pageSize - 1,
+                                            'x'));
+
+            blocks[ti] = p;
+        }
+        ASSERT(NUM_SIZES == X.numSlotsInUse());
+        ASSERT(0         == ta.numBlocksInUse() - 2);
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            mX.deallocate(blocks[ti]);
+            ASSERTV(ti, causesMemoryFault(blocks[ti], 0, 'x'));
+        }
+        ASSERT(0 == X.numSlotsInUse());
+
+        // Slots are reused in the order in which they were freed, and
+        // become accessible again.
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            char *p = static_cast<char *>(mX.allocate(SIZES[ti]));
+            ASSERTV(ti, p == blocks[ti]);
+            ASSERTV(ti, !causesMemoryFault(p, 0, 'x'));
+            mX.deallocate(p);
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocate' AND 'deallocate'
+        //
+        // Concerns:
+        //: 1 Exactly one in every 'sampleInterval' requests is guarded, and
+        //:   all other requests are supplied by the delegate allocator.
+        //:
+        //: 2 Requests exceeding a page, and sampled requests when no slot is
+        //:   free, are supplied by the delegate allocator.
+        //:
+        //: 3 Each block is returned to the allocator that supplied it.
+        //:
+        //: 4 'numGuardedAllocations' and 'numSlotsInUse' reflect the guarded
+        //:   blocks.
+        //:
+        //: 5 Allocating 0 bytes returns 0, and deallocating 0 has no effect.
+        //
+        // Plan:
+        //: 1 Using a test allocator as the delegate, allocate a sequence of
+        //:   blocks, and verify which are guarded, and the number of blocks
+        //:   in use by the delegate.  Then deallocate them, and verify that
+        //:   no memory remains in use.  (C-1..5)
+        //
+        // Testing:
+        //   void *allocate(size_type size);
+        //   void deallocate(void *address);
+        //   bool isGuarded(const void *address) const;
+        //   bsls::Types::Int64 numGuardedAllocations() const;
+        //   int numSlotsInUse() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'allocate' AND 'deallocate'" << endl
+                          << "===================================" << endl;
+
+        enum { NUM_SLOTS = 3, INTERVAL = 4, NUM_BLOCKS = 20 };
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        {
+            Obj mX(INTERVAL, NUM_SLOTS, &ta);  const Obj& X = mX;
+
+            const bsls::Types::Int64 BASE = ta.numBlocksInUse();
+
+            ASSERT(0 == mX.allocate(0));
+            mX.deallocate(0);
+
+            void *blocks[NUM_BLOCKS];
+            int   numGuarded = 0;
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks[i] = mX.allocate(32);
+
+                const bool SAMPLED  = (i + 1) % INTERVAL == 0;
+                const bool EXPECTED = SAMPLED && numGuarded < NUM_SLOTS;
+
+                ASSERTV(i, EXPECTED == X.isGuarded(blocks[i]));
+                if (EXPECTED) {
+                    ++numGuarded;
+                }
+                bsl::memset(blocks[i], 'a', 32);
+            }
+            ASSERT(NUM_SLOTS == X.numSlotsInUse());
+            ASSERT(NUM_SLOTS == X.numGuardedAllocations());
+            ASSERT(NUM_BLOCKS - NUM_SLOTS == ta.numBlocksInUse() - BASE);
+
+            // A sampled request exceeding a page is not guarded.
+
+            for (int i = 0; i < INTERVAL; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+            ASSERT(NUM_SLOTS - 1 == X.numSlotsInUse());
+
+            for (int i = 0; i < INTERVAL; ++i) {
+                blocks[i] = mX.allocate(pageSize + 1);
+                ASSERTV(i, !X.isGuarded(blocks[i]));
+            }
+            ASSERT(NUM_SLOTS - 1 == X.numSlotsInUse());
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+            ASSERT(0    == X.numSlotsInUse());
+            ASSERT(BASE == ta.numBlocksInUse());
+            ASSERT(NUM_SLOTS == X.numGuardedAllocations());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CREATORS
+        //
+        // Concerns:
+        //: 1 The constructor records the sample interval and the number of
+        //:   slots, and uses the supplied or default allocator for the state
+        //:   of the slots.
+        //:
+        //: 2 The destructor returns all memory.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create objects with and without a test allocator, and verify
+        //:   the accessors and the memory used.  (C-1..2)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-3)
+        //
+        // Testing:
+        //   SamplingGuardingAllocator(int si, int ns, Allocator *ba = 0);
+        //   ~SamplingGuardingAllocator();
+        //   int numSlots() const;
+        //   int sampleInterval() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING CREATORS"
+                          << endl << "================" << endl;
+
+        bslma::TestAllocator         da(veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        {
+            Obj mX(10, 5, &ta);  const Obj& X = mX;
+
+            ASSERT(10 == X.sampleInterval());
+            ASSERT( 5 == X.numSlots());
+            ASSERT( 0 == X.numSlotsInUse());
+            ASSERT( 0 == X.numGuardedAllocations());
+            ASSERT( 0 <  ta.numBlocksInUse());
+            ASSERT( 0 == da.numBlocksInUse());
+
+            int local;
+            ASSERT(!X.isGuarded(&local));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        {
+            Obj mX(1, 1);  const Obj& X = mX;
+
+            ASSERT(1 == X.sampleInterval());
+            ASSERT(1 == X.numSlots());
+            ASSERT(0 <  da.numBlocksInUse());
+        }
+        ASSERT(0 == da.numBlocksInUse());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_PASS(Obj(1, 1, &ta));
+            ASSERT_FAIL(Obj(0, 1, &ta));
+            ASSERT_FAIL(Obj(1, 0, &ta));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an object guarding every other allocation, allocate two
+        //:   blocks, write over them, verify that the second one is guarded
+        //:   and that the page following it is protected, and deallocate
+        //:   them.
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        {
+            Obj mX(2, 4, &ta);
+
+            char *p = static_cast<char *>(mX.allocate(16));
+            char *q = static_cast<char *>(mX.allocate(16));
+
+            bsl::memset(p, 'p', 16);
+            bsl::memset(q, 'q', 16);
+
+            ASSERT(!mX.isGuarded(p));
+            ASSERT( mX.isGuarded(q));
+            ASSERT(causesMemoryFault(q, 16, 'x'));
+
+            mX.deallocate(p);
+            mX.deallocate(q);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -6,6 +6,8 @@ BSLS_IDENT_RCSID(bdlma_sequentialallocator_cpp,"$Id$ $CSID$")
 
 #include <bsls_performancehint.h>
 
+#include <bsl_climits.h>  // 'INT_MAX'
+
 namespace BloombergLP {
 namespace bdlma {
 
@@ -41,6 +43,27 @@ void *SequentialAllocator::allocateAndExpand(size_type *size)
     return d_sequentialPool.allocateAndExpand(size);
 }
 
+bool SequentialAllocator::expandSized(void      *address,
+                                      size_type  size,
+                                      size_type  newSize)
+{
+    BSLS_ASSERT(address);
+    BSLS_ASSERT(0 < size);
+    BSLS_ASSERT(size <= newSize);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                  newSize > static_cast<size_type>(INT_MAX))) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return false;                                                 // RETURN
+    }
+
+    const int newSizeAsInt = static_cast<int>(newSize);
+
+    return newSizeAsInt == d_sequentialPool.expand(address,
+                                                   static_cast<int>(size),
+                                                   newSizeAsInt);
+}
+
 void SequentialAllocator::reserveCapacity(int numBytes)
 {
     BSLS_ASSERT(0 <= numBytes);
@@ -24,6 +24,7 @@ BSLS_IDENT("$Id: $")
 //   `--------------------------'
 //                |         ctor/dtor
 //                |         allocateAndExpand
+//                |         expandSized
 //                |         reserveCapacity
 //                |         truncate
 //                V
@@ -372,6 +373,20 @@ class SequentialAllocator : public ManagedAllocator {
         // behavior is undefined unless 'address' is 0, or was allocated by
         // this allocator and has not already been deallocated.
 
+    virtual bool expandSized(void     *address,
+                             size_type size,
+                             size_type newSize);
+        // Extend, in place, the memory block at the specified 'address',
+        // having the specified 'size' (in bytes), to the specified 'newSize'
+        // (in bytes) if it is the block returned by the most recent allocation
+        // request from this allocator and the current internal buffer has at
+        // least 'newSize - size' bytes of free space remaining.  Return 'true'
+        // if the block was extended, and 'false' (with no effect) otherwise.
+        // The behavior is undefined unless the memory at 'address' was
+        // originally allocated by this allocator, the size of the memory
+        // block at 'address' is 'size', '0 < size <= newSize', and 'release'
+        // was not called after allocating the memory block at 'address'.
+
     virtual void release();
         // Release all memory allocated through this allocator.  The allocator
         // is reset to its default constructed state, retaining the alignment
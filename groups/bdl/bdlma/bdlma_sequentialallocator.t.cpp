@@ -10,6 +10,9 @@
 #include <bsls_asserttest.h>
 #include <bsls_types.h>
 
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
 #include <bsl_cstdlib.h>
 #include <bsl_iostream.h>
 
@@ -73,9 +76,10 @@ using namespace bsl;
 // [ 4] void release();
 // [ 7] void reserveCapacity(int numBytes);
 // [ 6] int truncate(void *address, int originalSize, int newSize);
+// [ 8] bool expandSized(void *address, size_type size, size_type new);
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 8] USAGE TEST
+// [ 9] USAGE TEST
 
 //=============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -279,7 +283,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 8: {
+      case 9: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -313,6 +317,133 @@ int main(int argc, char *argv[])
 //  }
 //..
 
+      } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // 'expandSized' TEST
+        //
+        // Concerns:
+        //   1. That 'expandSized' extends the most recently allocated block in
+        //      place, so that the next allocation follows the extended block.
+        //
+        //   2. That 'expandSized' returns 'false', with no effect, if the
+        //      block is not the most recent allocation or if the internal
+        //      buffer has insufficient free space.
+        //
+        //   3. That 'bsl::vector' and 'bsl::string' that are the most recent
+        //      allocation grow without reallocating their storage.
+        //
+        //   4. QoI: Asserted precondition violations are detected when
+        //      enabled.
+        //
+        // Plan:
+        //   For concerns 1 and 2, reserve capacity in an allocator, allocate
+        //   and expand blocks through the base-class interface, and verify
+        //   the return values and the address of subsequent allocations.
+        //
+        //   For concern 3, append elements to a vector and a string supplied
+        //   by an allocator having sufficient reserved capacity, and verify
+        //   that the address of their data, and the number of blocks
+        //   allocated from the underlying allocator, are unchanged.
+        //
+        //   For concern 4, verify that, in appropriate build modes, defensive
+        //   checks are triggered.
+        //
+        // Testing:
+        //   bool expandSized(void *address, size_type size, size_type new);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'expandSized' TEST" << endl
+                                  << "==================" << endl;
+
+        bslma::TestAllocator objectAllocator(veryVeryVeryVerbose);
+
+        if (verbose) cout << "\nTesting 'expandSized'." << endl;
+        {
+            Obj mX(&objectAllocator);
+            mX.reserveCapacity(1024);
+
+            bslma::Allocator& a = mX;
+
+            char *addr1 = static_cast<char *>(a.allocateSized(16));
+            ASSERT(0 != addr1);
+
+            ASSERT(true  == a.expandSized(addr1, 16, 16));
+            ASSERT(true  == a.expandSized(addr1, 16, 64));
+
+            char *addr2 = static_cast<char *>(a.allocateSized(8));
+            ASSERTV((void *)addr1, (void *)addr2, addr1 + 64 == addr2);
+
+            // 'addr1' is no longer the most recent allocation.
+
+            ASSERT(false == a.expandSized(addr1, 64, 128));
+
+            // Insufficient space remaining in the internal buffer.
+
+            ASSERT(false == a.expandSized(addr2, 8, 2048));
+
+            char *addr3 = static_cast<char *>(a.allocateSized(8));
+            ASSERTV((void *)addr2, (void *)addr3, addr2 + 8 == addr3);
+        }
+
+        if (verbose) cout << "\nTesting copy-free container growth." << endl;
+        {
+            Obj mX(&objectAllocator);
+            mX.reserveCapacity(4096);
+
+            const bsls::Types::Int64 NUM_BLOCKS =
+                                              objectAllocator.numBlocksTotal();
+
+            bsl::vector<int> mV(&mX);  const bsl::vector<int>& V = mV;
+
+            mV.push_back(0);
+            const int *DATA = V.data();
+
+            for (int i = 1; i < 100; ++i) {
+                mV.push_back(i);
+                ASSERTV(i, DATA == V.data());
+            }
+            ASSERTV(V.capacity(), 100 <= V.capacity());
+
+            mV.reserve(V.capacity() + 50);
+            ASSERT(DATA == V.data());
+
+            for (int i = 0; i < 100; ++i) {
+                ASSERTV(i, V[i], i == V[i]);
+            }
+
+            bsl::string mS(&mX);  const bsl::string& S = mS;
+
+            mS.assign(40, 'a');
+            const char *STR = S.data();
+
+            for (int i = 0; i < 500; ++i) {
+                mS.push_back(static_cast<char>('a' + i % 26));
+                ASSERTV(i, STR == S.data());
+            }
+            ASSERTV(S.length(), 540 == S.length());
+            ASSERT(bsl::string(40, 'a') == S.substr(0, 40));
+            ASSERT('z' == S[40 + 25]);
+
+            ASSERTV(NUM_BLOCKS == objectAllocator.numBlocksTotal());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX;
+
+            void *addr = mX.allocate(2);
+
+            ASSERT_SAFE_PASS_RAW(mX.expandSized(addr, 2, 3));
+
+            ASSERT_SAFE_FAIL_RAW(mX.expandSized(   0, 1, 2));
+            ASSERT_SAFE_FAIL_RAW(mX.expandSized(addr, 0, 2));
+            ASSERT_SAFE_FAIL_RAW(mX.expandSized(addr, 3, 2));
+        }
+
       } break;
       case 7: {
         // --------------------------------------------------------------------
@@ -498,6 +498,20 @@ class SequentialPool {
         // growth strategies, and the initial and maximum buffer sizes in
         // effect following construction.
 
+    int expand(void *address, int originalSize, int newSize);
+        // Increase the amount of memory allocated at the specified 'address'
+        // of the specified 'originalSize' (in bytes) to the specified
+        // 'newSize', without moving it.  Return 'newSize' after expanding, or
+        // 'originalSize' if the memory block at 'address' cannot be expanded.
+        // This method can only 'expand' the memory block returned by the most
+        // recent 'allocate' request from this memory pool, and only if the
+        // current internal buffer has sufficient free space; otherwise it has
+        // no effect.  The behavior is undefined unless the memory at 'address'
+        // was originally allocated by this memory pool, the size of the memory
+        // block at 'address' is 'originalSize', '0 < originalSize',
+        // 'originalSize <= newSize', and 'release' was not called after
+        // allocating the memory block at 'address'.
+
     void reserveCapacity(int numBytes);
         // Reserve sufficient memory to satisfy allocation requests for at
         // least the specified 'numBytes' without replenishment (i.e., without
@@ -633,6 +647,23 @@ void SequentialPool::release()
     d_blockList.release();
 }
 
+inline
+int SequentialPool::expand(void *address, int originalSize, int newSize)
+{
+    BSLS_ASSERT_SAFE(address);
+    BSLS_ASSERT_SAFE(0 < originalSize);
+    BSLS_ASSERT_SAFE(originalSize <= newSize);
+
+    // If 'd_buffer.buffer()' is 0, the pool was 'release'd (or has never
+    // allocated from a buffer), and 'address' is from the block list.
+
+    if (0 == d_buffer.buffer()) {
+        return originalSize;                                          // RETURN
+    }
+
+    return d_buffer.expand(address, originalSize, newSize);
+}
+
 inline
 int SequentialPool::truncate(void *address, int originalSize, int newSize)
 {
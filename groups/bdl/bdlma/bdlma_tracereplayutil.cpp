@@ -0,0 +1,319 @@
+// bdlma_tracereplayutil.cpp                                          -*-C++-*-
+#include <bdlma_tracereplayutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_tracereplayutil_cpp,"$Id$ $CSID$")
+
+#include <bdlma_countingallocator.h>
+#include <bdlma_tracingallocator.h>
+
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+
+#include <bsls_assert.h>
+#include <bsls_timeutil.h>
+
+#include <bsl_unordered_map.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace bdlma {
+namespace {
+
+typedef bsls::Types::Int64            Int64;
+typedef bsls::Types::Uint64           Uint64;
+typedef bslma::Allocator::size_type   size_type;
+
+struct Request {
+    // This 'struct' holds a decoded request of a trace.
+
+    size_type d_size;  // size of the allocation, or 0 for a deallocation
+    int       d_slot;  // index of the block in the array of blocks in use
+};
+
+int decodeVarint(Uint64 *value, bsl::streambuf *trace)
+    // Load into the specified 'value' an unsigned LEB128 integer read from the
+    // specified 'trace'.  Return 0 on success, and a non-zero value if the
+    // end of 'trace' is reached, or the integer does not fit in 64 bits.
+{
+    typedef bsl::streambuf::traits_type Traits;
+
+    Uint64 result = 0;
+
+    for (int shift = 0; shift < 64; shift += 7) {
+        const Traits::int_type byte = trace->sbumpc();
+
+        if (Traits::eq_int_type(byte, Traits::eof())) {
+            return -1;                                                // RETURN
+        }
+
+        result |= static_cast<Uint64>(byte & 0x7F) << shift;
+
+        if (0 == (byte & 0x80)) {
+            *value = result;
+            return 0;                                                 // RETURN
+        }
+    }
+    return -2;
+}
+
+void deallocateBlocksInUse(bslma::Allocator           *allocator,
+                           const bsl::vector<void *>&  blocks,
+                           const bsl::vector<char>&    inUse)
+    // Deallocate to the specified 'allocator' each of the specified 'blocks'
+    // whose element in the specified 'inUse' is non-zero.  The behavior is
+    // undefined unless 'blocks' and 'inUse' have the same size.
+{
+    for (size_type i = 0; i < blocks.size(); ++i) {
+        if (inUse[i]) {
+            allocator->deallocate(blocks[i]);
+        }
+    }
+}
+
+int decodeTrace(bsl::vector<Request> *requests,
+                int                  *numSlots,
+                TraceReplayResult    *result,
+                bsl::streambuf       *trace,
+                bslma::Allocator     *scratchAllocator)
+    // Load into the specified 'requests' the requests decoded from the
+    // specified 'trace', into the specified 'numSlots' the maximum number of
+    // blocks in use at any point of the trace, and into the specified 'result'
+    // the measurements that depend on the trace only.  Use the specified
+    // 'scratchAllocator' to supply temporary memory.  Return 0 on success, and
+    // a non-zero value if 'trace' is not a valid allocation trace.
+{
+    typedef bsl::streambuf::traits_type Traits;
+
+    char header[TracingAllocator::k_HEADER_SIZE];
+
+    if (TracingAllocator::k_HEADER_SIZE !=
+                       trace->sgetn(header, TracingAllocator::k_HEADER_SIZE)
+     || 'B' != header[0] || 'D' != header[1]
+     || 'T' != header[2] || 'R' != header[3]
+     || TracingAllocator::k_VERSION != header[4]) {
+        return 1;                                                     // RETURN
+    }
+
+    bsl::unordered_map<Uint64, int> slots(scratchAllocator);
+        // slot of each block in use, by address in the recording process
+
+    bsl::vector<size_type> sizes(scratchAllocator);
+        // size of the block in each slot
+
+    bsl::vector<int> freeSlots(scratchAllocator);
+        // slots holding no block in use
+
+    Int64  numAllocations   = 0;
+    Int64  numDeallocations = 0;
+    Int64  totalBytes       = 0;
+    Int64  bytesInUse       = 0;
+    Int64  peakBytes        = 0;
+    Int64  duration         = 0;
+    Uint64 maxThread        = 0;
+
+    while (true) {
+        const Traits::int_type kind = trace->sbumpc();
+
+        if (Traits::eq_int_type(kind, Traits::eof())) {
+            break;
+        }
+
+        Uint64 thread, delta, address, size = 0;
+
+        if (0 != decodeVarint(&thread, trace)
+         || 0 != decodeVarint(&delta, trace)
+         || 0 != decodeVarint(&address, trace)) {
+            return 2;                                                 // RETURN
+        }
+
+        Request request;
+
+        if (TracingAllocator::k_ALLOCATE == kind) {
+            if (0 != decodeVarint(&size, trace)
+             || 0 == size
+             || size != static_cast<size_type>(size)) {
+                return 3;                                             // RETURN
+            }
+
+            int slot;
+            if (freeSlots.empty()) {
+                slot = static_cast<int>(sizes.size());
+                sizes.push_back(0);
+            }
+            else {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            }
+
+            if (!slots.insert(bsl::make_pair(address, slot)).second) {
+                return 4;                                             // RETURN
+            }
+            sizes[slot] = static_cast<size_type>(size);
+
+            request.d_size = static_cast<size_type>(size);
+            request.d_slot = slot;
+
+            ++numAllocations;
+            totalBytes += size;
+            bytesInUse += size;
+            if (peakBytes < bytesInUse) {
+                peakBytes = bytesInUse;
+            }
+        }
+        else if (TracingAllocator::k_DEALLOCATE == kind) {
+            bsl::unordered_map<Uint64, int>::iterator it =
+                                                          slots.find(address);
+            if (slots.end() == it) {
+                return 5;                                             // RETURN
+            }
+
+            request.d_size = 0;
+            request.d_slot = it->second;
+
+            freeSlots.push_back(it->second);
+            bytesInUse -= sizes[it->second];
+            slots.erase(it);
+
+            ++numDeallocations;
+        }
+        else {
+            return 6;                                                 // RETURN
+        }
+
+        requests->push_back(request);
+
+        duration += static_cast<Int64>(delta);
+        if (maxThread < thread) {
+            maxThread = thread;
+        }
+    }
+
+    *numSlots = static_cast<int>(sizes.size());
+
+    result->d_numAllocations      = numAllocations;
+    result->d_numDeallocations    = numDeallocations;
+    result->d_numThreads          = numAllocations + numDeallocations
+                                    ? static_cast<Int64>(maxThread) + 1
+                                    : 0;
+    result->d_totalBytesRequested = totalBytes;
+    result->d_peakBytesRequested  = peakBytes;
+    result->d_recordedNanoseconds = duration;
+
+    return 0;
+}
+
+}  // close unnamed namespace
+
+                           // ----------------------
+                           // struct TraceReplayUtil
+                           // ----------------------
+
+// CLASS METHODS
+int TraceReplayUtil::replay(TraceReplayResult       *result,
+                            bsl::streambuf          *trace,
+                            bslma::Allocator        *allocator,
+                            const CountingAllocator *upstream,
+                            bslma::Allocator        *scratchAllocator)
+{
+    BSLS_ASSERT(result);
+    BSLS_ASSERT(trace);
+    BSLS_ASSERT(allocator);
+
+    scratchAllocator = bslma::Default::allocator(scratchAllocator);
+
+    bsl::vector<Request> requests(scratchAllocator);
+    int                  numSlots = 0;
+    TraceReplayResult    decoded;
+
+    int rc = decodeTrace(&requests,
+                         &numSlots,
+                         &decoded,
+                         trace,
+                         scratchAllocator);
+    if (0 != rc) {
+        return rc;                                                    // RETURN
+    }
+
+    bsl::vector<void *> blocks(numSlots, static_cast<void *>(0),
+                               scratchAllocator);
+
+    const Request *const begin = requests.data();
+    const Request *const end   = begin + requests.size();
+
+    // Find the blocks still in use at the end of the trace, deallocated after
+    // each replay, untimed.
+
+    bsl::vector<char> inUse(numSlots, static_cast<char>(0), scratchAllocator);
+    for (const Request *request = begin; request != end; ++request) {
+        inUse[request->d_slot] = 0 != request->d_size;
+    }
+
+    // If 'upstream' is supplied, first replay the trace untimed, sampling the
+    // number of bytes in use from 'upstream' after each allocation, so that
+    // the reads of its counts are not timed with the allocator under test.
+
+    Int64 peakUpstream = -1;
+
+    if (upstream) {
+        peakUpstream = upstream->numBytesInUse();
+
+        for (const Request *request = begin; request != end; ++request) {
+            if (request->d_size) {
+                blocks[request->d_slot] = allocator->allocate(request->d_size);
+
+                const Int64 bytesInUse = upstream->numBytesInUse();
+                if (peakUpstream < bytesInUse) {
+                    peakUpstream = bytesInUse;
+                }
+            }
+            else {
+                allocator->deallocate(blocks[request->d_slot]);
+            }
+        }
+        deallocateBlocksInUse(allocator, blocks, inUse);
+    }
+
+    // Then, replay the trace timed.
+
+    const Int64 start = bsls::TimeUtil::getTimer();
+
+    for (const Request *request = begin; request != end; ++request) {
+        if (request->d_size) {
+            blocks[request->d_slot] = allocator->allocate(request->d_size);
+        }
+        else {
+            allocator->deallocate(blocks[request->d_slot]);
+        }
+    }
+
+    const Int64 elapsed = bsls::TimeUtil::getTimer() - start;
+
+    deallocateBlocksInUse(allocator, blocks, inUse);
+
+    *result = decoded;
+    result->d_peakUpstreamBytes  = peakUpstream;
+    result->d_elapsedNanoseconds = elapsed;
+
+    return 0;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
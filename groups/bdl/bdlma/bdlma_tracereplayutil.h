@@ -0,0 +1,237 @@
+// bdlma_tracereplayutil.h                                            -*-C++-*-
+#ifndef INCLUDED_BDLMA_TRACEREPLAYUTIL
+#define INCLUDED_BDLMA_TRACEREPLAYUTIL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a utility to replay an allocation trace against allocators.
+//
+//@CLASSES:
+//  bdlma::TraceReplayUtil: namespace for replaying allocation traces
+//  bdlma::TraceReplayResult: measurements of a replay
+//
+//@SEE_ALSO: bdlma_tracingallocator, bdlma_countingallocator
+//
+//@DESCRIPTION: This component provides a namespace, 'bdlma::TraceReplayUtil',
+// for a function, 'replay', that issues the sequence of requests recorded in
+// an allocation trace (written by a 'bdlma::TracingAllocator') to an allocator
+// under test, and measures its behavior, reporting the results in a
+// 'bdlma::TraceReplayResult' object.  Replaying the trace of a production
+// workload against candidate allocators (such as 'bdlma::Multipool',
+// 'bdlma::SequentialAllocator', or 'bslma::NewDeleteAllocator') allows the
+// allocator, and its configuration, to be selected on the basis of that
+// workload, without modifying the application.
+//
+///Replay
+///------
+// 'replay' first decodes the entire trace, mapping the address of each block
+// in the recording process to a dense index, so that the replay itself
+// performs no decoding and no lookup: each allocation stores the block it
+// obtains in an array, and each deallocation returns the block it finds there.
+// The time spent in the allocator under test (including the loop over the
+// decoded requests) is measured with 'bsls::TimeUtil::getTimer'.  The requests
+// are replayed from a single thread, in the order in which they were recorded
+// (i.e., the contention between the threads of the recording process is not
+// reproduced).  Blocks still in use at the end of the trace are deallocated
+// after the measurement ends.
+//
+// If an upstream counting allocator is supplied to 'replay' (see {Memory
+// Footprint and Fragmentation}), the trace is first replayed untimed, reading
+// the counts of the upstream allocator after each allocation, and then
+// replayed again, timed, so that these reads are not timed: the allocator
+// under test is then timed after it has served the trace once (i.e., "warm").
+// Otherwise, the trace is replayed once, timed, from the state of the
+// allocator under test on entry (e.g., "cold" for a newly created allocator).
+//
+///Memory Footprint and Fragmentation
+///----------------------------------
+// The memory footprint of the allocator under test is measured by supplying a
+// 'bdlma::CountingAllocator' as the allocator from which the allocator under
+// test obtains its memory (its *upstream* allocator), and passing it to
+// 'replay'.  The peak number of bytes in use from the upstream allocator
+// during the untimed replay, compared to the peak number of bytes requested by
+// the trace, gives the *overhead* of the allocator under test: the memory it
+// holds beyond that requested, due to headers, rounding, pooling, and
+// fragmentation.  This measure is deterministic and portable, and, unlike the
+// resident set size of the process, is not affected by the memory used by the
+// replay itself, or by previous replays in the same process.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Comparing Allocators on a Recorded Workload
+///- - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we have recorded a trace of the allocations of a workload with
+// a 'bdlma::TracingAllocator' (see 'bdlma_tracingallocator'):
+//..
+//  bsl::stringbuf traceBuffer;
+//  {
+//      bdlma::TracingAllocator tracingAllocator(&traceBuffer);
+//
+//      bsl::vector<bsl::string> words(&tracingAllocator);
+//      for (int i = 0; i < 100; ++i) {
+//          words.push_back(bsl::string(40 + i % 10, 'x'));
+//      }
+//  }
+//  const bsl::string trace = traceBuffer.str();
+//..
+// First, we replay the trace against a 'bdlma::MultipoolAllocator', measuring
+// its footprint through a counting allocator:
+//..
+//  bdlma::TraceReplayResult multipoolResult;
+//  {
+//      bdlma::CountingAllocator  upstream;
+//      bdlma::MultipoolAllocator allocator(&upstream);
+//
+//      bsl::stringbuf input(trace);
+//      int rc = bdlma::TraceReplayUtil::replay(&multipoolResult,
+//                                              &input,
+//                                              &allocator,
+//                                              &upstream);
+//      assert(0 == rc);
+//  }
+//..
+// Then, we replay the same trace against a 'bdlma::SequentialAllocator':
+//..
+//  bdlma::TraceReplayResult sequentialResult;
+//  {
+//      bdlma::CountingAllocator   upstream;
+//      bdlma::SequentialAllocator allocator(&upstream);
+//
+//      bsl::stringbuf input(trace);
+//      int rc = bdlma::TraceReplayUtil::replay(&sequentialResult,
+//                                              &input,
+//                                              &allocator,
+//                                              &upstream);
+//      assert(0 == rc);
+//  }
+//..
+// Now, we verify that both replays issued the same requests:
+//..
+//  assert(multipoolResult.d_numAllocations ==
+//                                        sequentialResult.d_numAllocations);
+//  assert(multipoolResult.d_peakBytesRequested ==
+//                                    sequentialResult.d_peakBytesRequested);
+//..
+// Finally, we compare the results.  A sequential allocator never reuses the
+// memory of deallocated blocks, so its footprint is at least the total number
+// of bytes requested:
+//..
+//  assert(sequentialResult.d_peakUpstreamBytes >=
+//                                   sequentialResult.d_totalBytesRequested);
+//..
+// In practice, we would also compare 'd_elapsedNanoseconds' (measured over a
+// trace long enough to be significant), and print the results of each
+// candidate configuration.
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_STREAMBUF
+#include <bsl_streambuf.h>
+#endif
+
+namespace BloombergLP {
+
+namespace bslma { class Allocator; }
+
+namespace bdlma {
+
+class CountingAllocator;
+
+                          // ========================
+                          // struct TraceReplayResult
+                          // ========================
+
+struct TraceReplayResult {
+    // This simple 'struct' holds the measurements of the replay of an
+    // allocation trace.
+
+    // PUBLIC DATA
+    bsls::Types::Int64 d_numAllocations;       // number of allocations
+
+    bsls::Types::Int64 d_numDeallocations;     // number of deallocations
+
+    bsls::Types::Int64 d_numThreads;           // number of threads recorded
+                                               // in the trace
+
+    bsls::Types::Int64 d_totalBytesRequested;  // sum of the sizes of all
+                                               // allocations
+
+    bsls::Types::Int64 d_peakBytesRequested;   // maximum, over the trace, of
+                                               // the sum of the sizes of the
+                                               // blocks in use
+
+    bsls::Types::Int64 d_peakUpstreamBytes;    // maximum number of bytes in
+                                               // use from the upstream
+                                               // allocator, or -1 if none was
+                                               // supplied
+
+    bsls::Types::Int64 d_recordedNanoseconds;  // duration of the trace in the
+                                               // recording process
+
+    bsls::Types::Int64 d_elapsedNanoseconds;   // duration of the timed
+                                               // replay
+};
+
+                           // ======================
+                           // struct TraceReplayUtil
+                           // ======================
+
+struct TraceReplayUtil {
+    // This 'struct' provides a namespace for replaying allocation traces.
+
+    // CLASS METHODS
+    static int replay(TraceReplayResult       *result,
+                      bsl::streambuf          *trace,
+                      bslma::Allocator        *allocator,
+                      const CountingAllocator *upstream = 0,
+                      bslma::Allocator        *scratchAllocator = 0);
+        // Issue the requests of the allocation trace read from the specified
+        // 'trace' stream buffer to the specified 'allocator', and load the
+        // measurements of the replay into the specified 'result'.  Optionally
+        // specify an 'upstream' counting allocator supplying the memory of
+        // 'allocator', whose peak number of bytes in use during an untimed
+        // replay of 'trace' is loaded into 'result->d_peakUpstreamBytes', and
+        // which precedes the timed replay (i.e., 'allocator' is then timed
+        // after serving the requests of 'trace' once; see {Replay}).  If
+        // 'upstream' is 0, 'trace' is replayed once, timed, and
+        // 'result->d_peakUpstreamBytes' is set to -1.  Optionally specify a
+        // 'scratchAllocator' used to supply the memory of the decoded trace.
+        // If 'scratchAllocator' is 0, the currently installed default
+        // allocator is used.  Return 0 on success, and a non-zero value (with
+        // no request issued to 'allocator', and 'result' unchanged) if the
+        // trace is not a valid allocation trace, including if it deallocates
+        // a block that is not in use.  Note that the memory used by the
+        // decoded trace is proportional to the number of records of 'trace'.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
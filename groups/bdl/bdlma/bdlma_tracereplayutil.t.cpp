@@ -0,0 +1,640 @@
+// bdlma_tracereplayutil.t.cpp                                        -*-C++-*-
+#include <bdlma_tracereplayutil.h>
+
+#include <bdlma_countingallocator.h>
+#include <bdlma_multipoolallocator.h>
+#include <bdlma_sequentialallocator.h>
+#include <bdlma_tracingallocator.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                TEST PLAN
+// ----------------------------------------------------------------------------
+//                                 Overview
+//                                 --------
+// 'bdlma::TraceReplayUtil::replay' decodes an allocation trace, issues its
+// requests to an allocator, and reports measurements of the replay.  We build
+// traces both with a 'bdlma::TracingAllocator' and by hand (to produce
+// invalid traces), replay them against test allocators, and verify the
+// requests issued and the measurements reported.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] int replay(result, trace, allocator, upstream = 0, scratch = 0);
+// [ 3] int replay(result, trace, allocator, upstream = 0, scratch = 0);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] USAGE EXAMPLE
+// [ *] CONCERN: In no case does memory come from the global allocator.
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+
+// ============================================================================
+//                  GLOBAL VARIABLES / TYPEDEFS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::TraceReplayUtil   Util;
+typedef bdlma::TraceReplayResult Result;
+typedef bdlma::TracingAllocator  TracingAllocator;
+typedef bsls::Types::Int64       Int64;
+typedef bsls::Types::Uint64      Uint64;
+
+// ============================================================================
+//                   HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+void appendVarint(bsl::string *trace, Uint64 value)
+    // Append the specified 'value' to the specified 'trace' as a LEB128
+    // integer.
+{
+    while (value >= 0x80) {
+        trace->push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    trace->push_back(static_cast<char>(value));
+}
+
+static
+void appendRecord(bsl::string *trace,
+                  int          kind,
+                  Uint64       address,
+                  Uint64       size = 0,
+                  Uint64       thread = 0,
+                  Uint64       delta = 0)
+    // Append to the specified 'trace' a record of the specified 'kind' for
+    // the specified 'address' and optionally specified 'size', 'thread', and
+    // 'delta'.  Note that 'size' is not written unless 'kind' is
+    // 'k_ALLOCATE'.
+{
+    trace->push_back(static_cast<char>(kind));
+    appendVarint(trace, thread);
+    appendVarint(trace, delta);
+    appendVarint(trace, address);
+    if (TracingAllocator::k_ALLOCATE == kind) {
+        appendVarint(trace, size);
+    }
+}
+
+static
+int replayString(Result                         *result,
+                 const bsl::string&              trace,
+                 bslma::Allocator               *allocator,
+                 const bdlma::CountingAllocator *upstream = 0)
+    // Replay the specified 'trace' against the specified 'allocator', with
+    // the optionally specified 'upstream' allocator, loading the measurements
+    // into the specified 'result', and return the value returned by
+    // 'TraceReplayUtil::replay'.
+{
+    bsl::stringbuf buffer(trace);
+    return Util::replay(result, &buffer, allocator, upstream);
+}
+
+// ============================================================================
+//                                MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    const bsl::string HEADER("BDTR\x01", 5);
+
+    switch (test) { case 0:
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da(veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Comparing Allocators on a Recorded Workload
+///- - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we have recorded a trace of the allocations of a workload with
+// a 'bdlma::TracingAllocator' (see 'bdlma_tracingallocator'):
+//..
+    bsl::stringbuf traceBuffer;
+    {
+        bdlma::TracingAllocator tracingAllocator(&traceBuffer);
+
+        bsl::vector<bsl::string> words(&tracingAllocator);
+        for (int i = 0; i < 100; ++i) {
+            words.push_back(bsl::string(40 + i % 10, 'x'));
+        }
+    }
+    const bsl::string trace = traceBuffer.str();
+//..
+// First, we replay the trace against a 'bdlma::MultipoolAllocator', measuring
+// its footprint through a counting allocator:
+//..
+    bdlma::TraceReplayResult multipoolResult;
+    {
+        bdlma::CountingAllocator  upstream;
+        bdlma::MultipoolAllocator allocator(&upstream);
+
+        bsl::stringbuf input(trace);
+        int rc = bdlma::TraceReplayUtil::replay(&multipoolResult,
+                                                &input,
+                                                &allocator,
+                                                &upstream);
+        ASSERT(0 == rc);
+    }
+//..
+// Then, we replay the same trace against a 'bdlma::SequentialAllocator':
+//..
+    bdlma::TraceReplayResult sequentialResult;
+    {
+        bdlma::CountingAllocator   upstream;
+        bdlma::SequentialAllocator allocator(&upstream);
+
+        bsl::stringbuf input(trace);
+        int rc = bdlma::TraceReplayUtil::replay(&sequentialResult,
+                                                &input,
+                                                &allocator,
+                                                &upstream);
+        ASSERT(0 == rc);
+    }
+//..
+// Now, we verify that both replays issued the same requests:
+//..
+    ASSERT(multipoolResult.d_numAllocations ==
+                                          sequentialResult.d_numAllocations);
+    ASSERT(multipoolResult.d_peakBytesRequested ==
+                                      sequentialResult.d_peakBytesRequested);
+//..
+// Finally, we compare the results.  A sequential allocator never reuses the
+// memory of deallocated blocks, so its footprint is at least the total number
+// of bytes requested:
+//..
+    ASSERT(sequentialResult.d_peakUpstreamBytes >=
+                                     sequentialResult.d_totalBytesRequested);
+//..
+
+        if (veryVerbose) {
+            P_(multipoolResult.d_peakUpstreamBytes)
+            P(sequentialResult.d_peakUpstreamBytes)
+            P_(multipoolResult.d_elapsedNanoseconds)
+            P(sequentialResult.d_elapsedNanoseconds)
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING INVALID TRACES
+        //
+        // Concerns:
+        //: 1 'replay' fails, without issuing any request and without
+        //:   modifying the result, for a trace with a missing or invalid
+        //:   header, a truncated record, a record of an unknown kind, an
+        //:   allocation of 0 bytes, an allocation of a block already in use,
+        //:   or a deallocation of a block not in use.
+        //:
+        //: 2 The memory used to decode an invalid trace is released.
+        //
+        // Plan:
+        //: 1 Replay each kind of invalid trace against a test allocator, and
+        //:   verify the return value, the result, and the use of the test
+        //:   allocator and of the default allocator.  (C-1..2)
+        //
+        // Testing:
+        //   int replay(result, trace, allocator, upstream = 0, scratch = 0);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING INVALID TRACES"
+                          << endl << "======================" << endl;
+
+        bslma::TestAllocator         da(veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        bsl::string valid(HEADER);
+        appendRecord(&valid, TracingAllocator::k_ALLOCATE,   0x1000, 8);
+        appendRecord(&valid, TracingAllocator::k_DEALLOCATE, 0x1000);
+
+        bsl::vector<bsl::string> TRACES;
+
+        TRACES.push_back("");                                   // empty
+        TRACES.push_back("BDTR");                               // short
+        TRACES.push_back(bsl::string("BDTX\x01", 5));           // magic
+        TRACES.push_back(bsl::string("BDTR\x02", 5));           // version
+        TRACES.push_back(valid.substr(0, valid.size() - 1));    // truncated
+        {
+            bsl::string t(HEADER);                              // bad kind
+            appendRecord(&t, 3, 0x1000);
+            TRACES.push_back(t);
+        }
+        {
+            bsl::string t(HEADER);                              // size 0
+            appendRecord(&t, TracingAllocator::k_ALLOCATE, 0x1000, 0);
+            TRACES.push_back(t);
+        }
+        {
+            bsl::string t(HEADER);                              // in use
+            appendRecord(&t, TracingAllocator::k_ALLOCATE, 0x1000, 8);
+            appendRecord(&t, TracingAllocator::k_ALLOCATE, 0x1000, 8);
+            TRACES.push_back(t);
+        }
+        {
+            bsl::string t(HEADER);                              // not in use
+            appendRecord(&t, TracingAllocator::k_ALLOCATE,   0x1000, 8);
+            appendRecord(&t, TracingAllocator::k_DEALLOCATE, 0x1000);
+            appendRecord(&t, TracingAllocator::k_DEALLOCATE, 0x1000);
+            TRACES.push_back(t);
+        }
+        {
+            bsl::string t(HEADER);                              // overlong
+            t.push_back(static_cast<char>(TracingAllocator::k_DEALLOCATE));
+            t.append(11, '\x80');
+            t.push_back('\x01');
+            TRACES.push_back(t);
+        }
+
+        for (size_t ti = 0; ti < TRACES.size(); ++ti) {
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Result mR;
+            bsl::memset(&mR, 0x5A, sizeof mR);
+            Result original = mR;
+
+            const Int64 NUM_IN_USE = da.numBlocksInUse();
+
+            const int rc = replayString(&mR, TRACES[ti], &ta);
+
+            LOOP_ASSERT(ti, 0 != rc);
+            LOOP_ASSERT(ti, 0 == ta.numBlocksTotal());
+            LOOP_ASSERT(ti, 0 == bsl::memcmp(&mR, &original, sizeof mR));
+            LOOP_ASSERT(ti, NUM_IN_USE == da.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nValid trace." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Result mR;
+            ASSERT(0 == replayString(&mR, valid, &ta));
+            ASSERT(1 == ta.numBlocksTotal());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+            bsl::stringbuf       buffer(valid);
+            Result               mR;
+
+            ASSERT_FAIL(Util::replay(0,   &buffer, &ta));
+            ASSERT_FAIL(Util::replay(&mR, 0,       &ta));
+            ASSERT_FAIL(Util::replay(&mR, &buffer, 0));
+            ASSERT_PASS(Util::replay(&mR, &buffer, &ta));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'replay'
+        //
+        // Concerns:
+        //: 1 Each recorded allocation is issued to the allocator under test
+        //:   with the recorded size, and each recorded deallocation returns
+        //:   the block obtained by the matching allocation, in the recorded
+        //:   order.
+        //:
+        //: 2 Blocks still in use at the end of the trace are deallocated.
+        //:
+        //: 3 The numbers of allocations and deallocations, the number of
+        //:   threads, the total and peak numbers of bytes requested, and the
+        //:   recorded duration are reported as recorded.
+        //:
+        //: 4 The peak number of bytes in use from an upstream allocator is
+        //:   reported, or -1 if no upstream allocator is supplied.
+        //:
+        //: 5 The memory of the decoded trace is supplied by the scratch
+        //:   allocator, if supplied, and by the default allocator otherwise.
+        //:
+        //: 6 A trace with no records is valid.
+        //:
+        //: 7 The trace is replayed once if no upstream allocator is supplied,
+        //:   and twice otherwise, the peak number of bytes in use from the
+        //:   upstream allocator being that of the first (untimed) replay.
+        //
+        // Plan:
+        //: 1 Build traces by hand, including addresses reused after
+        //:   deallocation and several threads, replay them against a test
+        //:   allocator (directly, and through a counting allocator), and
+        //:   verify the requests issued and the measurements.  (C-1..7)
+        //
+        // Testing:
+        //   int replay(result, trace, allocator, upstream = 0, scratch = 0);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING 'replay'"
+                          << endl << "================" << endl;
+
+        bslma::TestAllocator         da(veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        if (verbose) cout << "\nEmpty trace." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Result mR;
+            ASSERT(0 == replayString(&mR, HEADER, &ta));
+            ASSERT(0  == mR.d_numAllocations);
+            ASSERT(0  == mR.d_numDeallocations);
+            ASSERT(0  == mR.d_numThreads);
+            ASSERT(0  == mR.d_totalBytesRequested);
+            ASSERT(0  == mR.d_peakBytesRequested);
+            ASSERT(-1 == mR.d_peakUpstreamBytes);
+            ASSERT(0  == mR.d_recordedNanoseconds);
+            ASSERT(0  <= mR.d_elapsedNanoseconds);
+            ASSERT(0  == ta.numBlocksTotal());
+        }
+
+        if (verbose) cout << "\nRequests and measurements." << endl;
+
+        // Address 0x10 is reused after its deallocation; the block at 0x30 is
+        // never deallocated.
+
+        bsl::string trace(HEADER);
+        appendRecord(&trace, TracingAllocator::k_ALLOCATE,   0x10, 100, 0, 5);
+        appendRecord(&trace, TracingAllocator::k_ALLOCATE,   0x20, 200, 2, 5);
+        appendRecord(&trace, TracingAllocator::k_DEALLOCATE, 0x10,   0, 0, 5);
+        appendRecord(&trace, TracingAllocator::k_ALLOCATE,   0x10,  50, 1, 5);
+        appendRecord(&trace, TracingAllocator::k_ALLOCATE,   0x30, 300, 0, 5);
+        appendRecord(&trace, TracingAllocator::k_DEALLOCATE, 0x20,   0, 2, 5);
+        appendRecord(&trace, TracingAllocator::k_DEALLOCATE, 0x10,   0, 0, 5);
+
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            bslma::TestAllocator sa(veryVeryVerbose);
+
+            bsl::stringbuf buffer(trace);
+            Result         mR;
+
+            const Int64 NUM_TOTAL = da.numBlocksTotal();
+
+            ASSERT(0 == Util::replay(&mR, &buffer, &ta, 0, &sa));
+
+            ASSERT(4   == mR.d_numAllocations);
+            ASSERT(3   == mR.d_numDeallocations);
+            ASSERT(3   == mR.d_numThreads);
+            ASSERT(650 == mR.d_totalBytesRequested);
+            ASSERT(550 == mR.d_peakBytesRequested);
+            ASSERT(-1  == mR.d_peakUpstreamBytes);
+            ASSERT(35  == mR.d_recordedNanoseconds);
+            ASSERT(0   <= mR.d_elapsedNanoseconds);
+
+            ASSERT(4   == ta.numBlocksTotal());
+            ASSERT(0   == ta.numBlocksInUse());
+            ASSERT(300 == ta.lastAllocatedNumBytes());
+            ASSERT(0   <  sa.numBlocksTotal());
+            ASSERT(0   == sa.numBlocksInUse());
+            ASSERT(NUM_TOTAL == da.numBlocksTotal());
+        }
+
+        if (verbose) cout << "\nUpstream allocator." << endl;
+        {
+            bslma::TestAllocator     ta(veryVeryVerbose);
+            bdlma::CountingAllocator upstream(&ta);
+
+            const Int64 NUM_TOTAL  = da.numBlocksTotal();
+            const Int64 NUM_IN_USE = da.numBlocksInUse();
+
+            Result mR;
+            ASSERT(0 == replayString(&mR, trace, &upstream, &upstream));
+
+            ASSERT(550        == mR.d_peakUpstreamBytes);
+            ASSERT(0          == upstream.numBytesInUse());
+            ASSERT(NUM_TOTAL  <  da.numBlocksTotal());
+            ASSERT(NUM_IN_USE == da.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nRecorded trace." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            bsl::stringbuf       buffer;
+            {
+                TracingAllocator tracer(&buffer, &ta);
+
+                void *p = tracer.allocate(10);
+                void *q = tracer.allocate(20);
+                tracer.deallocate(p);
+                p = tracer.allocate(30);
+                tracer.deallocate(q);
+                tracer.deallocate(p);
+            }
+
+            bslma::TestAllocator     oa(veryVeryVerbose);
+            bdlma::CountingAllocator upstream(&oa);
+
+            Result mR;
+            ASSERT(0 == replayString(&mR, buffer.str(), &upstream, &upstream));
+
+            ASSERT(3  == mR.d_numAllocations);
+            ASSERT(3  == mR.d_numDeallocations);
+            ASSERT(1  == mR.d_numThreads);
+            ASSERT(60 == mR.d_totalBytesRequested);
+            ASSERT(50 == mR.d_peakBytesRequested);
+            ASSERT(50 == mR.d_peakUpstreamBytes);
+            ASSERT(6  == oa.numBlocksTotal());
+            ASSERT(0  == oa.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nPeak of the first replay." << endl;
+        {
+            // A sequential allocator does not reuse deallocated memory, so
+            // the memory it holds grows over the second replay.
+
+            bsl::string large(HEADER);
+            appendRecord(&large, TracingAllocator::k_ALLOCATE,   0x10, 5000,
+                         0, 5);
+            appendRecord(&large, TracingAllocator::k_DEALLOCATE, 0x10,    0,
+                         0, 5);
+
+            bslma::TestAllocator     oa(veryVeryVerbose);
+            bdlma::CountingAllocator upstream(&oa);
+
+            Result mR;
+            {
+                bdlma::SequentialAllocator sequential(&upstream);
+
+                ASSERT(0 == replayString(&mR, large, &sequential, &upstream));
+
+                ASSERTV(mR.d_peakUpstreamBytes, upstream.numBytesInUse(),
+                        mR.d_peakUpstreamBytes <  upstream.numBytesInUse());
+            }
+            ASSERT(5000 <= mR.d_peakUpstreamBytes);
+            ASSERT(0    == upstream.numBytesInUse());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Record a trace with a tracing allocator, replay it against a
+        //:   test allocator, and verify the result.
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator         da(veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        bsl::stringbuf       buffer;
+        {
+            TracingAllocator tracer(&buffer, &ta);
+            tracer.deallocate(tracer.allocate(64));
+        }
+
+        bslma::TestAllocator oa(veryVeryVerbose);
+        Result               mR;
+
+        ASSERT(0  == replayString(&mR, buffer.str(), &oa));
+        ASSERT(1  == mR.d_numAllocations);
+        ASSERT(1  == mR.d_numDeallocations);
+        ASSERT(64 == mR.d_peakBytesRequested);
+        ASSERT(1  == oa.numBlocksTotal());
+        ASSERT(0  == oa.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
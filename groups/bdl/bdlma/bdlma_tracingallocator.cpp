@@ -0,0 +1,178 @@
+// bdlma_tracingallocator.cpp                                         -*-C++-*-
+#include <bdlma_tracingallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_tracingallocator_cpp,"$Id$ $CSID$")
+
+#include <bslma_default.h>
+
+#include <bsls_assert.h>
+#include <bsls_threadlocal.h>
+#include <bsls_timeutil.h>
+
+#include <bsl_ios.h>                 // 'bsl::streamsize'
+
+namespace BloombergLP {
+namespace bdlma {
+namespace {
+
+enum {
+    k_MAX_VARINT_SIZE = 10,  // maximum size of an encoded 64-bit integer
+
+    k_MAX_RECORD_SIZE = 1 + 4 * k_MAX_VARINT_SIZE
+                             // maximum size of an encoded record
+};
+
+static bsls::AtomicOperations::AtomicTypes::Int64 s_numThreads = { 0 };
+    // number of threads that have been assigned an index
+
+static BSLS_THREADLOCAL bsls::Types::Uint64 s_threadIndexPlusOne = 0;
+    // index of the calling thread plus one, or 0 if not yet assigned
+
+inline
+char *encodeVarint(char *buffer, bsls::Types::Uint64 value)
+    // Write the specified 'value' to the specified 'buffer' as an unsigned
+    // LEB128 integer, and return the address one past the last byte written.
+{
+    while (value >= 0x80) {
+        *buffer++ = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    *buffer++ = static_cast<char>(value);
+    return buffer;
+}
+
+}  // close unnamed namespace
+
+                           // ----------------------
+                           // class TracingAllocator
+                           // ----------------------
+
+// PRIVATE MANIPULATORS
+void TracingAllocator::writeRecord(EventKind   kind,
+                                   const void *address,
+                                   size_type   size)
+{
+    const bsls::Types::Uint64 thread = threadIndex();
+
+    char  record[k_MAX_RECORD_SIZE];
+    char *end = record;
+
+    *end++ = static_cast<char>(kind);
+    end    = encodeVarint(end, thread);
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    const bsls::Types::Int64 now   = bsls::TimeUtil::getTimer();
+    const bsls::Types::Int64 delta = now - d_lastTimestamp;
+
+    d_lastTimestamp = now;
+
+    end = encodeVarint(end, delta > 0 ? delta : 0);
+    end = encodeVarint(end, reinterpret_cast<bsls::Types::UintPtr>(address));
+    if (k_ALLOCATE == kind) {
+        end = encodeVarint(end, size);
+    }
+
+    const bsl::streamsize length = end - record;
+
+    if (length != d_trace_p->sputn(record, length)) {
+        d_isValid = false;
+    }
+    d_numEvents.addRelaxed(1);
+}
+
+// CLASS METHODS
+bsls::Types::Uint64 TracingAllocator::threadIndex()
+{
+    if (0 == s_threadIndexPlusOne) {
+        s_threadIndexPlusOne =
+                  bsls::AtomicOperations::addInt64NvRelaxed(&s_numThreads, 1);
+    }
+    return s_threadIndexPlusOne - 1;
+}
+
+// CREATORS
+TracingAllocator::TracingAllocator(bsl::streambuf   *trace,
+                                   bslma::Allocator *basicAllocator)
+: d_trace_p(trace)
+, d_lastTimestamp(bsls::TimeUtil::getTimer())
+, d_numEvents(0)
+, d_isValid(true)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(trace);
+
+    const char header[k_HEADER_SIZE] = { 'B', 'D', 'T', 'R', k_VERSION };
+
+    if (k_HEADER_SIZE != d_trace_p->sputn(header, k_HEADER_SIZE)) {
+        d_isValid = false;
+    }
+}
+
+TracingAllocator::~TracingAllocator()
+{
+    flush();
+}
+
+// MANIPULATORS
+void *TracingAllocator::allocate(size_type size)
+{
+    if (0 == size) {
+        return 0;                                                     // RETURN
+    }
+
+    void *address = d_allocator_p->allocate(size);
+
+    writeRecord(k_ALLOCATE, address, size);
+
+    return address;
+}
+
+void TracingAllocator::deallocate(void *address)
+{
+    if (0 == address) {
+        return;                                                       // RETURN
+    }
+
+    // Record the deallocation before the block can be reused by another
+    // thread.
+
+    writeRecord(k_DEALLOCATE, address, 0);
+
+    d_allocator_p->deallocate(address);
+}
+
+int TracingAllocator::flush()
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    return d_trace_p->pubsync();
+}
+
+// ACCESSORS
+bool TracingAllocator::isValid() const
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    return d_isValid;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
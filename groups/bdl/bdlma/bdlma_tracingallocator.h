@@ -0,0 +1,295 @@
+// bdlma_tracingallocator.h                                           -*-C++-*-
+#ifndef INCLUDED_BDLMA_TRACINGALLOCATOR
+#define INCLUDED_BDLMA_TRACINGALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an allocator recording a binary trace of its use.
+//
+//@CLASSES:
+//  bdlma::TracingAllocator: allocator writing a trace of allocation events
+//
+//@SEE_ALSO: bdlma_tracereplayutil, bdlma_countingallocator
+//
+//@DESCRIPTION: This component provides a concrete allocator,
+// 'bdlma::TracingAllocator', that implements the 'bslma::Allocator' protocol
+// by forwarding each request to a delegate allocator, and writes a compact
+// binary record of each allocation and deallocation to a 'bsl::streambuf'
+// supplied at construction.  The resulting *allocation* *trace* captures the
+// sequence of requests made by an application, and can be replayed against
+// other allocators with 'bdlma::TraceReplayUtil' to compare their throughput
+// and memory footprint on the workload of the application, without modifying
+// the application itself.
+//..
+//   ,-----------------------.
+//  ( bdlma::TracingAllocator )
+//   `-----------------------'
+//               |         ctor/dtor
+//               |         flush
+//               |         isValid
+//               |         numEvents
+//               V
+//     ,----------------.
+//    ( bslma::Allocator )
+//     `----------------'
+//                       allocate
+//                       deallocate
+//..
+//
+///Trace Format
+///------------
+// A trace consists of a header followed by one record per event.  All integers
+// are encoded as unsigned LEB128 variable-length integers (seven bits per
+// byte, least significant group first, the high bit of each byte set on all
+// but the last byte), so that a typical record occupies 8 to 12 bytes.  The
+// header is the four bytes 'B', 'D', 'T', 'R', followed by a version byte
+// (currently 1).  Each record is:
+//..
+//  +------+--------+-----------+---------+--------+
+//  | kind | thread | timestamp | address | [size] |
+//  +------+--------+-----------+---------+--------+
+//..
+// where:
+//
+//: 'kind':      one byte, 'k_ALLOCATE' (1) or 'k_DEALLOCATE' (2)
+//:
+//: 'thread':    the index of the recording thread, assigned in the order in
+//:              which threads first use any tracing allocator, starting at 0
+//:
+//: 'timestamp': the number of nanoseconds elapsed since the previous record
+//:              (or since the construction of the allocator, for the first
+//:              record)
+//:
+//: 'address':   the address of the block in the recording process, which
+//:              identifies the block among the blocks in use at that point of
+//:              the trace
+//:
+//: 'size':      the size (in bytes) of the request, present for allocations
+//:              only
+//
+// Allocations of 0 bytes and deallocations of the null pointer are not
+// recorded.
+//
+///Thread Safety
+///-------------
+// 'bdlma::TracingAllocator' is *fully thread-safe*, meaning that any operation
+// on the same object can be safely invoked from any thread, provided that the
+// delegate allocator is fully thread-safe as well.  Records are written under
+// a lock, in an order consistent with the use of the blocks: the deallocation
+// of a block is recorded before the block is returned to the delegate, and an
+// allocation is recorded after the block is obtained from it, so that a trace
+// never shows a block in use twice.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Recording the Allocations of a Workload
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we want to select the allocator best suited for a
+// 'bsl::vector' of strings built by our application.  We start by recording a
+// trace of the allocations of the workload.
+//
+// First, we create a stream buffer to hold the trace (in practice, a file
+// buffer), and a tracing allocator writing to it:
+//..
+//  bsl::stringbuf traceBuffer;
+//
+//  bdlma::TracingAllocator tracingAllocator(&traceBuffer);
+//..
+// Then, we run the workload, supplying the tracing allocator to the objects
+// whose allocations we want to capture:
+//..
+//  {
+//      bsl::vector<bsl::string> words(&tracingAllocator);
+//
+//      for (int i = 0; i < 100; ++i) {
+//          words.push_back(bsl::string(40 + i % 10, 'x'));
+//      }
+//  }
+//..
+// Next, we flush the allocator, and verify that all of its events were
+// written:
+//..
+//  tracingAllocator.flush();
+//
+//  assert(tracingAllocator.isValid());
+//  assert(0 < tracingAllocator.numEvents());
+//..
+// Finally, we observe that the trace is compact:
+//..
+//  assert(static_cast<bsls::Types::Int64>(traceBuffer.str().size()) <
+//                                 16 * (5 + tracingAllocator.numEvents()));
+//..
+// See 'bdlma_tracereplayutil' for replaying this trace against candidate
+// allocators.
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLLOCK
+#include <bsls_bsllock.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_STREAMBUF
+#include <bsl_streambuf.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                           // ======================
+                           // class TracingAllocator
+                           // ======================
+
+class TracingAllocator : public bslma::Allocator {
+    // This class defines a concrete thread-safe allocator mechanism that
+    // implements the 'bslma::Allocator' protocol by forwarding each request to
+    // a delegate allocator, and writes a record of each allocation and
+    // deallocation to a stream buffer, in the format described in the
+    // component-level documentation.
+
+  public:
+    // TYPES
+    enum EventKind {
+        // Enumerate the kinds of trace records.
+
+        k_ALLOCATE   = 1,  // allocation of a block
+        k_DEALLOCATE = 2   // deallocation of a block
+    };
+
+    enum {
+        k_VERSION     = 1,  // version of the trace format
+        k_HEADER_SIZE = 5   // size (in bytes) of the header of a trace
+    };
+
+  private:
+    // DATA
+    bsl::streambuf     *d_trace_p;        // destination of the trace (held,
+                                          // not owned)
+
+    bsls::Types::Int64  d_lastTimestamp;  // time (in nanoseconds) of the last
+                                          // record
+
+    bsls::AtomicInt64   d_numEvents;      // number of records written
+
+    bool                d_isValid;        // 'false' if any write failed
+
+    mutable bsls::BslLock
+                        d_lock;           // serializes the records
+
+    bslma::Allocator   *d_allocator_p;    // delegate allocator (held, not
+                                          // owned)
+
+    // NOT IMPLEMENTED
+    TracingAllocator(const TracingAllocator&);
+    TracingAllocator& operator=(const TracingAllocator&);
+
+  private:
+    // PRIVATE MANIPULATORS
+    void writeRecord(EventKind kind, const void *address, size_type size);
+        // Write to the trace a record of the specified 'kind' for the block at
+        // the specified 'address' of the specified 'size'.  Note that 'size'
+        // is ignored unless 'k_ALLOCATE == kind'.
+
+  public:
+    // CLASS METHODS
+    static bsls::Types::Uint64 threadIndex();
+        // Return the index of the calling thread in the traces written by
+        // objects of this class.  Threads are numbered from 0 in the order in
+        // which they first call this method (directly, or through any tracing
+        // allocator).
+
+    // CREATORS
+    explicit
+    TracingAllocator(bsl::streambuf   *trace,
+                     bslma::Allocator *basicAllocator = 0);
+        // Create a tracing allocator that writes a trace of its use, starting
+        // with the trace header, to the specified 'trace' stream buffer.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless 'trace' outlives this
+        // object.
+
+    virtual ~TracingAllocator();
+        // Destroy this allocator, flushing its trace.  Note that blocks still
+        // allocated from this allocator are *not* released.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return a newly-allocated block of memory of (at least) the specified
+        // positive 'size' (in bytes), obtained from the delegate allocator,
+        // and record the allocation to the trace.  If 'size' is 0, a null
+        // pointer is returned with no other effect.
+
+    virtual void deallocate(void *address);
+        // Record the deallocation of the memory block at the specified
+        // 'address' to the trace, and return it to the delegate allocator.  If
+        // 'address' is 0, this function has no effect.  The behavior is
+        // undefined unless 'address' was allocated using this allocator object
+        // and has not already been deallocated.
+
+    int flush();
+        // Synchronize the trace stream buffer with its destination.  Return 0
+        // on success, and a non-zero value otherwise.
+
+    // ACCESSORS
+    bool isValid() const;
+        // Return 'true' if every record was successfully written to the trace,
+        // and 'false' otherwise.
+
+    bsls::Types::Int64 numEvents() const;
+        // Return the number of records written to the trace.
+};
+
+// ============================================================================
+//                          INLINE DEFINITIONS
+// ============================================================================
+
+                           // ----------------------
+                           // class TracingAllocator
+                           // ----------------------
+
+// ACCESSORS
+inline
+bsls::Types::Int64 TracingAllocator::numEvents() const
+{
+    return d_numEvents.loadRelaxed();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
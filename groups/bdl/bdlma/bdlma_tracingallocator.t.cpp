@@ -0,0 +1,728 @@
+// bdlma_tracingallocator.t.cpp                                       -*-C++-*-
+#include <bdlma_tracingallocator.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_streambuf.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                TEST PLAN
+// ----------------------------------------------------------------------------
+//                                 Overview
+//                                 --------
+// 'bdlma::TracingAllocator' is an allocator that forwards each request to a
+// delegate allocator and writes a record of it to a stream buffer.  We verify
+// that requests are forwarded, and that the trace is written in the
+// documented format by decoding it in the test driver.  We also verify that
+// write failures are detected, and that the records of concurrent threads are
+// complete and consistent.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 5] static bsls::Types::Uint64 threadIndex();
+//
+// CREATORS
+// [ 2] explicit TracingAllocator(bsl::streambuf *trace, Allocator *ba = 0);
+// [ 2] ~TracingAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 3] void deallocate(void *address);
+// [ 2] int flush();
+//
+// ACCESSORS
+// [ 4] bool isValid() const;
+// [ 3] bsls::Types::Int64 numEvents() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] USAGE EXAMPLE
+// [ 5] CONCERN: Concurrent records are complete and consistent.
+// [ *] CONCERN: In no case does memory come from the global allocator.
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+
+// ============================================================================
+//                  GLOBAL VARIABLES / TYPEDEFS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::TracingAllocator Obj;
+typedef bsls::Types::Uint64     Uint64;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+// ============================================================================
+//                   HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+struct Record {
+    // This 'struct' holds a decoded trace record.
+
+    int    d_kind;
+    Uint64 d_thread;
+    Uint64 d_delta;
+    Uint64 d_address;
+    Uint64 d_size;
+};
+
+static
+bool decodeVarint(Uint64 *value, const bsl::string& trace, size_t *position)
+    // Load into the specified 'value' the LEB128 integer at the specified
+    // 'position' of the specified 'trace', and advance 'position' past it.
+    // Return 'true' on success, and 'false' if 'trace' ends first.
+{
+    Uint64 result = 0;
+    for (int shift = 0; *position < trace.size(); shift += 7) {
+        const unsigned char byte = trace[(*position)++];
+        result |= static_cast<Uint64>(byte & 0x7F) << shift;
+        if (0 == (byte & 0x80)) {
+            *value = result;
+            return true;                                              // RETURN
+        }
+    }
+    return false;
+}
+
+static
+bool decodeTrace(bsl::vector<Record> *records, const bsl::string& trace)
+    // Load into the specified 'records' the records of the specified 'trace'.
+    // Return 'true' if 'trace' has a valid header and consists of complete
+    // records, and 'false' otherwise.
+{
+    if (trace.size() < 5 || trace.compare(0, 4, "BDTR") || 1 != trace[4]) {
+        return false;                                                 // RETURN
+    }
+
+    size_t position = 5;
+    while (position < trace.size()) {
+        Record record = { trace[position++], 0, 0, 0, 0 };
+
+        if (!decodeVarint(&record.d_thread,  trace, &position)
+         || !decodeVarint(&record.d_delta,   trace, &position)
+         || !decodeVarint(&record.d_address, trace, &position)) {
+            return false;                                             // RETURN
+        }
+        if (Obj::k_ALLOCATE == record.d_kind) {
+            if (!decodeVarint(&record.d_size, trace, &position)) {
+                return false;                                         // RETURN
+            }
+        }
+        else if (Obj::k_DEALLOCATE != record.d_kind) {
+            return false;                                             // RETURN
+        }
+        records->push_back(record);
+    }
+    return true;
+}
+
+static
+Uint64 addressOf(const void *address)
+    // Return the specified 'address' as recorded in a trace.
+{
+    return reinterpret_cast<bsls::Types::UintPtr>(address);
+}
+
+class FailingStreamBuf : public bsl::streambuf {
+    // This stream buffer accepts at most a fixed number of characters, and
+    // fails to write any further characters.
+
+    int d_capacity;  // number of characters still accepted
+
+  protected:
+    virtual bsl::streamsize xsputn(const char *, bsl::streamsize count)
+        // Accept the specified 'count' characters if the capacity allows, and
+        // return the number of characters accepted.
+    {
+        const bsl::streamsize n = count < d_capacity ? count : d_capacity;
+        d_capacity -= static_cast<int>(n);
+        return n;
+    }
+
+  public:
+    explicit FailingStreamBuf(int capacity)
+        // Create a stream buffer accepting the specified 'capacity'
+        // characters.
+    : d_capacity(capacity)
+    {
+    }
+};
+
+enum { k_NUM_THREADS = 4, k_NUM_ITERATIONS = 500 };
+
+struct ThreadArgs {
+    // This 'struct' holds the input and results of 'threadFunction'.
+
+    Obj    *d_allocator_p;  // allocator under test
+    Uint64  d_index;        // 'threadIndex' of the thread
+};
+
+extern "C"
+void *threadFunction(void *arg)
+    // Allocate and deallocate blocks from the allocator in the specified
+    // 'arg', the address of a 'ThreadArgs' object, and record the index of
+    // the calling thread into it.
+{
+    ThreadArgs *args = static_cast<ThreadArgs *>(arg);
+
+    args->d_index = Obj::threadIndex();
+
+    for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+        void *p = args->d_allocator_p->allocate(1 + i % 64);
+        void *q = args->d_allocator_p->allocate(8);
+        args->d_allocator_p->deallocate(p);
+        args->d_allocator_p->deallocate(q);
+    }
+    return 0;
+}
+
+// ============================================================================
+//                                MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da(veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Recording the Allocations of a Workload
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we want to select the allocator best suited for a
+// 'bsl::vector' of strings built by our application.  We start by recording a
+// trace of the allocations of the workload.
+//
+// First, we create a stream buffer to hold the trace (in practice, a file
+// buffer), and a tracing allocator writing to it:
+//..
+    bsl::stringbuf traceBuffer;
+
+    bdlma::TracingAllocator tracingAllocator(&traceBuffer);
+//..
+// Then, we run the workload, supplying the tracing allocator to the objects
+// whose allocations we want to capture:
+//..
+    {
+        bsl::vector<bsl::string> words(&tracingAllocator);
+
+        for (int i = 0; i < 100; ++i) {
+            words.push_back(bsl::string(40 + i % 10, 'x'));
+        }
+    }
+//..
+// Next, we flush the allocator, and verify that all of its events were
+// written:
+//..
+    tracingAllocator.flush();
+
+    ASSERT(tracingAllocator.isValid());
+    ASSERT(0 < tracingAllocator.numEvents());
+//..
+// Finally, we observe that the trace is compact:
+//..
+    ASSERT(static_cast<bsls::Types::Int64>(traceBuffer.str().size()) <
+                                   16 * (5 + tracingAllocator.numEvents()));
+//..
+
+        if (veryVerbose) {
+            P_(tracingAllocator.numEvents()) P(traceBuffer.str().size())
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING CONCURRENCY
+        //
+        // Concerns:
+        //: 1 'threadIndex' returns the same value for each call from a thread,
+        //:   and distinct values for distinct threads.
+        //:
+        //: 2 The records of concurrent allocations and deallocations are all
+        //:   written, each complete, and tagged with the index of the thread
+        //:   that made the request.
+        //:
+        //: 3 The trace never shows a block in use twice, and never shows the
+        //:   deallocation of a block not in use.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate blocks from several threads, decode the
+        //:   trace, and verify the number of records of each thread, and the
+        //:   sequence of allocations and deallocations of each address.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   static bsls::Types::Uint64 threadIndex();
+        //   CONCERN: Concurrent records are complete and consistent.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING CONCURRENCY"
+                          << endl << "===================" << endl;
+
+        const Uint64 MAIN_INDEX = Obj::threadIndex();
+        ASSERT(MAIN_INDEX == Obj::threadIndex());
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        bsl::stringbuf       buffer;
+        ThreadArgs           args[k_NUM_THREADS];
+        {
+            Obj mX(&buffer, &ta);  const Obj& X = mX;
+
+            ThreadId ids[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                args[i].d_allocator_p = &mX;
+                args[i].d_index       = MAIN_INDEX;
+                ids[i] = createThread(&threadFunction, &args[i]);
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                joinThread(ids[i]);
+            }
+
+            ASSERT(4 * k_NUM_THREADS * k_NUM_ITERATIONS == X.numEvents());
+            ASSERT(X.isValid());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            LOOP_ASSERT(i, MAIN_INDEX != args[i].d_index);
+            for (int j = 0; j < i; ++j) {
+                LOOP2_ASSERT(i, j, args[i].d_index != args[j].d_index);
+            }
+        }
+
+        bsl::vector<Record> records;
+        ASSERT(decodeTrace(&records, buffer.str()));
+        ASSERT(4 * k_NUM_THREADS * k_NUM_ITERATIONS == records.size());
+
+        int                 counts[k_NUM_THREADS] = { 0 };
+        bsl::vector<Uint64> inUse;  // addresses of the blocks in use
+
+        for (size_t i = 0; i < records.size(); ++i) {
+            const Record& R = records[i];
+
+            for (int t = 0; t < k_NUM_THREADS; ++t) {
+                counts[t] += R.d_thread == args[t].d_index;
+            }
+
+            bsl::vector<Uint64>::iterator it = inUse.begin();
+            while (it != inUse.end() && *it != R.d_address) {
+                ++it;
+            }
+
+            if (Obj::k_ALLOCATE == R.d_kind) {
+                LOOP_ASSERT(i, inUse.end() == it);
+                inUse.push_back(R.d_address);
+            }
+            else {
+                LOOP_ASSERT(i, inUse.end() != it);
+                if (inUse.end() != it) {
+                    inUse.erase(it);
+                }
+            }
+        }
+        ASSERT(inUse.empty());
+
+        for (int t = 0; t < k_NUM_THREADS; ++t) {
+            LOOP2_ASSERT(t, counts[t], 4 * k_NUM_ITERATIONS == counts[t]);
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING WRITE FAILURES
+        //
+        // Concerns:
+        //: 1 A failure to write the header or a record makes 'isValid' return
+        //:   'false', and has no other effect: requests are still served by
+        //:   the delegate allocator.
+        //
+        // Plan:
+        //: 1 Using a stream buffer accepting a limited number of characters,
+        //:   verify 'isValid' before and after the capacity is exceeded.
+        //:   (C-1)
+        //
+        // Testing:
+        //   bool isValid() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING WRITE FAILURES"
+                          << endl << "======================" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        {
+            FailingStreamBuf buffer(3);
+            Obj              mX(&buffer, &ta);  const Obj& X = mX;
+
+            ASSERT(!X.isValid());
+        }
+        {
+            FailingStreamBuf buffer(5 + 8);
+            Obj              mX(&buffer, &ta);  const Obj& X = mX;
+
+            ASSERT(X.isValid());
+
+            void *p = mX.allocate(8);
+            ASSERT(0 != p);
+            ASSERT(1 == ta.numBlocksInUse());
+            ASSERT(1 == X.numEvents());
+
+            mX.deallocate(p);
+            ASSERT(0 == ta.numBlocksInUse());
+            ASSERT(2 == X.numEvents());
+            ASSERT(!X.isValid());
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocate' AND 'deallocate'
+        //
+        // Concerns:
+        //: 1 Requests are forwarded to the delegate allocator.
+        //:
+        //: 2 Each allocation and deallocation is recorded, in order, with the
+        //:   documented kind, thread, address, and (for allocations) size.
+        //:
+        //: 3 Allocations of 0 bytes, and deallocations of 0, are not recorded
+        //:   and have no effect.
+        //:
+        //: 4 Sizes and addresses requiring several bytes are encoded
+        //:   correctly.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate blocks of a range of sizes, decode the
+        //:   trace, and verify each record, 'numEvents', and the use of the
+        //:   delegate allocator.  (C-1..4)
+        //
+        // Testing:
+        //   void *allocate(size_type size);
+        //   void deallocate(void *address);
+        //   bsls::Types::Int64 numEvents() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'allocate' AND 'deallocate'" << endl
+                          << "===================================" << endl;
+
+        static const int SIZES[] = { 1, 2, 127, 128, 129, 1000, 16383,
+                                     16384, 100000 };
+        const int NUM_SIZES = static_cast<int>(sizeof SIZES / sizeof *SIZES);
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        bsl::stringbuf       buffer;
+        void                *blocks[NUM_SIZES];
+        {
+            Obj mX(&buffer, &ta);  const Obj& X = mX;
+
+            ASSERT(0 == mX.allocate(0));
+            mX.deallocate(0);
+            ASSERT(0 == X.numEvents());
+            ASSERT(0 == ta.numBlocksTotal());
+
+            for (int i = 0; i < NUM_SIZES; ++i) {
+                blocks[i] = mX.allocate(SIZES[i]);
+                LOOP_ASSERT(i, i + 1 == ta.numBlocksInUse());
+                LOOP_ASSERT(i, i + 1 == X.numEvents());
+            }
+            for (int i = NUM_SIZES - 1; 0 <= i; --i) {
+                mX.deallocate(blocks[i]);
+                LOOP_ASSERT(i, i == ta.numBlocksInUse());
+            }
+            ASSERT(2 * NUM_SIZES == X.numEvents());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        bsl::vector<Record> records;
+        ASSERT(decodeTrace(&records, buffer.str()));
+        ASSERT(2 * NUM_SIZES == static_cast<int>(records.size()));
+
+        const Uint64 THREAD = Obj::threadIndex();
+
+        for (int i = 0; i < NUM_SIZES; ++i) {
+            const Record& A = records[i];
+            const Record& D = records[2 * NUM_SIZES - 1 - i];
+
+            LOOP_ASSERT(i, Obj::k_ALLOCATE   == A.d_kind);
+            LOOP_ASSERT(i, THREAD            == A.d_thread);
+            LOOP_ASSERT(i, addressOf(blocks[i]) == A.d_address);
+            LOOP_ASSERT(i, static_cast<Uint64>(SIZES[i]) == A.d_size);
+
+            LOOP_ASSERT(i, Obj::k_DEALLOCATE == D.d_kind);
+            LOOP_ASSERT(i, THREAD            == D.d_thread);
+            LOOP_ASSERT(i, addressOf(blocks[i]) == D.d_address);
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CREATORS AND 'flush'
+        //
+        // Concerns:
+        //: 1 The constructor writes the trace header, and nothing else.
+        //:
+        //: 2 The delegate allocator is the supplied or the default allocator.
+        //:
+        //: 3 'flush' synchronizes the stream buffer.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create objects with and without a test allocator, verify the
+        //:   trace written, and the allocator used by 'allocate'.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   explicit TracingAllocator(bsl::streambuf *trace, Allocator *ba);
+        //   ~TracingAllocator();
+        //   int flush();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING CREATORS AND 'flush'"
+                          << endl << "============================" << endl;
+
+        bslma::TestAllocator         da(veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        bslma::TestAllocator sa(veryVeryVerbose);  // for the trace buffers
+        bslma::TestAllocator ta(veryVeryVerbose);
+        {
+            bsl::stringbuf buffer(&sa);
+            Obj            mX(&buffer, &ta);  const Obj& X = mX;
+
+            ASSERT(bsl::string("BDTR\x01", 5) == buffer.str());
+            ASSERT(0 == X.numEvents());
+            ASSERT(X.isValid());
+            ASSERT(0 == mX.flush());
+
+            mX.deallocate(mX.allocate(4));
+            ASSERT(1 == ta.numBlocksTotal());
+            ASSERT(0 == da.numBlocksTotal());
+        }
+        {
+            bsl::stringbuf buffer(&sa);
+            Obj            mX(&buffer);
+
+            mX.deallocate(mX.allocate(4));
+            ASSERT(1 == da.numBlocksTotal());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            bsl::stringbuf buffer(&sa);
+
+            ASSERT_PASS(Obj(&buffer, &ta));
+            ASSERT_FAIL(Obj(0, &ta));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate a block, and verify the trace.
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        bsl::stringbuf       buffer;
+        {
+            Obj mX(&buffer, &ta);
+
+            void *p = mX.allocate(24);
+            ASSERT(1 == ta.numBlocksInUse());
+
+            mX.deallocate(p);
+            ASSERT(0 == ta.numBlocksInUse());
+            ASSERT(2 == mX.numEvents());
+            ASSERT(mX.isValid());
+        }
+
+        bsl::vector<Record> records;
+        ASSERT(decodeTrace(&records, buffer.str()));
+        ASSERT(2                 == records.size());
+        ASSERT(Obj::k_ALLOCATE   == records[0].d_kind);
+        ASSERT(24                == records[0].d_size);
+        ASSERT(Obj::k_DEALLOCATE == records[1].d_kind);
+        ASSERT(records[0].d_address == records[1].d_address);
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -7,11 +7,97 @@ BSLS_IDENT_RCSID(bdlt_currenttime_cpp,"$Id$ $CSID$")
 #include <bdlt_datetimeinterval.h>  // for testing only
 #include <bdlt_timeunitratio.h>     // for testing only
 
+#include <bsls_platform.h>
+#include <bsls_seqlock.h>
 #include <bsls_systemtime.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+#include <time.h>
+#endif
+
+#if defined(BSLS_PLATFORM_OS_LINUX) && defined(CLOCK_REALTIME_COARSE)
+#define BDLT_CURRENTTIME_COARSE_CLOCK 1
+#endif
 
 namespace BloombergLP {
 namespace bdlt {
 
+namespace {
+
+typedef bsls::AtomicOperations AtomicOps;
+
+enum {
+    // modes of 'CurrentTime::currentTimeCached'
+
+    e_MODE_UNKNOWN = 0,  // mode to be determined by the next call
+    e_MODE_DEFAULT = 1,  // read the system clock
+    e_MODE_COARSE  = 2,  // read the coarse clock
+    e_MODE_CACHE   = 3   // read the time cached by a recent call
+};
+
+const bsls::Types::Int64 k_NANOSECONDS_PER_SECOND = 1000 * 1000 * 1000;
+
+bsls::AtomicOperations::AtomicTypes::Int64 s_maxStalenessNanoseconds = {
+                                                                 1000 * 1000 };
+    // maximum staleness of the times returned by 'currentTimeCached'
+
+bsls::AtomicOperations::AtomicTypes::Int   s_cachedTimeMode = {
+                                                              e_MODE_UNKNOWN };
+    // mode of 'currentTimeCached', reset by 'setCachedTimeMaxStaleness'
+
+struct CachedTime {
+    // This 'struct' holds a time read from the system clock and the cycle
+    // count read just before it.
+
+    bsls::Types::Int64 d_cycles;       // cycle count preceding the read, or
+                                       // 0 if no time is cached
+
+    bsls::Types::Int64 d_nanoseconds;  // time read, in nanoseconds since the
+                                       // epoch
+};
+
+bsls::SeqLock<CachedTime> s_cachedTime;
+    // time cached by 'currentTimeCached', published as a pair so that no
+    // reader combines the cycle count of one refresh with the time of another
+    // (note that the zero-initialized state, preceding construction, holds
+    // no cached time)
+
+bsls::TimeInterval fromNanoseconds(bsls::Types::Int64 nanoseconds)
+    // Return the time interval of the specified 'nanoseconds'.
+{
+    bsls::TimeInterval result;
+    result.setTotalNanoseconds(nanoseconds);
+    return result;
+}
+
+int determineCachedTimeMode(bsls::Types::Int64 maxStalenessNanoseconds)
+    // Return the mode of 'currentTimeCached' for the specified
+    // 'maxStalenessNanoseconds': 'e_MODE_DEFAULT' if
+    // 'maxStalenessNanoseconds' is 0, 'e_MODE_COARSE' if the coarse clock is
+    // available and its resolution does not exceed 'maxStalenessNanoseconds',
+    // and 'e_MODE_CACHE' otherwise.
+{
+    if (0 == maxStalenessNanoseconds) {
+        return e_MODE_DEFAULT;                                        // RETURN
+    }
+
+#if defined(BDLT_CURRENTTIME_COARSE_CLOCK)
+    timespec resolution;
+    if (0 == clock_getres(CLOCK_REALTIME_COARSE, &resolution)
+     && resolution.tv_sec * k_NANOSECONDS_PER_SECOND + resolution.tv_nsec
+                                                  <= maxStalenessNanoseconds) {
+        return e_MODE_COARSE;                                         // RETURN
+    }
+#else
+    (void)maxStalenessNanoseconds;
+#endif
+    return e_MODE_CACHE;
+}
+
+}  // close unnamed namespace
+
                             // -----------------
                             // class CurrentTime
                             // -----------------
@@ -23,6 +109,80 @@ CurrentTime::s_currenttimeCallback_p =
 
 // CLASS METHODS
 
+                       // ** cached callback function **
+
+bsls::TimeInterval CurrentTime::cachedTimeMaxStaleness()
+{
+    return fromNanoseconds(
+                       AtomicOps::getInt64Relaxed(&s_maxStalenessNanoseconds));
+}
+
+bsls::TimeInterval CurrentTime::currentTimeCached()
+{
+    const bsls::Types::Int64 maxStaleness =
+                        AtomicOps::getInt64Relaxed(&s_maxStalenessNanoseconds);
+
+    int mode = AtomicOps::getIntRelaxed(&s_cachedTimeMode);
+    if (e_MODE_UNKNOWN == mode) {
+        mode = determineCachedTimeMode(maxStaleness);
+        AtomicOps::setIntRelaxed(&s_cachedTimeMode, mode);
+    }
+
+    if (e_MODE_DEFAULT == mode) {
+        return currentTimeDefault();                                  // RETURN
+    }
+
+#if defined(BDLT_CURRENTTIME_COARSE_CLOCK)
+    if (e_MODE_COARSE == mode) {
+        timespec now;
+        clock_gettime(CLOCK_REALTIME_COARSE, &now);
+        return bsls::TimeInterval(now.tv_sec,
+                                  static_cast<int>(now.tv_nsec));     // RETURN
+    }
+#endif
+
+    // The cached time was read no earlier than its cycle count, so its lag
+    // is at most the age of the cycle count.  A thread finding the cached
+    // time too old reads the system clock, and publishes the time read with
+    // the cycle count preceding it.  A thread finding the cached time being
+    // refreshed by another thread reads the system clock without publishing
+    // it, so that readers do not wait for, or pile onto, the refresh.
+
+    const bsls::Types::Int64 now = bsls::TimeUtil::getCycleCount();
+
+    CachedTime cached;
+    if (!s_cachedTime.tryLoad(&cached)) {
+        return currentTimeDefault();                                  // RETURN
+    }
+
+    if (0 != cached.d_cycles
+     && bsls::TimeUtil::convertCyclesToNanoseconds(now - cached.d_cycles)
+                                                             < maxStaleness) {
+        return fromNanoseconds(cached.d_nanoseconds);                 // RETURN
+    }
+
+    const bsls::TimeInterval result = currentTimeDefault();
+
+    cached.d_cycles      = now;
+    cached.d_nanoseconds = result.totalNanoseconds();
+    s_cachedTime.store(cached);
+
+    return result;
+}
+
+bsls::TimeInterval CurrentTime::setCachedTimeMaxStaleness(
+                                        const bsls::TimeInterval& maxStaleness)
+{
+    BSLS_ASSERT(bsls::TimeInterval() <= maxStaleness);
+
+    const bsls::Types::Int64 previous = AtomicOps::swapInt64AcqRel(
+                                             &s_maxStalenessNanoseconds,
+                                             maxStaleness.totalNanoseconds());
+
+    AtomicOps::setIntRelaxed(&s_cachedTimeMode, e_MODE_UNKNOWN);
+    return fromNanoseconds(previous);
+}
+
                        // ** default callbacks **
 
 bsls::TimeInterval CurrentTime::currentTimeDefault()
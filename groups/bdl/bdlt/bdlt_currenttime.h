@@ -19,6 +19,36 @@ BSLS_IDENT("$Id: $")
 // the local time zone of the executing process.  It also provides a facility
 // for customizing the means by which the time is retrieved.
 //
+///Cached Current Time
+///-------------------
+// Reading the system clock costs tens of nanoseconds (more where the clock
+// read is a system call), which is significant for applications timestamping
+// every message or log record.  'bdlt::CurrentTime::currentTimeCached' is an
+// alternative current-time callback that returns the current time with a
+// bounded *staleness*: the returned time may lag the system clock by up to the
+// maximum staleness set by 'setCachedTimeMaxStaleness' (1 millisecond by
+// default).  It is installed like any other callback:
+//..
+//  bdlt::CurrentTime::setCurrentTimeCallback(
+//                                      &bdlt::CurrentTime::currentTimeCached);
+//..
+// 'currentTimeCached' reads the cheapest of:
+//: o The coarse real-time clock of the platform (on Linux,
+//:   'CLOCK_REALTIME_COARSE', read without a system call), if its resolution
+//:   does not exceed the maximum staleness.
+//:
+//: o Otherwise, a time cached by the last call that read the system clock,
+//:   if the cycle counter (see 'bsls::TimeUtil::getCycleCount') shows that
+//:   the cached time is not older than the maximum staleness.  A call finding
+//:   the cached time too old reads the system clock, and refreshes the cached
+//:   time.  The cached time and its cycle count are published together
+//:   through a 'bsls::SeqLock', so that they are always read consistently.
+//
+// The staleness bound is approximate, as the cycle counter is calibrated
+// against the system clock.  Note that, as with the default callback,
+// successive times returned to different threads are not guaranteed to be
+// increasing.
+//
 ///Thread Safety
 ///-------------
 // The functions provided by 'bdlt::CurrentTime' are *thread-safe* (meaning
@@ -221,6 +251,28 @@ struct CurrentTime {
         // the interval between 'EpochUtil::epoch()' and the current date/time,
         // and return the previously set function.
 
+                        // ** cached callback function **
+
+    static bsls::TimeInterval cachedTimeMaxStaleness();
+        // Return the maximum duration by which the times returned by
+        // 'currentTimeCached' lag the system clock.
+
+    static bsls::TimeInterval currentTimeCached();
+        // Return the 'TimeInterval' value between 'EpochUtil::epoch()' and the
+        // current date/time, possibly lagging the system clock by up to
+        // (approximately) 'cachedTimeMaxStaleness()' (see 'Cached Current
+        // Time').  This function is a current-time callback that is cheaper
+        // than 'currentTimeDefault'.
+
+    static bsls::TimeInterval setCachedTimeMaxStaleness(
+                                       const bsls::TimeInterval& maxStaleness);
+        // Set the maximum duration by which the times returned by
+        // 'currentTimeCached' lag the system clock to the specified
+        // 'maxStaleness', and return the previous maximum staleness.  The
+        // behavior is undefined unless
+        // 'bsls::TimeInterval() <= maxStaleness'.  Note that a 'maxStaleness'
+        // of 0 makes 'currentTimeCached' read the system clock on each call.
+
                         // ** default callback function **
 
     static bsls::TimeInterval currentTimeDefault();
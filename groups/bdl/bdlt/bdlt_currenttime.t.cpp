@@ -14,6 +14,7 @@
 #include <bsl_ostream.h>
 
 #include <bsls_systemtime.h>
+#include <bsls_timeutil.h>
 
 #ifdef BSLS_PLATFORM_OS_WINDOWS
 #include <windows.h>
@@ -34,7 +35,8 @@ using namespace bsl;
 // Testing of 'bdlt::CurrentTime' consists of verifying that the various time
 // methods return non-decreasing values, including when called many times in
 // tight loops.  Additionally, the tests verify that the current-time callback
-// can be set, retrieved, and invoked correctly.
+// can be set, retrieved, and invoked correctly, and that the cached callback
+// returns times within its maximum staleness of the system clock.
 //
 // ----------------------------------------------------------------------------
 // [ 5] Datetime local()
@@ -42,9 +44,12 @@ using namespace bsl;
 // [ 4] Datetime utc()
 // [ 2] CurrentTimeCallback currentTimeCallback()
 // [ 2] CurrentTimeCallback setCurrentTimeCallback(CurrentTimeCallback)
+// [ 9] bsls::TimeInterval cachedTimeMaxStaleness()
+// [ 9] bsls::TimeInterval currentTimeCached()
+// [ 9] bsls::TimeInterval setCachedTimeMaxStaleness(const TimeInterval&)
 // [ 1] bsls::TimeInterval currentTimeDefault()
 // ----------------------------------------------------------------------------
-// [ 9] USAGE EXAMPLE
+// [10] USAGE EXAMPLE
 // [ 8] Datetime local() stress test
 // [ 6] bsls::TimeInterval now() stress test
 // [ 7] Datetime utc() stress test
@@ -243,6 +248,49 @@ static void *threadFunction(void *argument)
     return argument;
 }
 
+struct CachedTimeInfo {
+    // Data passed to 'cachedTimeThreadFunction'.
+
+    bsls::TimeInterval d_maxLag;     // largest lag of the cached times
+                                     // allowed
+
+    int                d_count;      // invoke 'currentTimeCached' this many
+                                     // times
+
+    int                d_numStale;   // number of cached times lagging the
+                                     // system clock by more than 'd_maxLag'
+
+    int                d_numFuture;  // number of cached times later than the
+                                     // system clock
+};
+
+static void *cachedTimeThreadFunction(void *argument)
+    // Using the 'CachedTimeInfo' data specified by 'argument', invoke
+    // 'currentTimeCached' between two invocations of 'currentTimeDefault',
+    // and count the cached times outside of the expected bounds.
+{
+    while (!bsls::AtomicOperations::getInt(&go)) {
+        // Wait for the starting gun.
+    }
+
+    CachedTimeInfo *info = static_cast<CachedTimeInfo *>(argument);
+
+    for (int i = 0; i < info->d_count; ++i) {
+        const bsls::TimeInterval before = Util::currentTimeDefault();
+        const bsls::TimeInterval cached = Util::currentTimeCached();
+        const bsls::TimeInterval after  = Util::currentTimeDefault();
+
+        if (cached < before - info->d_maxLag) {
+            ++info->d_numStale;
+        }
+        if (after < cached) {
+            ++info->d_numFuture;
+        }
+    }
+
+    return argument;
+}
+
 // ============================================================================
 //                             USAGE EXAMPLE
 // ----------------------------------------------------------------------------
@@ -371,7 +419,7 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
-      case 9: {
+      case 10: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   The usage example provided in the component header file must
@@ -391,6 +439,182 @@ int main(int argc, char *argv[])
 
         testApplication();
       } break;
+      case 9: {
+        // --------------------------------------------------------------------
+        // TESTING 'currentTimeCached'
+        //
+        // Concerns:
+        //: 1 The maximum staleness is initially 1 millisecond, and
+        //:   'setCachedTimeMaxStaleness' sets it and returns the previous
+        //:   maximum staleness.
+        //:
+        //: 2 'currentTimeCached' returns times no older than (approximately)
+        //:   the maximum staleness, and not later than the system clock.
+        //:
+        //: 3 'currentTimeCached' returns times that advance with the system
+        //:   clock.
+        //:
+        //: 4 'currentTimeCached' can be installed as the current-time
+        //:   callback.
+        //:
+        //: 5 When several threads refresh the cached time concurrently, no
+        //:   thread obtains a time older than the maximum staleness (i.e., the
+        //:   cached time and the cycle count at which it was read are read
+        //:   consistently).
+        //
+        // Plan:
+        //: 1 Verify the initial maximum staleness, set it to various values
+        //:   and verify the value returned by 'setCachedTimeMaxStaleness' and
+        //:   'cachedTimeMaxStaleness'.  (C-1)
+        //:
+        //: 2 For a maximum staleness of 0, 10 microseconds, 1 millisecond, and
+        //:   10 milliseconds, repeatedly invoke 'currentTimeCached' between
+        //:   two invocations of 'currentTimeDefault' and verify that the
+        //:   cached time is not later than the second default time, and not
+        //:   earlier than the first default time by more than the maximum
+        //:   staleness (allowing some slack for the duration of a read of the
+        //:   system clock, and for the coarse clock lagging the system clock
+        //:   by up to its resolution).  (C-2)
+        //:
+        //: 3 Invoke 'currentTimeCached' over a duration much larger than the
+        //:   maximum staleness and verify that the times returned advance.
+        //:   (C-3)
+        //:
+        //: 4 Install 'currentTimeCached' with 'setCurrentTimeCallback', and
+        //:   verify that 'now' returns times within the maximum staleness of
+        //:   the system clock.  (C-4)
+        //:
+        //: 5 With a maximum staleness of 100 microseconds, start several
+        //:   threads that each repeatedly invoke 'currentTimeCached' between
+        //:   two invocations of 'currentTimeDefault', and verify that no
+        //:   thread obtains a cached time later than the second default time,
+        //:   or earlier than the first default time by more than the maximum
+        //:   staleness (plus a margin for the calibration of the cycle
+        //:   counter).  (C-5)
+        //
+        // Testing:
+        //   bsls::TimeInterval cachedTimeMaxStaleness()
+        //   bsls::TimeInterval currentTimeCached()
+        //   bsls::TimeInterval setCachedTimeMaxStaleness(const TimeInterval&)
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'currentTimeCached'" << endl
+                          << "===========================" << endl;
+
+        const bsls::TimeInterval SLACK(0, 2 * 1000 * 1000);  // 2ms
+
+        if (verbose) cout << "Testing the maximum staleness" << endl;
+        {
+            ASSERTV(Util::cachedTimeMaxStaleness(),
+                    bsls::TimeInterval(0, 1000000) ==
+                                               Util::cachedTimeMaxStaleness());
+
+            ASSERT(bsls::TimeInterval(0, 1000000) ==
+                      Util::setCachedTimeMaxStaleness(bsls::TimeInterval(1)));
+            ASSERT(bsls::TimeInterval(1) == Util::cachedTimeMaxStaleness());
+            ASSERT(bsls::TimeInterval(1) ==
+                      Util::setCachedTimeMaxStaleness(bsls::TimeInterval()));
+            ASSERT(bsls::TimeInterval()  == Util::cachedTimeMaxStaleness());
+        }
+
+        if (verbose) cout << "Testing staleness of cached times" << endl;
+        {
+            static const int STALENESS[] = { 0, 10000, 1000000, 10000000 };
+            const int        NUM_STALENESS =
+                                       sizeof STALENESS / sizeof *STALENESS;
+
+            for (int ti = 0; ti < NUM_STALENESS; ++ti) {
+                const bsls::TimeInterval MAX_STALENESS(0, STALENESS[ti]);
+
+                Util::setCachedTimeMaxStaleness(MAX_STALENESS);
+                ASSERT(MAX_STALENESS == Util::cachedTimeMaxStaleness());
+
+                if (veryVerbose) { T_ P(MAX_STALENESS) }
+
+                for (int i = 0; i < 10000; ++i) {
+                    const bsls::TimeInterval before =
+                                                   Util::currentTimeDefault();
+                    const bsls::TimeInterval cached =
+                                                    Util::currentTimeCached();
+                    const bsls::TimeInterval after  =
+                                                   Util::currentTimeDefault();
+
+                    ASSERTV(ti, i, cached, after, cached <= after);
+                    ASSERTV(ti, i, cached, before,
+                            before - MAX_STALENESS - SLACK <= cached);
+                }
+            }
+            Util::setCachedTimeMaxStaleness(bsls::TimeInterval(0, 1000000));
+        }
+
+        if (verbose) cout << "Testing that cached times advance" << endl;
+        {
+            const bsls::TimeInterval start  = Util::currentTimeCached();
+            const bsls::TimeInterval finish = Util::currentTimeDefault()
+                                            + bsls::TimeInterval(0, 50000000);
+
+            bsls::TimeInterval last = start;
+            while (Util::currentTimeDefault() < finish) {
+                last = Util::currentTimeCached();
+            }
+            ASSERTV(start, last, start + bsls::TimeInterval(0, 40000000)
+                                                                      <= last);
+        }
+
+        if (verbose) cout << "Testing as the current-time callback" << endl;
+        {
+            const Util::CurrentTimeCallback previous =
+                Util::setCurrentTimeCallback(&Util::currentTimeCached);
+
+            for (int i = 0; i < 1000; ++i) {
+                const bsls::TimeInterval before = Util::currentTimeDefault();
+                const bsls::TimeInterval now    = Util::now();
+
+                ASSERTV(i, now, before,
+                        before - Util::cachedTimeMaxStaleness() - SLACK
+                                                                      <= now);
+            }
+
+            ASSERT(&Util::currentTimeCached ==
+                                   Util::setCurrentTimeCallback(previous));
+        }
+
+        if (verbose) cout << "Testing concurrent refreshes" << endl;
+        {
+            enum { k_NUM_THREADS = 8 };
+
+            const bsls::TimeInterval MAX_STALENESS(0, 100 * 1000);
+
+            Util::setCachedTimeMaxStaleness(MAX_STALENESS);
+
+            CachedTimeInfo infos[k_NUM_THREADS];
+            ThreadId       ids[k_NUM_THREADS];
+
+            bsls::AtomicOperations::setInt(&go, 0);
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                infos[i].d_maxLag    = MAX_STALENESS
+                                     + bsls::TimeInterval(0, 50 * 1000);
+                infos[i].d_count     = 100000;
+                infos[i].d_numStale  = 0;
+                infos[i].d_numFuture = 0;
+
+                ids[i] = createThread(cachedTimeThreadFunction, &infos[i]);
+            }
+
+            bsls::AtomicOperations::setInt(&go, 1);
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                joinThread(ids[i]);
+
+                ASSERTV(i, infos[i].d_numStale,  0 == infos[i].d_numStale);
+                ASSERTV(i, infos[i].d_numFuture, 0 == infos[i].d_numFuture);
+            }
+
+            Util::setCachedTimeMaxStaleness(bsls::TimeInterval(0, 1000000));
+        }
+      } break;
       case 8: {
         // --------------------------------------------------------------------
         // TESTING 'local' METHOD - STRESS TESTING FOR MONOTONICITY
@@ -1034,6 +1258,50 @@ int main(int argc, char *argv[])
                  << " seconds\n";
         }
       } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // BENCHMARK CURRENT-TIME CALLBACKS
+        //   Compare the cost of a call to 'currentTimeDefault' with that of a
+        //   call to 'currentTimeCached' for various maximum stalenesses.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BENCHMARK CURRENT-TIME CALLBACKS" << endl
+                          << "================================" << endl;
+
+        const int numCalls = 10 * 1000 * 1000;
+
+        static const int STALENESS[] = { 0, 10000, 1000000, 10000000 };
+        const int        NUM_STALENESS = sizeof STALENESS / sizeof *STALENESS;
+
+        bsls::TimeInterval sum;  // prevents the calls from being optimized
+
+        bsls::Types::Int64 start = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < numCalls; ++i) {
+            sum += Util::currentTimeDefault();
+        }
+        bsls::Types::Int64 elapsed = bsls::TimeUtil::getTimer() - start;
+
+        cout << "currentTimeDefault:                  "
+             << static_cast<double>(elapsed) / numCalls << " ns/call\n";
+
+        for (int ti = 0; ti < NUM_STALENESS; ++ti) {
+            Util::setCachedTimeMaxStaleness(
+                                         bsls::TimeInterval(0, STALENESS[ti]));
+
+            start = bsls::TimeUtil::getTimer();
+            for (int i = 0; i < numCalls; ++i) {
+                sum += Util::currentTimeCached();
+            }
+            elapsed = bsls::TimeUtil::getTimer() - start;
+
+            cout << "currentTimeCached (staleness "
+                 << STALENESS[ti] / 1000 << "us): \t"
+                 << static_cast<double>(elapsed) / numCalls << " ns/call\n";
+        }
+
+        if (veryVerbose) { P(sum) }
+      } break;
       default: {
           cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
           testStatus = -1;
@@ -51,7 +51,9 @@ namespace bsl
 #ifndef BSL_OVERRIDES_STD
 #include <bslstl_allocator.h>
 #include <bslstl_allocatortraits.h>
+#include <bslstl_atomicsharedptr.h>
 #include <bslstl_badweakptr.h>
+#include <bslstl_localsharedptr.h>
 #include <bslstl_ownerless.h>
 #include <bslstl_sharedptr.h>
 #endif
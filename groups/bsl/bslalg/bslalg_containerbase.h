@@ -101,6 +101,14 @@ BSLS_IDENT("$Id: $")
 #include <bslmf_isconvertible.h>
 #endif
 
+#ifndef INCLUDED_BSLS_ALIGNMENTFROMTYPE
+#include <bsls_alignmentfromtype.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTUTIL
+#include <bsls_alignmentutil.h>
+#endif
+
 namespace BloombergLP {
 
 namespace bslma { class Allocator; }
@@ -271,6 +279,26 @@ class ContainerBase : public
         return Rebound(this->allocator());
     }
 
+    // PRIVATE CLASS METHODS
+    static bool expandBytes(bslma::Allocator            *mechanism,
+                            void                        *address,
+                            bslma::Allocator::size_type  size,
+                            bslma::Allocator::size_type  newSize)
+        // Return 'mechanism->expandSized(address, size, newSize)'.
+    {
+        return mechanism->expandSized(address, size, newSize);
+    }
+
+    static bool expandBytes(void *,
+                            void *,
+                            bslma::Allocator::size_type,
+                            bslma::Allocator::size_type)
+        // Return 'false'.  This overload is selected for allocators that are
+        // not 'bslma'-based, which provide no in-place expansion.
+    {
+        return false;
+    }
+
   public:
     // PUBLIC TYPES
     typedef typename Base::AllocatorType            AllocatorType;
@@ -319,6 +347,28 @@ class ContainerBase : public
         return rebindAllocator(p).allocate(n);
     }
 
+    template <class T>
+    bool expandN(T *p, size_type n, size_type newN)
+        // Attempt to extend, in place, the block of 'n' objects of type 'T'
+        // starting at 'p', previously obtained from 'allocateN' (or extended
+        // by a previous call to this method), so that it can hold 'newN'
+        // objects.  Return 'true' on success, in which case the block must
+        // later be returned using 'deallocateN(p, newN)', and 'false' (with no
+        // effect) otherwise.  Note that only 'bslma'-based allocators that
+        // override 'bslma::Allocator::expandSized' can succeed, and only for
+        // a 'T' that is not over-aligned (see 'bsl::allocator').
+    {
+        if (static_cast<int>(bsls::AlignmentFromType<T>::VALUE) >
+                  static_cast<int>(bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT)) {
+            return false;                                             // RETURN
+        }
+
+        return expandBytes(this->bslmaAllocator(),
+                           p,
+                           n * sizeof(T),
+                           newN * sizeof(T));
+    }
+
     void construct(pointer p, const value_type& val);
         // Copy-construct a 'T' object at the memory address specified by 'p'.
         // Do not directly allocate memory.  The behavior is undefined if 'p'
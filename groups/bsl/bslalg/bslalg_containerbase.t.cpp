@@ -606,6 +606,10 @@ int main(int argc, char *argv[])
             ASSERTV(i, i * static_cast<ptrdiff_t>(sizeof(int))
                                                         == ta.numBytesInUse());
 
+            // 'bslma::TestAllocator' does not support in-place expansion.
+
+            ASSERTV(i, false == mX.expandN(intPtr, i, i + 1));
+
             mX.deallocateN(intPtr, i);
             ASSERTV(i, 0 == ta.numBytesInUse());
 
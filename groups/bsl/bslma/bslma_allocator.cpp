@@ -4,12 +4,42 @@
 #include <bsls_ident.h>
 BSLS_IDENT("$Id$ $CSID$")
 
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
 #include <bsls_bslexceptionutil.h>
+#include <bsls_exceptionutil.h>
 
 namespace BloombergLP {
 
 namespace bslma {
 
+namespace {
+
+const Allocator::size_type k_MAX_ALIGNMENT =
+                                       bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+    // maximal alignment guaranteed by 'allocateSized' for a suitably-sized
+    // block
+
+inline
+Allocator::size_type paddedSize(Allocator::size_type size,
+                                Allocator::size_type alignment)
+    // Return the size (in bytes) of the block that is obtained from
+    // 'allocateSized' by the default implementation of 'allocateAligned' to
+    // supply a block of the specified 'size' having the specified
+    // 'alignment'.  If 'alignment' does not exceed the maximal alignment, the
+    // block is naturally aligned to (at least) 'alignment' provided its size
+    // is a multiple of 'alignment'; otherwise, a maximally-aligned block
+    // having 'alignment' bytes of padding is required.
+{
+    if (alignment <= k_MAX_ALIGNMENT) {
+        return (size + alignment - 1) & ~(alignment - 1);             // RETURN
+    }
+
+    return ((size + k_MAX_ALIGNMENT - 1) & ~(k_MAX_ALIGNMENT - 1)) + alignment;
+}
+
+}  // close unnamed namespace
+
                         // ---------------
                         // class Allocator
                         // ---------------
@@ -20,6 +50,96 @@ Allocator::~Allocator()
 {
 }
 
+// MANIPULATORS
+void *Allocator::allocateSized(size_type size)
+{
+    return allocate(size);
+}
+
+void Allocator::deallocateSized(void *address, size_type)
+{
+    deallocate(address);
+}
+
+bool Allocator::expandSized(void *, size_type, size_type)
+{
+    return false;
+}
+
+void Allocator::allocateBatch(void      **addresses,
+                              size_type   numBlocks,
+                              size_type   size)
+{
+    size_type i = 0;
+
+    BSLS_TRY {
+        for (; i < numBlocks; ++i) {
+            addresses[i] = allocateSized(size);
+        }
+    }
+    BSLS_CATCH(...) {
+        while (i > 0) {
+            --i;
+            deallocateSized(addresses[i], size);
+        }
+        BSLS_RETHROW;
+    }
+}
+
+void Allocator::deallocateBatch(void *const *addresses,
+                                size_type    numBlocks,
+                                size_type    size)
+{
+    for (size_type i = 0; i < numBlocks; ++i) {
+        deallocateSized(addresses[i], size);
+    }
+}
+
+void *Allocator::allocateAligned(size_type size, size_type alignment)
+{
+    BSLS_ASSERT(0 < alignment);
+    BSLS_ASSERT(0 == (alignment & (alignment - 1)));
+
+    if (0 == size) {
+        return 0;                                                     // RETURN
+    }
+
+    char *block = static_cast<char *>(
+                                  allocateSized(paddedSize(size, alignment)));
+
+    if (alignment <= k_MAX_ALIGNMENT) {
+        return block;                                                 // RETURN
+    }
+
+    // 'block' is maximally aligned, so the aligned address is at least
+    // 'BSLS_MAX_ALIGNMENT' (and at most 'alignment') bytes beyond it, leaving
+    // room to store 'block' immediately before the aligned address.
+
+    char *address = block + alignment
+                  - (reinterpret_cast<bsls::Types::UintPtr>(block)
+                                                          & (alignment - 1));
+
+    reinterpret_cast<void **>(address)[-1] = block;
+    return address;
+}
+
+void Allocator::deallocateAligned(void      *address,
+                                  size_type  size,
+                                  size_type  alignment)
+{
+    if (0 == address) {
+        return;                                                       // RETURN
+    }
+
+    if (alignment <= k_MAX_ALIGNMENT) {
+        deallocateSized(address, paddedSize(size, alignment));
+        return;                                                       // RETURN
+    }
+
+    deallocateSized(reinterpret_cast<void **>(address)[-1],
+                    paddedSize(size, alignment));
+}
+
 }  // close package namespace
 
 }  // close enterprise namespace
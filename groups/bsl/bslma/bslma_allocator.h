@@ -68,6 +68,69 @@ BSLS_IDENT("$Id: $")
 // memory.  Memory is allocated from the pool until it is dry; only then does
 // new memory flow into the pool from the allocator.
 //
+///Sized Allocation
+///----------------
+// In addition to the pure virtual 'allocate' and 'deallocate' methods, the
+// protocol provides a pair of (non-pure) virtual methods, 'allocateSized' and
+// 'deallocateSized', for clients that know the size of every block they
+// return -- e.g., containers, which always know how many elements they
+// allocated.  A block obtained from 'allocateSized' must be returned using
+// 'deallocateSized', passing the same 'size' that was supplied to
+// 'allocateSized'; blocks obtained from 'allocate' must be returned using
+// 'deallocate'.  The default implementations simply forward to 'allocate' and
+// 'deallocate', so existing concrete allocators are unaffected.  A concrete
+// allocator may override both methods to serve sized requests without storing
+// any per-block bookkeeping (such as the index of the pool that supplied the
+// block) -- see 'bdlma_multipoolallocator'.  Note that 'bsl::allocator'
+// dispenses all container memory through 'allocateSized' and
+// 'deallocateSized'.
+//
+///In-Place Expansion
+///------------------
+// A block obtained from 'allocateSized' may also be offered back to the
+// allocator for in-place growth using the (non-pure) virtual method
+// 'expandSized'.  If the allocator can extend the block at its current address
+// to the requested new size, it does so and returns 'true', after which the
+// block must be returned using 'deallocateSized' with the *new* size;
+// otherwise, it returns 'false' and the block is unchanged.  The default
+// implementation always returns 'false', so existing concrete allocators are
+// unaffected.  Arena-style allocators, which can cheaply extend the most
+// recently allocated block, override this method (see
+// 'bdlma_sequentialallocator' and 'bdlma_bufferedsequentialallocator'), and
+// 'bsl::vector' and 'bsl::string' query it before reallocating their storage,
+// making growth of the most recently allocated container copy-free.
+//
+///Batch Allocation
+///----------------
+// Clients that obtain or return many blocks of the same size at once (e.g.,
+// node pools refilling or releasing their chunks) can use the (non-pure)
+// virtual methods 'allocateBatch' and 'deallocateBatch', which process an
+// array of blocks in a single call.  Blocks obtained from 'allocateBatch' are
+// indistinguishable from blocks obtained from 'allocateSized' with the same
+// size, and blocks returned using 'deallocateBatch' may have been obtained
+// from either method.  The default implementations simply loop over
+// 'allocateSized' and 'deallocateSized', so existing concrete allocators are
+// unaffected.  A concrete allocator may override both methods to amortize its
+// per-call overhead (such as locating the pool serving a given size) across
+// the whole batch -- see 'bdlma_multipoolallocator'.
+//
+///Over-Aligned Allocation
+///-----------------------
+// The alignment guaranteed by 'allocate' never exceeds
+// 'bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT', which is insufficient for, e.g.,
+// objects aligned to a cache line or a SIMD register, or buffers aligned to a
+// page for direct I/O.  Clients requiring a stricter alignment can use the
+// (non-pure) virtual method 'allocateAligned', which takes the required
+// alignment (an integral power of 2) in addition to the size, and must return
+// the block using 'deallocateAligned', passing the same size and alignment.
+// The default implementations obtain a padded block using 'allocateSized',
+// and store the address of the padded block immediately before the aligned
+// address that is returned, so existing concrete allocators are unaffected.
+// A concrete allocator that can supply aligned memory directly overrides both
+// methods (see 'bslma_newdeleteallocator' and 'bdlma_multipoolallocator'),
+// and 'bsl::allocator' uses them for element types whose alignment exceeds
+// 'BSLS_MAX_ALIGNMENT'.
+//
 ///Overloaded Global Operators 'new' and 'delete'
 ///----------------------------------------------
 // This component overloads the global operator 'new' to allow convenient
@@ -435,6 +498,96 @@ class Allocator {
         // behavior is undefined unless 'address' was allocated using this
         // allocator object and has not already been deallocated.
 
+    virtual void *allocateSized(size_type size);
+        // Return a newly allocated block of memory of (at least) the specified
+        // positive 'size' (in bytes) that must later be returned to this
+        // allocator using 'deallocateSized' with the same 'size'.  If 'size'
+        // is 0, a null pointer is returned with no other effect.  If this
+        // allocator cannot return the requested number of bytes, then it will
+        // throw a 'std::bad_alloc' exception in an exception-enabled build, or
+        // else will abort the program in a non-exception build.  The behavior
+        // is undefined unless '0 <= size'.  Note that the default
+        // implementation returns 'allocate(size)'.
+
+    virtual void deallocateSized(void *address, size_type size);
+        // Return the memory block at the specified 'address', having the
+        // specified 'size' (in bytes), back to this allocator.  If 'address'
+        // is 0, this function has no effect.  The behavior is undefined unless
+        // 'address' was allocated by a call to 'allocateSized' on this
+        // allocator object supplying the same 'size', and has not already been
+        // deallocated.  Note that the default implementation invokes
+        // 'deallocate(address)'.
+
+    virtual bool expandSized(void     *address,
+                             size_type size,
+                             size_type newSize);
+        // Attempt to extend, in place, the memory block at the specified
+        // 'address', having the specified 'size' (in bytes), to the specified
+        // 'newSize' (in bytes).  Return 'true' if the block was extended, in
+        // which case it must subsequently be returned to this allocator using
+        // 'deallocateSized' with 'newSize', and 'false' (with no effect)
+        // otherwise.  The behavior is undefined unless 'address' was allocated
+        // by a call to 'allocateSized' on this allocator object supplying
+        // 'size' (or was successfully extended to 'size' by a previous call to
+        // this method), has not already been deallocated, and
+        // '0 < size <= newSize'.  Note that the default implementation always
+        // returns 'false'.
+
+    virtual void allocateBatch(void      **addresses,
+                               size_type   numBlocks,
+                               size_type   size);
+        // Load into the specified 'addresses' array the addresses of the
+        // specified 'numBlocks' newly allocated blocks of memory, each of
+        // (at least) the specified positive 'size' (in bytes), that must later
+        // be returned to this allocator using 'deallocateBatch' or
+        // 'deallocateSized' with the same 'size'.  If this allocator cannot
+        // supply all of the requested blocks, then no blocks are allocated
+        // and a 'std::bad_alloc' exception is thrown in an exception-enabled
+        // build, or else the program is aborted in a non-exception build.
+        // The behavior is undefined unless 'addresses' refers to an array of
+        // at least 'numBlocks' elements, and '0 < size'.  Note that the
+        // default implementation invokes 'allocateSized(size)' 'numBlocks'
+        // times.
+
+    virtual void deallocateBatch(void *const *addresses,
+                                 size_type    numBlocks,
+                                 size_type    size);
+        // Return the specified 'numBlocks' memory blocks whose addresses are
+        // held in the specified 'addresses' array, each having the specified
+        // 'size' (in bytes), back to this allocator.  The behavior is
+        // undefined unless each block was allocated by a call to
+        // 'allocateSized' or 'allocateBatch' on this allocator object
+        // supplying the same 'size', and has not already been deallocated.
+        // Note that the default implementation invokes
+        // 'deallocateSized(addresses[i], size)' for each block.
+
+    virtual void *allocateAligned(size_type size, size_type alignment);
+        // Return a newly allocated block of memory of (at least) the specified
+        // positive 'size' (in bytes), whose address is a multiple of the
+        // specified 'alignment', that must later be returned to this
+        // allocator using 'deallocateAligned' with the same 'size' and
+        // 'alignment'.  If 'size' is 0, a null pointer is returned with no
+        // other effect.  If this allocator cannot return the requested number
+        // of bytes, then it will throw a 'std::bad_alloc' exception in an
+        // exception-enabled build, or else will abort the program in a
+        // non-exception build.  The behavior is undefined unless '0 <= size'
+        // and 'alignment' is a positive, integral power of 2.  Note that the
+        // default implementation returns 'allocateSized' of 'size' rounded up
+        // to a multiple of 'alignment' if 'alignment' does not exceed
+        // 'bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT', and otherwise returns an
+        // aligned address within a padded block obtained from 'allocateSized'
+        // (which incurs an overhead of 'alignment' bytes).
+
+    virtual void deallocateAligned(void      *address,
+                                   size_type  size,
+                                   size_type  alignment);
+        // Return the memory block at the specified 'address', having the
+        // specified 'size' (in bytes) and 'alignment', back to this allocator.
+        // If 'address' is 0, this function has no effect.  The behavior is
+        // undefined unless 'address' was allocated by a call to
+        // 'allocateAligned' on this allocator object supplying the same 'size'
+        // and 'alignment', and has not already been deallocated.
+
     template <class TYPE>
     void deleteObject(const TYPE *object);
         // Destroy the specified 'object' based on its dynamic type and then
@@ -33,11 +33,18 @@ using namespace BloombergLP;
 // [ 3] template<typename TYPE> deleteObjectRaw(const TYPE *);
 // [ 4] void *operator new(int size, bslma::Allocator& basicAllocator);
 // [ 5] void operator delete(void *address, bslma::Allocator& basicAllocator);
+// [ 6] virtual void *allocateSized(size_type size);
+// [ 6] virtual void deallocateSized(void *address, size_type size);
+// [ 6] virtual bool expandSized(void *, size_type, size_type);
+// [ 6] virtual void allocateBatch(void **, size_type, size_type);
+// [ 6] virtual void deallocateBatch(void *const *, size_type, size_type);
+// [ 7] virtual void *allocateAligned(size_type, size_type);
+// [ 7] virtual void deallocateAligned(void *, size_type, size_type);
 //-----------------------------------------------------------------------------
 // [ 1] PROTOCOL TEST - Make sure derived class compiles and links.
 // [ 4] OPERATOR TEST - Make sure overloaded operators call correct functions.
 // [ 5] EXCEPTION SAFETY - Ensure operator delete is invoked on an exception.
-// [ 6] USAGE EXAMPLE - Make sure usage examples compiles and works properly.
+// [ 8] USAGE EXAMPLE - Make sure usage examples compiles and works properly.
 //=============================================================================
 
 //=============================================================================
@@ -132,6 +139,99 @@ class my_Allocator : public bslma::Allocator {
         // Return number of times deallocate called.
 };
 
+class my_SizedAllocator : public my_Allocator {
+    // Test class used to verify that 'allocateSized' and 'deallocateSized'
+    // can be overridden.
+
+    size_type d_sizedArg;  // holds argument from last sized function
+
+  public:
+    my_SizedAllocator() : d_sizedArg(0) { }
+    ~my_SizedAllocator() { }
+
+    void *allocateSized(size_type s) {
+        d_sizedArg = s;
+        return my_Allocator::allocate(s);
+    }
+
+    void deallocateSized(void *p, size_type s) {
+        d_sizedArg = s;
+        my_Allocator::deallocate(p);
+    }
+
+    size_type sizedArg() const { return d_sizedArg; }
+        // Return last argument value for a sized function.
+};
+
+class my_LimitedAllocator : public my_SizedAllocator {
+    // Test class used to verify that a failed 'allocateBatch' returns the
+    // blocks allocated before the failure.  'allocateSized' throws
+    // 'std::bad_alloc' once the number of blocks in use reaches the limit
+    // supplied at construction.
+
+    int d_limit;  // maximum number of blocks in use
+
+  public:
+    explicit my_LimitedAllocator(int limit) : d_limit(limit) { }
+    ~my_LimitedAllocator() { }
+
+    void *allocateSized(size_type s) {
+        if (allocateCount() - deallocateCount() >= d_limit) {
+#ifdef BDE_BUILD_TARGET_EXC
+            throw std::bad_alloc();
+#else
+            abort();
+#endif
+        }
+        return my_SizedAllocator::allocateSized(s);
+    }
+};
+
+class my_HeapSizedAllocator : public bslma::Allocator {
+    // Test class used to verify the default implementations of
+    // 'allocateAligned' and 'deallocateAligned'.  Sized blocks are obtained
+    // from 'malloc' (and are therefore maximally aligned), and the sizes and
+    // addresses of the sized requests are recorded and checked.
+
+    size_type  d_lastSize;     // size of last sized request
+    void      *d_lastBlock_p;  // address of last sized block
+    int        d_numInUse;     // number of sized blocks in use
+
+  public:
+    my_HeapSizedAllocator() : d_lastSize(0), d_lastBlock_p(0), d_numInUse(0)
+    {
+    }
+
+    ~my_HeapSizedAllocator() { ASSERT(0 == d_numInUse); }
+
+    void *allocate(size_type) { ASSERT(!"unexpected 'allocate'"); return 0; }
+
+    void deallocate(void *) { ASSERT(!"unexpected 'deallocate'"); }
+
+    void *allocateSized(size_type s) {
+        d_lastSize    = s;
+        d_lastBlock_p = malloc(s);
+        ++d_numInUse;
+        return d_lastBlock_p;
+    }
+
+    void deallocateSized(void *p, size_type s) {
+        ASSERT(p == d_lastBlock_p);
+        ASSERT(s == d_lastSize);
+        --d_numInUse;
+        free(p);
+    }
+
+    size_type lastSize() const { return d_lastSize; }
+        // Return the size of the last sized request.
+
+    void *lastBlock() const { return d_lastBlock_p; }
+        // Return the address of the last sized block.
+
+    int numInUse() const { return d_numInUse; }
+        // Return the number of sized blocks in use.
+};
+
 class my_NewDeleteAllocator : public bslma::Allocator {
     // Test class used to verify examples.
 
@@ -425,7 +525,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:
-      case 6: {
+      case 8: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE
         //   The usage example provided in the component header file must
@@ -479,6 +579,204 @@ int main(int argc, char *argv[])
             deleteMyType(&a, t);
         }
 
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // OVER-ALIGNED ALLOCATION TEST:
+        //   We want to make sure that the default implementations of
+        //   'allocateAligned' and 'deallocateAligned' return blocks having
+        //   the requested size and alignment, obtained from (and returned to)
+        //   'allocateSized' and 'deallocateSized'.
+        //
+        // Plan:
+        //   Using an allocator that supplies sized blocks from 'malloc',
+        //   request blocks of various sizes and alignments, both within and
+        //   beyond the maximal alignment, and verify that each block is
+        //   aligned, lies within the sized block that supplied it, and is
+        //   returned (with the same size) by 'deallocateAligned'.  Verify that
+        //   a request for 0 bytes returns 0 without allocating, and that
+        //   'deallocateAligned' of 0 has no effect.
+        //
+        // Testing:
+        //   virtual void *allocateAligned(size_type, size_type);
+        //   virtual void deallocateAligned(void *, size_type, size_type);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nOVER-ALIGNED ALLOCATION TEST"
+                            "\n============================\n");
+
+        typedef bslma::Allocator::size_type size_type;
+
+        const size_type MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+        const size_type SIZES[]  = { 1, 3, 8, 24, 64, 100, 4096 };
+        const int       NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+        const size_type ALIGNS[] = { 1, 2, 8, MAX_ALIGN, 32, 64, 4096 };
+        const int       NUM_ALIGNS = sizeof ALIGNS / sizeof *ALIGNS;
+
+        my_HeapSizedAllocator myA;
+        bslma::Allocator&     a = myA;
+
+        for (int i = 0; i < NUM_SIZES; ++i) {
+            for (int j = 0; j < NUM_ALIGNS; ++j) {
+                const size_type SIZE  = SIZES[i];
+                const size_type ALIGN = ALIGNS[j];
+
+                char *p = static_cast<char *>(a.allocateAligned(SIZE, ALIGN));
+
+                ASSERTV(SIZE, ALIGN, p);
+                ASSERTV(SIZE, ALIGN, 1 == myA.numInUse());
+                ASSERTV(SIZE, ALIGN,
+                        0 == reinterpret_cast<bsls::Types::UintPtr>(p)
+                                                               % ALIGN);
+
+                const char *block = static_cast<char *>(myA.lastBlock());
+                ASSERTV(SIZE, ALIGN, block <= p);
+                ASSERTV(SIZE, ALIGN, p + SIZE <= block + myA.lastSize());
+
+                if (ALIGN <= MAX_ALIGN) {
+                    ASSERTV(SIZE, ALIGN, block == p);
+                }
+                else {
+                    ASSERTV(SIZE, ALIGN,
+                            myA.lastSize() <= SIZE + MAX_ALIGN + ALIGN);
+                }
+
+                memset(p, 0xa5, SIZE);
+
+                a.deallocateAligned(p, SIZE, ALIGN);
+                ASSERTV(SIZE, ALIGN, 0 == myA.numInUse());
+            }
+        }
+
+        ASSERT(0 == a.allocateAligned(0, 64));
+        ASSERT(0 == myA.numInUse());
+
+        a.deallocateAligned(0, 0, 64);
+        a.deallocateAligned(0, 8, 8);
+        ASSERT(0 == myA.numInUse());
+
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // SIZED ALLOCATION TEST:
+        //   We want to make sure that the default implementations of
+        //   'allocateSized' and 'deallocateSized' forward to 'allocate' and
+        //   'deallocate', and that derived classes can override them.
+        //
+        // Plan:
+        //   Using a base class reference to an allocator that does not
+        //   override the sized methods, invoke 'allocateSized' and
+        //   'deallocateSized' and verify that 'allocate' (with the same size)
+        //   and 'deallocate' are called.  Repeat for an allocator overriding
+        //   the sized methods, and verify that the overrides are called with
+        //   the supplied size.  Verify that the default implementation of
+        //   'expandSized' returns 'false' without invoking any other method.
+        //   Finally, verify that the default implementations of
+        //   'allocateBatch' and 'deallocateBatch' invoke the sized methods
+        //   once per block, and that a failed 'allocateBatch' returns the
+        //   blocks it had already obtained.
+        //
+        // Testing:
+        //   virtual void *allocateSized(size_type size);
+        //   virtual void deallocateSized(void *address, size_type size);
+        //   virtual bool expandSized(void *, size_type, size_type);
+        //   virtual void allocateBatch(void **, size_type, size_type);
+        //   virtual void deallocateBatch(void *const *, size_type, size_type);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nSIZED ALLOCATION TEST"
+                            "\n=====================\n");
+
+        if (verbose) printf("\nTesting default implementations.\n");
+        {
+            my_Allocator myA;
+            bslma::Allocator& a = myA;
+
+            ASSERT(&myA == a.allocateSized(100));
+            ASSERT(1 == myA.fun());    ASSERT(100 == myA.arg());
+            ASSERT(1 == myA.allocateCount());
+
+            a.deallocateSized(&myA, 100);
+            ASSERT(2 == myA.fun());
+            ASSERT(1 == myA.deallocateCount());
+        }
+
+        if (verbose) printf("\nTesting overridden implementations.\n");
+        {
+            my_SizedAllocator myA;
+            bslma::Allocator& a = myA;
+
+            ASSERT(&myA == a.allocateSized(24));
+            ASSERT(1  == myA.fun());    ASSERT(24 == myA.sizedArg());
+
+            a.deallocateSized(&myA, 24);
+            ASSERT(2  == myA.fun());    ASSERT(24 == myA.sizedArg());
+            ASSERT(1  == myA.allocateCount());
+            ASSERT(1  == myA.deallocateCount());
+        }
+
+        if (verbose) printf("\nTesting default 'expandSized'.\n");
+        {
+            my_Allocator myA;
+            bslma::Allocator& a = myA;
+
+            ASSERT(false == a.expandSized(&myA, 24, 48));
+            ASSERT(false == a.expandSized(&myA, 24, 24));
+            ASSERT(0 == myA.allocateCount());
+            ASSERT(0 == myA.deallocateCount());
+        }
+
+        if (verbose) printf("\nTesting default batch methods.\n");
+        {
+            my_SizedAllocator myA;
+            bslma::Allocator& a = myA;
+
+            void *blocks[5] = { 0, 0, 0, 0, 0 };
+
+            a.allocateBatch(blocks, 4, 40);
+            ASSERT(4  == myA.allocateCount());
+            ASSERT(40 == myA.sizedArg());
+            for (int i = 0; i < 4; ++i) {
+                ASSERTV(i, &myA == blocks[i]);
+            }
+            ASSERT(0 == blocks[4]);
+
+            a.deallocateBatch(blocks, 4, 48);
+            ASSERT(4  == myA.deallocateCount());
+            ASSERT(48 == myA.sizedArg());
+
+            a.allocateBatch(blocks, 0, 40);
+            a.deallocateBatch(blocks, 0, 40);
+            ASSERT(4 == myA.allocateCount());
+            ASSERT(4 == myA.deallocateCount());
+        }
+
+#ifdef BDE_BUILD_TARGET_EXC
+        if (verbose) printf("\nTesting failed 'allocateBatch'.\n");
+        {
+            my_LimitedAllocator myA(3);
+            bslma::Allocator& a = myA;
+
+            void *blocks[5];
+
+            bool caught = false;
+            try {
+                a.allocateBatch(blocks, 5, 16);
+            }
+            catch (const std::bad_alloc&) {
+                caught = true;
+            }
+            ASSERT(caught);
+            ASSERT(3 == myA.allocateCount());
+            ASSERT(3 == myA.deallocateCount());
+
+            a.allocateBatch(blocks, 3, 16);
+            ASSERT(6 == myA.allocateCount());
+        }
+#endif
+
       } break;
       case 5: {
         // --------------------------------------------------------------------
@@ -28,6 +28,10 @@ bsls::AtomicOperations::AtomicTypes::Int     Default::s_locked    = {0};
 
 bsls::AtomicOperations::AtomicTypes::Pointer Default::s_globalAllocator = {0};
 
+                        // *** thread default allocator ***
+
+BSLS_THREADLOCAL Allocator *Default::s_threadAllocator_p = 0;
+
 // CLASS METHODS
 
                         // *** default allocator ***
@@ -100,6 +100,33 @@ BSLS_IDENT("$Id: $")
 // at most once.  If called, it should be invoked in 'main' before starting any
 // threads and before initializing singletons.
 //
+///Thread Default Allocator
+///------------------------
+// In addition to the process-wide default allocator, each thread may install
+// its own *thread* *default* *allocator* by calling
+// 'bslma::Default::setThreadDefaultAllocator'.  While a thread default
+// allocator is installed, 'bslma::Default::defaultAllocator' (and
+// 'bslma::Default::allocator' with no argument, or an explicit 0) returns it,
+// instead of the process-wide default allocator, when called from that
+// thread, and from that thread only.  Consequently, every object created by
+// that thread without an explicitly supplied allocator (including the
+// temporaries of code that cannot be changed to accept one) obtains its memory
+// from the thread default allocator.  Installing a thread default allocator
+// does not require synchronization with other threads, and does not affect
+// the locking of the process-wide default allocator.  Initially, no thread
+// default allocator is installed in any thread; passing 0 to
+// 'bslma::Default::setThreadDefaultAllocator' uninstalls it.
+// 'bslma::Default::processDefaultAllocator' returns the process-wide default
+// allocator regardless of the calling thread.
+//
+// Note that an object obtains its allocator when it is created, and uses that
+// allocator for its lifetime.  The thread default allocator must therefore
+// outlive all objects created while it is installed, including objects that
+// are passed to, and destroyed by, other threads.  The
+// 'bslma_threaddefaultallocatorguard' component provides a scoped guard that
+// installs a thread default allocator, and restores the previous one on
+// destruction.
+//
 ///Usage
 ///-----
 // The following sequence of usage examples illustrate recommended use of the
@@ -644,6 +671,10 @@ BSLS_IDENT("$Id: $")
 #include <bsls_atomicoperations.h>
 #endif
 
+#ifndef INCLUDED_BSLS_THREADLOCAL
+#include <bsls_threadlocal.h>
+#endif
+
 #ifndef INCLUDED_BSLMA_NEWDELETEALLOCATOR
 #include <bslma_newdeleteallocator.h>
 #endif
@@ -672,6 +703,11 @@ struct Default {
     static bsls::AtomicOperations::AtomicTypes::Pointer s_globalAllocator;
                                                   // the global allocator
 
+    static BSLS_THREADLOCAL Allocator                  *s_threadAllocator_p;
+                                                  // the thread default
+                                                  // allocator of the calling
+                                                  // thread, or 0 if none
+
   public:
     // CLASS METHODS
 
@@ -710,13 +746,14 @@ struct Default {
         // disabled by this method.
 
     static Allocator *defaultAllocator();
-        // Return the address of the default allocator and disable all
-        // subsequent calls to the 'setDefaultAllocator' method.  Note that
-        // prior to the first call to 'setDefaultAllocator' or
-        // 'setDefaultAllocatorRaw' methods, the address of the default
-        // allocator is that of the 'NewDeleteAllocator' singleton.  Also note
-        // that subsequent calls to 'setDefaultAllocatorRaw' method are *not*
-        // disabled by this method.
+        // Return the address of the thread default allocator of the calling
+        // thread if one is installed, and the address of the process-wide
+        // default allocator otherwise, and disable all subsequent calls to the
+        // 'setDefaultAllocator' method.  Note that prior to the first call to
+        // 'setDefaultAllocator' or 'setDefaultAllocatorRaw' methods, the
+        // address of the process-wide default allocator is that of the
+        // 'NewDeleteAllocator' singleton.  Also note that subsequent calls to
+        // 'setDefaultAllocatorRaw' method are *not* disabled by this method.
 
     static Allocator *allocator(Allocator *basicAllocator = 0);
         // Return the allocator returned by 'defaultAllocator' and disable all
@@ -724,6 +761,29 @@ struct Default {
         // optionally-specified 'basicAllocator' is 0; return 'basicAllocator'
         // otherwise.
 
+    static Allocator *processDefaultAllocator();
+        // Return the address of the process-wide default allocator, ignoring
+        // any thread default allocator of the calling thread, and disable all
+        // subsequent calls to the 'setDefaultAllocator' method.
+
+                        // *** thread default allocator ***
+
+    static Allocator *setThreadDefaultAllocator(Allocator *basicAllocator);
+        // Install the specified 'basicAllocator' as the thread default
+        // allocator of the calling thread, or uninstall the thread default
+        // allocator of the calling thread if 'basicAllocator' is 0.  Return
+        // the thread default allocator of the calling thread in effect
+        // immediately before calling this method, or 0 if none was installed.
+        // The behavior is undefined unless 'basicAllocator' is 0 or is the
+        // address of an allocator that outlives every object created by the
+        // calling thread while it is installed.  Note that this method has no
+        // effect on other threads.
+
+    static Allocator *threadDefaultAllocator();
+        // Return the address of the thread default allocator of the calling
+        // thread, or 0 if none is installed.  Note that, unlike
+        // 'defaultAllocator', this method has no side-effects.
+
                         // *** global allocator ***
 
     static Allocator *globalAllocator(Allocator *basicAllocator = 0);
@@ -769,7 +829,7 @@ void Default::lockDefaultAllocator()
 }
 
 inline
-Allocator *Default::defaultAllocator()
+Allocator *Default::processDefaultAllocator()
 {
     if (!bsls::AtomicOperations::getPtrAcquire(&s_allocator)) {
         setDefaultAllocatorRaw(&NewDeleteAllocator::singleton());
@@ -783,12 +843,45 @@ Allocator *Default::defaultAllocator()
                          bsls::AtomicOperations::getPtrRelaxed(&s_allocator)));
 }
 
+inline
+Allocator *Default::defaultAllocator()
+{
+    Allocator *threadAllocator = s_threadAllocator_p;
+
+    if (threadAllocator) {
+        if (!bsls::AtomicOperations::getIntRelaxed(&s_locked)) {
+            bsls::AtomicOperations::setIntRelaxed(&s_locked, 1);
+        }
+        return threadAllocator;                                       // RETURN
+    }
+
+    return processDefaultAllocator();
+}
+
 inline
 Allocator *Default::allocator(Allocator *basicAllocator)
 {
     return basicAllocator ? basicAllocator : defaultAllocator();
 }
 
+                        // *** thread default allocator ***
+
+inline
+Allocator *Default::setThreadDefaultAllocator(Allocator *basicAllocator)
+{
+    Allocator *previous = s_threadAllocator_p;
+
+    s_threadAllocator_p = basicAllocator;
+
+    return previous;
+}
+
+inline
+Allocator *Default::threadDefaultAllocator()
+{
+    return s_threadAllocator_p;
+}
+
                         // *** global allocator ***
 
 inline
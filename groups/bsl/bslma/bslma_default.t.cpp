@@ -9,6 +9,7 @@
 #include <bsls_assert.h>
 #include <bsls_asserttest.h>
 #include <bsls_bsltestutil.h>
+#include <bsls_platform.h>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -16,6 +17,12 @@
 
 #include <new>
 
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 using namespace BloombergLP;
 
 //=============================================================================
@@ -36,21 +43,26 @@ using namespace BloombergLP;
 // accessor); case 3 tests 'setDefaultAllocator' and 'lockDefaultAllocator';
 // and case 4 tests 'allocator'.  The side-effects of 'defaultAllocator' and
 // 'allocator' are then tested in cases specifically targeted at them (cases 5
-// and 6 for 'defaultAllocator', and cases 7 and 8 for 'allocator').
+// and 6 for 'defaultAllocator', and cases 7 and 8 for 'allocator').  The
+// thread default allocator, which overrides the default allocator in a single
+// thread, is tested in case 10.
 //-----------------------------------------------------------------------------
 // [ 3] int setDefaultAllocator(*ba);
 // [ 2] void setDefaultAllocatorRaw(*ba);
 // [ 3] void lockDefaultAllocator();
 // [ 2] bslma::Allocator *defaultAllocator();
 // [ 4] bslma::Allocator *allocator(*ba = 0);
+// [10] bslma::Allocator *processDefaultAllocator();
+// [10] bslma::Allocator *setThreadDefaultAllocator(*ba);
+// [10] bslma::Allocator *threadDefaultAllocator();
 // [ 9] bslma::Allocator *globalAllocator(*ba = 0);
 // [ 9] bslma::Allocator *setGlobalAllocator(*ba);
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [ 2] BOOTSTRAP TEST
-// [10] USAGE EXAMPLE 1
-// [11] USAGE EXAMPLE 2
-// [12] USAGE EXAMPLE 3
+// [11] USAGE EXAMPLE 1
+// [12] USAGE EXAMPLE 2
+// [13] USAGE EXAMPLE 3
 
 //=============================================================================
 //                  STANDARD BDE ASSERT TEST MACRO
@@ -107,6 +119,66 @@ typedef bslma::Default Obj;
 //                  GLOBAL HELPER FUNCTIONS FOR TESTING
 //-----------------------------------------------------------------------------
 
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+struct ThreadDefaultArgs {
+    // This 'struct' holds the input and results of 'threadDefaultTest'.
+
+    bslma::Allocator *d_installed_p;       // thread default to install
+    bslma::Allocator *d_initialThread_p;   // 'threadDefaultAllocator' on entry
+    bslma::Allocator *d_initialDefault_p;  // 'defaultAllocator' on entry
+    bslma::Allocator *d_default_p;         // 'defaultAllocator' once installed
+    bslma::Allocator *d_allocator_p;       // 'allocator(0)' once installed
+};
+
+extern "C"
+void *threadDefaultTest(void *arg)
+    // Record the default allocators of this thread into the specified 'arg',
+    // the address of a 'ThreadDefaultArgs' object, before and after
+    // installing its 'd_installed_p' member as the thread default allocator.
+{
+    ThreadDefaultArgs *args = static_cast<ThreadDefaultArgs *>(arg);
+
+    args->d_initialThread_p  = bslma::Default::threadDefaultAllocator();
+    args->d_initialDefault_p = bslma::Default::defaultAllocator();
+
+    bslma::Default::setThreadDefaultAllocator(args->d_installed_p);
+
+    args->d_default_p   = bslma::Default::defaultAllocator();
+    args->d_allocator_p = bslma::Default::allocator(0);
+
+    return 0;
+}
+
 //=============================================================================
 //                  CLASSES FOR TESTING USAGE EXAMPLES
 //-----------------------------------------------------------------------------
@@ -507,7 +579,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 12: {
+      case 13: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE 3
         //
@@ -563,7 +635,7 @@ int main(int argc, char *argv[])
 //..
 
       } break;
-      case 11: {
+      case 12: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE 2
         //
@@ -655,7 +727,7 @@ int main(int argc, char *argv[])
 // invocations (i.e., even with correct code).
 
       } break;
-      case 10: {
+      case 11: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE 1
         //
@@ -730,6 +802,98 @@ int main(int argc, char *argv[])
 //..
 
       } break;
+      case 10: {
+        // --------------------------------------------------------------------
+        // TESTING THREAD DEFAULT ALLOCATOR
+        //
+        // Concerns:
+        //   1) Initially, no thread default allocator is installed.
+        //   2) 'setThreadDefaultAllocator' installs the thread default
+        //      allocator, and returns the one previously installed (or 0);
+        //      'threadDefaultAllocator' returns the one installed (or 0).
+        //   3) While a thread default allocator is installed, it is returned
+        //      by 'defaultAllocator', and by 'allocator' with a 0 argument,
+        //      but not by 'processDefaultAllocator'.
+        //   4) Passing 0 to 'setThreadDefaultAllocator' restores the
+        //      process-wide default allocator as the default allocator.
+        //   5) The thread default allocator of one thread has no effect on
+        //      other threads.
+        //   6) Installing a thread default allocator does not lock the
+        //      process-wide default allocator, but 'defaultAllocator' and
+        //      'processDefaultAllocator' do.
+        //
+        // Plan:
+        //   Install and uninstall thread default allocators in the main
+        //   thread, verifying the values returned by each method, and verify
+        //   that 'setDefaultAllocator' succeeds until 'defaultAllocator' is
+        //   called.  Then, while a thread default allocator is installed in
+        //   the main thread, create two threads installing their own thread
+        //   default allocators, and verify the allocators observed in each
+        //   thread.
+        //
+        // Testing:
+        //   bslma::Allocator *processDefaultAllocator();
+        //   bslma::Allocator *setThreadDefaultAllocator(*ba);
+        //   bslma::Allocator *threadDefaultAllocator();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING THREAD DEFAULT ALLOCATOR"
+                            "\n================================\n");
+
+        my_CountingAllocator mW;  bslma::Allocator *W = &mW;
+
+        if (verbose) printf("\nTesting the calling thread.\n");
+
+        ASSERT(0 == Obj::threadDefaultAllocator());
+
+        ASSERT(0 == Obj::setThreadDefaultAllocator(U));
+        ASSERT(U == Obj::threadDefaultAllocator());
+        ASSERT(0 == Obj::setDefaultAllocator(V));      // still unlocked
+
+        ASSERT(U == Obj::setThreadDefaultAllocator(W));
+        ASSERT(W == Obj::threadDefaultAllocator());
+        ASSERT(W == Obj::defaultAllocator());
+        ASSERT(W == Obj::allocator());
+        ASSERT(W == Obj::allocator(0));
+        ASSERT(U == Obj::allocator(U));
+        ASSERT(V == Obj::processDefaultAllocator());
+
+        ASSERT(0 != Obj::setDefaultAllocator(NDA));    // now locked
+        ASSERT(V == Obj::processDefaultAllocator());
+
+        ASSERT(W == Obj::setThreadDefaultAllocator(0));
+        ASSERT(0 == Obj::threadDefaultAllocator());
+        ASSERT(V == Obj::defaultAllocator());
+        ASSERT(V == Obj::allocator(0));
+
+        if (verbose) printf("\nTesting other threads.\n");
+
+        ASSERT(0 == Obj::setThreadDefaultAllocator(W));
+
+        ThreadDefaultArgs args[2] = { { U, 0, 0, 0, 0 },
+                                      { 0, 0, 0, 0, 0 } };
+
+        ThreadId t0 = createThread(&threadDefaultTest, &args[0]);
+        ThreadId t1 = createThread(&threadDefaultTest, &args[1]);
+        joinThread(t0);
+        joinThread(t1);
+
+        ASSERT(0 == args[0].d_initialThread_p);
+        ASSERT(V == args[0].d_initialDefault_p);
+        ASSERT(U == args[0].d_default_p);
+        ASSERT(U == args[0].d_allocator_p);
+
+        ASSERT(0 == args[1].d_initialThread_p);
+        ASSERT(V == args[1].d_initialDefault_p);
+        ASSERT(V == args[1].d_default_p);
+        ASSERT(V == args[1].d_allocator_p);
+
+        ASSERT(W == Obj::threadDefaultAllocator());
+        ASSERT(W == Obj::defaultAllocator());
+
+        ASSERT(W == Obj::setThreadDefaultAllocator(0));
+        ASSERT(V == Obj::defaultAllocator());
+      } break;
       case 9: {
         // --------------------------------------------------------------------
         // TESTING GLOBAL ALLOCATOR
@@ -0,0 +1,584 @@
+// bslma_localsharedptroutofplacerep.h                                -*-C++-*-
+#ifndef INCLUDED_BSLMA_LOCALSHAREDPTROUTOFPLACEREP
+#define INCLUDED_BSLMA_LOCALSHAREDPTROUTOFPLACEREP
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id$ $CSID$")
+
+//@PURPOSE: Provide an out-of-place implementation of 'LocalSharedPtrRep'.
+//
+//@CLASSES:
+//  bslma::LocalSharedPtrOutofplaceRep: out-of-place local shared ptr rep
+//
+//@SEE_ALSO: bslma_localsharedptrrep, bslma_sharedptroutofplacerep,
+//           bslstl_localsharedptr
+//
+//@DESCRIPTION: This component provides a concrete implementation of
+// 'bslma::LocalSharedPtrRep' for managing objects of the parameterized 'TYPE'
+// that are stored outside of the representation.  When all references to the
+// out-of-place object are released, the deleter of the parameterized 'DELETER'
+// type is invoked to delete the shared object.  This component is the
+// single-threaded counterpart of 'bslma_sharedptroutofplacerep', and supports
+// the same kinds of deleters.
+//
+///Thread-Safety
+///-------------
+// 'bslma::LocalSharedPtrOutofplaceRep' provides the thread-safety guarantees
+// of 'bslma::LocalSharedPtrRep': local references must be acquired and
+// released by a single thread, whereas shared and weak references obtained
+// from the base 'bslma::SharedPtrRep' may be released from any thread.
+//
+///Deleters
+///--------
+// When the last reference to a shared object is released, the object is
+// destroyed using the "deleter" provided when the representation was created.
+// As for 'bslma::SharedPtrOutofplaceRep', both "function-like" deleters
+// (invoked as 'deleterInstance(objectPtr)') and "factory" deleters (invoked as
+// 'deleterInstance->deleteObject(objectPtr)') are supported:
+//..
+//  Deleter                     Expression used to destroy 'objectPtr'
+//  - - - - - - - -             - - - - - - - - - - - - - - - - - - -
+//  "function-like"             deleterInstance(objectPtr);
+//  "factory"                   deleterInstance->deleteObject(objectPtr);
+//..
+// A deleter is treated as a factory if it is a pointer to an object (e.g., a
+// 'bslma::Allocator *'), and as function-like otherwise (e.g., a function
+// pointer or a functor).  A function-like deleter that uses 'bslma'
+// allocators is supplied the allocator of the representation at construction.
+// A null 'bslma::Allocator *' deleter denotes the currently installed default
+// allocator.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Managing an Object Allocated by an Allocator
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The following example demonstrates how to create a single-threaded shared
+// representation for an 'int' allocated by a 'bslma::TestAllocator'.  First,
+// we allocate the object:
+//..
+//  bslma::TestAllocator ta;
+//  int *value = new (ta) int(7);
+//..
+// Then, we create a representation that uses the same allocator both as the
+// deleter of the object and to supply memory for the representation itself:
+//..
+//  typedef bslma::LocalSharedPtrOutofplaceRep<int, bslma::Allocator *> Rep;
+//
+//  Rep *rep = Rep::makeOutofplaceRep(value, &ta, &ta);
+//  assert(value == rep->ptr());
+//  assert(1     == rep->numLocalReferences());
+//  assert(2     == ta.numBlocksInUse());
+//..
+// Finally, we release the only local reference, which deletes the 'int' and
+// the representation:
+//..
+//  rep->releaseLocalRef();
+//  assert(0 == ta.numBlocksInUse());
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_LOCALSHAREDPTRREP
+#include <bslma_localsharedptrrep.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_CONDITIONAL
+#include <bslmf_conditional.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_FUNCTIONPOINTERTRAITS
+#include <bslmf_functionpointertraits.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISCONVERTIBLE
+#include <bslmf_isconvertible.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISFUNCTION
+#include <bslmf_isfunction.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISPOINTER
+#include <bslmf_ispointer.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_METAINT
+#include <bslmf_metaint.h>
+#endif
+
+#ifndef INCLUDED_BSLS_UTIL
+#include <bsls_util.h>
+#endif
+
+#ifndef INCLUDED_TYPEINFO
+#include <typeinfo>
+#define INCLUDED_TYPEINFO
+#endif
+
+namespace BloombergLP {
+namespace bslma {
+
+template <class DELETER>
+struct LocalSharedPtrOutofplaceRep_DeleterTraits;
+
+                   // =================================
+                   // class LocalSharedPtrOutofplaceRep
+                   // =================================
+
+template <class TYPE, class DELETER>
+class LocalSharedPtrOutofplaceRep : public LocalSharedPtrRep {
+    // This class provides a concrete implementation of the
+    // 'LocalSharedPtrRep' protocol for out-of-place instances of the
+    // parameterized 'TYPE'.  Upon disposal of the shared object, the
+    // parameterized 'DELETER' type is invoked on the pointer to the shared
+    // object.
+
+    // PRIVATE TYPES
+    typedef LocalSharedPtrOutofplaceRep_DeleterTraits<DELETER> Traits;
+
+    typedef typename Traits::Type Deleter;
+        // 'Deleter' is an alias for the type of deleter used to destroy the
+        // shared object.
+
+    // DATA
+    Deleter    d_deleter;      // deleter for this out-of-place instance
+    TYPE      *d_ptr_p;        // pointer to out-of-place instance (held, not
+                               // owned)
+    Allocator *d_allocator_p;  // memory allocator (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    LocalSharedPtrOutofplaceRep(const LocalSharedPtrOutofplaceRep&);
+    LocalSharedPtrOutofplaceRep& operator=(
+                                           const LocalSharedPtrOutofplaceRep&);
+
+    // PRIVATE CREATORS
+    LocalSharedPtrOutofplaceRep(TYPE              *ptr,
+                                const DELETER&     deleter,
+                                Allocator         *basicAllocator,
+                                bslmf::MetaInt<0>);
+    LocalSharedPtrOutofplaceRep(TYPE              *ptr,
+                                const DELETER&     deleter,
+                                Allocator         *basicAllocator,
+                                bslmf::MetaInt<1>);
+        // Create a 'LocalSharedPtrOutofplaceRep' that manages the lifetime of
+        // the specified 'ptr', using the specified 'deleter' to destroy 'ptr',
+        // and using the specified 'basicAllocator' to supply memory.  The
+        // trailing tag argument indicates whether 'basicAllocator' should be
+        // passed to the constructor of the stored deleter.
+
+    ~LocalSharedPtrOutofplaceRep();
+        // Destroy this representation object.  Note that this destructor is
+        // never called explicitly.  Instead, 'disposeObject' destroys the
+        // shared object and 'disposeRep' deallocates this representation
+        // object.
+
+  public:
+    // CLASS METHODS
+    static LocalSharedPtrOutofplaceRep *makeOutofplaceRep(
+                                           TYPE           *ptr,
+                                           const DELETER&  deleter,
+                                           Allocator      *basicAllocator = 0);
+        // Return the address of a newly created 'LocalSharedPtrOutofplaceRep'
+        // object that manages the lifetime of the specified 'ptr', using the
+        // specified 'deleter' to destroy 'ptr'.  Optionally, specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  If an exception
+        // is thrown while creating the representation, 'ptr' is destroyed
+        // using 'deleter'.
+
+    // MANIPULATORS
+    virtual void disposeObject();
+        // Destroy the object being referred to by this representation.  This
+        // method is automatically invoked by 'releaseRef' when the number of
+        // shared references reaches zero and should not be explicitly invoked
+        // otherwise.
+
+    virtual void disposeRep();
+        // Destroy this representation object and deallocate the associated
+        // memory.  This method is automatically invoked by 'releaseRef' and
+        // 'releaseWeakRef' when the number of weak references and the number
+        // of shared references both reach zero and should not be explicitly
+        // invoked otherwise.  The behavior is undefined unless
+        // 'disposeObject' has already been called for this representation.
+
+    virtual void *getDeleter(const std::type_info& type);
+        // Return a pointer to the deleter stored by this representation if the
+        // deleter has the same type as that described by the specified
+        // 'type', and a null pointer otherwise.
+
+    // ACCESSORS
+    virtual void *originalPtr() const;
+        // Return the (untyped) address of the modifiable shared object to
+        // which this object refers.
+
+    TYPE *ptr() const;
+        // Return the address of the modifiable shared object to which this
+        // object refers.
+};
+
+           // ================================================
+           // struct LocalSharedPtrOutofplaceRep_DeleterTraits
+           // ================================================
+
+template <class DELETER>
+struct LocalSharedPtrOutofplaceRep_DeleterTraits {
+    // This component-private 'struct' provides the stored type of a 'DELETER'
+    // and the operations needed to invoke it.
+
+    enum {
+        // Enumeration that calls meta-functions to describe properties of
+        // the deleter.
+
+        k_IS_ALLOCATOR_PTR = bsl::is_convertible<DELETER, Allocator *>::value,
+
+        k_IS_FACTORY_PTR   = bsl::is_pointer<DELETER>::value
+                          && !bslmf::IsFunctionPointer<DELETER>::value,
+
+        k_USES_ALLOCATOR   = !k_IS_ALLOCATOR_PTR
+                          && UsesBslmaAllocator<DELETER>::value
+    };
+
+    // TYPES
+    typedef typename bsl::conditional<bsl::is_function<DELETER>::value,
+                                      DELETER *,
+                                      DELETER>::type FunctorType;
+        // 'FunctorType' is the type used to store a function-like 'DELETER'.
+
+    typedef typename bsl::conditional<k_IS_ALLOCATOR_PTR,
+                                      Allocator *,
+                                      FunctorType>::type Type;
+        // 'Type' is the type used to store a 'DELETER'.
+
+  private:
+    // PRIVATE CLASS METHODS
+    template <class TYPE>
+    static void deleteObject(TYPE *ptr, Type& deleter, bslmf::MetaInt<1>);
+        // Destroy the specified 'ptr' by invoking 'deleter->deleteObject'.
+
+    template <class TYPE>
+    static void deleteObject(TYPE *ptr, Type& deleter, bslmf::MetaInt<0>);
+        // Destroy the specified 'ptr' by invoking 'deleter(ptr)'.
+
+    static Type normalize(const DELETER& deleter, bslmf::MetaInt<1>);
+    static const DELETER& normalize(const DELETER& deleter, bslmf::MetaInt<0>);
+        // Return the specified 'deleter', replacing a null allocator pointer
+        // by the currently installed default allocator if the trailing tag is
+        // 'MetaInt<1>'.
+
+  public:
+    // CLASS METHODS
+    template <class TYPE>
+    static void deleteObject(TYPE *ptr, Type& deleter);
+        // Destroy the specified 'ptr' using the specified 'deleter'.
+
+    static Type normalize(const DELETER& deleter);
+        // Return the value to be stored for the specified 'deleter': the
+        // currently installed default allocator if 'deleter' is a null
+        // 'bslma::Allocator' pointer, and 'deleter' otherwise.
+};
+
+          // ================================================
+          // class LocalSharedPtrOutofplaceRep_InitProctor
+          // ================================================
+
+template <class TYPE, class DELETER>
+class LocalSharedPtrOutofplaceRep_InitProctor {
+    // This component-private proctor deletes, using the supplied deleter, the
+    // object it manages unless 'release' is called.  It is used to destroy
+    // the shared object if creating its representation throws.
+
+    // PRIVATE TYPES
+    typedef LocalSharedPtrOutofplaceRep_InitProctor SelfType;
+
+    // DATA
+    TYPE           *d_ptr_p;    // managed object (held, not owned)
+    const DELETER&  d_deleter;  // deleter used to destroy 'd_ptr_p'
+
+  private:
+    // NOT IMPLEMENTED
+    LocalSharedPtrOutofplaceRep_InitProctor(const SelfType&);
+    SelfType& operator=(const SelfType&);
+
+  public:
+    // CREATORS
+    LocalSharedPtrOutofplaceRep_InitProctor(TYPE *ptr, const DELETER& deleter);
+        // Create a proctor managing the specified 'ptr' and using the
+        // specified 'deleter' to destroy it.
+
+    ~LocalSharedPtrOutofplaceRep_InitProctor();
+        // Destroy this proctor and the object (if any) it manages.
+
+    // MANIPULATORS
+    void release();
+        // Release from management the object referred to by this proctor.
+};
+
+// ============================================================================
+//              INLINE FUNCTION AND FUNCTION TEMPLATE DEFINITIONS
+// ============================================================================
+
+                   // ---------------------------------
+                   // class LocalSharedPtrOutofplaceRep
+                   // ---------------------------------
+
+// PRIVATE CREATORS
+template <class TYPE, class DELETER>
+inline
+LocalSharedPtrOutofplaceRep<TYPE, DELETER>::LocalSharedPtrOutofplaceRep(
+                                               TYPE           *ptr,
+                                               const DELETER&  deleter,
+                                               Allocator      *basicAllocator,
+                                               bslmf::MetaInt<0>)
+: d_deleter(Traits::normalize(deleter))
+, d_ptr_p(ptr)
+, d_allocator_p(basicAllocator)
+{
+}
+
+template <class TYPE, class DELETER>
+inline
+LocalSharedPtrOutofplaceRep<TYPE, DELETER>::LocalSharedPtrOutofplaceRep(
+                                               TYPE           *ptr,
+                                               const DELETER&  deleter,
+                                               Allocator      *basicAllocator,
+                                               bslmf::MetaInt<1>)
+: d_deleter(deleter, basicAllocator)
+, d_ptr_p(ptr)
+, d_allocator_p(basicAllocator)
+{
+}
+
+template <class TYPE, class DELETER>
+inline
+LocalSharedPtrOutofplaceRep<TYPE, DELETER>::~LocalSharedPtrOutofplaceRep()
+{
+}
+
+// CLASS METHODS
+template <class TYPE, class DELETER>
+LocalSharedPtrOutofplaceRep<TYPE, DELETER> *
+LocalSharedPtrOutofplaceRep<TYPE, DELETER>::makeOutofplaceRep(
+                                                TYPE           *ptr,
+                                                const DELETER&  deleter,
+                                                Allocator      *basicAllocator)
+{
+    LocalSharedPtrOutofplaceRep_InitProctor<TYPE, DELETER> proctor(ptr,
+                                                                   deleter);
+
+    basicAllocator = Default::allocator(basicAllocator);
+    LocalSharedPtrOutofplaceRep *rep = new (*basicAllocator)
+                       LocalSharedPtrOutofplaceRep(
+                              ptr,
+                              deleter,
+                              basicAllocator,
+                              bslmf::MetaInt<(int)Traits::k_USES_ALLOCATOR>());
+
+    proctor.release();
+    return rep;
+}
+
+// MANIPULATORS
+template <class TYPE, class DELETER>
+void LocalSharedPtrOutofplaceRep<TYPE, DELETER>::disposeObject()
+{
+    Traits::deleteObject(d_ptr_p, d_deleter);
+    d_ptr_p = 0;
+}
+
+template <class TYPE, class DELETER>
+void LocalSharedPtrOutofplaceRep<TYPE, DELETER>::disposeRep()
+{
+    // Knowing 'LocalSharedPtrOutofplaceRep' is the most derived class, the
+    // virtual function call (and 'dynamic_cast') that would be incurred by
+    // 'd_allocator_p->deleteObject(this)' is avoided by explicitly calling
+    // the destructor (see 'bslma::SharedPtrOutofplaceRep::disposeRep').
+
+    Allocator *allocator = d_allocator_p;
+    this->LocalSharedPtrOutofplaceRep<TYPE, DELETER>::
+                                               ~LocalSharedPtrOutofplaceRep();
+    allocator->deallocate(this);
+}
+
+template <class TYPE, class DELETER>
+inline
+void *LocalSharedPtrOutofplaceRep<TYPE, DELETER>::getDeleter(
+                                                  const std::type_info& type)
+{
+    return (typeid(d_deleter) == type)
+         ? bsls::Util::addressOf(d_deleter)
+         : 0;
+}
+
+// ACCESSORS
+template <class TYPE, class DELETER>
+inline
+void *LocalSharedPtrOutofplaceRep<TYPE, DELETER>::originalPtr() const
+{
+    return const_cast<void *>(static_cast<const void *>(d_ptr_p));
+}
+
+template <class TYPE, class DELETER>
+inline
+TYPE *LocalSharedPtrOutofplaceRep<TYPE, DELETER>::ptr() const
+{
+    return d_ptr_p;
+}
+
+           // ------------------------------------------------
+           // struct LocalSharedPtrOutofplaceRep_DeleterTraits
+           // ------------------------------------------------
+
+// PRIVATE CLASS METHODS
+template <class DELETER>
+template <class TYPE>
+inline
+void LocalSharedPtrOutofplaceRep_DeleterTraits<DELETER>::deleteObject(
+                                                   TYPE              *ptr,
+                                                   Type&              deleter,
+                                                   bslmf::MetaInt<1>)
+{
+    deleter->deleteObject(ptr);
+}
+
+template <class DELETER>
+template <class TYPE>
+inline
+void LocalSharedPtrOutofplaceRep_DeleterTraits<DELETER>::deleteObject(
+                                                   TYPE              *ptr,
+                                                   Type&              deleter,
+                                                   bslmf::MetaInt<0>)
+{
+    deleter(ptr);
+}
+
+// CLASS METHODS
+template <class DELETER>
+template <class TYPE>
+inline
+void LocalSharedPtrOutofplaceRep_DeleterTraits<DELETER>::deleteObject(
+                                                         TYPE  *ptr,
+                                                         Type&  deleter)
+{
+    deleteObject(ptr, deleter, bslmf::MetaInt<(int)k_IS_FACTORY_PTR>());
+}
+
+template <class DELETER>
+inline
+typename LocalSharedPtrOutofplaceRep_DeleterTraits<DELETER>::Type
+LocalSharedPtrOutofplaceRep_DeleterTraits<DELETER>::normalize(
+                                                       const DELETER& deleter)
+{
+    return normalize(deleter, bslmf::MetaInt<(int)k_IS_ALLOCATOR_PTR>());
+}
+
+template <class DELETER>
+inline
+typename LocalSharedPtrOutofplaceRep_DeleterTraits<DELETER>::Type
+LocalSharedPtrOutofplaceRep_DeleterTraits<DELETER>::normalize(
+                                                const DELETER&    deleter,
+                                                bslmf::MetaInt<1>)
+{
+    return Default::allocator(deleter);
+}
+
+template <class DELETER>
+inline
+const DELETER&
+LocalSharedPtrOutofplaceRep_DeleterTraits<DELETER>::normalize(
+                                                const DELETER&    deleter,
+                                                bslmf::MetaInt<0>)
+{
+    return deleter;
+}
+
+          // ------------------------------------------------
+          // class LocalSharedPtrOutofplaceRep_InitProctor
+          // ------------------------------------------------
+
+// CREATORS
+template <class TYPE, class DELETER>
+inline
+LocalSharedPtrOutofplaceRep_InitProctor<TYPE, DELETER>::
+LocalSharedPtrOutofplaceRep_InitProctor(TYPE *ptr, const DELETER& deleter)
+: d_ptr_p(ptr)
+, d_deleter(deleter)
+{
+}
+
+template <class TYPE, class DELETER>
+inline
+LocalSharedPtrOutofplaceRep_InitProctor<TYPE, DELETER>::
+~LocalSharedPtrOutofplaceRep_InitProctor()
+{
+    if (!d_ptr_p) {
+        return;                                                       // RETURN
+    }
+
+    typedef LocalSharedPtrOutofplaceRep_DeleterTraits<DELETER> Traits;
+
+    typename Traits::Type tempDeleter(Traits::normalize(d_deleter));
+    Traits::deleteObject(d_ptr_p, tempDeleter);
+}
+
+// MANIPULATORS
+template <class TYPE, class DELETER>
+inline
+void LocalSharedPtrOutofplaceRep_InitProctor<TYPE, DELETER>::release()
+{
+    d_ptr_p = 0;
+}
+
+}  // close package namespace
+
+// ============================================================================
+//                              TYPE TRAITS
+// ============================================================================
+
+namespace bslma {
+
+template <class TYPE, class DELETER>
+struct UsesBslmaAllocator<
+                       LocalSharedPtrOutofplaceRep_InitProctor<TYPE, DELETER> >
+    : bsl::false_type
+{
+};
+
+}  // close namespace bslma
+}  // close namespace BloombergLP
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,516 @@
+// bslma_localsharedptroutofplacerep.t.cpp                            -*-C++-*-
+#include <bslma_localsharedptroutofplacerep.h>
+
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+#include <bsls_bsltestutil.h>
+
+#include <stdio.h>
+#include <stdlib.h>             // 'atoi'
+
+#ifdef BSLS_PLATFORM_CMP_MSVC  // Microsoft Compiler
+#ifdef _MSC_EXTENSIONS         // Microsoft Extensions Enabled
+#include <new>                 // if so, need to include new as well
+#endif
+#endif
+
+using namespace BloombergLP;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// 'bslma::LocalSharedPtrOutofplaceRep' is a concrete single-threaded shared
+// pointer representation for an object stored outside the representation.  We
+// verify that representations are created using the correct allocator, that
+// each kind of deleter (function pointer, functor, factory, and allocator) is
+// invoked exactly once when the last reference is released, and that the
+// deleter can be retrieved with 'getDeleter'.
+//-----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] LocalSharedPtrOutofplaceRep *makeOutofplaceRep(TYPE *, const D&, *ba);
+//
+// MANIPULATORS
+// [ 2] void disposeObject();
+// [ 2] void disposeRep();
+// [ 4] void *getDeleter(const std::type_info& type);
+//
+// ACCESSORS
+// [ 4] void *originalPtr() const;
+// [ 2] TYPE *ptr() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] FACTORY AND ALLOCATOR DELETERS
+// [ 5] USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACROS
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                     STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+#define ASSERT_SAFE_PASS_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS_RAW(EXPR)
+#define ASSERT_SAFE_FAIL_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL_RAW(EXPR)
+#define ASSERT_PASS_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS_RAW(EXPR)
+#define ASSERT_FAIL_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL_RAW(EXPR)
+#define ASSERT_OPT_PASS_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS_RAW(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static int numFunctionDeleterCalls = 0;
+
+//=============================================================================
+//             GLOBAL HELPER CLASSES AND FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+void myFunctionDeleter(int *ptr)
+    // Delete the specified 'ptr' and increment 'numFunctionDeleterCalls'.
+{
+    ++numFunctionDeleterCalls;
+    delete ptr;
+}
+
+                            // ===============
+                            // class MyDeleter
+                            // ===============
+
+class MyDeleter {
+    // This class provides a function-like deleter that counts the number of
+    // times it is invoked.
+
+    // DATA
+    int *d_numCalls_p;  // invocation counter (held, not owned)
+
+  public:
+    // CREATORS
+    explicit MyDeleter(int *numCalls)
+    : d_numCalls_p(numCalls)
+    {
+    }
+
+    // ACCESSORS
+    void operator()(int *ptr) const
+    {
+        ++*d_numCalls_p;
+        delete ptr;
+    }
+};
+
+                            // ===============
+                            // class MyFactory
+                            // ===============
+
+class MyFactory {
+    // This class provides a factory deleter that counts the number of objects
+    // it has deleted.
+
+    // DATA
+    int d_numDeleted;
+
+  public:
+    // CREATORS
+    MyFactory()
+    : d_numDeleted(0)
+    {
+    }
+
+    // MANIPULATORS
+    void deleteObject(int *ptr)
+    {
+        ++d_numDeleted;
+        delete ptr;
+    }
+
+    // ACCESSORS
+    int numDeleted() const
+    {
+        return d_numDeleted;
+    }
+};
+
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+    bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVerbose;
+    (void)veryVeryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    // Confirm no static intialization locked the global allocator
+    ASSERT(&globalAllocator == bslma::Default::globalAllocator());
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    // Confirm no static intialization locked the default allocator
+    ASSERT(&defaultAllocator == bslma::Default::defaultAllocator());
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+///Example 1: Managing an Object Allocated by an Allocator
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The following example demonstrates how to create a single-threaded shared
+// representation for an 'int' allocated by a 'bslma::TestAllocator'.  First,
+// we allocate the object:
+//..
+    bslma::TestAllocator ta;
+    int *value = new (ta) int(7);
+//..
+// Then, we create a representation that uses the same allocator both as the
+// deleter of the object and to supply memory for the representation itself:
+//..
+    typedef bslma::LocalSharedPtrOutofplaceRep<int, bslma::Allocator *> Rep;
+
+    Rep *rep = Rep::makeOutofplaceRep(value, &ta, &ta);
+    ASSERT(value == rep->ptr());
+    ASSERT(1     == rep->numLocalReferences());
+    ASSERT(2     == ta.numBlocksInUse());
+//..
+// Finally, we release the only local reference, which deletes the 'int' and
+// the representation:
+//..
+    rep->releaseLocalRef();
+    ASSERT(0 == ta.numBlocksInUse());
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'getDeleter' AND 'originalPtr'
+        //
+        // Concerns:
+        //: 1 'getDeleter' returns the address of the stored deleter if, and
+        //:   only if, the requested type matches the type of the deleter.
+        //:
+        //: 2 'originalPtr' returns the address of the managed object.
+        //
+        // Plan:
+        //: 1 Create a representation with a functor deleter, and query
+        //:   'getDeleter' with matching and non-matching types.  (C-1..2)
+        //
+        // Testing:
+        //   void *getDeleter(const std::type_info& type);
+        //   void *originalPtr() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'getDeleter' AND 'originalPtr'"
+                            "\n======================================\n");
+
+        typedef bslma::LocalSharedPtrOutofplaceRep<int, MyDeleter> Rep;
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+        int                  numCalls = 0;
+        int                 *value    = new int(3);
+
+        Rep *rep = Rep::makeOutofplaceRep(value, MyDeleter(&numCalls), &ta);
+
+        ASSERT(value == rep->originalPtr());
+        ASSERT(0     != rep->getDeleter(typeid(MyDeleter)));
+        ASSERT(0     == rep->getDeleter(typeid(MyFactory)));
+        ASSERT(0     == rep->getDeleter(typeid(int)));
+
+        rep->releaseLocalRef();
+        ASSERT(1 == numCalls);
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // FACTORY AND ALLOCATOR DELETERS
+        //
+        // Concerns:
+        //: 1 A pointer to a factory is used by calling 'deleteObject'.
+        //:
+        //: 2 An allocator deleter destroys the object and returns its memory
+        //:   to the allocator.
+        //:
+        //: 3 A null allocator deleter denotes the default allocator.
+        //
+        // Plan:
+        //: 1 Create representations with each kind of factory deleter and
+        //:   release them, checking the factory and allocator state.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   FACTORY AND ALLOCATOR DELETERS
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nFACTORY AND ALLOCATOR DELETERS"
+                            "\n==============================\n");
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+        if (verbose) printf("\nFactory deleter.\n");
+        {
+            typedef bslma::LocalSharedPtrOutofplaceRep<int, MyFactory *> Rep;
+
+            MyFactory factory;
+
+            Rep *rep = Rep::makeOutofplaceRep(new int(1), &factory, &ta);
+            ASSERT(1 == ta.numBlocksInUse());
+
+            rep->releaseLocalRef();
+            ASSERT(1 == factory.numDeleted());
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) printf("\nAllocator deleter.\n");
+        {
+            typedef bslma::LocalSharedPtrOutofplaceRep<int,
+                                                       bslma::TestAllocator *>
+                                                                           Rep;
+
+            bslma::TestAllocator oa(veryVeryVeryVerbose);
+
+            Rep *rep = Rep::makeOutofplaceRep(new (oa) int(2), &oa, &ta);
+            ASSERT(1 == oa.numBlocksInUse());
+            ASSERT(1 == ta.numBlocksInUse());
+
+            rep->releaseLocalRef();
+            ASSERT(0 == oa.numBlocksInUse());
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) printf("\nNull allocator deleter.\n");
+        {
+            typedef bslma::LocalSharedPtrOutofplaceRep<int, bslma::Allocator *>
+                                                                           Rep;
+
+            bslma::Allocator *nullAllocator = 0;
+
+            Rep *rep = Rep::makeOutofplaceRep(new (defaultAllocator) int(3),
+                                              nullAllocator,
+                                              &ta);
+            ASSERT(1 == defaultAllocator.numBlocksInUse());
+
+            rep->releaseLocalRef();
+            ASSERT(0 == defaultAllocator.numBlocksInUse());
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'makeOutofplaceRep' AND FUNCTION-LIKE DELETERS
+        //
+        // Concerns:
+        //: 1 The representation is allocated from the supplied allocator, or
+        //:   from the default allocator if none is supplied.
+        //:
+        //: 2 'ptr' returns the managed object.
+        //:
+        //: 3 Function-pointer and functor deleters are invoked exactly once,
+        //:   when the last reference (local or shared) is released.
+        //
+        // Plan:
+        //: 1 Create representations using function-pointer and functor
+        //:   deleters, with and without an allocator, acquire and release
+        //:   references, and check the deleter and allocator state after each
+        //:   step.  (C-1..3)
+        //
+        // Testing:
+        //   LocalSharedPtrOutofplaceRep *makeOutofplaceRep(TYPE *, D&, *ba);
+        //   void disposeObject();
+        //   void disposeRep();
+        //   TYPE *ptr() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf(
+                 "\nTESTING 'makeOutofplaceRep' AND FUNCTION-LIKE DELETERS"
+                 "\n======================================================\n");
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+        if (verbose) printf("\nFunction-pointer deleter.\n");
+        {
+            typedef void (*Deleter)(int *);
+            typedef bslma::LocalSharedPtrOutofplaceRep<int, Deleter> Rep;
+
+            numFunctionDeleterCalls = 0;
+            int *value = new int(4);
+
+            Rep *rep = Rep::makeOutofplaceRep(value, &myFunctionDeleter, &ta);
+            ASSERT(value == rep->ptr());
+            ASSERT(1     == ta.numBlocksInUse());
+
+            rep->acquireLocalRef();
+            rep->releaseLocalRef();
+            ASSERT(0 == numFunctionDeleterCalls);
+
+            rep->releaseLocalRef();
+            ASSERT(1 == numFunctionDeleterCalls);
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) printf("\nFunctor deleter and default allocator.\n");
+        {
+            typedef bslma::LocalSharedPtrOutofplaceRep<int, MyDeleter> Rep;
+
+            int numCalls = 0;
+
+            Rep *rep = Rep::makeOutofplaceRep(new int(5),
+                                              MyDeleter(&numCalls));
+            ASSERT(1 == defaultAllocator.numBlocksInUse());
+
+            rep->acquireRef();
+            rep->releaseLocalRef();
+            ASSERT(0 == numCalls);
+            ASSERT(1 == defaultAllocator.numBlocksInUse());
+
+            rep->releaseRef();
+            ASSERT(1 == numCalls);
+            ASSERT(0 == defaultAllocator.numBlocksInUse());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a representation managing an object allocated from a test
+        //:   allocator, acquire and release local references, and verify that
+        //:   all memory is returned.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        typedef bslma::LocalSharedPtrOutofplaceRep<int, bslma::Allocator *>
+                                                                           Rep;
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+        Rep *rep = Rep::makeOutofplaceRep(new (ta) int(42), &ta, &ta);
+        ASSERT(42 == *rep->ptr());
+        ASSERT(2  == ta.numBlocksInUse());
+
+        rep->acquireLocalRef();
+        ASSERT(2 == rep->numLocalReferences());
+
+        rep->releaseLocalRef();
+        ASSERT(2 == ta.numBlocksInUse());
+
+        rep->releaseLocalRef();
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,290 @@
+// bslma_localsharedptrrep.h                                          -*-C++-*-
+#ifndef INCLUDED_BSLMA_LOCALSHAREDPTRREP
+#define INCLUDED_BSLMA_LOCALSHAREDPTRREP
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id$ $CSID$")
+
+//@PURPOSE: Provide an abstract single-threaded shared object manager.
+//
+//@CLASSES:
+//  bslma::LocalSharedPtrRep : single-threaded shared pointer representation
+//
+//@SEE_ALSO: bslma_sharedptrrep, bslma_localsharedptroutofplacerep,
+//           bslstl_localsharedptr
+//
+//@DESCRIPTION: This component provides a partially implemented abstract class,
+// 'bslma::LocalSharedPtrRep', for managing the lifetime of a shared object
+// whose shared references are (almost always) created and released by a single
+// thread.  'bslma::LocalSharedPtrRep' extends 'bslma::SharedPtrRep' with a
+// third, *non*-atomic, counter: the number of "local" references to the shared
+// object.  All local references, collectively, hold exactly one (atomic)
+// shared reference of the base 'bslma::SharedPtrRep'; acquiring and releasing
+// local references is therefore ordinary integer arithmetic, and the only
+// atomic operations performed are those of the base class when the first local
+// reference is created (a relaxed store) and when the last local reference is
+// released.
+//
+///Local and Shared References
+///---------------------------
+// A local reference is acquired with 'acquireLocalRef' and released with
+// 'releaseLocalRef'.  When the last local reference is released, the one
+// shared reference held on behalf of all local references is released using
+// 'releaseRef', which disposes of the shared object (and of this
+// representation) unless other (non-local) references remain.
+//
+// Ordinary (thread-safe) shared and weak references can be acquired from the
+// base 'bslma::SharedPtrRep' at any time while a local reference is held (see
+// 'acquireRef' and 'acquireWeakRef').  Such references may be passed to, and
+// released from, other threads.  This is how a 'bsl::local_shared_ptr' is
+// converted to a 'bsl::shared_ptr' when the shared object must cross a thread
+// boundary.
+//
+///Thread-Safety
+///-------------
+// The local reference count of a 'bslma::LocalSharedPtrRep' is *not* protected
+// by any synchronization: 'acquireLocalRef', 'releaseLocalRef',
+// 'numLocalReferences', and 'hasUniqueLocalOwner' must not be called
+// concurrently on the same object from different threads.  Typically, all
+// local references are created and released by a single thread (the thread
+// that created the representation).  The operations inherited from
+// 'bslma::SharedPtrRep' retain their thread-safety guarantees.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Implementing a Local Representation
+/// - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we want to share an 'int' that is owned by a single thread.  First,
+// we define a concrete representation that stores the 'int' in-place and
+// returns its footprint to an allocator when disposed:
+//..
+//  class MyLocalIntRep : public bslma::LocalSharedPtrRep {
+//      // This class provides a concrete single-threaded shared pointer
+//      // representation for an in-place 'int'.
+//
+//      // DATA
+//      bslma::Allocator *d_allocator_p;  // memory allocator (held, not owned)
+//      int               d_value;        // in-place object
+//
+//    public:
+//      // CREATORS
+//      MyLocalIntRep(int value, bslma::Allocator *basicAllocator)
+//      : d_allocator_p(basicAllocator)
+//      , d_value(value)
+//      {
+//      }
+//
+//      // MANIPULATORS
+//      virtual void disposeObject()
+//      {
+//      }
+//
+//      virtual void disposeRep()
+//      {
+//          d_allocator_p->deallocate(this);
+//      }
+//
+//      virtual void *getDeleter(const std::type_info&)
+//      {
+//          return 0;
+//      }
+//
+//      int *ptr()
+//      {
+//          return &d_value;
+//      }
+//
+//      // ACCESSORS
+//      virtual void *originalPtr() const
+//      {
+//          return const_cast<int *>(&d_value);
+//      }
+//  };
+//..
+// Then, we create a representation, which has one local reference:
+//..
+//  bslma::TestAllocator ta;
+//  MyLocalIntRep *rep = new (ta) MyLocalIntRep(42, &ta);
+//
+//  assert(1 == rep->numLocalReferences());
+//  assert(1 == rep->numReferences());
+//..
+// Next, we acquire and release local references.  No atomic operations are
+// performed, and the single shared reference held by the local references is
+// unaffected:
+//..
+//  rep->acquireLocalRef();
+//  rep->acquireLocalRef();
+//  assert(3 == rep->numLocalReferences());
+//  assert(1 == rep->numReferences());
+//
+//  rep->releaseLocalRef();
+//  rep->releaseLocalRef();
+//  assert(1 == rep->numLocalReferences());
+//..
+// Now, we hand a thread-safe shared reference to some other thread by
+// acquiring it from the base class:
+//..
+//  rep->acquireRef();
+//  assert(2 == rep->numReferences());
+//..
+// Finally, we release the last local reference, and then the (possibly
+// remote) shared reference, which disposes of the representation:
+//..
+//  rep->releaseLocalRef();
+//  assert(1 == rep->numReferences());
+//  assert(1 == ta.numBlocksInUse());
+//
+//  rep->releaseRef();
+//  assert(0 == ta.numBlocksInUse());
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_SHAREDPTRREP
+#include <bslma_sharedptrrep.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+namespace BloombergLP {
+namespace bslma {
+
+                        // =======================
+                        // class LocalSharedPtrRep
+                        // =======================
+
+class LocalSharedPtrRep : public SharedPtrRep {
+    // This class provides a partially implemented single-threaded shared
+    // pointer representation ("letter") protocol.  In addition to the (atomic)
+    // shared and weak reference counts provided by 'SharedPtrRep', this class
+    // maintains a plain (non-atomic) count of local references.  All local
+    // references collectively hold a single shared reference of the base
+    // class, which is released when the last local reference is released.
+
+    // DATA
+    int d_numLocalReferences;  // number of local references; all local
+                               // references share one base-class shared
+                               // reference
+
+  protected:
+    // PROTECTED CREATORS
+    ~LocalSharedPtrRep();
+        // Destroy this representation object.
+
+  public:
+    // CREATORS
+    LocalSharedPtrRep();
+        // Create a 'LocalSharedPtrRep' object having one local reference, one
+        // shared reference (held on behalf of the local references), and no
+        // weak references.
+
+    // MANIPULATORS
+    void acquireLocalRef();
+        // Acquire a local reference to the shared object referred to by this
+        // representation.  The behavior is undefined unless
+        // '0 < numLocalReferences()'.  Note that this operation is *not*
+        // atomic.
+
+    void releaseLocalRef();
+        // Release a local reference to the shared object referred to by this
+        // representation, and, if this was the last local reference, release
+        // the shared reference held on behalf of the local references (see
+        // 'releaseRef').  The behavior is undefined unless
+        // '0 < numLocalReferences()'.  Note that this operation is *not*
+        // atomic, except that releasing the last local reference performs a
+        // single atomic decrement of the shared reference count.
+
+    // ACCESSORS
+    bool hasUniqueLocalOwner() const;
+        // Return 'true' if there is only one local reference, no other shared
+        // references, and no weak references to the object referred to by
+        // this representation, and 'false' otherwise.
+
+    int numLocalReferences() const;
+        // Return the current number of local references to the shared object
+        // referred to by this representation object.
+};
+
+// ============================================================================
+//              INLINE FUNCTION AND FUNCTION TEMPLATE DEFINITIONS
+// ============================================================================
+
+                        // -----------------------
+                        // class LocalSharedPtrRep
+                        // -----------------------
+
+// PROTECTED CREATORS
+inline
+LocalSharedPtrRep::~LocalSharedPtrRep()
+{
+}
+
+// CREATORS
+inline
+LocalSharedPtrRep::LocalSharedPtrRep()
+: SharedPtrRep()
+, d_numLocalReferences(1)
+{
+}
+
+// MANIPULATORS
+inline
+void LocalSharedPtrRep::acquireLocalRef()
+{
+    BSLS_ASSERT_SAFE(0 < d_numLocalReferences);
+
+    ++d_numLocalReferences;
+}
+
+inline
+void LocalSharedPtrRep::releaseLocalRef()
+{
+    BSLS_ASSERT_SAFE(0 < d_numLocalReferences);
+
+    if (0 == --d_numLocalReferences) {
+        releaseRef();
+    }
+}
+
+// ACCESSORS
+inline
+bool LocalSharedPtrRep::hasUniqueLocalOwner() const
+{
+    return 1 == d_numLocalReferences && hasUniqueOwner();
+}
+
+inline
+int LocalSharedPtrRep::numLocalReferences() const
+{
+    return d_numLocalReferences;
+}
+
+}  // close namespace bslma
+}  // close namespace BloombergLP
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
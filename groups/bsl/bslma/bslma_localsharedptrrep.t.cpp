@@ -0,0 +1,626 @@
+// bslma_localsharedptrrep.t.cpp                                      -*-C++-*-
+#include <bslma_localsharedptrrep.h>
+
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+#include <bsls_asserttest.h>
+#include <bsls_bsltestutil.h>
+
+#include <stdio.h>
+#include <stdlib.h>             // 'atoi'
+
+#ifdef BSLS_PLATFORM_CMP_MSVC  // Microsoft Compiler
+#ifdef _MSC_EXTENSIONS         // Microsoft Extensions Enabled
+#include <new>                 // if so, need to include new as well
+#endif
+#endif
+
+using namespace BloombergLP;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// 'bslma::LocalSharedPtrRep' is a partially implemented protocol that adds a
+// non-atomic local reference count to 'bslma::SharedPtrRep'.  We test it via a
+// concrete test implementation that records calls to 'disposeObject' and
+// 'disposeRep', verifying that local references collectively hold exactly one
+// shared reference of the base class, and that the shared object is disposed
+// of only when both the last local reference and the last (non-local) shared
+// reference have been released.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] LocalSharedPtrRep();
+//
+// MANIPULATORS
+// [ 3] void acquireLocalRef();
+// [ 3] void releaseLocalRef();
+//
+// ACCESSORS
+// [ 4] bool hasUniqueLocalOwner() const;
+// [ 2] int numLocalReferences() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] MIXING LOCAL AND SHARED REFERENCES
+// [ 6] USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACROS
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                     STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+#define ASSERT_SAFE_PASS_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS_RAW(EXPR)
+#define ASSERT_SAFE_FAIL_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL_RAW(EXPR)
+#define ASSERT_PASS_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS_RAW(EXPR)
+#define ASSERT_FAIL_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL_RAW(EXPR)
+#define ASSERT_OPT_PASS_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS_RAW(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+// TEST IMPLEMENTATION (defined below)
+class MyTestImplementation;
+
+// TYPEDEFS
+typedef bslma::LocalSharedPtrRep Obj;
+typedef MyTestImplementation     TObj;
+
+//=============================================================================
+//             GLOBAL HELPER CLASSES AND FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+                         // ==========================
+                         // class MyTestImplementation
+                         // ==========================
+
+class MyTestImplementation : public bslma::LocalSharedPtrRep {
+    // This class provides an implementation for 'bslma::LocalSharedPtrRep'
+    // so that it can be initialized and tested.
+
+    // DATA
+    int d_numRepDisposed;
+    int d_numObjectDisposed;
+
+  public:
+    // CREATORS
+    MyTestImplementation();
+
+    // MANIPULATORS
+    virtual void disposeObject();
+    virtual void disposeRep();
+    virtual void *getDeleter(const std::type_info& type);
+
+    // ACCESSORS
+    int numObjectDisposed() const;
+    int numRepDisposed() const;
+    virtual void *originalPtr() const;
+};
+
+                         // --------------------------
+                         // class MyTestImplementation
+                         // --------------------------
+
+// CREATORS
+MyTestImplementation::MyTestImplementation()
+: d_numRepDisposed(0)
+, d_numObjectDisposed(0)
+{
+}
+
+// MANIPULATORS
+void MyTestImplementation::disposeObject()
+{
+    ++d_numObjectDisposed;
+}
+
+void MyTestImplementation::disposeRep()
+{
+    ++d_numRepDisposed;
+}
+
+void *MyTestImplementation::getDeleter(const std::type_info& /*type*/)
+{
+    return 0;
+}
+
+// ACCESSORS
+int MyTestImplementation::numObjectDisposed() const
+{
+    return d_numObjectDisposed;
+}
+
+int MyTestImplementation::numRepDisposed() const
+{
+    return d_numRepDisposed;
+}
+
+void *MyTestImplementation::originalPtr() const
+{
+    return 0;
+}
+
+//=============================================================================
+//                               USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Implementing a Local Representation
+/// - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we want to share an 'int' that is owned by a single thread.  First,
+// we define a concrete representation that stores the 'int' in-place and
+// returns its footprint to an allocator when disposed:
+//..
+    class MyLocalIntRep : public bslma::LocalSharedPtrRep {
+        // This class provides a concrete single-threaded shared pointer
+        // representation for an in-place 'int'.
+
+        // DATA
+        bslma::Allocator *d_allocator_p;  // memory allocator (held, not owned)
+        int               d_value;        // in-place object
+
+      public:
+        // CREATORS
+        MyLocalIntRep(int value, bslma::Allocator *basicAllocator)
+        : d_allocator_p(basicAllocator)
+        , d_value(value)
+        {
+        }
+
+        // MANIPULATORS
+        virtual void disposeObject()
+        {
+        }
+
+        virtual void disposeRep()
+        {
+            d_allocator_p->deallocate(this);
+        }
+
+        virtual void *getDeleter(const std::type_info&)
+        {
+            return 0;
+        }
+
+        int *ptr()
+        {
+            return &d_value;
+        }
+
+        // ACCESSORS
+        virtual void *originalPtr() const
+        {
+            return const_cast<int *>(&d_value);
+        }
+    };
+//..
+
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+    bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVerbose;
+    (void)veryVeryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    // Confirm no static intialization locked the global allocator
+    ASSERT(&globalAllocator == bslma::Default::globalAllocator());
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    // Confirm no static intialization locked the default allocator
+    ASSERT(&defaultAllocator == bslma::Default::defaultAllocator());
+
+    bslma::TestAllocator ta;
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Then, we create a representation, which has one local reference:
+//..
+    MyLocalIntRep *rep = new (ta) MyLocalIntRep(42, &ta);
+
+    ASSERT(1 == rep->numLocalReferences());
+    ASSERT(1 == rep->numReferences());
+//..
+// Next, we acquire and release local references.  No atomic operations are
+// performed, and the single shared reference held by the local references is
+// unaffected:
+//..
+    rep->acquireLocalRef();
+    rep->acquireLocalRef();
+    ASSERT(3 == rep->numLocalReferences());
+    ASSERT(1 == rep->numReferences());
+
+    rep->releaseLocalRef();
+    rep->releaseLocalRef();
+    ASSERT(1 == rep->numLocalReferences());
+//..
+// Now, we hand a thread-safe shared reference to some other thread by
+// acquiring it from the base class:
+//..
+    rep->acquireRef();
+    ASSERT(2 == rep->numReferences());
+//..
+// Finally, we release the last local reference, and then the (possibly
+// remote) shared reference, which disposes of the representation:
+//..
+    rep->releaseLocalRef();
+    ASSERT(1 == rep->numReferences());
+    ASSERT(1 == ta.numBlocksInUse());
+
+    rep->releaseRef();
+    ASSERT(0 == ta.numBlocksInUse());
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // MIXING LOCAL AND SHARED REFERENCES
+        //
+        // Concerns:
+        //: 1 The shared object is not disposed of while either a local or a
+        //:   non-local shared reference remains.
+        //:
+        //: 2 The object and representation are disposed of exactly once,
+        //:   whether the last local or the last non-local reference is
+        //:   released last.
+        //:
+        //: 3 A weak reference keeps the representation, but not the object,
+        //:   alive.
+        //
+        // Plan:
+        //: 1 Create test implementations, acquire local, shared, and weak
+        //:   references, and release them in each order, checking the
+        //:   disposal counts after each step.  (C-1..3)
+        //
+        // Testing:
+        //   MIXING LOCAL AND SHARED REFERENCES
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nMIXING LOCAL AND SHARED REFERENCES"
+                            "\n==================================\n");
+
+        if (verbose) printf("\nLocal reference released last.\n");
+        {
+            TObj t;
+            Obj& x = t;
+
+            x.acquireRef();
+            ASSERT(2 == x.numReferences());
+
+            x.releaseRef();
+            ASSERT(1 == x.numReferences());
+            ASSERT(0 == t.numObjectDisposed());
+
+            x.releaseLocalRef();
+            ASSERT(0 == x.numReferences());
+            ASSERT(1 == t.numObjectDisposed());
+            ASSERT(1 == t.numRepDisposed());
+        }
+
+        if (verbose) printf("\nShared reference released last.\n");
+        {
+            TObj t;
+            Obj& x = t;
+
+            x.acquireLocalRef();
+            x.acquireRef();
+
+            x.releaseLocalRef();
+            x.releaseLocalRef();
+            ASSERT(0 == x.numLocalReferences());
+            ASSERT(1 == x.numReferences());
+            ASSERT(0 == t.numObjectDisposed());
+
+            x.releaseRef();
+            ASSERT(1 == t.numObjectDisposed());
+            ASSERT(1 == t.numRepDisposed());
+        }
+
+        if (verbose) printf("\nWeak reference released last.\n");
+        {
+            TObj t;
+            Obj& x = t;
+
+            x.acquireWeakRef();
+            x.releaseLocalRef();
+            ASSERT(1 == t.numObjectDisposed());
+            ASSERT(0 == t.numRepDisposed());
+
+            x.releaseWeakRef();
+            ASSERT(1 == t.numObjectDisposed());
+            ASSERT(1 == t.numRepDisposed());
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'hasUniqueLocalOwner'
+        //
+        // Concerns:
+        //: 1 'hasUniqueLocalOwner' returns 'true' only when there is exactly
+        //:   one local reference and no other shared or weak reference.
+        //
+        // Plan:
+        //: 1 Acquire and release local, shared, and weak references, checking
+        //:   'hasUniqueLocalOwner' after each step.  (C-1)
+        //
+        // Testing:
+        //   bool hasUniqueLocalOwner() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'hasUniqueLocalOwner'"
+                            "\n=============================\n");
+
+        TObj t;
+        Obj& x = t; const Obj& X = x;
+
+        ASSERT(true  == X.hasUniqueLocalOwner());
+
+        x.acquireLocalRef();
+        ASSERT(false == X.hasUniqueLocalOwner());
+
+        x.releaseLocalRef();
+        ASSERT(true  == X.hasUniqueLocalOwner());
+
+        x.acquireRef();
+        ASSERT(false == X.hasUniqueLocalOwner());
+
+        x.releaseRef();
+        ASSERT(true  == X.hasUniqueLocalOwner());
+
+        x.acquireWeakRef();
+        ASSERT(false == X.hasUniqueLocalOwner());
+
+        x.releaseWeakRef();
+        ASSERT(true  == X.hasUniqueLocalOwner());
+
+        x.releaseLocalRef();
+        ASSERT(1 == t.numRepDisposed());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'acquireLocalRef' AND 'releaseLocalRef'
+        //
+        // Concerns:
+        //: 1 'acquireLocalRef' and 'releaseLocalRef' adjust the local count
+        //:   and leave the (atomic) shared reference count unchanged, until
+        //:   the last local reference is released.
+        //:
+        //: 2 Releasing the last local reference releases the shared reference
+        //:   held on behalf of the local references, disposing of the object
+        //:   and representation.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Acquire and release a number of local references, verifying the
+        //:   counts after each operation.  (C-1..2)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered on a representation having no local references (using
+        //:   the 'BSLS_ASSERTTEST_*' macros).  (C-3)
+        //
+        // Testing:
+        //   void acquireLocalRef();
+        //   void releaseLocalRef();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf(
+                        "\nTESTING 'acquireLocalRef' AND 'releaseLocalRef'"
+                        "\n===============================================\n");
+
+        const int NUM_REFS = 10;
+
+        TObj t;
+        Obj& x = t; const Obj& X = x;
+
+        for (int i = 1; i < NUM_REFS; ++i) {
+            x.acquireLocalRef();
+            LOOP_ASSERT(i, i + 1 == X.numLocalReferences());
+            LOOP_ASSERT(i, 1     == X.numReferences());
+        }
+
+        for (int i = NUM_REFS - 1; i > 0; --i) {
+            x.releaseLocalRef();
+            LOOP_ASSERT(i, i == X.numLocalReferences());
+            LOOP_ASSERT(i, 1 == X.numReferences());
+            LOOP_ASSERT(i, 0 == t.numObjectDisposed());
+        }
+
+        x.releaseLocalRef();
+        ASSERT(0 == X.numLocalReferences());
+        ASSERT(0 == X.numReferences());
+        ASSERT(1 == t.numObjectDisposed());
+        ASSERT(1 == t.numRepDisposed());
+
+        if (verbose) printf("\nNegative Testing.\n");
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_SAFE_FAIL(x.acquireLocalRef());
+            ASSERT_SAFE_FAIL(x.releaseLocalRef());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CONSTRUCTOR
+        //
+        // Concerns:
+        //: 1 A newly constructed representation has one local reference, one
+        //:   shared reference, and no weak references.
+        //
+        // Plan:
+        //: 1 Construct a test implementation and verify its counts.  (C-1)
+        //
+        // Testing:
+        //   LocalSharedPtrRep();
+        //   int numLocalReferences() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING CONSTRUCTOR"
+                            "\n===================\n");
+
+        TObj t;
+        const Obj& X = t;
+
+        ASSERT(1 == X.numLocalReferences());
+        ASSERT(1 == X.numReferences());
+        ASSERT(0 == X.numWeakReferences());
+        ASSERT(0 == t.numObjectDisposed());
+        ASSERT(0 == t.numRepDisposed());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Acquire and release local references on a test implementation,
+        //:   verifying the counts and the disposal of the object.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        TObj t;
+        Obj& x = t; const Obj& X = x;
+
+        ASSERT(1 == X.numLocalReferences());
+
+        x.acquireLocalRef();
+        ASSERT(2 == X.numLocalReferences());
+        ASSERT(1 == X.numReferences());
+
+        x.releaseLocalRef();
+        ASSERT(1 == X.numLocalReferences());
+        ASSERT(0 == t.numObjectDisposed());
+
+        x.releaseLocalRef();
+        ASSERT(1 == t.numObjectDisposed());
+        ASSERT(1 == t.numRepDisposed());
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
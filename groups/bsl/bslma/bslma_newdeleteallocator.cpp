@@ -4,12 +4,21 @@
 #include <bsls_ident.h>
 BSLS_IDENT("$Id$ $CSID$")
 
+#include <bsls_alignmentutil.h>
 #include <bsls_assert.h>
 #include <bsls_atomicoperations.h>
+#include <bsls_bslexceptionutil.h>
 #include <bsls_objectbuffer.h>
+#include <bsls_platform.h>
 
 #include <new>
 
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <malloc.h>  // '_aligned_malloc', '_aligned_free'
+#else
+#include <stdlib.h>  // 'posix_memalign', 'free'
+#endif
+
 namespace BloombergLP {
 
 typedef bsls::ObjectBuffer<bslma::NewDeleteAllocator>
@@ -100,6 +109,51 @@ void *NewDeleteAllocator::allocate(size_type size)
     return 0 == size ? 0 : ::operator new(size);
 }
 
+void *NewDeleteAllocator::allocateAligned(size_type size, size_type alignment)
+{
+    BSLS_ASSERT(0 < alignment);
+    BSLS_ASSERT(0 == (alignment & (alignment - 1)));
+
+    const size_type maxAlignment = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+    if (alignment <= maxAlignment || 0 == size) {
+        return allocate(size);                                        // RETURN
+    }
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    void *address = _aligned_malloc(size, alignment);
+#else
+    void *address = 0;
+    if (0 != posix_memalign(&address, alignment, size)) {
+        address = 0;
+    }
+#endif
+
+    if (!address) {
+        bsls::BslExceptionUtil::throwBadAlloc();
+    }
+
+    return address;
+}
+
+void NewDeleteAllocator::deallocateAligned(void      *address,
+                                           size_type  ,
+                                           size_type  alignment)
+{
+    const size_type maxAlignment = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+    if (alignment <= maxAlignment) {
+        deallocate(address);
+        return;                                                       // RETURN
+    }
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    _aligned_free(address);
+#else
+    free(address);
+#endif
+}
+
 }  // close package namespace
 
 }  // close enterprise namespace
@@ -32,6 +32,8 @@ BSLS_IDENT("$Id: $")
 //       `----------------'
 //                       allocate
 //                       deallocate
+//                       allocateAligned
+//                       deallocateAligned
 //..
 // The essential purpose of this component is to facilitate the default use of
 // global 'new' and 'delete' in all components that accept a user-supplied
@@ -46,6 +48,11 @@ BSLS_IDENT("$Id: $")
 // natural-alignment requirement imposed by the base-class contract, or than is
 // provided by many other concrete implementations.
 //
+// Requests for memory aligned beyond the maximal alignment (see
+// 'bslma::Allocator::allocateAligned') are satisfied directly by the aligned
+// allocation facility of the platform ('posix_memalign' or '_aligned_malloc'),
+// without the padding imposed by the base-class implementation.
+//
 ///Thread Safety
 ///-------------
 // This class is fully thread-safe, which means that all non-creator object
@@ -325,6 +332,26 @@ class NewDeleteAllocator : public Allocator {
         // global 'operator delete' is *not* called when 'address' is 0 (in
         // order to avoid having to acquire a lock, and potential contention in
         // multi-threaded programs).
+
+    virtual void *allocateAligned(size_type size, size_type alignment);
+        // Return a newly allocated block of memory of (at least) the specified
+        // positive 'size' (in bytes), whose address is a multiple of the
+        // specified 'alignment'.  If 'size' is 0, a null pointer is returned
+        // with no other effect.  The behavior is undefined unless '0 <= size'
+        // and 'alignment' is a positive, integral power of 2.  Note that if
+        // 'alignment' does not exceed the maximal alignment, this method
+        // returns 'allocate(size)', and otherwise obtains the block from the
+        // aligned allocation facility of the platform, without padding.
+
+    virtual void deallocateAligned(void      *address,
+                                   size_type  size,
+                                   size_type  alignment);
+        // Return the memory block at the specified 'address', having the
+        // specified 'size' (in bytes) and 'alignment', back to this allocator.
+        // If 'address' is 0, this function has no effect.  The behavior is
+        // undefined unless 'address' was allocated by a call to
+        // 'allocateAligned' on this allocator object supplying the same 'size'
+        // and 'alignment', and has not already been deallocated.
 };
 
 // ============================================================================
@@ -4,8 +4,10 @@
 
 #include <bslma_allocator.h>    // for testing only
 
+#include <bsls_alignmentutil.h>
 #include <bsls_bsltestutil.h>
 #include <bsls_platform.h>
+#include <bsls_types.h>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -89,11 +91,13 @@ static void aSsErT(bool b, const char *s, int i) {
 // [ 1] ~bslma::NewDeleteAllocator();
 // [ 1] void *allocate(int size);
 // [ 1] void deallocate(void *address);
+// [ 3] void *allocateAligned(size_type size, size_type alignment);
+// [ 3] void deallocateAligned(void *, size_type, size_type);
 //--------------------------------------------------------------------------
 // [ 1] Make sure that global operators new and delete are called.
 // [ 2] Make sure that the lifetime of the singleton is sufficient.
 // [ 2] Make sure that memory is not leaked.
-// [ 3] USAGE EXAMPLE
+// [ 4] USAGE EXAMPLE
 //==========================================================================
 
 //=============================================================================
@@ -354,7 +358,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:
-      case 3: {
+      case 4: {
         // -----------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -385,6 +389,75 @@ int main(int argc, char *argv[])
         // a call to operator 'new' (as specified by the component level doc).
         ASSERT(0 == globalNewCalledCount);
 
+      } break;
+      case 3: {
+        // -----------------------------------------------------------------
+        // OVER-ALIGNED ALLOCATION TEST:
+        //   We need to make sure that 'allocateAligned' returns memory having
+        //   the requested alignment, that requests not exceeding the maximal
+        //   alignment are forwarded to 'allocate' (and hence to global
+        //   'operator new'), and that stricter requests bypass global
+        //   'operator new' (and are returned without calling global
+        //   'operator delete').
+        //
+        // Testing:
+        //   void *allocateAligned(size_type size, size_type alignment);
+        //   void deallocateAligned(void *, size_type, size_type);
+        // -----------------------------------------------------------------
+
+        if (verbose) printf("\nOVER-ALIGNED ALLOCATION TEST"
+                            "\n============================\n");
+
+        typedef bslma::Allocator::size_type size_type;
+
+        const size_type MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+        const size_type ALIGNS[] = { 1, 8, MAX_ALIGN, 32, 64, 4096 };
+        const int       NUM_ALIGNS = sizeof ALIGNS / sizeof *ALIGNS;
+
+        bslma::NewDeleteAllocator a;
+
+        for (int i = 0; i < NUM_ALIGNS; ++i) {
+            const size_type ALIGN = ALIGNS[i];
+            const size_type SIZE  = 100;
+
+            globalNewCalledCount    = 0;
+            globalDeleteCalledCount = 0;
+
+            globalNewCalledCountIsEnabled    = 1;
+            globalDeleteCalledCountIsEnabled = 1;
+
+            char *p = static_cast<char *>(a.allocateAligned(SIZE, ALIGN));
+            memset(p, 0xa5, SIZE);
+            a.deallocateAligned(p, SIZE, ALIGN);
+
+            globalNewCalledCountIsEnabled    = 0;
+            globalDeleteCalledCountIsEnabled = 0;
+
+            ASSERTV(ALIGN, 0 == reinterpret_cast<bsls::Types::UintPtr>(p)
+                                                                     % ALIGN);
+
+            const int EXP = ALIGN <= MAX_ALIGN ? 1 : 0;
+            ASSERTV(ALIGN, EXP == globalNewCalledCount);
+            ASSERTV(ALIGN, EXP == globalDeleteCalledCount);
+        }
+
+        globalNewCalledCount    = 0;
+        globalDeleteCalledCount = 0;
+
+        globalNewCalledCountIsEnabled    = 1;
+        globalDeleteCalledCountIsEnabled = 1;
+
+        ASSERT(0 == a.allocateAligned(0, 64));
+        a.deallocateAligned(0, 0, 64);
+        a.deallocateAligned(0, 0, 8);
+
+        globalNewCalledCountIsEnabled    = 0;
+        globalDeleteCalledCountIsEnabled = 0;
+
+        ASSERT(0 == globalNewCalledCount);
+        ASSERT(0 == globalDeleteCalledCount);
+
       } break;
       case 2: {
         // -----------------------------------------------------------------
@@ -71,6 +71,8 @@ struct Header {
 
     unsigned int  d_magicNumber;  // allocated/deallocated/other identifier
 
+    bool          d_isSized;      // 'true' if allocated by 'allocateSized'
+
     size_type     d_bytes;        // number of available bytes in this block
 
     bsls::Types::Int64
@@ -168,6 +170,12 @@ void formatInvalidMemoryBlock(Align                *address,
         std::printf("*** Freeing segment at %p from wrong allocator. ***\n",
                     static_cast<void *>(payload));
     }
+    else if (address->d_object.d_isSized) {
+        std::printf("*** Freeing " ZU " byte segment at %p obtained from"
+                    " 'allocateSized' using 'deallocate'. ***\n",
+                    numBytes,
+                    static_cast<void *>(payload));
+    }
     else if (underrunBy) {
         std::printf("*** Memory corrupted at %d bytes before " ZU " byte"
                     " segment at %p. ***\n",
@@ -515,6 +523,7 @@ void *TestAllocator::allocate(size_type size)
 
     align->d_object.d_bytes       = size;
     align->d_object.d_magicNumber = ALLOCATED_MEMORY;
+    align->d_object.d_isSized     = false;
     align->d_object.d_index       = allocationIndex;
 
     d_numBlocksInUse.addRelaxed(1);
@@ -593,7 +602,9 @@ void TestAllocator::deallocate(void *address)
     if (ALLOCATED_MEMORY != align->d_object.d_magicNumber) {
         miscError = true;
     }
-    else if (0 >= align->d_object.d_bytes || this != align->d_object.d_id_p) {
+    else if (0 >= align->d_object.d_bytes
+          || this != align->d_object.d_id_p
+          || align->d_object.d_isSized) {
         miscError = true;
     }
     else {
@@ -711,6 +722,69 @@ void TestAllocator::deallocate(void *address)
     d_allocator_p->deallocate(align);
 }
 
+void *TestAllocator::allocateSized(size_type size)
+{
+    void *address = allocate(size);
+
+    if (address) {
+        Align *align = static_cast<Align *>(address) - 1;
+        align->d_object.d_isSized = true;
+    }
+
+    return address;
+}
+
+void TestAllocator::deallocateSized(void *address, size_type size)
+{
+    if (0 == address) {
+        deallocate(address);
+        return;                                                       // RETURN
+    }
+
+    Align *align = static_cast<Align *>(address) - 1;
+
+    // Validate the supplied 'size' only if the block otherwise appears to have
+    // been allocated by this object; all other errors are diagnosed (in the
+    // usual manner) by 'deallocate'.  The header is examined in the same order
+    // as in 'deallocate' (see comment there).
+
+    if (ALLOCATED_MEMORY != align->d_object.d_magicNumber
+     || this != align->d_object.d_id_p
+     || (align->d_object.d_isSized && size == align->d_object.d_bytes)) {
+        align->d_object.d_isSized = false;
+        deallocate(address);
+        return;                                                       // RETURN
+    }
+
+    d_numDeallocations.addRelaxed(1);
+    d_lastDeallocatedAddress_p.storeRelaxed(reinterpret_cast<int *>(address));
+    d_numMismatches.addRelaxed(1);
+
+    if (isQuiet()) {
+        return;                                                       // RETURN
+    }
+
+    if (align->d_object.d_isSized) {
+        std::printf("*** Freeing " ZU " byte segment at %p using"
+                    " 'deallocateSized' with mismatched size " ZU ". ***\n",
+                    align->d_object.d_bytes,
+                    address,
+                    size);
+    }
+    else {
+        std::printf("*** Freeing " ZU " byte segment at %p obtained from"
+                    " 'allocate' using 'deallocateSized'. ***\n",
+                    align->d_object.d_bytes,
+                    address);
+    }
+    std::printf("Header:\n");
+    formatBlock(align, sizeof *align);
+
+    if (!isNoAbort()) {
+        std::abort();                                                 // ABORT
+    }
+}
+
 // ACCESSORS
 void TestAllocator::print() const
 {
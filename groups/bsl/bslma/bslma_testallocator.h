@@ -502,6 +502,27 @@ class TestAllocator : public Allocator {
         // details of the mismatch to 'stdout' (e.g., as an 'std::hex' memory
         // dump) and abort.
 
+    void *allocateSized(size_type size);
+        // Return a newly-allocated block of memory of the specified 'size' (in
+        // bytes), recording that the block must be returned using
+        // 'deallocateSized'.  If 'size' is 0, a null pointer is returned.
+        // Otherwise, the behavior (including the effect on all statistics) is
+        // identical to that of 'allocate'.
+
+    void deallocateSized(void *address, size_type size);
+        // Return the memory block at the specified 'address', having the
+        // specified 'size' (in bytes), back to this allocator.  If 'address'
+        // is 0, this function has no effect (other than to record relevant
+        // statistics).  Otherwise, if the memory at 'address' is consistent
+        // with being allocated by 'allocateSized' from this test allocator
+        // with the same 'size', proceed as for 'deallocate'.  Although
+        // technically undefined behavior, if the block was obtained from
+        // 'allocate', or was allocated with a different size, increment the
+        // number of mismatches, and -- unless in quiet mode -- immediately
+        // report the details of the mismatch to 'stdout' and abort.  Note
+        // that a block obtained from 'allocateSized' and returned using
+        // 'deallocate' is likewise reported as a mismatch.
+
     void setAllocationLimit(bsls::Types::Int64 limit);
         // Set the number of valid allocation requests before an exception is
         // to be thrown for this allocator to the specified 'limit'.  If
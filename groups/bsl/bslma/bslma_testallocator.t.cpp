@@ -59,6 +59,8 @@ using namespace std;
 // [ 2] ~bslma::TestAllocator();
 // [ 3] void *allocate(size_type size);
 // [ 3] void deallocate(void *address);
+// [14] void *allocateSized(size_type size);
+// [14] void deallocateSized(void *address, size_type size);
 // [ 2] void setAllocationLimit(Int64 limit);
 // [ 2] void setNoAbort(bool flagValue);
 // [ 2] void setQuiet(bool flagValue);
@@ -85,7 +87,7 @@ using namespace std;
 // [12] void print() const;
 // [ 2] int status() const;
 //-----------------------------------------------------------------------------
-// [14] USAGE TEST
+// [15] USAGE TEST
 // [ 5] Ensure that exception is thrown after allocation limit is exceeded.
 // [ 1] Make sure that all counts are initialized to zero (placement new).
 // [ 1] Make sure that global operators new and delete are *not* called.
@@ -102,6 +104,7 @@ using namespace std;
 // [10] Test 'numBlocksInUse', 'numBlocksTotal'
 // [11] Ensure that over and underruns are properly caught.
 // [13] Ensure that 'allocate' and 'deallocate' are thread-safe.
+// [14] Ensure that mismatched sized deallocations are detected/reported.
 
 //=============================================================================
 //                    STANDARD BDE ASSERT TEST MACRO
@@ -571,7 +574,7 @@ int main(int argc, char *argv[])
     bslma::TestAllocator testAllocator(veryVeryVeryVerbose);
 
     switch (test) { case 0:
-      case 14: {
+      case 15: {
         // --------------------------------------------------------------------
         // TEST USAGE
         //   Verify that the usage example for testing exception neutrality is
@@ -688,6 +691,107 @@ int main(int argc, char *argv[])
 // indicate whether or not exceptions are enabled.
 
       } break;
+      case 14: {
+        // --------------------------------------------------------------------
+        // TEST SIZED ALLOCATION AND DEALLOCATION
+        //   Blocks obtained from 'allocateSized' must be returned using
+        //   'deallocateSized' with the same size, and blocks obtained from
+        //   'allocate' must be returned using 'deallocate'.
+        //
+        // Concerns:
+        //: 1 'allocateSized' and 'deallocateSized' update all statistics
+        //:   exactly as 'allocate' and 'deallocate' do.
+        //:
+        //: 2 'deallocateSized' with a null address has no effect other than
+        //:   to record the deallocation.
+        //:
+        //: 3 Returning a block from 'allocateSized' with a different size, or
+        //:   using 'deallocate', is detected as a mismatch.
+        //:
+        //: 4 Returning a block from 'allocate' using 'deallocateSized' is
+        //:   detected as a mismatch.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate blocks using the sized methods and
+        //:   verify the statistics.  (C-1..2)
+        //:
+        //: 2 In quiet mode, deliberately mismatch the allocation and
+        //:   deallocation methods, and the sizes, verifying that the blocks
+        //:   remain in use and that 'numMismatches' is incremented.  Then
+        //:   return each block correctly.  (C-3..4)
+        //
+        // Testing:
+        //   void *allocateSized(size_type size);
+        //   void deallocateSized(void *address, size_type size);
+        //   Ensure that mismatched sized deallocations are detected/reported.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TEST SIZED ALLOCATION AND DEALLOCATION" << endl
+                          << "======================================" << endl;
+
+        if (verbose) cout << "\nTesting matched sized requests." << endl;
+        {
+            Obj mX(veryVeryVerbose);  const Obj& X = mX;
+
+            ASSERT(0 == mX.allocateSized(0));
+            ASSERT(1 == X.numAllocations());
+            ASSERT(0 == X.numBlocksInUse());
+
+            void *p = mX.allocateSized(24);
+            ASSERT(p);
+            ASSERT(p  == X.lastAllocatedAddress());
+            ASSERT(24 == X.lastAllocatedNumBytes());
+            ASSERT(1  == X.numBlocksInUse());
+            ASSERT(24 == X.numBytesInUse());
+
+            mX.deallocateSized(p, 24);
+            ASSERT(p  == X.lastDeallocatedAddress());
+            ASSERT(24 == X.lastDeallocatedNumBytes());
+            ASSERT(0  == X.numBlocksInUse());
+            ASSERT(0  == X.numBytesInUse());
+            ASSERT(1  == X.numDeallocations());
+
+            mX.deallocateSized(0, 24);
+            ASSERT(2 == X.numDeallocations());
+            ASSERT(0 == X.numMismatches());
+            ASSERT(0 == X.status());
+        }
+
+        if (verbose) cout << "\nTesting mismatched requests." << endl;
+        {
+            Obj mX(veryVeryVerbose);  const Obj& X = mX;
+            mX.setNoAbort(verbose);
+            mX.setQuiet(!veryVerbose);
+
+            void *p = mX.allocateSized(24);
+            void *q = mX.allocate(24);
+            ASSERT(2 == X.numBlocksInUse());
+
+            if (verbose) cout << "\tSized block, wrong size." << endl;
+            mX.deallocateSized(p, 16);
+            ASSERT(1 == X.numMismatches());
+            ASSERT(2 == X.numBlocksInUse());
+
+            if (verbose) cout << "\tSized block, unsized deallocation."
+                              << endl;
+            mX.deallocate(p);
+            ASSERT(2 == X.numMismatches());
+            ASSERT(2 == X.numBlocksInUse());
+
+            if (verbose) cout << "\tUnsized block, sized deallocation."
+                              << endl;
+            mX.deallocateSized(q, 24);
+            ASSERT(3 == X.numMismatches());
+            ASSERT(2 == X.numBlocksInUse());
+
+            mX.deallocateSized(p, 24);
+            mX.deallocate(q);
+            ASSERT(3 == X.numMismatches());
+            ASSERT(0 == X.numBlocksInUse());
+            ASSERT(0 == X.numBytesInUse());
+        }
+      } break;
       case 13: {
         // --------------------------------------------------------------------
         // CONCURRENCY
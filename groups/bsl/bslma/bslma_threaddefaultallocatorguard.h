@@ -0,0 +1,186 @@
+// bslma_threaddefaultallocatorguard.h                                -*-C++-*-
+#ifndef INCLUDED_BSLMA_THREADDEFAULTALLOCATORGUARD
+#define INCLUDED_BSLMA_THREADDEFAULTALLOCATORGUARD
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide scoped guard to install a thread default allocator.
+//
+//@CLASSES:
+//  bslma::ThreadDefaultAllocatorGuard: thread-default-allocator scoped guard
+//
+//@SEE_ALSO: bslma_default, bslma_defaultallocatorguard
+//
+//@DESCRIPTION: This component provides an object,
+// 'bslma::ThreadDefaultAllocatorGuard', that serves as a "scoped guard" to
+// install an allocator as the *thread* *default* *allocator* of the calling
+// thread (see the "Thread Default Allocator" section of 'bslma_default').
+// While the guard is in scope, 'bslma::Default::defaultAllocator' returns the
+// guarded allocator when called from the thread that created the guard, so
+// that every object created by that thread without an explicitly supplied
+// allocator obtains its memory from the guarded allocator.  Other threads are
+// not affected.  Upon destruction, the guard restores the thread default
+// allocator that was installed when the guard was created (if any).
+//
+// Unlike 'bslma::DefaultAllocatorGuard', which replaces the process-wide
+// default allocator and is intended for testing only, this guard may be used
+// in production code, at any time, by any thread.  The guarded allocator must,
+// however, outlive every object created while the guard is in scope: an
+// object retains the allocator it was created with, and will use it for
+// deallocation when it is destroyed, after the guard has gone out of scope.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Routing the Temporaries of a Task to a Local Allocator
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a worker thread executes tasks calling legacy code that does
+// not accept an allocator, and allocates many short-lived temporaries from the
+// default allocator.  We would like these temporaries to be supplied by an
+// allocator local to the task, without contention with other threads, and
+// without changing the legacy code.
+//
+// First, we define the legacy function, which allocates a temporary buffer
+// from the default allocator:
+//..
+//  int legacyChecksum(const char *data, int length)
+//      // Return a checksum of the specified 'length' bytes of 'data'.
+//  {
+//      bslma::Allocator *allocator = bslma::Default::defaultAllocator();
+//
+//      char *copy = static_cast<char *>(allocator->allocate(length));
+//      memcpy(copy, data, length);
+//
+//      int result = 0;
+//      for (int i = 0; i < length; ++i) {
+//          result = result * 31 + copy[i];
+//      }
+//
+//      allocator->deallocate(copy);
+//      return result;
+//  }
+//..
+// Then, in the code executing a task, we create an allocator local to the
+// task (here a test allocator, standing in for an arena such as a
+// 'bdlma::SequentialAllocator'), and install it as the thread default
+// allocator for the duration of the task:
+//..
+//  bslma::TestAllocator taskAllocator;
+//  {
+//      bslma::ThreadDefaultAllocatorGuard guard(&taskAllocator);
+//      assert(&taskAllocator == bslma::Default::defaultAllocator());
+//..
+// Next, we call the legacy code, whose temporaries are now supplied by the
+// task allocator:
+//..
+//      int checksum = legacyChecksum("hello", 5);
+//      (void)checksum;
+//
+//      assert(1 == taskAllocator.numBlocksTotal());
+//  }
+//..
+// Finally, we observe that, once the guard is destroyed, the default allocator
+// of the thread is again the process-wide default allocator:
+//..
+//  assert(bslma::Default::defaultAllocator() ==
+//                                  bslma::Default::processDefaultAllocator());
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+namespace BloombergLP {
+
+namespace bslma {
+
+class Allocator;
+
+                     // =================================
+                     // class ThreadDefaultAllocatorGuard
+                     // =================================
+
+class ThreadDefaultAllocatorGuard {
+    // Upon construction, an object of this class saves the thread default
+    // allocator of the calling thread and installs the user-specified
+    // allocator as the thread default allocator.  On destruction, the original
+    // thread default allocator is restored.  The behavior is undefined unless
+    // an object of this class is destroyed by the thread that created it, and
+    // objects of this class created by a thread are destroyed in the reverse
+    // order of their creation.
+
+    Allocator *d_original_p;  // original (to be restored at destruction), or
+                              // 0 if none was installed
+
+    // NOT IMPLEMENTED
+    ThreadDefaultAllocatorGuard(const ThreadDefaultAllocatorGuard&);
+    ThreadDefaultAllocatorGuard& operator=(
+                                           const ThreadDefaultAllocatorGuard&);
+
+  public:
+    // CREATORS
+    explicit
+    ThreadDefaultAllocatorGuard(Allocator *temporary);
+        // Create a scoped guard that installs the specified 'temporary'
+        // allocator as the thread default allocator of the calling thread, or
+        // uninstalls the thread default allocator of the calling thread if
+        // 'temporary' is 0.  The behavior is undefined unless 'temporary' is 0
+        // or outlives every object created by the calling thread while this
+        // guard exists.  Note that the thread default allocator is
+        // automatically restored to the original allocator on destruction.
+
+    ~ThreadDefaultAllocatorGuard();
+        // Restore the thread default allocator that was in place when this
+        // scoped guard was created and destroy this guard.
+};
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                     // ---------------------------------
+                     // class ThreadDefaultAllocatorGuard
+                     // ---------------------------------
+
+// CREATORS
+inline
+ThreadDefaultAllocatorGuard::ThreadDefaultAllocatorGuard(Allocator *temporary)
+: d_original_p(Default::setThreadDefaultAllocator(temporary))
+{
+}
+
+inline
+ThreadDefaultAllocatorGuard::~ThreadDefaultAllocatorGuard()
+{
+    Default::setThreadDefaultAllocator(d_original_p);
+}
+
+}  // close package namespace
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
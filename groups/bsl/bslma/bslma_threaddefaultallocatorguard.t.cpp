@@ -0,0 +1,416 @@
+// bslma_threaddefaultallocatorguard.t.cpp                            -*-C++-*-
+
+#include <bslma_threaddefaultallocatorguard.h>
+
+#include <bslma_allocator.h>               // for testing only
+#include <bslma_default.h>                 // for testing only
+#include <bslma_testallocator.h>           // for testing only
+
+#include <bsls_asserttest.h>
+#include <bsls_bsltestutil.h>
+#include <bsls_platform.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test "guards" the thread default allocator of the
+// calling thread, which is to say that an instance of this object installs a
+// new thread default allocator (from the constructor argument) on
+// construction, and restores the original thread default allocator (if any)
+// on destruction.  In addition to the single-threaded concerns, we must
+// verify that a guard has no effect on other threads.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] bslma::ThreadDefaultAllocatorGuard(bslma::Allocator *temporary);
+// [ 2] ~bslma::ThreadDefaultAllocatorGuard();
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] CONCERN: A guard has no effect on other threads.
+// [ 4] USAGE EXAMPLE
+
+//=============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(bool b, const char *s, int i) {
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+typedef bslma::ThreadDefaultAllocatorGuard Obj;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+//=============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+enum { k_NUM_THREADS = 4, k_NUM_ITERATIONS = 1000 };
+
+struct WorkerArgs {
+    // This 'struct' holds the input and results of 'workerThread'.
+
+    bslma::TestAllocator *d_allocator_p;  // allocator to guard
+    bslma::Allocator     *d_process_p;    // expected process-wide default
+    int                   d_numErrors;    // number of unexpected defaults
+};
+
+extern "C"
+void *workerThread(void *arg)
+    // Repeatedly allocate a block from the default allocator, alternately
+    // with and without a guard installing the 'd_allocator_p' member of the
+    // specified 'arg', the address of a 'WorkerArgs' object, and count the
+    // blocks not supplied by the expected allocator in its 'd_numErrors'
+    // member.
+{
+    WorkerArgs *args = static_cast<WorkerArgs *>(arg);
+
+    for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+        {
+            Obj guard(args->d_allocator_p);
+
+            if (args->d_allocator_p != bslma::Default::defaultAllocator()) {
+                ++args->d_numErrors;
+            }
+            void *p = bslma::Default::allocator()->allocate(8);
+            args->d_allocator_p->deallocate(p);
+        }
+        if (args->d_process_p != bslma::Default::defaultAllocator()) {
+            ++args->d_numErrors;
+        }
+    }
+    return 0;
+}
+
+//=============================================================================
+//                  CLASSES FOR TESTING USAGE EXAMPLES
+//-----------------------------------------------------------------------------
+
+int legacyChecksum(const char *data, int length)
+    // Return a checksum of the specified 'length' bytes of 'data'.
+{
+    bslma::Allocator *allocator = bslma::Default::defaultAllocator();
+
+    char *copy = static_cast<char *>(allocator->allocate(length));
+    memcpy(copy, data, length);
+
+    int result = 0;
+    for (int i = 0; i < length; ++i) {
+        result = result * 31 + copy[i];
+    }
+
+    allocator->deallocate(copy);
+    return result;
+}
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING USAGE EXAMPLE
+        //   The usage example provided in the component header file must
+        //   compile, link, and run on all platforms as shown.
+        //
+        // Plan:
+        //   Incorporate usage example from header into driver, remove
+        //   leading comment characters, and replace 'assert' with
+        //   'ASSERT'.
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+        bslma::TestAllocator taskAllocator(veryVeryVerbose);
+        {
+            bslma::ThreadDefaultAllocatorGuard guard(&taskAllocator);
+            ASSERT(&taskAllocator == bslma::Default::defaultAllocator());
+
+            int checksum = legacyChecksum("hello", 5);
+            (void)checksum;
+
+            ASSERT(1 == taskAllocator.numBlocksTotal());
+        }
+
+        ASSERT(bslma::Default::defaultAllocator() ==
+                                   bslma::Default::processDefaultAllocator());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING THREAD ISOLATION
+        //
+        // Concerns:
+        //   1. A guard affects the default allocator of the thread that
+        //      created it only.
+        //   2. Guards repeatedly created and destroyed concurrently by several
+        //      threads do not interfere with one another.
+        //
+        // Plan:
+        //   With a guard installed in the main thread, create several
+        //   threads, each repeatedly allocating from the default allocator
+        //   with and without a guard installing its own test allocator, and
+        //   verify that each thread always observes the expected default
+        //   allocator, that each test allocator supplied all and only the
+        //   allocations of its thread, and that the default allocator of the
+        //   main thread is unaffected.
+        //
+        // Testing:
+        //   CONCERN: A guard has no effect on other threads.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING THREAD ISOLATION"
+                            "\n========================\n");
+
+        bslma::TestAllocator da(veryVeryVerbose);
+        bslma::Default::setDefaultAllocatorRaw(&da);
+
+        bslma::TestAllocator mainAllocator(veryVeryVerbose);
+        Obj                  guard(&mainAllocator);
+
+        bslma::TestAllocator ta[k_NUM_THREADS];
+        WorkerArgs           args[k_NUM_THREADS];
+        ThreadId             ids[k_NUM_THREADS];
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            args[i].d_allocator_p = &ta[i];
+            args[i].d_process_p   = &da;
+            args[i].d_numErrors   = 0;
+
+            ids[i] = createThread(&workerThread, &args[i]);
+        }
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            joinThread(ids[i]);
+        }
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            if (veryVerbose) { P_(i) P(ta[i].numBlocksTotal()) }
+
+            LOOP2_ASSERT(i, args[i].d_numErrors, 0 == args[i].d_numErrors);
+            LOOP2_ASSERT(i, ta[i].numBlocksTotal(),
+                         k_NUM_ITERATIONS == ta[i].numBlocksTotal());
+        }
+
+        ASSERT(&mainAllocator == bslma::Default::defaultAllocator());
+        ASSERT(0 == mainAllocator.numBlocksTotal());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CREATORS
+        //
+        // Concerns:
+        //   1. The constructor installs the guarded allocator as the thread
+        //      default allocator, and the destructor restores the thread
+        //      default allocator that was installed on construction, or
+        //      uninstalls it if none was.
+        //   2. Guards nest.
+        //   3. A guard created with 0 uninstalls the thread default allocator
+        //      for its lifetime.
+        //   4. A guard has no effect on the process-wide default allocator.
+        //
+        // Plan:
+        //   Create nested guards, including one guarding 0, and verify the
+        //   thread default, default, and process-wide default allocators
+        //   after each creation and destruction.
+        //
+        // Testing:
+        //   bslma::ThreadDefaultAllocatorGuard(bslma::Allocator *temporary);
+        //   ~bslma::ThreadDefaultAllocatorGuard();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING CREATORS"
+                            "\n================\n");
+
+        bslma::TestAllocator da(veryVeryVerbose);
+        bslma::Default::setDefaultAllocatorRaw(&da);
+
+        bslma::TestAllocator a1(veryVeryVerbose);
+        bslma::TestAllocator a2(veryVeryVerbose);
+
+        ASSERT(0   == bslma::Default::threadDefaultAllocator());
+        {
+            Obj g1(&a1);
+            ASSERT(&a1 == bslma::Default::threadDefaultAllocator());
+            ASSERT(&a1 == bslma::Default::defaultAllocator());
+            ASSERT(&da == bslma::Default::processDefaultAllocator());
+            {
+                Obj g2(&a2);
+                ASSERT(&a2 == bslma::Default::threadDefaultAllocator());
+                ASSERT(&a2 == bslma::Default::defaultAllocator());
+                {
+                    Obj g3(0);
+                    ASSERT(0   == bslma::Default::threadDefaultAllocator());
+                    ASSERT(&da == bslma::Default::defaultAllocator());
+                }
+                ASSERT(&a2 == bslma::Default::threadDefaultAllocator());
+                ASSERT(&a2 == bslma::Default::defaultAllocator());
+            }
+            ASSERT(&a1 == bslma::Default::threadDefaultAllocator());
+            ASSERT(&a1 == bslma::Default::defaultAllocator());
+            ASSERT(&da == bslma::Default::processDefaultAllocator());
+        }
+        ASSERT(0   == bslma::Default::threadDefaultAllocator());
+        ASSERT(&da == bslma::Default::defaultAllocator());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic
+        //   functionality.
+        //
+        // Concerns:
+        //   1. The guard installs its allocator as the default allocator of
+        //      the calling thread, and restores the previous default
+        //      allocator on destruction.
+        //
+        // Plan:
+        //   Create a guard in an inner scope, allocate from the default
+        //   allocator, and verify the allocator used and the default
+        //   allocator after the scope ends.
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        bslma::Allocator *original = bslma::Default::defaultAllocator();
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        {
+            Obj guard(&ta);
+            ASSERT(&ta == bslma::Default::defaultAllocator());
+
+            void *p = bslma::Default::allocator(0)->allocate(16);
+            ASSERT(1 == ta.numBlocksInUse());
+            ta.deallocate(p);
+        }
+        ASSERT(original == bslma::Default::defaultAllocator());
+      } break;
+
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
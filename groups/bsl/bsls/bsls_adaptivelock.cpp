@@ -0,0 +1,66 @@
+// bsls_adaptivelock.cpp                                              -*-C++-*-
+#include <bsls_adaptivelock.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bsls_bsltestutil.h>  // for testing only
+#include <bsls_waitutil.h>
+
+namespace BloombergLP {
+namespace bsls {
+
+                             // ------------------
+                             // class AdaptiveLock
+                             // ------------------
+
+// PRIVATE MANIPULATORS
+void AdaptiveLock::lockContended()
+{
+    // Spin, reading the state (so as not to take exclusive ownership of its
+    // cache line) until the lock appears to be released.
+
+    for (int i = 0; i < k_SPIN_COUNT; ++i) {
+        WaitUtil::pause();
+
+        if (e_UNLOCKED == AtomicOperations::getIntRelaxed(&d_state)
+         && e_UNLOCKED == AtomicOperations::testAndSwapIntAcqRel(&d_state,
+                                                                 e_UNLOCKED,
+                                                                 e_LOCKED)) {
+            return;                                                   // RETURN
+        }
+    }
+
+    // Block until the lock is released.  Having blocked, a thread cannot know
+    // whether other threads are still blocked, and therefore acquires the
+    // lock in the 'e_CONTENDED' state, so that 'unlock' wakes the next one.
+
+    while (e_UNLOCKED != AtomicOperations::swapIntAcqRel(&d_state,
+                                                         e_CONTENDED)) {
+        WaitUtil::wait(&d_state, e_CONTENDED);
+    }
+}
+
+void AdaptiveLock::unlockContended()
+{
+    WaitUtil::wakeOne(&d_state);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,332 @@
+// bsls_adaptivelock.h                                                -*-C++-*-
+#ifndef INCLUDED_BSLS_ADAPTIVELOCK
+#define INCLUDED_BSLS_ADAPTIVELOCK
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a mutex that spins briefly before blocking.
+//
+//@CLASSES:
+//  bsls::AdaptiveLock: mutex spinning before blocking
+//  bsls::AdaptiveLockGuard: RAII mechanism for locking an 'AdaptiveLock'
+//
+//@SEE_ALSO: bsls_bsllock, bsls_readerwriterlock, bsls_waitutil
+//
+//@DESCRIPTION: This component provides a mutually exclusive lock primitive
+// ("mutex"), 'bsls::AdaptiveLock', for use below 'bslmt', that is optimized
+// for critical sections that are short and rarely contended.  Like
+// 'bsls::BslLock', 'bsls::AdaptiveLock' provides 'lock' and 'unlock'
+// operations (and is not recursive); it additionally provides a 'tryLock'
+// operation.
+//
+// This component also provides the 'bsls::AdaptiveLockGuard' class, a
+// mechanism that follows the RAII idiom for automatically acquiring and
+// releasing the lock on an associated 'bsls::AdaptiveLock' object.
+//
+///Spinning and Blocking
+///---------------------
+// A 'bsls::AdaptiveLock' is a single atomic integer: it requires no
+// initialization by (nor resources of) the operating system, and acquiring
+// and releasing an uncontended lock each cost one atomic read-modify-write
+// operation, without a function call.
+//
+// A thread attempting to acquire a lock held by another thread first spins
+// (reading the state of the lock, with 'bsls::WaitUtil::pause' between
+// reads) for up to 'k_SPIN_COUNT' iterations, on the premise that a lock
+// protecting a short critical section is soon released, in which case the
+// cost of blocking and waking the thread is avoided.  If the lock is still
+// held after spinning, the thread marks the lock as *contended* and blocks
+// (with 'bsls::WaitUtil::wait', i.e., on a 'futex' on Linux) until it is
+// woken.  'unlock' wakes a blocked thread only if the lock is marked
+// contended, and therefore makes no system call unless a thread is blocked.
+//
+// Note that the lock is not fair: a thread releasing the lock can re-acquire
+// it before the thread it woke.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Protecting a Counter
+///- - - - - - - - - - - - - - - -
+// Suppose that we want to maintain a table of statistics, updated by several
+// threads, in a component below 'bslmt'.  The updates are short, and the
+// threads are expected to rarely contend on the table.
+//
+// First, we define the table, protected by a 'bsls::AdaptiveLock':
+//..
+//  class my_Statistics {
+//      // This class maintains the number and the total size of requests.
+//
+//      // DATA
+//      mutable bsls::AdaptiveLock d_lock;         // protects the members
+//                                                 // below
+//      int                        d_numRequests;  // number of requests
+//      bsls::Types::Int64         d_totalSize;    // total size of requests
+//
+//    public:
+//      // CREATORS
+//      my_Statistics()
+//      : d_numRequests(0)
+//      , d_totalSize(0)
+//      {
+//      }
+//
+//      // MANIPULATORS
+//      void addRequest(int size)
+//      {
+//          bsls::AdaptiveLockGuard guard(&d_lock);
+//          ++d_numRequests;
+//          d_totalSize += size;
+//      }
+//
+//      // ACCESSORS
+//      double averageSize() const
+//      {
+//          bsls::AdaptiveLockGuard guard(&d_lock);
+//          return d_numRequests ? static_cast<double>(d_totalSize)
+//                                                            / d_numRequests
+//                               : 0.0;
+//      }
+//  };
+//..
+// Then, we record requests, whose average size we compute:
+//..
+//  my_Statistics statistics;
+//
+//  statistics.addRequest(100);
+//  statistics.addRequest(300);
+//
+//  assert(200.0 == statistics.averageSize());
+//..
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMICOPERATIONS
+#include <bsls_atomicoperations.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+namespace BloombergLP {
+namespace bsls {
+
+                             // ==================
+                             // class AdaptiveLock
+                             // ==================
+
+class AdaptiveLock {
+    // This 'class' implements a non-recursive mutex that spins briefly before
+    // blocking the calling thread.
+
+    // PRIVATE TYPES
+    enum {
+        e_UNLOCKED  = 0,  // the lock is not held
+        e_LOCKED    = 1,  // the lock is held, and no thread is blocked on it
+        e_CONTENDED = 2   // the lock is held, and threads may be blocked on
+                          // it
+    };
+
+    // DATA
+    AtomicOperations::AtomicTypes::Int d_state;  // 'e_UNLOCKED', 'e_LOCKED',
+                                                 // or 'e_CONTENDED'
+
+  private:
+    // NOT IMPLEMENTED
+    AdaptiveLock(const AdaptiveLock&);             // = delete
+    AdaptiveLock& operator=(const AdaptiveLock&);  // = delete
+
+    // PRIVATE MANIPULATORS
+    void lockContended();
+        // Acquire the lock on this object, which was held by another thread
+        // at the time of the call, spinning and blocking as required.
+
+    void unlockContended();
+        // Wake one of the threads blocked on this object.
+
+  public:
+    // TYPES
+    enum {
+        k_SPIN_COUNT = 100  // maximum number of times a thread examines a
+                            // held lock before blocking
+    };
+
+    // CREATORS
+    AdaptiveLock();
+        // Create a lock object in the unlocked state.
+
+    //! ~AdaptiveLock() = default;
+        // Destroy this lock object.  The behavior is undefined unless this
+        // object is in the unlocked state.
+
+    // MANIPULATORS
+    void lock();
+        // Acquire the lock on this object.  If this lock object is currently
+        // locked by a different thread, then suspend execution of the
+        // current thread until a lock can be acquired.  The behavior is
+        // undefined unless the calling thread does not already hold the lock
+        // on this object.  Note that deadlock may result if this method is
+        // invoked while the calling thread holds the lock on the object.
+
+    int tryLock();
+        // Attempt to acquire the lock on this object, without blocking.
+        // Return 0 on success, and a non-zero value if this object is locked
+        // by another thread.
+
+    void unlock();
+        // Release the lock on this object that was previously acquired
+        // through a call to 'lock' or a successful call to 'tryLock', enabling
+        // another thread to acquire the lock.  The behavior is undefined
+        // unless the calling thread holds the lock on this object.
+};
+
+                          // =======================
+                          // class AdaptiveLockGuard
+                          // =======================
+
+class AdaptiveLockGuard {
+    // This 'class' implements a guard for automatically acquiring and
+    // releasing the lock on an associated 'bsls::AdaptiveLock' object.  This
+    // mechanism follows the RAII idiom whereby the lock on the 'AdaptiveLock'
+    // associated with a guard object is acquired upon construction and
+    // released upon destruction.
+
+    // DATA
+    AdaptiveLock *d_lock_p;  // lock guarded by this object (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    AdaptiveLockGuard(const AdaptiveLockGuard&);             // = delete
+    AdaptiveLockGuard& operator=(const AdaptiveLockGuard&);  // = delete
+
+  public:
+    // CREATORS
+    explicit AdaptiveLockGuard(AdaptiveLock *lock);
+        // Create a guard object that conditionally manages the specified
+        // 'lock', and acquires the lock on 'lock' by invoking its 'lock'
+        // method.  The behavior is undefined unless the calling thread does
+        // not already hold the lock on 'lock'.  Note that 'lock' must remain
+        // valid throughout the lifetime of this guard, or until 'release' is
+        // called.
+
+    ~AdaptiveLockGuard();
+        // Destroy this guard object and release the lock on the object it
+        // manages (if any) by invoking the 'unlock' method of the object that
+        // was supplied at construction of this guard.  If no lock is
+        // currently being managed, this method has no effect.
+
+    // MANIPULATORS
+    void release();
+        // Release from management, with no effect, the object currently
+        // managed by this guard, if any.  Note that 'unlock' is *not* called
+        // on the managed object upon its release.
+};
+
+// ============================================================================
+//                        INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                             // ------------------
+                             // class AdaptiveLock
+                             // ------------------
+
+// CREATORS
+inline
+AdaptiveLock::AdaptiveLock()
+{
+    AtomicOperations::initInt(&d_state, e_UNLOCKED);
+}
+
+// MANIPULATORS
+inline
+void AdaptiveLock::lock()
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                  e_UNLOCKED != AtomicOperations::testAndSwapIntAcqRel(
+                                                                 &d_state,
+                                                                 e_UNLOCKED,
+                                                                 e_LOCKED))) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        lockContended();
+    }
+}
+
+inline
+int AdaptiveLock::tryLock()
+{
+    return e_UNLOCKED == AtomicOperations::testAndSwapIntAcqRel(&d_state,
+                                                                e_UNLOCKED,
+                                                                e_LOCKED)
+           ? 0
+           : 1;
+}
+
+inline
+void AdaptiveLock::unlock()
+{
+    BSLS_ASSERT_SAFE(e_UNLOCKED != AtomicOperations::getIntRelaxed(&d_state));
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+          e_CONTENDED == AtomicOperations::swapIntAcqRel(&d_state,
+                                                         e_UNLOCKED))) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        unlockContended();
+    }
+}
+
+                          // -----------------------
+                          // class AdaptiveLockGuard
+                          // -----------------------
+
+// CREATORS
+inline
+AdaptiveLockGuard::AdaptiveLockGuard(AdaptiveLock *lock)
+: d_lock_p(lock)
+{
+    BSLS_ASSERT_SAFE(lock);
+
+    d_lock_p->lock();
+}
+
+inline
+AdaptiveLockGuard::~AdaptiveLockGuard()
+{
+    if (d_lock_p) {
+        d_lock_p->unlock();
+    }
+}
+
+// MANIPULATORS
+inline
+void AdaptiveLockGuard::release()
+{
+    d_lock_p = 0;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
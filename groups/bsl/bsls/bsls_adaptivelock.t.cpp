@@ -0,0 +1,522 @@
+// bsls_adaptivelock.t.cpp                                            -*-C++-*-
+
+#include <bsls_adaptivelock.h>
+
+#include <bsls_asserttest.h>     // for testing only
+#include <bsls_atomic.h>         // for testing only
+#include <bsls_bsltestutil.h>    // for testing only
+#include <bsls_platform.h>       // for testing only
+#include <bsls_types.h>          // for testing only
+#include <bsls_waitutil.h>       // for testing only
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a mutex that spins before blocking, and a guard
+// for it.  We verify the state transitions of the lock observable in a single
+// thread (with 'tryLock'), that the guard locks and unlocks the lock (unless
+// released), and that the lock provides mutual exclusion to threads
+// contending on it, both when the critical section is short (the threads
+// mostly spin) and when it is long (the threads mostly block).
+// ----------------------------------------------------------------------------
+// 'AdaptiveLock' class:
+// [ 2] AdaptiveLock();
+// [ 2] ~AdaptiveLock();
+// [ 2] void lock();
+// [ 2] int tryLock();
+// [ 2] void unlock();
+//
+// 'AdaptiveLockGuard' class:
+// [ 3] explicit AdaptiveLockGuard(AdaptiveLock *lock);
+// [ 3] ~AdaptiveLockGuard();
+// [ 3] void release();
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+// [ 4] CONCERN: The lock provides mutual exclusion to contending threads.
+
+// ============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bsls::AdaptiveLock      Obj;
+typedef bsls::AdaptiveLockGuard Guard;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+                                // -------
+                                // case 4
+                                // -------
+
+struct CountArgs {
+    // This 'struct' holds the arguments of 'countThread'.
+
+    Obj                *d_lock_p;         // lock protecting the counters
+    bsls::Types::Int64 *d_counter_p;      // counter incremented
+    bsls::Types::Int64 *d_copy_p;         // copy of '*d_counter_p'
+    int                 d_numIterations;  // number of increments
+    int                 d_numDelays;      // length of the critical section
+    bsls::AtomicInt    *d_numErrors_p;    // number of inconsistencies seen
+};
+
+extern "C"
+void *countThread(void *arg)
+    // Increment, under the lock, the counter described by the specified 'arg'
+    // (a 'CountArgs' object) and its copy, verifying that they are equal.
+{
+    CountArgs *args = static_cast<CountArgs *>(arg);
+
+    for (int i = 0; i < args->d_numIterations; ++i) {
+        Guard guard(args->d_lock_p);
+
+        // Not atomic: another thread would see the counters differ, and
+        // increments would be lost, without mutual exclusion.
+
+        const bsls::Types::Int64 counter = *args->d_counter_p;
+        for (int j = 0; j < args->d_numDelays; ++j) {
+            bsls::WaitUtil::pause();
+        }
+        if (counter != *args->d_copy_p) {
+            ++*args->d_numErrors_p;
+        }
+        *args->d_counter_p = counter + 1;
+        *args->d_copy_p    = counter + 1;
+    }
+    return 0;
+}
+
+                                // -------
+                                // case 5
+                                // -------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Protecting a Counter
+///- - - - - - - - - - - - - - - -
+// Suppose that we want to maintain a table of statistics, updated by several
+// threads, in a component below 'bslmt'.  The updates are short, and the
+// threads are expected to rarely contend on the table.
+//
+// First, we define the table, protected by a 'bsls::AdaptiveLock':
+//..
+    class my_Statistics {
+        // This class maintains the number and the total size of requests.
+
+        // DATA
+        mutable bsls::AdaptiveLock d_lock;         // protects the members
+                                                   // below
+        int                        d_numRequests;  // number of requests
+        bsls::Types::Int64         d_totalSize;    // total size of requests
+
+      public:
+        // CREATORS
+        my_Statistics()
+        : d_numRequests(0)
+        , d_totalSize(0)
+        {
+        }
+
+        // MANIPULATORS
+        void addRequest(int size)
+        {
+            bsls::AdaptiveLockGuard guard(&d_lock);
+            ++d_numRequests;
+            d_totalSize += size;
+        }
+
+        // ACCESSORS
+        double averageSize() const
+        {
+            bsls::AdaptiveLockGuard guard(&d_lock);
+            return d_numRequests ? static_cast<double>(d_totalSize)
+                                                              / d_numRequests
+                                 : 0.0;
+        }
+    };
+//..
+
+// ============================================================================
+//                              MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Then, we record requests, whose average size we compute:
+//..
+    my_Statistics statistics;
+
+    statistics.addRequest(100);
+    statistics.addRequest(300);
+
+    ASSERT(200.0 == statistics.averageSize());
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // MUTUAL EXCLUSION
+        //
+        // Concerns:
+        //: 1 At most one thread holds the lock at any time, whether the
+        //:   threads contending on the lock spin or block.
+        //:
+        //: 2 Every thread blocked on the lock is eventually woken.
+        //
+        // Plan:
+        //: 1 For critical sections of several lengths, have several threads
+        //:   increment (non-atomically) a counter and a copy of it under the
+        //:   lock, verifying that the copy equals the counter, and verify that
+        //:   no increment was lost.  (C-1..2)
+        //
+        // Testing:
+        //   CONCERN: The lock provides mutual exclusion to contending threads.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nMUTUAL EXCLUSION"
+                            "\n================\n");
+
+        enum { k_NUM_THREADS = 8 };
+
+        static const struct {
+            int d_line;           // source line number
+            int d_numIterations;  // number of increments per thread
+            int d_numDelays;      // length of the critical section
+        } DATA[] = {
+            //LINE  ITERATIONS  DELAYS
+            //----  ----------  ------
+            { L_,       100000,      0 },
+            { L_,        20000,     20 },
+            { L_,         2000,   1000 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE       = DATA[ti].d_line;
+            const int ITERATIONS = DATA[ti].d_numIterations;
+            const int DELAYS     = DATA[ti].d_numDelays;
+
+            Obj                lock;
+            bsls::Types::Int64 counter = 0;
+            bsls::Types::Int64 copy    = 0;
+            bsls::AtomicInt    numErrors(0);
+
+            CountArgs args = { &lock,
+                               &counter,
+                               &copy,
+                               ITERATIONS,
+                               DELAYS,
+                               &numErrors };
+
+            ThreadId threads[k_NUM_THREADS];
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                threads[i] = createThread(&countThread, &args);
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                joinThread(threads[i]);
+            }
+
+            ASSERTV(LINE, numErrors, 0 == numErrors);
+            ASSERTV(LINE, counter, k_NUM_THREADS * ITERATIONS == counter);
+            ASSERTV(LINE, 0 == lock.tryLock());
+            lock.unlock();
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // GUARD
+        //
+        // Concerns:
+        //: 1 The guard acquires the lock on construction, and releases it on
+        //:   destruction.
+        //:
+        //: 2 The guard does not release the lock on destruction after
+        //:   'release' is called.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create a guard, verify with 'tryLock' that the lock is held, and
+        //:   verify that the lock is released once the guard is destroyed.
+        //:   (C-1)
+        //:
+        //: 2 Create a guard, call 'release', and verify that the lock is still
+        //:   held once the guard is destroyed.  (C-2)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a null lock, and for unlocking an unlocked lock.
+        //:   (C-3)
+        //
+        // Testing:
+        //   explicit AdaptiveLockGuard(AdaptiveLock *lock);
+        //   ~AdaptiveLockGuard();
+        //   void release();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nGUARD"
+                            "\n=====\n");
+
+        Obj mX;
+
+        {
+            Guard guard(&mX);
+            ASSERT(0 != mX.tryLock());
+        }
+        ASSERT(0 == mX.tryLock());
+        mX.unlock();
+
+        {
+            Guard guard(&mX);
+            guard.release();
+        }
+        ASSERT(0 != mX.tryLock());
+        mX.unlock();
+        ASSERT(0 == mX.tryLock());
+        mX.unlock();
+
+        if (verbose) printf("\tNegative Testing.\n");
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_SAFE_FAIL(Guard(0));
+
+            Obj mY;
+            ASSERT_SAFE_FAIL(mY.unlock());
+            mY.lock();
+            ASSERT_SAFE_PASS(mY.unlock());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // LOCK, TRYLOCK, AND UNLOCK
+        //
+        // Concerns:
+        //: 1 A lock is created in the unlocked state.
+        //:
+        //: 2 'lock' and a successful 'tryLock' acquire the lock, and 'unlock'
+        //:   releases it.
+        //:
+        //: 3 'tryLock' fails, without blocking, if the lock is held.
+        //
+        // Plan:
+        //: 1 Using 'tryLock' to observe the state of the lock, lock and unlock
+        //:   a lock with 'lock' and 'tryLock'.  (C-1..3)
+        //
+        // Testing:
+        //   AdaptiveLock();
+        //   ~AdaptiveLock();
+        //   void lock();
+        //   int tryLock();
+        //   void unlock();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nLOCK, TRYLOCK, AND UNLOCK"
+                            "\n=========================\n");
+
+        Obj mX;
+
+        ASSERT(0 == mX.tryLock());
+        ASSERT(0 != mX.tryLock());
+        ASSERT(0 != mX.tryLock());
+        mX.unlock();
+
+        mX.lock();
+        ASSERT(0 != mX.tryLock());
+        mX.unlock();
+
+        for (int i = 0; i < 3; ++i) {
+            mX.lock();
+            mX.unlock();
+        }
+        ASSERT(0 == mX.tryLock());
+        mX.unlock();
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The component is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Lock and unlock a lock, directly and with a guard, and from two
+        //:   threads.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        Obj mX;
+
+        mX.lock();
+        mX.unlock();
+
+        {
+            Guard guard(&mX);
+        }
+
+        bsls::Types::Int64 counter = 0;
+        bsls::Types::Int64 copy    = 0;
+        bsls::AtomicInt    numErrors(0);
+        CountArgs          args = { &mX, &counter, &copy, 1000, 0,
+                                    &numErrors };
+
+        ThreadId thread = createThread(&countThread, &args);
+        countThread(&args);
+        joinThread(thread);
+
+        ASSERT(0    == numErrors);
+        ASSERT(2000 == counter);
+        if (veryVerbose) { P(counter) }
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -11,6 +11,7 @@ BSLS_IDENT("$Id: $")
 //
 //@CLASSES:
 //  bsls::AlignmentImpCalc: 'TYPE' parameter to alignment 'VALUE' map
+//  bsls::AlignmentImpExtendedType: extended 'ALIGNMENT' param to type map
 //  bsls::AlignmentImpMatch: namespace for overloaded 'match' functions
 //  bsls::AlignmentImpPriorityToType: 'PRIORITY' param to primitive type map
 //  bsls::AlignmentImpTag: unique type of size 'SIZE' (parameter)
@@ -365,6 +366,49 @@ struct AlignmentImpPriorityToType<13> {
 };
 #endif
 
+                // ===============================
+                // struct AlignmentImpExtendedType
+                // ===============================
+
+template <int ALIGNMENT>
+struct AlignmentImpExtendedType {
+    // Specializations of this 'struct' provide a type (as a 'Type' 'typedef')
+    // whose size and alignment are both the specified 'ALIGNMENT', for each
+    // power of two from 16 to 4096.  Such a type is needed for an *extended*
+    // alignment, i.e., one that no fundamental type has, and is declared
+    // using a compiler-specific attribute.
+};
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#   define BSLS_ALIGNMENTIMP_EXTENDED_TYPE(ALIGNMENT)                       \
+        template <>                                                         \
+        struct AlignmentImpExtendedType<ALIGNMENT> {                        \
+            struct __declspec(align(ALIGNMENT)) Type {                      \
+                char d_dummy[ALIGNMENT];                                    \
+            };                                                              \
+        }
+#else
+#   define BSLS_ALIGNMENTIMP_EXTENDED_TYPE(ALIGNMENT)                       \
+        template <>                                                         \
+        struct AlignmentImpExtendedType<ALIGNMENT> {                        \
+            struct Type {                                                   \
+                char d_dummy[ALIGNMENT];                                    \
+            } __attribute__((aligned(ALIGNMENT)));                          \
+        }
+#endif
+
+BSLS_ALIGNMENTIMP_EXTENDED_TYPE(  16);
+BSLS_ALIGNMENTIMP_EXTENDED_TYPE(  32);
+BSLS_ALIGNMENTIMP_EXTENDED_TYPE(  64);
+BSLS_ALIGNMENTIMP_EXTENDED_TYPE( 128);
+BSLS_ALIGNMENTIMP_EXTENDED_TYPE( 256);
+BSLS_ALIGNMENTIMP_EXTENDED_TYPE( 512);
+BSLS_ALIGNMENTIMP_EXTENDED_TYPE(1024);
+BSLS_ALIGNMENTIMP_EXTENDED_TYPE(2048);
+BSLS_ALIGNMENTIMP_EXTENDED_TYPE(4096);
+
+#undef BSLS_ALIGNMENTIMP_EXTENDED_TYPE
+
                 // ============================
                 // struct AlignmentImp_Priority
                 // ============================
@@ -433,6 +477,15 @@ struct AlignmentImpMatch {
     static BSLS_ALIGNMENTIMP_MATCH_FUNC(AlignmentImp8ByteAlignedType,      13);
 #endif
 
+    enum { k_EXTENDED_PRIORITY = 14 };
+        // Priority returned by 'match' for an alignment that no fundamental
+        // type has (see 'AlignmentImpExtendedType').
+
+    static AlignmentImpTag<k_EXTENDED_PRIORITY> match(...);
+        // This function will match any alignment and size not matched by one
+        // of the functions above.  Note that, having an ellipsis parameter,
+        // it is never preferred to one of them.
+
     typedef AlignmentImp_Priority<13> MaxPriority;
 };
 
@@ -19,6 +19,13 @@ BSLS_IDENT("$Id: $")
 // declares a 'typedef' ('Type'), which is an alias for a primitive type having
 // the indicated 'ALIGNMENT' requirement.
 //
+// If 'ALIGNMENT' is an *extended* alignment (a power of two, up to 4096,
+// exceeding the alignment of every primitive type, e.g., the 64-byte alignment
+// of a cache line), 'Type' is instead an alias for a 'struct' whose size and
+// alignment are both 'ALIGNMENT', declared using a compiler-specific
+// attribute.  This allows 'bsls::AlignmentFromType', and hence aligned
+// buffers such as 'bsls::ObjectBuffer', to support over-aligned types.
+//
 ///Usage
 ///-----
 // Consider a parameterized type, 'my_AlignedBuffer', that provides aligned
@@ -272,6 +279,24 @@ namespace BloombergLP {
 
 namespace bsls {
 
+                        // ==========================
+                        // struct AlignmentToType_Imp
+                        // ==========================
+
+template <int PRIORITY, int ALIGNMENT>
+struct AlignmentToType_Imp : AlignmentImpPriorityToType<PRIORITY> {
+    // This component-private 'struct' provides a 'typedef', 'Type', that
+    // aliases the primitive type having the specified 'PRIORITY'.
+};
+
+template <int ALIGNMENT>
+struct AlignmentToType_Imp<AlignmentImpMatch::k_EXTENDED_PRIORITY, ALIGNMENT>
+: AlignmentImpExtendedType<ALIGNMENT> {
+    // This partial specialization of 'AlignmentToType_Imp' provides a
+    // 'typedef', 'Type', that aliases a type having the specified extended
+    // 'ALIGNMENT', which no primitive type has.
+};
+
                          // ======================
                          // struct AlignmentToType
                          // ======================
@@ -297,9 +322,10 @@ struct AlignmentToType {
 
   public:
     // TYPES
-    typedef typename AlignmentImpPriorityToType<PRIORITY>::Type Type;
+    typedef typename AlignmentToType_Imp<PRIORITY, ALIGNMENT>::Type Type;
         // Alias for a primitive type that has the specified 'ALIGNMENT'
-        // requirement.
+        // requirement or, if 'ALIGNMENT' is an extended alignment that no
+        // primitive type has, for a 'struct' having that alignment.
 };
 
 }  // close package namespace
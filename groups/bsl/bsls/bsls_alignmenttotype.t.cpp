@@ -30,8 +30,9 @@ using namespace std;
 // range of inputs.
 //-----------------------------------------------------------------------------
 // [ 1] bsls::AlignmentToType<N>::Type
+// [ 2] bsls::AlignmentToType<N>::Type (extended alignment)
 //-----------------------------------------------------------------------------
-// [ 2] USAGE EXAMPLE -- Ensure the usage example compiles and works.
+// [ 3] USAGE EXAMPLE -- Ensure the usage example compiles and works.
 //=============================================================================
 
 //-----------------------------------------------------------------------------
@@ -468,7 +469,7 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
-      case 2: {
+      case 3: {
         // --------------------------------------------------------------------
         // USAGE TEST
         //   Make sure main usage examples compile and work as advertized.
@@ -503,6 +504,43 @@ int main(int argc, char *argv[])
     }
 //..
 
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING EXTENDED ALIGNMENT
+        //
+        // Concerns:
+        //: 1 For each power of two from 16 to 4096, 'Type' is well-formed
+        //:   and has both the size and the alignment 'N', even where no
+        //:   primitive type has that alignment.
+        //
+        // Plan:
+        //: 1 For each such alignment, verify the alignment and size of
+        //:   'bsls::AlignmentToType<N>::Type'.  (C-1)
+        //
+        // Testing:
+        //   bsls::AlignmentToType<N>::Type (extended alignment)
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING EXTENDED ALIGNMENT"
+                          << "\n==========================" << endl;
+
+#define TEST_EXTENDED(N)                                                      \
+        LOOP_ASSERT(N, N == bsls::AlignmentImpCalc<                           \
+                                 bsls::AlignmentToType<N>::Type>::VALUE);     \
+        LOOP_ASSERT(N, N == sizeof(bsls::AlignmentToType<N>::Type))
+
+        TEST_EXTENDED(  16);
+        TEST_EXTENDED(  32);
+        TEST_EXTENDED(  64);
+        TEST_EXTENDED( 128);
+        TEST_EXTENDED( 256);
+        TEST_EXTENDED( 512);
+        TEST_EXTENDED(1024);
+        TEST_EXTENDED(2048);
+        TEST_EXTENDED(4096);
+
+#undef TEST_EXTENDED
       } break;
       case 1: {
         // --------------------------------------------------------------------
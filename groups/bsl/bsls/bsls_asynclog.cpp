@@ -0,0 +1,505 @@
+// bsls_asynclog.cpp                                                  -*-C++-*-
+#include <bsls_asynclog.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bsls_assert.h>
+#include <bsls_atomicoperations.h>
+#include <bsls_bsltestutil.h>  // for testing only
+#include <bsls_platform.h>
+#include <bsls_timeutil.h>
+#include <bsls_waitutil.h>
+
+#include <stdio.h>             // sprintf()
+#include <string.h>            // memchr(), memcpy()
+
+#if defined(BSLS_PLATFORM_OS_WINDOWS)
+    #include <windows.h>       // CreateThread(), WaitForSingleObject()
+#else
+    #include <pthread.h>
+#endif
+
+namespace BloombergLP {
+namespace bsls {
+
+namespace {
+
+typedef AtomicOperations         AtomicOps;
+typedef AtomicOps::AtomicTypes   AtomicTypes;
+
+#if defined(BSLS_PLATFORM_OS_WINDOWS)
+typedef HANDLE    ThreadHandle;
+#else
+typedef pthread_t ThreadHandle;
+#endif
+
+struct Record {
+    // This 'struct' holds a queued log record.  The queue is a bounded
+    // multiple-producer queue in which 'd_sequence' tells the state of each
+    // record: the record at index 'i' may be written by the producer claiming
+    // position 'p' (with 'p % k_CAPACITY == i') when its sequence number is
+    // 'p', is readable when its sequence number is 'p + 1', and is released,
+    // once read, by setting its sequence number to 'p + k_CAPACITY'.  The
+    // sequence numbers are stored minus 'i', so that the zero-initialized
+    // records are in their initial state.
+
+    AtomicTypes::Int d_sequence;                          // sequence number
+                                                          // minus index
+
+    int              d_line;                              // line number
+
+    char             d_file[AsyncLog::k_MAX_FILE_LENGTH + 1];
+                                                          // file name
+
+    char             d_message[AsyncLog::k_MAX_MESSAGE_LENGTH + 1];
+                                                          // message
+};
+
+struct Site {
+    // This 'struct' holds the state of the rate limiting of the call sites
+    // hashing to the same entry of the table of sites.
+
+    AtomicTypes::Int64 d_intervalStart;  // start of the current interval
+                                         // (nanoseconds, see 'TimeUtil')
+
+    AtomicTypes::Int   d_count;          // number of records queued in the
+                                         // current interval
+};
+
+                                // ------------
+                                // Static State
+                                // ------------
+
+Record              s_records[AsyncLog::k_CAPACITY];
+Site                s_sites[AsyncLog::k_NUM_RATE_LIMITED_SITES];
+
+AtomicTypes::Int    s_running            = { 0 };  // 1 while the background
+                                                   // thread runs
+
+AtomicTypes::Int    s_stopRequested      = { 0 };  // 1 once 'stop' asks the
+                                                   // background thread to
+                                                   // exit
+
+AtomicTypes::Int    s_consumerIdle       = { 0 };  // 1 while the background
+                                                   // thread is (about to be)
+                                                   // blocked
+
+AtomicTypes::Int    s_enqueuePosition    = { 0 };  // next position to claim
+AtomicTypes::Int    s_dequeuePosition    = { 0 };  // next position to read
+AtomicTypes::Int    s_numFlushWaiters    = { 0 };  // threads blocked in
+                                                   // 'flush'
+
+AtomicTypes::Int    s_maxRecordsPerSite  = { 0 };  // 0 if not rate-limited
+AtomicTypes::Int64  s_intervalNanoseconds = { 0 };
+
+AtomicTypes::Int64  s_numDropped         = { 0 };
+AtomicTypes::Int64  s_numRateLimited     = { 0 };
+AtomicTypes::Int64  s_numWritten         = { 0 };
+
+Types::Int64 s_numReportedDropped     = 0;  // 's_numDropped' and
+Types::Int64 s_numReportedRateLimited = 0;  // 's_numRateLimited' as last
+                                            // reported by the background
+                                            // thread
+
+AtomicTypes::Pointer s_downstreamHandler =
+      { reinterpret_cast<void *>(&Log::platformDefaultMessageHandler) };
+
+Log::LogMessageHandler s_previousHandler = 0;  // handler to restore on 'stop'
+ThreadHandle           s_thread;               // background thread
+
+                          // ------------------------
+                          // Local Function Utilities
+                          // ------------------------
+
+inline
+Log::LogMessageHandler downstreamHandler()
+    // Return the handler to which the records are passed.
+{
+    return reinterpret_cast<Log::LogMessageHandler>(
+                               AtomicOps::getPtrAcquire(&s_downstreamHandler));
+}
+
+inline
+unsigned int loadSequence(const Record *record, unsigned int position)
+    // Return the sequence number of the specified 'record', being at the
+    // specified 'position' (modulo 'k_CAPACITY') of the queue, providing the
+    // acquire memory ordering guarantee.
+{
+    return static_cast<unsigned int>(AtomicOps::getIntAcquire(
+                                                         &record->d_sequence))
+         + position % AsyncLog::k_CAPACITY;
+}
+
+inline
+int encodeSequence(unsigned int sequence, unsigned int position)
+    // Return the value stored for the specified 'sequence' number of the
+    // record at the specified 'position' (modulo 'k_CAPACITY') of the queue.
+{
+    return static_cast<int>(sequence - position % AsyncLog::k_CAPACITY);
+}
+
+void copyString(char *buffer, const char *string, size_t maxLength)
+    // Copy into the specified 'buffer' at most the specified 'maxLength'
+    // first characters of the specified 'string', followed by a null
+    // character.
+{
+    const char *end = static_cast<const char *>(memchr(string, 0, maxLength));
+    const size_t length = end ? static_cast<size_t>(end - string) : maxLength;
+
+    memcpy(buffer, string, length);
+    buffer[length] = 0;
+}
+
+bool isRateLimited(const char *file, int line)
+    // Return 'true' if the call site having the specified 'file' and 'line'
+    // has queued the maximum number of records of its current interval, and
+    // count a record for the site otherwise.
+{
+    const int maxRecords = AtomicOps::getIntRelaxed(&s_maxRecordsPerSite);
+    if (0 == maxRecords) {
+        return false;                                                 // RETURN
+    }
+
+    // Fibonacci hashing of the site, keeping the upper 8 bits (for the 256
+    // entries of the table).
+
+    const Types::Uint64 key = reinterpret_cast<Types::UintPtr>(file) * 31
+                            + static_cast<Types::Uint64>(line);
+    Site& site = s_sites[(key * 0x9E3779B97F4A7C15ULL) >> 56];
+
+    const Types::Int64 now   = TimeUtil::getTimer();
+    const Types::Int64 start = AtomicOps::getInt64Relaxed(
+                                                        &site.d_intervalStart);
+    if (now - start >= AtomicOps::getInt64Relaxed(&s_intervalNanoseconds)
+     && start == AtomicOps::testAndSwapInt64AcqRel(&site.d_intervalStart,
+                                                   start,
+                                                   now)) {
+        AtomicOps::setIntRelaxed(&site.d_count, 0);
+    }
+
+    // Reading the count first keeps it from growing (and overflowing) while
+    // the site is rate-limited.
+
+    return AtomicOps::getIntRelaxed(&site.d_count) >= maxRecords
+        || AtomicOps::addIntNvRelaxed(&site.d_count, 1) > maxRecords;
+}
+
+bool enqueue(const char *file, int line, const char *message)
+    // Queue a record holding the specified 'file', 'line', and 'message'.
+    // Return 'true' on success, and 'false' if the queue is full.
+{
+    unsigned int position = static_cast<unsigned int>(
+                                 AtomicOps::getIntRelaxed(&s_enqueuePosition));
+    Record *record;
+    for (;;) {
+        record = &s_records[position % AsyncLog::k_CAPACITY];
+
+        const int difference = static_cast<int>(
+                                    loadSequence(record, position) - position);
+        if (0 == difference) {
+            const unsigned int previous = static_cast<unsigned int>(
+                           AtomicOps::testAndSwapIntAcqRel(
+                                             &s_enqueuePosition,
+                                             static_cast<int>(position),
+                                             static_cast<int>(position + 1)));
+            if (previous == position) {
+                break;
+            }
+            position = previous;
+        }
+        else if (difference < 0) {
+            // The record was not yet read since it was last written: the
+            // queue is full.
+
+            return false;                                             // RETURN
+        }
+        else {
+            position = static_cast<unsigned int>(
+                                 AtomicOps::getIntRelaxed(&s_enqueuePosition));
+        }
+    }
+
+    record->d_line = line;
+    copyString(record->d_file, file, AsyncLog::k_MAX_FILE_LENGTH);
+    copyString(record->d_message, message, AsyncLog::k_MAX_MESSAGE_LENGTH);
+
+    // The record is published, and 's_consumerIdle' read, with sequentially
+    // consistent operations, so that either this thread sees that the
+    // background thread is idle (and wakes it), or the background thread sees
+    // the record before blocking.
+
+    AtomicOps::setInt(&record->d_sequence,
+                      encodeSequence(position + 1, position));
+
+    if (AtomicOps::getInt(&s_consumerIdle)
+     && 1 == AtomicOps::swapInt(&s_consumerIdle, 0)) {
+        WaitUtil::wakeOne(&s_consumerIdle);
+    }
+    return true;
+}
+
+void reportDrops()
+    // If records were dropped (because the queue was full, or because of rate
+    // limiting) since the numbers of dropped records were last reported, pass
+    // to the downstream handler a message telling the numbers of records
+    // dropped since.
+{
+    const Types::Int64 numDropped     = AtomicOps::getInt64Relaxed(
+                                                                &s_numDropped);
+    const Types::Int64 numRateLimited = AtomicOps::getInt64Relaxed(
+                                                            &s_numRateLimited);
+
+    if (numDropped == s_numReportedDropped
+     && numRateLimited == s_numReportedRateLimited) {
+        return;                                                       // RETURN
+    }
+
+    char message[128];  // large enough for the format and two 20-digit
+                        // numbers
+
+    sprintf(message,
+            "bsls::AsyncLog dropped %lld log records (queue full) and %lld "
+            "log records (rate limit)",
+            static_cast<long long>(numDropped - s_numReportedDropped),
+            static_cast<long long>(numRateLimited
+                                                 - s_numReportedRateLimited));
+
+    downstreamHandler()(__FILE__, __LINE__, message);
+
+    s_numReportedDropped     = numDropped;
+    s_numReportedRateLimited = numRateLimited;
+}
+
+void drainQueue()
+    // Pass the queued records to the downstream handler, blocking while the
+    // queue is empty, until 'stop' is requested and the queue is empty.
+{
+    unsigned int position = static_cast<unsigned int>(
+                                 AtomicOps::getIntRelaxed(&s_dequeuePosition));
+
+    for (;;) {
+        Record *record = &s_records[position % AsyncLog::k_CAPACITY];
+
+        if (loadSequence(record, position) == position + 1) {
+            downstreamHandler()(record->d_file,
+                                record->d_line,
+                                record->d_message);
+
+            AtomicOps::setIntRelease(
+                            &record->d_sequence,
+                            encodeSequence(position + AsyncLog::k_CAPACITY,
+                                           position));
+            ++position;
+
+            AtomicOps::addInt64Relaxed(&s_numWritten, 1);
+
+            // As in 'enqueue', the position is published, and the number of
+            // flushing threads read, with sequentially consistent
+            // operations.
+
+            AtomicOps::setInt(&s_dequeuePosition,
+                              static_cast<int>(position));
+            if (AtomicOps::getInt(&s_numFlushWaiters)) {
+                WaitUtil::wakeAll(&s_dequeuePosition);
+            }
+            continue;
+        }
+
+        // The queue is empty (or its next record is being written).
+
+        reportDrops();
+
+        if (AtomicOps::getInt(&s_stopRequested)) {
+            return;                                                   // RETURN
+        }
+
+        AtomicOps::setInt(&s_consumerIdle, 1);
+
+        // As in 'enqueue', the idle state is published, and the record read,
+        // with sequentially consistent operations.
+
+        const unsigned int sequence = static_cast<unsigned int>(
+                                     AtomicOps::getInt(&record->d_sequence))
+                                    + position % AsyncLog::k_CAPACITY;
+        if (sequence == position + 1 || AtomicOps::getInt(&s_stopRequested)) {
+            AtomicOps::setIntRelaxed(&s_consumerIdle, 0);
+            continue;
+        }
+
+        while (1 == AtomicOps::getIntAcquire(&s_consumerIdle)) {
+            WaitUtil::wait(&s_consumerIdle, 1);
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+extern "C" {
+
+#if defined(BSLS_PLATFORM_OS_WINDOWS)
+static DWORD WINAPI bsls_asynclog_drainThread(LPVOID)
+    // Drain the queue of 'bsls::AsyncLog' until 'stop' is requested.
+{
+    drainQueue();
+    return 0;
+}
+#else
+static void *bsls_asynclog_drainThread(void *)
+    // Drain the queue of 'bsls::AsyncLog' until 'stop' is requested.
+{
+    drainQueue();
+    return 0;
+}
+#endif
+
+}  // close extern "C"
+
+                               // --------------
+                               // class AsyncLog
+                               // --------------
+
+// CLASS METHODS
+void AsyncLog::asyncMessageHandler(const char *file,
+                                   int         line,
+                                   const char *message)
+{
+    BSLS_ASSERT_SAFE(file);
+    BSLS_ASSERT_SAFE(0 <= line);
+    BSLS_ASSERT_SAFE(message);
+
+    if (!AtomicOps::getIntAcquire(&s_running)) {
+        downstreamHandler()(file, line, message);
+        return;                                                       // RETURN
+    }
+
+    if (isRateLimited(file, line)) {
+        AtomicOps::addInt64Relaxed(&s_numRateLimited, 1);
+        return;                                                       // RETURN
+    }
+
+    if (!enqueue(file, line, message)) {
+        AtomicOps::addInt64Relaxed(&s_numDropped, 1);
+    }
+}
+
+void AsyncLog::flush()
+{
+    if (!isRunning()) {
+        return;                                                       // RETURN
+    }
+
+    const unsigned int target = static_cast<unsigned int>(
+                                        AtomicOps::getInt(&s_enqueuePosition));
+
+    AtomicOps::addInt(&s_numFlushWaiters, 1);
+    for (;;) {
+        const int position = AtomicOps::getInt(&s_dequeuePosition);
+        if (0 <= static_cast<int>(static_cast<unsigned int>(position)
+                                                                   - target)) {
+            break;
+        }
+        WaitUtil::wait(&s_dequeuePosition, position);
+    }
+    AtomicOps::addInt(&s_numFlushWaiters, -1);
+}
+
+bool AsyncLog::isRunning()
+{
+    return 0 != AtomicOps::getIntAcquire(&s_running);
+}
+
+Types::Int64 AsyncLog::numDropped()
+{
+    return AtomicOps::getInt64Acquire(&s_numDropped);
+}
+
+Types::Int64 AsyncLog::numRateLimited()
+{
+    return AtomicOps::getInt64Acquire(&s_numRateLimited);
+}
+
+Types::Int64 AsyncLog::numWritten()
+{
+    return AtomicOps::getInt64Acquire(&s_numWritten);
+}
+
+int AsyncLog::start(Log::LogMessageHandler downstreamHandler,
+                    int                    maxRecordsPerSite,
+                    int                    intervalMilliseconds)
+{
+    BSLS_ASSERT(downstreamHandler);
+    BSLS_ASSERT(&asyncMessageHandler != downstreamHandler);
+    BSLS_ASSERT(0 <= maxRecordsPerSite);
+    BSLS_ASSERT(0 <  intervalMilliseconds);
+
+    if (isRunning()) {
+        return 1;                                                     // RETURN
+    }
+
+    TimeUtil::initialize();
+
+    AtomicOps::setPtrRelease(&s_downstreamHandler,
+                             reinterpret_cast<void *>(downstreamHandler));
+    AtomicOps::setIntRelaxed(&s_maxRecordsPerSite, maxRecordsPerSite);
+    AtomicOps::setInt64Relaxed(&s_intervalNanoseconds,
+                               intervalMilliseconds * 1000000LL);
+    AtomicOps::setInt(&s_stopRequested, 0);
+
+#if defined(BSLS_PLATFORM_OS_WINDOWS)
+    s_thread = CreateThread(0, 0, &bsls_asynclog_drainThread, 0, 0, 0);
+    if (!s_thread) {
+        return 2;                                                     // RETURN
+    }
+#else
+    if (0 != pthread_create(&s_thread, 0, &bsls_asynclog_drainThread, 0)) {
+        return 2;                                                     // RETURN
+    }
+#endif
+
+    s_previousHandler = Log::logMessageHandler();
+
+    AtomicOps::setIntRelease(&s_running, 1);
+    Log::setLogMessageHandler(&asyncMessageHandler);
+    return 0;
+}
+
+void AsyncLog::stop()
+{
+    if (!isRunning()) {
+        return;                                                       // RETURN
+    }
+
+    Log::setLogMessageHandler(s_previousHandler);
+    AtomicOps::setIntRelease(&s_running, 0);
+
+    AtomicOps::setInt(&s_stopRequested, 1);
+    AtomicOps::setInt(&s_consumerIdle, 0);
+    WaitUtil::wakeOne(&s_consumerIdle);
+
+#if defined(BSLS_PLATFORM_OS_WINDOWS)
+    WaitForSingleObject(s_thread, INFINITE);
+    CloseHandle(s_thread);
+#else
+    pthread_join(s_thread, 0);
+#endif
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
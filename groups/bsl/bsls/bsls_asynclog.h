@@ -0,0 +1,227 @@
+// bsls_asynclog.h                                                    -*-C++-*-
+#ifndef INCLUDED_BSLS_ASYNCLOG
+#define INCLUDED_BSLS_ASYNCLOG
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a non-blocking, asynchronous log message handler.
+//
+//@CLASSES:
+//  bsls::AsyncLog: namespace for the asynchronous log message handler
+//
+//@SEE_ALSO: bsls_log, bsls_waitutil
+//
+//@DESCRIPTION: This component provides a namespace, 'bsls::AsyncLog', for a
+// 'bsls::Log' message handler, 'bsls::AsyncLog::asyncMessageHandler', that
+// does not write the messages it is passed, but copies them into a bounded
+// queue, from which a background thread (started by 'bsls::AsyncLog::start')
+// passes them to another, "downstream", log message handler.  A thread
+// logging a message therefore never blocks on the destination of the message
+// (e.g., on a slow pipe or disk behind 'stderr'), so that low-level logging
+// can be used in latency-sensitive code.
+//
+///Queueing and Dropping Records
+///-----------------------------
+// The queue is a lock-free ring buffer of 'k_CAPACITY' records, written by any
+// number of threads and read by the background thread.  Each record holds a
+// copy of the file name (truncated to 'k_MAX_FILE_LENGTH' characters) and of
+// the message (truncated to 'k_MAX_MESSAGE_LENGTH' characters) it was passed,
+// and its line number.  Queueing a record costs a few atomic operations and
+// the copy of the strings; a thread queueing a record makes a system call
+// (to wake the background thread) only if the background thread was idle.
+//
+// If the queue is full (i.e., the downstream handler does not keep up with the
+// logging threads), the record is *dropped*: it is counted (see
+// 'numDropped'), and the logging thread returns immediately.  The background
+// thread reports the number of records dropped since its last report, as a
+// message of its own, to the downstream handler each time it empties the
+// queue.
+//
+///Rate Limiting
+///-------------
+// 'start' optionally takes a maximum number of records that each call site
+// (i.e., each file name and line number) may queue in each interval of a
+// given duration, starting with the first record the site queues.  Records
+// logged by a call site beyond this limit are dropped and counted (see
+// 'numRateLimited'), so that a single call site logging in a loop cannot
+// crowd the other sites out of the queue.  The call sites are tracked in a
+// fixed table of 'k_NUM_RATE_LIMITED_SITES' entries, indexed by a hash of the
+// address of the file name and of the line number: the limit is therefore
+// shared by sites hashing to the same entry, and applies to the file name
+// *address* (two translation units logging with equal file names at the same
+// line are distinct sites).
+//
+///Starting and Stopping
+///---------------------
+// 'start' starts the background thread and installs 'asyncMessageHandler' as
+// the 'bsls::Log' message handler; 'stop' restores the handler installed
+// before 'start', writes the records remaining in the queue, and joins the
+// background thread.  Records queued concurrently with 'stop' by threads
+// that retrieved the handler before it was restored may remain in the queue
+// until the next call to 'start'.  While the background thread is not
+// running, 'asyncMessageHandler' passes the messages it is given to the
+// downstream handler (synchronously).
+//
+// 'flush' blocks until all the records queued before the call have been
+// passed to the downstream handler, which is useful, e.g., before exiting a
+// process or before reading the destination of the messages.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Logging from a Latency-Sensitive Thread
+/// - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a thread processing orders logs unusual conditions with
+// 'BSLS_LOG', and that we want to make sure that the thread is not blocked
+// when 'stderr' is slow to drain.
+//
+// First, on startup, we start the asynchronous handler, passing the messages
+// to the default handler of 'bsls::Log', and allowing each call site to log
+// at most 10 messages each second:
+//..
+//  int rc = bsls::AsyncLog::start(&bsls::Log::platformDefaultMessageHandler,
+//                                 10,
+//                                 1000);
+//  assert(0 == rc);
+//..
+// Then, the thread processing orders logs as usual; the messages are written
+// to 'stderr' by the background thread:
+//..
+//  for (int i = 0; i < 100; ++i) {
+//      BSLS_LOG("Order %d rejected", i);
+//  }
+//..
+// Next, we wait for the messages logged so far to be written:
+//..
+//  bsls::AsyncLog::flush();
+//..
+// Now, we verify that the call site was limited to 10 messages:
+//..
+//  assert(90 == bsls::AsyncLog::numRateLimited());
+//..
+// Finally, on shutdown, we stop the asynchronous handler, which writes the
+// remaining messages and restores the previous handler:
+//..
+//  bsls::AsyncLog::stop();
+//..
+
+#ifndef INCLUDED_BSLS_LOG
+#include <bsls_log.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bsls {
+
+                               // ==============
+                               // class AsyncLog
+                               // ==============
+
+class AsyncLog {
+    // This class provides a namespace for a log message handler queueing the
+    // messages it is passed, and for starting and stopping the thread writing
+    // the queued messages.
+
+  public:
+    // TYPES
+    enum {
+        k_CAPACITY               = 512,  // number of records in the queue
+
+        k_MAX_FILE_LENGTH        = 127,  // maximum number of characters of
+                                         // a queued file name
+
+        k_MAX_MESSAGE_LENGTH     = 383,  // maximum number of characters of
+                                         // a queued message
+
+        k_NUM_RATE_LIMITED_SITES = 256   // number of entries of the table of
+                                         // rate-limited call sites
+    };
+
+    // CLASS METHODS
+    static void asyncMessageHandler(const char *file,
+                                    int         line,
+                                    const char *message);
+        // Queue a record holding the specified 'file', 'line', and 'message'
+        // (truncating 'file' and 'message' if needed) for the background
+        // thread to pass to the downstream handler, if the background thread
+        // is running, the call site is within its rate limit, and the queue
+        // is not full; otherwise, count the record as dropped or rate-limited.
+        // If the background thread is not running, invoke the downstream
+        // handler (or, if 'start' was never called,
+        // 'bsls::Log::platformDefaultMessageHandler') with 'file', 'line', and
+        // 'message' instead.  This function does not block.  The behavior is
+        // undefined unless 'file' and 'message' are null-terminated strings
+        // and '0 <= line'.
+
+    static void flush();
+        // Block until all the records queued before this call have been
+        // passed to the downstream handler.  Return immediately if the
+        // background thread is not running.
+
+    static bool isRunning();
+        // Return 'true' if the background thread is running, and 'false'
+        // otherwise.
+
+    static Types::Int64 numDropped();
+        // Return the number of records dropped because the queue was full.
+
+    static Types::Int64 numRateLimited();
+        // Return the number of records dropped because their call site
+        // exceeded its rate limit.
+
+    static Types::Int64 numWritten();
+        // Return the number of queued records passed to the downstream
+        // handler.
+
+    static int start(Log::LogMessageHandler downstreamHandler,
+                     int                    maxRecordsPerSite = 0,
+                     int                    intervalMilliseconds = 1000);
+        // Start the background thread passing queued records to the specified
+        // 'downstreamHandler', and install 'asyncMessageHandler' as the
+        // 'bsls::Log' message handler.  Optionally specify
+        // 'maxRecordsPerSite', the maximum number of records each call site
+        // may queue in each interval of the optionally specified
+        // 'intervalMilliseconds'.  If 'maxRecordsPerSite' is 0 or not
+        // specified, the records are not rate-limited; if
+        // 'intervalMilliseconds' is not specified, intervals last a second.
+        // Return 0 on success, and a non-zero value (with no effect) if the
+        // background thread is already running or cannot be created.  The
+        // behavior is undefined unless 'downstreamHandler' is not
+        // 'asyncMessageHandler', '0 <= maxRecordsPerSite', and
+        // '0 < intervalMilliseconds'.  Note that 'start' and 'stop' must not
+        // be called concurrently.
+
+    static void stop();
+        // Restore the 'bsls::Log' message handler installed before the last
+        // call to 'start', and stop the background thread after it passes
+        // the records remaining in the queue to the downstream handler.  This
+        // function has no effect if the background thread is not running.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,726 @@
+// bsls_asynclog.t.cpp                                                -*-C++-*-
+
+#include <bsls_asynclog.h>
+
+#include <bsls_atomic.h>         // for testing only
+#include <bsls_bsltestutil.h>    // for testing only
+#include <bsls_log.h>            // for testing only
+#include <bsls_platform.h>       // for testing only
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+using namespace BloombergLP;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides a log message handler queueing the
+// records it is passed for a background thread to pass to a downstream
+// handler.  The tests install a downstream handler recording the records it
+// is passed, and verify that the records are passed in order and unchanged
+// (but truncated), that records beyond the capacity of the queue and beyond
+// the rate limit of a call site are dropped and counted, and that the counts
+// add up when several threads log concurrently.  The downstream handler can
+// be blocked, to fill the queue deterministically.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] void asyncMessageHandler(const char *, int, const char *);
+// [ 3] void flush();
+// [ 3] bool isRunning();
+// [ 5] Types::Int64 numDropped();
+// [ 4] Types::Int64 numRateLimited();
+// [ 3] Types::Int64 numWritten();
+// [ 3] int start(Log::LogMessageHandler, int = 0, int = 1000);
+// [ 3] void stop();
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] CONCURRENCY TEST
+// [ 7] USAGE EXAMPLE
+
+// ============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+typedef bsls::AsyncLog Obj;
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+void sleepMilliseconds(int milliseconds)
+    // Suspend the calling thread for the specified 'milliseconds'.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    Sleep(milliseconds);
+#else
+    usleep(milliseconds * 1000);
+#endif
+}
+
+
+enum { k_MAX_RECORDS = 2 * Obj::k_CAPACITY };
+
+static const char *const k_FILE = "producer.cpp";
+
+static int              g_lines[k_MAX_RECORDS];
+static char             g_files[k_MAX_RECORDS][Obj::k_MAX_FILE_LENGTH + 2];
+static char             g_messages[k_MAX_RECORDS]
+                                  [Obj::k_MAX_MESSAGE_LENGTH + 2];
+static bsls::AtomicInt  g_numRecords(0);
+static bsls::AtomicInt  g_numReports(0);
+static bsls::AtomicInt  g_gate(1);
+static bsls::AtomicInt  g_numBlocked(0);
+
+static
+void recordMessage(const char *file, int line, const char *message)
+    // Record the specified 'file', 'line', and 'message' (unless they report
+    // dropped records, or 'k_MAX_RECORDS' records were recorded), first
+    // blocking, if 'g_gate' is 0, until it is set to 1.
+{
+    if (0 == g_gate) {
+        ++g_numBlocked;
+        g_numBlocked.notifyAll();
+        g_gate.wait(0);
+    }
+
+    if (strstr(message, "bsls::AsyncLog dropped")) {
+        ++g_numReports;
+        return;                                                       // RETURN
+    }
+
+    const int index = g_numRecords;
+    if (index < k_MAX_RECORDS) {
+        g_lines[index] = line;
+        strncpy(g_files[index], file, sizeof g_files[index] - 1);
+        strncpy(g_messages[index], message, sizeof g_messages[index] - 1);
+    }
+    g_numRecords = index + 1;
+}
+
+struct ProducerArgs {
+    // This 'struct' holds the arguments of 'producerThread'.
+
+    int d_id;            // identifies the messages of the thread
+    int d_numMessages;   // number of messages to log
+};
+
+extern "C"
+void *producerThread(void *arg)
+    // Log, through 'bsls::AsyncLog::asyncMessageHandler', the number of
+    // messages specified by the 'ProducerArgs' at the specified 'arg', each
+    // made of the identifier of the thread and of the index of the message.
+{
+    const ProducerArgs *args = static_cast<const ProducerArgs *>(arg);
+
+    char message[32];
+    for (int i = 0; i < args->d_numMessages; ++i) {
+        sprintf(message, "%d %d", args->d_id, i);
+        Obj::asyncMessageHandler(k_FILE, args->d_id, message);
+    }
+    return 0;
+}
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Logging from a Latency-Sensitive Thread
+/// - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a thread processing orders logs unusual conditions with
+// 'BSLS_LOG', and that we want to make sure that the thread is not blocked
+// when 'stderr' is slow to drain.
+//
+// First, on startup, we start the asynchronous handler, passing the messages
+// to the default handler of 'bsls::Log', and allowing each call site to log
+// at most 10 messages each second:
+//..
+    int rc = bsls::AsyncLog::start(&bsls::Log::platformDefaultMessageHandler,
+                                   10,
+                                   1000);
+    ASSERT(0 == rc);
+//..
+// Then, the thread processing orders logs as usual; the messages are written
+// to 'stderr' by the background thread:
+//..
+    for (int i = 0; i < 100; ++i) {
+        BSLS_LOG("Order %d rejected", i);
+    }
+//..
+// Next, we wait for the messages logged so far to be written:
+//..
+    bsls::AsyncLog::flush();
+//..
+// Now, we verify that the call site was limited to 10 messages:
+//..
+    ASSERT(90 == bsls::AsyncLog::numRateLimited());
+//..
+// Finally, on shutdown, we stop the asynchronous handler, which writes the
+// remaining messages and restores the previous handler:
+//..
+    bsls::AsyncLog::stop();
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY TEST
+        //
+        // Concerns:
+        //: 1 Each record logged concurrently by several threads is either
+        //:   passed to the downstream handler, or counted as dropped.
+        //:
+        //: 2 The records of each thread are passed to the downstream handler
+        //:   in the order they were logged, and unchanged.
+        //
+        // Plan:
+        //: 1 Start several threads, each logging a sequence of numbered
+        //:   messages, and verify, after joining the threads and flushing,
+        //:   that the numbers of records written and dropped add up to the
+        //:   number of records logged, and that the numbers of each thread
+        //:   are increasing.  (C-1..2)
+        //
+        // Testing:
+        //   CONCURRENCY TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCONCURRENCY TEST"
+                            "\n================\n");
+
+        enum { k_NUM_THREADS = 4, k_NUM_MESSAGES = 5000 };
+
+        ASSERT(0 == Obj::start(&recordMessage));
+
+        ProducerArgs args[k_NUM_THREADS];
+        ThreadId     threads[k_NUM_THREADS];
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            args[i].d_id          = i;
+            args[i].d_numMessages = k_NUM_MESSAGES;
+            threads[i] = createThread(&producerThread, &args[i]);
+        }
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            joinThread(threads[i]);
+        }
+
+        Obj::flush();
+
+        const bsls::Types::Int64 numWritten = Obj::numWritten();
+        const bsls::Types::Int64 numDropped = Obj::numDropped();
+
+        if (veryVerbose) { P_(numWritten) P(numDropped) }
+
+        ASSERTV(numWritten, numDropped,
+                k_NUM_THREADS * k_NUM_MESSAGES == numWritten + numDropped);
+        ASSERTV(numWritten, g_numRecords, numWritten == g_numRecords);
+        ASSERT(0 == Obj::numRateLimited());
+
+        // Only the first 'k_MAX_RECORDS' records are kept.
+
+        int next[k_NUM_THREADS] = { 0 };
+        for (int i = 0; i < g_numRecords && i < k_MAX_RECORDS; ++i) {
+            int id;
+            int index;
+            ASSERTV(i, 2 == sscanf(g_messages[i], "%d %d", &id, &index));
+            ASSERTV(i, 0 <= id && id < k_NUM_THREADS);
+            if (0 <= id && id < k_NUM_THREADS) {
+                ASSERTV(i, id, g_lines[i], id == g_lines[i]);
+                ASSERTV(i, id, next[id], index, next[id] <= index);
+                next[id] = index + 1;
+            }
+            ASSERTV(i, 0 == strcmp(k_FILE, g_files[i]));
+        }
+
+        Obj::stop();
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // QUEUE CAPACITY
+        //
+        // Concerns:
+        //: 1 The queue holds 'k_CAPACITY' records.
+        //:
+        //: 2 The records logged while the queue is full are dropped, counted,
+        //:   and logging them does not block.
+        //:
+        //: 3 The number of records dropped is reported to the downstream
+        //:   handler once the queue is emptied.
+        //:
+        //: 4 The records queued before the queue was full are written.
+        //
+        // Plan:
+        //: 1 Block the downstream handler, and log 'k_CAPACITY' records plus
+        //:   a few more; verify the number of dropped records.  (C-1..2)
+        //:
+        //: 2 Unblock the downstream handler, flush, and verify the records
+        //:   passed to the downstream handler, and that a report was passed.
+        //:   (C-3..4)
+        //
+        // Testing:
+        //   Types::Int64 numDropped();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nQUEUE CAPACITY"
+                            "\n==============\n");
+
+        enum { k_NUM_EXTRA = 10 };
+
+        g_gate = 0;
+        ASSERT(0 == Obj::start(&recordMessage));
+
+        char message[32];
+        for (int i = 0; i < Obj::k_CAPACITY + k_NUM_EXTRA; ++i) {
+            sprintf(message, "%d", i);
+            Obj::asyncMessageHandler(k_FILE, i, message);
+
+            if (0 == i) {
+                // Wait for the background thread to block on the first
+                // record, which occupies the queue until it is written.
+
+                while (0 == g_numBlocked) {
+                    g_numBlocked.wait(0);
+                }
+            }
+        }
+
+        ASSERTV(Obj::numDropped(), k_NUM_EXTRA == Obj::numDropped());
+        ASSERT(0 == Obj::numWritten());
+        ASSERT(0 == g_numRecords);
+
+        g_gate = 1;
+        g_gate.notifyAll();
+
+        Obj::flush();
+
+        ASSERTV(Obj::numWritten(), Obj::k_CAPACITY == Obj::numWritten());
+        ASSERTV(g_numRecords, Obj::k_CAPACITY == g_numRecords);
+        for (int i = 0; i < g_numRecords; ++i) {
+            ASSERTV(i, g_lines[i], i == g_lines[i]);
+            ASSERTV(i, g_messages[i], i == atoi(g_messages[i]));
+        }
+
+        Obj::stop();
+
+        ASSERTV(g_numReports, 1 == g_numReports);
+        ASSERTV(Obj::numDropped(), k_NUM_EXTRA == Obj::numDropped());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // RATE LIMITING
+        //
+        // Concerns:
+        //: 1 Records are not rate-limited by default.
+        //:
+        //: 2 Each call site queues at most 'maxRecordsPerSite' records in an
+        //:   interval; the records beyond the limit are dropped and counted.
+        //:
+        //: 3 Distinct call sites are limited independently.
+        //:
+        //: 4 A call site may queue records again once its interval is over.
+        //:
+        //: 5 The number of rate-limited records is reported to the downstream
+        //:   handler.
+        //
+        // Plan:
+        //: 1 Start without a limit, log many records from one site, and
+        //:   verify that they are all written.  (C-1)
+        //:
+        //: 2 Start with a limit and a long interval, log more records than the
+        //:   limit from two sites, and verify the numbers of records written
+        //:   and rate-limited.  (C-2..3, 5)
+        //:
+        //: 3 Start with a limit and a short interval, log more records than
+        //:   the limit, wait for the interval to end, and log again.  (C-4)
+        //
+        // Testing:
+        //   Types::Int64 numRateLimited();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nRATE LIMITING"
+                            "\n=============\n");
+
+        if (verbose) printf("\tNo limit.\n");
+        {
+            ASSERT(0 == Obj::start(&recordMessage));
+            for (int i = 0; i < 100; ++i) {
+                Obj::asyncMessageHandler(k_FILE, 1, "unlimited");
+            }
+            Obj::flush();
+            Obj::stop();
+
+            ASSERTV(g_numRecords, 100 == g_numRecords);
+            ASSERT(0 == Obj::numRateLimited());
+            ASSERT(0 == g_numReports);
+        }
+
+        if (verbose) printf("\tLimit per site.\n");
+        {
+            g_numRecords = 0;
+            ASSERT(0 == Obj::start(&recordMessage, 3, 1000 * 1000));
+            for (int i = 0; i < 10; ++i) {
+                Obj::asyncMessageHandler(k_FILE, 2, "site A");
+                Obj::asyncMessageHandler(k_FILE, 3, "site B");
+            }
+            Obj::flush();
+
+            ASSERTV(g_numRecords, 6 == g_numRecords);
+            ASSERTV(Obj::numRateLimited(), 14 == Obj::numRateLimited());
+
+            int numA = 0;
+            for (int i = 0; i < g_numRecords; ++i) {
+                numA += 2 == g_lines[i];
+            }
+            ASSERTV(numA, 3 == numA);
+
+            Obj::stop();
+
+            // The drops may be reported in several messages.
+
+            ASSERTV(g_numReports, 1 <= g_numReports);
+        }
+
+        if (verbose) printf("\tEnd of interval.\n");
+        {
+            g_numRecords = 0;
+            ASSERT(0 == Obj::start(&recordMessage, 2, 50));
+            for (int i = 0; i < 5; ++i) {
+                Obj::asyncMessageHandler(k_FILE, 4, "site C");
+            }
+            sleepMilliseconds(200);
+            for (int i = 0; i < 5; ++i) {
+                Obj::asyncMessageHandler(k_FILE, 4, "site C");
+            }
+            Obj::flush();
+            Obj::stop();
+
+            ASSERTV(g_numRecords, 4 == g_numRecords);
+            ASSERTV(Obj::numRateLimited(), 20 == Obj::numRateLimited());
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // START, STOP, AND FLUSH
+        //
+        // Concerns:
+        //: 1 'start' installs 'asyncMessageHandler' as the 'bsls::Log'
+        //:   handler, and fails if the background thread is already running.
+        //:
+        //: 2 The records logged are passed to the downstream handler, in
+        //:   order, by the time 'flush' returns.
+        //:
+        //: 3 The file names and messages are truncated to their maximum
+        //:   lengths.
+        //:
+        //: 4 'stop' restores the previous handler, and writes the records
+        //:   remaining in the queue.
+        //:
+        //: 5 The background thread can be started again after 'stop'.
+        //
+        // Plan:
+        //: 1 Start the background thread, log with 'BSLS_LOG', flush, and
+        //:   verify the records passed to the downstream handler.  (C-1..2)
+        //:
+        //: 2 Log a record with a long file name and a long message, and verify
+        //:   the record passed to the downstream handler.  (C-3)
+        //:
+        //: 3 Log records, stop, and verify the records written.  Start and
+        //:   stop again.  (C-4..5)
+        //
+        // Testing:
+        //   void flush();
+        //   bool isRunning();
+        //   Types::Int64 numWritten();
+        //   int start(Log::LogMessageHandler, int = 0, int = 1000);
+        //   void stop();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nSTART, STOP, AND FLUSH"
+                            "\n======================\n");
+
+        bsls::Log::setLogMessageHandler(&recordMessage);
+
+        ASSERT(false == Obj::isRunning());
+        Obj::flush();  // no effect
+
+        ASSERT(0 == Obj::start(&recordMessage));
+        ASSERT(true  == Obj::isRunning());
+        ASSERT(&Obj::asyncMessageHandler == bsls::Log::logMessageHandler());
+        ASSERT(0 != Obj::start(&recordMessage));
+
+        if (verbose) printf("\tLogging and flushing.\n");
+
+        const int LINE = L_ + 2;
+        for (int i = 0; i < 10; ++i) {
+            BSLS_LOG("message %d", i);
+        }
+        Obj::flush();
+
+        ASSERTV(g_numRecords, 10 == g_numRecords);
+        ASSERT(10 == Obj::numWritten());
+        for (int i = 0; i < 10 && i < g_numRecords; ++i) {
+            char expected[32];
+            sprintf(expected, "message %d", i);
+
+            ASSERTV(i, g_messages[i], 0 == strcmp(expected, g_messages[i]));
+            ASSERTV(i, g_lines[i], LINE == g_lines[i]);
+            ASSERTV(i, g_files[i], 0 == strcmp(__FILE__, g_files[i]));
+        }
+
+        if (verbose) printf("\tTruncation.\n");
+
+        char longFile[Obj::k_MAX_FILE_LENGTH + 20];
+        memset(longFile, 'f', sizeof longFile - 1);
+        longFile[sizeof longFile - 1] = 0;
+
+        char longMessage[Obj::k_MAX_MESSAGE_LENGTH + 20];
+        memset(longMessage, 'm', sizeof longMessage - 1);
+        longMessage[sizeof longMessage - 1] = 0;
+
+        g_numRecords = 0;
+        Obj::asyncMessageHandler(longFile, 7, longMessage);
+        Obj::flush();
+
+        ASSERT(1 == g_numRecords);
+        ASSERTV(strlen(g_files[0]),
+                Obj::k_MAX_FILE_LENGTH == strlen(g_files[0]));
+        ASSERTV(strlen(g_messages[0]),
+                Obj::k_MAX_MESSAGE_LENGTH == strlen(g_messages[0]));
+        ASSERT(0 == strncmp(longFile, g_files[0], Obj::k_MAX_FILE_LENGTH));
+        ASSERT(0 == strncmp(longMessage,
+                            g_messages[0],
+                            Obj::k_MAX_MESSAGE_LENGTH));
+
+        if (verbose) printf("\tStopping.\n");
+
+        g_numRecords = 0;
+        for (int i = 0; i < 10; ++i) {
+            Obj::asyncMessageHandler(k_FILE, i, "before stop");
+        }
+        Obj::stop();
+
+        ASSERT(false == Obj::isRunning());
+        ASSERT(&recordMessage == bsls::Log::logMessageHandler());
+        ASSERTV(g_numRecords, 10 == g_numRecords);
+        ASSERT(21 == Obj::numWritten());
+        ASSERT(0 == Obj::numDropped());
+        ASSERT(0 == g_numReports);
+
+        Obj::stop();  // no effect
+
+        if (verbose) printf("\tRestarting.\n");
+
+        g_numRecords = 0;
+        ASSERT(0 == Obj::start(&recordMessage));
+        Obj::asyncMessageHandler(k_FILE, 1, "restarted");
+        Obj::stop();
+
+        ASSERT(1 == g_numRecords);
+        ASSERT(22 == Obj::numWritten());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // SYNCHRONOUS HANDLING
+        //
+        // Concerns:
+        //: 1 While the background thread is not running,
+        //:   'asyncMessageHandler' passes its arguments, unchanged, to the
+        //:   downstream handler before returning.
+        //
+        // Plan:
+        //: 1 Start and stop the background thread, then call
+        //:   'asyncMessageHandler' and verify that the downstream handler was
+        //:   called with the same arguments, without truncation.  (C-1)
+        //
+        // Testing:
+        //   void asyncMessageHandler(const char *, int, const char *);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nSYNCHRONOUS HANDLING"
+                            "\n====================\n");
+
+        ASSERT(0 == Obj::start(&recordMessage));
+        Obj::stop();
+
+        char longMessage[Obj::k_MAX_MESSAGE_LENGTH + 2];
+        memset(longMessage, 'm', sizeof longMessage - 1);
+        longMessage[sizeof longMessage - 1] = 0;
+
+        Obj::asyncMessageHandler(k_FILE, 42, longMessage);
+
+        ASSERT(1 == g_numRecords);
+        ASSERT(42 == g_lines[0]);
+        ASSERT(0 == strcmp(k_FILE, g_files[0]));
+        ASSERT(0 == strcmp(longMessage, g_messages[0]));
+        ASSERT(0 == Obj::numWritten());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The component is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Start the background thread, log a record, flush, and stop.
+        //:   (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        ASSERT(0 == Obj::start(&recordMessage));
+        ASSERT(Obj::isRunning());
+
+        BSLS_LOG_SIMPLE("hello");
+        Obj::flush();
+
+        ASSERT(1 == g_numRecords);
+        ASSERT(0 == strcmp("hello", g_messages[0]));
+        ASSERT(1 == Obj::numWritten());
+
+        Obj::stop();
+        ASSERT(!Obj::isRunning());
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -14,7 +14,7 @@ BSLS_IDENT("$Id: $")
 //  bsls::AtomicInt64: atomic 64-bit integer types
 //  bsls::AtomicPointer: parameterized atomic pointer type
 //
-//@SEE_ALSO: bsls_atomicoperations
+//@SEE_ALSO: bsls_atomicoperations, bsls_waitutil
 //
 //@DESCRIPTION: This component provides classes with atomic operations for
 // 'int', 'Int64', and pointer types.  These classes are based on atomic
@@ -25,6 +25,11 @@ BSLS_IDENT("$Id: $")
 // represents the atomic pointer type, and provides atomic operations to
 // manipulate and dereference a pointer.
 //
+// In addition, a thread can block until the value of a 'bsls::AtomicInt'
+// changes, using 'wait', provided the thread changing the value calls
+// 'notifyOne' or 'notifyAll'.  A thread blocked in 'wait' consumes no CPU
+// (on Linux, it waits on a 'futex'); see 'bsls_waitutil'.
+//
 ///Memory Order and Consistency Guarantees of Atomic Operations
 ///------------------------------------------------------------
 // Atomic operations provided by this component ensure various memory ordering
@@ -671,6 +676,10 @@ BSLS_IDENT("$Id: $")
 #include <bsls_types.h>
 #endif
 
+#ifndef INCLUDED_BSLS_WAITUTIL
+#include <bsls_waitutil.h>
+#endif
+
 namespace BloombergLP {
 
 namespace bsls {
@@ -783,6 +792,44 @@ class AtomicInt {
         // atomically and it provides the acquire/release memory ordering
         // guarantee.
 
+    int fetchAnd(int mask);
+        // Atomically set the value of this object to the bitwise "and" of its
+        // value and the specified 'mask', and return its previous value.
+
+    int fetchAndAcqRel(int mask);
+        // Atomically set the value of this object to the bitwise "and" of its
+        // value and the specified 'mask', and return its previous value,
+        // providing the acquire/release memory ordering guarantee.
+
+    int fetchOr(int mask);
+        // Atomically set the value of this object to the bitwise "or" of its
+        // value and the specified 'mask', and return its previous value.
+
+    int fetchOrAcqRel(int mask);
+        // Atomically set the value of this object to the bitwise "or" of its
+        // value and the specified 'mask', and return its previous value,
+        // providing the acquire/release memory ordering guarantee.
+
+    int fetchXor(int mask);
+        // Atomically set the value of this object to the bitwise "exclusive
+        // or" of its value and the specified 'mask', and return its previous
+        // value.
+
+    int fetchXorAcqRel(int mask);
+        // Atomically set the value of this object to the bitwise "exclusive
+        // or" of its value and the specified 'mask', and return its previous
+        // value, providing the acquire/release memory ordering guarantee.
+
+    void notifyAll();
+        // Wake all of the threads blocked in 'wait' on this object.  Note that
+        // the value of this object is expected to have been changed before
+        // this call.
+
+    void notifyOne();
+        // Wake one of the threads blocked in 'wait' on this object, if any.
+        // Note that the value of this object is expected to have been changed
+        // before this call.
+
     // ACCESSORS
     operator int() const;
         // Return the current value of this object.
@@ -797,6 +844,15 @@ class AtomicInt {
     int loadAcquire() const;
         // Return the current value of this object, providing the acquire
         // memory ordering guarantee.
+
+    void wait(int value) const;
+        // Block the calling thread until the value of this object is observed
+        // to differ from the specified 'value', providing the acquire memory
+        // ordering guarantee.  Return immediately if the value of this object
+        // differs from 'value' at the time of the call.  Note that a blocked
+        // thread is guaranteed to be woken only if the value of this object is
+        // changed and then 'notifyOne' or 'notifyAll' is called; a change of
+        // value without notification may leave it blocked indefinitely.
 };
 
                               // =================
@@ -910,6 +966,34 @@ class AtomicInt64 {
         // atomically and it provides the acquire/release memory ordering
         // guarantee.
 
+    Types::Int64 fetchAnd(Types::Int64 mask);
+        // Atomically set the value of this object to the bitwise "and" of its
+        // value and the specified 'mask', and return its previous value.
+
+    Types::Int64 fetchAndAcqRel(Types::Int64 mask);
+        // Atomically set the value of this object to the bitwise "and" of its
+        // value and the specified 'mask', and return its previous value,
+        // providing the acquire/release memory ordering guarantee.
+
+    Types::Int64 fetchOr(Types::Int64 mask);
+        // Atomically set the value of this object to the bitwise "or" of its
+        // value and the specified 'mask', and return its previous value.
+
+    Types::Int64 fetchOrAcqRel(Types::Int64 mask);
+        // Atomically set the value of this object to the bitwise "or" of its
+        // value and the specified 'mask', and return its previous value,
+        // providing the acquire/release memory ordering guarantee.
+
+    Types::Int64 fetchXor(Types::Int64 mask);
+        // Atomically set the value of this object to the bitwise "exclusive
+        // or" of its value and the specified 'mask', and return its previous
+        // value.
+
+    Types::Int64 fetchXorAcqRel(Types::Int64 mask);
+        // Atomically set the value of this object to the bitwise "exclusive
+        // or" of its value and the specified 'mask', and return its previous
+        // value, providing the acquire/release memory ordering guarantee.
+
     // ACCESSORS
     operator Types::Int64() const;
         // Return the current value of this object.
@@ -1166,6 +1250,54 @@ int AtomicInt::testAndSwapAcqRel(int compareValue, int swapValue)
                                                       swapValue);
 }
 
+inline
+int AtomicInt::fetchAnd(int mask)
+{
+    return AtomicOperations_Imp::fetchAndInt(&d_value, mask);
+}
+
+inline
+int AtomicInt::fetchAndAcqRel(int mask)
+{
+    return AtomicOperations_Imp::fetchAndIntAcqRel(&d_value, mask);
+}
+
+inline
+int AtomicInt::fetchOr(int mask)
+{
+    return AtomicOperations_Imp::fetchOrInt(&d_value, mask);
+}
+
+inline
+int AtomicInt::fetchOrAcqRel(int mask)
+{
+    return AtomicOperations_Imp::fetchOrIntAcqRel(&d_value, mask);
+}
+
+inline
+int AtomicInt::fetchXor(int mask)
+{
+    return AtomicOperations_Imp::fetchXorInt(&d_value, mask);
+}
+
+inline
+int AtomicInt::fetchXorAcqRel(int mask)
+{
+    return AtomicOperations_Imp::fetchXorIntAcqRel(&d_value, mask);
+}
+
+inline
+void AtomicInt::notifyAll()
+{
+    WaitUtil::wakeAll(&d_value);
+}
+
+inline
+void AtomicInt::notifyOne()
+{
+    WaitUtil::wakeOne(&d_value);
+}
+
 // ACCESSORS
 
 inline
@@ -1192,6 +1324,16 @@ int AtomicInt::loadAcquire() const
     return AtomicOperations_Imp::getIntAcquire(&d_value);
 }
 
+inline
+void AtomicInt::wait(int value) const
+{
+    while (value == loadAcquire()) {
+        WaitUtil::wait(const_cast<AtomicOperations::AtomicTypes::Int *>(
+                                                                    &d_value),
+                       value);
+    }
+}
+
                               // -----------------
                               // class AtomicInt64
                               // -----------------
@@ -1315,6 +1457,42 @@ AtomicInt64::testAndSwapAcqRel(Types::Int64 compareValue,
                                                         swapValue);
 }
 
+inline
+Types::Int64 AtomicInt64::fetchAnd(Types::Int64 mask)
+{
+    return AtomicOperations_Imp::fetchAndInt64(&d_value, mask);
+}
+
+inline
+Types::Int64 AtomicInt64::fetchAndAcqRel(Types::Int64 mask)
+{
+    return AtomicOperations_Imp::fetchAndInt64AcqRel(&d_value, mask);
+}
+
+inline
+Types::Int64 AtomicInt64::fetchOr(Types::Int64 mask)
+{
+    return AtomicOperations_Imp::fetchOrInt64(&d_value, mask);
+}
+
+inline
+Types::Int64 AtomicInt64::fetchOrAcqRel(Types::Int64 mask)
+{
+    return AtomicOperations_Imp::fetchOrInt64AcqRel(&d_value, mask);
+}
+
+inline
+Types::Int64 AtomicInt64::fetchXor(Types::Int64 mask)
+{
+    return AtomicOperations_Imp::fetchXorInt64(&d_value, mask);
+}
+
+inline
+Types::Int64 AtomicInt64::fetchXorAcqRel(Types::Int64 mask)
+{
+    return AtomicOperations_Imp::fetchXorInt64AcqRel(&d_value, mask);
+}
+
 // ACCESSORS
 inline
 AtomicInt64::operator Types::Int64() const
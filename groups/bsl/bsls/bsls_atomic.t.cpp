@@ -55,6 +55,15 @@ using namespace std;
 // [ 4] void operator +=(int value);
 // [ 4] void operator -=(int value);
 // [ 2] operator int() const;
+// [ 9] int fetchAnd(int mask);
+// [ 9] int fetchAndAcqRel(int mask);
+// [ 9] int fetchOr(int mask);
+// [ 9] int fetchOrAcqRel(int mask);
+// [ 9] int fetchXor(int mask);
+// [ 9] int fetchXorAcqRel(int mask);
+// [10] void notifyAll();
+// [10] void notifyOne();
+// [10] void wait(int value) const;
 //
 // bsls::AtomicInt64
 // -----------------
@@ -74,6 +83,12 @@ using namespace std;
 // [ 4] void operator +=(bsls::Types::Int64 value);
 // [ 4] void operator -=(bsls::Types::Int64 value);
 // [ 2] operator bsls::Types::Int64() const;
+// [ 9] bsls::Types::Int64 fetchAnd(bsls::Types::Int64 mask);
+// [ 9] bsls::Types::Int64 fetchAndAcqRel(bsls::Types::Int64 mask);
+// [ 9] bsls::Types::Int64 fetchOr(bsls::Types::Int64 mask);
+// [ 9] bsls::Types::Int64 fetchOrAcqRel(bsls::Types::Int64 mask);
+// [ 9] bsls::Types::Int64 fetchXor(bsls::Types::Int64 mask);
+// [ 9] bsls::Types::Int64 fetchXorAcqRel(bsls::Types::Int64 mask);
 //
 // bsls::AtomicPointer
 // -------------------
@@ -91,7 +106,7 @@ using namespace std;
 //
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 8] USAGE EXAMPLE
+// [11] USAGE EXAMPLE
 //-----------------------------------------------------------------------------
 
 //=============================================================================
@@ -590,6 +605,44 @@ void testCaseSharedPtr(int iterations)
     joinThread(thrWriter);
 }
 
+struct PingPongThreadParam
+{
+    bsls::AtomicInt *d_turn_p;      // counter incremented in turn
+    int              d_parity;      // 0 or 1 - parity of this thread's turns
+    int              d_iterations;  // number of turns of this thread
+};
+
+void *pingPongThreadFunc(void *arg)
+    // Take the specified number of turns, incrementing the counter of the
+    // 'PingPongThreadParam' object addressed by the specified 'arg' each time
+    // its parity matches that of this thread, and waiting (using 'wait') for
+    // the other thread to take its turn otherwise.
+{
+    PingPongThreadParam *param = reinterpret_cast<PingPongThreadParam *>(arg);
+
+    for (int i = 0; i < param->d_iterations; ++i) {
+        const int turn = 2 * i + param->d_parity;
+        int       value;
+        while (turn != (value = param->d_turn_p->loadAcquire())) {
+            param->d_turn_p->wait(value);
+        }
+        param->d_turn_p->addAcqRel(1);
+        param->d_turn_p->notifyOne();
+    }
+    return 0;
+}
+
+void *waitForNonZeroThreadFunc(void *arg)
+    // Wait (using 'wait') until the 'bsls::AtomicInt' addressed by the
+    // specified 'arg' is non-zero, and increment it.
+{
+    bsls::AtomicInt *value = reinterpret_cast<bsls::AtomicInt *>(arg);
+
+    value->wait(0);
+    ++*value;
+    return 0;
+}
+
 }  // close unnamed namespace
 
 //=============================================================================
@@ -1123,7 +1176,7 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
-      case 9: {
+      case 11: {
         // TESTING USAGE Examples
         //
         // Plan:
@@ -1136,6 +1189,224 @@ int main(int argc, char *argv[])
             my_CountedHandle<double> handle(NULL);
         }
       } break;
+      case 10: {
+        // --------------------------------------------------------------------
+        // TESTING 'wait', 'notifyOne', AND 'notifyAll'
+        //
+        // Concerns:
+        //: 1 'wait' returns immediately if the value differs from its
+        //:   argument.
+        //:
+        //: 2 'wait' blocks until the value changes and 'notifyOne' or
+        //:   'notifyAll' is called, and then returns.
+        //:
+        //: 3 'notifyAll' wakes every waiting thread.
+        //:
+        //: 4 'notifyOne' and 'notifyAll' with no waiting thread have no
+        //:   effect.
+        //
+        // Plan:
+        //: 1 Call 'wait' with a value different from that of the object, and
+        //:   verify that it returns.  Call 'notifyOne' and 'notifyAll' on an
+        //:   object with no waiting thread.  (C-1, 4)
+        //:
+        //: 2 Create two threads that take turns incrementing a counter,
+        //:   using 'wait' and 'notifyOne' to wait for their turns, and verify
+        //:   the final value of the counter.  (C-2)
+        //:
+        //: 3 Create N threads waiting for an object to become non-zero, set
+        //:   it to 1, call 'notifyAll', and verify (after joining the threads)
+        //:   that each thread incremented the object.  (C-3)
+        //
+        // Testing:
+        //   void notifyAll();
+        //   void notifyOne();
+        //   void wait(int value) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTesting 'wait', 'notifyOne', and 'notifyAll'"
+                          << "\n============================================"
+                          << endl;
+
+        if (verbose) cout << "\nTesting without waiting threads" << endl;
+        {
+            AI mX(5);  const AI& X = mX;
+
+            X.wait(4);
+            X.wait(-5);
+            mX.notifyOne();
+            mX.notifyAll();
+            ASSERT(5 == X);
+        }
+
+        if (verbose) cout << "\nTesting 'wait' and 'notifyOne'" << endl;
+        {
+            enum { k_ITERATIONS = 2000 };
+
+            AI turn(0);
+
+            PingPongThreadParam params[2];
+            thread_t            threads[2];
+            for (int i = 0; i < 2; ++i) {
+                params[i].d_turn_p     = &turn;
+                params[i].d_parity     = i;
+                params[i].d_iterations = k_ITERATIONS;
+                threads[i] = createThread(&pingPongThreadFunc, &params[i]);
+            }
+            for (int i = 0; i < 2; ++i) {
+                joinThread(threads[i]);
+            }
+            LOOP_ASSERT(turn, 2 * k_ITERATIONS == turn);
+        }
+
+        if (verbose) cout << "\nTesting 'wait' and 'notifyAll'" << endl;
+        {
+            enum { k_NUM_THREADS = 4 };
+
+            AI value(0);
+
+            thread_t threads[k_NUM_THREADS];
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                threads[i] = createThread(&waitForNonZeroThreadFunc, &value);
+            }
+            sleepSeconds(1);
+
+            value = 1;
+            value.notifyAll();
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                joinThread(threads[i]);
+            }
+            LOOP_ASSERT(value, 1 + k_NUM_THREADS == value);
+        }
+      } break;
+      case 9: {
+        // --------------------------------------------------------------------
+        // TESTING BITWISE FETCH MANIPULATORS
+        //
+        // Concerns:
+        //: 1 Each of 'fetchAnd', 'fetchOr', and 'fetchXor' (and their
+        //:   acquire/release variants) of 'AtomicInt' and 'AtomicInt64'
+        //:   returns the previous value, and sets the value to the bitwise
+        //:   combination of that value and the mask.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, apply each manipulator to a set
+        //:   of initial values and masks, and verify the returned and
+        //:   resulting values.  (C-1)
+        //
+        // Testing:
+        //   int fetchAnd(int mask);
+        //   int fetchAndAcqRel(int mask);
+        //   int fetchOr(int mask);
+        //   int fetchOrAcqRel(int mask);
+        //   int fetchXor(int mask);
+        //   int fetchXorAcqRel(int mask);
+        //   bsls::Types::Int64 fetchAnd(bsls::Types::Int64 mask);
+        //   bsls::Types::Int64 fetchAndAcqRel(bsls::Types::Int64 mask);
+        //   bsls::Types::Int64 fetchOr(bsls::Types::Int64 mask);
+        //   bsls::Types::Int64 fetchOrAcqRel(bsls::Types::Int64 mask);
+        //   bsls::Types::Int64 fetchXor(bsls::Types::Int64 mask);
+        //   bsls::Types::Int64 fetchXorAcqRel(bsls::Types::Int64 mask);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTesting Bitwise Fetch Manipulators"
+                          << "\n=================================="
+                          << endl;
+
+        static const struct {
+            int   d_lineNum;  // source line number
+            Int64 d_value;    // initial value
+            Int64 d_mask;     // mask
+        } DATA[] = {
+            //LINE  VALUE                  MASK
+            //----  ---------------------  ---------------------
+            { L_,   0,                     0                     },
+            { L_,   0,                     -1                    },
+            { L_,   -1,                    0                     },
+            { L_,   -1,                    -1                    },
+            { L_,   0x0F0F,                0x00FF                },
+            { L_,   0x12345678,            0x0F0F0F0F            },
+            { L_,   0x123456789ABCDEFLL,   0x7FFFFFFF00000000LL  },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        if (verbose) cout << "\nTesting 'AtomicInt'" << endl;
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE  = DATA[ti].d_lineNum;
+            const int VALUE = static_cast<int>(DATA[ti].d_value);
+            const int MASK  = static_cast<int>(DATA[ti].d_mask);
+
+            {
+                AI mX(VALUE);  const AI& X = mX;
+                LOOP_ASSERT(LINE, VALUE == mX.fetchAnd(MASK));
+                LOOP_ASSERT(LINE, (VALUE & MASK) == X);
+            }
+            {
+                AI mX(VALUE);  const AI& X = mX;
+                LOOP_ASSERT(LINE, VALUE == mX.fetchAndAcqRel(MASK));
+                LOOP_ASSERT(LINE, (VALUE & MASK) == X);
+            }
+            {
+                AI mX(VALUE);  const AI& X = mX;
+                LOOP_ASSERT(LINE, VALUE == mX.fetchOr(MASK));
+                LOOP_ASSERT(LINE, (VALUE | MASK) == X);
+            }
+            {
+                AI mX(VALUE);  const AI& X = mX;
+                LOOP_ASSERT(LINE, VALUE == mX.fetchOrAcqRel(MASK));
+                LOOP_ASSERT(LINE, (VALUE | MASK) == X);
+            }
+            {
+                AI mX(VALUE);  const AI& X = mX;
+                LOOP_ASSERT(LINE, VALUE == mX.fetchXor(MASK));
+                LOOP_ASSERT(LINE, (VALUE ^ MASK) == X);
+            }
+            {
+                AI mX(VALUE);  const AI& X = mX;
+                LOOP_ASSERT(LINE, VALUE == mX.fetchXorAcqRel(MASK));
+                LOOP_ASSERT(LINE, (VALUE ^ MASK) == X);
+            }
+        }
+
+        if (verbose) cout << "\nTesting 'AtomicInt64'" << endl;
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int   LINE  = DATA[ti].d_lineNum;
+            const Int64 VALUE = DATA[ti].d_value;
+            const Int64 MASK  = DATA[ti].d_mask;
+
+            {
+                AI64 mX(VALUE);  const AI64& X = mX;
+                LOOP_ASSERT(LINE, VALUE == mX.fetchAnd(MASK));
+                LOOP_ASSERT(LINE, (VALUE & MASK) == X);
+            }
+            {
+                AI64 mX(VALUE);  const AI64& X = mX;
+                LOOP_ASSERT(LINE, VALUE == mX.fetchAndAcqRel(MASK));
+                LOOP_ASSERT(LINE, (VALUE & MASK) == X);
+            }
+            {
+                AI64 mX(VALUE);  const AI64& X = mX;
+                LOOP_ASSERT(LINE, VALUE == mX.fetchOr(MASK));
+                LOOP_ASSERT(LINE, (VALUE | MASK) == X);
+            }
+            {
+                AI64 mX(VALUE);  const AI64& X = mX;
+                LOOP_ASSERT(LINE, VALUE == mX.fetchOrAcqRel(MASK));
+                LOOP_ASSERT(LINE, (VALUE | MASK) == X);
+            }
+            {
+                AI64 mX(VALUE);  const AI64& X = mX;
+                LOOP_ASSERT(LINE, VALUE == mX.fetchXor(MASK));
+                LOOP_ASSERT(LINE, (VALUE ^ MASK) == X);
+            }
+            {
+                AI64 mX(VALUE);  const AI64& X = mX;
+                LOOP_ASSERT(LINE, VALUE == mX.fetchXorAcqRel(MASK));
+                LOOP_ASSERT(LINE, (VALUE ^ MASK) == X);
+            }
+        }
+      } break;
       case 8: {
         // --------------------------------------------------------------------
         // TESTING MEMORY ORDERING OF ATOMIC OPERATIONS USED IN SHARED POINTER
@@ -179,9 +179,10 @@ BSLS_IDENT("$Id: $")
 // The atomic integer operations provide thread-safe access for 32 or 64-bit
 // signed integer numbers without the use of higher level synchronization
 // mechanisms.  Atomic integers are most commonly used to manipulate shared
-// counters and indices.  Five types of operations are provided; get/set,
-// increment/decrement, add, swap, and test and swap.  Two sub-types of
-// manipulators are provided for increment/decrement and addition operations.
+// counters and indices.  Six types of operations are provided; get/set,
+// increment/decrement, add, swap, test and swap, and bitwise "fetch" (and,
+// or, and exclusive or).  Two sub-types of manipulators are provided for
+// increment/decrement and addition operations.
 //
 // 'bsls::AtomicOperations' functions whose names end in "Nv" (stands for "new
 // value"; e.g., 'addIntNv', 'incrementInt64Nv') return the resulting value of
@@ -191,12 +192,32 @@ BSLS_IDENT("$Id: $")
 // to determine the resulting value of an operation than to simply perform the
 // operation.
 //
+// The bitwise operations (e.g., 'fetchOrInt', 'fetchAndInt64AcqRel') apply a
+// mask to an atomic integer and return its *previous* value, so that a thread
+// can, for example, set a flag bit and learn whether it was already set with
+// a single atomic operation.  The operations map to single instructions (or
+// intrinsics) on platforms providing them, and to compare-and-swap loops
+// elsewhere.
+//
 ///Atomic Pointer Operations
 ///-------------------------
 // The atomic pointer operations provide thread-safe access to pointer values
 // without the use of higher level synchronization mechanisms.  They are
 // commonly used to create fast thread safe singly-linked lists.
 //
+///Atomic Double-Word Operations
+///-----------------------------
+// On platforms where the macro 'BSLS_ATOMICOPERATIONS_SUPPORT_DOUBLE_WORD' is
+// defined (currently, when compiling with gcc or clang for x86, x86-64, and
+// other platforms providing a 16-byte compare-and-swap), the type
+// 'AtomicTypes::DoubleWord' holds two pointer-sized words that can be
+// compared and swapped as a single atomic operation.  A pointer paired with a
+// "version" counter incremented on each update (a "tagged pointer") can thus
+// be replaced atomically, which avoids the "ABA problem" of lock-free data
+// structures, such as the list of Example 3, that reuse their nodes.  Note
+// that 'getDoubleWord' is implemented with a compare-and-swap, and therefore
+// writes to (and requires write access to) the double word.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -891,6 +912,40 @@ struct AtomicOperations {
         // Atomically decrement the value of the specified 'atomicInt' by 1,
         // providing the acquire/release memory ordering guarantee.
 
+    static int fetchAndInt(AtomicTypes::Int *atomicInt, int mask);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // "and" of its value and the specified 'mask', and return its previous
+        // value, providing the sequential consistency memory ordering
+        // guarantee.
+
+    static int fetchAndIntAcqRel(AtomicTypes::Int *atomicInt, int mask);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // "and" of its value and the specified 'mask', and return its previous
+        // value, providing the acquire/release memory ordering guarantee.
+
+    static int fetchOrInt(AtomicTypes::Int *atomicInt, int mask);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // "or" of its value and the specified 'mask', and return its previous
+        // value, providing the sequential consistency memory ordering
+        // guarantee.
+
+    static int fetchOrIntAcqRel(AtomicTypes::Int *atomicInt, int mask);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // "or" of its value and the specified 'mask', and return its previous
+        // value, providing the acquire/release memory ordering guarantee.
+
+    static int fetchXorInt(AtomicTypes::Int *atomicInt, int mask);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // "exclusive or" of its value and the specified 'mask', and return its
+        // previous value, providing the sequential consistency memory ordering
+        // guarantee.
+
+    static int fetchXorIntAcqRel(AtomicTypes::Int *atomicInt, int mask);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // "exclusive or" of its value and the specified 'mask', and return its
+        // previous value, providing the acquire/release memory ordering
+        // guarantee.
+
         // *** atomic functions for Int64 ***
 
     static void initInt64(AtomicTypes::Int64 *atomicInt,
@@ -1028,6 +1083,46 @@ struct AtomicOperations {
         // resulting value, providing the acquire/release memory ordering
         // guarantee.
 
+    static Types::Int64 fetchAndInt64(AtomicTypes::Int64 *atomicInt,
+                                      Types::Int64        mask);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // "and" of its value and the specified 'mask', and return its previous
+        // value, providing the sequential consistency memory ordering
+        // guarantee.
+
+    static Types::Int64 fetchAndInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                            Types::Int64        mask);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // "and" of its value and the specified 'mask', and return its previous
+        // value, providing the acquire/release memory ordering guarantee.
+
+    static Types::Int64 fetchOrInt64(AtomicTypes::Int64 *atomicInt,
+                                     Types::Int64        mask);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // "or" of its value and the specified 'mask', and return its previous
+        // value, providing the sequential consistency memory ordering
+        // guarantee.
+
+    static Types::Int64 fetchOrInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                           Types::Int64        mask);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // "or" of its value and the specified 'mask', and return its previous
+        // value, providing the acquire/release memory ordering guarantee.
+
+    static Types::Int64 fetchXorInt64(AtomicTypes::Int64 *atomicInt,
+                                      Types::Int64        mask);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // "exclusive or" of its value and the specified 'mask', and return its
+        // previous value, providing the sequential consistency memory ordering
+        // guarantee.
+
+    static Types::Int64 fetchXorInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                            Types::Int64        mask);
+        // Atomically set the value of the specified 'atomicInt' to the bitwise
+        // "exclusive or" of its value and the specified 'mask', and return its
+        // previous value, providing the acquire/release memory ordering
+        // guarantee.
+
         // *** atomic functions for pointer ***
 
     static void initPointer(AtomicTypes::Pointer *atomicPtr,
@@ -1092,6 +1187,34 @@ struct AtomicOperations {
         // the value of the specified 'compareValue', and return the initial
         // value of 'atomicPtr', providing the acquire/release memory ordering
         // guarantee.  The whole operation is performed atomically.
+
+#if defined(BSLS_ATOMICOPERATIONS_SUPPORT_DOUBLE_WORD)
+        // *** atomic functions for double words ***
+
+    static void initDoubleWord(AtomicTypes::DoubleWord *atomicWords,
+                               Types::UintPtr           first = 0,
+                               Types::UintPtr           second = 0);
+        // Initialize the specified 'atomicWords' and set its words to the
+        // optionally specified 'first' and 'second' values.  If 'first' or
+        // 'second' is not specified, the corresponding word is set to 0.
+
+    static AtomicTypes::DoubleWord getDoubleWord(
+                                         AtomicTypes::DoubleWord *atomicWords);
+        // Atomically retrieve the value of the specified 'atomicWords',
+        // providing the sequential consistency memory ordering guarantee.
+        // Note that this operation writes to 'atomicWords' (replacing its
+        // value with itself).
+
+    static AtomicTypes::DoubleWord testAndSwapDoubleWord(
+                                 AtomicTypes::DoubleWord        *atomicWords,
+                                 const AtomicTypes::DoubleWord&  compareValue,
+                                 const AtomicTypes::DoubleWord&  swapValue);
+        // Conditionally set the value of the specified 'atomicWords' to the
+        // specified 'swapValue' if and only if both words of 'atomicWords'
+        // equal those of the specified 'compareValue', and return the initial
+        // value of 'atomicWords', providing the sequential consistency memory
+        // ordering guarantee.  The whole operation is performed atomically.
+#endif
 };
 
 // ===========================================================================
@@ -1256,6 +1379,42 @@ void AtomicOperations::decrementIntAcqRel(AtomicTypes::Int *atomicInt)
     Imp::decrementIntAcqRel(atomicInt);
 }
 
+inline
+int AtomicOperations::fetchAndInt(AtomicTypes::Int *atomicInt, int mask)
+{
+    return Imp::fetchAndInt(atomicInt, mask);
+}
+
+inline
+int AtomicOperations::fetchAndIntAcqRel(AtomicTypes::Int *atomicInt, int mask)
+{
+    return Imp::fetchAndIntAcqRel(atomicInt, mask);
+}
+
+inline
+int AtomicOperations::fetchOrInt(AtomicTypes::Int *atomicInt, int mask)
+{
+    return Imp::fetchOrInt(atomicInt, mask);
+}
+
+inline
+int AtomicOperations::fetchOrIntAcqRel(AtomicTypes::Int *atomicInt, int mask)
+{
+    return Imp::fetchOrIntAcqRel(atomicInt, mask);
+}
+
+inline
+int AtomicOperations::fetchXorInt(AtomicTypes::Int *atomicInt, int mask)
+{
+    return Imp::fetchXorInt(atomicInt, mask);
+}
+
+inline
+int AtomicOperations::fetchXorIntAcqRel(AtomicTypes::Int *atomicInt, int mask)
+{
+    return Imp::fetchXorIntAcqRel(atomicInt, mask);
+}
+
 inline
 void AtomicOperations::initInt64(AtomicTypes::Int64 *atomicInt,
                                  Types::Int64        initialValue)
@@ -1431,6 +1590,51 @@ Types::Int64
     return Imp::decrementInt64NvAcqRel(atomicInt);
 }
 
+inline
+Types::Int64 AtomicOperations::fetchAndInt64(AtomicTypes::Int64 *atomicInt,
+                                             Types::Int64        mask)
+{
+    return Imp::fetchAndInt64(atomicInt, mask);
+}
+
+inline
+Types::Int64
+    AtomicOperations::fetchAndInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                          Types::Int64        mask)
+{
+    return Imp::fetchAndInt64AcqRel(atomicInt, mask);
+}
+
+inline
+Types::Int64 AtomicOperations::fetchOrInt64(AtomicTypes::Int64 *atomicInt,
+                                            Types::Int64        mask)
+{
+    return Imp::fetchOrInt64(atomicInt, mask);
+}
+
+inline
+Types::Int64
+    AtomicOperations::fetchOrInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                         Types::Int64        mask)
+{
+    return Imp::fetchOrInt64AcqRel(atomicInt, mask);
+}
+
+inline
+Types::Int64 AtomicOperations::fetchXorInt64(AtomicTypes::Int64 *atomicInt,
+                                             Types::Int64        mask)
+{
+    return Imp::fetchXorInt64(atomicInt, mask);
+}
+
+inline
+Types::Int64
+    AtomicOperations::fetchXorInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                          Types::Int64        mask)
+{
+    return Imp::fetchXorInt64AcqRel(atomicInt, mask);
+}
+
 inline
 void AtomicOperations::initPointer(AtomicTypes::Pointer *atomicPtr,
                                    void                 *initialValue)
@@ -1508,6 +1712,33 @@ void *AtomicOperations::testAndSwapPtrAcqRel(
     return Imp::testAndSwapPtrAcqRel(atomicPtr, compareValue, swapValue);
 }
 
+#if defined(BSLS_ATOMICOPERATIONS_SUPPORT_DOUBLE_WORD)
+inline
+void AtomicOperations::initDoubleWord(AtomicTypes::DoubleWord *atomicWords,
+                                      Types::UintPtr           first,
+                                      Types::UintPtr           second)
+{
+    Imp::initDoubleWord(atomicWords, first, second);
+}
+
+inline
+AtomicOperations::AtomicTypes::DoubleWord
+    AtomicOperations::getDoubleWord(AtomicTypes::DoubleWord *atomicWords)
+{
+    return Imp::getDoubleWord(atomicWords);
+}
+
+inline
+AtomicOperations::AtomicTypes::DoubleWord
+    AtomicOperations::testAndSwapDoubleWord(
+                                 AtomicTypes::DoubleWord        *atomicWords,
+                                 const AtomicTypes::DoubleWord&  compareValue,
+                                 const AtomicTypes::DoubleWord&  swapValue)
+{
+    return Imp::testAndSwapDoubleWord(atomicWords, compareValue, swapValue);
+}
+#endif
+
 }  // close package namespace
 
 }  // close enterprise namespace
@@ -58,6 +58,21 @@ using namespace std;
 // [2 ] setPtr(Pointer *aPointer, void *value);
 // [4 ] swapPtr(Pointer *aPointer, void *value);
 // [4 ] testAndSwapPtr(Pointer *, void *, void *);
+// [13] fetchAndInt(Int *aInt, int mask);
+// [13] fetchAndIntAcqRel(Int *aInt, int mask);
+// [13] fetchOrInt(Int *aInt, int mask);
+// [13] fetchOrIntAcqRel(Int *aInt, int mask);
+// [13] fetchXorInt(Int *aInt, int mask);
+// [13] fetchXorIntAcqRel(Int *aInt, int mask);
+// [13] fetchAndInt64(Int64 *, bsls::Types::Int64);
+// [13] fetchAndInt64AcqRel(Int64 *, bsls::Types::Int64);
+// [13] fetchOrInt64(Int64 *, bsls::Types::Int64);
+// [13] fetchOrInt64AcqRel(Int64 *, bsls::Types::Int64);
+// [13] fetchXorInt64(Int64 *, bsls::Types::Int64);
+// [13] fetchXorInt64AcqRel(Int64 *, bsls::Types::Int64);
+// [14] initDoubleWord(DoubleWord *, UintPtr, UintPtr);
+// [14] getDoubleWord(DoubleWord *);
+// [14] testAndSwapDoubleWord(DoubleWord *, const DW&, const DW&);
 //-----------------------------------------------------------------------------
 // [1 ] Breathing test
 // [7 ] Usage examples
@@ -1150,6 +1165,83 @@ static void* testAndSwapPtrAcqRelTestThread(void *ptr)
     return ptr;
 }
 
+struct Case13
+{
+    Types::Int   *d_value_p;    // flags shared by all threads
+    Types::Int64 *d_value64_p;  // 64-bit flags shared by all threads
+    int           d_bit;        // index of the flag owned by this thread
+    int           d_m;          // number of iterations
+};
+
+static void* case13Thread(void* ptr)
+    // Repeatedly set and clear, in the atomic integers referred to by the
+    // specified 'ptr' (a 'Case13'), the flag owned by the calling thread, and
+    // verify that the value returned by each operation shows the flag in its
+    // expected state.
+{
+    Case13 *args = (Case13*) ptr;
+
+    const int                MASK   = 1 << args->d_bit;
+    const bsls::Types::Int64 MASK64 = 1LL << (args->d_bit + 32);
+
+    for (int i = 0; i < args->d_m; ++i) {
+        LOOP_ASSERT(i, 0 == (Obj::fetchOrInt(args->d_value_p, MASK) & MASK));
+        LOOP_ASSERT(i, 0 != (Obj::fetchAndIntAcqRel(args->d_value_p, ~MASK)
+                                                                     & MASK));
+        LOOP_ASSERT(i, 0 == (Obj::fetchXorIntAcqRel(args->d_value_p, MASK)
+                                                                     & MASK));
+        LOOP_ASSERT(i, 0 != (Obj::fetchXorInt(args->d_value_p, MASK) & MASK));
+
+        LOOP_ASSERT(i, 0 == (Obj::fetchOrInt64AcqRel(args->d_value64_p,
+                                                     MASK64) & MASK64));
+        LOOP_ASSERT(i, 0 != (Obj::fetchAndInt64(args->d_value64_p,
+                                                ~MASK64) & MASK64));
+        LOOP_ASSERT(i, 0 == (Obj::fetchXorInt64(args->d_value64_p,
+                                                MASK64) & MASK64));
+        LOOP_ASSERT(i, 0 != (Obj::fetchXorInt64AcqRel(args->d_value64_p,
+                                                      MASK64) & MASK64));
+    }
+    return ptr;
+}
+
+#if defined(BSLS_ATOMICOPERATIONS_SUPPORT_DOUBLE_WORD)
+struct Case14
+{
+    Types::DoubleWord *d_value_p;  // counter and its complement
+    int                d_m;        // number of iterations
+};
+
+static void* case14Thread(void* ptr)
+    // Increment 'd_m' times the counter held by the first word of the double
+    // word referred to by the specified 'ptr' (a 'Case14'), setting its second
+    // word to the complement of the counter, and verify that the words of
+    // each value read are consistent.
+{
+    Case14 *args = (Case14*) ptr;
+
+    Types::DoubleWord value = Obj::getDoubleWord(args->d_value_p);
+    for (int i = 0; i < args->d_m; ++i) {
+        for (;;) {
+            LOOP_ASSERT(i, ~value.d_words[0] == value.d_words[1]);
+
+            Types::DoubleWord newValue;
+            newValue.d_words[0] = value.d_words[0] + 1;
+            newValue.d_words[1] = ~newValue.d_words[0];
+
+            const Types::DoubleWord previous =
+                  Obj::testAndSwapDoubleWord(args->d_value_p, value, newValue);
+            if (previous.d_words[0] == value.d_words[0]
+             && previous.d_words[1] == value.d_words[1]) {
+                value = newValue;
+                break;
+            }
+            value = previous;
+        }
+    }
+    return ptr;
+}
+#endif
+
 }
 
 //=============================================================================
@@ -1620,6 +1712,298 @@ int main(int argc, char *argv[]) {
 #endif
 
     switch (test) { case 0:
+      case 14: {
+        // --------------------------------------------------------------------
+        // TESTING DOUBLE-WORD OPERATIONS
+        //
+        // Concerns:
+        //: 1 'initDoubleWord' sets both words, defaulting them to 0.
+        //:
+        //: 2 'testAndSwapDoubleWord' replaces the value if and only if both
+        //:   words are equal to those of the compare value, and returns the
+        //:   previous value in either case.
+        //:
+        //: 3 'getDoubleWord' returns the current value, without modifying it.
+        //:
+        //: 4 Both words are compared and replaced as one atomic operation.
+        //
+        // Plan:
+        //: 1 Initialize double words, and verify their value.  (C-1, 3)
+        //:
+        //: 2 Compare-and-swap with compare values differing in either or both
+        //:   words, and with an equal compare value, and verify the returned
+        //:   and resulting values.  (C-2..3)
+        //:
+        //: 3 Create N threads, each of which increments M times a counter in
+        //:   the first word of a double word, and sets the second word to its
+        //:   complement, using a compare-and-swap loop.  Verify that each
+        //:   value read is consistent, and that the final counter is NxM.
+        //:   (C-4)
+        //
+        // Testing:
+        //   initDoubleWord(DoubleWord *, UintPtr, UintPtr);
+        //   getDoubleWord(DoubleWord *);
+        //   testAndSwapDoubleWord(DoubleWord *, const DW&, const DW&);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTesting Double-Word Operations"
+                          << "\n==============================" << endl;
+
+#if defined(BSLS_ATOMICOPERATIONS_SUPPORT_DOUBLE_WORD)
+        typedef bsls::Types::UintPtr UintPtr;
+
+        const UintPtr A = 0x12345678;
+        const UintPtr B = ~A;
+
+        if (verbose) cout << "\nTesting 'initDoubleWord'" << endl;
+        {
+            Types::DoubleWord x;
+
+            Obj::initDoubleWord(&x);
+            ASSERT(0 == Obj::getDoubleWord(&x).d_words[0]);
+            ASSERT(0 == Obj::getDoubleWord(&x).d_words[1]);
+
+            Obj::initDoubleWord(&x, A);
+            ASSERT(A == Obj::getDoubleWord(&x).d_words[0]);
+            ASSERT(0 == Obj::getDoubleWord(&x).d_words[1]);
+
+            Obj::initDoubleWord(&x, A, B);
+            ASSERT(A == Obj::getDoubleWord(&x).d_words[0]);
+            ASSERT(B == Obj::getDoubleWord(&x).d_words[1]);
+        }
+
+        if (verbose) cout << "\nTesting 'testAndSwapDoubleWord'" << endl;
+        {
+            static const struct {
+                int     d_lineNum;   // source line number
+                UintPtr d_first;     // first word of the compare value
+                UintPtr d_second;    // second word of the compare value
+                bool    d_swapped;   // whether the value is replaced
+            } DATA[] = {
+                //LINE  FIRST  SECOND  SWAPPED
+                //----  -----  ------  -------
+                { L_,   0,     0,      false   },
+                { L_,   A,     0,      false   },
+                { L_,   0,     B,      false   },
+                { L_,   B,     A,      false   },
+                { L_,   A,     B,      true    },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int  LINE    = DATA[ti].d_lineNum;
+                const bool SWAPPED = DATA[ti].d_swapped;
+
+                Types::DoubleWord x;
+                Obj::initDoubleWord(&x, A, B);
+
+                Types::DoubleWord compare;
+                compare.d_words[0] = DATA[ti].d_first;
+                compare.d_words[1] = DATA[ti].d_second;
+
+                Types::DoubleWord swap;
+                swap.d_words[0] = 1;
+                swap.d_words[1] = 2;
+
+                const Types::DoubleWord previous =
+                                Obj::testAndSwapDoubleWord(&x, compare, swap);
+                LOOP_ASSERT(LINE, A == previous.d_words[0]);
+                LOOP_ASSERT(LINE, B == previous.d_words[1]);
+
+                const Types::DoubleWord result = Obj::getDoubleWord(&x);
+                LOOP_ASSERT(LINE, (SWAPPED ? 1 : A) == result.d_words[0]);
+                LOOP_ASSERT(LINE, (SWAPPED ? 2 : B) == result.d_words[1]);
+            }
+        }
+
+        if (verbose) cout << "\nTesting concurrent updates" << endl;
+        {
+            enum {
+                N = 4,
+                M = 20000
+            };
+
+            Types::DoubleWord value;
+            Obj::initDoubleWord(&value, 0, ~UintPtr(0));
+
+            Case14 args;
+            args.d_value_p = &value;
+            args.d_m       = M;
+
+            my_thread_t threadHandles[N];
+            for (int i = 0; i < N; ++i) {
+                myCreateThread(&threadHandles[i], case14Thread, &args);
+            }
+            for (int i = 0; i < N; ++i) {
+                myJoinThread(threadHandles[i]);
+            }
+
+            const Types::DoubleWord result = Obj::getDoubleWord(&value);
+            ASSERT(UintPtr(N * M) == result.d_words[0]);
+            ASSERT(~UintPtr(N * M) == result.d_words[1]);
+        }
+#else
+        if (verbose) cout << "\nDouble-word operations not supported" << endl;
+#endif
+      } break;
+      case 13: {
+        // --------------------------------------------------------------------
+        // TESTING BITWISE FETCH OPERATIONS
+        //
+        // Concerns:
+        //: 1 The 'fetchAnd', 'fetchOr', and 'fetchXor' operations on 'Int'
+        //:   and 'Int64' (and their acquire/release variants) return the
+        //:   previous value, and store the bitwise combination of that value
+        //:   and the mask.
+        //:
+        //: 2 The operations are atomic: updates of distinct bits of the same
+        //:   object by different threads are not lost.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, apply each operation to a set
+        //:   of initial values and masks, and verify the returned and
+        //:   resulting values.  (C-1)
+        //:
+        //: 2 Create N threads, each of which repeatedly sets and clears a bit
+        //:   of its own in an 'Int' and an 'Int64' using each operation, and
+        //:   verify that each operation observes that bit in the expected
+        //:   state, and that the final values are 0.  (C-2)
+        //
+        // Testing:
+        //   fetchAndInt(Int *aInt, int mask);
+        //   fetchAndIntAcqRel(Int *aInt, int mask);
+        //   fetchOrInt(Int *aInt, int mask);
+        //   fetchOrIntAcqRel(Int *aInt, int mask);
+        //   fetchXorInt(Int *aInt, int mask);
+        //   fetchXorIntAcqRel(Int *aInt, int mask);
+        //   fetchAndInt64(Int64 *, bsls::Types::Int64);
+        //   fetchAndInt64AcqRel(Int64 *, bsls::Types::Int64);
+        //   fetchOrInt64(Int64 *, bsls::Types::Int64);
+        //   fetchOrInt64AcqRel(Int64 *, bsls::Types::Int64);
+        //   fetchXorInt64(Int64 *, bsls::Types::Int64);
+        //   fetchXorInt64AcqRel(Int64 *, bsls::Types::Int64);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTesting Bitwise Fetch Operations"
+                          << "\n================================" << endl;
+
+        static const struct {
+            int                d_lineNum;  // source line number
+            bsls::Types::Int64 d_value;    // initial value
+            bsls::Types::Int64 d_mask;     // mask
+        } DATA[] = {
+            //LINE  VALUE                   MASK
+            //----  ----------------------  ----------------------
+            { L_,   0,                      0                      },
+            { L_,   0,                      -1                     },
+            { L_,   -1,                     0                      },
+            { L_,   -1,                     -1                     },
+            { L_,   0x0F0F,                 0x00FF                 },
+            { L_,   0x12345678,             0x0F0F0F0F             },
+            { L_,   0x123456789ABCDEFLL,    0x7FFFFFFF00000000LL   },
+            { L_,   INT64_SWAPTEST_VALUE1,  INT64_SWAPTEST_VALUE2  },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        if (verbose) cout << "\nTesting 'Int' operations" << endl;
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE  = DATA[ti].d_lineNum;
+            const int VALUE = static_cast<int>(DATA[ti].d_value);
+            const int MASK  = static_cast<int>(DATA[ti].d_mask);
+
+            if (veryVerbose) { T_(); P_(LINE); P_(VALUE); P(MASK); }
+
+            Types::Int x;
+
+            Obj::initInt(&x, VALUE);
+            LOOP_ASSERT(LINE, VALUE == Obj::fetchAndInt(&x, MASK));
+            LOOP_ASSERT(LINE, (VALUE & MASK) == Obj::getInt(&x));
+
+            Obj::initInt(&x, VALUE);
+            LOOP_ASSERT(LINE, VALUE == Obj::fetchAndIntAcqRel(&x, MASK));
+            LOOP_ASSERT(LINE, (VALUE & MASK) == Obj::getInt(&x));
+
+            Obj::initInt(&x, VALUE);
+            LOOP_ASSERT(LINE, VALUE == Obj::fetchOrInt(&x, MASK));
+            LOOP_ASSERT(LINE, (VALUE | MASK) == Obj::getInt(&x));
+
+            Obj::initInt(&x, VALUE);
+            LOOP_ASSERT(LINE, VALUE == Obj::fetchOrIntAcqRel(&x, MASK));
+            LOOP_ASSERT(LINE, (VALUE | MASK) == Obj::getInt(&x));
+
+            Obj::initInt(&x, VALUE);
+            LOOP_ASSERT(LINE, VALUE == Obj::fetchXorInt(&x, MASK));
+            LOOP_ASSERT(LINE, (VALUE ^ MASK) == Obj::getInt(&x));
+
+            Obj::initInt(&x, VALUE);
+            LOOP_ASSERT(LINE, VALUE == Obj::fetchXorIntAcqRel(&x, MASK));
+            LOOP_ASSERT(LINE, (VALUE ^ MASK) == Obj::getInt(&x));
+        }
+
+        if (verbose) cout << "\nTesting 'Int64' operations" << endl;
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int                LINE  = DATA[ti].d_lineNum;
+            const bsls::Types::Int64 VALUE = DATA[ti].d_value;
+            const bsls::Types::Int64 MASK  = DATA[ti].d_mask;
+
+            if (veryVerbose) { T_(); P_(LINE); P_(VALUE); P(MASK); }
+
+            Types::Int64 x;
+
+            Obj::initInt64(&x, VALUE);
+            LOOP_ASSERT(LINE, VALUE == Obj::fetchAndInt64(&x, MASK));
+            LOOP_ASSERT(LINE, (VALUE & MASK) == Obj::getInt64(&x));
+
+            Obj::initInt64(&x, VALUE);
+            LOOP_ASSERT(LINE, VALUE == Obj::fetchAndInt64AcqRel(&x, MASK));
+            LOOP_ASSERT(LINE, (VALUE & MASK) == Obj::getInt64(&x));
+
+            Obj::initInt64(&x, VALUE);
+            LOOP_ASSERT(LINE, VALUE == Obj::fetchOrInt64(&x, MASK));
+            LOOP_ASSERT(LINE, (VALUE | MASK) == Obj::getInt64(&x));
+
+            Obj::initInt64(&x, VALUE);
+            LOOP_ASSERT(LINE, VALUE == Obj::fetchOrInt64AcqRel(&x, MASK));
+            LOOP_ASSERT(LINE, (VALUE | MASK) == Obj::getInt64(&x));
+
+            Obj::initInt64(&x, VALUE);
+            LOOP_ASSERT(LINE, VALUE == Obj::fetchXorInt64(&x, MASK));
+            LOOP_ASSERT(LINE, (VALUE ^ MASK) == Obj::getInt64(&x));
+
+            Obj::initInt64(&x, VALUE);
+            LOOP_ASSERT(LINE, VALUE == Obj::fetchXorInt64AcqRel(&x, MASK));
+            LOOP_ASSERT(LINE, (VALUE ^ MASK) == Obj::getInt64(&x));
+        }
+
+        if (verbose) cout << "\nTesting concurrent updates" << endl;
+        {
+            enum {
+                N = 8,
+                M = 20000
+            };
+
+            Types::Int   value;
+            Types::Int64 value64;
+            Obj::initInt(&value, 0);
+            Obj::initInt64(&value64, 0);
+
+            Case13      args[N];
+            my_thread_t threadHandles[N];
+            for (int i = 0; i < N; ++i) {
+                args[i].d_value_p   = &value;
+                args[i].d_value64_p = &value64;
+                args[i].d_bit       = i;
+                args[i].d_m         = M;
+                myCreateThread(&threadHandles[i], case13Thread, &args[i]);
+            }
+            for (int i = 0; i < N; ++i) {
+                myJoinThread(threadHandles[i]);
+            }
+
+            ASSERT(0 == Obj::getInt(&value));
+            ASSERT(0 == Obj::getInt64(&value64));
+        }
+      } break;
       case 12: {
         // --------------------------------------------------------------------
         // TESTING GET/SET ACQUIRE/RELEASE MANIPULATORS:
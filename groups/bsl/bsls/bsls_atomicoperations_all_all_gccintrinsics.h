@@ -31,6 +31,15 @@ BSLS_IDENT("$Id: $")
 
 #if defined(BSLS_PLATFORM_CMP_GNU) && BSLS_PLATFORM_CMP_VERSION >= 40700
 
+#if !defined(BSLS_PLATFORM_CPU_64_BIT)                                        \
+ || defined(BSLS_PLATFORM_CPU_X86_64)                                         \
+ || defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#define BSLS_ATOMICOPERATIONS_SUPPORT_DOUBLE_WORD 1
+    // A compare-and-swap of two pointer-sized words is available: a 64-bit
+    // compare-and-swap on 32-bit platforms, 'cmpxchg16b' on x86-64, and the
+    // 16-byte '__sync' intrinsics elsewhere.
+#endif
+
 namespace BloombergLP {
 
 namespace bsls {
@@ -59,6 +68,13 @@ struct Atomic_TypeTraits<AtomicOperations_ALL_ALL_GCCIntrinsics>
     {
           void * d_value;
     };
+
+#if defined(BSLS_ATOMICOPERATIONS_SUPPORT_DOUBLE_WORD)
+    struct __attribute__((__aligned__(2 * sizeof(void *)))) DoubleWord
+    {
+          Types::UintPtr d_words[2];
+    };
+#endif
 };
 
                // =============================================
@@ -112,6 +128,18 @@ struct AtomicOperations_ALL_ALL_GCCIntrinsics
 
     static int addIntNvRelaxed(AtomicTypes::Int *atomicInt, int value);
 
+    static int fetchAndInt(AtomicTypes::Int *atomicInt, int mask);
+
+    static int fetchAndIntAcqRel(AtomicTypes::Int *atomicInt, int mask);
+
+    static int fetchOrInt(AtomicTypes::Int *atomicInt, int mask);
+
+    static int fetchOrIntAcqRel(AtomicTypes::Int *atomicInt, int mask);
+
+    static int fetchXorInt(AtomicTypes::Int *atomicInt, int mask);
+
+    static int fetchXorIntAcqRel(AtomicTypes::Int *atomicInt, int mask);
+
         // *** atomic functions for Int64 ***
 
     static void initInt64(AtomicTypes::Int64 *atomicInt, Types::Int64 value);
@@ -153,6 +181,40 @@ struct AtomicOperations_ALL_ALL_GCCIntrinsics
 
     static Types::Int64 addInt64NvRelaxed(AtomicTypes::Int64 *atomicInt,
                                           Types::Int64        value);
+
+    static Types::Int64 fetchAndInt64(AtomicTypes::Int64 *atomicInt,
+                                      Types::Int64        mask);
+
+    static Types::Int64 fetchAndInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                            Types::Int64        mask);
+
+    static Types::Int64 fetchOrInt64(AtomicTypes::Int64 *atomicInt,
+                                     Types::Int64        mask);
+
+    static Types::Int64 fetchOrInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                           Types::Int64        mask);
+
+    static Types::Int64 fetchXorInt64(AtomicTypes::Int64 *atomicInt,
+                                      Types::Int64        mask);
+
+    static Types::Int64 fetchXorInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                            Types::Int64        mask);
+
+#if defined(BSLS_ATOMICOPERATIONS_SUPPORT_DOUBLE_WORD)
+        // *** atomic functions for double words ***
+
+    static void initDoubleWord(AtomicTypes::DoubleWord *atomicWords,
+                               Types::UintPtr           first,
+                               Types::UintPtr           second);
+
+    static AtomicTypes::DoubleWord getDoubleWord(
+                                         AtomicTypes::DoubleWord *atomicWords);
+
+    static AtomicTypes::DoubleWord testAndSwapDoubleWord(
+                                 AtomicTypes::DoubleWord        *atomicWords,
+                                 const AtomicTypes::DoubleWord&  compareValue,
+                                 const AtomicTypes::DoubleWord&  swapValue);
+#endif
 };
 
 // ===========================================================================
@@ -271,6 +333,48 @@ int AtomicOperations_ALL_ALL_GCCIntrinsics::
     return __atomic_add_fetch(&atomicInt->d_value, value, __ATOMIC_RELAXED);
 }
 
+inline
+int AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchAndInt(AtomicTypes::Int *atomicInt, int mask)
+{
+    return __atomic_fetch_and(&atomicInt->d_value, mask, __ATOMIC_SEQ_CST);
+}
+
+inline
+int AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchAndIntAcqRel(AtomicTypes::Int *atomicInt, int mask)
+{
+    return __atomic_fetch_and(&atomicInt->d_value, mask, __ATOMIC_ACQ_REL);
+}
+
+inline
+int AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchOrInt(AtomicTypes::Int *atomicInt, int mask)
+{
+    return __atomic_fetch_or(&atomicInt->d_value, mask, __ATOMIC_SEQ_CST);
+}
+
+inline
+int AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchOrIntAcqRel(AtomicTypes::Int *atomicInt, int mask)
+{
+    return __atomic_fetch_or(&atomicInt->d_value, mask, __ATOMIC_ACQ_REL);
+}
+
+inline
+int AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchXorInt(AtomicTypes::Int *atomicInt, int mask)
+{
+    return __atomic_fetch_xor(&atomicInt->d_value, mask, __ATOMIC_SEQ_CST);
+}
+
+inline
+int AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchXorIntAcqRel(AtomicTypes::Int *atomicInt, int mask)
+{
+    return __atomic_fetch_xor(&atomicInt->d_value, mask, __ATOMIC_ACQ_REL);
+}
+
 inline
 void AtomicOperations_ALL_ALL_GCCIntrinsics::
     initInt64(AtomicTypes::Int64 *atomicInt, Types::Int64 value)
@@ -379,6 +483,127 @@ Types::Int64 AtomicOperations_ALL_ALL_GCCIntrinsics::
     return __atomic_add_fetch(&atomicInt->d_value, value, __ATOMIC_RELAXED);
 }
 
+inline
+Types::Int64 AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchAndInt64(AtomicTypes::Int64 *atomicInt, Types::Int64 mask)
+{
+    return __atomic_fetch_and(&atomicInt->d_value, mask, __ATOMIC_SEQ_CST);
+}
+
+inline
+Types::Int64 AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchAndInt64AcqRel(AtomicTypes::Int64 *atomicInt, Types::Int64 mask)
+{
+    return __atomic_fetch_and(&atomicInt->d_value, mask, __ATOMIC_ACQ_REL);
+}
+
+inline
+Types::Int64 AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchOrInt64(AtomicTypes::Int64 *atomicInt, Types::Int64 mask)
+{
+    return __atomic_fetch_or(&atomicInt->d_value, mask, __ATOMIC_SEQ_CST);
+}
+
+inline
+Types::Int64 AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchOrInt64AcqRel(AtomicTypes::Int64 *atomicInt, Types::Int64 mask)
+{
+    return __atomic_fetch_or(&atomicInt->d_value, mask, __ATOMIC_ACQ_REL);
+}
+
+inline
+Types::Int64 AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchXorInt64(AtomicTypes::Int64 *atomicInt, Types::Int64 mask)
+{
+    return __atomic_fetch_xor(&atomicInt->d_value, mask, __ATOMIC_SEQ_CST);
+}
+
+inline
+Types::Int64 AtomicOperations_ALL_ALL_GCCIntrinsics::
+    fetchXorInt64AcqRel(AtomicTypes::Int64 *atomicInt, Types::Int64 mask)
+{
+    return __atomic_fetch_xor(&atomicInt->d_value, mask, __ATOMIC_ACQ_REL);
+}
+
+#if defined(BSLS_ATOMICOPERATIONS_SUPPORT_DOUBLE_WORD)
+inline
+void AtomicOperations_ALL_ALL_GCCIntrinsics::
+    initDoubleWord(AtomicTypes::DoubleWord *atomicWords,
+                   Types::UintPtr           first,
+                   Types::UintPtr           second)
+{
+    atomicWords->d_words[0] = first;
+    atomicWords->d_words[1] = second;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+inline
+AtomicOperations_ALL_ALL_GCCIntrinsics::AtomicTypes::DoubleWord
+AtomicOperations_ALL_ALL_GCCIntrinsics::
+    getDoubleWord(AtomicTypes::DoubleWord *atomicWords)
+{
+    // A compare-and-swap replacing a value by itself returns the current
+    // value atomically.
+
+    const AtomicTypes::DoubleWord zero = { { 0, 0 } };
+    return testAndSwapDoubleWord(atomicWords, zero, zero);
+}
+
+inline
+AtomicOperations_ALL_ALL_GCCIntrinsics::AtomicTypes::DoubleWord
+AtomicOperations_ALL_ALL_GCCIntrinsics::
+    testAndSwapDoubleWord(AtomicTypes::DoubleWord        *atomicWords,
+                          const AtomicTypes::DoubleWord&  compareValue,
+                          const AtomicTypes::DoubleWord&  swapValue)
+{
+    AtomicTypes::DoubleWord previous = compareValue;
+
+#if defined(BSLS_PLATFORM_CPU_X86_64)
+    // 'cmpxchg16b' compares 'rdx:rax' to the operand, and either stores
+    // 'rcx:rbx' into it, or loads it into 'rdx:rax'; in either case,
+    // 'rdx:rax' holds the previous value.  (The 16-byte '__atomic' intrinsics
+    // are not inlined on x86-64.)
+
+    asm volatile (
+        "       lock cmpxchg16b %[obj]\n\t"
+                : [obj] "+m" (*atomicWords),
+                  "+a" (previous.d_words[0]),
+                  "+d" (previous.d_words[1])
+                : "b" (swapValue.d_words[0]),
+                  "c" (swapValue.d_words[1])
+                : "memory", "cc");
+#elif defined(BSLS_PLATFORM_CPU_64_BIT)
+    __extension__ typedef unsigned __int128 Uint128;
+
+    union Words {
+        AtomicTypes::DoubleWord d_words;
+        Uint128                 d_value;
+    };
+
+    Words compare;  compare.d_words = compareValue;
+    Words swap;     swap.d_words    = swapValue;
+    Words result;
+
+    result.d_value = __sync_val_compare_and_swap(
+                                  reinterpret_cast<Uint128 *>(atomicWords),
+                                  compare.d_value,
+                                  swap.d_value);
+    previous = result.d_words;
+#else
+    AtomicTypes::DoubleWord swap = swapValue;
+
+    __atomic_compare_exchange(atomicWords,
+                              &previous,
+                              &swap,
+                              false,
+                              __ATOMIC_SEQ_CST,
+                              __ATOMIC_SEQ_CST);
+#endif
+
+    return previous;
+}
+#endif
+
 }  // close package namespace
 
 }  // close enterprise namespace
@@ -375,6 +375,21 @@ struct AtomicOperations_DefaultInt
     static void decrementInt(typename AtomicTypes::Int *atomicInt);
 
     static void decrementIntAcqRel(typename AtomicTypes::Int *atomicInt);
+
+    static int fetchAndInt(typename AtomicTypes::Int *atomicInt, int mask);
+
+    static int fetchAndIntAcqRel(typename AtomicTypes::Int *atomicInt,
+                                 int mask);
+
+    static int fetchOrInt(typename AtomicTypes::Int *atomicInt, int mask);
+
+    static int fetchOrIntAcqRel(typename AtomicTypes::Int *atomicInt,
+                                int mask);
+
+    static int fetchXorInt(typename AtomicTypes::Int *atomicInt, int mask);
+
+    static int fetchXorIntAcqRel(typename AtomicTypes::Int *atomicInt,
+                                 int mask);
 };
 
                     // ====================================
@@ -478,6 +493,27 @@ struct AtomicOperations_DefaultInt64
 
     static Types::Int64 decrementInt64NvAcqRel(
                                        typename AtomicTypes::Int64 *atomicInt);
+
+    static Types::Int64 fetchAndInt64(typename AtomicTypes::Int64 *atomicInt,
+                                      Types::Int64 mask);
+
+    static Types::Int64 fetchAndInt64AcqRel(
+                                        typename AtomicTypes::Int64 *atomicInt,
+                                        Types::Int64 mask);
+
+    static Types::Int64 fetchOrInt64(typename AtomicTypes::Int64 *atomicInt,
+                                     Types::Int64 mask);
+
+    static Types::Int64 fetchOrInt64AcqRel(
+                                        typename AtomicTypes::Int64 *atomicInt,
+                                        Types::Int64 mask);
+
+    static Types::Int64 fetchXorInt64(typename AtomicTypes::Int64 *atomicInt,
+                                      Types::Int64 mask);
+
+    static Types::Int64 fetchXorInt64AcqRel(
+                                        typename AtomicTypes::Int64 *atomicInt,
+                                        Types::Int64 mask);
 };
 
                   // ========================================
@@ -838,6 +874,112 @@ void AtomicOperations_DefaultInt<IMP>::
     IMP::addIntAcqRel(atomicInt, -1);
 }
 
+// The bitwise operations are implemented by compare-and-swap loops, which
+// platform-specific implementations override where the processor (or the
+// compiler) provides the operations directly.
+
+template <class IMP>
+inline
+int AtomicOperations_DefaultInt<IMP>::
+    fetchAndInt(typename AtomicTypes::Int *atomicInt, int mask)
+{
+    int value = IMP::getIntRelaxed(atomicInt);
+    for (;;) {
+        const int previous = IMP::testAndSwapInt(atomicInt,
+                                                 value,
+                                                 value & mask);
+        if (previous == value) {
+            return previous;                                          // RETURN
+        }
+        value = previous;
+    }
+}
+
+template <class IMP>
+inline
+int AtomicOperations_DefaultInt<IMP>::
+    fetchAndIntAcqRel(typename AtomicTypes::Int *atomicInt, int mask)
+{
+    int value = IMP::getIntRelaxed(atomicInt);
+    for (;;) {
+        const int previous = IMP::testAndSwapIntAcqRel(atomicInt,
+                                                       value,
+                                                       value & mask);
+        if (previous == value) {
+            return previous;                                          // RETURN
+        }
+        value = previous;
+    }
+}
+
+template <class IMP>
+inline
+int AtomicOperations_DefaultInt<IMP>::
+    fetchOrInt(typename AtomicTypes::Int *atomicInt, int mask)
+{
+    int value = IMP::getIntRelaxed(atomicInt);
+    for (;;) {
+        const int previous = IMP::testAndSwapInt(atomicInt,
+                                                 value,
+                                                 value | mask);
+        if (previous == value) {
+            return previous;                                          // RETURN
+        }
+        value = previous;
+    }
+}
+
+template <class IMP>
+inline
+int AtomicOperations_DefaultInt<IMP>::
+    fetchOrIntAcqRel(typename AtomicTypes::Int *atomicInt, int mask)
+{
+    int value = IMP::getIntRelaxed(atomicInt);
+    for (;;) {
+        const int previous = IMP::testAndSwapIntAcqRel(atomicInt,
+                                                       value,
+                                                       value | mask);
+        if (previous == value) {
+            return previous;                                          // RETURN
+        }
+        value = previous;
+    }
+}
+
+template <class IMP>
+inline
+int AtomicOperations_DefaultInt<IMP>::
+    fetchXorInt(typename AtomicTypes::Int *atomicInt, int mask)
+{
+    int value = IMP::getIntRelaxed(atomicInt);
+    for (;;) {
+        const int previous = IMP::testAndSwapInt(atomicInt,
+                                                 value,
+                                                 value ^ mask);
+        if (previous == value) {
+            return previous;                                          // RETURN
+        }
+        value = previous;
+    }
+}
+
+template <class IMP>
+inline
+int AtomicOperations_DefaultInt<IMP>::
+    fetchXorIntAcqRel(typename AtomicTypes::Int *atomicInt, int mask)
+{
+    int value = IMP::getIntRelaxed(atomicInt);
+    for (;;) {
+        const int previous = IMP::testAndSwapIntAcqRel(atomicInt,
+                                                       value,
+                                                       value ^ mask);
+        if (previous == value) {
+            return previous;                                          // RETURN
+        }
+        value = previous;
+    }
+}
+
                     // ------------------------------------
                     // struct AtomicOperations_DefaultInt64
                     // ------------------------------------
@@ -1014,6 +1156,108 @@ Types::Int64 AtomicOperations_DefaultInt64<IMP>::
     return IMP::addInt64NvAcqRel(atomicInt, -1);
 }
 
+template <class IMP>
+inline
+Types::Int64 AtomicOperations_DefaultInt64<IMP>::
+    fetchAndInt64(typename AtomicTypes::Int64 *atomicInt,
+                  Types::Int64 mask)
+{
+    Types::Int64 value = IMP::getInt64Relaxed(atomicInt);
+    for (;;) {
+        const Types::Int64 previous =
+                         IMP::testAndSwapInt64(atomicInt, value, value & mask);
+        if (previous == value) {
+            return previous;                                          // RETURN
+        }
+        value = previous;
+    }
+}
+
+template <class IMP>
+inline
+Types::Int64 AtomicOperations_DefaultInt64<IMP>::
+    fetchAndInt64AcqRel(typename AtomicTypes::Int64 *atomicInt,
+                        Types::Int64 mask)
+{
+    Types::Int64 value = IMP::getInt64Relaxed(atomicInt);
+    for (;;) {
+        const Types::Int64 previous =
+                   IMP::testAndSwapInt64AcqRel(atomicInt, value, value & mask);
+        if (previous == value) {
+            return previous;                                          // RETURN
+        }
+        value = previous;
+    }
+}
+
+template <class IMP>
+inline
+Types::Int64 AtomicOperations_DefaultInt64<IMP>::
+    fetchOrInt64(typename AtomicTypes::Int64 *atomicInt,
+                 Types::Int64 mask)
+{
+    Types::Int64 value = IMP::getInt64Relaxed(atomicInt);
+    for (;;) {
+        const Types::Int64 previous =
+                         IMP::testAndSwapInt64(atomicInt, value, value | mask);
+        if (previous == value) {
+            return previous;                                          // RETURN
+        }
+        value = previous;
+    }
+}
+
+template <class IMP>
+inline
+Types::Int64 AtomicOperations_DefaultInt64<IMP>::
+    fetchOrInt64AcqRel(typename AtomicTypes::Int64 *atomicInt,
+                       Types::Int64 mask)
+{
+    Types::Int64 value = IMP::getInt64Relaxed(atomicInt);
+    for (;;) {
+        const Types::Int64 previous =
+                   IMP::testAndSwapInt64AcqRel(atomicInt, value, value | mask);
+        if (previous == value) {
+            return previous;                                          // RETURN
+        }
+        value = previous;
+    }
+}
+
+template <class IMP>
+inline
+Types::Int64 AtomicOperations_DefaultInt64<IMP>::
+    fetchXorInt64(typename AtomicTypes::Int64 *atomicInt,
+                  Types::Int64 mask)
+{
+    Types::Int64 value = IMP::getInt64Relaxed(atomicInt);
+    for (;;) {
+        const Types::Int64 previous =
+                         IMP::testAndSwapInt64(atomicInt, value, value ^ mask);
+        if (previous == value) {
+            return previous;                                          // RETURN
+        }
+        value = previous;
+    }
+}
+
+template <class IMP>
+inline
+Types::Int64 AtomicOperations_DefaultInt64<IMP>::
+    fetchXorInt64AcqRel(typename AtomicTypes::Int64 *atomicInt,
+                        Types::Int64 mask)
+{
+    Types::Int64 value = IMP::getInt64Relaxed(atomicInt);
+    for (;;) {
+        const Types::Int64 previous =
+                   IMP::testAndSwapInt64AcqRel(atomicInt, value, value ^ mask);
+        if (previous == value) {
+            return previous;                                          // RETURN
+        }
+        value = previous;
+    }
+}
+
                   // ----------------------------------------
                   // struct AtomicOperations_DefaultPointer32
                   // ----------------------------------------
@@ -40,6 +40,9 @@ BSLS_IDENT("$Id: $")
 #if defined(BSLS_PLATFORM_CPU_X86_64) \
     && (defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG))
 
+#define BSLS_ATOMICOPERATIONS_SUPPORT_DOUBLE_WORD 1
+    // 'cmpxchg16b' provides a compare-and-swap of two pointer-sized words.
+
 namespace BloombergLP {
 
 namespace bsls {
@@ -69,6 +72,12 @@ struct Atomic_TypeTraits<AtomicOperations_X64_ALL_GCC>
     {
         void * volatile d_value __attribute__((__aligned__(sizeof(void *))));
     };
+
+    struct DoubleWord
+    {
+        volatile Types::UintPtr d_words[2]
+                             __attribute__((__aligned__(2 * sizeof(void *))));
+    };
 };
 
                      // ===================================
@@ -96,6 +105,18 @@ struct AtomicOperations_X64_ALL_GCC
 
     static int addIntNv(AtomicTypes::Int *atomicInt, int value);
 
+    static int fetchAndInt(AtomicTypes::Int *atomicInt, int mask);
+
+    static int fetchAndIntAcqRel(AtomicTypes::Int *atomicInt, int mask);
+
+    static int fetchOrInt(AtomicTypes::Int *atomicInt, int mask);
+
+    static int fetchOrIntAcqRel(AtomicTypes::Int *atomicInt, int mask);
+
+    static int fetchXorInt(AtomicTypes::Int *atomicInt, int mask);
+
+    static int fetchXorIntAcqRel(AtomicTypes::Int *atomicInt, int mask);
+
         // *** atomic functions for Int64 ***
 
     static Types::Int64 getInt64(const AtomicTypes::Int64 *atomicInt);
@@ -114,6 +135,38 @@ struct AtomicOperations_X64_ALL_GCC
 
     static Types::Int64 addInt64Nv(AtomicTypes::Int64 *atomicInt,
                                    Types::Int64 value);
+
+    static Types::Int64 fetchAndInt64(AtomicTypes::Int64 *atomicInt,
+                                      Types::Int64 mask);
+
+    static Types::Int64 fetchAndInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                            Types::Int64 mask);
+
+    static Types::Int64 fetchOrInt64(AtomicTypes::Int64 *atomicInt,
+                                     Types::Int64 mask);
+
+    static Types::Int64 fetchOrInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                           Types::Int64 mask);
+
+    static Types::Int64 fetchXorInt64(AtomicTypes::Int64 *atomicInt,
+                                      Types::Int64 mask);
+
+    static Types::Int64 fetchXorInt64AcqRel(AtomicTypes::Int64 *atomicInt,
+                                            Types::Int64 mask);
+
+        // *** atomic functions for double words ***
+
+    static void initDoubleWord(AtomicTypes::DoubleWord *atomicWords,
+                               Types::UintPtr first,
+                               Types::UintPtr second);
+
+    static AtomicTypes::DoubleWord getDoubleWord(
+                                         AtomicTypes::DoubleWord *atomicWords);
+
+    static AtomicTypes::DoubleWord testAndSwapDoubleWord(
+                                 AtomicTypes::DoubleWord *atomicWords,
+                                 const AtomicTypes::DoubleWord& compareValue,
+                                 const AtomicTypes::DoubleWord& swapValue);
 };
 
 // ===========================================================================
@@ -198,6 +251,48 @@ int AtomicOperations_X64_ALL_GCC::
     return __sync_add_and_fetch(&atomicInt->d_value, value);
 }
 
+inline
+int AtomicOperations_X64_ALL_GCC::
+    fetchAndInt(AtomicTypes::Int *atomicInt, int mask)
+{
+    return __sync_fetch_and_and(&atomicInt->d_value, mask);
+}
+
+inline
+int AtomicOperations_X64_ALL_GCC::
+    fetchAndIntAcqRel(AtomicTypes::Int *atomicInt, int mask)
+{
+    return __sync_fetch_and_and(&atomicInt->d_value, mask);
+}
+
+inline
+int AtomicOperations_X64_ALL_GCC::
+    fetchOrInt(AtomicTypes::Int *atomicInt, int mask)
+{
+    return __sync_fetch_and_or(&atomicInt->d_value, mask);
+}
+
+inline
+int AtomicOperations_X64_ALL_GCC::
+    fetchOrIntAcqRel(AtomicTypes::Int *atomicInt, int mask)
+{
+    return __sync_fetch_and_or(&atomicInt->d_value, mask);
+}
+
+inline
+int AtomicOperations_X64_ALL_GCC::
+    fetchXorInt(AtomicTypes::Int *atomicInt, int mask)
+{
+    return __sync_fetch_and_xor(&atomicInt->d_value, mask);
+}
+
+inline
+int AtomicOperations_X64_ALL_GCC::
+    fetchXorIntAcqRel(AtomicTypes::Int *atomicInt, int mask)
+{
+    return __sync_fetch_and_xor(&atomicInt->d_value, mask);
+}
+
 inline
 Types::Int64 AtomicOperations_X64_ALL_GCC::
     getInt64(const AtomicTypes::Int64 *atomicInt)
@@ -275,6 +370,92 @@ Types::Int64 AtomicOperations_X64_ALL_GCC::
     return __sync_add_and_fetch(&atomicInt->d_value, value);
 }
 
+inline
+Types::Int64 AtomicOperations_X64_ALL_GCC::
+    fetchAndInt64(AtomicTypes::Int64 *atomicInt, Types::Int64 mask)
+{
+    return __sync_fetch_and_and(&atomicInt->d_value, mask);
+}
+
+inline
+Types::Int64 AtomicOperations_X64_ALL_GCC::
+    fetchAndInt64AcqRel(AtomicTypes::Int64 *atomicInt, Types::Int64 mask)
+{
+    return __sync_fetch_and_and(&atomicInt->d_value, mask);
+}
+
+inline
+Types::Int64 AtomicOperations_X64_ALL_GCC::
+    fetchOrInt64(AtomicTypes::Int64 *atomicInt, Types::Int64 mask)
+{
+    return __sync_fetch_and_or(&atomicInt->d_value, mask);
+}
+
+inline
+Types::Int64 AtomicOperations_X64_ALL_GCC::
+    fetchOrInt64AcqRel(AtomicTypes::Int64 *atomicInt, Types::Int64 mask)
+{
+    return __sync_fetch_and_or(&atomicInt->d_value, mask);
+}
+
+inline
+Types::Int64 AtomicOperations_X64_ALL_GCC::
+    fetchXorInt64(AtomicTypes::Int64 *atomicInt, Types::Int64 mask)
+{
+    return __sync_fetch_and_xor(&atomicInt->d_value, mask);
+}
+
+inline
+Types::Int64 AtomicOperations_X64_ALL_GCC::
+    fetchXorInt64AcqRel(AtomicTypes::Int64 *atomicInt, Types::Int64 mask)
+{
+    return __sync_fetch_and_xor(&atomicInt->d_value, mask);
+}
+
+inline
+void AtomicOperations_X64_ALL_GCC::
+    initDoubleWord(AtomicTypes::DoubleWord *atomicWords,
+                   Types::UintPtr first,
+                   Types::UintPtr second)
+{
+    atomicWords->d_words[0] = first;
+    atomicWords->d_words[1] = second;
+    asm volatile ("" ::: "memory");
+}
+
+inline
+AtomicOperations_X64_ALL_GCC::AtomicTypes::DoubleWord
+AtomicOperations_X64_ALL_GCC::
+    getDoubleWord(AtomicTypes::DoubleWord *atomicWords)
+{
+    const AtomicTypes::DoubleWord zero = { { 0, 0 } };
+    return testAndSwapDoubleWord(atomicWords, zero, zero);
+}
+
+inline
+AtomicOperations_X64_ALL_GCC::AtomicTypes::DoubleWord
+AtomicOperations_X64_ALL_GCC::
+    testAndSwapDoubleWord(AtomicTypes::DoubleWord *atomicWords,
+                          const AtomicTypes::DoubleWord& compareValue,
+                          const AtomicTypes::DoubleWord& swapValue)
+{
+    Types::UintPtr low  = compareValue.d_words[0];
+    Types::UintPtr high = compareValue.d_words[1];
+
+    asm volatile (
+        "       lock cmpxchg16b %[obj]\n\t"
+
+                : [obj] "+m" (*atomicWords),
+                  "+a" (low),
+                  "+d" (high)
+                : "b" (swapValue.d_words[0]),
+                  "c" (swapValue.d_words[1])
+                : "memory", "cc");
+
+    AtomicTypes::DoubleWord previous = { { low, high } };
+    return previous;
+}
+
 }  // close package namespace
 
 }  // close enterprise namespace
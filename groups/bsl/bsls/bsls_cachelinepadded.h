@@ -0,0 +1,270 @@
+// bsls_cachelinepadded.h                                             -*-C++-*-
+#ifndef INCLUDED_BSLS_CACHELINEPADDED
+#define INCLUDED_BSLS_CACHELINEPADDED
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a wrapper placing an object alone in its cache lines.
+//
+//@CLASSES:
+//  bsls::CacheLinePadded: object aligned and padded to avoid false sharing
+//
+//@SEE_ALSO: bsls_performancehint, bsls_objectbuffer
+//
+//@DESCRIPTION: This component provides a class template,
+// 'bsls::CacheLinePadded', that holds an object of its parameterized 'TYPE',
+// aligned on, and padded to a multiple of,
+// 'BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE' bytes (see
+// 'bsls_performancehint').  No other object therefore shares a cache line
+// with the wrapped object, so that the wrapped object, e.g., an atomic
+// counter written by many threads, or one element of an array of per-thread
+// counters, does not *false-share* with its neighbors: a thread writing to
+// the wrapped object does not evict the neighbors from the caches of the
+// other processors, and vice versa.
+//
+// The wrapped object is accessed with 'object', or with the '*' and '->'
+// operators.  'bsls::CacheLinePadded' is constructed from zero, one, or two
+// arguments, passed to the constructor of the wrapped object.
+//
+///Alignment of Dynamically Allocated Objects
+///------------------------------------------
+// The alignment of 'bsls::CacheLinePadded' exceeds the maximal fundamental
+// alignment ('bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT').  Automatic and static
+// objects, and members of such objects, are aligned by the compiler, but
+// 'operator new' (before C++17) and 'bslma::Allocator::allocate' do not
+// honor extended alignments: a dynamically allocated 'bsls::CacheLinePadded',
+// or an object having a 'bsls::CacheLinePadded' member, should be allocated
+// with 'bslma::Allocator::allocateAligned' (as 'bsl::allocator' does for
+// container elements).  Note that a misaligned 'bsls::CacheLinePadded' object
+// may share its first and last cache lines with other objects, but is usable
+// otherwise on the supported platforms.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Per-Thread Counters
+/// - - - - - - - - - - - - - - -
+// Suppose that each thread of a server counts the requests it processes in
+// its own element of an array, so that the threads do not contend on a single
+// counter.
+//
+// First, we note that the elements of an array of 'int' share cache lines:
+// each increment by a thread evicts the counters of the other threads from
+// the caches of their processors, and the threads contend as if they shared a
+// single counter:
+//..
+//  int sharedCounters[4];
+//  assert(&sharedCounters[1] - &sharedCounters[0] == 1);
+//..
+// Then, we define the array with each counter padded instead:
+//..
+//  bsls::CacheLinePadded<int> counters[4];
+//..
+// Now, the counters are each alone in their cache lines:
+//..
+//  const char *first  = reinterpret_cast<const char *>(&counters[0]);
+//  const char *second = reinterpret_cast<const char *>(&counters[1]);
+//  assert(BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE
+//                                                         <= second - first);
+//..
+// Finally, each thread increments its counter through the wrapper, and the
+// counters are summed as usual:
+//..
+//  for (int thread = 0; thread < 4; ++thread) {
+//      *counters[thread] = 0;
+//      for (int request = 0; request <= thread; ++request) {
+//          ++counters[thread].object();
+//      }
+//  }
+//
+//  int numRequests = 0;
+//  for (int thread = 0; thread < 4; ++thread) {
+//      numRequests += *counters[thread];
+//  }
+//  assert(10 == numRequests);
+//..
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#   define BSLS_CACHELINEPADDED_ALIGN                                        \
+      __declspec(align(BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE))
+#else
+#   define BSLS_CACHELINEPADDED_ALIGN                                        \
+      __attribute__((__aligned__(                                            \
+                          BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE)))
+#endif
+
+namespace BloombergLP {
+namespace bsls {
+
+                           // =====================
+                           // class CacheLinePadded
+                           // =====================
+
+template <class TYPE>
+class BSLS_CACHELINEPADDED_ALIGN CacheLinePadded {
+    // This class template holds an object of the parameterized 'TYPE', aligned
+    // on, and padded to a multiple of, the destructive interference size of
+    // the target platform.  Copying and assigning a 'CacheLinePadded' object
+    // copies and assigns the wrapped object.
+
+    // DATA
+    TYPE d_object;  // wrapped object
+
+  public:
+    // CREATORS
+    CacheLinePadded();
+        // Create a padded object holding a value-initialized 'TYPE' object.
+
+    template <class ARG>
+    explicit CacheLinePadded(const ARG& argument);
+        // Create a padded object holding a 'TYPE' object constructed from the
+        // specified 'argument'.
+
+    template <class ARG1, class ARG2>
+    CacheLinePadded(const ARG1& argument1, const ARG2& argument2);
+        // Create a padded object holding a 'TYPE' object constructed from the
+        // specified 'argument1' and 'argument2'.
+
+    // CacheLinePadded(const CacheLinePadded& original) = default;
+    // ~CacheLinePadded() = default;
+
+    // MANIPULATORS
+    // CacheLinePadded& operator=(const CacheLinePadded& rhs) = default;
+
+    TYPE& object();
+        // Return a reference providing modifiable access to the wrapped
+        // object.
+
+    TYPE& operator*();
+        // Return a reference providing modifiable access to the wrapped
+        // object.
+
+    TYPE *operator->();
+        // Return the address providing modifiable access to the wrapped
+        // object.
+
+    // ACCESSORS
+    const TYPE& object() const;
+        // Return a reference providing non-modifiable access to the wrapped
+        // object.
+
+    const TYPE& operator*() const;
+        // Return a reference providing non-modifiable access to the wrapped
+        // object.
+
+    const TYPE *operator->() const;
+        // Return the address providing non-modifiable access to the wrapped
+        // object.
+};
+
+#undef BSLS_CACHELINEPADDED_ALIGN
+
+// ============================================================================
+//                         INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                           // ---------------------
+                           // class CacheLinePadded
+                           // ---------------------
+
+// CREATORS
+template <class TYPE>
+inline
+CacheLinePadded<TYPE>::CacheLinePadded()
+: d_object()
+{
+}
+
+template <class TYPE>
+template <class ARG>
+inline
+CacheLinePadded<TYPE>::CacheLinePadded(const ARG& argument)
+: d_object(argument)
+{
+}
+
+template <class TYPE>
+template <class ARG1, class ARG2>
+inline
+CacheLinePadded<TYPE>::CacheLinePadded(const ARG1& argument1,
+                                       const ARG2& argument2)
+: d_object(argument1, argument2)
+{
+}
+
+// MANIPULATORS
+template <class TYPE>
+inline
+TYPE& CacheLinePadded<TYPE>::object()
+{
+    return d_object;
+}
+
+template <class TYPE>
+inline
+TYPE& CacheLinePadded<TYPE>::operator*()
+{
+    return d_object;
+}
+
+template <class TYPE>
+inline
+TYPE *CacheLinePadded<TYPE>::operator->()
+{
+    return &d_object;
+}
+
+// ACCESSORS
+template <class TYPE>
+inline
+const TYPE& CacheLinePadded<TYPE>::object() const
+{
+    return d_object;
+}
+
+template <class TYPE>
+inline
+const TYPE& CacheLinePadded<TYPE>::operator*() const
+{
+    return d_object;
+}
+
+template <class TYPE>
+inline
+const TYPE *CacheLinePadded<TYPE>::operator->() const
+{
+    return &d_object;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,420 @@
+// bsls_cachelinepadded.t.cpp                                         -*-C++-*-
+
+#include <bsls_cachelinepadded.h>
+
+#include <bsls_alignmentfromtype.h>  // for testing only
+#include <bsls_bsltestutil.h>        // for testing only
+#include <bsls_performancehint.h>    // for testing only
+#include <bsls_types.h>              // for testing only
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace BloombergLP;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides a wrapper aligning and padding an object.
+// We verify the size and alignment of the wrapper for wrapped types of
+// various sizes, that the elements of an array of wrappers are in distinct
+// cache lines, and that the constructors pass their arguments to the wrapped
+// object, which the accessors and manipulators refer to.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 3] CacheLinePadded();
+// [ 3] CacheLinePadded(const ARG& argument);
+// [ 3] CacheLinePadded(const ARG1& argument1, const ARG2& argument2);
+// [ 3] CacheLinePadded(const CacheLinePadded& original);
+//
+// MANIPULATORS
+// [ 3] CacheLinePadded& operator=(const CacheLinePadded& rhs);
+// [ 3] TYPE& object();
+// [ 3] TYPE& operator*();
+// [ 3] TYPE *operator->();
+//
+// ACCESSORS
+// [ 3] const TYPE& object() const;
+// [ 3] const TYPE& operator*() const;
+// [ 3] const TYPE *operator->() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 2] SIZE AND ALIGNMENT
+// [ 4] USAGE EXAMPLE
+
+// ============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static const int k_SIZE = BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE;
+
+template <int SIZE>
+struct Bytes {
+    // This 'struct' has the specified 'SIZE'.
+
+    char d_bytes[SIZE];
+};
+
+struct Point {
+    // This 'struct' has a default constructor, and constructors taking one
+    // and two arguments.
+
+    int d_x;
+    int d_y;
+
+    Point() : d_x(-1), d_y(-1) {}
+    explicit Point(int x) : d_x(x), d_y(0) {}
+    Point(int x, int y) : d_x(x), d_y(y) {}
+};
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+template <class TYPE>
+void testSizeAndAlignment(int line)
+    // Verify the size and alignment of 'bsls::CacheLinePadded<TYPE>', and
+    // that the elements of an array of 'bsls::CacheLinePadded<TYPE>' are
+    // aligned on, and at least 'k_SIZE' bytes apart from, each other,
+    // reporting failures with the specified 'line'.
+{
+    typedef bsls::CacheLinePadded<TYPE> Obj;
+
+    const int SIZE      = static_cast<int>(sizeof(Obj));
+    const int ALIGNMENT = bsls::AlignmentFromType<Obj>::VALUE;
+
+    ASSERTV(line, ALIGNMENT, k_SIZE == ALIGNMENT);
+    ASSERTV(line, SIZE, 0 == SIZE % k_SIZE);
+    ASSERTV(line, SIZE, sizeof(TYPE) <= sizeof(Obj));
+    ASSERTV(line, SIZE, sizeof(Obj) < sizeof(TYPE) + k_SIZE);
+
+    Obj array[3];
+    for (int i = 0; i < 3; ++i) {
+        const char *address = reinterpret_cast<const char *>(&array[i]);
+        const bsls::Types::UintPtr value =
+                               reinterpret_cast<bsls::Types::UintPtr>(address);
+
+        ASSERTV(line, i, 0 == value % k_SIZE);
+        ASSERTV(line, i, reinterpret_cast<const char *>(&array[i].object())
+                                                                   == address);
+    }
+}
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    (void)veryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Per-Thread Counters
+/// - - - - - - - - - - - - - - -
+// Suppose that each thread of a server counts the requests it processes in
+// its own element of an array, so that the threads do not contend on a single
+// counter.
+//
+// First, we note that the elements of an array of 'int' share cache lines:
+// each increment by a thread evicts the counters of the other threads from
+// the caches of their processors, and the threads contend as if they shared a
+// single counter:
+//..
+    int sharedCounters[4];
+    ASSERT(&sharedCounters[1] - &sharedCounters[0] == 1);
+//..
+// Then, we define the array with each counter padded instead:
+//..
+    bsls::CacheLinePadded<int> counters[4];
+//..
+// Now, the counters are each alone in their cache lines:
+//..
+    const char *first  = reinterpret_cast<const char *>(&counters[0]);
+    const char *second = reinterpret_cast<const char *>(&counters[1]);
+    ASSERT(BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE
+                                                           <= second - first);
+//..
+// Finally, each thread increments its counter through the wrapper, and the
+// counters are summed as usual:
+//..
+    for (int thread = 0; thread < 4; ++thread) {
+        *counters[thread] = 0;
+        for (int request = 0; request <= thread; ++request) {
+            ++counters[thread].object();
+        }
+    }
+
+    int numRequests = 0;
+    for (int thread = 0; thread < 4; ++thread) {
+        numRequests += *counters[thread];
+    }
+    ASSERT(10 == numRequests);
+//..
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CREATORS, MANIPULATORS, AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 The default constructor value-initializes the wrapped object.
+        //:
+        //: 2 The other constructors pass their arguments to the constructor
+        //:   of the wrapped object.
+        //:
+        //: 3 Copying and assigning copies and assigns the wrapped object.
+        //:
+        //: 4 The manipulators and accessors refer to the wrapped object, with
+        //:   the appropriate constness.
+        //
+        // Plan:
+        //: 1 Create objects wrapping 'int' and 'Point' with each constructor,
+        //:   and verify the value of the wrapped object.  (C-1..2)
+        //:
+        //: 2 Copy and assign objects, and verify the values of the wrapped
+        //:   objects.  (C-3)
+        //:
+        //: 3 Modify the wrapped object through each manipulator, and read it
+        //:   through each accessor.  (C-4)
+        //
+        // Testing:
+        //   CacheLinePadded();
+        //   CacheLinePadded(const ARG& argument);
+        //   CacheLinePadded(const ARG1& argument1, const ARG2& argument2);
+        //   CacheLinePadded(const CacheLinePadded& original);
+        //   CacheLinePadded& operator=(const CacheLinePadded& rhs);
+        //   TYPE& object();
+        //   TYPE& operator*();
+        //   TYPE *operator->();
+        //   const TYPE& object() const;
+        //   const TYPE& operator*() const;
+        //   const TYPE *operator->() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCREATORS, MANIPULATORS, AND ACCESSORS"
+                            "\n=====================================\n");
+
+        if (verbose) printf("\tConstructors.\n");
+        {
+            const bsls::CacheLinePadded<int> I0;
+            const bsls::CacheLinePadded<int> I1(42);
+
+            ASSERT( 0 == I0.object());
+            ASSERT(42 == I1.object());
+
+            const bsls::CacheLinePadded<Point> P0;
+            const bsls::CacheLinePadded<Point> P1(3);
+            const bsls::CacheLinePadded<Point> P2(3, 4);
+
+            ASSERT(-1 == P0->d_x);  ASSERT(-1 == P0->d_y);
+            ASSERT( 3 == P1->d_x);  ASSERT( 0 == P1->d_y);
+            ASSERT( 3 == P2->d_x);  ASSERT( 4 == P2->d_y);
+        }
+
+        if (verbose) printf("\tCopy and assignment.\n");
+        {
+            const bsls::CacheLinePadded<Point> X(1, 2);
+
+            bsls::CacheLinePadded<Point> mY(X);
+            const bsls::CacheLinePadded<Point>& Y = mY;
+            ASSERT(1 == Y->d_x);  ASSERT(2 == Y->d_y);
+
+            bsls::CacheLinePadded<Point> mZ;
+            const bsls::CacheLinePadded<Point>& Z = mZ;
+            ASSERT(&mZ == &(mZ = X));
+            ASSERT(1 == Z->d_x);  ASSERT(2 == Z->d_y);
+        }
+
+        if (verbose) printf("\tManipulators and accessors.\n");
+        {
+            bsls::CacheLinePadded<Point> mX;
+            const bsls::CacheLinePadded<Point>& X = mX;
+
+            ASSERT(&mX.object() == &*mX);
+            ASSERT(&mX.object() == mX.operator->());
+            ASSERT(&mX.object() == &X.object());
+            ASSERT(&X.object()  == &*X);
+            ASSERT(&X.object()  == X.operator->());
+
+            mX.object().d_x = 5;
+            (*mX).d_y       = 6;
+            ASSERT(5 == X.object().d_x);  ASSERT(6 == (*X).d_y);
+
+            mX->d_x = 7;
+            ASSERT(7 == X->d_x);
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // SIZE AND ALIGNMENT
+        //
+        // Concerns:
+        //: 1 The alignment of the wrapper is the destructive interference
+        //:   size, and its size is the smallest multiple of the destructive
+        //:   interference size holding the wrapped object.
+        //:
+        //: 2 The wrapped object is at the start of the wrapper.
+        //:
+        //: 3 The elements of an array of wrappers are aligned.
+        //:
+        //: 4 The destructive interference size is a power of two, and is a
+        //:   multiple of the cache line size.
+        //
+        // Plan:
+        //: 1 For wrapped types of various sizes, smaller and larger than the
+        //:   destructive interference size, verify the size and alignment of
+        //:   the wrapper, and the addresses of the elements of an array of
+        //:   wrappers.  (C-1..3)
+        //:
+        //: 2 Verify the values of the macros.  (C-4)
+        //
+        // Testing:
+        //   SIZE AND ALIGNMENT
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nSIZE AND ALIGNMENT"
+                            "\n==================\n");
+
+        if (verbose) P(k_SIZE);
+
+        const int LINE_SIZE = BSLS_PERFORMANCEHINT_CACHE_LINE_SIZE;
+
+        ASSERTV(k_SIZE, 0 == (k_SIZE & (k_SIZE - 1)));
+        ASSERTV(k_SIZE, LINE_SIZE, 0 == k_SIZE % LINE_SIZE);
+
+        testSizeAndAlignment<char>(L_);
+        testSizeAndAlignment<int>(L_);
+        testSizeAndAlignment<double>(L_);
+        testSizeAndAlignment<Point>(L_);
+        testSizeAndAlignment<Bytes<k_SIZE - 1> >(L_);
+        testSizeAndAlignment<Bytes<k_SIZE> >(L_);
+        testSizeAndAlignment<Bytes<k_SIZE + 1> >(L_);
+        testSizeAndAlignment<Bytes<3 * k_SIZE + 7> >(L_);
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The component is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a wrapped 'int', modify it, and verify its value and the
+        //:   size of the wrapper.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        bsls::CacheLinePadded<int> mX(1);
+        const bsls::CacheLinePadded<int>& X = mX;
+
+        ASSERT(1 == *X);
+
+        ++*mX;
+        ASSERT(2 == X.object());
+
+        ASSERT(k_SIZE == sizeof X);
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -17,12 +17,20 @@ BSLS_IDENT("$Id: $")
 //  BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(X): 'X' probably evaluates to zero
 //  BSLS_PERFORMANCEHINT_PREDICT_EXPECT(X, Y): 'X' probably evaluates to 'Y'
 //  BSLS_PERFORMANCEHINT_UNLIKELY_HINT: annotate block unlikely to be taken
+//  BSLS_PERFORMANCEHINT_CACHE_LINE_SIZE: size of a data cache line
+//  BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE: false-sharing distance
+//
+//@SEE_ALSO: bsls_cachelinepadded
 //
 //@DESCRIPTION: This component provides performance hints for the compiler or
 // hardware.  There are currently two types of hints that are supported:
 //: o branch prediction
 //: o data cache prefetching
 //
+// This component also provides the sizes, for the target platform, of a data
+// cache line, and of the distance between two objects needed to avoid false
+// sharing.
+//
 ///Branch Prediction
 ///-----------------
 // The three macros provided, 'BSLS_PERFORMANCEHINT_PREDICT_LIKELY',
@@ -119,6 +127,21 @@ BSLS_IDENT("$Id: $")
 //  prefetchForWriting(address)      Prefetches one cache line worth of data at
 //                                   the specified 'address' for writing.
 //..
+// The functions 'prefetchLinesForReading' and 'prefetchLinesForWriting'
+// prefetch a given number of consecutive cache lines, starting with the line
+// holding a given address, e.g., to prefetch an object spanning several
+// lines:
+//..
+//        Function Name                      Description of Function
+//  --------------------------       ------------------------------------------
+//  prefetchLinesForReading(         Prefetches the specified 'numLines' cache
+//                address, numLines) lines starting at the specified 'address'
+//                                   for reading.
+//
+//  prefetchLinesForWriting(         Prefetches the specified 'numLines' cache
+//                address, numLines) lines starting at the specified 'address'
+//                                   for writing.
+//..
 ///Warning
 ///- - - -
 // These functions must be used *with* *caution*.  Inappropriate use of these
@@ -128,6 +151,24 @@ BSLS_IDENT("$Id: $")
 // used to understand the program's behavior before attempting to optimize with
 // these functions.
 //
+///Cache Line Size and False Sharing
+///---------------------------------
+// 'BSLS_PERFORMANCEHINT_CACHE_LINE_SIZE' is the size, in bytes, of a data
+// cache line of the target processor (i.e., the unit in which memory is
+// transferred to and from the data caches), and the stride of
+// 'prefetchLinesForReading' and 'prefetchLinesForWriting'.
+//
+// 'BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE' is the minimum
+// distance, in bytes, between the addresses of two objects written by
+// different threads needed for the objects to not *false-share* (i.e., for the
+// writes of one thread to not evict the object of the other thread from the
+// cache of its processor).  It may exceed the cache line size: e.g., x86
+// processors fetch pairs of adjacent cache lines, hence the value of 128 on
+// these processors.  Both macros expand to integer literals, so that they can
+// be used in preprocessor expressions and in alignment attributes.  See
+// 'bsls_cachelinepadded' for a wrapper type placing an object alone in its
+// cache lines.
+//
 ///Usage
 ///-----
 // The following series of examples illustrates use of the macros and functions
@@ -395,6 +436,25 @@ namespace BloombergLP {
 
 #endif
 
+             // ==================================================
+             // BSLS_PERFORMANCEHINT_CACHE_LINE_SIZE
+             // BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE
+             // ==================================================
+
+#if defined(BSLS_PLATFORM_CPU_POWERPC)
+    #define BSLS_PERFORMANCEHINT_CACHE_LINE_SIZE                128
+#else
+    #define BSLS_PERFORMANCEHINT_CACHE_LINE_SIZE                 64
+#endif
+
+#if defined(BSLS_PLATFORM_CPU_X86)                                            \
+ || defined(BSLS_PLATFORM_CPU_X86_64)                                         \
+ || defined(BSLS_PLATFORM_CPU_POWERPC)
+    #define BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE  128
+#else
+    #define BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE   64
+#endif
+
 #if defined(BDE_BUILD_TARGET_OPT) && defined(BSLS_PLATFORM_CMP_SUN)
     #define BSLS_PERFORMANCEHINT_UNLIKELY_HINT                                \
                              BloombergLP::bsls::PerformanceHint::rarelyCalled()
@@ -428,6 +488,18 @@ struct PerformanceHint {
         // level document for limitations).  Otherwise this method has no
         // effect.
 
+    static void prefetchLinesForReading(const void *address, int numLines);
+        // Prefetch, for reading, the specified 'numLines' consecutive cache
+        // lines starting with the line holding the specified 'address' if the
+        // compiler built-in is available.  Otherwise this method has no
+        // effect.  The behavior is undefined unless '0 <= numLines'.
+
+    static void prefetchLinesForWriting(void *address, int numLines);
+        // Prefetch, for writing, the specified 'numLines' consecutive cache
+        // lines starting with the line holding the specified 'address' if the
+        // compiler built-in is available.  Otherwise this method has no
+        // effect.  The behavior is undefined unless '0 <= numLines'.
+
     static void rarelyCalled();
         // This is an empty function that is marked as rarely called using
         // pragmas.  If this function is placed in a block of code inside a
@@ -529,6 +601,27 @@ void PerformanceHint::prefetchForWriting(void *address)
 #endif
 }
 
+inline
+void PerformanceHint::prefetchLinesForReading(const void *address,
+                                              int         numLines)
+{
+    const char *line = static_cast<const char *>(address);
+    for (int i = 0; i < numLines; ++i) {
+        prefetchForReading(line);
+        line += BSLS_PERFORMANCEHINT_CACHE_LINE_SIZE;
+    }
+}
+
+inline
+void PerformanceHint::prefetchLinesForWriting(void *address, int numLines)
+{
+    char *line = static_cast<char *>(address);
+    for (int i = 0; i < numLines; ++i) {
+        prefetchForWriting(line);
+        line += BSLS_PERFORMANCEHINT_CACHE_LINE_SIZE;
+    }
+}
+
 // This function must be inlined for the pragma to take effect on the branch
 // prediction.
 inline
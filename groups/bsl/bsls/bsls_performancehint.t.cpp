@@ -46,6 +46,10 @@ using namespace bsls;
 //                     'BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY'
 // [ 2] Usage Example: Using 'BSLS_PERFORMANCEHINT_PREDICT_EXPECT'
 // [ 3] Usage Example: Using 'prefetchForReading' and 'prefetchForWriting'
+// [ 5] void prefetchLinesForReading(const void *address, int numLines);
+// [ 5] void prefetchLinesForWriting(void *address, int numLines);
+// [ 5] BSLS_PERFORMANCEHINT_CACHE_LINE_SIZE
+// [ 5] BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE
 //-----------------------------------------------------------------------------
 // [-1] Performance Test: Verifies the performance of test 1, 2, 3
 //-----------------------------------------------------------------------------
@@ -550,6 +554,77 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:  // Zero is always the leading case.
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING CACHE LINES
+        //
+        // Concerns:
+        //: 1 The cache line size and the destructive interference size are
+        //:   powers of two, usable in preprocessor expressions, and the
+        //:   destructive interference size is a multiple of the cache line
+        //:   size.
+        //:
+        //: 2 'prefetchLinesForReading' and 'prefetchLinesForWriting' do not
+        //:   modify the prefetched memory, and have no effect for 0 lines.
+        //
+        // Plan:
+        //: 1 Verify the values of the macros, in preprocessor expressions and
+        //:   at run time.  (C-1)
+        //:
+        //: 2 Prefetch the lines of an array, and of an empty range, and verify
+        //:   the contents of the array.  (C-2)
+        //
+        // Testing:
+        //   void prefetchLinesForReading(const void *address, int numLines);
+        //   void prefetchLinesForWriting(void *address, int numLines);
+        //   BSLS_PERFORMANCEHINT_CACHE_LINE_SIZE
+        //   BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING CACHE LINES"
+                            "\n===================\n");
+
+#if BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE                        \
+                                       < BSLS_PERFORMANCEHINT_CACHE_LINE_SIZE
+#error "The destructive interference size is less than a cache line."
+#endif
+
+        const int LINE_SIZE = BSLS_PERFORMANCEHINT_CACHE_LINE_SIZE;
+        const int SIZE      =
+                            BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE;
+
+        if (veryVerbose) { P_(LINE_SIZE) P(SIZE) }
+
+        ASSERTV(LINE_SIZE, 0 == (LINE_SIZE & (LINE_SIZE - 1)));
+        ASSERTV(SIZE,      0 == (SIZE & (SIZE - 1)));
+        ASSERTV(LINE_SIZE, SIZE, 0 == SIZE % LINE_SIZE);
+
+        enum { k_NUM_LINES = 8 };
+
+        static char buffer[k_NUM_LINES * BSLS_PERFORMANCEHINT_CACHE_LINE_SIZE];
+        for (int i = 0; i < static_cast<int>(sizeof buffer); ++i) {
+            buffer[i] = static_cast<char>(i);
+        }
+
+        for (int numLines = 0; numLines <= k_NUM_LINES; ++numLines) {
+            BloombergLP::bsls::PerformanceHint::prefetchLinesForReading(
+                                                                    buffer,
+                                                                    numLines);
+            BloombergLP::bsls::PerformanceHint::prefetchLinesForWriting(
+                                                                    buffer,
+                                                                    numLines);
+        }
+
+        // A misaligned address prefetches the line holding it.
+
+        BloombergLP::bsls::PerformanceHint::prefetchLinesForReading(
+                                                                   buffer + 1,
+                                                                   2);
+
+        for (int i = 0; i < static_cast<int>(sizeof buffer); ++i) {
+            ASSERTV(i, static_cast<char>(i) == buffer[i]);
+        }
+      } break;
       case 4: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE 3
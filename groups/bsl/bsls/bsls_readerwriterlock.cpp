@@ -0,0 +1,115 @@
+// bsls_readerwriterlock.cpp                                          -*-C++-*-
+#include <bsls_readerwriterlock.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bsls_bsltestutil.h>  // for testing only
+#include <bsls_waitutil.h>
+
+namespace BloombergLP {
+namespace bsls {
+
+                           // ----------------------
+                           // class ReaderWriterLock
+                           // ----------------------
+
+// PRIVATE MANIPULATORS
+void ReaderWriterLock::lockReadContended()
+{
+    int numSpins = 0;
+    do {
+        int state = AtomicOperations::getIntRelaxed(&d_state);
+
+        if (0 == (state & (k_WRITER | k_WAITING_WRITER_MASK))) {
+            if (state == AtomicOperations::testAndSwapIntAcqRel(
+                                                         &d_state,
+                                                         state,
+                                                         state + k_READER)) {
+                return;                                               // RETURN
+            }
+            continue;
+        }
+
+        if (numSpins < k_SPIN_COUNT) {
+            ++numSpins;
+            WaitUtil::pause();
+            continue;
+        }
+
+        // Flag that a reader is blocked, so that 'unlockWrite' wakes it.  The
+        // flag is cleared by the writer releasing the lock, which a waiting
+        // writer (or the writer holding the lock) is bound to do.
+
+        if (0 == (state & k_BLOCKED_READERS)) {
+            if (state != AtomicOperations::testAndSwapIntAcqRel(
+                                                 &d_state,
+                                                 state,
+                                                 state | k_BLOCKED_READERS)) {
+                continue;
+            }
+            state |= k_BLOCKED_READERS;
+        }
+
+        WaitUtil::wait(&d_state, state);
+    } while (true);
+}
+
+void ReaderWriterLock::lockWriteContended()
+{
+    // Register as a waiting writer, which prevents new readers from acquiring
+    // the lock, and ensures that the last reader releasing the lock, or
+    // 'unlockWrite', wakes this thread.
+
+    AtomicOperations::addIntAcqRel(&d_state, k_WAITING_WRITER);
+
+    int numSpins = 0;
+    do {
+        const int state = AtomicOperations::getIntRelaxed(&d_state);
+
+        if (0 == (state & (k_WRITER | k_READER_MASK))) {
+            if (state == AtomicOperations::testAndSwapIntAcqRel(
+                                       &d_state,
+                                       state,
+                                       state - k_WAITING_WRITER + k_WRITER)) {
+                return;                                               // RETURN
+            }
+            continue;
+        }
+
+        if (numSpins < k_SPIN_COUNT) {
+            ++numSpins;
+            WaitUtil::pause();
+            continue;
+        }
+
+        WaitUtil::wait(&d_state, state);
+    } while (true);
+}
+
+void ReaderWriterLock::wakeAll()
+{
+    // Readers and writers block on the same integer: waking only one thread
+    // could wake a reader that blocks again, while a writer stays blocked.
+
+    WaitUtil::wakeAll(&d_state);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,497 @@
+// bsls_readerwriterlock.h                                            -*-C++-*-
+#ifndef INCLUDED_BSLS_READERWRITERLOCK
+#define INCLUDED_BSLS_READERWRITERLOCK
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a writer-preferring reader/writer lock for use below bslmt.
+//
+//@CLASSES:
+//  bsls::ReaderWriterLock: writer-preferring reader/writer lock
+//  bsls::ReadLockGuard: RAII mechanism for read-locking a 'ReaderWriterLock'
+//  bsls::WriteLockGuard: RAII mechanism for write-locking a 'ReaderWriterLock'
+//
+//@SEE_ALSO: bsls_adaptivelock, bsls_bsllock, bsls_waitutil
+//
+//@DESCRIPTION: This component provides a reader/writer lock,
+// 'bsls::ReaderWriterLock', for use below 'bslmt', allowing any number of
+// threads to hold the lock for reading (*shared* access) at the same time,
+// or one thread to hold it for writing (*exclusive* access).  It is intended
+// to protect data that are read much more often than they are modified (such
+// as caches of reference data), whose readers would otherwise be serialized
+// by a mutex.
+//
+// This component also provides the 'bsls::ReadLockGuard' and
+// 'bsls::WriteLockGuard' classes, mechanisms that follow the RAII idiom for
+// automatically acquiring and releasing the lock on an associated
+// 'bsls::ReaderWriterLock' object, respectively for reading and for writing.
+//
+///Writer Preference
+///-----------------
+// The lock prefers writers: as soon as a thread attempts to acquire the lock
+// for writing, threads attempting to acquire it for reading wait, even if the
+// lock is held for reading, until the writers waiting at that time have
+// acquired and released the lock.  A writer therefore cannot be starved by a
+// continuous stream of readers (but readers can be starved by a continuous
+// stream of writers).  A consequence is that the lock is *not* recursive for
+// readers: a thread holding the lock for reading and attempting to acquire
+// it again for reading can deadlock if a writer is waiting in between.
+//
+///Performance
+///-----------
+// The state of a 'bsls::ReaderWriterLock' is a single atomic integer, which
+// requires no resources of the operating system.  Acquiring and releasing
+// the lock without contention each cost one atomic read-modify-write
+// operation, without a function call.  (Readers sharing the lock do not
+// contend with each other, except for the cache line of the lock.)
+//
+// A thread that cannot acquire the lock spins for up to 'k_SPIN_COUNT'
+// iterations (with 'bsls::WaitUtil::pause'), then blocks with
+// 'bsls::WaitUtil::wait' (i.e., on a 'futex' on Linux).  Releasing the lock
+// makes a system call only if a thread is blocked on it.
+//
+// A lock supports up to 65535 threads holding it for reading, and up to 8191
+// threads waiting to acquire it for writing, at the same time.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: A Read-Mostly Cache
+/// - - - - - - - - - - - - - - -
+// Suppose that we want a cache of reference data, looked up by many threads
+// and updated rarely.
+//
+// First, we define the cache, whose lookups acquire a 'bsls::ReaderWriterLock'
+// for reading, and whose updates acquire it for writing:
+//..
+//  class my_RateCache {
+//      // This class maintains the exchange rates of a small number of
+//      // currencies.
+//
+//      // DATA
+//      mutable bsls::ReaderWriterLock d_lock;      // protects 'd_rates'
+//      double                         d_rates[8];  // rate of each currency
+//
+//    public:
+//      // CREATORS
+//      my_RateCache()
+//      {
+//          for (int i = 0; i < 8; ++i) {
+//              d_rates[i] = 1.0;
+//          }
+//      }
+//
+//      // MANIPULATORS
+//      void setRate(int currency, double rate)
+//      {
+//          bsls::WriteLockGuard guard(&d_lock);
+//          d_rates[currency] = rate;
+//      }
+//
+//      // ACCESSORS
+//      double rate(int currency) const
+//      {
+//          bsls::ReadLockGuard guard(&d_lock);
+//          return d_rates[currency];
+//      }
+//  };
+//..
+// Then, we update the cache, and look a rate up:
+//..
+//  my_RateCache cache;
+//
+//  cache.setRate(3, 1.25);
+//
+//  assert(1.25 == cache.rate(3));
+//  assert(1.0  == cache.rate(4));
+//..
+// Note that any number of threads can call 'rate' concurrently without
+// waiting for one another.
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMICOPERATIONS
+#include <bsls_atomicoperations.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+namespace BloombergLP {
+namespace bsls {
+
+                           // ======================
+                           // class ReaderWriterLock
+                           // ======================
+
+class ReaderWriterLock {
+    // This 'class' implements a writer-preferring reader/writer lock that
+    // spins briefly before blocking the calling thread.
+
+    // PRIVATE TYPES
+    enum {
+        // The state of the lock is the sum of the following values.
+
+        k_READER             = 1,          // a thread holds the lock for
+                                           // reading
+        k_READER_MASK        = 0xFFFF,     // number of readers
+
+        k_WAITING_WRITER     = 1 << 16,    // a thread waits to acquire the
+                                           // lock for writing
+        k_WAITING_WRITER_MASK
+                             = 0x1FFF << 16,
+                                           // number of waiting writers
+
+        k_WRITER             = 1 << 29,    // a thread holds the lock for
+                                           // writing
+
+        k_BLOCKED_READERS    = 1 << 30     // threads may be blocked waiting
+                                           // to acquire the lock for reading
+    };
+
+    // DATA
+    AtomicOperations::AtomicTypes::Int d_state;  // state of the lock (see
+                                                 // above)
+
+  private:
+    // NOT IMPLEMENTED
+    ReaderWriterLock(const ReaderWriterLock&);             // = delete
+    ReaderWriterLock& operator=(const ReaderWriterLock&);  // = delete
+
+    // PRIVATE MANIPULATORS
+    void lockReadContended();
+        // Acquire the lock on this object for reading, when it could not be
+        // acquired immediately, spinning and blocking as required.
+
+    void lockWriteContended();
+        // Acquire the lock on this object for writing, when it could not be
+        // acquired immediately, spinning and blocking as required.
+
+    void wakeAll();
+        // Wake all of the threads blocked on this object.
+
+  public:
+    // TYPES
+    enum {
+        k_SPIN_COUNT = 100  // maximum number of times a thread examines a
+                            // lock it cannot acquire before blocking
+    };
+
+    // CREATORS
+    ReaderWriterLock();
+        // Create a lock object in the unlocked state.
+
+    //! ~ReaderWriterLock() = default;
+        // Destroy this lock object.  The behavior is undefined unless this
+        // object is in the unlocked state.
+
+    // MANIPULATORS
+    void lockRead();
+        // Acquire the lock on this object for reading.  If this object is
+        // locked for writing, or a thread is waiting to lock it for writing,
+        // suspend execution of the calling thread until the lock can be
+        // acquired.  The behavior is undefined unless the calling thread does
+        // not already hold the lock on this object.
+
+    void lockWrite();
+        // Acquire the lock on this object for writing.  If this object is
+        // locked (for reading or for writing), suspend execution of the
+        // calling thread until the lock can be acquired.  The behavior is
+        // undefined unless the calling thread does not already hold the lock
+        // on this object.
+
+    int tryLockRead();
+        // Attempt to acquire the lock on this object for reading, without
+        // blocking.  Return 0 on success, and a non-zero value if this object
+        // is locked for writing, or a thread is waiting to lock it for
+        // writing.
+
+    int tryLockWrite();
+        // Attempt to acquire the lock on this object for writing, without
+        // blocking.  Return 0 on success, and a non-zero value if this object
+        // is locked, or a thread is waiting to lock it for writing.
+
+    void unlockRead();
+        // Release the lock on this object for reading that was previously
+        // acquired through a call to 'lockRead' or a successful call to
+        // 'tryLockRead'.  The behavior is undefined unless the calling thread
+        // holds the lock on this object for reading.
+
+    void unlockWrite();
+        // Release the lock on this object for writing that was previously
+        // acquired through a call to 'lockWrite' or a successful call to
+        // 'tryLockWrite'.  The behavior is undefined unless the calling
+        // thread holds the lock on this object for writing.
+};
+
+                            // ===================
+                            // class ReadLockGuard
+                            // ===================
+
+class ReadLockGuard {
+    // This 'class' implements a guard for automatically acquiring and
+    // releasing the lock for reading on an associated
+    // 'bsls::ReaderWriterLock' object.
+
+    // DATA
+    ReaderWriterLock *d_lock_p;  // lock guarded by this object (held, not
+                                 // owned)
+
+  private:
+    // NOT IMPLEMENTED
+    ReadLockGuard(const ReadLockGuard&);             // = delete
+    ReadLockGuard& operator=(const ReadLockGuard&);  // = delete
+
+  public:
+    // CREATORS
+    explicit ReadLockGuard(ReaderWriterLock *lock);
+        // Create a guard object that conditionally manages the specified
+        // 'lock', and acquires the lock on 'lock' for reading by invoking its
+        // 'lockRead' method.  The behavior is undefined unless the calling
+        // thread does not already hold the lock on 'lock'.  Note that 'lock'
+        // must remain valid throughout the lifetime of this guard, or until
+        // 'release' is called.
+
+    ~ReadLockGuard();
+        // Destroy this guard object and release the lock on the object it
+        // manages (if any) by invoking its 'unlockRead' method.  If no lock
+        // is currently being managed, this method has no effect.
+
+    // MANIPULATORS
+    void release();
+        // Release from management, with no effect, the object currently
+        // managed by this guard, if any.  Note that 'unlockRead' is *not*
+        // called on the managed object upon its release.
+};
+
+                           // ====================
+                           // class WriteLockGuard
+                           // ====================
+
+class WriteLockGuard {
+    // This 'class' implements a guard for automatically acquiring and
+    // releasing the lock for writing on an associated
+    // 'bsls::ReaderWriterLock' object.
+
+    // DATA
+    ReaderWriterLock *d_lock_p;  // lock guarded by this object (held, not
+                                 // owned)
+
+  private:
+    // NOT IMPLEMENTED
+    WriteLockGuard(const WriteLockGuard&);             // = delete
+    WriteLockGuard& operator=(const WriteLockGuard&);  // = delete
+
+  public:
+    // CREATORS
+    explicit WriteLockGuard(ReaderWriterLock *lock);
+        // Create a guard object that conditionally manages the specified
+        // 'lock', and acquires the lock on 'lock' for writing by invoking its
+        // 'lockWrite' method.  The behavior is undefined unless the calling
+        // thread does not already hold the lock on 'lock'.  Note that 'lock'
+        // must remain valid throughout the lifetime of this guard, or until
+        // 'release' is called.
+
+    ~WriteLockGuard();
+        // Destroy this guard object and release the lock on the object it
+        // manages (if any) by invoking its 'unlockWrite' method.  If no lock
+        // is currently being managed, this method has no effect.
+
+    // MANIPULATORS
+    void release();
+        // Release from management, with no effect, the object currently
+        // managed by this guard, if any.  Note that 'unlockWrite' is *not*
+        // called on the managed object upon its release.
+};
+
+// ============================================================================
+//                        INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                           // ----------------------
+                           // class ReaderWriterLock
+                           // ----------------------
+
+// CREATORS
+inline
+ReaderWriterLock::ReaderWriterLock()
+{
+    AtomicOperations::initInt(&d_state, 0);
+}
+
+// MANIPULATORS
+inline
+void ReaderWriterLock::lockRead()
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 != tryLockRead())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        lockReadContended();
+    }
+}
+
+inline
+void ReaderWriterLock::lockWrite()
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 != tryLockWrite())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        lockWriteContended();
+    }
+}
+
+inline
+int ReaderWriterLock::tryLockRead()
+{
+    int state = AtomicOperations::getIntRelaxed(&d_state);
+
+    while (0 == (state & (k_WRITER | k_WAITING_WRITER_MASK))) {
+        const int previous = AtomicOperations::testAndSwapIntAcqRel(
+                                                           &d_state,
+                                                           state,
+                                                           state + k_READER);
+        if (previous == state) {
+            return 0;                                                 // RETURN
+        }
+        state = previous;
+    }
+    return 1;
+}
+
+inline
+int ReaderWriterLock::tryLockWrite()
+{
+    return 0 == AtomicOperations::testAndSwapIntAcqRel(&d_state, 0, k_WRITER)
+           ? 0
+           : 1;
+}
+
+inline
+void ReaderWriterLock::unlockRead()
+{
+    BSLS_ASSERT_SAFE(AtomicOperations::getIntRelaxed(&d_state)
+                                                              & k_READER_MASK);
+
+    const int state = AtomicOperations::addIntNvAcqRel(&d_state, -k_READER);
+
+    // The last reader leaving wakes the waiting writers.
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                   0 == (state & k_READER_MASK)
+                                && 0 != (state & k_WAITING_WRITER_MASK))) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        wakeAll();
+    }
+}
+
+inline
+void ReaderWriterLock::unlockWrite()
+{
+    BSLS_ASSERT_SAFE(AtomicOperations::getIntRelaxed(&d_state) & k_WRITER);
+
+    int state = AtomicOperations::testAndSwapIntAcqRel(&d_state, k_WRITER, 0);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(k_WRITER != state)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        // Threads are waiting: release the lock, clearing the
+        // 'k_BLOCKED_READERS' flag, and wake them.
+
+        do {
+            const int previous = AtomicOperations::testAndSwapIntAcqRel(
+                                  &d_state,
+                                  state,
+                                  state & ~(k_WRITER | k_BLOCKED_READERS));
+            if (previous == state) {
+                break;
+            }
+            state = previous;
+        } while (true);
+
+        wakeAll();
+    }
+}
+
+                            // -------------------
+                            // class ReadLockGuard
+                            // -------------------
+
+// CREATORS
+inline
+ReadLockGuard::ReadLockGuard(ReaderWriterLock *lock)
+: d_lock_p(lock)
+{
+    BSLS_ASSERT_SAFE(lock);
+
+    d_lock_p->lockRead();
+}
+
+inline
+ReadLockGuard::~ReadLockGuard()
+{
+    if (d_lock_p) {
+        d_lock_p->unlockRead();
+    }
+}
+
+// MANIPULATORS
+inline
+void ReadLockGuard::release()
+{
+    d_lock_p = 0;
+}
+
+                           // --------------------
+                           // class WriteLockGuard
+                           // --------------------
+
+// CREATORS
+inline
+WriteLockGuard::WriteLockGuard(ReaderWriterLock *lock)
+: d_lock_p(lock)
+{
+    BSLS_ASSERT_SAFE(lock);
+
+    d_lock_p->lockWrite();
+}
+
+inline
+WriteLockGuard::~WriteLockGuard()
+{
+    if (d_lock_p) {
+        d_lock_p->unlockWrite();
+    }
+}
+
+// MANIPULATORS
+inline
+void WriteLockGuard::release()
+{
+    d_lock_p = 0;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
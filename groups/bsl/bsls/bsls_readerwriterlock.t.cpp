@@ -0,0 +1,731 @@
+// bsls_readerwriterlock.t.cpp                                        -*-C++-*-
+
+#include <bsls_readerwriterlock.h>
+
+#include <bsls_asserttest.h>     // for testing only
+#include <bsls_atomic.h>         // for testing only
+#include <bsls_bsltestutil.h>    // for testing only
+#include <bsls_platform.h>       // for testing only
+#include <bsls_types.h>          // for testing only
+#include <bsls_waitutil.h>       // for testing only
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+using namespace BloombergLP;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a writer-preferring reader/writer lock, and
+// guards for it.  We verify the state transitions of the lock observable in a
+// single thread (with 'tryLockRead' and 'tryLockWrite'), that the guards lock
+// and unlock the lock (unless released), that a waiting writer prevents new
+// readers from acquiring the lock, and that the lock provides readers with
+// shared access and writers with exclusive access when threads contend on it.
+// ----------------------------------------------------------------------------
+// 'ReaderWriterLock' class:
+// [ 2] ReaderWriterLock();
+// [ 2] ~ReaderWriterLock();
+// [ 2] void lockRead();
+// [ 2] void lockWrite();
+// [ 2] int tryLockRead();
+// [ 2] int tryLockWrite();
+// [ 2] void unlockRead();
+// [ 2] void unlockWrite();
+//
+// 'ReadLockGuard' class:
+// [ 3] explicit ReadLockGuard(ReaderWriterLock *lock);
+// [ 3] ~ReadLockGuard();
+// [ 3] void release();
+//
+// 'WriteLockGuard' class:
+// [ 3] explicit WriteLockGuard(ReaderWriterLock *lock);
+// [ 3] ~WriteLockGuard();
+// [ 3] void release();
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] USAGE EXAMPLE
+// [ 4] CONCERN: A waiting writer prevents new readers from locking.
+// [ 5] CONCERN: The lock provides exclusion to contending threads.
+
+// ============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bsls::ReaderWriterLock Obj;
+typedef bsls::ReadLockGuard    ReadGuard;
+typedef bsls::WriteLockGuard   WriteGuard;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+void sleepMilliseconds(int milliseconds)
+    // Suspend the calling thread for the specified 'milliseconds'.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    Sleep(milliseconds);
+#else
+    usleep(milliseconds * 1000);
+#endif
+}
+
+                                // -------
+                                // case 5
+                                // -------
+
+struct SharedData {
+    // This 'struct' holds the data accessed by 'readThread' and
+    // 'writeThread'.
+
+    Obj                 d_lock;        // lock protecting the members below
+    bsls::Types::Int64  d_value;       // value incremented by writers
+    bsls::Types::Int64  d_copy;        // copy of 'd_value'
+    int                 d_numIterations;
+                                       // number of iterations per thread
+    bsls::AtomicInt     d_numErrors;   // number of inconsistencies seen
+    bsls::AtomicInt     d_maxReaders;  // maximum number of concurrent
+                                       // readers seen
+    bsls::AtomicInt     d_numReaders;  // number of current readers
+};
+
+extern "C"
+void *readThread(void *arg)
+    // Repeatedly verify, holding the lock for reading, that the value and the
+    // copy of the specified 'arg' (a 'SharedData' object) are equal.
+{
+    SharedData *data = static_cast<SharedData *>(arg);
+
+    for (int i = 0; i < data->d_numIterations; ++i) {
+        ReadGuard guard(&data->d_lock);
+
+        const int numReaders = ++data->d_numReaders;
+        if (numReaders > data->d_maxReaders) {
+            data->d_maxReaders = numReaders;
+        }
+
+        const bsls::Types::Int64 value = data->d_value;
+        for (int j = 0; j < 10; ++j) {
+            bsls::WaitUtil::pause();
+        }
+        if (value != data->d_copy) {
+            ++data->d_numErrors;
+        }
+
+        --data->d_numReaders;
+    }
+    return 0;
+}
+
+extern "C"
+void *writeThread(void *arg)
+    // Repeatedly increment, holding the lock for writing, the value and the
+    // copy of the specified 'arg' (a 'SharedData' object), verifying that no
+    // reader holds the lock.
+{
+    SharedData *data = static_cast<SharedData *>(arg);
+
+    for (int i = 0; i < data->d_numIterations; ++i) {
+        WriteGuard guard(&data->d_lock);
+
+        if (0 != data->d_numReaders) {
+            ++data->d_numErrors;
+        }
+
+        // Not atomic: a reader would see the members differ, and increments
+        // would be lost, without exclusion.
+
+        const bsls::Types::Int64 value = data->d_value;
+        data->d_value = value + 1;
+        for (int j = 0; j < 10; ++j) {
+            bsls::WaitUtil::pause();
+        }
+        data->d_copy  = value + 1;
+    }
+    return 0;
+}
+
+                                // -------
+                                // case 4
+                                // -------
+
+struct WriterArgs {
+    // This 'struct' holds the arguments of 'writerThread'.
+
+    Obj             *d_lock_p;    // lock to acquire for writing
+    bsls::AtomicInt *d_locked_p;  // set to 1 once the lock is acquired
+};
+
+extern "C"
+void *writerThread(void *arg)
+    // Acquire for writing, and release, the lock described by the specified
+    // 'arg' (a 'WriterArgs' object), flagging that it was acquired.
+{
+    WriterArgs *args = static_cast<WriterArgs *>(arg);
+
+    args->d_lock_p->lockWrite();
+    *args->d_locked_p = 1;
+    args->d_lock_p->unlockWrite();
+    return 0;
+}
+
+                                // -------
+                                // case 6
+                                // -------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: A Read-Mostly Cache
+/// - - - - - - - - - - - - - - -
+// Suppose that we want a cache of reference data, looked up by many threads
+// and updated rarely.
+//
+// First, we define the cache, whose lookups acquire a 'bsls::ReaderWriterLock'
+// for reading, and whose updates acquire it for writing:
+//..
+    class my_RateCache {
+        // This class maintains the exchange rates of a small number of
+        // currencies.
+
+        // DATA
+        mutable bsls::ReaderWriterLock d_lock;      // protects 'd_rates'
+        double                         d_rates[8];  // rate of each currency
+
+      public:
+        // CREATORS
+        my_RateCache()
+        {
+            for (int i = 0; i < 8; ++i) {
+                d_rates[i] = 1.0;
+            }
+        }
+
+        // MANIPULATORS
+        void setRate(int currency, double rate)
+        {
+            bsls::WriteLockGuard guard(&d_lock);
+            d_rates[currency] = rate;
+        }
+
+        // ACCESSORS
+        double rate(int currency) const
+        {
+            bsls::ReadLockGuard guard(&d_lock);
+            return d_rates[currency];
+        }
+    };
+//..
+
+// ============================================================================
+//                              MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Then, we update the cache, and look a rate up:
+//..
+    my_RateCache cache;
+
+    cache.setRate(3, 1.25);
+
+    ASSERT(1.25 == cache.rate(3));
+    ASSERT(1.0  == cache.rate(4));
+//..
+// Note that any number of threads can call 'rate' concurrently without
+// waiting for one another.
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONTENTION
+        //
+        // Concerns:
+        //: 1 No reader holds the lock while a writer holds it, and at most one
+        //:   writer holds it at any time.
+        //:
+        //: 2 Several readers can hold the lock at the same time.
+        //:
+        //: 3 Every thread blocked on the lock is eventually woken.
+        //
+        // Plan:
+        //: 1 Have several reader threads verify, holding the lock for reading,
+        //:   that a value and a copy of it are equal, while writer threads
+        //:   increment (non-atomically) the value and the copy holding the
+        //:   lock for writing, verifying that no reader holds the lock.
+        //:   Verify that no increment was lost.  (C-1, 3)
+        //:
+        //: 2 Have reader threads only hold the lock for reading, and verify
+        //:   that no inconsistency was seen.  Where more than one processor
+        //:   is available, the maximum number of concurrent readers is
+        //:   reported in very verbose mode.  (C-2)
+        //
+        // Testing:
+        //   CONCERN: The lock provides exclusion to contending threads.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCONTENTION"
+                            "\n==========\n");
+
+        static const struct {
+            int d_line;           // source line number
+            int d_numReaders;     // number of reader threads
+            int d_numWriters;     // number of writer threads
+            int d_numIterations;  // number of iterations per thread
+        } DATA[] = {
+            //LINE  READERS  WRITERS  ITERATIONS
+            //----  -------  -------  ----------
+            { L_,         6,       2,      20000 },
+            { L_,         2,       6,      20000 },
+            { L_,         0,       8,      20000 },
+            { L_,         8,       0,      20000 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        enum { k_MAX_THREADS = 8 };
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE       = DATA[ti].d_line;
+            const int READERS    = DATA[ti].d_numReaders;
+            const int WRITERS    = DATA[ti].d_numWriters;
+            const int ITERATIONS = DATA[ti].d_numIterations;
+
+            SharedData data;
+            data.d_value         = 0;
+            data.d_copy          = 0;
+            data.d_numIterations = ITERATIONS;
+
+            ThreadId threads[k_MAX_THREADS];
+            for (int i = 0; i < READERS + WRITERS; ++i) {
+                threads[i] = createThread(i < READERS ? &readThread
+                                                      : &writeThread,
+                                          &data);
+            }
+            for (int i = 0; i < READERS + WRITERS; ++i) {
+                joinThread(threads[i]);
+            }
+
+            if (veryVerbose) { P_(LINE) P(data.d_maxReaders) }
+
+            ASSERTV(LINE, data.d_numErrors, 0 == data.d_numErrors);
+            ASSERTV(LINE,
+                    data.d_value,
+                    WRITERS * ITERATIONS == data.d_value);
+            ASSERTV(LINE, 0 == data.d_lock.tryLockWrite());
+            data.d_lock.unlockWrite();
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // WRITER PREFERENCE
+        //
+        // Concerns:
+        //: 1 A writer waiting for the readers to release the lock prevents new
+        //:   readers from acquiring the lock.
+        //:
+        //: 2 The writer acquires the lock once the last reader releases it.
+        //
+        // Plan:
+        //: 1 Holding the lock for reading, start a thread locking it for
+        //:   writing.  Wait until 'tryLockRead' fails, and verify that the
+        //:   writer has not acquired the lock.  (C-1)
+        //:
+        //: 2 Release the lock for reading, and verify that the writer
+        //:   acquires (and releases) the lock.  (C-2)
+        //
+        // Testing:
+        //   CONCERN: A waiting writer prevents new readers from locking.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nWRITER PREFERENCE"
+                            "\n=================\n");
+
+        Obj             mX;
+        bsls::AtomicInt locked(0);
+        WriterArgs      args = { &mX, &locked };
+
+        mX.lockRead();
+
+        ThreadId thread = createThread(&writerThread, &args);
+
+        // Wait (up to 10 seconds) for the writer to wait for the lock.
+
+        int numTries = 0;
+        for (; numTries < 10000; ++numTries) {
+            if (0 != mX.tryLockRead()) {
+                break;
+            }
+            mX.unlockRead();
+            sleepMilliseconds(1);
+        }
+        ASSERTV(numTries, numTries < 10000);
+        ASSERT(0 == locked);
+
+        sleepMilliseconds(10);  // let the writer block
+        ASSERT(0 == locked);
+        ASSERT(0 != mX.tryLockRead());
+        ASSERT(0 != mX.tryLockWrite());
+
+        mX.unlockRead();
+        joinThread(thread);
+
+        ASSERT(1 == locked);
+        ASSERT(0 == mX.tryLockRead());
+        mX.unlockRead();
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // GUARDS
+        //
+        // Concerns:
+        //: 1 The guards acquire the lock (for reading and for writing,
+        //:   respectively) on construction, and release it on destruction.
+        //:
+        //: 2 The guards do not release the lock on destruction after 'release'
+        //:   is called.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create guards, verify with 'tryLockRead' and 'tryLockWrite' that
+        //:   the lock is held as expected, and verify that the lock is
+        //:   released once the guards are destroyed.  (C-1)
+        //:
+        //: 2 Create guards, call 'release', and verify that the lock is still
+        //:   held once the guards are destroyed.  (C-2)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a null lock, and for unlocking a lock that is not
+        //:   held.  (C-3)
+        //
+        // Testing:
+        //   explicit ReadLockGuard(ReaderWriterLock *lock);
+        //   ~ReadLockGuard();
+        //   void release();
+        //   explicit WriteLockGuard(ReaderWriterLock *lock);
+        //   ~WriteLockGuard();
+        //   void release();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nGUARDS"
+                            "\n======\n");
+
+        Obj mX;
+
+        {
+            ReadGuard guard1(&mX);
+            ReadGuard guard2(&mX);
+            ASSERT(0 != mX.tryLockWrite());
+        }
+        ASSERT(0 == mX.tryLockWrite());
+        mX.unlockWrite();
+
+        {
+            WriteGuard guard(&mX);
+            ASSERT(0 != mX.tryLockRead());
+            ASSERT(0 != mX.tryLockWrite());
+        }
+        ASSERT(0 == mX.tryLockWrite());
+        mX.unlockWrite();
+
+        {
+            ReadGuard guard(&mX);
+            guard.release();
+        }
+        ASSERT(0 != mX.tryLockWrite());
+        mX.unlockRead();
+
+        {
+            WriteGuard guard(&mX);
+            guard.release();
+        }
+        ASSERT(0 != mX.tryLockRead());
+        mX.unlockWrite();
+
+        ASSERT(0 == mX.tryLockWrite());
+        mX.unlockWrite();
+
+        if (verbose) printf("\tNegative Testing.\n");
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_SAFE_FAIL(ReadGuard(0));
+            ASSERT_SAFE_FAIL(WriteGuard(0));
+
+            Obj mY;
+            ASSERT_SAFE_FAIL(mY.unlockRead());
+            ASSERT_SAFE_FAIL(mY.unlockWrite());
+
+            mY.lockRead();
+            ASSERT_SAFE_FAIL(mY.unlockWrite());
+            ASSERT_SAFE_PASS(mY.unlockRead());
+
+            mY.lockWrite();
+            ASSERT_SAFE_FAIL(mY.unlockRead());
+            ASSERT_SAFE_PASS(mY.unlockWrite());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // LOCKING AND UNLOCKING
+        //
+        // Concerns:
+        //: 1 A lock is created in the unlocked state.
+        //:
+        //: 2 Any number of 'lockRead' and successful 'tryLockRead' calls
+        //:   acquire the lock for reading, preventing it from being acquired
+        //:   for writing until each is matched by 'unlockRead'.
+        //:
+        //: 3 'lockWrite' and a successful 'tryLockWrite' acquire the lock for
+        //:   writing, preventing it from being acquired until 'unlockWrite'
+        //:   is called.
+        //:
+        //: 4 'tryLockRead' and 'tryLockWrite' fail without blocking.
+        //
+        // Plan:
+        //: 1 Using 'tryLockRead' and 'tryLockWrite' to observe the state of
+        //:   the lock, lock and unlock a lock for reading and for writing.
+        //:   (C-1..4)
+        //
+        // Testing:
+        //   ReaderWriterLock();
+        //   ~ReaderWriterLock();
+        //   void lockRead();
+        //   void lockWrite();
+        //   int tryLockRead();
+        //   int tryLockWrite();
+        //   void unlockRead();
+        //   void unlockWrite();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nLOCKING AND UNLOCKING"
+                            "\n=====================\n");
+
+        Obj mX;
+
+        if (verbose) printf("\tReading.\n");
+
+        enum { k_NUM_READERS = 5 };
+
+        for (int i = 0; i < k_NUM_READERS; ++i) {
+            if (i % 2) {
+                mX.lockRead();
+            }
+            else {
+                ASSERTV(i, 0 == mX.tryLockRead());
+            }
+            ASSERTV(i, 0 != mX.tryLockWrite());
+        }
+        for (int i = 0; i < k_NUM_READERS; ++i) {
+            ASSERTV(i, 0 != mX.tryLockWrite());
+            mX.unlockRead();
+        }
+        ASSERT(0 == mX.tryLockWrite());
+        mX.unlockWrite();
+
+        if (verbose) printf("\tWriting.\n");
+
+        ASSERT(0 == mX.tryLockWrite());
+        ASSERT(0 != mX.tryLockWrite());
+        ASSERT(0 != mX.tryLockRead());
+        mX.unlockWrite();
+
+        mX.lockWrite();
+        ASSERT(0 != mX.tryLockWrite());
+        ASSERT(0 != mX.tryLockRead());
+        mX.unlockWrite();
+
+        ASSERT(0 == mX.tryLockRead());
+        mX.unlockRead();
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The component is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Lock and unlock a lock for reading and for writing, directly and
+        //:   with guards, and from a reader and a writer thread.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        Obj mX;
+
+        mX.lockRead();
+        mX.lockRead();
+        mX.unlockRead();
+        mX.unlockRead();
+
+        mX.lockWrite();
+        mX.unlockWrite();
+
+        {
+            ReadGuard guard(&mX);
+        }
+        {
+            WriteGuard guard(&mX);
+        }
+
+        SharedData data;
+        data.d_value         = 0;
+        data.d_copy          = 0;
+        data.d_numIterations = 1000;
+
+        ThreadId thread = createThread(&writeThread, &data);
+        readThread(&data);
+        joinThread(thread);
+
+        ASSERT(0    == data.d_numErrors);
+        ASSERT(1000 == data.d_value);
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
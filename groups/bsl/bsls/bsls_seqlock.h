@@ -0,0 +1,349 @@
+// bsls_seqlock.h                                                     -*-C++-*-
+#ifndef INCLUDED_BSLS_SEQLOCK
+#define INCLUDED_BSLS_SEQLOCK
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a sequence lock publishing small bitwise-copyable values.
+//
+//@CLASSES:
+//  bsls::SeqLock: value published by writers and read without writing
+//
+//@SEE_ALSO: bsls_atomicoperations, bsls_readerwriterlock, bsls_waitutil
+//
+//@DESCRIPTION: This component provides a class template, 'bsls::SeqLock', for
+// a value of a small, bitwise-copyable 'TYPE' (e.g., a time offset, or a
+// price and its quantity) that writers replace and readers copy, without
+// locking and without allocating memory.
+//
+// A 'bsls::SeqLock' holds a copy of the value and a *sequence* number, odd
+// while a writer is replacing the value, and even otherwise.  A reader reads
+// the sequence number, copies the value, and reads the sequence number again:
+// the copy is consistent if the sequence number was even and unchanged, and
+// is otherwise discarded and retried.  Readers therefore never write to the
+// shared memory of the 'bsls::SeqLock': while no writer is active, readers on
+// any number of processors share the cache line(s) holding it, and read it
+// without any cache coherence traffic, unlike with a lock or a reference
+// count.  Conversely, a reader is delayed (spinning) for as long as a writer
+// is replacing the value, and readers can be starved by writers replacing the
+// value continuously.  Writers are serialized with each other (each spinning
+// until no other writer is active), and are never delayed by readers.
+//
+// 'TYPE' must be *bitwise-copyable*: the value is copied byte by byte (a
+// reader may copy bytes of a value being replaced, which are then discarded),
+// and its copy constructor and destructor are not invoked; on compilers
+// providing the '__is_trivially_copyable' intrinsic, instantiating
+// 'bsls::SeqLock' for a 'TYPE' that is not trivially copyable fails to
+// compile.  The value is held
+// in an array of atomic words, so that a reader racing with a writer does not
+// make a data race.  A 'bsls::SeqLock' is intended for small values (of a few
+// words), whose copy is short compared to the frequency of the writes.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Publishing the Best Price of an Instrument
+///- - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a thread receiving market data publishes the best price of an
+// instrument and the quantity available at that price, and that many threads
+// read them.  The price and quantity must be read consistently (i.e., a reader
+// must not combine a new price with an old quantity).
+//
+// First, we define the published value:
+//..
+//  struct BestPrice {
+//      // This 'struct' holds the best price of an instrument, and the
+//      // quantity available at that price.
+//
+//      double d_price;     // best price
+//      int    d_quantity;  // quantity available at 'd_price'
+//  };
+//..
+// Then, we define the sequence lock holding the best price:
+//..
+//  BestPrice                initial = { 100.0, 10 };
+//  bsls::SeqLock<BestPrice> bestPrice(initial);
+//..
+// Next, the market data thread publishes a new best price:
+//..
+//  BestPrice update = { 100.5, 20 };
+//  bestPrice.store(update);
+//..
+// Finally, a reader loads the best price, which is consistent:
+//..
+//  BestPrice current;
+//  bestPrice.load(&current);
+//  assert(100.5 == current.d_price);
+//  assert(20    == current.d_quantity);
+//..
+
+#ifndef INCLUDED_BSLS_ATOMICOPERATIONS
+#include <bsls_atomicoperations.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+#ifndef INCLUDED_BSLS_WAITUTIL
+#include <bsls_waitutil.h>
+#endif
+
+#ifndef INCLUDED_STRING_H
+#include <string.h>  // for 'memcpy'
+#define INCLUDED_STRING_H
+#endif
+
+// ============================================================================
+//                                  LOCAL MACROS
+// ============================================================================
+
+                  // ----------------------------------------
+                  // macro BSLS_SEQLOCK_IS_TRIVIALLY_COPYABLE
+                  // ----------------------------------------
+
+// We don't have access to 'bslmf::IsBitwiseCopyable' and 'BSLMF_ASSERT' here
+// in 'bsls' -- use the compiler intrinsic, where available, to check that
+// 'TYPE' can be copied byte by byte.  Note that this macro is not to be used
+// outside this file.
+
+#if defined(BSLS_PLATFORM_CMP_CLANG)                                          \
+ || (defined(BSLS_PLATFORM_CMP_GNU) && BSLS_PLATFORM_CMP_VERSION >= 50000)    \
+ || (defined(BSLS_PLATFORM_CMP_MSVC) && BSLS_PLATFORM_CMP_VERSION >= 1900)
+#define BSLS_SEQLOCK_IS_TRIVIALLY_COPYABLE(TYPE) __is_trivially_copyable(TYPE)
+#endif
+
+namespace BloombergLP {
+namespace bsls {
+
+                               // =============
+                               // class SeqLock
+                               // =============
+
+template <class TYPE>
+class SeqLock {
+    // This class template provides a value of the bitwise-copyable 'TYPE'
+    // that can be replaced by writers and copied by readers concurrently, the
+    // readers retrying their copy if it raced with a writer.
+
+  public:
+    // TYPES
+    typedef TYPE ValueType;  // type of the published value
+
+  private:
+    // PRIVATE TYPES
+    typedef AtomicOperations::AtomicTypes::Int Word;
+
+    enum {
+        k_NUM_WORDS = (sizeof(TYPE) + sizeof(int) - 1) / sizeof(int)
+                                       // number of words holding the value
+    };
+
+#if defined(BSLS_SEQLOCK_IS_TRIVIALLY_COPYABLE)
+    typedef char BitwiseCopyableCheck[
+                          BSLS_SEQLOCK_IS_TRIVIALLY_COPYABLE(TYPE) ? 1 : -1];
+        // compile-time assert that 'TYPE' is bitwise copyable
+#endif
+
+    // DATA
+    Word d_sequence;            // even if no writer is active, odd otherwise
+
+    Word d_words[k_NUM_WORDS];  // value, as an array of words
+
+    // PRIVATE CLASS METHODS
+    static int increment(int sequence);
+        // Return the specified 'sequence' number plus one, wrapping around
+        // from 'INT_MAX' to 'INT_MIN' (without the undefined behavior of
+        // signed overflow).
+
+    // PRIVATE ACCESSORS
+    void copyWords(int *buffer) const;
+        // Copy the words holding the value into the specified 'buffer', each
+        // read with acquire memory ordering.
+
+    // NOT IMPLEMENTED
+    SeqLock(const SeqLock&);
+    SeqLock& operator=(const SeqLock&);
+
+  public:
+    // CREATORS
+    SeqLock();
+        // Create a sequence lock holding a value whose bytes are all 0.
+
+    explicit SeqLock(const TYPE& value);
+        // Create a sequence lock holding a copy of the specified 'value'.
+
+    // ~SeqLock() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    void store(const TYPE& value);
+        // Replace the value held by this object with a copy of the specified
+        // 'value', spinning until no other thread is storing a value.  The
+        // readers loading the value after this function returns load 'value'
+        // (or a later one), and observe the memory operations of the calling
+        // thread that precede the call (i.e., the store has release
+        // semantics).
+
+    // ACCESSORS
+    void load(TYPE *result) const;
+        // Load into the specified 'result' a consistent copy of the value
+        // held by this object, spinning while a writer is replacing the
+        // value.  The loaded value was stored by a call to 'store' (or at
+        // construction) whose preceding memory operations are visible to the
+        // calling thread (i.e., the load has acquire semantics).
+
+    bool tryLoad(TYPE *result) const;
+        // Attempt once to load into the specified 'result' a consistent copy
+        // of the value held by this object, as 'load' does.  Return 'true' on
+        // success, and 'false' (with no effect on 'result') if a writer was
+        // replacing the value.
+};
+
+// ============================================================================
+//                          INLINE DEFINITIONS
+// ============================================================================
+
+                               // -------------
+                               // class SeqLock
+                               // -------------
+
+// PRIVATE CLASS METHODS
+template <class TYPE>
+inline
+int SeqLock<TYPE>::increment(int sequence)
+{
+    return static_cast<int>(static_cast<unsigned int>(sequence) + 1u);
+}
+
+// PRIVATE ACCESSORS
+template <class TYPE>
+inline
+void SeqLock<TYPE>::copyWords(int *buffer) const
+{
+    // Reading each word with acquire ordering ensures that the second read of
+    // 'd_sequence' observes any writer whose words were read.
+
+    for (int i = 0; i < k_NUM_WORDS; ++i) {
+        buffer[i] = AtomicOperations::getIntAcquire(&d_words[i]);
+    }
+}
+
+// CREATORS
+template <class TYPE>
+inline
+SeqLock<TYPE>::SeqLock()
+{
+    AtomicOperations::initInt(&d_sequence, 0);
+    for (int i = 0; i < k_NUM_WORDS; ++i) {
+        AtomicOperations::initInt(&d_words[i], 0);
+    }
+}
+
+template <class TYPE>
+inline
+SeqLock<TYPE>::SeqLock(const TYPE& value)
+{
+    int buffer[k_NUM_WORDS];
+    buffer[k_NUM_WORDS - 1] = 0;
+    memcpy(buffer, &value, sizeof(TYPE));
+
+    AtomicOperations::initInt(&d_sequence, 0);
+    for (int i = 0; i < k_NUM_WORDS; ++i) {
+        AtomicOperations::initInt(&d_words[i], buffer[i]);
+    }
+}
+
+// MANIPULATORS
+template <class TYPE>
+void SeqLock<TYPE>::store(const TYPE& value)
+{
+    int buffer[k_NUM_WORDS];
+    buffer[k_NUM_WORDS - 1] = 0;
+    memcpy(buffer, &value, sizeof(TYPE));
+
+    // Make the sequence number odd, waiting for any other writer to make it
+    // even.  The acquire semantics of the swap keep the stores of the words
+    // after it.
+
+    int sequence = AtomicOperations::getIntRelaxed(&d_sequence);
+    for (;;) {
+        if (0 == (sequence & 1)) {
+            const int previous = AtomicOperations::testAndSwapIntAcqRel(
+                                                                &d_sequence,
+                                                         sequence,
+                                                         increment(sequence));
+            if (previous == sequence) {
+                break;
+            }
+            sequence = previous;
+        }
+        else {
+            WaitUtil::pause();
+            sequence = AtomicOperations::getIntRelaxed(&d_sequence);
+        }
+    }
+
+    for (int i = 0; i < k_NUM_WORDS; ++i) {
+        AtomicOperations::setIntRelease(&d_words[i], buffer[i]);
+    }
+
+    AtomicOperations::setIntRelease(&d_sequence,
+                                    increment(increment(sequence)));
+}
+
+// ACCESSORS
+template <class TYPE>
+void SeqLock<TYPE>::load(TYPE *result) const
+{
+    while (!tryLoad(result)) {
+        WaitUtil::pause();
+    }
+}
+
+template <class TYPE>
+inline
+bool SeqLock<TYPE>::tryLoad(TYPE *result) const
+{
+    const int sequence = AtomicOperations::getIntAcquire(&d_sequence);
+    if (sequence & 1) {
+        return false;                                                 // RETURN
+    }
+
+    int buffer[k_NUM_WORDS];
+    copyWords(buffer);
+
+    if (sequence != AtomicOperations::getIntRelaxed(&d_sequence)) {
+        return false;                                                 // RETURN
+    }
+
+    memcpy(static_cast<void *>(result), buffer, sizeof(TYPE));
+    return true;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#undef BSLS_SEQLOCK_IS_TRIVIALLY_COPYABLE
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
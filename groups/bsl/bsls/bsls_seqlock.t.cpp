@@ -0,0 +1,582 @@
+// bsls_seqlock.t.cpp                                                 -*-C++-*-
+
+#include <bsls_seqlock.h>
+
+#include <bsls_atomic.h>            // for testing only
+#include <bsls_bsltestutil.h>       // for testing only
+#include <bsls_platform.h>          // for testing only
+#include <bsls_types.h>             // for testing only
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides a value that writers replace and readers
+// copy concurrently.  We verify that values of various sizes are stored and
+// loaded exactly, and that readers racing with writers (including several
+// writers) load only consistent values, in the order they were stored.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] SeqLock();
+// [ 2] explicit SeqLock(const TYPE& value);
+//
+// MANIPULATORS
+// [ 2] void store(const TYPE& value);
+// [ 3] void store(const TYPE& value);  // concurrent
+//
+// ACCESSORS
+// [ 2] void load(TYPE *result) const;
+// [ 2] bool tryLoad(TYPE *result) const;
+// [ 3] void load(TYPE *result) const;  // concurrent
+// [ 3] bool tryLoad(TYPE *result) const;  // concurrent
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] USAGE EXAMPLE
+
+// ============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+struct Chars3 {
+    // This 'struct' has a size that is not a multiple of the size of 'int'.
+
+    char d_chars[3];
+};
+
+struct Mixed {
+    // This 'struct' has members of distinct types (and padding).
+
+    double d_double;
+    int    d_int;
+    char   d_char;
+};
+
+struct Snapshot {
+    // This 'struct' holds a value whose members are all equal when it is
+    // consistent, and is larger than a cache line.
+
+    enum { k_NUM_MEMBERS = 12 };
+
+    bsls::Types::Int64 d_members[k_NUM_MEMBERS];
+};
+
+typedef bsls::SeqLock<Snapshot> Obj;
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+void setSnapshot(Snapshot *snapshot, bsls::Types::Int64 value)
+    // Set all of the members of the specified 'snapshot' to the specified
+    // 'value'.
+{
+    for (int i = 0; i < Snapshot::k_NUM_MEMBERS; ++i) {
+        snapshot->d_members[i] = value;
+    }
+}
+
+static
+bool isConsistent(const Snapshot& snapshot)
+    // Return 'true' if all of the members of the specified 'snapshot' are
+    // equal, and 'false' otherwise.
+{
+    for (int i = 1; i < Snapshot::k_NUM_MEMBERS; ++i) {
+        if (snapshot.d_members[i] != snapshot.d_members[0]) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+struct ThreadArgs {
+    // This 'struct' holds the arguments of 'writerThread' and 'readerThread'.
+
+    Obj                *d_seqLock_p;   // sequence lock under test
+    bsls::AtomicInt    *d_done_p;      // non-zero once the writers are done
+    bsls::Types::Int64  d_base;        // writer: base of the stored values
+    int                 d_numWrites;   // writer: number of values stored
+    bool                d_checkOrder;  // reader: verify that the values
+                                       // loaded do not decrease
+    int                 d_numErrors;   // reader (set): number of
+                                       // inconsistent or decreasing values
+                                       // loaded
+    int                 d_numLoads;    // reader (set): number of loads
+};
+
+extern "C" void *writerThread(void *arg)
+    // Store into '*d_seqLock_p' the snapshots 'd_base + 1' to
+    // 'd_base + d_numWrites', in order, as specified by the 'ThreadArgs' at
+    // the specified 'arg'.  Return 0.
+{
+    ThreadArgs *args = static_cast<ThreadArgs *>(arg);
+
+    for (int i = 1; i <= args->d_numWrites; ++i) {
+        Snapshot snapshot;
+        setSnapshot(&snapshot, args->d_base + i);
+        args->d_seqLock_p->store(snapshot);
+    }
+    return 0;
+}
+
+extern "C" void *readerThread(void *arg)
+    // Load snapshots from '*d_seqLock_p' until '*d_done_p' is non-zero, as
+    // specified by the 'ThreadArgs' at the specified 'arg', alternating
+    // 'load' and 'tryLoad', and count in 'd_numErrors' the snapshots that
+    // are inconsistent or (if 'd_checkOrder' is 'true') less than the
+    // snapshot loaded before.  Return 0.
+{
+    ThreadArgs *args = static_cast<ThreadArgs *>(arg);
+
+    bsls::Types::Int64 last = 0;
+    args->d_numErrors = 0;
+    args->d_numLoads  = 0;
+
+    while (!*args->d_done_p) {
+        Snapshot snapshot;
+
+        if (args->d_numLoads & 1) {
+            if (!args->d_seqLock_p->tryLoad(&snapshot)) {
+                continue;
+            }
+        }
+        else {
+            args->d_seqLock_p->load(&snapshot);
+        }
+        ++args->d_numLoads;
+
+        if (!isConsistent(snapshot)
+         || (args->d_checkOrder && snapshot.d_members[0] < last)) {
+            ++args->d_numErrors;
+        }
+        last = snapshot.d_members[0];
+    }
+    return 0;
+}
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+struct BestPrice {
+    // This 'struct' holds the best price of an instrument, and the quantity
+    // available at that price.
+
+    double d_price;     // best price
+    int    d_quantity;  // quantity available at 'd_price'
+};
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    (void)veryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Publishing the Best Price of an Instrument
+///- - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a thread receiving market data publishes the best price of an
+// instrument and the quantity available at that price, and that many threads
+// read them.  The price and quantity must be read consistently (i.e., a reader
+// must not combine a new price with an old quantity).
+//
+// First, we define the published value (see 'BestPrice' above, defined at
+// namespace scope in this test driver, as required of a template argument):
+//..
+//  struct BestPrice {
+//      // This 'struct' holds the best price of an instrument, and the
+//      // quantity available at that price.
+//
+//      double d_price;     // best price
+//      int    d_quantity;  // quantity available at 'd_price'
+//  };
+//..
+// Then, we define the sequence lock holding the best price:
+//..
+    BestPrice                initial = { 100.0, 10 };
+    bsls::SeqLock<BestPrice> bestPrice(initial);
+//..
+// Next, the market data thread publishes a new best price:
+//..
+    BestPrice update = { 100.5, 20 };
+    bestPrice.store(update);
+//..
+// Finally, a reader loads the best price, which is consistent:
+//..
+    BestPrice current;
+    bestPrice.load(&current);
+    ASSERT(100.5 == current.d_price);
+    ASSERT(20    == current.d_quantity);
+//..
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CONCURRENT STORES AND LOADS
+        //
+        // Concerns:
+        //: 1 Readers racing with a writer load only consistent values, which
+        //:   were stored, in the order they were stored.
+        //:
+        //: 2 Concurrent writers are serialized: readers do not load a value
+        //:   mixing the values of several writers.
+        //:
+        //: 3 'tryLoad' racing with a writer either fails or loads a consistent
+        //:   value.
+        //
+        // Plan:
+        //: 1 Using a snapshot larger than a cache line whose members are all
+        //:   equal when consistent, start reader threads alternately calling
+        //:   'load' and 'tryLoad' and verifying that the values loaded are
+        //:   consistent, and one or several writer threads each storing a
+        //:   distinct range of increasing values.  With a single writer,
+        //:   verify also that the values loaded do not decrease.  (C-1..3)
+        //:
+        //: 2 Join the writers, and verify that the final value is the last
+        //:   value stored by one of the writers.  (C-1)
+        //
+        // Testing:
+        //   void store(const TYPE& value);  // concurrent
+        //   void load(TYPE *result) const;  // concurrent
+        //   bool tryLoad(TYPE *result) const;  // concurrent
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCONCURRENT STORES AND LOADS"
+                            "\n===========================\n");
+
+        enum { k_NUM_READERS = 4, k_MAX_WRITERS = 3, k_NUM_WRITES = 50000 };
+
+        const bsls::Types::Int64 k_BASE = 1000000000000LL;
+
+        for (int numWriters = 1; numWriters <= k_MAX_WRITERS; ++numWriters) {
+            if (veryVerbose) { T_ P(numWriters) }
+
+            Snapshot initial;
+            setSnapshot(&initial, 0);
+
+            Obj             mX(initial);
+            bsls::AtomicInt done(0);
+
+            ThreadArgs readers[k_NUM_READERS];
+            ThreadArgs writers[k_MAX_WRITERS];
+            ThreadId   readerIds[k_NUM_READERS];
+            ThreadId   writerIds[k_MAX_WRITERS];
+
+            for (int i = 0; i < k_NUM_READERS; ++i) {
+                readers[i].d_seqLock_p  = &mX;
+                readers[i].d_done_p     = &done;
+                readers[i].d_checkOrder = 1 == numWriters;
+                readerIds[i] = createThread(&readerThread, &readers[i]);
+            }
+            for (int i = 0; i < numWriters; ++i) {
+                writers[i].d_seqLock_p = &mX;
+                writers[i].d_done_p    = &done;
+                writers[i].d_base      = k_BASE * (i + 1);
+                writers[i].d_numWrites = k_NUM_WRITES;
+                writerIds[i] = createThread(&writerThread, &writers[i]);
+            }
+
+            for (int i = 0; i < numWriters; ++i) {
+                joinThread(writerIds[i]);
+            }
+            done = 1;
+            for (int i = 0; i < k_NUM_READERS; ++i) {
+                joinThread(readerIds[i]);
+                ASSERTV(numWriters, i, readers[i].d_numErrors,
+                        0 == readers[i].d_numErrors);
+                if (veryVerbose) { T_ T_ P(readers[i].d_numLoads) }
+            }
+
+            Snapshot final;
+            mX.load(&final);
+            ASSERT(isConsistent(final));
+            ASSERTV(numWriters, final.d_members[0],
+                    k_NUM_WRITES == final.d_members[0] % k_BASE);
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS, MANIPULATORS, AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 The default constructor creates a value whose bytes are all 0,
+        //:   and the value constructor copies its argument.
+        //:
+        //: 2 'store' replaces the value, and 'load' and 'tryLoad' (which
+        //:   succeeds in the absence of writers) load it exactly, for types
+        //:   of sizes smaller than, equal to, not a multiple of, and larger
+        //:   than the size of 'int'.
+        //:
+        //: 3 The size of a sequence lock is the size of the value, rounded up
+        //:   to a multiple of the size of 'int', and one 'int'.
+        //
+        // Plan:
+        //: 1 For values of type 'char', 'int', 'Chars3', 'Mixed', and
+        //:   'Snapshot', create sequence locks with each constructor, store
+        //:   values, and verify the values loaded by 'load' and 'tryLoad'.
+        //:   (C-1..2)
+        //:
+        //: 2 Verify the size of sequence locks of each type.  (C-3)
+        //
+        // Testing:
+        //   SeqLock();
+        //   explicit SeqLock(const TYPE& value);
+        //   void store(const TYPE& value);
+        //   void load(TYPE *result) const;
+        //   bool tryLoad(TYPE *result) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCREATORS, MANIPULATORS, AND ACCESSORS"
+                            "\n=====================================\n");
+
+        if (verbose) printf("\t'char' and 'int'.\n");
+        {
+            const bsls::SeqLock<char> C0;
+            const bsls::SeqLock<char> C1('x');
+            char                      c = 'a';
+
+            C0.load(&c);
+            ASSERT(0 == c);
+            ASSERT(C1.tryLoad(&c));
+            ASSERT('x' == c);
+
+            bsls::SeqLock<int> mI(-7);  const bsls::SeqLock<int>& I = mI;
+            int                i = 0;
+
+            I.load(&i);
+            ASSERT(-7 == i);
+            mI.store(123456789);
+            ASSERT(I.tryLoad(&i));
+            ASSERT(123456789 == i);
+
+            ASSERT(2 * sizeof(int) == sizeof(bsls::SeqLock<char>));
+            ASSERT(2 * sizeof(int) == sizeof(bsls::SeqLock<int>));
+        }
+
+        if (verbose) printf("\t'Chars3' and 'Mixed'.\n");
+        {
+            const Chars3 A = { { 'a', 'b', 'c' } };
+            const Chars3 B = { { 'x', 'y', 'z' } };
+
+            bsls::SeqLock<Chars3> mC(A);  const bsls::SeqLock<Chars3>& C = mC;
+            Chars3                c = { { 0, 0, 0 } };
+
+            C.load(&c);
+            ASSERT('a' == c.d_chars[0]);  ASSERT('c' == c.d_chars[2]);
+
+            mC.store(B);
+            ASSERT(C.tryLoad(&c));
+            ASSERT('x' == c.d_chars[0]);  ASSERT('y' == c.d_chars[1]);
+            ASSERT('z' == c.d_chars[2]);
+
+            ASSERT(2 * sizeof(int) == sizeof(bsls::SeqLock<Chars3>));
+
+            bsls::SeqLock<Mixed> mM;  const bsls::SeqLock<Mixed>& M = mM;
+            Mixed                m = { 1.0, 1, 1 };
+
+            M.load(&m);
+            ASSERT(0.0 == m.d_double);  ASSERT(0 == m.d_int);
+            ASSERT(0   == m.d_char);
+
+            const Mixed V = { -2.5, 42, 'q' };
+            mM.store(V);
+            M.load(&m);
+            ASSERT(-2.5 == m.d_double);  ASSERT(42 == m.d_int);
+            ASSERT('q'  == m.d_char);
+
+            ASSERT(sizeof(Mixed) + sizeof(int)
+                                            == sizeof(bsls::SeqLock<Mixed>));
+        }
+
+        if (verbose) printf("\t'Snapshot'.\n");
+        {
+            Obj      mX;  const Obj& X = mX;
+            Snapshot s;
+
+            setSnapshot(&s, 5);
+            ASSERT(X.tryLoad(&s));
+            ASSERT(isConsistent(s));  ASSERT(0 == s.d_members[0]);
+
+            for (int i = 1; i <= 10; ++i) {
+                setSnapshot(&s, 1000000000000LL * i);
+                mX.store(s);
+
+                setSnapshot(&s, 0);
+                X.load(&s);
+                ASSERTV(i, isConsistent(s));
+                ASSERTV(i, 1000000000000LL * i == s.d_members[0]);
+            }
+
+            ASSERT(sizeof(Snapshot) + sizeof(int) == sizeof(Obj));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The component is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a sequence lock holding an 'int', store values, and
+        //:   verify the values loaded.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        bsls::SeqLock<int> mX(1);  const bsls::SeqLock<int>& X = mX;
+        int                value = 0;
+
+        X.load(&value);
+        ASSERT(1 == value);
+
+        mX.store(2);
+        ASSERT(X.tryLoad(&value));
+        ASSERT(2 == value);
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
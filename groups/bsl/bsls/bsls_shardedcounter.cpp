@@ -0,0 +1,65 @@
+// bsls_shardedcounter.cpp                                            -*-C++-*-
+#include <bsls_shardedcounter.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bsls_atomicoperations.h>
+#include <bsls_bsltestutil.h>       // for testing only
+#include <bsls_threadlocal.h>
+
+namespace BloombergLP {
+namespace bsls {
+
+namespace {
+
+AtomicOperations::AtomicTypes::Int s_numThreads = { 0 };
+    // number of threads assigned a shard, used to assign the next shard
+
+BSLS_THREADLOCAL int t_shardIndexPlusOne = 0;
+    // index of the shard assigned to the calling thread plus one, or 0 if no
+    // shard is assigned yet
+
+}  // close unnamed namespace
+
+                            // --------------------
+                            // class ShardedCounter
+                            // --------------------
+
+// PRIVATE CLASS METHODS
+int ShardedCounter::shardIndex()
+{
+    int indexPlusOne = t_shardIndexPlusOne;
+
+    if (0 == indexPlusOne) {
+        // Assign shards round-robin, so that the first 'k_NUM_SHARDS' threads
+        // updating counters have distinct shards.
+
+        const int thread =
+                     AtomicOperations::addIntNvRelaxed(&s_numThreads, 1) - 1;
+
+        indexPlusOne        = (thread & (k_NUM_SHARDS - 1)) + 1;
+        t_shardIndexPlusOne = indexPlusOne;
+    }
+
+    return indexPlusOne - 1;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
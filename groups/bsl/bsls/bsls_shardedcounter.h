@@ -0,0 +1,206 @@
+// bsls_shardedcounter.h                                              -*-C++-*-
+#ifndef INCLUDED_BSLS_SHARDEDCOUNTER
+#define INCLUDED_BSLS_SHARDEDCOUNTER
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a 64-bit counter sharded to avoid contention.
+//
+//@CLASSES:
+//  bsls::ShardedCounter: counter updated in per-thread, padded shards
+//
+//@SEE_ALSO: bsls_atomic, bsls_cachelinepadded, bsls_performancehint
+//
+//@DESCRIPTION: This component provides a class, 'bsls::ShardedCounter', for a
+// 64-bit integer counter intended for statistics that are updated frequently
+// by many threads and read rarely (e.g., the number of bytes allocated by an
+// allocator).  Updating a single 'bsls::AtomicInt64' from several threads
+// makes its cache line move between the processors running the threads, so
+// that the updates of every thread are slowed down by those of the others.
+//
+// A 'bsls::ShardedCounter' holds instead 'k_NUM_SHARDS' atomic *shards*, each
+// alone in its cache lines (see 'bsls_performancehint').  Each thread is
+// assigned a shard on its first update of any 'bsls::ShardedCounter', and
+// updates only that shard, with a single relaxed atomic addition; the value
+// of the counter, the sum of its shards, is computed by 'load'.  Threads
+// beyond 'k_NUM_SHARDS' share shards, which remains correct and contends
+// (much) less than a single counter.
+//
+// Note that a 'bsls::ShardedCounter' is about 'k_NUM_SHARDS + 1' times the
+// size of a cache line (two kilobytes on common platforms), and does not
+// allocate memory.  Objects of this type therefore suit long-lived
+// statistics, and not large numbers of counters.
+//
+///Thread Safety
+///-------------
+// 'add' and 'load' may be called concurrently from any number of threads.
+// The value returned by 'load' while other threads are updating the counter
+// is the sum of the shards read one after the other: it is the value of the
+// counter at no particular instant, but (for a counter that is only
+// incremented) is at least the value of the counter when 'load' was called.
+// Like the relaxed operations of 'bsls::AtomicInt64', 'add' and 'load'
+// provide no ordering of other memory operations.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Counting Requests Processed by a Server
+/// - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that the threads of a server count the requests they process, and
+// that a monitoring thread periodically reports the number of requests
+// processed.
+//
+// First, we define the counter:
+//..
+//  bsls::ShardedCounter numRequests;
+//..
+// Then, each thread processing a request increments the counter, without
+// contending with the other threads:
+//..
+//  numRequests.add(1);
+//  numRequests.add(1);
+//..
+// Finally, the monitoring thread reads the counter:
+//..
+//  assert(2 == numRequests.load());
+//..
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bsls {
+
+                            // ====================
+                            // class ShardedCounter
+                            // ====================
+
+class ShardedCounter {
+    // This class provides a 64-bit integer counter whose updates by distinct
+    // threads are made to distinct, padded shards.
+
+  public:
+    // TYPES
+    enum {
+        k_NUM_SHARDS = 16  // number of shards of a counter (a power of 2)
+    };
+
+  private:
+    // PRIVATE TYPES
+    enum {
+        k_SHARD_SIZE = BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE
+    };
+
+    struct Shard {
+        // This 'struct' holds a shard padded to 'k_SHARD_SIZE' bytes.  Note
+        // that shards are padded rather than aligned, so that a counter can be
+        // created in memory of the natural alignment of its members (e.g.,
+        // with the placement 'new' of 'bslma::Allocator').
+
+        AtomicInt64 d_value;                                        // shard
+        char        d_padding[k_SHARD_SIZE - sizeof(AtomicInt64)];  // padding
+    };
+
+    // DATA
+    char  d_leadingPadding[k_SHARD_SIZE];  // separates the shards from the
+                                           // data preceding the counter
+
+    Shard d_shards[k_NUM_SHARDS];          // shards, summing to the value of
+                                           // the counter
+
+    // PRIVATE CLASS METHODS
+    static int shardIndex();
+        // Return the index of the shard assigned to the calling thread,
+        // assigning it on the first call by the calling thread.
+
+    // NOT IMPLEMENTED
+    ShardedCounter(const ShardedCounter&);
+    ShardedCounter& operator=(const ShardedCounter&);
+
+  public:
+    // CREATORS
+    explicit ShardedCounter(Types::Int64 initialValue = 0);
+        // Create a counter having the optionally specified 'initialValue'.  If
+        // 'initialValue' is not specified, the counter has the value 0.
+
+    // ~ShardedCounter() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    void add(Types::Int64 value);
+        // Atomically add the specified 'value' to the shard of this counter
+        // assigned to the calling thread, with relaxed memory ordering.
+
+    // ACCESSORS
+    Types::Int64 load() const;
+        // Return the value of this counter, i.e., the sum of its shards, each
+        // read with relaxed memory ordering.  Note that the shards are not
+        // read at the same instant (see {Thread Safety}).
+};
+
+// ============================================================================
+//                          INLINE DEFINITIONS
+// ============================================================================
+
+                            // --------------------
+                            // class ShardedCounter
+                            // --------------------
+
+// CREATORS
+inline
+ShardedCounter::ShardedCounter(Types::Int64 initialValue)
+{
+    d_shards[0].d_value.storeRelaxed(initialValue);
+}
+
+// MANIPULATORS
+inline
+void ShardedCounter::add(Types::Int64 value)
+{
+    d_shards[shardIndex()].d_value.addRelaxed(value);
+}
+
+// ACCESSORS
+inline
+Types::Int64 ShardedCounter::load() const
+{
+    Types::Int64 result = 0;
+    for (int i = 0; i < k_NUM_SHARDS; ++i) {
+        result += d_shards[i].d_value.loadRelaxed();
+    }
+    return result;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,431 @@
+// bsls_shardedcounter.t.cpp                                          -*-C++-*-
+
+#include <bsls_shardedcounter.h>
+
+#include <bsls_bsltestutil.h>       // for testing only
+#include <bsls_performancehint.h>   // for testing only
+#include <bsls_platform.h>          // for testing only
+#include <bsls_types.h>             // for testing only
+
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides a counter whose value is the sum of
+// shards updated by distinct threads.  We verify the value of counters
+// updated by one thread and by many threads concurrently, and the layout of
+// the shards.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] explicit ShardedCounter(Types::Int64 initialValue = 0);
+//
+// MANIPULATORS
+// [ 2] void add(Types::Int64 value);
+// [ 3] void add(Types::Int64 value);  // concurrent
+//
+// ACCESSORS
+// [ 2] Types::Int64 load() const;
+// [ 3] Types::Int64 load() const;  // concurrent
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] USAGE EXAMPLE
+
+// ============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+typedef bsls::ShardedCounter Obj;
+
+static const int k_SIZE = BSLS_PERFORMANCEHINT_DESTRUCTIVE_INTERFERENCE_SIZE;
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+struct AdderArgs {
+    // This 'struct' holds the arguments of 'adderThread'.
+
+    Obj *d_counter_p;   // counter to update
+    int  d_numAdds;     // number of additions
+    int  d_value;       // value added by each addition
+};
+
+extern "C" void *adderThread(void *arg)
+    // Add 'd_value' to '*d_counter_p' 'd_numAdds' times, as specified by the
+    // 'AdderArgs' at the specified 'arg'.  Return 0.
+{
+    const AdderArgs *args = static_cast<const AdderArgs *>(arg);
+
+    for (int i = 0; i < args->d_numAdds; ++i) {
+        args->d_counter_p->add(args->d_value);
+    }
+    return 0;
+}
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    (void)veryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Counting Requests Processed by a Server
+/// - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that the threads of a server count the requests they process, and
+// that a monitoring thread periodically reports the number of requests
+// processed.
+//
+// First, we define the counter:
+//..
+    bsls::ShardedCounter numRequests;
+//..
+// Then, each thread processing a request increments the counter, without
+// contending with the other threads:
+//..
+    numRequests.add(1);
+    numRequests.add(1);
+//..
+// Finally, the monitoring thread reads the counter:
+//..
+    ASSERT(2 == numRequests.load());
+//..
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CONCURRENT UPDATES
+        //
+        // Concerns:
+        //: 1 No update is lost when threads update a counter concurrently,
+        //:   including when there are more threads than shards.
+        //:
+        //: 2 'load' may be called concurrently with 'add'.
+        //
+        // Plan:
+        //: 1 For numbers of threads below, equal to, and above
+        //:   'k_NUM_SHARDS', start threads each adding a distinct value to a
+        //:   counter many times, and to a second counter (so that threads use
+        //:   the same shard of distinct counters).  Meanwhile, load the first
+        //:   counter and verify that its value does not decrease.  Join the
+        //:   threads and verify the values of the counters.  (C-1..2)
+        //
+        // Testing:
+        //   void add(Types::Int64 value);  // concurrent
+        //   Types::Int64 load() const;  // concurrent
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCONCURRENT UPDATES"
+                            "\n==================\n");
+
+        enum { k_MAX_THREADS = 2 * Obj::k_NUM_SHARDS + 3,
+               k_NUM_ADDS    = 20000 };
+
+        static const int NUM_THREADS[] = { 1,
+                                           3,
+                                           Obj::k_NUM_SHARDS,
+                                           k_MAX_THREADS };
+        const int        NUM_DATA = sizeof NUM_THREADS / sizeof *NUM_THREADS;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int numThreads = NUM_THREADS[ti];
+
+            if (veryVerbose) { T_ P(numThreads) }
+
+            Obj mX(7);  const Obj& X = mX;
+            Obj mY;     const Obj& Y = mY;
+
+            AdderArgs args[2 * k_MAX_THREADS];
+            ThreadId  threads[2 * k_MAX_THREADS];
+
+            bsls::Types::Int64 expected = 7;
+            for (int i = 0; i < numThreads; ++i) {
+                args[2 * i].d_counter_p     = &mX;
+                args[2 * i].d_numAdds       = k_NUM_ADDS;
+                args[2 * i].d_value         = i + 1;
+                args[2 * i + 1].d_counter_p = &mY;
+                args[2 * i + 1].d_numAdds   = k_NUM_ADDS;
+                args[2 * i + 1].d_value     = -1;
+
+                expected += static_cast<bsls::Types::Int64>(k_NUM_ADDS)
+                                                                     * (i + 1);
+            }
+
+            for (int i = 0; i < 2 * numThreads; ++i) {
+                threads[i] = createThread(&adderThread, &args[i]);
+            }
+
+            bsls::Types::Int64 last = X.load();
+            for (int i = 0; i < 1000; ++i) {
+                const bsls::Types::Int64 value = X.load();
+                ASSERTV(ti, i, last, value, last <= value);
+                ASSERTV(ti, i, value, value <= expected);
+                last = value;
+            }
+
+            for (int i = 0; i < 2 * numThreads; ++i) {
+                joinThread(threads[i]);
+            }
+
+            ASSERTV(ti, X.load(), expected == X.load());
+            ASSERTV(ti, Y.load(),
+                    -static_cast<bsls::Types::Int64>(k_NUM_ADDS) * numThreads
+                                                                 == Y.load());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS, MANIPULATORS, AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 A counter has the value it was created with, 0 by default.
+        //:
+        //: 2 'add' adds its argument, which may be negative or exceed 32 bits,
+        //:   to the value of the counter.
+        //:
+        //: 3 The shards are at least the destructive interference size apart,
+        //:   without the counter being over-aligned, so that counters can be
+        //:   created in memory aligned only for 'bsls::Types::Int64'.
+        //
+        // Plan:
+        //: 1 Create counters with and without an initial value, and verify
+        //:   their value.  (C-1)
+        //:
+        //: 2 Add positive, negative, and large values to a counter, and verify
+        //:   its value after each addition.  (C-2)
+        //:
+        //: 3 Verify the size of a counter, and create a counter at an address
+        //:   aligned only for 'bsls::Types::Int64'.  (C-3)
+        //
+        // Testing:
+        //   explicit ShardedCounter(Types::Int64 initialValue = 0);
+        //   void add(Types::Int64 value);
+        //   Types::Int64 load() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCREATORS, MANIPULATORS, AND ACCESSORS"
+                            "\n=====================================\n");
+
+        if (verbose) printf("\tConstructors.\n");
+        {
+            const Obj X;
+            const Obj Y(42);
+            const Obj Z(-5000000000LL);
+
+            ASSERT(0             == X.load());
+            ASSERT(42            == Y.load());
+            ASSERT(-5000000000LL == Z.load());
+        }
+
+        if (verbose) printf("\tAdding.\n");
+        {
+            static const struct {
+                int                d_line;      // source line number
+                bsls::Types::Int64 d_value;     // value to add
+                bsls::Types::Int64 d_expected;  // value after addition
+            } DATA[] = {
+                //LINE  VALUE           EXPECTED
+                //----  --------------  --------------
+                { L_,              0,              0 },
+                { L_,              1,              1 },
+                { L_,             41,             42 },
+                { L_,            -50,             -8 },
+                { L_,    4000000000LL,   3999999992LL },
+                { L_,   -3999999992LL,             0 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            Obj mX;  const Obj& X = mX;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int                LINE     = DATA[ti].d_line;
+                const bsls::Types::Int64 VALUE    = DATA[ti].d_value;
+                const bsls::Types::Int64 EXPECTED = DATA[ti].d_expected;
+
+                mX.add(VALUE);
+                ASSERTV(LINE, X.load(), EXPECTED == X.load());
+            }
+        }
+
+        if (verbose) printf("\tLayout.\n");
+        {
+            ASSERTV(sizeof(Obj),
+                    (Obj::k_NUM_SHARDS + 1) * k_SIZE == sizeof(Obj));
+
+            bsls::Types::Int64 buffer[sizeof(Obj) / sizeof(bsls::Types::Int64)
+                                                                         + 2];
+            Obj *counter_p = new (buffer + 1) Obj(3);
+
+            counter_p->add(4);
+            ASSERT(7 == counter_p->load());
+            counter_p->~Obj();
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The component is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a counter, add to it, and verify its value.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        Obj mX;  const Obj& X = mX;
+        ASSERT(0 == X.load());
+
+        mX.add(5);
+        ASSERT(5 == X.load());
+
+        mX.add(-2);
+        ASSERT(3 == X.load());
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,107 @@
+// bsls_threadlocal.h                                                 -*-C++-*-
+#ifndef INCLUDED_BSLS_THREADLOCAL
+#define INCLUDED_BSLS_THREADLOCAL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a macro declaring variables having one instance per thread.
+//
+//@CLASSES:
+//
+//@MACROS:
+//  BSLS_THREADLOCAL: storage-class specifier for per-thread variables
+//
+//@SEE_ALSO: bsls_platform
+//
+//@DESCRIPTION: This component provides a macro, 'BSLS_THREADLOCAL', expanding
+// to the storage-class specifier with which the compiler declares a variable
+// having *thread* storage duration: each thread has its own instance of the
+// variable, created when the thread starts, and accessed without any
+// synchronization.
+//
+// The specifier is the compiler extension that predates the C++11
+// 'thread_local' keyword ('__thread', or '__declspec(thread)' for MSVC), and
+// is thus available in C++03 builds.  Like the extension, 'BSLS_THREADLOCAL'
+// may be applied only to variables of namespace scope, block scope (with
+// 'static'), and static data members, whose type is a fundamental type, a
+// pointer, or an aggregate of them, and whose initializer is a constant
+// expression; the initial value of the instance of each thread is that of
+// the initializer.  Access to such a variable costs no more than a few
+// instructions, which makes it suitable for per-thread state consulted on
+// fast paths (e.g., the per-thread default allocator of 'bslma_default').
+//
+///Macro Summary
+///-------------
+// This section provides a brief description of the macro defined in this
+// component.
+//..
+//  BSLS_THREADLOCAL
+//      Expand to the storage-class specifier declaring a variable having
+//      thread storage duration.
+//..
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Counting the Calls Made by Each Thread
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we want to count the calls to a function made by each thread,
+// without the threads contending on a shared counter.
+//
+// First, we define a counter having one instance per thread:
+//..
+//  static BSLS_THREADLOCAL int t_numCalls = 0;
+//      // number of calls to 'countCall' made by the calling thread
+//..
+// Then, we define the function, which increments the counter of the calling
+// thread:
+//..
+//  int countCall()
+//      // Return the number of calls to this function made by the calling
+//      // thread, including this one.
+//  {
+//      return ++t_numCalls;
+//  }
+//..
+// Finally, we call the function, and observe that the calls are counted (a
+// thread calling it for the first time would get 1):
+//..
+//  assert(1 == countCall());
+//  assert(2 == countCall());
+//..
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+                           // ======================
+                           // macro BSLS_THREADLOCAL
+                           // ======================
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#define BSLS_THREADLOCAL __declspec(thread)
+#else
+#define BSLS_THREADLOCAL __thread
+#endif
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,392 @@
+// bsls_threadlocal.t.cpp                                             -*-C++-*-
+
+#include <bsls_threadlocal.h>
+
+#include <bsls_bsltestutil.h>       // for testing only
+#include <bsls_platform.h>          // for testing only
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides a storage-class specifier.  We declare
+// variables of each kind of scope with it, and verify that each thread has
+// its own instance of them, initialized with their initializer.
+// ----------------------------------------------------------------------------
+// MACROS
+// [ 2] BSLS_THREADLOCAL
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] USAGE EXAMPLE
+
+// ============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+struct Point {
+    // This 'struct' is an aggregate having thread storage duration in the
+    // tests.
+
+    int d_x;  // x coordinate
+    int d_y;  // y coordinate
+};
+
+BSLS_THREADLOCAL int        t_namespaceInt = 7;
+    // namespace-scope per-thread variable
+
+static BSLS_THREADLOCAL Point t_point = { 1, 2 };
+    // namespace-scope (internal linkage) per-thread aggregate
+
+struct Holder {
+    // This 'struct' has a per-thread static data member.
+
+    static BSLS_THREADLOCAL const char *s_name_p;  // per-thread pointer
+};
+
+BSLS_THREADLOCAL const char *Holder::s_name_p = "initial";
+
+static
+int *blockScopeInt()
+    // Return the address of the instance, for the calling thread, of a
+    // block-scope per-thread variable initialized with 11.
+{
+    static BSLS_THREADLOCAL int t_blockInt = 11;
+    return &t_blockInt;
+}
+
+struct ThreadArgs {
+    // This 'struct' holds the arguments and results of 'checkerThread'.
+
+    int         d_id;             // distinct value written by the thread
+
+    bool        d_initialValues;  // 'true' if the variables had their
+                                  // initial values at thread start
+
+    bool        d_writtenValues;  // 'true' if the variables kept the values
+                                  // written by the thread
+
+    const void *d_addresses[4];   // addresses of the thread's instances
+};
+
+extern "C" void *checkerThread(void *arg)
+    // Verify that the per-thread variables have their initial values, write
+    // values derived from 'd_id' into them, and record the results and the
+    // addresses of the instances in the 'ThreadArgs' at the specified 'arg'.
+    // Return 0.
+{
+    ThreadArgs *args = static_cast<ThreadArgs *>(arg);
+
+    args->d_initialValues = 7  == t_namespaceInt
+                         && 1  == t_point.d_x
+                         && 2  == t_point.d_y
+                         && 0  == strcmp("initial", Holder::s_name_p)
+                         && 11 == *blockScopeInt();
+
+    t_namespaceInt   = args->d_id;
+    t_point.d_x      = args->d_id + 1;
+    t_point.d_y      = args->d_id + 2;
+    Holder::s_name_p = "written";
+    *blockScopeInt() = args->d_id + 3;
+
+    args->d_addresses[0] = &t_namespaceInt;
+    args->d_addresses[1] = &t_point;
+    args->d_addresses[2] = &Holder::s_name_p;
+    args->d_addresses[3] = blockScopeInt();
+
+    args->d_writtenValues = args->d_id     == t_namespaceInt
+                         && args->d_id + 1 == t_point.d_x
+                         && args->d_id + 2 == t_point.d_y
+                         && 0 == strcmp("written", Holder::s_name_p)
+                         && args->d_id + 3 == *blockScopeInt();
+    return 0;
+}
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Counting the Calls Made by Each Thread
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we want to count the calls to a function made by each thread,
+// without the threads contending on a shared counter.
+//
+// First, we define a counter having one instance per thread:
+//..
+    static BSLS_THREADLOCAL int t_numCalls = 0;
+        // number of calls to 'countCall' made by the calling thread
+//..
+// Then, we define the function, which increments the counter of the calling
+// thread:
+//..
+    int countCall()
+        // Return the number of calls to this function made by the calling
+        // thread, including this one.
+    {
+        return ++t_numCalls;
+    }
+//..
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    (void)veryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 3: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Finally, we call the function, and observe that the calls are counted (a
+// thread calling it for the first time would get 1):
+//..
+    ASSERT(1 == countCall());
+    ASSERT(2 == countCall());
+//..
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // BSLS_THREADLOCAL
+        //
+        // Concerns:
+        //: 1 A variable of namespace scope, of block scope, or a static data
+        //:   member, declared with 'BSLS_THREADLOCAL', has a distinct instance
+        //:   in each thread.
+        //:
+        //: 2 The instance of each thread has the initial value of the
+        //:   variable, whatever the values written by other threads.
+        //:
+        //: 3 Variables of fundamental, pointer, and aggregate types are
+        //:   supported.
+        //
+        // Plan:
+        //: 1 Write values to the variables in the main thread.  Then start
+        //:   several threads that each verify that the variables have their
+        //:   initial values, write distinct values to them, and verify that
+        //:   the values they wrote are kept.  Verify that the instances of
+        //:   the threads have distinct addresses, and that the values of the
+        //:   main thread are unchanged.  (C-1..3)
+        //
+        // Testing:
+        //   BSLS_THREADLOCAL
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBSLS_THREADLOCAL"
+                            "\n================\n");
+
+        enum { k_NUM_THREADS = 8, k_NUM_VARIABLES = 4 };
+
+        t_namespaceInt   = -1;
+        t_point.d_x      = -2;
+        t_point.d_y      = -3;
+        Holder::s_name_p = "main";
+        *blockScopeInt() = -4;
+
+        ThreadArgs args[k_NUM_THREADS];
+        ThreadId   threads[k_NUM_THREADS];
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            args[i].d_id = 100 * (i + 1);
+            threads[i]   = createThread(&checkerThread, &args[i]);
+        }
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            joinThread(threads[i]);
+        }
+
+        // The instances of threads that have exited may be reused by later
+        // threads, but those of the main thread are distinct from those of
+        // every other thread.
+
+        const void *const MAIN_ADDRESSES[k_NUM_VARIABLES] = {
+            &t_namespaceInt, &t_point, &Holder::s_name_p, blockScopeInt()
+        };
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            ASSERTV(i, args[i].d_initialValues);
+            ASSERTV(i, args[i].d_writtenValues);
+
+            for (int v = 0; v < k_NUM_VARIABLES; ++v) {
+                ASSERTV(i, v, MAIN_ADDRESSES[v] != args[i].d_addresses[v]);
+            }
+        }
+
+        ASSERT(-1 == t_namespaceInt);
+        ASSERT(-2 == t_point.d_x);
+        ASSERT(-3 == t_point.d_y);
+        ASSERT( 0 == strcmp("main", Holder::s_name_p));
+        ASSERT(-4 == *blockScopeInt());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The component is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Write a per-thread variable in the main thread, and verify that
+        //:   a second thread observes the initial value.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        ASSERT(7 == t_namespaceInt);
+
+        t_namespaceInt = 8;
+
+        ThreadArgs args;
+        args.d_id = 5;
+
+        joinThread(createThread(&checkerThread, &args));
+
+        ASSERT(args.d_initialValues);
+        ASSERT(args.d_writtenValues);
+        ASSERT(8 == t_namespaceInt);
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -23,6 +23,11 @@ BSLS_IDENT("$Id$ $CSID$")
     #error "Don't know how to get nanosecond time for this platform"
 #endif
 
+#if defined(BSLS_TIMEUTIL_CYCLE_COUNTER_TSC)                                  \
+ && !defined(BSLS_PLATFORM_CMP_MSVC)
+    #include <cpuid.h>          // __get_cpuid()
+#endif
+
 #if defined(BSLS_PLATFORM_OS_SOLARIS)
     #include <sys/time.h>       // gethrtime()
 #elif defined(BSLS_PLATFORM_OS_DARWIN)
@@ -584,6 +589,37 @@ bsls::Types::Int64 MachTimerUtil::getTimerRaw()
 
 #endif
 
+#ifdef BSLS_TIMEUTIL_CYCLE_COUNTER_TSC
+
+bool cpuHasInvariantTsc()
+    // Return 'true' if the processor reports an invariant time-stamp counter
+    // (bit 8 of EDX for the extended CPUID leaf 0x80000007), and 'false'
+    // otherwise.
+{
+    const unsigned int k_INVARIANT_TSC_LEAF = 0x80000007u;
+    const unsigned int k_INVARIANT_TSC_BIT  = 1u << 8;
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+    int info[4];
+    __cpuid(info, 0x80000000);
+    if (static_cast<unsigned int>(info[0]) < k_INVARIANT_TSC_LEAF) {
+        return false;                                                 // RETURN
+    }
+    __cpuid(info, k_INVARIANT_TSC_LEAF);
+    return 0 != (static_cast<unsigned int>(info[3]) & k_INVARIANT_TSC_BIT);
+#else
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000000u, &eax, &ebx, &ecx, &edx)
+     || eax < k_INVARIANT_TSC_LEAF) {
+        return false;                                                 // RETURN
+    }
+    __get_cpuid(k_INVARIANT_TSC_LEAF, &eax, &ebx, &ecx, &edx);
+    return 0 != (edx & k_INVARIANT_TSC_BIT);
+#endif
+}
+
+#endif
+
 }  // close unnamed namespace
 
 namespace bsls {
@@ -592,7 +628,82 @@ namespace bsls {
                             // struct TimeUtil
                             // ---------------
 
+// CLASS DATA
+AtomicOperations::AtomicTypes::Int   TimeUtil::s_cycleCounterMode    = { 0 };
+AtomicOperations::AtomicTypes::Int64 TimeUtil::s_nanosecondsPerCycle = { 0 };
+
+// PRIVATE CLASS METHODS
+void TimeUtil::initializeCycleCounter()
+{
+    static BslOnce once = BSLS_BSLONCE_INITIALIZER;
+
+    BslOnceGuard onceGuard;
+    if (!onceGuard.enter(&once)) {
+        return;                                                       // RETURN
+    }
+
+    // By default, the cycle counter is 'getTimer', with one cycle per
+    // nanosecond.
+
+    int          mode                = e_CYCLE_COUNTER_TIMER;
+    Types::Int64 nanosecondsPerCycle = static_cast<Types::Int64>(1) << 32;
+
+#ifdef BSLS_TIMEUTIL_CYCLE_COUNTER_TSC
+    if (cpuHasInvariantTsc()) {
+        // Calibrate the rate of the time-stamp counter against 'getTimer' over
+        // about a millisecond.  Each read of the counter is bracketed by two
+        // reads of the timer, whose average is taken as the time of the read,
+        // so that the cost of 'getTimer' does not bias the rate.
+
+        const Types::Int64 k_CALIBRATION_NANOSECONDS = 1000 * 1000;
+
+        const Types::Int64 startTime0  = getTimer();
+        const Types::Int64 startCycles = readTsc();
+        const Types::Int64 startTime1  = getTimer();
+
+        Types::Int64 endTime0;
+        do {
+            endTime0 = getTimer();
+        } while (endTime0 - startTime0 < k_CALIBRATION_NANOSECONDS);
+
+        const Types::Int64 endCycles = readTsc();
+        const Types::Int64 endTime1  = getTimer();
+
+        const Types::Int64 elapsedCycles = endCycles - startCycles;
+        const Types::Int64 elapsedTime   = (endTime0 + endTime1) / 2
+                                         - (startTime0 + startTime1) / 2;
+
+        if (0 < elapsedCycles && 0 < elapsedTime) {
+            const Types::Int64 ratio = (elapsedTime << 32) / elapsedCycles;
+
+            // Reject implausible rates (outside of 100 MHz to 100 GHz), which
+            // would indicate a counter that is not usable as a clock.
+
+            if ((static_cast<Types::Int64>(1) << 32) / 100 < ratio
+             && ratio < (static_cast<Types::Int64>(10) << 32)) {
+                mode                = e_CYCLE_COUNTER_TSC;
+                nanosecondsPerCycle = ratio;
+            }
+        }
+    }
+#endif
+
+    AtomicOperations::setInt64Relaxed(&s_nanosecondsPerCycle,
+                                      nanosecondsPerCycle);
+    AtomicOperations::setIntRelease(&s_cycleCounterMode, mode);
+}
+
 // CLASS METHODS
+bool TimeUtil::hasInvariantTsc()
+{
+    if (e_CYCLE_COUNTER_UNINITIALIZED ==
+                        AtomicOperations::getIntAcquire(&s_cycleCounterMode)) {
+        initializeCycleCounter();
+    }
+    return e_CYCLE_COUNTER_TSC ==
+                         AtomicOperations::getIntAcquire(&s_cycleCounterMode);
+}
+
 void TimeUtil::initialize()
 {
 #if defined BSLS_PLATFORM_OS_UNIX
@@ -605,6 +716,11 @@ void TimeUtil::initialize()
 #else
     #error "Don't know how to get nanosecond time for this platform"
 #endif
+
+    if (e_CYCLE_COUNTER_UNINITIALIZED ==
+                        AtomicOperations::getIntAcquire(&s_cycleCounterMode)) {
+        initializeCycleCounter();
+    }
 }
 
 Types::Int64
@@ -90,6 +90,43 @@ BSLS_IDENT("$Id: $")
 // expressed by the 'QueryPerformanceCounter' interface.  Note that the times
 // will still be monotonically non-decreasing.
 //
+///Cycle Counter
+///-------------
+// 'getTimer' costs on the order of 20 nanoseconds on typical platforms, which
+// is too expensive to bracket individual operations on a hot path (e.g., to
+// stamp each message with its latency).  'bsls::TimeUtil' therefore also
+// provides a *cycle* *counter*, 'getCycleCount', that reads the processor's
+// time-stamp counter (TSC) directly where this is reliable, at a cost of a few
+// nanoseconds, and 'convertCyclesToNanoseconds', that converts a number of
+// cycles (typically, the difference of two cycle counts) to nanoseconds
+// through a cached fixed-point multiplier.
+//
+// The TSC is used only on x86 and x86-64 processors advertising an *invariant*
+// TSC (one that runs at a constant rate, independent of the frequency and
+// power state of the core, and synchronized between the cores of a machine),
+// as reported by 'hasInvariantTsc'.  The TSC is read after a load fence, so
+// that it is not sampled before the preceding instructions complete.  The rate
+// of the TSC is calibrated once, against 'getTimer', over about a millisecond,
+// by 'initialize' (or by the first call to 'getCycleCount',
+// 'convertCyclesToNanoseconds', or 'hasInvariantTsc', if 'initialize' has not
+// been called); rates from 100 MHz to 100 GHz are accepted.  Elsewhere
+// (including on virtual machines not exposing an invariant TSC),
+// 'getCycleCount' returns the value of 'getTimer', and
+// 'convertCyclesToNanoseconds' returns its argument, so that code using the
+// cycle counter is portable.
+//
+// The following snippet illustrates timing a single operation with the cycle
+// counter:
+//..
+//  const bsls::Types::Int64 start = bsls::TimeUtil::getCycleCount();
+//
+//  // ... process the message ...
+//
+//  const bsls::Types::Int64 latency =
+//                           bsls::TimeUtil::convertCyclesToNanoseconds(
+//                                  bsls::TimeUtil::getCycleCount() - start);
+//..
+//
 ///Usage
 ///-----
 // The following snippets of code illustrate how to use 'bsls::TimeUtil'
@@ -188,6 +225,10 @@ BSLS_IDENT("$Id: $")
 //  }
 //..
 
+#ifndef INCLUDED_BSLS_ATOMICOPERATIONS
+#include <bsls_atomicoperations.h>
+#endif
+
 #ifndef INCLUDED_BSLS_PLATFORM
 #include <bsls_platform.h>
 #endif
@@ -210,10 +251,42 @@ BSLS_IDENT("$Id: $")
     #endif
 #endif
 
+#if (defined(BSLS_PLATFORM_CPU_X86) || defined(BSLS_PLATFORM_CPU_X86_64))    \
+ && (defined(BSLS_PLATFORM_CMP_GNU)   || defined(BSLS_PLATFORM_CMP_CLANG)     \
+                                      || defined(BSLS_PLATFORM_CMP_MSVC))
+    #define BSLS_TIMEUTIL_CYCLE_COUNTER_TSC 1
+        // The cycle counter may read the time-stamp counter.
+#endif
+
+#if defined(BSLS_TIMEUTIL_CYCLE_COUNTER_TSC) && defined(BSLS_PLATFORM_CMP_MSVC)
+    #ifndef INCLUDED_INTRIN
+    #include <intrin.h>
+    #define INCLUDED_INTRIN
+    #endif
+#endif
+
 namespace BloombergLP {
 
 namespace bsls {
 
+                        // ===========================
+                        // struct TimeUtil_FixedPoint
+                        // ===========================
+
+struct TimeUtil_FixedPoint {
+    // [!PRIVATE!] This component-private 'struct' provides a namespace for the
+    // fixed-point arithmetic converting cycles to nanoseconds.  It is not for
+    // use outside this component.
+
+    // CLASS METHODS
+    static Types::Uint64 multiply(Types::Uint64 value,
+                                  Types::Uint64 multiplier);
+        // Return the product of the specified 'value' and the specified
+        // 'multiplier', a fixed-point value with 32 fractional bits, rounded
+        // down to an integer.  The behavior is undefined unless the result is
+        // less than '2^64'.
+};
+
                             // ===============
                             // struct TimeUtil
                             // ===============
@@ -248,6 +321,36 @@ struct TimeUtil {
     typedef struct { Types::Int64 d_opaque; } OpaqueNativeTime;
 #endif
 
+  private:
+    // PRIVATE TYPES
+    enum CycleCounterMode {
+        // Enumerate the sources of the cycle counter.
+
+        e_CYCLE_COUNTER_UNINITIALIZED = 0,  // not yet calibrated
+        e_CYCLE_COUNTER_TSC           = 1,  // invariant time-stamp counter
+        e_CYCLE_COUNTER_TIMER         = 2   // 'getTimer'
+    };
+
+    // CLASS DATA
+    static AtomicOperations::AtomicTypes::Int   s_cycleCounterMode;
+        // 'CycleCounterMode' of the cycle counter
+
+    static AtomicOperations::AtomicTypes::Int64 s_nanosecondsPerCycle;
+        // number of nanoseconds per cycle, as a fixed-point value with 32
+        // fractional bits
+
+    // PRIVATE CLASS METHODS
+    static void initializeCycleCounter();
+        // Select the source of the cycle counter, and calibrate its rate
+        // against 'getTimer', if not already done.
+
+    static Types::Int64 readTsc();
+        // Return the value of the time-stamp counter of the processor, read
+        // after all previous instructions have completed locally.  The
+        // behavior is undefined unless 'BSLS_TIMEUTIL_CYCLE_COUNTER_TSC' is
+        // defined.
+
+  public:
     // CLASS METHODS
 
                                   // Initializers
@@ -259,12 +362,28 @@ struct TimeUtil {
 
                                   // Operations
 
+    static Types::Int64 convertCyclesToNanoseconds(Types::Int64 numCycles);
+        // Return the number of nanoseconds corresponding to the specified
+        // 'numCycles' of the cycle counter.  'numCycles' may be negative
+        // (e.g., the difference of cycle counts read on distinct cores).  Note
+        // that this method is thread-safe only if 'initialize' has been called
+        // before.
+
     static Types::Int64 convertRawTime(OpaqueNativeTime rawTime);
         // Convert the specified 'rawTime' to a value in nanoseconds,
         // referenced to an arbitrary but fixed origin, and return the result
         // of the conversion.  Note that this method is thread-safe only if
         // 'initialize' has been called before.
 
+    static Types::Int64 getCycleCount();
+        // Return the instantaneous value of a low-overhead, platform-dependent
+        // cycle counter, in units (*cycles*) to be converted to nanoseconds by
+        // 'convertCyclesToNanoseconds', referenced to an arbitrary but fixed
+        // origin.  The cycle counter is the invariant time-stamp counter of
+        // the processor, if available, and 'getTimer' (with one cycle per
+        // nanosecond) otherwise (see {Cycle Counter}).  Note that this method
+        // is thread-safe only if 'initialize' has been called before.
+
     static Types::Int64 getProcessSystemTimer();
         // Return the instantaneous values of a platform-dependent timer for
         // the current process system time in absolute nanoseconds referenced
@@ -300,8 +419,109 @@ struct TimeUtil {
         // interpreting the results.  Note that this method is thread-safe only
         // if 'initialize' has been called before.
 
+                                  // Aspects
+
+    static bool hasInvariantTsc();
+        // Return 'true' if the cycle counter is the invariant time-stamp
+        // counter of the processor, and 'false' if it is 'getTimer'.  Note
+        // that this method is thread-safe only if 'initialize' has been called
+        // before.
 };
 
+// ============================================================================
+//                          INLINE DEFINITIONS
+// ============================================================================
+
+                        // ---------------------------
+                        // struct TimeUtil_FixedPoint
+                        // ---------------------------
+
+// CLASS METHODS
+inline
+Types::Uint64 TimeUtil_FixedPoint::multiply(Types::Uint64 value,
+                                            Types::Uint64 multiplier)
+{
+    // Sum the products of the 32-bit halves of the operands, so that no
+    // intermediate product overflows unless the result does, whatever the
+    // integral part of 'multiplier'.
+
+    const Types::Uint64 valueHigh      = value >> 32;
+    const Types::Uint64 valueLow       = value & 0xFFFFFFFFu;
+    const Types::Uint64 multiplierHigh = multiplier >> 32;
+    const Types::Uint64 multiplierLow  = multiplier & 0xFFFFFFFFu;
+
+    return value * multiplierHigh
+         + valueHigh * multiplierLow
+         + ((valueLow * multiplierLow) >> 32);
+}
+
+                            // ---------------
+                            // struct TimeUtil
+                            // ---------------
+
+// PRIVATE CLASS METHODS
+inline
+Types::Int64 TimeUtil::readTsc()
+{
+#if defined(BSLS_TIMEUTIL_CYCLE_COUNTER_TSC)
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+    _mm_lfence();
+    return static_cast<Types::Int64>(__rdtsc());
+#else
+    unsigned int low, high;
+    __asm__ __volatile__("lfence\n\t"
+                         "rdtsc"
+                         : "=a" (low), "=d" (high)
+                         :
+                         : "memory");
+    return static_cast<Types::Int64>(
+                              (static_cast<Types::Uint64>(high) << 32) | low);
+#endif
+#else
+    return 0;
+#endif
+}
+
+// CLASS METHODS
+inline
+Types::Int64 TimeUtil::convertCyclesToNanoseconds(Types::Int64 numCycles)
+{
+    if (numCycles < 0) {
+        return -convertCyclesToNanoseconds(-numCycles);               // RETURN
+    }
+
+    if (e_CYCLE_COUNTER_UNINITIALIZED ==
+                        AtomicOperations::getIntAcquire(&s_cycleCounterMode)) {
+        initializeCycleCounter();
+    }
+
+    const Types::Uint64 multiplier = static_cast<Types::Uint64>(
+                   AtomicOperations::getInt64Relaxed(&s_nanosecondsPerCycle));
+
+    return static_cast<Types::Int64>(TimeUtil_FixedPoint::multiply(
+                                        static_cast<Types::Uint64>(numCycles),
+                                        multiplier));
+}
+
+inline
+Types::Int64 TimeUtil::getCycleCount()
+{
+    const int mode = AtomicOperations::getIntAcquire(&s_cycleCounterMode);
+
+#if defined(BSLS_TIMEUTIL_CYCLE_COUNTER_TSC)
+    if (e_CYCLE_COUNTER_TSC == mode) {
+        return readTsc();                                             // RETURN
+    }
+#endif
+
+    if (e_CYCLE_COUNTER_UNINITIALIZED == mode) {
+        initializeCycleCounter();
+        return getCycleCount();                                       // RETURN
+    }
+
+    return getTimer();
+}
+
 }  // close package namespace
 
 
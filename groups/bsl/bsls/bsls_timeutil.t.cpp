@@ -46,15 +46,19 @@ using namespace BloombergLP;
 // address basic concerns to probe both our own code for consistent behavior
 // and the system results for plausible correct behavior.
 //-----------------------------------------------------------------------------
+// [12] bsls::Types::Int64 convertCyclesToNanoseconds(Int64 numCycles);
 // [11] bsls::Types::Int64 convertRawTime(OpaqueNativeTime rawTime);
+// [12] bsls::Types::Int64 getCycleCount();
 // [ 1] bsls::Types::Int64 bsls::TimeUtil::getProcessSystemTimer();
 // [ 1] void bsls::TimeUtil::getProcessTimers(bsls::Types::Int64);
 // [ 1] bsls::Types::Int64 bsls::TimeUtil::getTimer();
 // [ 1] bsls::Types::Int64 bsls::TimeUtil::getProcessUserTimer();
 // [11] OpaqueNativeTime getTimerRaw();
+// [12] bool hasInvariantTsc();
+// [12] Uint64 TimeUtil_FixedPoint::multiply(Uint64 value, Uint64 multiplier);
 //-----------------------------------------------------------------------------
 // [XX] Breathing Test -- NOT IMPLEMENTED
-// [ 2] USAGE
+// [13] USAGE
 // [ 3] Performance Test
 // [ 4] Test for unique, monotonically increasing return values (statistical)
 // [ 5] Test correct hooking of methods to underlying OS APIs (approximately)
@@ -497,7 +501,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 12: {
+      case 13: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE
         //   The usage example provided in the component header must build and
@@ -539,6 +543,210 @@ int main(int argc, char *argv[])
         }
 
       } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // TESTING CYCLE COUNTER
+        //
+        // Concerns:
+        //: 1 'hasInvariantTsc' returns the same value on each call.
+        //:
+        //: 2 Successive values of 'getCycleCount' are non-decreasing.
+        //:
+        //: 3 'convertCyclesToNanoseconds' converts an interval measured with
+        //:   the cycle counter to (approximately) the same interval as
+        //:   measured with 'getTimer'.
+        //:
+        //: 4 'convertCyclesToNanoseconds' is exact for 0, is odd (i.e.,
+        //:   'f(-x) == -f(x)'), and does not overflow for large values.
+        //:
+        //: 5 If there is no invariant TSC, the cycle counter is 'getTimer'.
+        //:
+        //: 6 The fixed-point multiplication converting cycles is exact (up to
+        //:   rounding down), and does not overflow for any multiplier from
+        //:   0.01 to 10 nanoseconds per cycle (i.e., a TSC rate from 100 MHz
+        //:   to 100 GHz) as long as the result fits.
+        //
+        // Plan:
+        //: 1 Call 'hasInvariantTsc' repeatedly.  (C-1)
+        //:
+        //: 2 Call 'getCycleCount' in a loop, comparing each value to the
+        //:   previous one.  (C-2)
+        //:
+        //: 3 Measure a busy interval of 20 milliseconds with both clocks, and
+        //:   compare the results, allowing for a 2% error.  (C-3)
+        //:
+        //: 4 Convert 0, and positive and negative values of various
+        //:   magnitudes, and verify the results are consistent.  (C-4)
+        //:
+        //: 5 If 'hasInvariantTsc' is 'false', verify that conversion is the
+        //:   identity.  (C-5)
+        //:
+        //: 6 Using the table-driven technique, multiply values having large
+        //:   high and low halves by multipliers of less and more than one,
+        //:   and verify the products.  (C-6)
+        //
+        // Testing:
+        //   bsls::Types::Int64 convertCyclesToNanoseconds(Int64 numCycles);
+        //   bsls::Types::Int64 getCycleCount();
+        //   bool hasInvariantTsc();
+        //   Uint64 TimeUtil_FixedPoint::multiply(Uint64, Uint64);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING CYCLE COUNTER"
+                            "\n=====================\n");
+
+        if (verbose) printf("\tFixed-point multiplication.\n");
+        {
+            typedef bsls::Types::Uint64 Uint64;
+
+            static const struct {
+                int    d_line;        // source line number
+                Uint64 d_value;       // value to multiply
+                Uint64 d_multiplier;  // 32.32 fixed-point multiplier
+                Uint64 d_expected;    // expected product
+            } DATA[] = {
+                //LINE  VALUE                  MULTIPLIER
+                //----  ---------------------  ------------
+                //      EXPECTED
+                //      ---------------------
+                { L_,   0x0ULL,                0xA00000000ULL,
+                        0x0ULL                                      },
+                { L_,   0x1ULL,                0x100000000ULL,
+                        0x1ULL                                      },
+                { L_,   0xFFFFFFFFULL,         0x100000000ULL,
+                        0xFFFFFFFFULL                               },
+                { L_,   0x10000003039ULL,      0x380000000ULL,
+                        0x3800000A8C7ULL                            },
+                { L_,   0xFFFFFFFFULL,         0x9FFFFFFFFULL,
+                        0x9FFFFFFF5ULL                              },
+                { L_,   0x800000000000007ULL,  0xA00000000ULL,
+                        0x5000000000000046ULL                       },
+                { L_,   0x7048860DDF79ULL,     0x28F5C28ULL,
+                        0x11F71FA9900ULL                            },
+                { L_,   0x8000000000000005ULL, 0x80000000ULL,
+                        0x4000000000000002ULL                       },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int    LINE       = DATA[ti].d_line;
+                const Uint64 VALUE      = DATA[ti].d_value;
+                const Uint64 MULTIPLIER = DATA[ti].d_multiplier;
+                const Uint64 EXPECTED   = DATA[ti].d_expected;
+
+                LOOP_ASSERT(LINE,
+                            EXPECTED == bsls::TimeUtil_FixedPoint::multiply(
+                                                                  VALUE,
+                                                                  MULTIPLIER));
+            }
+        }
+
+        TU::initialize();
+
+        const bool HAS_TSC = TU::hasInvariantTsc();
+        if (verbose) printf("\thasInvariantTsc: %d\n", (int)HAS_TSC);
+
+        for (int i = 0; i < 10; ++i) {
+            ASSERT(HAS_TSC == TU::hasInvariantTsc());
+        }
+
+        if (verbose) printf("\tMonotonicity.\n");
+        {
+            Int64 previous = TU::getCycleCount();
+            for (int i = 0; i < 100000; ++i) {
+                const Int64 current = TU::getCycleCount();
+                LOOP3_ASSERT(i, previous, current, previous <= current);
+                previous = current;
+            }
+        }
+
+        if (verbose) printf("\tAccuracy.\n");
+        {
+            const Int64 k_INTERVAL = 20 * 1000 * 1000;
+
+            const Int64 startCycles = TU::getCycleCount();
+            const Int64 startTime   = TU::getTimer();
+
+            Int64 endTime;
+            do {
+                endTime = TU::getTimer();
+            } while (endTime - startTime < k_INTERVAL);
+
+            const Int64 endCycles = TU::getCycleCount();
+
+            const Int64 elapsedTime   = endTime - startTime;
+            const Int64 elapsedCycles =
+                               TU::convertCyclesToNanoseconds(endCycles
+                                                              - startCycles);
+
+            if (veryVerbose) {
+                P_(elapsedTime) P(elapsedCycles)
+            }
+
+            LOOP2_ASSERT(elapsedTime,
+                         elapsedCycles,
+                         elapsedCycles >= elapsedTime - elapsedTime / 50);
+            LOOP2_ASSERT(elapsedTime,
+                         elapsedCycles,
+                         elapsedCycles <= elapsedTime + elapsedTime / 50);
+        }
+
+        if (verbose) printf("\tConversion.\n");
+        {
+            ASSERT(0 == TU::convertCyclesToNanoseconds(0));
+
+            const Int64 k_BASE = static_cast<Int64>(1) << 20;
+            const Int64 BASE_NS = TU::convertCyclesToNanoseconds(k_BASE);
+            ASSERT(0 < BASE_NS);
+
+            for (int shift = 0; shift <= 40; shift += 5) {
+                const Int64 CYCLES = k_BASE << shift;
+                const Int64 NS     = TU::convertCyclesToNanoseconds(CYCLES);
+
+                LOOP2_ASSERT(shift, NS, 0 < NS);
+                LOOP2_ASSERT(shift,
+                             NS,
+                             -NS == TU::convertCyclesToNanoseconds(-CYCLES));
+
+                // The conversion is linear, up to rounding.
+
+                const Int64 EXPECTED  = BASE_NS << shift;
+                const Int64 TOLERANCE = static_cast<Int64>(1) << shift;
+                LOOP3_ASSERT(shift, NS, EXPECTED,
+                             NS - EXPECTED <= TOLERANCE
+                          && EXPECTED - NS <= TOLERANCE);
+
+                if (!HAS_TSC) {
+                    LOOP2_ASSERT(shift, NS, CYCLES == NS);
+                }
+            }
+        }
+
+        if (verbose) printf("\tCost.\n");
+        {
+            const int k_ITERATIONS = 1000000;
+
+            Int64 sink = 0;
+
+            const Int64 t0 = TU::getTimer();
+            for (int i = 0; i < k_ITERATIONS; ++i) {
+                sink += TU::getCycleCount();
+            }
+            const Int64 t1 = TU::getTimer();
+            for (int i = 0; i < k_ITERATIONS; ++i) {
+                sink += TU::getTimer();
+            }
+            const Int64 t2 = TU::getTimer();
+
+            if (verbose) {
+                printf("\t\tgetCycleCount: %g ns/call\n"
+                       "\t\tgetTimer:      %g ns/call\n",
+                       (double)(t1 - t0) / k_ITERATIONS,
+                       (double)(t2 - t1) / k_ITERATIONS);
+            }
+            ASSERT(0 != sink);
+        }
+      } break;
       case 11: {
         // --------------------------------------------------------------------
         // TESTING convertRawTime() arithmetic *** Windows Only ***
@@ -0,0 +1,340 @@
+// bsls_trace.cpp                                                     -*-C++-*-
+#include <bsls_trace.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bsls_assert.h>
+#include <bsls_bsltestutil.h>  // for testing only
+#include <bsls_platform.h>
+#include <bsls_threadlocal.h>
+
+#include <stdlib.h>            // malloc()
+#include <string.h>            // memset()
+
+#if defined(BSLS_PLATFORM_OS_WINDOWS)
+    #include <windows.h>       // GetCurrentProcessId()
+#else
+    #include <unistd.h>        // getpid()
+#endif
+
+namespace BloombergLP {
+namespace bsls {
+
+namespace {
+
+typedef AtomicOperations         AtomicOps;
+typedef AtomicOps::AtomicTypes   AtomicTypes;
+
+struct Event {
+    // This 'struct' holds a recorded scope.  Its members are atomic so that
+    // they can be read while the owning thread overwrites them: 'd_sequence'
+    // is '2 * i + 1' while the 'i'th event of the buffer is being written,
+    // and '2 * i + 2' once it is written, allowing a reader to detect (and
+    // skip) an event that changed while it was being read.
+
+    AtomicTypes::Int64   d_sequence;  // sequence number, as described above
+    AtomicTypes::Pointer d_name;      // name of the scope
+    AtomicTypes::Int64   d_start;     // start, in nanoseconds
+    AtomicTypes::Int64   d_end;       // end, in nanoseconds
+};
+
+struct Buffer {
+    // This 'struct' holds the ring buffer of events of a thread.  'd_events'
+    // is allocated together with this object.
+
+    Buffer               *d_next_p;      // next buffer in 's_buffers'
+    int                   d_threadId;    // id of the thread
+    int                   d_capacity;    // number of events (a power of 2)
+    AtomicTypes::Pointer  d_threadName;  // name of the thread, or 0
+    AtomicTypes::Int64    d_numEvents;   // number of events ever recorded
+    AtomicTypes::Int64    d_firstEvent;  // index of the first event not
+                                         // discarded by 'reset'
+    Event                 d_events[1];   // first of 'd_capacity' events
+};
+
+AtomicTypes::Pointer s_buffers;         // list of the buffers of all threads
+
+AtomicTypes::Int     s_nextThreadId;    // id of the last thread allocating a
+                                        // buffer
+
+AtomicTypes::Int     s_bufferCapacity;  // capacity of the next buffers, or 0
+                                        // for the default
+
+BSLS_THREADLOCAL Buffer *t_buffer_p = 0;
+                                        // buffer of the calling thread
+
+Buffer *createBuffer()
+    // Allocate a buffer for the calling thread, add it to 's_buffers', and
+    // return its address, or 0 if it cannot be allocated.
+{
+    int capacity = AtomicOps::getIntRelaxed(&s_bufferCapacity);
+    if (0 == capacity) {
+        capacity = Trace::k_DEFAULT_BUFFER_CAPACITY;
+    }
+
+    const size_t size = sizeof(Buffer) + (capacity - 1) * sizeof(Event);
+
+    Buffer *buffer = static_cast<Buffer *>(malloc(size));
+    if (!buffer) {
+        return 0;                                                     // RETURN
+    }
+    memset(buffer, 0, size);
+
+    buffer->d_capacity = capacity;
+    buffer->d_threadId = AtomicOps::addIntNv(&s_nextThreadId, 1);
+
+    void *head = AtomicOps::getPtrAcquire(&s_buffers);
+    do {
+        buffer->d_next_p = static_cast<Buffer *>(head);
+        void *previous = AtomicOps::testAndSwapPtrAcqRel(&s_buffers,
+                                                         head,
+                                                         buffer);
+        if (previous == head) {
+            break;
+        }
+        head = previous;
+    } while (true);
+
+    t_buffer_p = buffer;
+    return buffer;
+}
+
+int processId()
+    // Return the id of the current process.
+{
+#if defined(BSLS_PLATFORM_OS_WINDOWS)
+    return static_cast<int>(GetCurrentProcessId());
+#else
+    return static_cast<int>(getpid());
+#endif
+}
+
+void writeString(std::FILE *file, const char *string)
+    // Write the specified 'string' to the specified 'file' as a JSON string.
+{
+    std::fputc('"', file);
+    for (const char *p = string; *p; ++p) {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        if ('"' == c || '\\' == c) {
+            std::fputc('\\', file);
+            std::fputc(c, file);
+        }
+        else if (c < 0x20) {
+            std::fprintf(file, "\\u%04x", c);
+        }
+        else {
+            std::fputc(c, file);
+        }
+    }
+    std::fputc('"', file);
+}
+
+void writeMicroseconds(std::FILE *file, Types::Int64 nanoseconds)
+    // Write to the specified 'file' the specified 'nanoseconds' as a number
+    // of microseconds having three decimals.
+{
+    const char *sign = "";
+    if (nanoseconds < 0) {
+        sign        = "-";
+        nanoseconds = -nanoseconds;
+    }
+    std::fprintf(file,
+                 "%s%lld.%03d",
+                 sign,
+                 static_cast<long long>(nanoseconds / 1000),
+                 static_cast<int>(nanoseconds % 1000));
+}
+
+}  // close unnamed namespace
+
+                               // -----------
+                               // class Trace
+                               // -----------
+
+// CLASS DATA
+AtomicOperations::AtomicTypes::Int Trace::s_enabled = { 0 };
+
+// CLASS METHODS
+int Trace::bufferCapacity()
+{
+    const int capacity = AtomicOps::getIntRelaxed(&s_bufferCapacity);
+    return capacity ? capacity : k_DEFAULT_BUFFER_CAPACITY;
+}
+
+void Trace::recordScope(const char   *name,
+                        Types::Int64  startNanoseconds,
+                        Types::Int64  endNanoseconds)
+{
+    BSLS_ASSERT_SAFE(name);
+    BSLS_ASSERT_SAFE(startNanoseconds <= endNanoseconds);
+
+    Buffer *buffer = t_buffer_p;
+    if (!buffer) {
+        buffer = createBuffer();
+        if (!buffer) {
+            return;                                                   // RETURN
+        }
+    }
+
+    // Only this thread modifies 'd_numEvents' and the events of 'buffer'.
+
+    const Types::Int64 index = AtomicOps::getInt64Relaxed(
+                                                        &buffer->d_numEvents);
+
+    Event& event = buffer->d_events[index & (buffer->d_capacity - 1)];
+
+    // The acquire semantics of the swap prevent the writes of the members of
+    // the event from becoming visible before its odd sequence number.
+
+    AtomicOps::swapInt64AcqRel(&event.d_sequence, 2 * index + 1);
+
+    AtomicOps::setPtrRelaxed(&event.d_name,
+                             const_cast<char *>(name));
+    AtomicOps::setInt64Relaxed(&event.d_start, startNanoseconds);
+    AtomicOps::setInt64Relaxed(&event.d_end,   endNanoseconds);
+
+    AtomicOps::setInt64Release(&event.d_sequence, 2 * index + 2);
+    AtomicOps::setInt64Release(&buffer->d_numEvents, index + 1);
+}
+
+void Trace::reset()
+{
+    for (Buffer *buffer = static_cast<Buffer *>(
+                                       AtomicOps::getPtrAcquire(&s_buffers));
+         buffer;
+         buffer = buffer->d_next_p) {
+        const Types::Int64 numEvents = AtomicOps::getInt64Acquire(
+                                                        &buffer->d_numEvents);
+        AtomicOps::setInt64Relaxed(&buffer->d_firstEvent, numEvents);
+    }
+}
+
+void Trace::setBufferCapacity(int numEvents)
+{
+    BSLS_ASSERT(1 <= numEvents);
+    BSLS_ASSERT(numEvents <= 1 << 24);
+
+    int capacity = 1;
+    while (capacity < numEvents) {
+        capacity <<= 1;
+    }
+    AtomicOps::setIntRelaxed(&s_bufferCapacity, capacity);
+}
+
+void Trace::setThreadName(const char *name)
+{
+    BSLS_ASSERT(name);
+
+    Buffer *buffer = t_buffer_p;
+    if (!buffer) {
+        buffer = createBuffer();
+        if (!buffer) {
+            return;                                                   // RETURN
+        }
+    }
+    AtomicOps::setPtrRelease(&buffer->d_threadName, const_cast<char *>(name));
+}
+
+int Trace::writeChromeTrace(std::FILE *file)
+{
+    BSLS_ASSERT(file);
+
+    const int pid = processId();
+
+    std::fputs("{\"traceEvents\":[", file);
+
+    const char *separator = "\n";
+
+    for (Buffer *buffer = static_cast<Buffer *>(
+                                       AtomicOps::getPtrAcquire(&s_buffers));
+         buffer;
+         buffer = buffer->d_next_p) {
+        const char *threadName = static_cast<const char *>(
+                              AtomicOps::getPtrAcquire(&buffer->d_threadName));
+        if (threadName) {
+            std::fputs(separator, file);
+            std::fputs("{\"name\":\"thread_name\",\"ph\":\"M\"", file);
+            std::fprintf(file,
+                         ",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":",
+                         pid,
+                         buffer->d_threadId);
+            writeString(file, threadName);
+            std::fputs("}}", file);
+            separator = ",\n";
+        }
+
+        const Types::Int64 numEvents = AtomicOps::getInt64Acquire(
+                                                        &buffer->d_numEvents);
+        const Types::Int64 firstEvent = AtomicOps::getInt64Relaxed(
+                                                       &buffer->d_firstEvent);
+
+        Types::Int64 first = numEvents - buffer->d_capacity;
+        if (first < firstEvent) {
+            first = firstEvent;
+        }
+        if (first < 0) {
+            first = 0;
+        }
+
+        for (Types::Int64 i = first; i < numEvents; ++i) {
+            Event& event = buffer->d_events[i & (buffer->d_capacity - 1)];
+
+            const Types::Int64 sequence = AtomicOps::getInt64Acquire(
+                                                           &event.d_sequence);
+            if (2 * i + 2 != sequence) {
+                continue;  // overwritten
+            }
+
+            const char *name = static_cast<const char *>(
+                                  AtomicOps::getPtrRelaxed(&event.d_name));
+            const Types::Int64 start =
+                                 AtomicOps::getInt64Relaxed(&event.d_start);
+            const Types::Int64 end = AtomicOps::getInt64Relaxed(&event.d_end);
+
+            // The release semantics of the (no-op) addition prevent the reads
+            // above from being performed after it.
+
+            if (sequence != AtomicOps::addInt64NvAcqRel(&event.d_sequence,
+                                                        0)) {
+                continue;  // overwritten while being read
+            }
+
+            std::fputs(separator, file);
+            std::fputs("{\"name\":", file);
+            writeString(file, name);
+            std::fputs(",\"ph\":\"X\",\"ts\":", file);
+            writeMicroseconds(file, start);
+            std::fputs(",\"dur\":", file);
+            writeMicroseconds(file, end - start);
+            std::fprintf(file,
+                         ",\"pid\":%d,\"tid\":%d}",
+                         pid,
+                         buffer->d_threadId);
+            separator = ",\n";
+        }
+    }
+
+    std::fputs("\n],\"displayTimeUnit\":\"ns\"}\n", file);
+
+    return std::ferror(file) || 0 != std::fflush(file) ? -1 : 0;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,355 @@
+// bsls_trace.h                                                       -*-C++-*-
+#ifndef INCLUDED_BSLS_TRACE
+#define INCLUDED_BSLS_TRACE
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide scoped timeline tracing into per-thread ring buffers.
+//
+//@CLASSES:
+//  bsls::Trace: namespace for controlling and collecting traces
+//  bsls::TraceScope: guard recording the duration of a scope
+//
+//@MACROS:
+//  BSLS_TRACE_SCOPE(NAME): record the duration of the enclosing scope
+//
+//@SEE_ALSO: bsls_timeutil, bsls_stopwatch, bsls_log
+//
+//@DESCRIPTION: This component provides a macro, 'BSLS_TRACE_SCOPE', that
+// records the time at which the enclosing scope is entered and left, and a
+// namespace, 'bsls::Trace', for enabling the recording, and for writing the
+// recorded scopes of every thread in the Chrome trace event format (readable
+// by 'chrome://tracing' and by Perfetto), so that the timeline of an
+// operation can be examined across threads.  Unlike 'bsls::Stopwatch', which
+// accumulates the total of several intervals, and 'bsls::Log', which writes
+// textual messages, a trace retains the start and duration of each individual
+// scope.
+//
+///Compile-Time and Run-Time Enabling
+///----------------------------------
+// 'BSLS_TRACE_SCOPE' expands to nothing (its argument is not evaluated) unless
+// the macro 'BSLS_TRACE_ENABLE' is defined when this header is included, so
+// that tracing has no cost at all in the builds where it is not wanted.
+//
+// Where it is compiled in, the recording is enabled and disabled at run time
+// by 'bsls::Trace::enable' and 'bsls::Trace::disable', and is initially
+// *disabled*.  While recording is disabled, a traced scope costs a single
+// relaxed atomic load.  While it is enabled, a traced scope reads the timer
+// ('bsls::TimeUtil::getTimer') twice, and writes one event into the ring
+// buffer of the calling thread, without locking.
+//
+///Ring Buffers
+///------------
+// Each thread records its events into a ring buffer of its own, allocated
+// (with 'malloc') when the thread first records an event, and holding the
+// most recent 'bsls::Trace::bufferCapacity()' events of the thread (older
+// events are overwritten).  The buffers are not released when their thread
+// exits, so that the events of the thread can still be collected; the memory
+// used by tracing is therefore proportional to the number of threads that
+// have ever recorded an event.  'bsls::Trace::setBufferCapacity' sets the
+// capacity of the buffers of the threads that have not yet recorded an event.
+//
+// The name of a traced scope is recorded as a pointer, and therefore must
+// remain valid until the trace is written (typically, the name is a string
+// literal).
+//
+///Collecting a Trace
+///------------------
+// 'bsls::Trace::writeChromeTrace' writes the events of all threads, as a
+// JSON object having a 'traceEvents' array, to a 'FILE'.  Each scope is
+// written as a "complete" event (phase "X") with its name, start, and
+// duration (in microseconds, with nanosecond precision), the process id, and
+// a per-thread id assigned in the order in which threads first record an
+// event.  Threads named with 'bsls::Trace::setThreadName' are also described
+// by "thread_name" metadata events.  A trace can be collected while other
+// threads record events: events overwritten during the collection are
+// skipped, and every event written is consistent.  'bsls::Trace::reset'
+// discards the events recorded so far.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Tracing the Stages of a Request
+/// - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we want to see the timeline of the stages of the requests
+// processed by a service, in a build having 'BSLS_TRACE_ENABLE' defined.
+//
+// First, we mark each stage of the processing with 'BSLS_TRACE_SCOPE':
+//..
+//  void decode()
+//  {
+//      BSLS_TRACE_SCOPE("decode");
+//
+//      // ...
+//  }
+//
+//  void process()
+//  {
+//      BSLS_TRACE_SCOPE("process");
+//
+//      decode();
+//
+//      // ...
+//  }
+//..
+// Then, we enable the recording, and process some requests:
+//..
+//  bsls::Trace::setThreadName("main");
+//  bsls::Trace::enable();
+//
+//  for (int i = 0; i < 3; ++i) {
+//      process();
+//  }
+//
+//  bsls::Trace::disable();
+//..
+// Finally, we write the trace to a file, which can be loaded in
+// 'chrome://tracing' or 'https://ui.perfetto.dev':
+//..
+//  FILE *file = tmpfile();
+//  int   rc   = bsls::Trace::writeChromeTrace(file);
+//  assert(0 == rc);
+//  fclose(file);
+//..
+// The file holds a 'traceEvents' array of the form:
+//..
+//  {"traceEvents":[
+//  {"name":"thread_name","ph":"M","pid":4242,"tid":1,"args":{"name":"main"}},
+//  {"name":"decode","ph":"X","ts":1520.118,"dur":0.052,"pid":4242,"tid":1},
+//  {"name":"process","ph":"X","ts":1520.087,"dur":0.135,"pid":4242,"tid":1},
+//  ...
+//  ],"displayTimeUnit":"ns"}
+//..
+
+#ifndef INCLUDED_BSLS_ATOMICOPERATIONS
+#include <bsls_atomicoperations.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TIMEUTIL
+#include <bsls_timeutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_CSTDIO
+#include <cstdio>
+#define INCLUDED_CSTDIO
+#endif
+
+                          // ===================
+                          // BSLS_TRACE_* Macros
+                          // ===================
+
+#define BSLS_TRACE_IMP_CAT(X, Y) BSLS_TRACE_IMP_CAT_IMP(X, Y)
+#define BSLS_TRACE_IMP_CAT_IMP(X, Y) X##Y
+    // Concatenate the specified 'X' and 'Y' after their expansion.  These
+    // macros are for use by this component *only*.
+
+#if defined(BSLS_TRACE_ENABLE)
+
+#define BSLS_TRACE_SCOPE(NAME)                                                \
+    BloombergLP::bsls::TraceScope                                             \
+                       BSLS_TRACE_IMP_CAT(bslsTraceScope_, __LINE__)((NAME))
+
+#else
+
+#define BSLS_TRACE_SCOPE(NAME)
+
+#endif
+    // Record, if recording is enabled, the duration of the scope enclosing
+    // the point of expansion of this macro, from that point to the end of the
+    // scope, under the specified 'NAME'.  Expand to nothing, without
+    // evaluating 'NAME', unless 'BSLS_TRACE_ENABLE' is defined.  The behavior
+    // is undefined unless 'NAME' is a null-terminated string that remains
+    // valid until the trace is written or reset.
+
+namespace BloombergLP {
+namespace bsls {
+
+                               // ===========
+                               // class Trace
+                               // ===========
+
+class Trace {
+    // This class provides a namespace for functions enabling the recording of
+    // traced scopes, recording them into the ring buffer of the calling
+    // thread, and writing the recorded events of all threads.
+
+    // CLASS DATA
+    static AtomicOperations::AtomicTypes::Int s_enabled;  // 1 if recording
+                                                          // is enabled, and
+                                                          // 0 otherwise
+
+  public:
+    // TYPES
+    enum {
+        k_DEFAULT_BUFFER_CAPACITY = 4096  // default number of events in the
+                                          // buffer of a thread
+    };
+
+    // CLASS METHODS
+    static int bufferCapacity();
+        // Return the number of events held by the buffers of the threads that
+        // have not yet recorded an event.
+
+    static void disable();
+        // Disable the recording of traced scopes.  Note that the events
+        // already recorded are retained.
+
+    static void enable();
+        // Enable the recording of traced scopes.
+
+    static bool isEnabled();
+        // Return 'true' if the recording of traced scopes is enabled, and
+        // 'false' otherwise.
+
+    static void recordScope(const char   *name,
+                            Types::Int64  startNanoseconds,
+                            Types::Int64  endNanoseconds);
+        // Record, into the buffer of the calling thread, a scope having the
+        // specified 'name', and starting and ending at the specified
+        // 'startNanoseconds' and 'endNanoseconds' (as returned by
+        // 'TimeUtil::getTimer').  If the buffer of the calling thread cannot
+        // be allocated, the scope is not recorded.  The behavior is undefined
+        // unless 'name' is a null-terminated string that remains valid until
+        // the trace is written or reset, and
+        // 'startNanoseconds <= endNanoseconds'.  Note that this function
+        // records the scope even if recording is disabled.
+
+    static void reset();
+        // Discard the events recorded so far by all threads.  Note that this
+        // function may be called while other threads record events.
+
+    static void setBufferCapacity(int numEvents);
+        // Set to the specified 'numEvents', rounded up to a power of two, the
+        // number of events held by the buffers of the threads that have not
+        // yet recorded an event.  The behavior is undefined unless
+        // '1 <= numEvents <= 1 << 24'.
+
+    static void setThreadName(const char *name);
+        // Set the name under which the calling thread is described in the
+        // traces written by 'writeChromeTrace' to the specified 'name'.  The
+        // behavior is undefined unless 'name' is a null-terminated string
+        // that remains valid until the trace is written.
+
+    static int writeChromeTrace(std::FILE *file);
+        // Write the events recorded by all threads to the specified 'file' in
+        // the Chrome trace event (JSON) format.  Return 0 on success, and a
+        // non-zero value if an error occurred while writing to 'file'.  Note
+        // that this function may be called while other threads record
+        // events.
+};
+
+                              // ================
+                              // class TraceScope
+                              // ================
+
+class TraceScope {
+    // This class implements a guard recording, on its destruction, the
+    // duration of its lifetime as a traced scope, if recording was enabled on
+    // its construction.
+
+    // DATA
+    const char   *d_name_p;            // name of the scope, or 0 if not
+                                       // recording
+
+    Types::Int64  d_startNanoseconds;  // time of construction
+
+  private:
+    // NOT IMPLEMENTED
+    TraceScope(const TraceScope&);
+    TraceScope& operator=(const TraceScope&);
+
+  public:
+    // CREATORS
+    explicit TraceScope(const char *name);
+        // Create a guard recording the scope having the specified 'name', if
+        // recording is enabled.  The behavior is undefined unless 'name' is a
+        // null-terminated string that remains valid until the trace is
+        // written or reset.
+
+    ~TraceScope();
+        // If recording was enabled on the construction of this object, record
+        // the scope of this object into the buffer of the calling thread, and
+        // destroy this object.
+};
+
+// ============================================================================
+//                          INLINE DEFINITIONS
+// ============================================================================
+
+                               // -----------
+                               // class Trace
+                               // -----------
+
+// CLASS METHODS
+inline
+void Trace::disable()
+{
+    AtomicOperations::setIntRelaxed(&s_enabled, 0);
+}
+
+inline
+void Trace::enable()
+{
+    AtomicOperations::setIntRelaxed(&s_enabled, 1);
+}
+
+inline
+bool Trace::isEnabled()
+{
+    return 0 != AtomicOperations::getIntRelaxed(&s_enabled);
+}
+
+                              // ----------------
+                              // class TraceScope
+                              // ----------------
+
+// CREATORS
+inline
+TraceScope::TraceScope(const char *name)
+: d_name_p(0)
+, d_startNanoseconds(0)
+{
+    if (Trace::isEnabled()) {
+        d_name_p           = name;
+        d_startNanoseconds = TimeUtil::getTimer();
+    }
+}
+
+inline
+TraceScope::~TraceScope()
+{
+    if (d_name_p) {
+        Trace::recordScope(d_name_p,
+                           d_startNanoseconds,
+                           TimeUtil::getTimer());
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
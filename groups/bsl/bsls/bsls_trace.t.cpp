@@ -0,0 +1,761 @@
+// bsls_trace.t.cpp                                                   -*-C++-*-
+
+// Compile the traced scopes in (see {Compile-Time and Run-Time Enabling}).
+
+#define BSLS_TRACE_ENABLE
+
+#include <bsls_trace.h>
+
+#include <bsls_asserttest.h>     // for testing only
+#include <bsls_atomic.h>         // for testing only
+#include <bsls_bsltestutil.h>    // for testing only
+#include <bsls_platform.h>       // for testing only
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+using namespace BloombergLP;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test records traced scopes into per-thread ring
+// buffers, and writes them in the Chrome trace event format.  We verify that
+// scopes are recorded only while recording is enabled, that the events are
+// written in the documented format (including the escaping of names), that a
+// buffer retains only its most recent events, and that 'reset' discards the
+// recorded events.  Finally, we verify that a trace written while several
+// threads record events holds only consistent events.
+//
+// Note that the state of this component is global, and that each test case
+// runs in a process of its own: the test cases take care of the threads that
+// have recorded events in the same case.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] int bufferCapacity();
+// [ 2] void disable();
+// [ 2] void enable();
+// [ 2] bool isEnabled();
+// [ 3] void recordScope(const char *name, Int64 start, Int64 end);
+// [ 4] void reset();
+// [ 2] void setBufferCapacity(int numEvents);
+// [ 3] void setThreadName(const char *name);
+// [ 3] int writeChromeTrace(std::FILE *file);
+//
+// 'TraceScope' class:
+// [ 2] TraceScope(const char *name);
+// [ 2] ~TraceScope();
+//
+// MACROS
+// [ 2] BSLS_TRACE_SCOPE(NAME)
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] USAGE EXAMPLE
+// [ 4] CONCERN: A buffer retains the most recent events of its thread.
+// [ 5] CONCERN: A trace can be written while threads record events.
+
+// ============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bsls::Trace        Obj;
+typedef bsls::Types::Int64 Int64;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+enum { k_MAX_TRACE_SIZE = 4 * 1024 * 1024 };
+
+static char g_trace[k_MAX_TRACE_SIZE + 1];  // trace written by 'writeTrace'
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+const char *writeTrace()
+    // Write the current trace to a temporary file, and return the content of
+    // the file (held in 'g_trace') as a null-terminated string.
+{
+    FILE *file = tmpfile();
+    ASSERT(file);
+
+    int rc = Obj::writeChromeTrace(file);
+    ASSERT(0 == rc);
+
+    rewind(file);
+    size_t length = fread(g_trace, 1, k_MAX_TRACE_SIZE, file);
+    ASSERT(length < k_MAX_TRACE_SIZE);
+    g_trace[length] = '\0';
+
+    fclose(file);
+    return g_trace;
+}
+
+static
+int countOccurrences(const char *string, const char *pattern)
+    // Return the number of occurrences of the specified 'pattern' in the
+    // specified 'string'.
+{
+    int count = 0;
+    for (const char *p = strstr(string, pattern); p; p = strstr(p + 1,
+                                                                 pattern)) {
+        ++count;
+    }
+    return count;
+}
+
+static
+bool isValidEnvelope(const char *trace)
+    // Return 'true' if the specified 'trace' starts and ends as documented,
+    // and 'false' otherwise.
+{
+    const char   *HEAD = "{\"traceEvents\":[";
+    const char   *TAIL = "\n],\"displayTimeUnit\":\"ns\"}\n";
+    const size_t  len  = strlen(trace);
+
+    return 0 == strncmp(trace, HEAD, strlen(HEAD))
+        && len >= strlen(TAIL)
+        && 0 == strcmp(trace + len - strlen(TAIL), TAIL);
+}
+
+                                // -------
+                                // case 5
+                                // -------
+
+struct RecordArgs {
+    // This 'struct' holds the arguments of 'recordThread'.
+
+    int              d_threadIndex;  // index of the thread (1 to 9)
+    int              d_numEvents;    // number of events to record
+    bsls::AtomicInt *d_done_p;       // number of threads done
+};
+
+static const char *const NAMES[] = { "n0", "n1", "n2", "n3", "n4",
+                                     "n5", "n6", "n7", "n8", "n9" };
+
+extern "C"
+void *recordThread(void *arg)
+    // Record the events described by the specified 'arg' (a 'RecordArgs'
+    // object).  The 'i'th event is named 'NAMES[d_threadIndex]', starts at
+    // '1000 * i + d_threadIndex', and lasts 'd_threadIndex' nanoseconds.
+{
+    RecordArgs *args = static_cast<RecordArgs *>(arg);
+
+    const int K = args->d_threadIndex;
+
+    for (int i = 0; i < args->d_numEvents; ++i) {
+        const Int64 start = 1000 * static_cast<Int64>(i) + K;
+        Obj::recordScope(NAMES[K], start, start + K);
+    }
+    ++*args->d_done_p;
+    return 0;
+}
+
+static
+int checkConsistency(const char *trace)
+    // Return the number of events of the specified 'trace', or a negative
+    // value if an event is not consistent with 'recordThread'.
+{
+    int count = 0;
+    for (const char *p = strstr(trace, "{\"name\":\"n"); p;
+                                       p = strstr(p + 1, "{\"name\":\"n")) {
+        int       k, tsFraction, durFraction, pid, tid;
+        long long tsWhole, durWhole;
+
+        if (7 != sscanf(p,
+                        "{\"name\":\"n%d\",\"ph\":\"X\",\"ts\":%lld.%d,"
+                        "\"dur\":%lld.%d,\"pid\":%d,\"tid\":%d}",
+                        &k,
+                        &tsWhole,
+                        &tsFraction,
+                        &durWhole,
+                        &durFraction,
+                        &pid,
+                        &tid)) {
+            return -1;                                                // RETURN
+        }
+        if (tsFraction != k || 0 != durWhole || durFraction != k) {
+            return -2;                                                // RETURN
+        }
+        ++count;
+    }
+    return count;
+}
+
+                                // -------
+                                // case 4
+                                // -------
+
+extern "C"
+void *ringThread(void *arg)
+    // Record 10 events named "r" starting at '0 .. 9' microseconds and
+    // lasting 1 microsecond, after setting the buffer capacity to the
+    // specified 'arg' (the address of an 'int').
+{
+    Obj::setBufferCapacity(*static_cast<int *>(arg));
+
+    for (int i = 0; i < 10; ++i) {
+        Obj::recordScope("r", 1000 * i, 1000 * i + 1000);
+    }
+    return 0;
+}
+
+                                // -------
+                                // case 6
+                                // -------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Tracing the Stages of a Request
+/// - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we want to see the timeline of the stages of the requests
+// processed by a service, in a build having 'BSLS_TRACE_ENABLE' defined.
+//
+// First, we mark each stage of the processing with 'BSLS_TRACE_SCOPE':
+//..
+    void decode()
+    {
+        BSLS_TRACE_SCOPE("decode");
+
+        // ...
+    }
+
+    void process()
+    {
+        BSLS_TRACE_SCOPE("process");
+
+        decode();
+
+        // ...
+    }
+//..
+
+// ============================================================================
+//                              MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Then, we enable the recording, and process some requests:
+//..
+    bsls::Trace::setThreadName("main");
+    bsls::Trace::enable();
+
+    for (int i = 0; i < 3; ++i) {
+        process();
+    }
+
+    bsls::Trace::disable();
+//..
+// Finally, we write the trace to a file, which can be loaded in
+// 'chrome://tracing' or 'https://ui.perfetto.dev':
+//..
+    FILE *file = tmpfile();
+    int   rc   = bsls::Trace::writeChromeTrace(file);
+    ASSERT(0 == rc);
+    fclose(file);
+//..
+        const char *TRACE = writeTrace();
+        if (veryVerbose) printf("%s", TRACE);
+
+        ASSERT(3 == countOccurrences(TRACE, "{\"name\":\"decode\""));
+        ASSERT(3 == countOccurrences(TRACE, "{\"name\":\"process\""));
+        ASSERT(1 == countOccurrences(TRACE, "\"args\":{\"name\":\"main\"}"));
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCURRENT RECORDING AND WRITING
+        //
+        // Concerns:
+        //: 1 A trace written while threads record events (and overwrite the
+        //:   oldest events of their buffers) holds only consistent events.
+        //:
+        //: 2 Once the threads are done, the trace holds the most recent
+        //:   events of each thread.
+        //
+        // Plan:
+        //: 1 Record, from several threads having small buffers, events whose
+        //:   name, start, and duration are related, while writing traces from
+        //:   the main thread.  Verify that each event of each trace is
+        //:   consistent.  (C-1)
+        //:
+        //: 2 Write a trace once the threads are done, and verify that it
+        //:   holds the expected number of events.  (C-2)
+        //
+        // Testing:
+        //   CONCERN: A trace can be written while threads record events.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCONCURRENT RECORDING AND WRITING"
+                            "\n================================\n");
+
+        enum { k_NUM_THREADS = 4, k_NUM_EVENTS = 200000, k_CAPACITY = 256 };
+
+        Obj::setBufferCapacity(k_CAPACITY);
+
+        bsls::AtomicInt done(0);
+        RecordArgs      args[k_NUM_THREADS];
+        ThreadId        threads[k_NUM_THREADS];
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            args[i].d_threadIndex = i + 1;
+            args[i].d_numEvents   = k_NUM_EVENTS;
+            args[i].d_done_p      = &done;
+
+            threads[i] = createThread(&recordThread, &args[i]);
+        }
+
+        int numTraces = 0;
+        while (done < k_NUM_THREADS) {
+            const char *TRACE = writeTrace();
+
+            ASSERT(isValidEnvelope(TRACE));
+
+            const int numEvents = checkConsistency(TRACE);
+            ASSERTV(numEvents, 0 <= numEvents);
+            ASSERTV(numEvents, numEvents <= k_NUM_THREADS * k_CAPACITY);
+            ++numTraces;
+        }
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            joinThread(threads[i]);
+        }
+
+        if (veryVerbose) { P(numTraces) }
+
+        const char *TRACE = writeTrace();
+        ASSERT(isValidEnvelope(TRACE));
+        ASSERTV(checkConsistency(TRACE),
+                k_NUM_THREADS * k_CAPACITY == checkConsistency(TRACE));
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // RING BUFFER AND RESET
+        //
+        // Concerns:
+        //: 1 The capacity of a buffer is fixed when its thread first records
+        //:   an event, and is rounded up to a power of two.
+        //:
+        //: 2 A buffer retains the most recent events of its thread, in
+        //:   order.
+        //:
+        //: 3 'reset' discards the events recorded so far, and not the events
+        //:   recorded afterwards.
+        //
+        // Plan:
+        //: 1 Record 10 events from threads having set the buffer capacity to
+        //:   3 and to 16, and verify the events written.  (C-1..2)
+        //:
+        //: 2 Reset, record, and verify the events written.  (C-3)
+        //
+        // Testing:
+        //   void reset();
+        //   CONCERN: A buffer retains the most recent events of its thread.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nRING BUFFER AND RESET"
+                            "\n=====================\n");
+
+        int capacity = 3;  // rounded up to 4
+        joinThread(createThread(&ringThread, &capacity));
+        ASSERT(4 == Obj::bufferCapacity());
+
+        const char *TRACE = writeTrace();
+        if (veryVerbose) printf("%s", TRACE);
+
+        ASSERT(4 == countOccurrences(TRACE, "{\"name\":\"r\""));
+        ASSERT(0 == countOccurrences(TRACE, "\"ts\":5.000"));
+
+        const char *p6 = strstr(TRACE, "\"ts\":6.000");
+        const char *p9 = strstr(TRACE, "\"ts\":9.000");
+        ASSERT(p6 && p9 && p6 < p9);
+
+        capacity = 16;
+        joinThread(createThread(&ringThread, &capacity));
+
+        TRACE = writeTrace();
+        ASSERT(14 == countOccurrences(TRACE, "{\"name\":\"r\""));
+        ASSERT(1  == countOccurrences(TRACE, "\"ts\":0.000"));
+        ASSERT(2  == countOccurrences(TRACE, "\"ts\":9.000"));
+
+        Obj::reset();
+
+        TRACE = writeTrace();
+        ASSERT(isValidEnvelope(TRACE));
+        ASSERT(0 == countOccurrences(TRACE, "{\"name\":\"r\""));
+
+        Obj::recordScope("after", 1, 2);
+
+        TRACE = writeTrace();
+        ASSERT(0 == countOccurrences(TRACE, "{\"name\":\"r\""));
+        ASSERT(1 == countOccurrences(TRACE, "{\"name\":\"after\""));
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // WRITING THE TRACE
+        //
+        // Concerns:
+        //: 1 An empty trace is a valid JSON object with an empty
+        //:   'traceEvents' array.
+        //:
+        //: 2 Each scope is written as a complete event, with its start and
+        //:   duration in microseconds having three decimals, the process id,
+        //:   and the id of its thread.
+        //:
+        //: 3 Named threads are described by a metadata event.
+        //:
+        //: 4 Quotes, backslashes, and control characters in names are
+        //:   escaped.
+        //:
+        //: 5 Each thread has a distinct id.
+        //
+        // Plan:
+        //: 1 Write a trace before recording any event, and compare it to the
+        //:   expected output.  (C-1)
+        //:
+        //: 2 Record scopes having chosen names and times, name the thread,
+        //:   and compare the trace to the expected output.  (C-2..4)
+        //:
+        //: 3 Record a scope from another thread, and verify its thread id.
+        //:   (C-5)
+        //
+        // Testing:
+        //   void recordScope(const char *name, Int64 start, Int64 end);
+        //   void setThreadName(const char *name);
+        //   int writeChromeTrace(std::FILE *file);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nWRITING THE TRACE"
+                            "\n=================\n");
+
+        const char *TRACE = writeTrace();
+        ASSERTV(TRACE,
+                0 == strcmp("{\"traceEvents\":["
+                            "\n],\"displayTimeUnit\":\"ns\"}\n", TRACE));
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+        const int PID = static_cast<int>(GetCurrentProcessId());
+#else
+        const int PID = static_cast<int>(getpid());
+#endif
+
+        Obj::recordScope("a", 1234567, 1234567);
+        Obj::recordScope("q\"b\\s\n", 5, 1005);
+        Obj::setThreadName("main \"thread\"");
+
+        char expected[1024];
+        sprintf(expected,
+                "{\"traceEvents\":[\n"
+                "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":1,"
+                "\"args\":{\"name\":\"main \\\"thread\\\"\"}},\n"
+                "{\"name\":\"a\",\"ph\":\"X\",\"ts\":1234.567,\"dur\":0.000,"
+                "\"pid\":%d,\"tid\":1},\n"
+                "{\"name\":\"q\\\"b\\\\s\\u000a\",\"ph\":\"X\",\"ts\":0.005,"
+                "\"dur\":1.000,\"pid\":%d,\"tid\":1}"
+                "\n],\"displayTimeUnit\":\"ns\"}\n",
+                PID, PID, PID);
+
+        TRACE = writeTrace();
+        if (veryVerbose) printf("%s", TRACE);
+        ASSERTV(TRACE, 0 == strcmp(expected, TRACE));
+
+        int capacity = 8;
+        joinThread(createThread(&ringThread, &capacity));
+
+        TRACE = writeTrace();
+        ASSERT(8 == countOccurrences(TRACE, "\"tid\":2}"));
+        ASSERT(3 == countOccurrences(TRACE, "\"tid\":1"));
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // ENABLING AND TRACE SCOPES
+        //
+        // Concerns:
+        //: 1 Recording is initially disabled, and 'enable' and 'disable'
+        //:   control it.
+        //:
+        //: 2 'BSLS_TRACE_SCOPE' records a scope, from its point of expansion
+        //:   to the end of the enclosing scope, if recording was enabled at
+        //:   that point, and several scopes can be traced in the same block.
+        //:
+        //: 3 The default buffer capacity is 'k_DEFAULT_BUFFER_CAPACITY', and
+        //:   'setBufferCapacity' rounds its argument up to a power of two.
+        //:
+        //: 4 Invalid capacities are detected in appropriate build modes.
+        //
+        // Plan:
+        //: 1 Trace scopes while recording is disabled and enabled (and
+        //:   disabled or enabled during the scope), and verify the recorded
+        //:   events.  (C-1..2)
+        //:
+        //: 2 Set various capacities, and verify 'bufferCapacity'.  (C-3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered.  (C-4)
+        //
+        // Testing:
+        //   int bufferCapacity();
+        //   void disable();
+        //   void enable();
+        //   bool isEnabled();
+        //   void setBufferCapacity(int numEvents);
+        //   TraceScope(const char *name);
+        //   ~TraceScope();
+        //   BSLS_TRACE_SCOPE(NAME)
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nENABLING AND TRACE SCOPES"
+                            "\n=========================\n");
+
+        ASSERT(false == Obj::isEnabled());
+
+        {
+            BSLS_TRACE_SCOPE("disabled");
+        }
+        ASSERT(0 == countOccurrences(writeTrace(), "\"ph\":\"X\""));
+
+        Obj::enable();
+        ASSERT(true == Obj::isEnabled());
+
+        {
+            BSLS_TRACE_SCOPE("outer");
+            BSLS_TRACE_SCOPE("inner");
+
+            Obj::disable();     // the scopes are still recorded
+        }
+        ASSERT(false == Obj::isEnabled());
+
+        const char *TRACE = writeTrace();
+        ASSERT(1 == countOccurrences(TRACE, "{\"name\":\"outer\""));
+        ASSERT(1 == countOccurrences(TRACE, "{\"name\":\"inner\""));
+        ASSERT(2 == countOccurrences(TRACE, "\"ph\":\"X\""));
+
+        {
+            BSLS_TRACE_SCOPE("late");
+
+            Obj::enable();      // the scope is not recorded
+        }
+        ASSERT(2 == countOccurrences(writeTrace(), "\"ph\":\"X\""));
+
+        {
+            bsls::TraceScope scope("direct");
+        }
+        ASSERT(1 == countOccurrences(writeTrace(), "{\"name\":\"direct\""));
+        Obj::disable();
+
+        if (verbose) printf("\tBuffer capacity.\n");
+
+        ASSERT(Obj::k_DEFAULT_BUFFER_CAPACITY == Obj::bufferCapacity());
+
+        static const struct {
+            int d_line;
+            int d_numEvents;
+            int d_expected;
+        } DATA[] = {
+            //LINE  NUM         EXP
+            //----  ----------  ----------
+            { L_,           1,          1 },
+            { L_,           2,          2 },
+            { L_,           3,          4 },
+            { L_,        1000,       1024 },
+            { L_,        1024,       1024 },
+            { L_,   1 << 24,      1 << 24 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE = DATA[ti].d_line;
+            const int NUM  = DATA[ti].d_numEvents;
+            const int EXP  = DATA[ti].d_expected;
+
+            Obj::setBufferCapacity(NUM);
+            ASSERTV(LINE, Obj::bufferCapacity(), EXP == Obj::bufferCapacity());
+        }
+
+        if (verbose) printf("\tNegative Testing.\n");
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_PASS(Obj::setBufferCapacity(1));
+            ASSERT_PASS(Obj::setBufferCapacity(1 << 24));
+            ASSERT_FAIL(Obj::setBufferCapacity(0));
+            ASSERT_FAIL(Obj::setBufferCapacity((1 << 24) + 1));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The component is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Enable the recording, trace a scope, and verify that the trace
+        //:   written holds it.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        Obj::enable();
+        {
+            BSLS_TRACE_SCOPE("breathing");
+        }
+        Obj::disable();
+
+        const char *TRACE = writeTrace();
+        if (veryVerbose) printf("%s", TRACE);
+
+        ASSERT(isValidEnvelope(TRACE));
+        ASSERT(1 == countOccurrences(TRACE, "{\"name\":\"breathing\""));
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,202 @@
+// bsls_waitutil.cpp                                                  -*-C++-*-
+#include <bsls_waitutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bsls_assert.h>
+#include <bsls_bsltestutil.h>  // for testing only
+#include <bsls_types.h>
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    #include <linux/futex.h>   // FUTEX_WAIT_PRIVATE, FUTEX_WAKE_PRIVATE
+    #include <sys/syscall.h>   // SYS_futex
+    #include <unistd.h>        // syscall()
+    #include <limits.h>        // INT_MAX
+#elif defined(BSLS_PLATFORM_OS_WINDOWS)
+    #include <windows.h>       // SRWLOCK, CONDITION_VARIABLE
+#else
+    #include <pthread.h>
+#endif
+
+namespace BloombergLP {
+namespace bsls {
+
+namespace {
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+
+inline
+int *futexAddress(AtomicOperations::AtomicTypes::Int *address)
+    // Return the address of the integer held by the specified 'address'.
+{
+    return const_cast<int *>(&address->d_value);
+}
+
+#else
+
+enum { k_NUM_BUCKETS = 64 };  // number of condition variables (a power of 2)
+
+struct Bucket {
+    // This 'struct' holds the condition variable on which the threads waiting
+    // on the integers hashed to this bucket block, and the mutex protecting
+    // it.
+
+#if defined(BSLS_PLATFORM_OS_WINDOWS)
+    SRWLOCK            d_mutex;
+    CONDITION_VARIABLE d_condition;
+#else
+    pthread_mutex_t    d_mutex;
+    pthread_cond_t     d_condition;
+#endif
+};
+
+#if defined(BSLS_PLATFORM_OS_WINDOWS)
+
+Bucket s_buckets[k_NUM_BUCKETS];  // zero-initialized, i.e., 'SRWLOCK_INIT'
+                                  // and 'CONDITION_VARIABLE_INIT'
+
+#else
+
+#define BSLS_WAITUTIL_BUCKET                                                  \
+    { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER }
+#define BSLS_WAITUTIL_BUCKETS8                                                \
+    BSLS_WAITUTIL_BUCKET, BSLS_WAITUTIL_BUCKET, BSLS_WAITUTIL_BUCKET,         \
+    BSLS_WAITUTIL_BUCKET, BSLS_WAITUTIL_BUCKET, BSLS_WAITUTIL_BUCKET,         \
+    BSLS_WAITUTIL_BUCKET, BSLS_WAITUTIL_BUCKET
+
+Bucket s_buckets[k_NUM_BUCKETS] = {
+    BSLS_WAITUTIL_BUCKETS8, BSLS_WAITUTIL_BUCKETS8, BSLS_WAITUTIL_BUCKETS8,
+    BSLS_WAITUTIL_BUCKETS8, BSLS_WAITUTIL_BUCKETS8, BSLS_WAITUTIL_BUCKETS8,
+    BSLS_WAITUTIL_BUCKETS8, BSLS_WAITUTIL_BUCKETS8
+};
+
+#undef BSLS_WAITUTIL_BUCKETS8
+#undef BSLS_WAITUTIL_BUCKET
+
+#endif
+
+Bucket& bucketFor(const AtomicOperations::AtomicTypes::Int *address)
+    // Return a reference to the bucket of the specified 'address'.
+{
+    Types::UintPtr hash = reinterpret_cast<Types::UintPtr>(address);
+    hash ^= hash >> 6;   // discard the bits common to neighboring integers
+    hash ^= hash >> 12;
+    return s_buckets[hash & (k_NUM_BUCKETS - 1)];
+}
+
+void wakeBucket(const AtomicOperations::AtomicTypes::Int *address)
+    // Wake all of the threads blocked on the bucket of the specified
+    // 'address'.
+{
+    Bucket& bucket = bucketFor(address);
+
+    // Acquiring the mutex guarantees that a thread having examined 'address'
+    // in 'WaitUtil::wait' before it was modified is blocked on the condition
+    // variable.
+
+#if defined(BSLS_PLATFORM_OS_WINDOWS)
+    AcquireSRWLockExclusive(&bucket.d_mutex);
+    ReleaseSRWLockExclusive(&bucket.d_mutex);
+    WakeAllConditionVariable(&bucket.d_condition);
+#else
+    pthread_mutex_lock(&bucket.d_mutex);
+    pthread_mutex_unlock(&bucket.d_mutex);
+    pthread_cond_broadcast(&bucket.d_condition);
+#endif
+}
+
+#endif
+
+}  // close unnamed namespace
+
+                              // ---------------
+                              // struct WaitUtil
+                              // ---------------
+
+// CLASS METHODS
+void WaitUtil::wait(AtomicOperations::AtomicTypes::Int *address,
+                    int                                 expectedValue)
+{
+    BSLS_ASSERT_SAFE(address);
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    // The kernel compares '*address' to 'expectedValue', and blocks only if
+    // they are equal (failing with 'EAGAIN' otherwise); interruptions by
+    // signals ('EINTR') are spurious wake-ups.
+
+    syscall(SYS_futex,
+            futexAddress(address),
+            FUTEX_WAIT_PRIVATE,
+            expectedValue,
+            0,
+            0,
+            0);
+#else
+    Bucket& bucket = bucketFor(address);
+
+# if defined(BSLS_PLATFORM_OS_WINDOWS)
+    AcquireSRWLockExclusive(&bucket.d_mutex);
+    if (AtomicOperations::getIntAcquire(address) == expectedValue) {
+        SleepConditionVariableSRW(&bucket.d_condition,
+                                  &bucket.d_mutex,
+                                  INFINITE,
+                                  0);
+    }
+    ReleaseSRWLockExclusive(&bucket.d_mutex);
+# else
+    pthread_mutex_lock(&bucket.d_mutex);
+    if (AtomicOperations::getIntAcquire(address) == expectedValue) {
+        pthread_cond_wait(&bucket.d_condition, &bucket.d_mutex);
+    }
+    pthread_mutex_unlock(&bucket.d_mutex);
+# endif
+#endif
+}
+
+void WaitUtil::wakeAll(AtomicOperations::AtomicTypes::Int *address)
+{
+    BSLS_ASSERT_SAFE(address);
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    syscall(SYS_futex,
+            futexAddress(address),
+            FUTEX_WAKE_PRIVATE,
+            INT_MAX,
+            0,
+            0,
+            0);
+#else
+    wakeBucket(address);
+#endif
+}
+
+void WaitUtil::wakeOne(AtomicOperations::AtomicTypes::Int *address)
+{
+    BSLS_ASSERT_SAFE(address);
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    syscall(SYS_futex, futexAddress(address), FUTEX_WAKE_PRIVATE, 1, 0, 0, 0);
+#else
+    wakeBucket(address);
+#endif
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
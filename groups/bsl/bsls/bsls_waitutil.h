@@ -0,0 +1,208 @@
+// bsls_waitutil.h                                                    -*-C++-*-
+#ifndef INCLUDED_BSLS_WAITUTIL
+#define INCLUDED_BSLS_WAITUTIL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide primitives to spin and to block on an atomic integer.
+//
+//@CLASSES:
+//  bsls::WaitUtil: namespace for spinning, waiting, and waking primitives
+//
+//@SEE_ALSO: bsls_adaptivelock, bsls_readerwriterlock, bsls_atomicoperations
+//
+//@DESCRIPTION: This component provides a namespace, 'bsls::WaitUtil', for the
+// primitives from which blocking synchronization mechanisms (such as
+// 'bsls::AdaptiveLock' and 'bsls::ReaderWriterLock') are built: 'pause', a
+// hint to the processor that the calling thread is spinning, and 'wait',
+// 'wakeOne', and 'wakeAll', which block the calling thread until the value of
+// an atomic integer (a 'bsls::AtomicOperations::AtomicTypes::Int') changes,
+// and wake the threads so blocked.
+//
+// 'wait' blocks the calling thread only if the integer has the value that the
+// caller expects, and the check and the blocking are atomic with respect to
+// the wake functions: a thread that changes the value of the integer and then
+// calls 'wakeOne' or 'wakeAll' cannot miss a thread that observed the
+// previous value.  'wait' can however return *spuriously* (without a wake
+// function having been called, or although the value has not changed), and
+// therefore is always called in a loop that re-examines the value of the
+// integer.
+//
+///Implementation
+///--------------
+// On Linux, 'wait', 'wakeOne', and 'wakeAll' are implemented by the
+// (process-private) 'futex' system call, and do not allocate any resource:
+// 'wait' parks the calling thread in the kernel, keyed by the address of the
+// integer.
+//
+// On other platforms, they are implemented by a fixed table of mutexes and
+// condition variables, selected by hashing the address of the integer.  Since
+// several integers can share a condition variable, 'wakeOne' wakes *all* of
+// the threads waiting on the condition variable of the integer on these
+// platforms; the wake functions must therefore be used by callers prepared
+// for spurious wake-ups, which is already required by 'wait'.
+//
+// 'pause' is the 'pause' instruction on x86 and x86-64 processors, and the
+// 'yield' instruction on ARMv7 processors (in either case, the instruction
+// lowers the power consumption of the spinning thread and frees resources for
+// a sibling hardware thread), and a compiler barrier elsewhere.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: A One-Shot Event
+///- - - - - - - - - - - - - -
+// Suppose that we want threads to wait until an event, signaled once by
+// another thread, has occurred, spinning a little before blocking.
+//
+// First, we define the event, holding 1 once it has occurred:
+//..
+//  class my_Event {
+//      // This class implements an event that can be waited for, and
+//      // signaled once.
+//
+//      // DATA
+//      bsls::AtomicOperations::AtomicTypes::Int d_state;  // 1 if signaled
+//
+//    public:
+//      // CREATORS
+//      my_Event()
+//      {
+//          bsls::AtomicOperations::initInt(&d_state, 0);
+//      }
+//
+//      // MANIPULATORS
+//      void signal()
+//      {
+//          bsls::AtomicOperations::setIntRelease(&d_state, 1);
+//          bsls::WaitUtil::wakeAll(&d_state);
+//      }
+//
+//      void wait()
+//      {
+//          for (int i = 0; i < 100; ++i) {
+//              if (bsls::AtomicOperations::getIntAcquire(&d_state)) {
+//                  return;                                           // RETURN
+//              }
+//              bsls::WaitUtil::pause();
+//          }
+//          while (0 == bsls::AtomicOperations::getIntAcquire(&d_state)) {
+//              bsls::WaitUtil::wait(&d_state, 0);
+//          }
+//      }
+//  };
+//..
+// Note that 'wait' may return spuriously, which the loop of 'my_Event::wait'
+// handles.  Then, a thread signals the event, which wakes the threads
+// waiting for it:
+//..
+//  my_Event event;
+//
+//  event.signal();
+//  event.wait();  // returns immediately
+//..
+
+#ifndef INCLUDED_BSLS_ATOMICOPERATIONS
+#include <bsls_atomicoperations.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)                                           \
+ && (defined(BSLS_PLATFORM_CPU_X86) || defined(BSLS_PLATFORM_CPU_X86_64))
+
+#ifndef INCLUDED_EMMINTRIN
+#include <emmintrin.h>     // for '_mm_pause'
+#define INCLUDED_EMMINTRIN
+#endif
+
+#endif
+
+namespace BloombergLP {
+namespace bsls {
+
+                              // ===============
+                              // struct WaitUtil
+                              // ===============
+
+struct WaitUtil {
+    // This 'struct' provides a namespace for primitives to spin, and to block
+    // until the value of an atomic integer changes.
+
+    // CLASS METHODS
+    static void pause();
+        // Signal to the processor that the calling thread is spinning (i.e.,
+        // repeatedly examining a location of memory that another thread is
+        // expected to modify).
+
+    static void wait(AtomicOperations::AtomicTypes::Int *address,
+                     int                                 expectedValue);
+        // Block the calling thread, if the specified 'address' holds the
+        // specified 'expectedValue', until 'wakeOne' or 'wakeAll' is called
+        // on 'address'; return immediately otherwise.  The comparison and the
+        // blocking are atomic with respect to 'wakeOne' and 'wakeAll'.  Note
+        // that this function can return spuriously, and is meant to be called
+        // in a loop re-examining 'address'.
+
+    static void wakeAll(AtomicOperations::AtomicTypes::Int *address);
+        // Wake all of the threads blocked in 'wait' on the specified
+        // 'address'.
+
+    static void wakeOne(AtomicOperations::AtomicTypes::Int *address);
+        // Wake at least one of the threads blocked in 'wait' on the specified
+        // 'address', if any.  Note that this function can wake more than one
+        // thread (see {Implementation}).
+};
+
+// ============================================================================
+//                          INLINE DEFINITIONS
+// ============================================================================
+
+                              // ---------------
+                              // struct WaitUtil
+                              // ---------------
+
+// CLASS METHODS
+inline
+void WaitUtil::pause()
+{
+#if defined(BSLS_PLATFORM_CMP_MSVC)                                           \
+ && (defined(BSLS_PLATFORM_CPU_X86) || defined(BSLS_PLATFORM_CPU_X86_64))
+    _mm_pause();
+#elif (defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG))    \
+   && (defined(BSLS_PLATFORM_CPU_X86) || defined(BSLS_PLATFORM_CPU_X86_64))
+    __asm__ __volatile__("pause" ::: "memory");
+#elif (defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG))    \
+   && defined(BSLS_PLATFORM_CPU_ARM_V7)
+    __asm__ __volatile__("yield" ::: "memory");
+#elif defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG)
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
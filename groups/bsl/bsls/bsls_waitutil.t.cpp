@@ -0,0 +1,500 @@
+// bsls_waitutil.t.cpp                                                -*-C++-*-
+
+#include <bsls_waitutil.h>
+
+#include <bsls_atomic.h>         // for testing only
+#include <bsls_bsltestutil.h>    // for testing only
+#include <bsls_platform.h>       // for testing only
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+using namespace BloombergLP;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides primitives to spin, and to block until
+// the value of an atomic integer changes.  We verify that 'wait' returns
+// immediately when the integer does not hold the expected value, that the
+// wake functions have no effect when no thread is blocked, and that threads
+// blocked in 'wait' are woken by 'wakeAll' and (eventually, one call at a
+// time) by 'wakeOne'.  Since 'wait' can return spuriously, the threads wait
+// in a loop, and the tests verify only that each thread returns once the
+// value has changed and it has been woken.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 1] void pause();
+// [ 2] void wait(AtomicTypes::Int *address, int expectedValue);
+// [ 3] void wakeAll(AtomicTypes::Int *address);
+// [ 4] void wakeOne(AtomicTypes::Int *address);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+
+// ============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bsls::WaitUtil                           Obj;
+typedef bsls::AtomicOperations                   AtomicOps;
+typedef bsls::AtomicOperations::AtomicTypes::Int AtomicInt;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+void sleepMilliseconds(int milliseconds)
+    // Suspend the calling thread for the specified 'milliseconds'.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    Sleep(milliseconds);
+#else
+    usleep(milliseconds * 1000);
+#endif
+}
+
+struct WaitArgs {
+    // This 'struct' holds the arguments of 'waitThread'.
+
+    AtomicInt       *d_value_p;     // integer waited on
+    bsls::AtomicInt *d_numReady_p;  // number of threads about to wait
+    bsls::AtomicInt *d_numDone_p;   // number of threads done waiting
+};
+
+extern "C"
+void *waitThread(void *arg)
+    // Wait, as described by the specified 'arg' (a 'WaitArgs' object), until
+    // the integer it refers to is not 0.
+{
+    WaitArgs *args = static_cast<WaitArgs *>(arg);
+
+    ++*args->d_numReady_p;
+    while (0 == AtomicOps::getIntAcquire(args->d_value_p)) {
+        Obj::wait(args->d_value_p, 0);
+    }
+    ++*args->d_numDone_p;
+    return 0;
+}
+
+                                // -------
+                                // case 5
+                                // -------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: A One-Shot Event
+///- - - - - - - - - - - - - -
+// Suppose that we want threads to wait until an event, signaled once by
+// another thread, has occurred, spinning a little before blocking.
+//
+// First, we define the event, holding 1 once it has occurred:
+//..
+    class my_Event {
+        // This class implements an event that can be waited for, and
+        // signaled once.
+
+        // DATA
+        bsls::AtomicOperations::AtomicTypes::Int d_state;  // 1 if signaled
+
+      public:
+        // CREATORS
+        my_Event()
+        {
+            bsls::AtomicOperations::initInt(&d_state, 0);
+        }
+
+        // MANIPULATORS
+        void signal()
+        {
+            bsls::AtomicOperations::setIntRelease(&d_state, 1);
+            bsls::WaitUtil::wakeAll(&d_state);
+        }
+
+        void wait()
+        {
+            for (int i = 0; i < 100; ++i) {
+                if (bsls::AtomicOperations::getIntAcquire(&d_state)) {
+                    return;                                           // RETURN
+                }
+                bsls::WaitUtil::pause();
+            }
+            while (0 == bsls::AtomicOperations::getIntAcquire(&d_state)) {
+                bsls::WaitUtil::wait(&d_state, 0);
+            }
+        }
+    };
+//..
+
+// ============================================================================
+//                              MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Note that 'wait' may return spuriously, which the loop of 'my_Event::wait'
+// handles.  Then, a thread signals the event, which wakes the threads
+// waiting for it:
+//..
+    my_Event event;
+
+    event.signal();
+    event.wait();  // returns immediately
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // 'wakeOne'
+        //
+        // Concerns:
+        //: 1 'wakeOne' wakes a thread blocked on the integer, so that calling
+        //:   'wakeOne' repeatedly (once the value has changed) eventually
+        //:   wakes all of the blocked threads.
+        //:
+        //: 2 'wakeOne' has no effect when no thread is blocked.
+        //
+        // Plan:
+        //: 1 Call 'wakeOne' on an integer on which no thread waits.  (C-2)
+        //:
+        //: 2 Start several threads waiting for an integer to become non-zero,
+        //:   wait for them to be about to block, change the integer, and call
+        //:   'wakeOne' until all of the threads are done.  (C-1)
+        //
+        // Testing:
+        //   void wakeOne(AtomicTypes::Int *address);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'wakeOne'"
+                            "\n=========\n");
+
+        AtomicInt value;
+        AtomicOps::initInt(&value, 0);
+
+        Obj::wakeOne(&value);
+
+        enum { k_NUM_THREADS = 4 };
+
+        bsls::AtomicInt numReady(0);
+        bsls::AtomicInt numDone(0);
+        WaitArgs        args = { &value, &numReady, &numDone };
+
+        ThreadId threads[k_NUM_THREADS];
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            threads[i] = createThread(&waitThread, &args);
+        }
+        while (numReady < k_NUM_THREADS) {
+            sleepMilliseconds(1);
+        }
+        sleepMilliseconds(10);  // let the threads block
+
+        ASSERT(0 == numDone);
+
+        AtomicOps::setIntRelease(&value, 1);
+
+        int numCalls = 0;
+        while (numDone < k_NUM_THREADS) {
+            Obj::wakeOne(&value);
+            ++numCalls;
+            sleepMilliseconds(1);
+        }
+        if (veryVerbose) { P(numCalls) }
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            joinThread(threads[i]);
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'wakeAll'
+        //
+        // Concerns:
+        //: 1 'wakeAll' wakes all of the threads blocked on the integer.
+        //:
+        //: 2 'wakeAll' has no effect when no thread is blocked.
+        //:
+        //: 3 Threads blocked on an integer are not woken by the wake functions
+        //:   called on another integer (except spuriously).
+        //
+        // Plan:
+        //: 1 Call 'wakeAll' on an integer on which no thread waits.  (C-2)
+        //:
+        //: 2 Start several threads waiting for an integer to become non-zero,
+        //:   wait for them to be about to block, wake the threads blocked on
+        //:   another integer, and verify that none of the threads is done.
+        //:   (C-3)
+        //:
+        //: 3 Change the integer, call 'wakeAll' once, and verify that all of
+        //:   the threads are done.  (C-1)
+        //
+        // Testing:
+        //   void wakeAll(AtomicTypes::Int *address);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'wakeAll'"
+                            "\n=========\n");
+
+        AtomicInt value;
+        AtomicOps::initInt(&value, 0);
+
+        AtomicInt other;
+        AtomicOps::initInt(&other, 0);
+
+        Obj::wakeAll(&value);
+
+        enum { k_NUM_THREADS = 4 };
+
+        bsls::AtomicInt numReady(0);
+        bsls::AtomicInt numDone(0);
+        WaitArgs        args = { &value, &numReady, &numDone };
+
+        ThreadId threads[k_NUM_THREADS];
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            threads[i] = createThread(&waitThread, &args);
+        }
+        while (numReady < k_NUM_THREADS) {
+            sleepMilliseconds(1);
+        }
+        sleepMilliseconds(10);  // let the threads block
+
+        Obj::wakeAll(&other);
+        sleepMilliseconds(10);
+
+        ASSERT(0 == numDone);
+
+        AtomicOps::setIntRelease(&value, 1);
+        Obj::wakeAll(&value);
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            joinThread(threads[i]);
+        }
+        ASSERT(k_NUM_THREADS == numDone);
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // 'wait'
+        //
+        // Concerns:
+        //: 1 'wait' returns immediately if the integer does not hold the
+        //:   expected value.
+        //:
+        //: 2 'wait' does not modify the integer.
+        //
+        // Plan:
+        //: 1 Call 'wait' on integers having values other than the expected
+        //:   value, and verify that it returns, and that the integer is
+        //:   unchanged.  (C-1..2)
+        //
+        // Testing:
+        //   void wait(AtomicTypes::Int *address, int expectedValue);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'wait'"
+                            "\n======\n");
+
+        static const struct {
+            int d_line;      // source line number
+            int d_value;     // value of the integer
+            int d_expected;  // value expected by 'wait'
+        } DATA[] = {
+            //LINE  VALUE        EXPECTED
+            //----  -----------  -----------
+            { L_,             0,           1 },
+            { L_,             1,           0 },
+            { L_,            -1,           1 },
+            { L_,    0x7FFFFFFF, -0x7FFFFFFF },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE     = DATA[ti].d_line;
+            const int VALUE    = DATA[ti].d_value;
+            const int EXPECTED = DATA[ti].d_expected;
+
+            AtomicInt value;
+            AtomicOps::initInt(&value, VALUE);
+
+            Obj::wait(&value, EXPECTED);
+
+            ASSERTV(LINE, VALUE == AtomicOps::getInt(&value));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The component is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Call 'pause', call 'wait' on an integer not holding the expected
+        //:   value, and wake a thread blocked on an integer.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   void pause();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        for (int i = 0; i < 100; ++i) {
+            Obj::pause();
+        }
+
+        AtomicInt value;
+        AtomicOps::initInt(&value, 0);
+
+        Obj::wait(&value, 1);
+
+        bsls::AtomicInt numReady(0);
+        bsls::AtomicInt numDone(0);
+        WaitArgs        args = { &value, &numReady, &numDone };
+
+        ThreadId thread = createThread(&waitThread, &args);
+        while (0 == numReady) {
+            sleepMilliseconds(1);
+        }
+
+        AtomicOps::setIntRelease(&value, 1);
+        Obj::wakeAll(&value);
+
+        joinThread(thread);
+        ASSERT(1 == numDone);
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -387,6 +387,14 @@ BSL_OVERRIDES_STD mode"
 #include <bslmf_nestedtraitdeclaration.h>
 #endif
 
+#ifndef INCLUDED_BSLS_ALIGNMENTFROMTYPE
+#include <bsls_alignmentfromtype.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTUTIL
+#include <bsls_alignmentutil.h>
+#endif
+
 #ifndef INCLUDED_BSLS_ASSERT
 #include <bsls_assert.h>
 #endif
@@ -505,16 +513,22 @@ class allocator {
     // MANIPULATORS
     pointer allocate(size_type n, const void *hint = 0);
         // Allocate enough (properly aligned) space for the specified 'n'
-        // objects of (template parameter) 'TYPE' by calling 'allocate' on the
-        // mechanism object.  The optionally specified 'hint' argument is
-        // ignored by this allocator type.  The behavior is undefined unless
-        // 'n <= max_size()'.
+        // objects of (template parameter) 'TYPE' by calling 'allocateSized'
+        // on the mechanism object, or, if the alignment of 'TYPE' exceeds
+        // 'bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT', by calling
+        // 'allocateAligned' with the alignment of 'TYPE'.  The optionally
+        // specified 'hint' argument is ignored by this allocator type.  The
+        // behavior is undefined unless 'n <= max_size()'.
 
     void deallocate(pointer p, size_type n = 1);
         // Return memory previously allocated with 'allocate' to the underlying
-        // mechanism object by calling 'deallocate' on the the mechanism
-        // object with the specified 'p'.  The optionally specified 'n'
-        // argument is ignored by this allocator type.
+        // mechanism object by calling 'deallocateSized' (or, for an
+        // over-aligned 'TYPE', 'deallocateAligned') on the mechanism object
+        // with the specified 'p' and the size (in bytes) of the optionally
+        // specified 'n' objects of (template parameter) 'TYPE'.
+        // The behavior is undefined unless 'p' was obtained from a call to
+        // 'allocate' on an allocator comparing equal to this one, supplying
+        // the same 'n'.
 
     void construct(pointer p, const TYPE& val);
         // Copy-construct an object of (template parameter) 'TYPE' from the
@@ -731,7 +745,16 @@ allocator<TYPE>::allocate(typename allocator::size_type  n,
     BSLS_ASSERT_SAFE(n <= this->max_size());
 
     (void) hint;  // suppress unused parameter warning
-    return static_cast<pointer>(d_mechanism->allocate(n * sizeof(TYPE)));
+
+    const int alignment = BloombergLP::bsls::AlignmentFromType<TYPE>::VALUE;
+
+    if (alignment > BloombergLP::bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT) {
+        return static_cast<pointer>(
+                    d_mechanism->allocateAligned(n * sizeof(TYPE), alignment));
+                                                                      // RETURN
+    }
+
+    return static_cast<pointer>(d_mechanism->allocateSized(n * sizeof(TYPE)));
 }
 
 template <class TYPE>
@@ -739,8 +762,14 @@ inline
 void allocator<TYPE>::deallocate(typename allocator::pointer   p,
                                  typename allocator::size_type n)
 {
-    (void) n;  // suppress unsued parameter warning
-    d_mechanism->deallocate(p);
+    const int alignment = BloombergLP::bsls::AlignmentFromType<TYPE>::VALUE;
+
+    if (alignment > BloombergLP::bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT) {
+        d_mechanism->deallocateAligned(p, n * sizeof(TYPE), alignment);
+        return;                                                       // RETURN
+    }
+
+    d_mechanism->deallocateSized(p, n * sizeof(TYPE));
 }
 
 template <class TYPE>
@@ -52,8 +52,8 @@ using namespace BloombergLP;
 //
 // Modifiers
 // [  ] allocator& operator=(const allocator& rhs);
-// [  ] pointer allocate(size_type n, const void *hint = 0);
-// [  ] void deallocate(pointer p, size_type n = 1);
+// [ 6] pointer allocate(size_type n, const void *hint = 0);
+// [ 6] void deallocate(pointer p, size_type n = 1);
 // [  ] void construct(pointer p, const TYPE& val);
 // [  ] void destroy(pointer p);
 //
@@ -83,7 +83,7 @@ using namespace BloombergLP;
 // [  ] bool operator!=(bsl::allocator<T>,  bslma::Allocator*);
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 6] USAGE EXAMPLE
+// [ 7] USAGE EXAMPLE
 // [ 2] bsl::is_trivially_copyable<bsl::allocator>
 // [ 2] bslmf::IsBitwiseEqualityComparable<sl::allocator>
 // [ 2] bslmf::IsBitwiseMoveable<bsl::allocator>
@@ -494,7 +494,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 6: {
+      case 7: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -517,6 +517,63 @@ int main(int argc, char *argv[])
         usageExample();
 
       } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocate' AND 'deallocate'
+        //
+        // Concerns:
+        //   o that 'allocate' obtains 'n * sizeof(TYPE)' bytes from the
+        //     mechanism using 'allocateSized'.
+        //   o that 'deallocate' returns the memory to the mechanism using
+        //     'deallocateSized', supplying the same number of bytes.
+        //   o that 'deallocate' with a different 'n' is detected (by the
+        //     test allocator) as a mismatch.
+        //
+        // Plan: Allocate and deallocate arrays of various lengths from an
+        //   allocator using a test allocator as mechanism, and verify the
+        //   sizes recorded by the test allocator.  Then, in quiet mode,
+        //   deallocate an array supplying a different length.
+        //
+        // Testing:
+        //   pointer allocate(size_type n, const void *hint = 0);
+        //   void deallocate(pointer p, size_type n = 1);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'allocate' AND 'deallocate'"
+                            "\n===================================\n");
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        bsl::allocator<int> mX(&ta);
+
+        for (int n = 1; n <= 8; ++n) {
+            const bslma::Allocator::size_type NUM_BYTES = n * sizeof(int);
+
+            int *p = mX.allocate(n);
+            LOOP_ASSERT(n, p);
+            LOOP_ASSERT(n, NUM_BYTES == ta.lastAllocatedNumBytes());
+            LOOP_ASSERT(n, 1         == ta.numBlocksInUse());
+
+            mX.deallocate(p, n);
+            LOOP_ASSERT(n, NUM_BYTES == ta.lastDeallocatedNumBytes());
+            LOOP_ASSERT(n, 0         == ta.numBlocksInUse());
+            LOOP_ASSERT(n, 0         == ta.numMismatches());
+        }
+
+        if (verbose) printf("\tTesting mismatched 'n'.\n");
+        {
+            ta.setQuiet(true);
+
+            int *p = mX.allocate(4);
+            mX.deallocate(p, 3);
+            ASSERT(1 == ta.numMismatches());
+            ASSERT(1 == ta.numBlocksInUse());
+
+            mX.deallocate(p, 4);
+            ASSERT(1 == ta.numMismatches());
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+      } break;
       case 5: {
         // --------------------------------------------------------------------
         // TESTING NESTED TYPES
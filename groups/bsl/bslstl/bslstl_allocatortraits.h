@@ -11,8 +11,9 @@ BSLS_IDENT("$Id: $")
 //
 //@CLASSES:
 //  bsl::allocator_traits: Uniform interface to standard allocator types
+//  bslstl::SuppliesBslmaAllocator: trait for allocators exposing a mechanism
 //
-//@SEE_ALSO: bslma_allocator, bslstl_allocator
+//@SEE_ALSO: bslma_allocator, bslstl_allocator, bslstl_staticallocator
 //
 //@DESCRIPTION: The standard 'allocator_traits' class template is defined in
 // the C++11 standard ([allocator.traits]) as a uniform mechanism for accessing
@@ -66,6 +67,14 @@ BSLS_IDENT("$Id: $")
 // all have a 'false' value, so allocators are not propagated on assignment or
 // swap.
 //
+// An allocator type that is *not* convertible from 'bslma::Allocator *', but
+// that is nonetheless backed by a 'bslma::Allocator' (e.g.,
+// 'bsl::static_allocator' instantiated on a concrete 'bslma::Allocator'
+// class), can declare the 'bslstl::SuppliesBslmaAllocator' trait to have
+// 'construct' pass 'allocator.mechanism()' to elements having the
+// 'bslma::UsesBslmaAllocator' trait.  Such an allocator otherwise follows the
+// C++03 model: in particular, it is copied on container copy construction.
+//
 // Note that use of this component will differ from a strict following of the
 // C++03 standard, as the 'construct' and 'destroy' methods of the
 // parameterized allocator type will not be called.  Rather, the target object
@@ -404,6 +413,14 @@ BSL_OVERRIDES_STD mode"
 #include <bslma_allocator.h>
 #endif
 
+#ifndef INCLUDED_BSLMF_DETECTNESTEDTRAIT
+#include <bslmf_detectnestedtrait.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_INTEGRALCONSTANT
+#include <bslmf_integralconstant.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_ISCONVERTIBLE
 #include <bslmf_isconvertible.h>
 #endif
@@ -421,6 +438,27 @@ BSL_OVERRIDES_STD mode"
 
 #endif
 
+namespace BloombergLP {
+namespace bslstl {
+
+                        // =============================
+                        // struct SuppliesBslmaAllocator
+                        // =============================
+
+template <class ALLOCATOR_TYPE>
+struct SuppliesBslmaAllocator
+: bslmf::DetectNestedTrait<ALLOCATOR_TYPE, SuppliesBslmaAllocator>::type {
+    // This metafunction is derived from 'true_type' if the (template
+    // parameter) 'ALLOCATOR_TYPE', although not convertible from
+    // 'bslma::Allocator *', provides a 'mechanism' accessor returning a
+    // pointer convertible to 'bslma::Allocator *' that 'bsl::allocator_traits'
+    // should supply to elements having the 'bslma::UsesBslmaAllocator' trait,
+    // and from 'false_type' otherwise.  This trait is typically associated
+    // with an allocator type using 'BSLMF_NESTED_TRAIT_DECLARATION_IF'.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
 
 namespace bsl {
 
@@ -449,11 +487,23 @@ struct allocator_traits {
     // deduce data types that are not specified in the allocator.
 
   private:
-    // 'IsBslma' is 'true_type' if the parameterized 'ALLOCATOR_TYPE' is
-    // constructible from 'bslma::Allocator*'.  In other words, its 'VALUE' is
-    // 'true' if 'ALLOCATOR_TYPE' is a wrapper around 'bslma::Allocator *'.
+    // 'IsBslmaConvertible' is 'true_type' if the parameterized
+    // 'ALLOCATOR_TYPE' is constructible from 'bslma::Allocator*'.  In other
+    // words, its 'VALUE' is 'true' if 'ALLOCATOR_TYPE' is a wrapper around
+    // 'bslma::Allocator *'.
     typedef typename is_convertible<BloombergLP::bslma::Allocator*,
-                                    ALLOCATOR_TYPE>::type IsBslma;
+                                    ALLOCATOR_TYPE>::type IsBslmaConvertible;
+
+    // 'IsBslma' is 'true_type' if 'IsBslmaConvertible' is 'true_type', or if
+    // the parameterized 'ALLOCATOR_TYPE' has the
+    // 'bslstl::SuppliesBslmaAllocator' trait.  In other words, its 'VALUE' is
+    // 'true' if 'ALLOCATOR_TYPE::mechanism()' is to be passed to elements
+    // having the 'bslma::UsesBslmaAllocator' trait.
+    typedef BloombergLP::bslstl::SuppliesBslmaAllocator<ALLOCATOR_TYPE>
+                                                             SuppliesMechanism;
+    typedef typename integral_constant<bool,
+                                       IsBslmaConvertible::value
+                                    || SuppliesMechanism::value>::type IsBslma;
 
     static void *mechanism(const ALLOCATOR_TYPE&, false_type);
         // Return a null pointer.  Note that this function is called only when
@@ -466,7 +516,8 @@ struct allocator_traits {
         // Return the address of the 'bslma::Allocator' that implements the
         // mechanism for the specified 'bslAllocator', i.e.,
         // 'allocator.mechanism()'.  Note that this function is called only
-        // when 'ALLOCATOR_TYPE' is bslma allocator.
+        // when 'ALLOCATOR_TYPE' is bslma allocator, or has the
+        // 'bslstl::SuppliesBslmaAllocator' trait.
 
     static
     ALLOCATOR_TYPE selectOnCopyConstruct(const ALLOCATOR_TYPE& stdAllocator,
@@ -1696,7 +1747,7 @@ ALLOCATOR_TYPE
 allocator_traits<ALLOCATOR_TYPE>::select_on_container_copy_construction(
                                                      const ALLOCATOR_TYPE& rhs)
 {
-    return selectOnCopyConstruct(rhs, IsBslma());
+    return selectOnCopyConstruct(rhs, IsBslmaConvertible());
 }
 
 }  // close namespace bsl
@@ -0,0 +1,335 @@
+// bslstl_atomicsharedptr.cpp                                         -*-C++-*-
+#include <bslstl_atomicsharedptr.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bslma_default.h>
+
+#include <bsls_assert.h>
+#include <bsls_waitutil.h>
+
+#include <new>
+
+// IMPLEMENTATION NOTES: The word of an 'AtomicSharedPtr_Imp' holds the
+// address of the current node in its high bits, and the number of readers
+// that have "pinned" that node in its low bits, selected by 'k_COUNT_MASK'
+// (the "external" count).  A null word denotes an empty slot, and is never
+// pinned.
+//
+// A writer that swaps a node out of the word adds the external count it
+// swapped out to the node's "internal" count, while each pinned reader that
+// subsequently finds its node replaced decrements the internal count instead
+// of the external one.  The internal count therefore reaches zero exactly
+// once, after the writer and all readers counted in the swapped-out word are
+// done with the node, and whichever thread brings it to zero destroys the
+// node.  Since a node is never reinstalled in the word, and is not destroyed
+// while a reader holds a pin on it, the 'testAndSwap' operations below are
+// not subject to the ABA problem.
+
+namespace BloombergLP {
+namespace bslstl {
+namespace {
+
+typedef bsls::Types::Int64   Int64;
+typedef bsls::Types::UintPtr UintPtr;
+
+enum {
+    k_NODE_ALIGNMENT = 64,                    // alignment of every node
+    k_COUNT_MASK     = k_NODE_ALIGNMENT - 1   // bits of the reader count
+};
+
+}  // close unnamed namespace
+
+                        // ===========================
+                        // struct AtomicSharedPtr_Node
+                        // ===========================
+
+struct AtomicSharedPtr_Node {
+    // This 'struct' holds one value of an 'AtomicSharedPtr_Imp' and the
+    // internal reader count used to reclaim it once it has been replaced.
+
+    // DATA
+    void                *d_ptr_p;          // address of the shared object
+    bslma::SharedPtrRep *d_rep_p;          // representation (one reference
+                                           // owned)
+    bsls::AtomicInt      d_internalCount;  // transferred external count, less
+                                           // readers done after replacement
+    void                *d_block_p;        // allocated block holding this node
+};
+
+// STATIC HELPER FUNCTIONS
+static inline
+AtomicSharedPtr_Node *nodeOf(Int64 word)
+    // Return the address of the node designated by the specified 'word'.
+{
+    return reinterpret_cast<AtomicSharedPtr_Node *>(
+                          static_cast<UintPtr>(word & ~Int64(k_COUNT_MASK)));
+}
+
+static inline
+Int64 wordOf(AtomicSharedPtr_Node *node)
+    // Return the word designating the specified 'node' with no readers.
+{
+    return static_cast<Int64>(reinterpret_cast<UintPtr>(node));
+}
+
+                         // -------------------------
+                         // class AtomicSharedPtr_Imp
+                         // -------------------------
+
+// PRIVATE MANIPULATORS
+AtomicSharedPtr_Node *AtomicSharedPtr_Imp::makeNode(void                *ptr,
+                                                    bslma::SharedPtrRep *rep)
+{
+    if (0 == ptr && 0 == rep) {
+        return 0;                                                     // RETURN
+    }
+
+    void *block = d_allocator_p->allocate(sizeof(AtomicSharedPtr_Node)
+                                          + k_NODE_ALIGNMENT - 1);
+
+    UintPtr address = (reinterpret_cast<UintPtr>(block) + k_COUNT_MASK)
+                    & ~static_cast<UintPtr>(k_COUNT_MASK);
+
+    AtomicSharedPtr_Node *node = new (reinterpret_cast<void *>(address))
+                                                         AtomicSharedPtr_Node;
+    node->d_ptr_p   = ptr;
+    node->d_rep_p   = rep;
+    node->d_block_p = block;
+
+    if (rep) {
+        rep->acquireRef();
+    }
+    return node;
+}
+
+void AtomicSharedPtr_Imp::destroyNode(AtomicSharedPtr_Node *node) const
+{
+    BSLS_ASSERT_SAFE(node);
+
+    if (node->d_rep_p) {
+        node->d_rep_p->releaseRef();
+    }
+
+    void *block = node->d_block_p;
+    node->~AtomicSharedPtr_Node();
+    d_allocator_p->deallocate(block);
+}
+
+void AtomicSharedPtr_Imp::retire(Int64 word, int numHeld) const
+{
+    AtomicSharedPtr_Node *node = nodeOf(word);
+    if (!node) {
+        return;                                                       // RETURN
+    }
+
+    const int numReaders = static_cast<int>(word & k_COUNT_MASK) - numHeld;
+
+    BSLS_ASSERT_SAFE(0 <= numReaders);
+
+    if (0 == node->d_internalCount.addAcqRel(numReaders)) {
+        destroyNode(node);
+    }
+}
+
+// PRIVATE ACCESSORS
+Int64 AtomicSharedPtr_Imp::pin() const
+{
+    Int64 word = d_word.loadAcquire();
+
+    while (0 != word) {
+        if (k_COUNT_MASK == (word & k_COUNT_MASK)) {
+            // The reader count is saturated; wait for a reader to finish.
+
+            bsls::WaitUtil::pause();
+            word = d_word.loadAcquire();
+            continue;
+        }
+
+        const Int64 previous = d_word.testAndSwapAcqRel(word, word + 1);
+        if (previous == word) {
+            return word + 1;                                          // RETURN
+        }
+        word = previous;
+    }
+    return 0;
+}
+
+void AtomicSharedPtr_Imp::unpin(AtomicSharedPtr_Node *node) const
+{
+    BSLS_ASSERT_SAFE(node);
+
+    const Int64 nodeWord = wordOf(node);
+
+    Int64 word = d_word.loadRelaxed();
+    while ((word & ~Int64(k_COUNT_MASK)) == nodeWord) {
+        BSLS_ASSERT_SAFE(0 != (word & k_COUNT_MASK));
+
+        const Int64 previous = d_word.testAndSwapAcqRel(word, word - 1);
+        if (previous == word) {
+            return;                                                   // RETURN
+        }
+        word = previous;
+    }
+
+    // 'node' has been replaced: our pin was transferred to its internal
+    // count.
+
+    if (0 == node->d_internalCount.addAcqRel(-1)) {
+        destroyNode(node);
+    }
+}
+
+// CREATORS
+AtomicSharedPtr_Imp::AtomicSharedPtr_Imp(void                *ptr,
+                                         bslma::SharedPtrRep *rep,
+                                         bslma::Allocator    *basicAllocator)
+: d_word(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    d_word.storeRelease(wordOf(makeNode(ptr, rep)));
+}
+
+AtomicSharedPtr_Imp::~AtomicSharedPtr_Imp()
+{
+    BSLS_ASSERT_SAFE(0 == (d_word.loadRelaxed() & k_COUNT_MASK));
+
+    retire(d_word.loadAcquire(), 0);
+}
+
+// MANIPULATORS
+bool AtomicSharedPtr_Imp::compareExchange(void                **expectedPtr,
+                                          bslma::SharedPtrRep **expectedRep,
+                                          void                 *ptr,
+                                          bslma::SharedPtrRep  *rep)
+{
+    BSLS_ASSERT_SAFE(expectedPtr);
+    BSLS_ASSERT_SAFE(expectedRep);
+
+    // Allocate the new node up front, so that no allocation (which may throw)
+    // happens while a node is pinned.
+
+    AtomicSharedPtr_Node *newNode = makeNode(ptr, rep);
+
+    Int64 word = pin();
+    for (;;) {
+        AtomicSharedPtr_Node *node       = nodeOf(word);
+        void                 *currentPtr = node ? node->d_ptr_p : 0;
+        bslma::SharedPtrRep  *currentRep = node ? node->d_rep_p : 0;
+
+        if (currentPtr != *expectedPtr || currentRep != *expectedRep) {
+            if (currentRep) {
+                currentRep->acquireRef();
+            }
+            *expectedPtr = currentPtr;
+            *expectedRep = currentRep;
+
+            if (node) {
+                unpin(node);
+            }
+            if (newNode) {
+                destroyNode(newNode);
+            }
+            return false;                                             // RETURN
+        }
+
+        const Int64 previous = d_word.testAndSwapAcqRel(word,
+                                                        wordOf(newNode));
+        if (previous == word) {
+            // Our own pin (if any) is released along with the swapped-out
+            // word.
+
+            retire(word, node ? 1 : 0);
+            return true;                                              // RETURN
+        }
+
+        if (node && nodeOf(previous) == node) {
+            // Only the reader count changed; we still hold our pin.
+
+            word = previous;
+            continue;
+        }
+
+        if (node) {
+            unpin(node);
+        }
+        word = pin();
+    }
+}
+
+void AtomicSharedPtr_Imp::exchange(void                **oldPtr,
+                                   bslma::SharedPtrRep **oldRep,
+                                   void                 *ptr,
+                                   bslma::SharedPtrRep  *rep)
+{
+    BSLS_ASSERT_SAFE(oldPtr);
+    BSLS_ASSERT_SAFE(oldRep);
+
+    const Int64 word = d_word.swapAcqRel(wordOf(makeNode(ptr, rep)));
+
+    AtomicSharedPtr_Node *node = nodeOf(word);
+    if (!node) {
+        *oldPtr = 0;
+        *oldRep = 0;
+        return;                                                       // RETURN
+    }
+
+    // The node cannot be reclaimed before 'retire' is called, so it is safe
+    // to acquire a reference through it.  Readers may still be reading the
+    // node, so its reference cannot simply be transferred to the caller.
+
+    *oldPtr = node->d_ptr_p;
+    *oldRep = node->d_rep_p;
+    if (*oldRep) {
+        (*oldRep)->acquireRef();
+    }
+    retire(word, 0);
+}
+
+void AtomicSharedPtr_Imp::store(void *ptr, bslma::SharedPtrRep *rep)
+{
+    retire(d_word.swapAcqRel(wordOf(makeNode(ptr, rep))), 0);
+}
+
+// ACCESSORS
+void AtomicSharedPtr_Imp::load(void **ptr, bslma::SharedPtrRep **rep) const
+{
+    BSLS_ASSERT_SAFE(ptr);
+    BSLS_ASSERT_SAFE(rep);
+
+    const Int64 word = pin();
+
+    AtomicSharedPtr_Node *node = nodeOf(word);
+    if (!node) {
+        *ptr = 0;
+        *rep = 0;
+        return;                                                       // RETURN
+    }
+
+    *ptr = node->d_ptr_p;
+    *rep = node->d_rep_p;
+    if (*rep) {
+        (*rep)->acquireRef();
+    }
+    unpin(node);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,536 @@
+// bslstl_atomicsharedptr.h                                           -*-C++-*-
+#ifndef INCLUDED_BSLSTL_ATOMICSHAREDPTR
+#define INCLUDED_BSLSTL_ATOMICSHAREDPTR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id$ $CSID$")
+
+//@PURPOSE: Provide a shared pointer that can be read and written atomically.
+//
+//@CLASSES:
+//  bsl::atomic_shared_ptr: shared pointer slot with atomic load and store
+//
+//@SEE_ALSO: bslstl_sharedptr, bsls_atomic
+//
+//@DESCRIPTION: This component provides a class template,
+// 'bsl::atomic_shared_ptr', holding a 'bsl::shared_ptr' value that may be
+// loaded, stored, exchanged, and compared-and-exchanged concurrently by any
+// number of threads without external synchronization.  A typical use is the
+// publication of immutable snapshots (e.g., configuration or reference data):
+// a writer builds a new snapshot and 'store's it, while readers 'load' the
+// current snapshot on every request.  Each loaded 'shared_ptr' keeps its
+// snapshot alive for as long as the reader needs it, regardless of subsequent
+// stores.
+//
+// The interface follows that of the C++20 'std::atomic<std::shared_ptr<T>>'
+// specialization (and the earlier 'std::experimental::atomic_shared_ptr'),
+// except that memory-order arguments are not supported: every operation is
+// sequentially consistent with respect to the other operations on the same
+// 'atomic_shared_ptr'.
+//
+///Implementation Overview
+///-----------------------
+// An 'atomic_shared_ptr' does not use a mutex.  Its value is held in a small
+// node, allocated from the object's allocator whenever a new value is stored,
+// that owns one (atomic) shared reference to the stored 'shared_ptr'.  The
+// object holds a single atomic word packing the address of the current node
+// with a count of readers that are in the middle of a 'load' ("split
+// reference counting").  A reader:
+//
+//: 1 Atomically increments the reader count in the word, which prevents the
+//:   node it designates from being reclaimed.
+//:
+//: 2 Acquires a shared reference to the stored object using the node.
+//:
+//: 3 Decrements the reader count, either in the word (if the node is still
+//:   current) or in the node itself (if a writer has since replaced it).
+//
+// A writer atomically swaps in a new node and transfers the reader count it
+// swapped out to the old node, which is reclaimed (releasing its shared
+// reference) by whichever thread finishes with it last.
+//
+// Nodes are aligned on 64-byte boundaries, leaving 6 bits of the word for the
+// reader count; a 'load' that would exceed 63 simultaneous readers in steps
+// 1-3 above waits (spins) until one of them completes.  Since a reader holds
+// its count only for the duration of two atomic operations, such waits are
+// rare in practice, and no thread ever waits for a writer.
+//
+///Performance
+///-----------
+// 'load' performs three atomic read-modify-write operations (two on the
+// 'atomic_shared_ptr' and one on the shared reference count), and never
+// allocates memory.  'store', 'exchange', and a successful
+// 'compare_exchange_strong' each allocate a node from the object's allocator.
+// This makes 'atomic_shared_ptr' well suited to read-mostly data: readers
+// contend only on the cache line of the 'atomic_shared_ptr' itself, and never
+// wait for a writer or for each other.  Readers that must minimize even this
+// contention may hold on to a loaded 'shared_ptr' and reload it periodically.
+//
+///Thread Safety
+///-------------
+// All of the manipulators and accessors of 'atomic_shared_ptr' (other than
+// construction and destruction) may be called concurrently from any number of
+// threads.  As for 'bsl::shared_ptr', there is no guarantee regarding the
+// safety of accessing or modifying the object referred to by the stored value.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Publishing Configuration Snapshots
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a service reads its configuration on every incoming message,
+// while an administrative thread occasionally publishes a new configuration.
+// First, we define the (immutable) configuration type:
+//..
+//  struct MyConfig {
+//      // This 'struct' provides an immutable configuration snapshot.
+//
+//      int d_timeoutMs;
+//      int d_maxRetries;
+//  };
+//..
+// Then, we create an 'atomic_shared_ptr' holding the initial configuration,
+// supplying an allocator for the nodes it uses internally:
+//..
+//  bslma::TestAllocator ta;
+//
+//  MyConfig initial = { 100, 3 };
+//  bsl::atomic_shared_ptr<const MyConfig> config(
+//                              bsl::allocate_shared<MyConfig>(&ta, initial),
+//                              &ta);
+//..
+// Next, each message-processing thread loads the current snapshot, without
+// taking a lock.  The loaded 'shared_ptr' remains valid while it is used,
+// even if a new configuration is published concurrently:
+//..
+//  bsl::shared_ptr<const MyConfig> current = config.load();
+//  assert(100 == current->d_timeoutMs);
+//..
+// Now, the administrative thread publishes a new configuration:
+//..
+//  MyConfig updated = { 250, 5 };
+//  config.store(bsl::allocate_shared<MyConfig>(&ta, updated));
+//
+//  assert(250 == config.load()->d_timeoutMs);
+//  assert(100 == current->d_timeoutMs);
+//..
+// Finally, when the last reader releases the old snapshot, it is destroyed:
+//..
+//  current.reset();
+//  assert(2 == ta.numBlocksInUse());    // current snapshot and its node
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_SHAREDPTR
+#include <bslstl_sharedptr.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_SHAREDPTRREP
+#include <bslma_sharedptrrep.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bslstl {
+
+struct AtomicSharedPtr_Node;
+
+                         // =========================
+                         // class AtomicSharedPtr_Imp
+                         // =========================
+
+class AtomicSharedPtr_Imp {
+    // This component-private class implements a type-erased atomic shared
+    // pointer slot holding an object address and the shared pointer
+    // representation that manages it (see "Implementation Overview" in the
+    // component-level documentation).  Every pair of ('ptr', 'rep') values
+    // accepted by the methods of this class denote a (possibly empty)
+    // 'shared_ptr' value; a non-zero 'rep' is never adopted: the slot acquires
+    // its own reference.
+
+    // DATA
+    mutable bsls::AtomicInt64  d_word;         // address of current node,
+                                               // packed with the count of
+                                               // readers using that node
+
+    bslma::Allocator          *d_allocator_p;  // memory allocator (held, not
+                                               // owned)
+
+    // NOT IMPLEMENTED
+    AtomicSharedPtr_Imp(const AtomicSharedPtr_Imp&);
+    AtomicSharedPtr_Imp& operator=(const AtomicSharedPtr_Imp&);
+
+  private:
+    // PRIVATE MANIPULATORS
+    AtomicSharedPtr_Node *makeNode(void *ptr, bslma::SharedPtrRep *rep);
+        // Return the address of a new node, allocated from the allocator of
+        // this object, that holds a (newly acquired) reference to the value
+        // described by the specified 'ptr' and 'rep', or 0 if both 'ptr' and
+        // 'rep' are 0.
+
+    void destroyNode(AtomicSharedPtr_Node *node) const;
+        // Release the reference held by the specified 'node' and return its
+        // memory to the allocator of this object.
+
+    void retire(bsls::Types::Int64 word, int numHeld) const;
+        // Transfer the reader count of the specified 'word', which has just
+        // been replaced in this object, less the specified 'numHeld' readers
+        // held by the caller, to the node designated by 'word', and destroy
+        // that node if no reader remains.
+
+    // PRIVATE ACCESSORS
+    bsls::Types::Int64 pin() const;
+        // Register the calling thread as a reader of the current node and
+        // return the word designating that node (including the caller's
+        // reader count), or 0 if this object is empty.
+
+    void unpin(AtomicSharedPtr_Node *node) const;
+        // Unregister the calling thread as a reader of the specified 'node',
+        // destroying 'node' if it has been replaced and the calling thread is
+        // its last reader.
+
+  public:
+    // CREATORS
+    AtomicSharedPtr_Imp(void                *ptr,
+                        bslma::SharedPtrRep *rep,
+                        bslma::Allocator    *basicAllocator);
+        // Create a slot holding the value described by the specified 'ptr'
+        // and 'rep' (acquiring a reference to that value), using the specified
+        // 'basicAllocator' to supply memory.  If 'basicAllocator' is 0, the
+        // currently installed default allocator is used.
+
+    ~AtomicSharedPtr_Imp();
+        // Destroy this object, releasing the reference to its value.
+
+    // MANIPULATORS
+    bool compareExchange(void                **expectedPtr,
+                         bslma::SharedPtrRep **expectedRep,
+                         void                 *ptr,
+                         bslma::SharedPtrRep  *rep);
+        // If the value of this slot is the one described by the specified
+        // 'expectedPtr' and 'expectedRep', replace it with the value described
+        // by the specified 'ptr' and 'rep' (acquiring a reference to that
+        // value and releasing the reference to the previous one) and return
+        // 'true'.  Otherwise, load the value of this slot into 'expectedPtr'
+        // and 'expectedRep', acquiring a reference that the caller must
+        // adopt, and return 'false'.
+
+    void exchange(void                **oldPtr,
+                  bslma::SharedPtrRep **oldRep,
+                  void                 *ptr,
+                  bslma::SharedPtrRep  *rep);
+        // Replace the value of this slot with the value described by the
+        // specified 'ptr' and 'rep' (acquiring a reference to that value), and
+        // load the previous value into the specified 'oldPtr' and 'oldRep'.
+        // The reference to the previous value is transferred to the caller.
+
+    void store(void *ptr, bslma::SharedPtrRep *rep);
+        // Replace the value of this slot with the value described by the
+        // specified 'ptr' and 'rep', acquiring a reference to that value and
+        // releasing the reference to the previous one.
+
+    // ACCESSORS
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this object to supply memory.
+
+    void load(void **ptr, bslma::SharedPtrRep **rep) const;
+        // Load the value of this slot into the specified 'ptr' and 'rep',
+        // acquiring a reference that the caller must adopt.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+namespace bsl {
+
+                          // =======================
+                          // class atomic_shared_ptr
+                          // =======================
+
+template <class ELEMENT_TYPE>
+class atomic_shared_ptr {
+    // This class provides a 'shared_ptr<ELEMENT_TYPE>' value that may be
+    // read and written concurrently by multiple threads.  Readers never block
+    // on a mutex (see the "Implementation Overview" section in the
+    // component-level documentation).
+
+    // DATA
+    BloombergLP::bslstl::AtomicSharedPtr_Imp d_imp;  // type-erased slot
+
+    // NOT IMPLEMENTED
+    atomic_shared_ptr(const atomic_shared_ptr&);
+    atomic_shared_ptr& operator=(const atomic_shared_ptr&);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(atomic_shared_ptr,
+                                   BloombergLP::bslma::UsesBslmaAllocator);
+
+    // TYPES
+    typedef shared_ptr<ELEMENT_TYPE> value_type;
+
+    // CREATORS
+    explicit atomic_shared_ptr(
+                          BloombergLP::bslma::Allocator *basicAllocator = 0);
+        // Create an 'atomic_shared_ptr' holding an empty shared pointer.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
+    explicit atomic_shared_ptr(
+                          const shared_ptr<ELEMENT_TYPE>&  value,
+                          BloombergLP::bslma::Allocator   *basicAllocator = 0);
+        // Create an 'atomic_shared_ptr' holding the specified 'value'.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
+    ~atomic_shared_ptr();
+        // Destroy this object, releasing the reference to the held value.  The
+        // behavior is undefined if any other thread is accessing this object.
+
+    // MANIPULATORS
+    void operator=(const shared_ptr<ELEMENT_TYPE>& value);
+        // Atomically replace the value held by this object with the specified
+        // 'value'.  Note that, as for the C++20 standard
+        // 'std::atomic<std::shared_ptr<T>>', this operator returns 'void'.
+
+    bool compare_exchange_strong(shared_ptr<ELEMENT_TYPE>&       expected,
+                                 const shared_ptr<ELEMENT_TYPE>& desired);
+        // If the value held by this object is equivalent to the specified
+        // 'expected' (i.e., both refer to the same object *and* share
+        // ownership), atomically replace it with the specified 'desired' and
+        // return 'true'.  Otherwise, load the value held by this object into
+        // 'expected' and return 'false'.
+
+    bool compare_exchange_weak(shared_ptr<ELEMENT_TYPE>&       expected,
+                               const shared_ptr<ELEMENT_TYPE>& desired);
+        // If the value held by this object is equivalent to the specified
+        // 'expected' (i.e., both refer to the same object *and* share
+        // ownership), atomically replace it with the specified 'desired' and
+        // return 'true'.  Otherwise, load the value held by this object into
+        // 'expected' and return 'false'.  Note that this implementation never
+        // fails spuriously, and is identical to 'compare_exchange_strong'.
+
+    shared_ptr<ELEMENT_TYPE> exchange(const shared_ptr<ELEMENT_TYPE>& value);
+        // Atomically replace the value held by this object with the specified
+        // 'value', and return the previous value.
+
+    void store(const shared_ptr<ELEMENT_TYPE>& value);
+        // Atomically replace the value held by this object with the specified
+        // 'value'.
+
+    // ACCESSORS
+    operator shared_ptr<ELEMENT_TYPE>() const;
+        // Return (a copy of) the value held by this object.  Note that this
+        // conversion is equivalent to 'load()'.
+
+    BloombergLP::bslma::Allocator *allocator() const;
+        // Return the allocator used by this object to supply memory.
+
+    bool is_lock_free() const;
+        // Return 'true'.  Note that no operation on this object takes a mutex,
+        // although a 'load' may wait for other readers under extreme
+        // contention (see the "Implementation Overview" section in the
+        // component-level documentation).
+
+    shared_ptr<ELEMENT_TYPE> load() const;
+        // Return (a copy of) the value held by this object.
+};
+
+// ============================================================================
+//                           INLINE DEFINITIONS
+// ============================================================================
+
+                          // -----------------------
+                          // class atomic_shared_ptr
+                          // -----------------------
+
+// CREATORS
+template <class ELEMENT_TYPE>
+inline
+atomic_shared_ptr<ELEMENT_TYPE>::atomic_shared_ptr(
+                                 BloombergLP::bslma::Allocator *basicAllocator)
+: d_imp(0, 0, basicAllocator)
+{
+}
+
+template <class ELEMENT_TYPE>
+inline
+atomic_shared_ptr<ELEMENT_TYPE>::atomic_shared_ptr(
+                               const shared_ptr<ELEMENT_TYPE>&  value,
+                               BloombergLP::bslma::Allocator   *basicAllocator)
+: d_imp(const_cast<void *>(static_cast<const volatile void *>(value.get())),
+        value.rep(),
+        basicAllocator)
+{
+}
+
+template <class ELEMENT_TYPE>
+inline
+atomic_shared_ptr<ELEMENT_TYPE>::~atomic_shared_ptr()
+{
+}
+
+// MANIPULATORS
+template <class ELEMENT_TYPE>
+inline
+void atomic_shared_ptr<ELEMENT_TYPE>::operator=(
+                                        const shared_ptr<ELEMENT_TYPE>& value)
+{
+    store(value);
+}
+
+template <class ELEMENT_TYPE>
+bool atomic_shared_ptr<ELEMENT_TYPE>::compare_exchange_strong(
+                                      shared_ptr<ELEMENT_TYPE>&       expected,
+                                      const shared_ptr<ELEMENT_TYPE>& desired)
+{
+    void *ptr = const_cast<void *>(
+                        static_cast<const volatile void *>(expected.get()));
+    BloombergLP::bslma::SharedPtrRep *rep = expected.rep();
+
+    if (d_imp.compareExchange(
+                    &ptr,
+                    &rep,
+                    const_cast<void *>(
+                         static_cast<const volatile void *>(desired.get())),
+                    desired.rep())) {
+        return true;                                                  // RETURN
+    }
+
+    shared_ptr<ELEMENT_TYPE>(static_cast<ELEMENT_TYPE *>(ptr),
+                             rep).swap(expected);
+    return false;
+}
+
+template <class ELEMENT_TYPE>
+inline
+bool atomic_shared_ptr<ELEMENT_TYPE>::compare_exchange_weak(
+                                      shared_ptr<ELEMENT_TYPE>&       expected,
+                                      const shared_ptr<ELEMENT_TYPE>& desired)
+{
+    return compare_exchange_strong(expected, desired);
+}
+
+template <class ELEMENT_TYPE>
+inline
+shared_ptr<ELEMENT_TYPE> atomic_shared_ptr<ELEMENT_TYPE>::exchange(
+                                         const shared_ptr<ELEMENT_TYPE>& value)
+{
+    void                             *ptr;
+    BloombergLP::bslma::SharedPtrRep *rep;
+
+    d_imp.exchange(&ptr,
+                   &rep,
+                   const_cast<void *>(
+                           static_cast<const volatile void *>(value.get())),
+                   value.rep());
+    return shared_ptr<ELEMENT_TYPE>(static_cast<ELEMENT_TYPE *>(ptr), rep);
+}
+
+template <class ELEMENT_TYPE>
+inline
+void atomic_shared_ptr<ELEMENT_TYPE>::store(
+                                         const shared_ptr<ELEMENT_TYPE>& value)
+{
+    d_imp.store(const_cast<void *>(
+                           static_cast<const volatile void *>(value.get())),
+                value.rep());
+}
+
+// ACCESSORS
+template <class ELEMENT_TYPE>
+inline
+atomic_shared_ptr<ELEMENT_TYPE>::operator shared_ptr<ELEMENT_TYPE>() const
+{
+    return load();
+}
+
+template <class ELEMENT_TYPE>
+inline
+BloombergLP::bslma::Allocator *
+atomic_shared_ptr<ELEMENT_TYPE>::allocator() const
+{
+    return d_imp.allocator();
+}
+
+template <class ELEMENT_TYPE>
+inline
+bool atomic_shared_ptr<ELEMENT_TYPE>::is_lock_free() const
+{
+    return true;
+}
+
+template <class ELEMENT_TYPE>
+inline
+shared_ptr<ELEMENT_TYPE> atomic_shared_ptr<ELEMENT_TYPE>::load() const
+{
+    void                             *ptr;
+    BloombergLP::bslma::SharedPtrRep *rep;
+
+    d_imp.load(&ptr, &rep);
+    return shared_ptr<ELEMENT_TYPE>(static_cast<ELEMENT_TYPE *>(ptr), rep);
+}
+
+}  // close namespace bsl
+
+namespace BloombergLP {
+namespace bslstl {
+
+                         // -------------------------
+                         // class AtomicSharedPtr_Imp
+                         // -------------------------
+
+// ACCESSORS
+inline
+bslma::Allocator *AtomicSharedPtr_Imp::allocator() const
+{
+    return d_allocator_p;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,878 @@
+// bslstl_atomicsharedptr.t.cpp                                       -*-C++-*-
+#include <bslstl_atomicsharedptr.h>
+
+#include <bslstl_sharedptr.h>
+
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bsls_atomic.h>
+#include <bsls_bsltestutil.h>
+#include <bsls_platform.h>
+
+#include <stdio.h>
+#include <stdlib.h>             // 'atoi'
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// 'bsl::atomic_shared_ptr' holds a 'bsl::shared_ptr' value that may be read
+// and written concurrently.  Its value is kept in nodes allocated from the
+// allocator supplied at construction, and reclaimed using a split reference
+// count.  We first verify, in a single thread, that each operation yields the
+// correct value, that shared objects and nodes are released exactly when they
+// are no longer referenced, and that a failed allocation leaves the object
+// unchanged.  We then verify, using several concurrent threads, that readers
+// always observe a published value that is still alive, that concurrent
+// 'compare_exchange_strong' operations are linearizable, and that no memory
+// is leaked.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] explicit atomic_shared_ptr(bslma::Allocator *basicAllocator = 0);
+// [ 2] explicit atomic_shared_ptr(const shared_ptr& value, Allocator *ba = 0);
+// [ 2] ~atomic_shared_ptr();
+//
+// MANIPULATORS
+// [ 3] void operator=(const shared_ptr<ELEMENT_TYPE>& value);
+// [ 5] bool compare_exchange_strong(shared_ptr& expected, const shared_ptr&);
+// [ 5] bool compare_exchange_weak(shared_ptr& expected, const shared_ptr&);
+// [ 4] shared_ptr<ELEMENT_TYPE> exchange(const shared_ptr& value);
+// [ 3] void store(const shared_ptr<ELEMENT_TYPE>& value);
+//
+// ACCESSORS
+// [ 2] operator shared_ptr<ELEMENT_TYPE>() const;
+// [ 2] bslma::Allocator *allocator() const;
+// [ 2] bool is_lock_free() const;
+// [ 2] shared_ptr<ELEMENT_TYPE> load() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] CONCURRENCY TEST
+// [ 7] USAGE EXAMPLE
+
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACROS
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                     STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+#define ASSERT_SAFE_PASS_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS_RAW(EXPR)
+#define ASSERT_SAFE_FAIL_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL_RAW(EXPR)
+#define ASSERT_PASS_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS_RAW(EXPR)
+#define ASSERT_FAIL_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL_RAW(EXPR)
+#define ASSERT_OPT_PASS_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS_RAW(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bsl::atomic_shared_ptr<int> Obj;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+//=============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+                            // ===============
+                            // struct Snapshot
+                            // ===============
+
+struct Snapshot {
+    // This 'struct' provides a value whose two members are always equal while
+    // the object is alive, and that counts the number of live objects.
+
+    // CLASS DATA
+    static bsls::AtomicInt s_numLive;  // number of live 'Snapshot' objects
+
+    // DATA
+    int d_first;   // generation number
+    int d_second;  // copy of 'd_first'; overwritten by the destructor
+
+    // CREATORS
+    explicit Snapshot(int generation)
+    : d_first(generation)
+    , d_second(generation)
+    {
+        ++s_numLive;
+    }
+
+    ~Snapshot()
+    {
+        d_second = -1;
+        --s_numLive;
+    }
+};
+
+bsls::AtomicInt Snapshot::s_numLive(0);
+
+                          // ======================
+                          // struct ConcurrencyData
+                          // ======================
+
+struct ConcurrencyData {
+    // This 'struct' holds the state shared by the threads of the concurrency
+    // test.
+
+    // DATA
+    bsl::atomic_shared_ptr<Snapshot> *d_object_p;      // object under test
+    bslma::Allocator                 *d_allocator_p;   // for new snapshots
+    bsls::AtomicInt                   d_numWriters;    // writers not done
+    bsls::AtomicInt                   d_numIncrements; // successful CASes
+    bsls::AtomicInt                   d_numErrors;     // observed errors
+    int                               d_numIterations; // per writer
+};
+
+extern "C" void *readerThread(void *arg)
+    // Repeatedly load the value of the object in the 'ConcurrencyData'
+    // addressed by the specified 'arg' until all writers are done, verifying
+    // that the loaded snapshot is alive and that the generations observed
+    // never decrease.
+{
+    ConcurrencyData *data = static_cast<ConcurrencyData *>(arg);
+
+    int last = 0;
+    while (0 != data->d_numWriters.loadAcquire()) {
+        bsl::shared_ptr<Snapshot> current = data->d_object_p->load();
+        if (!current
+         || current->d_first != current->d_second
+         || current->d_first < last) {
+            ++data->d_numErrors;
+            break;
+        }
+        last = current->d_first;
+    }
+    return 0;
+}
+
+extern "C" void *writerThread(void *arg)
+    // Increment the generation of the object in the 'ConcurrencyData'
+    // addressed by the specified 'arg' the configured number of times, using
+    // 'compare_exchange_strong'.
+{
+    ConcurrencyData *data = static_cast<ConcurrencyData *>(arg);
+
+    bsl::shared_ptr<Snapshot> expected = data->d_object_p->load();
+    for (int i = 0; i < data->d_numIterations; ++i) {
+        bsl::shared_ptr<Snapshot> desired;
+        do {
+            bslma::Allocator *allocator = data->d_allocator_p;
+            desired.reset(new (*allocator) Snapshot(expected->d_first + 1),
+                          allocator);
+        } while (!data->d_object_p->compare_exchange_strong(expected,
+                                                            desired));
+        ++data->d_numIncrements;
+        expected = desired;
+    }
+    --data->d_numWriters;
+    return 0;
+}
+
+
+//=============================================================================
+//                              USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+struct MyConfig {
+    // This 'struct' provides an immutable configuration snapshot.
+
+    int d_timeoutMs;
+    int d_maxRetries;
+};
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+    bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVerbose;
+    (void)veryVeryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    // Confirm no static intialization locked the global allocator
+    ASSERT(&globalAllocator == bslma::Default::globalAllocator());
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    // Confirm no static intialization locked the default allocator
+    ASSERT(&defaultAllocator == bslma::Default::defaultAllocator());
+
+    bslma::TestAllocator ta;
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+///Example 1: Publishing Configuration Snapshots
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a service reads its configuration on every incoming message,
+// while an administrative thread occasionally publishes a new configuration.
+// First, we define the (immutable) configuration type:
+//..
+//  struct MyConfig {
+//      // This 'struct' provides an immutable configuration snapshot.
+//
+//      int d_timeoutMs;
+//      int d_maxRetries;
+//  };
+//..
+// Then, we create an 'atomic_shared_ptr' holding the initial configuration,
+// supplying an allocator for the nodes it uses internally:
+//..
+    bslma::TestAllocator ta;
+
+    MyConfig initial = { 100, 3 };
+    bsl::atomic_shared_ptr<const MyConfig> config(
+                                bsl::allocate_shared<MyConfig>(&ta, initial),
+                                &ta);
+//..
+// Next, each message-processing thread loads the current snapshot, without
+// taking a lock.  The loaded 'shared_ptr' remains valid while it is used,
+// even if a new configuration is published concurrently:
+//..
+    bsl::shared_ptr<const MyConfig> current = config.load();
+    ASSERT(100 == current->d_timeoutMs);
+//..
+// Now, the administrative thread publishes a new configuration:
+//..
+    MyConfig updated = { 250, 5 };
+    config.store(bsl::allocate_shared<MyConfig>(&ta, updated));
+
+    ASSERT(250 == config.load()->d_timeoutMs);
+    ASSERT(100 == current->d_timeoutMs);
+//..
+// Finally, when the last reader releases the old snapshot, it is destroyed:
+//..
+    current.reset();
+    ASSERT(2 == ta.numBlocksInUse());    // current snapshot and its node
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY TEST
+        //
+        // Concerns:
+        //: 1 A value loaded concurrently with writes is always one that was
+        //:   published, and remains alive while the loaded 'shared_ptr'
+        //:   refers to it.
+        //:
+        //: 2 A reader never observes a value older than one it observed
+        //:   before.
+        //:
+        //: 3 Concurrent 'compare_exchange_strong' operations are
+        //:   linearizable: every successful exchange is reflected in the
+        //:   final value.
+        //:
+        //: 4 All snapshots and nodes are released once the object and all
+        //:   loaded values are destroyed.
+        //
+        // Plan:
+        //: 1 Create an object holding a snapshot with generation 0, and start
+        //:   several reader threads that repeatedly load the value, checking
+        //:   that it is alive and that generations are non-decreasing.
+        //:   (C-1..2)
+        //:
+        //: 2 Concurrently, start several writer threads that each increment
+        //:   the generation a fixed number of times using
+        //:   'compare_exchange_strong', retrying on failure.  Verify that the
+        //:   final generation equals the total number of increments.  (C-3)
+        //:
+        //: 3 Verify, using a test allocator, that no memory remains in use
+        //:   after the object is destroyed, and that no 'Snapshot' remains
+        //:   alive.  (C-4)
+        //
+        // Testing:
+        //   CONCURRENCY TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCONCURRENCY TEST"
+                            "\n================\n");
+
+        enum { k_NUM_READERS = 8, k_NUM_WRITERS = 4 };
+
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+        {
+            bsl::shared_ptr<Snapshot>        initial(new (oa) Snapshot(0),
+                                                     &oa);
+            bsl::atomic_shared_ptr<Snapshot> mX(initial, &oa);
+            initial.reset();
+
+            ConcurrencyData data;
+            data.d_object_p      = &mX;
+            data.d_allocator_p   = &oa;
+            data.d_numWriters    = k_NUM_WRITERS;
+            data.d_numIncrements = 0;
+            data.d_numErrors     = 0;
+            data.d_numIterations = veryVerbose ? 100000 : 10000;
+
+            ThreadId readers[k_NUM_READERS];
+            ThreadId writers[k_NUM_WRITERS];
+
+            for (int i = 0; i < k_NUM_READERS; ++i) {
+                readers[i] = createThread(&readerThread, &data);
+            }
+            for (int i = 0; i < k_NUM_WRITERS; ++i) {
+                writers[i] = createThread(&writerThread, &data);
+            }
+            for (int i = 0; i < k_NUM_WRITERS; ++i) {
+                joinThread(writers[i]);
+            }
+            for (int i = 0; i < k_NUM_READERS; ++i) {
+                joinThread(readers[i]);
+            }
+
+            const int EXPECTED = k_NUM_WRITERS * data.d_numIterations;
+
+            if (veryVerbose) {
+                P_(data.d_numIncrements) P(data.d_numErrors)
+            }
+
+            ASSERTV(data.d_numErrors, 0 == data.d_numErrors);
+            ASSERTV(data.d_numIncrements, EXPECTED == data.d_numIncrements);
+            ASSERTV(mX.load()->d_first, EXPECTED == mX.load()->d_first);
+            ASSERTV(Snapshot::s_numLive, 1 == Snapshot::s_numLive);
+        }
+        ASSERTV(Snapshot::s_numLive, 0 == Snapshot::s_numLive);
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // 'compare_exchange_strong' AND 'compare_exchange_weak'
+        //
+        // Concerns:
+        //: 1 If the value held is equivalent to 'expected' (refers to the same
+        //:   object, sharing ownership), 'desired' is stored and 'true' is
+        //:   returned.
+        //:
+        //: 2 Otherwise the value held is unchanged, 'expected' is assigned
+        //:   the value held, and 'false' is returned.
+        //:
+        //: 3 Two 'shared_ptr' objects pointing to the same object but owned
+        //:   by different representations are not equivalent.
+        //:
+        //: 4 An empty value is equivalent only to an empty 'expected'.
+        //:
+        //: 5 No memory is leaked on either path, and a failed exchange
+        //:   allocates no memory once it has returned.
+        //
+        // Plan:
+        //: 1 Perform successful and failed exchanges, including with empty
+        //:   values and with an aliasing 'shared_ptr', and verify the
+        //:   results, the value held, and the values of 'expected'.
+        //:   (C-1..4)
+        //:
+        //: 2 Use test allocators to verify memory usage.  (C-5)
+        //
+        // Testing:
+        //   bool compare_exchange_strong(shared_ptr& exp, const shared_ptr&);
+        //   bool compare_exchange_weak(shared_ptr& exp, const shared_ptr&);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'compare_exchange_strong' AND "
+                            "'compare_exchange_weak'"
+                            "\n============================="
+                            "=======================\n");
+
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+        {
+            bsl::shared_ptr<int> A = bsl::allocate_shared<int>(&ta, 1);
+            bsl::shared_ptr<int> B = bsl::allocate_shared<int>(&ta, 2);
+            bsl::shared_ptr<int> C(A, A.get());    // same rep as 'A'
+
+            Obj mX(A, &oa);  const Obj& X = mX;
+
+            if (veryVerbose) printf("\tFailure.\n");
+
+            bsl::shared_ptr<int> expected = B;
+            ASSERT(false == mX.compare_exchange_strong(expected, B));
+            ASSERT(A == expected);
+            ASSERT(A == X.load());
+            ASSERT(4 == A.use_count());     // 'A', 'C', 'expected', and 'mX'
+            ASSERT(1 == oa.numBlocksInUse());
+
+            expected.reset();
+            ASSERT(false == mX.compare_exchange_weak(expected, B));
+            ASSERT(A == expected);
+            ASSERT(A == X.load());
+            ASSERT(1 == oa.numBlocksInUse());
+
+            if (veryVerbose) printf("\tSuccess.\n");
+
+            ASSERT(true == mX.compare_exchange_strong(C, B));
+            ASSERT(B == X.load());
+            ASSERT(3 == A.use_count());     // 'A', 'C', and 'expected'
+            ASSERT(2 == B.use_count());
+            ASSERT(1 == oa.numBlocksInUse());
+
+            if (veryVerbose) printf("\tSame pointer, different owner.\n");
+
+            bsl::shared_ptr<int> D(A, B.get());    // 'B' owned by 'A'
+
+            expected = D;
+            ASSERT(false == mX.compare_exchange_strong(expected, A));
+            ASSERT(B == expected);
+            ASSERT(B.rep() == expected.rep());
+            ASSERT(B == X.load());
+
+            if (veryVerbose) printf("\tEmpty values.\n");
+
+            expected = B;
+            ASSERT(true == mX.compare_exchange_weak(expected,
+                                                    bsl::shared_ptr<int>()));
+            ASSERT(!X.load());
+            ASSERT(0 == oa.numBlocksInUse());
+
+            expected = A;
+            ASSERT(false == mX.compare_exchange_strong(expected, B));
+            ASSERT(!expected);
+            ASSERT(0 == expected.rep());
+
+            ASSERT(true == mX.compare_exchange_strong(expected, A));
+            ASSERT(A == X.load());
+            ASSERT(1 == oa.numBlocksInUse());
+
+            if (veryVerbose) printf("\tAllocation failure.\n");
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(oa) {
+                bsl::shared_ptr<int> expected = A;
+                ASSERT(A == X.load());
+                ASSERT(true == mX.compare_exchange_strong(expected, B));
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERT(B == X.load());
+            ASSERT(1 == oa.numBlocksInUse());
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // 'exchange'
+        //
+        // Concerns:
+        //: 1 'exchange' stores the specified value and returns the value held
+        //:   immediately before the call, sharing ownership of it.
+        //:
+        //: 2 'exchange' works with empty values.
+        //:
+        //: 3 No memory is leaked.
+        //
+        // Plan:
+        //: 1 Exchange a series of values, including empty ones, and verify
+        //:   the returned values, the value held, and the use counts.
+        //:   (C-1..2)
+        //:
+        //: 2 Use test allocators to verify memory usage.  (C-3)
+        //
+        // Testing:
+        //   shared_ptr<ELEMENT_TYPE> exchange(const shared_ptr& value);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'exchange'"
+                            "\n==========\n");
+
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+        {
+            bsl::shared_ptr<int> A = bsl::allocate_shared<int>(&ta, 1);
+            bsl::shared_ptr<int> B = bsl::allocate_shared<int>(&ta, 2);
+
+            Obj mX(&oa);  const Obj& X = mX;
+
+            bsl::shared_ptr<int> old = mX.exchange(A);
+            ASSERT(!old);
+            ASSERT(A == X.load());
+            ASSERT(2 == A.use_count());
+            ASSERT(1 == oa.numBlocksInUse());
+
+            old = mX.exchange(B);
+            ASSERT(A == old);
+            ASSERT(B == X.load());
+            ASSERT(2 == A.use_count());     // 'A' and 'old'
+            ASSERT(2 == B.use_count());
+            ASSERT(1 == oa.numBlocksInUse());
+
+            old = mX.exchange(bsl::shared_ptr<int>());
+            ASSERT(B == old);
+            ASSERT(!X.load());
+            ASSERT(1 == A.use_count());
+            ASSERT(2 == B.use_count());     // 'B' and 'old'
+            ASSERT(0 == oa.numBlocksInUse());
+
+            mX.store(A);
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'store' AND 'operator='
+        //
+        // Concerns:
+        //: 1 'store' and 'operator=' replace the value held, releasing the
+        //:   reference held to the previous value.
+        //:
+        //: 2 A value loaded before a 'store' remains valid after it.
+        //:
+        //: 3 Storing an empty value releases the node; storing a non-empty
+        //:   value allocates exactly one node from the object allocator.
+        //:
+        //: 4 If allocating a node fails, the value held is unchanged and no
+        //:   memory is leaked.
+        //
+        // Plan:
+        //: 1 Store a series of values, and verify the value held, the use
+        //:   counts, and the blocks in use by the object allocator.  (C-1..3)
+        //:
+        //: 2 Store values within the exception-test macros, and verify that
+        //:   the value held is unchanged when an exception is thrown.  (C-4)
+        //
+        // Testing:
+        //   void operator=(const shared_ptr<ELEMENT_TYPE>& value);
+        //   void store(const shared_ptr<ELEMENT_TYPE>& value);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'store' AND 'operator='"
+                            "\n=======================\n");
+
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+        {
+            bsl::shared_ptr<int> A = bsl::allocate_shared<int>(&ta, 1);
+            bsl::shared_ptr<int> B = bsl::allocate_shared<int>(&ta, 2);
+
+            Obj mX(A, &oa);  const Obj& X = mX;
+
+            bsl::shared_ptr<int> loaded = X.load();
+
+            mX.store(B);
+            ASSERT(B == X.load());
+            ASSERT(1 == *loaded);
+            ASSERT(2 == A.use_count());     // 'A' and 'loaded'
+            ASSERT(2 == B.use_count());
+            ASSERT(1 == oa.numBlocksInUse());
+            ASSERT(2 == oa.numBlocksTotal());
+
+            mX = A;
+            ASSERT(A == X.load());
+            ASSERT(3 == A.use_count());
+            ASSERT(1 == B.use_count());
+            ASSERT(1 == oa.numBlocksInUse());
+
+            mX.store(bsl::shared_ptr<int>());
+            ASSERT(!X.load());
+            ASSERT(2 == A.use_count());
+            ASSERT(0 == oa.numBlocksInUse());
+
+            mX = B;
+            ASSERT(B == X.load());
+            ASSERT(1 == oa.numBlocksInUse());
+
+            if (veryVerbose) printf("\tAllocation failure.\n");
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(oa) {
+                ASSERT(B == X.load());
+                mX.store(A);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERT(A == X.load());
+            ASSERT(3 == A.use_count());
+            ASSERT(1 == B.use_count());
+            ASSERT(1 == oa.numBlocksInUse());
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 A default-constructed object holds an empty value and allocates
+        //:   no memory.
+        //:
+        //: 2 An object constructed from a 'shared_ptr' holds that value and
+        //:   shares its ownership; constructing from an empty value allocates
+        //:   no memory.
+        //:
+        //: 3 'load' and the conversion operator return the value held,
+        //:   sharing its ownership, without allocating memory.
+        //:
+        //: 4 The object allocator is the one supplied at construction, or the
+        //:   default allocator if none is supplied.
+        //:
+        //: 5 'is_lock_free' returns 'true'.
+        //:
+        //: 6 The destructor releases the reference held and the node.
+        //
+        // Plan:
+        //: 1 Construct objects with and without values and allocators, and
+        //:   verify the value held, the use counts, and the memory usage of
+        //:   the object and default allocators.  (C-1..6)
+        //
+        // Testing:
+        //   explicit atomic_shared_ptr(bslma::Allocator *basicAllocator = 0);
+        //   explicit atomic_shared_ptr(const shared_ptr& v, Allocator *ba = 0);
+        //   ~atomic_shared_ptr();
+        //   operator shared_ptr<ELEMENT_TYPE>() const;
+        //   bslma::Allocator *allocator() const;
+        //   bool is_lock_free() const;
+        //   shared_ptr<ELEMENT_TYPE> load() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCREATORS AND ACCESSORS"
+                            "\n======================\n");
+
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+        if (veryVerbose) printf("\tDefault construction.\n");
+        {
+            Obj mX;  const Obj& X = mX;
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(true == X.is_lock_free());
+            ASSERT(!X.load());
+            ASSERT(0 == defaultAllocator.numBlocksTotal());
+
+            Obj mY(&oa);  const Obj& Y = mY;
+            ASSERT(&oa == Y.allocator());
+            ASSERT(!Y.load());
+
+            Obj mZ(bsl::shared_ptr<int>(), &oa);  const Obj& Z = mZ;
+            ASSERT(!Z.load());
+            ASSERT(0 == oa.numBlocksTotal());
+        }
+
+        if (veryVerbose) printf("\tValue construction.\n");
+        {
+            bsl::shared_ptr<int> A = bsl::allocate_shared<int>(&ta, 7);
+            {
+                Obj mX(A, &oa);  const Obj& X = mX;
+                ASSERT(&oa == X.allocator());
+                ASSERT(2 == A.use_count());
+                ASSERT(1 == oa.numBlocksInUse());
+
+                bsls::Types::Int64 numTotal = oa.numBlocksTotal();
+
+                bsl::shared_ptr<int> loaded = X.load();
+                ASSERT(A == loaded);
+                ASSERT(A.rep() == loaded.rep());
+                ASSERT(3 == A.use_count());
+
+                bsl::shared_ptr<int> converted = X;
+                ASSERT(A == converted);
+                ASSERT(4 == A.use_count());
+
+                ASSERT(numTotal == oa.numBlocksTotal());
+            }
+            ASSERT(1 == A.use_count());
+            ASSERT(0 == oa.numBlocksInUse());
+
+            {
+                Obj mX(A);  const Obj& X = mX;
+                ASSERT(&defaultAllocator == X.allocator());
+                ASSERT(1 == defaultAllocator.numBlocksInUse());
+                ASSERT(7 == *X.load());
+            }
+            ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+            if (veryVerbose) printf("\tAliasing value.\n");
+
+            bsl::shared_ptr<int> B(A, A.get());
+            {
+                bsl::atomic_shared_ptr<const int> mX(B, &oa);
+                bsl::shared_ptr<const int> loaded = mX.load();
+                ASSERT(B.get() == loaded.get());
+                ASSERT(B.rep() == loaded.rep());
+                ASSERT(4 == A.use_count());
+            }
+            ASSERT(2 == A.use_count());
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an object, and store, load, exchange, and
+        //:   compare-exchange values.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        bsl::shared_ptr<int> A = bsl::allocate_shared<int>(&ta, 1);
+        bsl::shared_ptr<int> B = bsl::allocate_shared<int>(&ta, 2);
+        {
+            Obj mX(A, &ta);  const Obj& X = mX;
+            ASSERT(1 == *X.load());
+
+            mX.store(B);
+            ASSERT(2 == *X.load());
+
+            bsl::shared_ptr<int> old = mX.exchange(A);
+            ASSERT(B == old);
+            ASSERT(1 == *X.load());
+
+            bsl::shared_ptr<int> expected = B;
+            ASSERT(!mX.compare_exchange_strong(expected, B));
+            ASSERT(A == expected);
+            ASSERT( mX.compare_exchange_strong(expected, B));
+            ASSERT(2 == *X.load());
+        }
+        ASSERT(1 == A.use_count());
+        ASSERT(1 == B.use_count());
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1664 @@
+// bslstl_localsharedptr.h                                            -*-C++-*-
+#ifndef INCLUDED_BSLSTL_LOCALSHAREDPTR
+#define INCLUDED_BSLSTL_LOCALSHAREDPTR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id$ $CSID$")
+
+//@PURPOSE: Provide a single-threaded reference-counted shared pointer.
+//
+//@CLASSES:
+//  bsl::local_shared_ptr: shared pointer with non-atomic reference counting
+//
+//@SEE_ALSO: bslstl_sharedptr, bslma_localsharedptrrep
+//
+//@DESCRIPTION: This component provides a class template,
+// 'bsl::local_shared_ptr', implementing a reference-counted "smart pointer"
+// supporting "shared ownership" of objects of (template parameter)
+// 'ELEMENT_TYPE' by multiple pointers that are all owned by a *single*
+// thread.  'bsl::local_shared_ptr' has the interface of 'bsl::shared_ptr' (of
+// which it is a subset), but maintains its reference count using plain,
+// non-atomic, integer arithmetic: copying, assigning, and destroying a
+// 'local_shared_ptr' never performs a locked read-modify-write operation.
+//
+// This component also provides the factory functions
+// 'bsl::allocate_local_shared' and 'bsl::make_local_shared', which create the
+// shared object and its representation in a single allocation obtained from a
+// supplied (or the default) allocator.
+//
+///Converting to 'bsl::shared_ptr'
+///-------------------------------
+// The representation of a 'local_shared_ptr' ('bslma::LocalSharedPtrRep')
+// derives from the representation of a 'bsl::shared_ptr'
+// ('bslma::SharedPtrRep'): all local references to a shared object,
+// collectively, hold a single thread-safe shared reference.  A
+// 'local_shared_ptr' is therefore implicitly convertible to a
+// 'bsl::shared_ptr' referring to the same object; the conversion acquires one
+// additional (atomic) shared reference, and the resulting 'bsl::shared_ptr'
+// (and any 'bsl::weak_ptr' created from it) may be freely passed to, copied
+// by, and destroyed by, other threads.  The shared object is destroyed when
+// both the last local reference and the last shared reference are released,
+// from whichever thread releases last.  Note that conversion in the opposite
+// direction is not supported.
+//
+///Thread-Safety
+///-------------
+// A 'local_shared_ptr' object, and all 'local_shared_ptr' objects sharing
+// ownership with it, must be accessed, copied, assigned, and destroyed by a
+// single thread at a time; in practice, they are confined to the thread that
+// created the shared object.  To share ownership with another thread, convert
+// to 'bsl::shared_ptr' (on the owning thread) and pass the 'bsl::shared_ptr'
+// to the other thread.  As with 'bsl::shared_ptr', there is no guarantee
+// regarding the safety of accessing or modifying the object referred to by a
+// 'local_shared_ptr'.
+//
+///Performance
+///-----------
+// Each copy of a 'bsl::shared_ptr' performs an atomic increment of the shared
+// reference count, and each destruction an atomic decrement; even when
+// uncontended these locked instructions are significantly more expensive than
+// ordinary arithmetic.  A 'local_shared_ptr' performs the single atomic
+// decrement of its underlying shared reference only when its *last* local
+// reference is released.  'local_shared_ptr' is therefore appropriate for
+// objects that are heavily shared within one thread, such as the state
+// managed by a single-threaded event loop.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Sharing an Object Within a Single Thread
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we have an event loop, confined to a single thread, that shares
+// request objects among a number of handlers.  First, we create a request
+// using 'allocate_local_shared', supplying an allocator that provides memory
+// for both the request and its representation:
+//..
+//  bslma::TestAllocator ta;
+//
+//  bsl::local_shared_ptr<int> request = bsl::allocate_local_shared<int>(&ta,
+//                                                                       17);
+//  assert(17 == *request);
+//  assert( 1 == request.use_count());
+//  assert( 1 == ta.numBlocksInUse());
+//..
+// Then, we make a number of copies, for example by storing the request into
+// the handlers.  Note that no atomic operation is performed:
+//..
+//  {
+//      bsl::local_shared_ptr<int> handler1(request);
+//      bsl::local_shared_ptr<int> handler2(request);
+//      assert(3 == request.use_count());
+//  }
+//  assert(1 == request.use_count());
+//..
+// Next, one of the handlers needs to hand the request to a worker thread.  It
+// converts the 'local_shared_ptr' to a (thread-safe) 'bsl::shared_ptr':
+//..
+//  bsl::shared_ptr<int> forWorker = request;
+//  assert(2  == request.use_count());
+//  assert(17 == *forWorker);
+//..
+// Finally, we release the local reference.  The request stays alive until the
+// worker thread releases its 'bsl::shared_ptr':
+//..
+//  request.reset();
+//  assert(1 == forWorker.use_count());
+//  assert(1 == ta.numBlocksInUse());
+//
+//  forWorker.reset();
+//  assert(0 == ta.numBlocksInUse());
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_ALLOCATOR
+#include <bslstl_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_ALLOCATORTRAITS
+#include <bslstl_allocatortraits.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_LOCALSHAREDPTRALLOCATEINPLACEREP
+#include <bslstl_localsharedptrallocateinplacerep.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_SHAREDPTR
+#include <bslstl_sharedptr.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_LOCALSHAREDPTROUTOFPLACEREP
+#include <bslma_localsharedptroutofplacerep.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_LOCALSHAREDPTRREP
+#include <bslma_localsharedptrrep.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ADDLVALUEREFERENCE
+#include <bslmf_addlvaluereference.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ENABLEIF
+#include <bslmf_enableif.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_HASPOINTERSEMANTICS
+#include <bslmf_haspointersemantics.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
+#include <bslmf_isbitwisemoveable.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISCONVERTIBLE
+#include <bslmf_isconvertible.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISPOINTER
+#include <bslmf_ispointer.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_METAINT
+#include <bslmf_metaint.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_COMPILERFEATURES
+#include <bsls_compilerfeatures.h>
+#endif
+
+#ifndef INCLUDED_BSLS_NATIVESTD
+#include <bsls_nativestd.h>
+#endif
+
+#ifndef INCLUDED_BSLS_NULLPTR
+#include <bsls_nullptr.h>
+#endif
+
+#ifndef INCLUDED_BSLS_UNSPECIFIEDBOOL
+#include <bsls_unspecifiedbool.h>
+#endif
+
+#ifndef INCLUDED_BSLS_UTIL
+#include <bsls_util.h>
+#endif
+
+#ifndef INCLUDED_FUNCTIONAL
+#include <functional>            // 'std::less'
+#define INCLUDED_FUNCTIONAL
+#endif
+
+namespace BloombergLP {
+namespace bslstl {
+
+                       // ====================================
+                       // struct LocalSharedPtr_DefaultDeleter
+                       // ====================================
+
+struct LocalSharedPtr_DefaultDeleter {
+    // This 'struct' provides a function-like shared pointer deleter that
+    // invokes 'delete' with the passed pointer.
+
+    // ACCESSORS
+    template <class ANY_TYPE>
+    void operator()(ANY_TYPE *ptr) const;
+        // Call 'delete' with the specified 'ptr'.
+};
+
+                        // ===============================
+                        // class LocalSharedPtr_RepProctor
+                        // ===============================
+
+class LocalSharedPtr_RepProctor {
+    // This 'class' implements a proctor that, unless its 'release' method has
+    // previously been invoked, automatically disposes of the (not yet
+    // initialized) 'bslma::SharedPtrRep' object that is supplied at
+    // construction *without* disposing of its shared object.
+
+    // DATA
+    bslma::SharedPtrRep *d_rep_p;  // address of representation being managed
+
+  private:
+    // NOT IMPLEMENTED
+    LocalSharedPtr_RepProctor(const LocalSharedPtr_RepProctor&);
+    LocalSharedPtr_RepProctor& operator=(const LocalSharedPtr_RepProctor&);
+
+  public:
+    // CREATORS
+    explicit LocalSharedPtr_RepProctor(bslma::SharedPtrRep *rep);
+        // Create a 'LocalSharedPtr_RepProctor' that conditionally manages the
+        // specified 'rep' (if non-zero).
+
+    ~LocalSharedPtr_RepProctor();
+        // Destroy this proctor and call 'disposeRep' on the representation it
+        // manages (if any).
+
+    // MANIPULATORS
+    void release();
+        // Release from management the object currently managed by this
+        // proctor.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+namespace bsl {
+
+                          // ======================
+                          // class local_shared_ptr
+                          // ======================
+
+template <class ELEMENT_TYPE>
+class local_shared_ptr {
+    // This class provides a single-threaded reference-counted "smart pointer"
+    // to support "shared ownership" of objects: a local shared pointer ensures
+    // that the shared object is destroyed, using the appropriate deletion
+    // method, only when there are no (local or thread-safe) shared references
+    // to it.  All 'local_shared_ptr' objects sharing ownership of an object
+    // must be used by only one thread at a time (see the "Thread-Safety"
+    // section in the component-level documentation).
+
+    // DATA
+    ELEMENT_TYPE                          *d_ptr_p; // shared object
+
+    BloombergLP::bslma::LocalSharedPtrRep *d_rep_p; // representation object
+                                                    // that manages the shared
+                                                    // object
+
+    // PRIVATE TYPES
+    typedef local_shared_ptr<ELEMENT_TYPE> SelfType;
+        // 'SelfType' is an alias to this 'class'.
+
+    typedef typename BloombergLP::bsls::UnspecifiedBool<local_shared_ptr>::
+                                                           BoolType BoolType;
+
+    // FRIENDS
+    template <class COMPATIBLE_TYPE>
+    friend class local_shared_ptr;
+
+  private:
+    // PRIVATE CLASS METHODS
+    template <class COMPATIBLE_TYPE, class DELETER>
+    static BloombergLP::bslma::LocalSharedPtrRep *makeInternalRep(
+                                             COMPATIBLE_TYPE *,
+                                             const DELETER&   rep,
+                                             BloombergLP::bslmf::MetaInt<2>);
+        // Return the specified 'rep', which is a pointer to a (class derived
+        // from) 'bslma::LocalSharedPtrRep'.
+
+    template <class COMPATIBLE_TYPE, class DELETER>
+    static BloombergLP::bslma::LocalSharedPtrRep *makeInternalRep(
+                                             COMPATIBLE_TYPE *ptr,
+                                             const DELETER&   deleter,
+                                             BloombergLP::bslmf::MetaInt<1>);
+        // Return the address of a new out-of-place representation that
+        // manages the specified 'ptr' and uses the specified 'deleter', which
+        // is a pointer to a 'bslma::Allocator', both to destroy 'ptr' and to
+        // supply memory for the representation.
+
+    template <class COMPATIBLE_TYPE, class DELETER>
+    static BloombergLP::bslma::LocalSharedPtrRep *makeInternalRep(
+                                             COMPATIBLE_TYPE *ptr,
+                                             const DELETER&   deleter,
+                                             BloombergLP::bslmf::MetaInt<0>);
+        // Return the address of a new out-of-place representation that
+        // manages the specified 'ptr' and uses the specified 'deleter' to
+        // destroy 'ptr'.  Use the currently installed default allocator to
+        // supply memory.
+
+  public:
+    // TYPES
+    typedef ELEMENT_TYPE element_type;
+        // 'element_type' is an alias to the 'ELEMENT_TYPE' template parameter.
+
+    // CREATORS
+    local_shared_ptr();
+        // Create an empty local shared pointer, i.e., a local shared pointer
+        // with no representation that does not refer to any object.
+
+    local_shared_ptr(bsl::nullptr_t);                               // IMPLICIT
+        // Create an empty local shared pointer.
+
+    template <class COMPATIBLE_TYPE>
+    explicit local_shared_ptr(COMPATIBLE_TYPE *ptr);
+        // Create a local shared pointer that manages the modifiable object of
+        // (template parameter) type 'COMPATIBLE_TYPE' at the specified 'ptr'
+        // address, and refers to '(ELEMENT_TYPE *)ptr'.  When the last
+        // reference is released, the object is destroyed by calling
+        // 'delete ptr'.  Use the currently installed default allocator to
+        // supply memory for the representation.  If an exception is thrown,
+        // 'ptr' is deleted.  The behavior is undefined unless 'ptr' is
+        // compatible with 'delete'.
+
+    template <class COMPATIBLE_TYPE, class DELETER>
+    local_shared_ptr(COMPATIBLE_TYPE *ptr, const DELETER& deleter);
+        // Create a local shared pointer that manages the modifiable object of
+        // (template parameter) type 'COMPATIBLE_TYPE' at the specified 'ptr'
+        // address, and refers to '(ELEMENT_TYPE *)ptr', using the specified
+        // 'deleter' to destroy the object when the last reference is
+        // released.  If 'DELETER' is convertible to 'bslma::Allocator *',
+        // 'deleter' is also used to supply memory for the representation (a
+        // null allocator pointer denoting the currently installed default
+        // allocator); otherwise the default allocator supplies that memory.
+        // See the "Deleters" section in 'bslma_localsharedptroutofplacerep'
+        // for the requirements on 'DELETER'.  If an exception is thrown,
+        // 'ptr' is destroyed using 'deleter'.  Note that if 'DELETER' is
+        // convertible to 'bslma::LocalSharedPtrRep *', this constructor
+        // instead behaves as the constructor taking 'ptr' and a 'rep'
+        // (below), adopting the local reference held by 'deleter'.
+
+    template <class COMPATIBLE_TYPE, class DELETER>
+    local_shared_ptr(COMPATIBLE_TYPE                    *ptr,
+                     const DELETER&                      deleter,
+                     BloombergLP::bslma::Allocator      *basicAllocator);
+        // Create a local shared pointer that manages the modifiable object of
+        // (template parameter) type 'COMPATIBLE_TYPE' at the specified 'ptr'
+        // address, and refers to '(ELEMENT_TYPE *)ptr', using the specified
+        // 'deleter' to destroy the object when the last reference is released
+        // and the specified 'basicAllocator' to supply memory for the
+        // representation.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.  If an exception is thrown, 'ptr' is
+        // destroyed using 'deleter'.
+
+    local_shared_ptr(ELEMENT_TYPE                          *ptr,
+                     BloombergLP::bslma::LocalSharedPtrRep *rep);
+        // Create a local shared pointer that takes ownership of one local
+        // reference of the specified 'rep' and refers to the modifiable
+        // object at the specified 'ptr' address.  The number of local
+        // references of 'rep' is *not* incremented.  Note that if 'rep' is a
+        // pointer to a class derived from 'bslma::LocalSharedPtrRep', the
+        // compiler will select the (more general) deleter constructor above,
+        // which has the same behavior.
+
+    template <class ANY_TYPE>
+    local_shared_ptr(const local_shared_ptr<ANY_TYPE>&  source,
+                     ELEMENT_TYPE                      *object);
+        // Create a local shared pointer that manages the same object (if any)
+        // as the specified 'source' shared pointer to the (template parameter)
+        // 'ANY_TYPE', and that refers to the modifiable object at the
+        // specified 'object' address.  The resulting shared pointer is known
+        // as an "alias" of 'source'.  Note that typically the objects
+        // referred to by 'source' and 'object' have identical lifetimes (e.g.,
+        // one might be a part of the other), so that the deleter for 'source'
+        // will destroy them both, but they do not necessarily have the same
+        // type.
+
+    local_shared_ptr(const local_shared_ptr& original);
+        // Create a local shared pointer that manages the same object (if any)
+        // as the specified 'original', and refers to the same object as
+        // 'original'.  Note that no atomic operation is performed.
+
+    template <class COMPATIBLE_TYPE>
+    local_shared_ptr(const local_shared_ptr<COMPATIBLE_TYPE>& other);
+                                                                    // IMPLICIT
+        // Create a local shared pointer that manages the same object (if any)
+        // as the specified 'other' local shared pointer to the (template
+        // parameter) 'COMPATIBLE_TYPE', and refers to
+        // '(ELEMENT_TYPE *)other.get()'.  The behavior is undefined unless
+        // 'COMPATIBLE_TYPE *' is implicitly convertible to 'ELEMENT_TYPE *'.
+
+    ~local_shared_ptr();
+        // Destroy this local shared pointer.  If this local shared pointer
+        // refers to a (possibly shared) object, then release the reference to
+        // that object, and destroy the shared object using its associated
+        // deleter if this local shared pointer is the last reference to that
+        // object.
+
+    // MANIPULATORS
+    local_shared_ptr& operator=(const local_shared_ptr& rhs);
+        // Make this local shared pointer manage the same object as the
+        // specified 'rhs' and refer to the same object as 'rhs', releasing
+        // the object previously referred to by this local shared pointer (if
+        // any).  Return a reference providing modifiable access to this
+        // object.
+
+    template <class COMPATIBLE_TYPE>
+    local_shared_ptr& operator=(const local_shared_ptr<COMPATIBLE_TYPE>& rhs);
+        // Make this local shared pointer manage the same object as the
+        // specified 'rhs' local shared pointer to the (template parameter)
+        // 'COMPATIBLE_TYPE' and refer to '(ELEMENT_TYPE *)rhs.get()',
+        // releasing the object previously referred to by this local shared
+        // pointer (if any).  Return a reference providing modifiable access
+        // to this object.
+
+    void reset();
+        // Reset this local shared pointer to the empty state.  If this local
+        // shared pointer is managing a (possibly shared) object, then release
+        // the reference to the shared object, calling the associated deleter
+        // to destroy the shared object if this local shared pointer is the
+        // last reference.
+
+    template <class COMPATIBLE_TYPE>
+    void reset(COMPATIBLE_TYPE *ptr);
+        // Modify this local shared pointer to manage the modifiable object of
+        // (template parameter) type 'COMPATIBLE_TYPE' at the specified 'ptr'
+        // address and to refer to '(ELEMENT_TYPE *)ptr', as if by
+        // 'local_shared_ptr(ptr).swap(*this)'.
+
+    template <class COMPATIBLE_TYPE, class DELETER>
+    void reset(COMPATIBLE_TYPE *ptr, const DELETER& deleter);
+        // Modify this local shared pointer to manage the modifiable object of
+        // (template parameter) type 'COMPATIBLE_TYPE' at the specified 'ptr'
+        // address, using the specified 'deleter' to destroy it, as if by
+        // 'local_shared_ptr(ptr, deleter).swap(*this)'.
+
+    template <class ANY_TYPE>
+    void reset(const local_shared_ptr<ANY_TYPE>&  source,
+               ELEMENT_TYPE                      *ptr);
+        // Modify this local shared pointer to manage the same object (if any)
+        // as the specified 'source' and to refer to the modifiable object at
+        // the specified 'ptr' address (i.e., make this an "alias" of
+        // 'source').
+
+    void swap(local_shared_ptr& other);
+        // Efficiently exchange the states of this local shared pointer and
+        // the specified 'other' local shared pointer such that each will refer
+        // to the object formerly referred to by the other and each will manage
+        // the object formerly managed by the other.
+
+    // ACCESSORS
+    operator BoolType() const;
+        // Return a value of an "unspecified bool" type that evaluates to
+        // 'false' if this local shared pointer does not refer to an object,
+        // and 'true' otherwise.
+
+    template <class COMPATIBLE_TYPE>
+    operator shared_ptr<COMPATIBLE_TYPE>() const;
+        // Return a (thread-safe) 'shared_ptr' that manages the same object (if
+        // any) as this local shared pointer and refers to 'get()' implicitly
+        // converted to 'COMPATIBLE_TYPE *'.  The returned shared pointer (and
+        // its copies) may be used by any thread.  If 'ELEMENT_TYPE *' is not
+        // implicitly convertible to 'COMPATIBLE_TYPE *' (e.g., for a derived
+        // or unrelated 'COMPATIBLE_TYPE', or if 'ELEMENT_TYPE' is 'void'),
+        // then a compiler diagnostic will be emitted indicating the error.
+        // Note that this conversion performs one atomic increment of the
+        // shared reference count.
+
+    typename add_lvalue_reference<ELEMENT_TYPE>::type
+    operator*() const;
+        // Return a reference providing modifiable access to the object
+        // referred to by this local shared pointer.  The behavior is undefined
+        // unless this local shared pointer refers to an object, and
+        // 'ELEMENT_TYPE' is not (potentially 'const' or 'volatile' qualified)
+        // 'void'.
+
+    ELEMENT_TYPE *operator->() const;
+        // Return the address providing modifiable access to the object
+        // referred to by this local shared pointer, or 0 if this local shared
+        // pointer does not refer to an object.
+
+    ELEMENT_TYPE *get() const;
+        // Return the address providing modifiable access to the object
+        // referred to by this local shared pointer, or 0 if this local shared
+        // pointer does not refer to an object.
+
+    long local_use_count() const;
+        // Return a count of the number of local shared pointers (including
+        // this one) that share ownership of the same object as this local
+        // shared pointer, or 0 if this local shared pointer is empty.
+
+    template <class ANY_TYPE>
+    bool owner_before(const local_shared_ptr<ANY_TYPE>& other) const;
+    template <class ANY_TYPE>
+    bool owner_before(const shared_ptr<ANY_TYPE>& other) const;
+        // Return 'true' if the address of the representation object used by
+        // this local shared pointer is ordered before the address of the
+        // representation object used by the specified 'other' shared pointer
+        // under the total ordering defined by 'std::less', and 'false'
+        // otherwise.
+
+    BloombergLP::bslma::LocalSharedPtrRep *rep() const;
+        // Return the address providing modifiable access to the
+        // representation object used by this local shared pointer, or 0 if
+        // this local shared pointer is empty.
+
+    bool unique() const;
+        // Return 'true' if this local shared pointer is the only shared
+        // reference (local or otherwise) to the object it manages, and 'false'
+        // otherwise.
+
+    long use_count() const;
+        // Return a "snapshot" of the number of shared pointers, counting both
+        // local shared pointers and (thread-safe) 'shared_ptr' objects, that
+        // share ownership of the same object as this local shared pointer, or
+        // 0 if this local shared pointer is empty.
+};
+
+// FREE OPERATORS
+template <class LHS_TYPE, class RHS_TYPE>
+bool operator==(const local_shared_ptr<LHS_TYPE>& lhs,
+                const local_shared_ptr<RHS_TYPE>& rhs);
+    // Return 'true' if the specified 'lhs' local shared pointer refers to the
+    // same object (if any) as that referred to by the specified 'rhs' local
+    // shared pointer (if any), and 'false' otherwise.
+
+template <class LHS_TYPE, class RHS_TYPE>
+bool operator!=(const local_shared_ptr<LHS_TYPE>& lhs,
+                const local_shared_ptr<RHS_TYPE>& rhs);
+    // Return 'true' if the specified 'lhs' local shared pointer does not refer
+    // to the same object (if any) as that referred to by the specified 'rhs'
+    // local shared pointer (if any), and 'false' otherwise.
+
+template <class LHS_TYPE, class RHS_TYPE>
+bool operator<(const local_shared_ptr<LHS_TYPE>& lhs,
+               const local_shared_ptr<RHS_TYPE>& rhs);
+    // Return 'true' if the address of the object that the specified 'lhs'
+    // local shared pointer refers to is ordered before the address of the
+    // object that the specified 'rhs' local shared pointer refers to under the
+    // total ordering supplied by 'std::less<T *>', where 'T *' is the
+    // composite pointer type of 'LHS_TYPE *' and 'RHS_TYPE *', and 'false'
+    // otherwise.
+
+template <class LHS_TYPE>
+bool operator==(const local_shared_ptr<LHS_TYPE>& lhs, nullptr_t);
+template <class RHS_TYPE>
+bool operator==(nullptr_t, const local_shared_ptr<RHS_TYPE>& rhs);
+    // Return 'true' if the specified local shared pointer is empty, and
+    // 'false' otherwise.
+
+template <class LHS_TYPE>
+bool operator!=(const local_shared_ptr<LHS_TYPE>& lhs, nullptr_t);
+template <class RHS_TYPE>
+bool operator!=(nullptr_t, const local_shared_ptr<RHS_TYPE>& rhs);
+    // Return 'true' if the specified local shared pointer is not empty, and
+    // 'false' otherwise.
+
+// FREE FUNCTIONS
+template <class ELEMENT_TYPE>
+void swap(local_shared_ptr<ELEMENT_TYPE>& a,
+          local_shared_ptr<ELEMENT_TYPE>& b);
+    // Efficiently exchange the states of the specified 'a' and 'b' local
+    // shared pointers such that each will refer to the object formerly
+    // referred to by the other, and each will manage the object formerly
+    // managed by the other.
+
+template <class TO_TYPE, class FROM_TYPE>
+local_shared_ptr<TO_TYPE>
+const_pointer_cast(const local_shared_ptr<FROM_TYPE>& source);
+    // Return a 'local_shared_ptr<TO_TYPE>' object sharing ownership of the
+    // same object as the specified 'source' and referring to
+    // 'const_cast<TO_TYPE *>(source.get())'.
+
+template <class TO_TYPE, class FROM_TYPE>
+local_shared_ptr<TO_TYPE>
+dynamic_pointer_cast(const local_shared_ptr<FROM_TYPE>& source);
+    // Return a 'local_shared_ptr<TO_TYPE>' object sharing ownership of the
+    // same object as the specified 'source' and referring to
+    // 'dynamic_cast<TO_TYPE *>(source.get())'.  If that would return a null
+    // pointer, then return an empty local shared pointer.
+
+template <class TO_TYPE, class FROM_TYPE>
+local_shared_ptr<TO_TYPE>
+static_pointer_cast(const local_shared_ptr<FROM_TYPE>& source);
+    // Return a 'local_shared_ptr<TO_TYPE>' object sharing ownership of the
+    // same object as the specified 'source' and referring to
+    // 'static_cast<TO_TYPE *>(source.get())'.
+
+// FACTORY FUNCTIONS
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_VARIADIC_TEMPLATES)                 \
+ && defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+template <class ELEMENT_TYPE, class ALLOC, class... ARGS>
+typename enable_if<!is_pointer<ALLOC>::value,
+                   local_shared_ptr<ELEMENT_TYPE> >::type
+allocate_local_shared(ALLOC basicAllocator, ARGS&&... args);
+    // Return a 'local_shared_ptr' object referring to and managing a new
+    // 'ELEMENT_TYPE' object.  The specified 'basicAllocator' will be used to
+    // supply a single contiguous region of memory holding the returned local
+    // shared pointer's internal representation and the new 'ELEMENT_TYPE'
+    // object, which is initialized by calling
+    // 'allocator_traits<ALLOC>::construct' passing 'basicAllocator', an
+    // 'ELEMENT_TYPE *' pointer to space for the new shared object, and the
+    // specified arguments 'std::forward<ARGS>(args)...'.
+
+template <class ELEMENT_TYPE, class ALLOC, class... ARGS>
+local_shared_ptr<ELEMENT_TYPE>
+allocate_local_shared(ALLOC *basicAllocator, ARGS&&... args);
+    // Return a 'local_shared_ptr' object referring to and managing a new
+    // 'ELEMENT_TYPE' object.  The specified 'basicAllocator' will be used to
+    // supply a single contiguous region of memory holding the returned local
+    // shared pointer's internal representation and the new 'ELEMENT_TYPE'
+    // object, which is initialized using the 'ELEMENT_TYPE' constructor that
+    // takes the specified arguments 'std::forward<ARGS>(args)...'.  If
+    // 'ELEMENT_TYPE' uses 'bslma' allocators, then 'basicAllocator' is passed
+    // as an extra argument in the final position.
+
+template <class ELEMENT_TYPE, class... ARGS>
+local_shared_ptr<ELEMENT_TYPE> make_local_shared(ARGS&&... args);
+    // Return a 'local_shared_ptr' object referring to and managing a new
+    // 'ELEMENT_TYPE' object.  The default allocator will be used to supply a
+    // single contiguous region of memory holding the returned local shared
+    // pointer's internal representation and the new 'ELEMENT_TYPE' object,
+    // which is initialized using the 'ELEMENT_TYPE' constructor that takes the
+    // specified arguments 'std::forward<ARGS>(args)...'.  If 'ELEMENT_TYPE'
+    // uses 'bslma' allocators, then the default allocator is passed as an
+    // extra argument in the final position.
+#else
+// The following overloads emulate the variadic factory functions above, for
+// up to five constructor arguments, on platforms lacking variadic templates or
+// rvalue references.
+
+template <class ELEMENT_TYPE, class ALLOC>
+typename enable_if<!is_pointer<ALLOC>::value,
+                   local_shared_ptr<ELEMENT_TYPE> >::type
+allocate_local_shared(ALLOC basicAllocator);
+
+template <class ELEMENT_TYPE, class ALLOC, class A1>
+typename enable_if<!is_pointer<ALLOC>::value,
+                   local_shared_ptr<ELEMENT_TYPE> >::type
+allocate_local_shared(ALLOC basicAllocator, const A1& a1);
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2>
+typename enable_if<!is_pointer<ALLOC>::value,
+                   local_shared_ptr<ELEMENT_TYPE> >::type
+allocate_local_shared(ALLOC basicAllocator, const A1& a1, const A2& a2);
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2, class A3>
+typename enable_if<!is_pointer<ALLOC>::value,
+                   local_shared_ptr<ELEMENT_TYPE> >::type
+allocate_local_shared(ALLOC     basicAllocator,
+                      const A1& a1,
+                      const A2& a2,
+                      const A3& a3);
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2, class A3,
+          class A4>
+typename enable_if<!is_pointer<ALLOC>::value,
+                   local_shared_ptr<ELEMENT_TYPE> >::type
+allocate_local_shared(ALLOC     basicAllocator,
+                      const A1& a1,
+                      const A2& a2,
+                      const A3& a3,
+                      const A4& a4);
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2, class A3,
+          class A4, class A5>
+typename enable_if<!is_pointer<ALLOC>::value,
+                   local_shared_ptr<ELEMENT_TYPE> >::type
+allocate_local_shared(ALLOC     basicAllocator,
+                      const A1& a1,
+                      const A2& a2,
+                      const A3& a3,
+                      const A4& a4,
+                      const A5& a5);
+    // Return a 'local_shared_ptr' object referring to and managing a new
+    // 'ELEMENT_TYPE' object.  The specified 'basicAllocator' will be used to
+    // supply a single contiguous region of memory holding the returned local
+    // shared pointer's internal representation and the new 'ELEMENT_TYPE'
+    // object, which is initialized by calling
+    // 'allocator_traits<ALLOC>::construct' passing 'basicAllocator', an
+    // 'ELEMENT_TYPE *' pointer to space for the new shared object, and the
+    // specified arguments 'a1' up to 'a5' (if any).
+
+template <class ELEMENT_TYPE, class ALLOC>
+local_shared_ptr<ELEMENT_TYPE> allocate_local_shared(ALLOC *basicAllocator);
+
+template <class ELEMENT_TYPE, class ALLOC, class A1>
+local_shared_ptr<ELEMENT_TYPE> allocate_local_shared(ALLOC     *basicAllocator,
+                                                     const A1&  a1);
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2>
+local_shared_ptr<ELEMENT_TYPE> allocate_local_shared(ALLOC     *basicAllocator,
+                                                     const A1&  a1,
+                                                     const A2&  a2);
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2, class A3>
+local_shared_ptr<ELEMENT_TYPE> allocate_local_shared(ALLOC     *basicAllocator,
+                                                     const A1&  a1,
+                                                     const A2&  a2,
+                                                     const A3&  a3);
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2, class A3,
+          class A4>
+local_shared_ptr<ELEMENT_TYPE> allocate_local_shared(ALLOC     *basicAllocator,
+                                                     const A1&  a1,
+                                                     const A2&  a2,
+                                                     const A3&  a3,
+                                                     const A4&  a4);
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2, class A3,
+          class A4, class A5>
+local_shared_ptr<ELEMENT_TYPE> allocate_local_shared(ALLOC     *basicAllocator,
+                                                     const A1&  a1,
+                                                     const A2&  a2,
+                                                     const A3&  a3,
+                                                     const A4&  a4,
+                                                     const A5&  a5);
+    // Return a 'local_shared_ptr' object referring to and managing a new
+    // 'ELEMENT_TYPE' object.  The specified 'basicAllocator' will be used to
+    // supply a single contiguous region of memory holding the returned local
+    // shared pointer's internal representation and the new 'ELEMENT_TYPE'
+    // object, which is initialized using the 'ELEMENT_TYPE' constructor that
+    // takes the specified arguments 'a1' up to 'a5' (if any).  If
+    // 'ELEMENT_TYPE' uses 'bslma' allocators, then 'basicAllocator' is passed
+    // as an extra argument in the final position.
+
+template <class ELEMENT_TYPE>
+local_shared_ptr<ELEMENT_TYPE> make_local_shared();
+
+template <class ELEMENT_TYPE, class A1>
+local_shared_ptr<ELEMENT_TYPE> make_local_shared(const A1& a1);
+
+template <class ELEMENT_TYPE, class A1, class A2>
+local_shared_ptr<ELEMENT_TYPE> make_local_shared(const A1& a1, const A2& a2);
+
+template <class ELEMENT_TYPE, class A1, class A2, class A3>
+local_shared_ptr<ELEMENT_TYPE> make_local_shared(const A1& a1,
+                                                 const A2& a2,
+                                                 const A3& a3);
+
+template <class ELEMENT_TYPE, class A1, class A2, class A3, class A4>
+local_shared_ptr<ELEMENT_TYPE> make_local_shared(const A1& a1,
+                                                 const A2& a2,
+                                                 const A3& a3,
+                                                 const A4& a4);
+
+template <class ELEMENT_TYPE, class A1, class A2, class A3, class A4,
+          class A5>
+local_shared_ptr<ELEMENT_TYPE> make_local_shared(const A1& a1,
+                                                 const A2& a2,
+                                                 const A3& a3,
+                                                 const A4& a4,
+                                                 const A5& a5);
+    // Return a 'local_shared_ptr' object referring to and managing a new
+    // 'ELEMENT_TYPE' object.  The default allocator will be used to supply a
+    // single contiguous region of memory holding the returned local shared
+    // pointer's internal representation and the new 'ELEMENT_TYPE' object,
+    // which is initialized using the 'ELEMENT_TYPE' constructor that takes the
+    // specified arguments 'a1' up to 'a5' (if any).  If 'ELEMENT_TYPE' uses
+    // 'bslma' allocators, then the default allocator is passed as an extra
+    // argument in the final position.
+#endif
+
+}  // close namespace bsl
+
+// ============================================================================
+//                           INLINE DEFINITIONS
+// ============================================================================
+
+namespace BloombergLP {
+namespace bslstl {
+
+                       // ------------------------------------
+                       // struct LocalSharedPtr_DefaultDeleter
+                       // ------------------------------------
+
+// ACCESSORS
+template <class ANY_TYPE>
+inline
+void LocalSharedPtr_DefaultDeleter::operator()(ANY_TYPE *ptr) const
+{
+    delete ptr;
+}
+
+                        // -------------------------------
+                        // class LocalSharedPtr_RepProctor
+                        // -------------------------------
+
+// CREATORS
+inline
+LocalSharedPtr_RepProctor::LocalSharedPtr_RepProctor(bslma::SharedPtrRep *rep)
+: d_rep_p(rep)
+{
+}
+
+inline
+LocalSharedPtr_RepProctor::~LocalSharedPtr_RepProctor()
+{
+    if (d_rep_p) {
+        d_rep_p->disposeRep();
+    }
+}
+
+// MANIPULATORS
+inline
+void LocalSharedPtr_RepProctor::release()
+{
+    d_rep_p = 0;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+namespace bsl {
+
+                          // ----------------------
+                          // class local_shared_ptr
+                          // ----------------------
+
+// PRIVATE CLASS METHODS
+template <class ELEMENT_TYPE>
+template <class COMPATIBLE_TYPE, class DELETER>
+inline
+BloombergLP::bslma::LocalSharedPtrRep *
+local_shared_ptr<ELEMENT_TYPE>::makeInternalRep(
+                                              COMPATIBLE_TYPE *,
+                                              const DELETER&   rep,
+                                              BloombergLP::bslmf::MetaInt<2>)
+{
+    return rep;
+}
+
+template <class ELEMENT_TYPE>
+template <class COMPATIBLE_TYPE, class DELETER>
+inline
+BloombergLP::bslma::LocalSharedPtrRep *
+local_shared_ptr<ELEMENT_TYPE>::makeInternalRep(
+                                              COMPATIBLE_TYPE *ptr,
+                                              const DELETER&   deleter,
+                                              BloombergLP::bslmf::MetaInt<1>)
+{
+    typedef BloombergLP::bslma::LocalSharedPtrOutofplaceRep<
+                                               COMPATIBLE_TYPE,
+                                               BloombergLP::bslma::Allocator *>
+                                                                      RepMaker;
+
+    BloombergLP::bslma::Allocator *allocator = deleter;
+    return RepMaker::makeOutofplaceRep(ptr, allocator, allocator);
+}
+
+template <class ELEMENT_TYPE>
+template <class COMPATIBLE_TYPE, class DELETER>
+inline
+BloombergLP::bslma::LocalSharedPtrRep *
+local_shared_ptr<ELEMENT_TYPE>::makeInternalRep(
+                                              COMPATIBLE_TYPE *ptr,
+                                              const DELETER&   deleter,
+                                              BloombergLP::bslmf::MetaInt<0>)
+{
+    typedef BloombergLP::bslma::LocalSharedPtrOutofplaceRep<COMPATIBLE_TYPE,
+                                                            DELETER> RepMaker;
+
+    return RepMaker::makeOutofplaceRep(ptr, deleter, 0);
+}
+
+// CREATORS
+template <class ELEMENT_TYPE>
+inline
+local_shared_ptr<ELEMENT_TYPE>::local_shared_ptr()
+: d_ptr_p(0)
+, d_rep_p(0)
+{
+}
+
+template <class ELEMENT_TYPE>
+inline
+local_shared_ptr<ELEMENT_TYPE>::local_shared_ptr(bsl::nullptr_t)
+: d_ptr_p(0)
+, d_rep_p(0)
+{
+}
+
+template <class ELEMENT_TYPE>
+template <class COMPATIBLE_TYPE>
+inline
+local_shared_ptr<ELEMENT_TYPE>::local_shared_ptr(COMPATIBLE_TYPE *ptr)
+: d_ptr_p(ptr)
+{
+    typedef BloombergLP::bslstl::LocalSharedPtr_DefaultDeleter Deleter;
+    typedef BloombergLP::bslma::LocalSharedPtrOutofplaceRep<COMPATIBLE_TYPE,
+                                                            Deleter> RepMaker;
+
+    d_rep_p = RepMaker::makeOutofplaceRep(ptr, Deleter(), 0);
+}
+
+template <class ELEMENT_TYPE>
+template <class COMPATIBLE_TYPE, class DELETER>
+inline
+local_shared_ptr<ELEMENT_TYPE>::local_shared_ptr(COMPATIBLE_TYPE *ptr,
+                                                 const DELETER&   deleter)
+: d_ptr_p(ptr)
+{
+    enum {
+        k_IS_REP       = is_convertible<
+                      DELETER, BloombergLP::bslma::LocalSharedPtrRep *>::value,
+        k_IS_ALLOCATOR = is_convertible<
+                           DELETER, BloombergLP::bslma::Allocator *>::value,
+        k_DISPATCH     = k_IS_REP ? 2 : k_IS_ALLOCATOR ? 1 : 0
+    };
+
+    d_rep_p = makeInternalRep(ptr,
+                              deleter,
+                              BloombergLP::bslmf::MetaInt<k_DISPATCH>());
+}
+
+template <class ELEMENT_TYPE>
+template <class COMPATIBLE_TYPE, class DELETER>
+inline
+local_shared_ptr<ELEMENT_TYPE>::local_shared_ptr(
+                        COMPATIBLE_TYPE                    *ptr,
+                        const DELETER&                      deleter,
+                        BloombergLP::bslma::Allocator      *basicAllocator)
+: d_ptr_p(ptr)
+{
+    typedef BloombergLP::bslma::LocalSharedPtrOutofplaceRep<COMPATIBLE_TYPE,
+                                                            DELETER> RepMaker;
+
+    d_rep_p = RepMaker::makeOutofplaceRep(ptr, deleter, basicAllocator);
+}
+
+template <class ELEMENT_TYPE>
+inline
+local_shared_ptr<ELEMENT_TYPE>::local_shared_ptr(
+                               ELEMENT_TYPE                          *ptr,
+                               BloombergLP::bslma::LocalSharedPtrRep *rep)
+: d_ptr_p(ptr)
+, d_rep_p(rep)
+{
+}
+
+template <class ELEMENT_TYPE>
+template <class ANY_TYPE>
+inline
+local_shared_ptr<ELEMENT_TYPE>::local_shared_ptr(
+                                   const local_shared_ptr<ANY_TYPE>&  source,
+                                   ELEMENT_TYPE                      *object)
+: d_ptr_p(object)
+, d_rep_p(source.d_rep_p)
+{
+    if (d_rep_p) {
+        d_rep_p->acquireLocalRef();
+    }
+}
+
+template <class ELEMENT_TYPE>
+inline
+local_shared_ptr<ELEMENT_TYPE>::local_shared_ptr(
+                                              const local_shared_ptr& original)
+: d_ptr_p(original.d_ptr_p)
+, d_rep_p(original.d_rep_p)
+{
+    if (d_rep_p) {
+        d_rep_p->acquireLocalRef();
+    }
+}
+
+template <class ELEMENT_TYPE>
+template <class COMPATIBLE_TYPE>
+inline
+local_shared_ptr<ELEMENT_TYPE>::local_shared_ptr(
+                                const local_shared_ptr<COMPATIBLE_TYPE>& other)
+: d_ptr_p(other.d_ptr_p)
+, d_rep_p(other.d_rep_p)
+{
+    if (d_rep_p) {
+        d_rep_p->acquireLocalRef();
+    }
+}
+
+template <class ELEMENT_TYPE>
+inline
+local_shared_ptr<ELEMENT_TYPE>::~local_shared_ptr()
+{
+    if (d_rep_p) {
+        d_rep_p->releaseLocalRef();
+    }
+}
+
+// MANIPULATORS
+template <class ELEMENT_TYPE>
+inline
+local_shared_ptr<ELEMENT_TYPE>&
+local_shared_ptr<ELEMENT_TYPE>::operator=(const local_shared_ptr& rhs)
+{
+    // Acquiring the new reference before releasing the old one makes
+    // self-assignment (and assignment from an alias) safe.
+
+    SelfType(rhs).swap(*this);
+    return *this;
+}
+
+template <class ELEMENT_TYPE>
+template <class COMPATIBLE_TYPE>
+inline
+local_shared_ptr<ELEMENT_TYPE>&
+local_shared_ptr<ELEMENT_TYPE>::operator=(
+                                  const local_shared_ptr<COMPATIBLE_TYPE>& rhs)
+{
+    SelfType(rhs).swap(*this);
+    return *this;
+}
+
+template <class ELEMENT_TYPE>
+inline
+void local_shared_ptr<ELEMENT_TYPE>::reset()
+{
+    BloombergLP::bslma::LocalSharedPtrRep *rep = d_rep_p;
+
+    // Clear 'd_rep_p' first so that a self-referencing structure is not
+    // destroyed twice.
+
+    d_ptr_p = 0;
+    d_rep_p = 0;
+
+    if (rep) {
+        rep->releaseLocalRef();
+    }
+}
+
+template <class ELEMENT_TYPE>
+template <class COMPATIBLE_TYPE>
+inline
+void local_shared_ptr<ELEMENT_TYPE>::reset(COMPATIBLE_TYPE *ptr)
+{
+    SelfType(ptr).swap(*this);
+}
+
+template <class ELEMENT_TYPE>
+template <class COMPATIBLE_TYPE, class DELETER>
+inline
+void local_shared_ptr<ELEMENT_TYPE>::reset(COMPATIBLE_TYPE *ptr,
+                                           const DELETER&   deleter)
+{
+    SelfType(ptr, deleter).swap(*this);
+}
+
+template <class ELEMENT_TYPE>
+template <class ANY_TYPE>
+inline
+void local_shared_ptr<ELEMENT_TYPE>::reset(
+                                     const local_shared_ptr<ANY_TYPE>&  source,
+                                     ELEMENT_TYPE                      *ptr)
+{
+    SelfType(source, ptr).swap(*this);
+}
+
+template <class ELEMENT_TYPE>
+inline
+void local_shared_ptr<ELEMENT_TYPE>::swap(local_shared_ptr& other)
+{
+    // As for 'shared_ptr::swap', the pointers are swapped directly to avoid
+    // (indirectly) including the platform <algorithm> header.
+
+    ELEMENT_TYPE *tempPtr_p = d_ptr_p;
+    d_ptr_p       = other.d_ptr_p;
+    other.d_ptr_p = tempPtr_p;
+
+    BloombergLP::bslma::LocalSharedPtrRep *tempRep_p = d_rep_p;
+    d_rep_p       = other.d_rep_p;
+    other.d_rep_p = tempRep_p;
+}
+
+// ACCESSORS
+template <class ELEMENT_TYPE>
+inline
+#if defined(BSLS_PLATFORM_CMP_IBM)
+local_shared_ptr<ELEMENT_TYPE>::operator
+                                   typename local_shared_ptr::BoolType() const
+#else
+local_shared_ptr<ELEMENT_TYPE>::operator BoolType() const
+#endif
+{
+    return BloombergLP::bsls::UnspecifiedBool<local_shared_ptr>::makeValue(
+                                                                      d_ptr_p);
+}
+
+template <class ELEMENT_TYPE>
+template <class COMPATIBLE_TYPE>
+inline
+local_shared_ptr<ELEMENT_TYPE>::operator shared_ptr<COMPATIBLE_TYPE>() const
+{
+    // Convert the pointer implicitly, so that a downcast (or a conversion from
+    // 'void *') fails to compile, and before constructing the result, so that
+    // the '(ptr, rep)' constructor is selected rather than the constructor
+    // taking a deleter.
+
+    COMPATIBLE_TYPE *ptr = d_ptr_p;
+
+    if (!d_rep_p) {
+        return shared_ptr<COMPATIBLE_TYPE>();                         // RETURN
+    }
+
+    BloombergLP::bslma::SharedPtrRep *rep = d_rep_p;
+    rep->acquireRef();
+
+    return shared_ptr<COMPATIBLE_TYPE>(ptr, rep);
+}
+
+template <class ELEMENT_TYPE>
+inline
+typename add_lvalue_reference<ELEMENT_TYPE>::type
+local_shared_ptr<ELEMENT_TYPE>::operator*() const
+{
+    BSLS_ASSERT_SAFE(d_ptr_p);
+
+    return *d_ptr_p;
+}
+
+template <class ELEMENT_TYPE>
+inline
+ELEMENT_TYPE *local_shared_ptr<ELEMENT_TYPE>::operator->() const
+{
+    return d_ptr_p;
+}
+
+template <class ELEMENT_TYPE>
+inline
+ELEMENT_TYPE *local_shared_ptr<ELEMENT_TYPE>::get() const
+{
+    return d_ptr_p;
+}
+
+template <class ELEMENT_TYPE>
+inline
+long local_shared_ptr<ELEMENT_TYPE>::local_use_count() const
+{
+    return d_rep_p ? d_rep_p->numLocalReferences() : 0;
+}
+
+template <class ELEMENT_TYPE>
+template <class ANY_TYPE>
+inline
+bool local_shared_ptr<ELEMENT_TYPE>::owner_before(
+                                 const local_shared_ptr<ANY_TYPE>& other) const
+{
+    return native_std::less<BloombergLP::bslma::SharedPtrRep *>()(
+                                                                 rep(),
+                                                                 other.rep());
+}
+
+template <class ELEMENT_TYPE>
+template <class ANY_TYPE>
+inline
+bool local_shared_ptr<ELEMENT_TYPE>::owner_before(
+                                       const shared_ptr<ANY_TYPE>& other) const
+{
+    return native_std::less<BloombergLP::bslma::SharedPtrRep *>()(
+                                                                 rep(),
+                                                                 other.rep());
+}
+
+template <class ELEMENT_TYPE>
+inline
+BloombergLP::bslma::LocalSharedPtrRep *
+local_shared_ptr<ELEMENT_TYPE>::rep() const
+{
+    return d_rep_p;
+}
+
+template <class ELEMENT_TYPE>
+inline
+bool local_shared_ptr<ELEMENT_TYPE>::unique() const
+{
+    return 1 == use_count();
+}
+
+template <class ELEMENT_TYPE>
+inline
+long local_shared_ptr<ELEMENT_TYPE>::use_count() const
+{
+    // The local references collectively hold one of the representation's
+    // shared references.
+
+    return d_rep_p
+           ? d_rep_p->numReferences() - 1 + d_rep_p->numLocalReferences()
+           : 0;
+}
+
+}  // close namespace bsl
+
+// FREE OPERATORS
+template <class LHS_TYPE, class RHS_TYPE>
+inline
+bool bsl::operator==(const local_shared_ptr<LHS_TYPE>& lhs,
+                     const local_shared_ptr<RHS_TYPE>& rhs)
+{
+    return lhs.get() == rhs.get();
+}
+
+template <class LHS_TYPE, class RHS_TYPE>
+inline
+bool bsl::operator!=(const local_shared_ptr<LHS_TYPE>& lhs,
+                     const local_shared_ptr<RHS_TYPE>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class LHS_TYPE, class RHS_TYPE>
+inline
+bool bsl::operator<(const local_shared_ptr<LHS_TYPE>& lhs,
+                    const local_shared_ptr<RHS_TYPE>& rhs)
+{
+    return native_std::less<const void *>()(lhs.get(), rhs.get());
+}
+
+template <class LHS_TYPE>
+inline
+bool bsl::operator==(const local_shared_ptr<LHS_TYPE>& lhs, nullptr_t)
+{
+    return !lhs;
+}
+
+template <class RHS_TYPE>
+inline
+bool bsl::operator==(nullptr_t, const local_shared_ptr<RHS_TYPE>& rhs)
+{
+    return !rhs;
+}
+
+template <class LHS_TYPE>
+inline
+bool bsl::operator!=(const local_shared_ptr<LHS_TYPE>& lhs, nullptr_t)
+{
+    return static_cast<bool>(lhs);
+}
+
+template <class RHS_TYPE>
+inline
+bool bsl::operator!=(nullptr_t, const local_shared_ptr<RHS_TYPE>& rhs)
+{
+    return static_cast<bool>(rhs);
+}
+
+// FREE FUNCTIONS
+template <class ELEMENT_TYPE>
+inline
+void bsl::swap(local_shared_ptr<ELEMENT_TYPE>& a,
+               local_shared_ptr<ELEMENT_TYPE>& b)
+{
+    a.swap(b);
+}
+
+template <class TO_TYPE, class FROM_TYPE>
+inline
+bsl::local_shared_ptr<TO_TYPE>
+bsl::const_pointer_cast(const local_shared_ptr<FROM_TYPE>& source)
+{
+    return local_shared_ptr<TO_TYPE>(source,
+                                     const_cast<TO_TYPE *>(source.get()));
+}
+
+template <class TO_TYPE, class FROM_TYPE>
+inline
+bsl::local_shared_ptr<TO_TYPE>
+bsl::dynamic_pointer_cast(const local_shared_ptr<FROM_TYPE>& source)
+{
+    if (TO_TYPE *castPtr = dynamic_cast<TO_TYPE *>(source.get())) {
+        return local_shared_ptr<TO_TYPE>(source, castPtr);            // RETURN
+    }
+
+    return local_shared_ptr<TO_TYPE>();
+}
+
+template <class TO_TYPE, class FROM_TYPE>
+inline
+bsl::local_shared_ptr<TO_TYPE>
+bsl::static_pointer_cast(const local_shared_ptr<FROM_TYPE>& source)
+{
+    return local_shared_ptr<TO_TYPE>(source,
+                                     static_cast<TO_TYPE *>(source.get()));
+}
+
+// FACTORY FUNCTIONS
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_VARIADIC_TEMPLATES)                 \
+ && defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+template <class ELEMENT_TYPE, class ALLOC, class... ARGS>
+typename bsl::enable_if<!bsl::is_pointer<ALLOC>::value,
+                        bsl::local_shared_ptr<ELEMENT_TYPE> >::type
+bsl::allocate_local_shared(ALLOC basicAllocator, ARGS&&... args)
+{
+    typedef BloombergLP::bslstl::LocalSharedPtrAllocateInplaceRep<ELEMENT_TYPE,
+                                                                  ALLOC> Rep;
+    Rep *rep_p = Rep::makeRep(basicAllocator);
+    BloombergLP::bslstl::LocalSharedPtr_RepProctor proctor(rep_p);
+    bsl::allocator_traits<ALLOC>::construct(
+                              basicAllocator,
+                              rep_p->ptr(),
+                              BloombergLP::bsls::Util::forward<ARGS>(args)...);
+    proctor.release();
+    return local_shared_ptr<ELEMENT_TYPE>(rep_p->ptr(), rep_p);
+}
+
+template <class ELEMENT_TYPE, class ALLOC, class... ARGS>
+inline
+bsl::local_shared_ptr<ELEMENT_TYPE>
+bsl::allocate_local_shared(ALLOC *basicAllocator, ARGS&&... args)
+{
+    return allocate_local_shared<ELEMENT_TYPE>(
+                              bsl::allocator<ELEMENT_TYPE>(basicAllocator),
+                              BloombergLP::bsls::Util::forward<ARGS>(args)...);
+}
+
+template <class ELEMENT_TYPE, class... ARGS>
+inline
+bsl::local_shared_ptr<ELEMENT_TYPE>
+bsl::make_local_shared(ARGS&&... args)
+{
+    return allocate_local_shared<ELEMENT_TYPE>(
+                              bsl::allocator<ELEMENT_TYPE>(),
+                              BloombergLP::bsls::Util::forward<ARGS>(args)...);
+}
+#else
+template <class ELEMENT_TYPE, class ALLOC>
+typename bsl::enable_if<!bsl::is_pointer<ALLOC>::value,
+                        bsl::local_shared_ptr<ELEMENT_TYPE> >::type
+bsl::allocate_local_shared(ALLOC basicAllocator)
+{
+    typedef BloombergLP::bslstl::LocalSharedPtrAllocateInplaceRep<ELEMENT_TYPE,
+                                                                  ALLOC> Rep;
+    Rep *rep_p = Rep::makeRep(basicAllocator);
+    BloombergLP::bslstl::LocalSharedPtr_RepProctor proctor(rep_p);
+    bsl::allocator_traits<ALLOC>::construct(basicAllocator, rep_p->ptr());
+    proctor.release();
+    return local_shared_ptr<ELEMENT_TYPE>(rep_p->ptr(), rep_p);
+}
+
+template <class ELEMENT_TYPE, class ALLOC, class A1>
+typename bsl::enable_if<!bsl::is_pointer<ALLOC>::value,
+                        bsl::local_shared_ptr<ELEMENT_TYPE> >::type
+bsl::allocate_local_shared(ALLOC basicAllocator, const A1& a1)
+{
+    typedef BloombergLP::bslstl::LocalSharedPtrAllocateInplaceRep<ELEMENT_TYPE,
+                                                                  ALLOC> Rep;
+    Rep *rep_p = Rep::makeRep(basicAllocator);
+    BloombergLP::bslstl::LocalSharedPtr_RepProctor proctor(rep_p);
+    bsl::allocator_traits<ALLOC>::construct(basicAllocator, rep_p->ptr(), a1);
+    proctor.release();
+    return local_shared_ptr<ELEMENT_TYPE>(rep_p->ptr(), rep_p);
+}
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2>
+typename bsl::enable_if<!bsl::is_pointer<ALLOC>::value,
+                        bsl::local_shared_ptr<ELEMENT_TYPE> >::type
+bsl::allocate_local_shared(ALLOC basicAllocator, const A1& a1, const A2& a2)
+{
+    typedef BloombergLP::bslstl::LocalSharedPtrAllocateInplaceRep<ELEMENT_TYPE,
+                                                                  ALLOC> Rep;
+    Rep *rep_p = Rep::makeRep(basicAllocator);
+    BloombergLP::bslstl::LocalSharedPtr_RepProctor proctor(rep_p);
+    bsl::allocator_traits<ALLOC>::construct(basicAllocator,
+                                            rep_p->ptr(),
+                                            a1,
+                                            a2);
+    proctor.release();
+    return local_shared_ptr<ELEMENT_TYPE>(rep_p->ptr(), rep_p);
+}
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2, class A3>
+typename bsl::enable_if<!bsl::is_pointer<ALLOC>::value,
+                        bsl::local_shared_ptr<ELEMENT_TYPE> >::type
+bsl::allocate_local_shared(ALLOC     basicAllocator,
+                           const A1& a1,
+                           const A2& a2,
+                           const A3& a3)
+{
+    typedef BloombergLP::bslstl::LocalSharedPtrAllocateInplaceRep<ELEMENT_TYPE,
+                                                                  ALLOC> Rep;
+    Rep *rep_p = Rep::makeRep(basicAllocator);
+    BloombergLP::bslstl::LocalSharedPtr_RepProctor proctor(rep_p);
+    bsl::allocator_traits<ALLOC>::construct(basicAllocator,
+                                            rep_p->ptr(),
+                                            a1,
+                                            a2,
+                                            a3);
+    proctor.release();
+    return local_shared_ptr<ELEMENT_TYPE>(rep_p->ptr(), rep_p);
+}
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2, class A3,
+          class A4>
+typename bsl::enable_if<!bsl::is_pointer<ALLOC>::value,
+                        bsl::local_shared_ptr<ELEMENT_TYPE> >::type
+bsl::allocate_local_shared(ALLOC     basicAllocator,
+                           const A1& a1,
+                           const A2& a2,
+                           const A3& a3,
+                           const A4& a4)
+{
+    typedef BloombergLP::bslstl::LocalSharedPtrAllocateInplaceRep<ELEMENT_TYPE,
+                                                                  ALLOC> Rep;
+    Rep *rep_p = Rep::makeRep(basicAllocator);
+    BloombergLP::bslstl::LocalSharedPtr_RepProctor proctor(rep_p);
+    bsl::allocator_traits<ALLOC>::construct(basicAllocator,
+                                            rep_p->ptr(),
+                                            a1,
+                                            a2,
+                                            a3,
+                                            a4);
+    proctor.release();
+    return local_shared_ptr<ELEMENT_TYPE>(rep_p->ptr(), rep_p);
+}
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2, class A3,
+          class A4, class A5>
+typename bsl::enable_if<!bsl::is_pointer<ALLOC>::value,
+                        bsl::local_shared_ptr<ELEMENT_TYPE> >::type
+bsl::allocate_local_shared(ALLOC     basicAllocator,
+                           const A1& a1,
+                           const A2& a2,
+                           const A3& a3,
+                           const A4& a4,
+                           const A5& a5)
+{
+    typedef BloombergLP::bslstl::LocalSharedPtrAllocateInplaceRep<ELEMENT_TYPE,
+                                                                  ALLOC> Rep;
+    Rep *rep_p = Rep::makeRep(basicAllocator);
+    BloombergLP::bslstl::LocalSharedPtr_RepProctor proctor(rep_p);
+    bsl::allocator_traits<ALLOC>::construct(basicAllocator,
+                                            rep_p->ptr(),
+                                            a1,
+                                            a2,
+                                            a3,
+                                            a4,
+                                            a5);
+    proctor.release();
+    return local_shared_ptr<ELEMENT_TYPE>(rep_p->ptr(), rep_p);
+}
+
+template <class ELEMENT_TYPE, class ALLOC>
+inline
+bsl::local_shared_ptr<ELEMENT_TYPE>
+bsl::allocate_local_shared(ALLOC *basicAllocator)
+{
+    return allocate_local_shared<ELEMENT_TYPE>(
+                                 bsl::allocator<ELEMENT_TYPE>(basicAllocator));
+}
+
+template <class ELEMENT_TYPE, class ALLOC, class A1>
+inline
+bsl::local_shared_ptr<ELEMENT_TYPE>
+bsl::allocate_local_shared(ALLOC *basicAllocator, const A1& a1)
+{
+    return allocate_local_shared<ELEMENT_TYPE>(
+                                  bsl::allocator<ELEMENT_TYPE>(basicAllocator),
+                                  a1);
+}
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2>
+inline
+bsl::local_shared_ptr<ELEMENT_TYPE>
+bsl::allocate_local_shared(ALLOC     *basicAllocator,
+                           const A1&  a1,
+                           const A2&  a2)
+{
+    return allocate_local_shared<ELEMENT_TYPE>(
+                                  bsl::allocator<ELEMENT_TYPE>(basicAllocator),
+                                  a1,
+                                  a2);
+}
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2, class A3>
+inline
+bsl::local_shared_ptr<ELEMENT_TYPE>
+bsl::allocate_local_shared(ALLOC     *basicAllocator,
+                           const A1&  a1,
+                           const A2&  a2,
+                           const A3&  a3)
+{
+    return allocate_local_shared<ELEMENT_TYPE>(
+                                  bsl::allocator<ELEMENT_TYPE>(basicAllocator),
+                                  a1,
+                                  a2,
+                                  a3);
+}
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2, class A3,
+          class A4>
+inline
+bsl::local_shared_ptr<ELEMENT_TYPE>
+bsl::allocate_local_shared(ALLOC     *basicAllocator,
+                           const A1&  a1,
+                           const A2&  a2,
+                           const A3&  a3,
+                           const A4&  a4)
+{
+    return allocate_local_shared<ELEMENT_TYPE>(
+                                  bsl::allocator<ELEMENT_TYPE>(basicAllocator),
+                                  a1,
+                                  a2,
+                                  a3,
+                                  a4);
+}
+
+template <class ELEMENT_TYPE, class ALLOC, class A1, class A2, class A3,
+          class A4, class A5>
+inline
+bsl::local_shared_ptr<ELEMENT_TYPE>
+bsl::allocate_local_shared(ALLOC     *basicAllocator,
+                           const A1&  a1,
+                           const A2&  a2,
+                           const A3&  a3,
+                           const A4&  a4,
+                           const A5&  a5)
+{
+    return allocate_local_shared<ELEMENT_TYPE>(
+                                  bsl::allocator<ELEMENT_TYPE>(basicAllocator),
+                                  a1,
+                                  a2,
+                                  a3,
+                                  a4,
+                                  a5);
+}
+
+template <class ELEMENT_TYPE>
+inline
+bsl::local_shared_ptr<ELEMENT_TYPE> bsl::make_local_shared()
+{
+    return allocate_local_shared<ELEMENT_TYPE>(bsl::allocator<ELEMENT_TYPE>());
+}
+
+template <class ELEMENT_TYPE, class A1>
+inline
+bsl::local_shared_ptr<ELEMENT_TYPE> bsl::make_local_shared(const A1& a1)
+{
+    return allocate_local_shared<ELEMENT_TYPE>(bsl::allocator<ELEMENT_TYPE>(),
+                                               a1);
+}
+
+template <class ELEMENT_TYPE, class A1, class A2>
+inline
+bsl::local_shared_ptr<ELEMENT_TYPE> bsl::make_local_shared(const A1& a1,
+                                                           const A2& a2)
+{
+    return allocate_local_shared<ELEMENT_TYPE>(bsl::allocator<ELEMENT_TYPE>(),
+                                               a1,
+                                               a2);
+}
+
+template <class ELEMENT_TYPE, class A1, class A2, class A3>
+inline
+bsl::local_shared_ptr<ELEMENT_TYPE> bsl::make_local_shared(const A1& a1,
+                                                           const A2& a2,
+                                                           const A3& a3)
+{
+    return allocate_local_shared<ELEMENT_TYPE>(bsl::allocator<ELEMENT_TYPE>(),
+                                               a1,
+                                               a2,
+                                               a3);
+}
+
+template <class ELEMENT_TYPE, class A1, class A2, class A3, class A4>
+inline
+bsl::local_shared_ptr<ELEMENT_TYPE> bsl::make_local_shared(const A1& a1,
+                                                           const A2& a2,
+                                                           const A3& a3,
+                                                           const A4& a4)
+{
+    return allocate_local_shared<ELEMENT_TYPE>(bsl::allocator<ELEMENT_TYPE>(),
+                                               a1,
+                                               a2,
+                                               a3,
+                                               a4);
+}
+
+template <class ELEMENT_TYPE, class A1, class A2, class A3, class A4,
+          class A5>
+inline
+bsl::local_shared_ptr<ELEMENT_TYPE> bsl::make_local_shared(const A1& a1,
+                                                           const A2& a2,
+                                                           const A3& a3,
+                                                           const A4& a4,
+                                                           const A5& a5)
+{
+    return allocate_local_shared<ELEMENT_TYPE>(bsl::allocator<ELEMENT_TYPE>(),
+                                               a1,
+                                               a2,
+                                               a3,
+                                               a4,
+                                               a5);
+}
+#endif
+
+// ============================================================================
+//                              TYPE TRAITS
+// ============================================================================
+
+namespace BloombergLP {
+
+namespace bslma {
+
+template <class ELEMENT_TYPE>
+struct UsesBslmaAllocator< ::bsl::local_shared_ptr<ELEMENT_TYPE> >
+    : bsl::false_type
+{};
+
+}  // close namespace bslma
+
+namespace bslmf {
+
+template <class ELEMENT_TYPE>
+struct HasPointerSemantics< ::bsl::local_shared_ptr<ELEMENT_TYPE> >
+    : bsl::true_type
+{};
+
+template <class ELEMENT_TYPE>
+struct IsBitwiseMoveable< ::bsl::local_shared_ptr<ELEMENT_TYPE> >
+    : bsl::true_type
+{};
+
+}  // close namespace bslmf
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1168 @@
+// bslstl_localsharedptr.t.cpp                                        -*-C++-*-
+#include <bslstl_localsharedptr.h>
+
+#include <bslstl_allocator.h>
+#include <bslstl_sharedptr.h>
+
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bsls_bsltestutil.h>
+
+#include <bsltf_alloctesttype.h>
+
+#include <stdio.h>
+#include <stdlib.h>             // 'atoi'
+
+#ifdef BSLS_PLATFORM_CMP_MSVC  // Microsoft Compiler
+#ifdef _MSC_EXTENSIONS         // Microsoft Extensions Enabled
+#include <new>                 // if so, need to include new as well
+#endif
+#endif
+
+using namespace BloombergLP;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// 'bsl::local_shared_ptr' is a shared pointer whose local references are
+// counted without atomic operations.  The representation objects it uses are
+// tested in their own components; here we verify that each constructor,
+// manipulator, and accessor maintains the correct local and shared reference
+// counts, that managed objects are destroyed using the right deleter exactly
+// once, that conversion to 'bsl::shared_ptr' keeps the object alive
+// independently of the local references, and that the factory functions use a
+// single allocation from the correct allocator and are exception-neutral.
+//
+// Further, there are conversions that explicitly should not compile, for which
+// we provide tests that fail to compile if the corresponding macro is defined.
+// Each test provides a commented-out definition of its macro immediately above
+// it.  Below is the list of all macros that control the availability of these
+// tests:
+//  #define BSLSTL_LOCALSHAREDPTR_COMPILE_FAIL_CONVERT_TO_DERIVED
+//  #define BSLSTL_LOCALSHAREDPTR_COMPILE_FAIL_CONVERT_FROM_VOID
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] local_shared_ptr();
+// [ 2] local_shared_ptr(bsl::nullptr_t);
+// [ 2] local_shared_ptr(COMPATIBLE_TYPE *ptr);
+// [ 3] local_shared_ptr(COMPATIBLE_TYPE *ptr, const DELETER& deleter);
+// [ 3] local_shared_ptr(COMPATIBLE_TYPE *, const DELETER&, Allocator *);
+// [ 8] local_shared_ptr(ELEMENT_TYPE *ptr, LocalSharedPtrRep *rep);
+// [ 4] local_shared_ptr(const local_shared_ptr<ANY>& src, ELEMENT_TYPE *obj);
+// [ 4] local_shared_ptr(const local_shared_ptr& original);
+// [ 4] local_shared_ptr(const local_shared_ptr<COMPATIBLE_TYPE>& other);
+// [ 2] ~local_shared_ptr();
+//
+// MANIPULATORS
+// [ 4] local_shared_ptr& operator=(const local_shared_ptr& rhs);
+// [ 4] local_shared_ptr& operator=(const local_shared_ptr<COMPATIBLE>& rhs);
+// [ 5] void reset();
+// [ 5] void reset(COMPATIBLE_TYPE *ptr);
+// [ 5] void reset(COMPATIBLE_TYPE *ptr, const DELETER& deleter);
+// [ 5] void reset(const local_shared_ptr<ANY_TYPE>& source, ELEMENT_TYPE *);
+// [ 4] void swap(local_shared_ptr& other);
+//
+// ACCESSORS
+// [ 2] operator BoolType() const;
+// [ 6] operator shared_ptr<COMPATIBLE_TYPE>() const;
+// [ 2] add_lvalue_reference<ELEMENT_TYPE>::type operator*() const;
+// [ 2] ELEMENT_TYPE *operator->() const;
+// [ 2] ELEMENT_TYPE *get() const;
+// [ 2] long local_use_count() const;
+// [ 6] bool owner_before(const local_shared_ptr<ANY_TYPE>& other) const;
+// [ 6] bool owner_before(const shared_ptr<ANY_TYPE>& other) const;
+// [ 2] LocalSharedPtrRep *rep() const;
+// [ 2] bool unique() const;
+// [ 2] long use_count() const;
+//
+// FREE OPERATORS
+// [ 7] bool operator==(const local_shared_ptr<L>&, const local_shared_ptr<R>&);
+// [ 7] bool operator!=(const local_shared_ptr<L>&, const local_shared_ptr<R>&);
+// [ 7] bool operator<(const local_shared_ptr<L>&, const local_shared_ptr<R>&);
+// [ 7] bool operator==(const local_shared_ptr<L>&, nullptr_t);
+// [ 7] bool operator==(nullptr_t, const local_shared_ptr<R>&);
+// [ 7] bool operator!=(const local_shared_ptr<L>&, nullptr_t);
+// [ 7] bool operator!=(nullptr_t, const local_shared_ptr<R>&);
+//
+// FREE FUNCTIONS
+// [ 4] void swap(local_shared_ptr<ELEMENT_TYPE>&, local_shared_ptr<...>&);
+// [ 7] local_shared_ptr<TO> const_pointer_cast(const local_shared_ptr<FROM>&);
+// [ 7] local_shared_ptr<TO> dynamic_pointer_cast(const local_shared_ptr<F>&);
+// [ 7] local_shared_ptr<TO> static_pointer_cast(const local_shared_ptr<F>&);
+//
+// FACTORY FUNCTIONS
+// [ 8] local_shared_ptr<T> allocate_local_shared(ALLOC, ARGS&&...);
+// [ 8] local_shared_ptr<T> allocate_local_shared(ALLOC *, ARGS&&...);
+// [ 8] local_shared_ptr<T> make_local_shared(ARGS&&...);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 9] USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACROS
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                     STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+#define ASSERT_SAFE_PASS_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS_RAW(EXPR)
+#define ASSERT_SAFE_FAIL_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL_RAW(EXPR)
+#define ASSERT_PASS_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS_RAW(EXPR)
+#define ASSERT_FAIL_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL_RAW(EXPR)
+#define ASSERT_OPT_PASS_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS_RAW(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bsl::local_shared_ptr<int> Obj;
+
+//=============================================================================
+//             GLOBAL HELPER CLASSES AND FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+                            // ================
+                            // class MyTestBase
+                            // ================
+
+class MyTestBase {
+    // This class provides a polymorphic base class that records its
+    // destruction in a counter supplied at construction.
+
+    // DATA
+    int *d_numDestroyed_p;  // destruction counter (held, not owned)
+
+  public:
+    // CREATORS
+    explicit MyTestBase(int *numDestroyed)
+    : d_numDestroyed_p(numDestroyed)
+    {
+    }
+
+    virtual ~MyTestBase()
+    {
+        ++*d_numDestroyed_p;
+    }
+};
+
+                           // ===================
+                           // class MyTestDerived
+                           // ===================
+
+class MyTestDerived : public MyTestBase {
+    // This class provides a type derived from 'MyTestBase' having a value.
+
+    // DATA
+    int d_value;
+
+  public:
+    // CREATORS
+    MyTestDerived(int *numDestroyed, int value)
+    : MyTestBase(numDestroyed)
+    , d_value(value)
+    {
+    }
+
+    // ACCESSORS
+    int value() const
+    {
+        return d_value;
+    }
+};
+
+                         // ========================
+                         // class MyTestMultiDerived
+                         // ========================
+
+struct MyTestTag {
+    // This 'struct' provides a polymorphic base class preceding 'MyTestBase'
+    // in 'MyTestMultiDerived', so that the 'MyTestBase' subobject is not at
+    // the address of the derived object.
+
+    int d_tag;
+
+    virtual ~MyTestTag()
+    {
+    }
+};
+
+class MyTestMultiDerived : public MyTestTag, public MyTestBase {
+    // This class provides a type derived from 'MyTestBase' whose conversion
+    // to 'MyTestBase *' adjusts the address.
+
+  public:
+    // CREATORS
+    explicit MyTestMultiDerived(int *numDestroyed)
+    : MyTestBase(numDestroyed)
+    {
+        d_tag = 0;
+    }
+};
+
+                            // ===============
+                            // class MyDeleter
+                            // ===============
+
+class MyDeleter {
+    // This class provides a function-like deleter that counts the number of
+    // times it is invoked.
+
+    // DATA
+    int *d_numCalls_p;  // invocation counter (held, not owned)
+
+  public:
+    // CREATORS
+    explicit MyDeleter(int *numCalls)
+    : d_numCalls_p(numCalls)
+    {
+    }
+
+    // ACCESSORS
+    template <class TYPE>
+    void operator()(TYPE *ptr) const
+    {
+        ++*d_numCalls_p;
+        delete ptr;
+    }
+};
+
+                          // ====================
+                          // class MyThrowingType
+                          // ====================
+
+class MyThrowingType {
+    // This class provides a type whose value constructor throws if the value
+    // is negative.
+
+    // DATA
+    int d_value;
+
+  public:
+    // CREATORS
+    explicit MyThrowingType(int value)
+    : d_value(value)
+    {
+        if (value < 0) {
+            BSLS_THROW(value);
+        }
+    }
+};
+
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+    bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVerbose;
+    (void)veryVeryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    // Confirm no static intialization locked the global allocator
+    ASSERT(&globalAllocator == bslma::Default::globalAllocator());
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    // Confirm no static intialization locked the default allocator
+    ASSERT(&defaultAllocator == bslma::Default::defaultAllocator());
+
+    bslma::TestAllocator ta;
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 9: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+///Example 1: Sharing an Object Within a Single Thread
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we have an event loop, confined to a single thread, that shares
+// request objects among a number of handlers.  First, we create a request
+// using 'allocate_local_shared', supplying an allocator that provides memory
+// for both the request and its representation:
+//..
+    bslma::TestAllocator ta;
+
+    bsl::local_shared_ptr<int> request = bsl::allocate_local_shared<int>(&ta,
+                                                                         17);
+    ASSERT(17 == *request);
+    ASSERT( 1 == request.use_count());
+    ASSERT( 1 == ta.numBlocksInUse());
+//..
+// Then, we make a number of copies, for example by storing the request into
+// the handlers.  Note that no atomic operation is performed:
+//..
+    {
+        bsl::local_shared_ptr<int> handler1(request);
+        bsl::local_shared_ptr<int> handler2(request);
+        ASSERT(3 == request.use_count());
+    }
+    ASSERT(1 == request.use_count());
+//..
+// Next, one of the handlers needs to hand the request to a worker thread.  It
+// converts the 'local_shared_ptr' to a (thread-safe) 'bsl::shared_ptr':
+//..
+    bsl::shared_ptr<int> forWorker = request;
+    ASSERT(2  == request.use_count());
+    ASSERT(17 == *forWorker);
+//..
+// Finally, we release the local reference.  The request stays alive until the
+// worker thread releases its 'bsl::shared_ptr':
+//..
+    request.reset();
+    ASSERT(1 == forWorker.use_count());
+    ASSERT(1 == ta.numBlocksInUse());
+
+    forWorker.reset();
+    ASSERT(0 == ta.numBlocksInUse());
+//..
+      } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // TESTING FACTORY FUNCTIONS
+        //
+        // Concerns:
+        //: 1 'allocate_local_shared' obtains exactly one block of memory from
+        //:   the supplied allocator (or allocator pointer), and
+        //:   'make_local_shared' one block from the default allocator.
+        //:
+        //: 2 The arguments are forwarded to the constructor of the object.
+        //:
+        //: 3 An object that uses 'bslma' allocators is supplied the allocator
+        //:   passed to the factory function.
+        //:
+        //: 4 If the constructor of the object throws, no memory is leaked.
+        //:
+        //: 5 The adopting constructor takes over the local reference of the
+        //:   representation without acquiring another one.
+        //
+        // Plan:
+        //: 1 Create objects using each factory function and verify the value
+        //:   of the object and the allocator usage.  (C-1..3, 5)
+        //:
+        //: 2 Create an object whose constructor throws and verify that all
+        //:   memory is returned.  (C-4)
+        //
+        // Testing:
+        //   local_shared_ptr(ELEMENT_TYPE *ptr, LocalSharedPtrRep *rep);
+        //   local_shared_ptr<T> allocate_local_shared(ALLOC, ARGS&&...);
+        //   local_shared_ptr<T> allocate_local_shared(ALLOC *, ARGS&&...);
+        //   local_shared_ptr<T> make_local_shared(ARGS&&...);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING FACTORY FUNCTIONS"
+                            "\n=========================\n");
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+        if (verbose) printf("\nAllocator object.\n");
+        {
+            Obj mX = bsl::allocate_local_shared<int>(bsl::allocator<int>(&ta),
+                                                     5);
+            const Obj& X = mX;
+
+            ASSERT(5 == *X);
+            ASSERT(1 == X.use_count());
+            ASSERT(1 == X.local_use_count());
+            ASSERT(1 == ta.numBlocksInUse());
+            ASSERT(X.get() == X.rep()->originalPtr());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) printf("\nAllocator pointer and 'bslma' type.\n");
+        {
+            typedef bsl::local_shared_ptr<bsltf::AllocTestType> TObj;
+
+            TObj mX = bsl::allocate_local_shared<bsltf::AllocTestType>(&ta,
+                                                                        7);
+            const TObj& X = mX;
+
+            ASSERT(7   == X->data());
+            ASSERT(&ta == X->allocator());
+            ASSERT(2   == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) printf("\nDefault allocator.\n");
+        {
+            int numDestroyed = 0;
+
+            bsl::local_shared_ptr<MyTestDerived> mX =
+                      bsl::make_local_shared<MyTestDerived>(&numDestroyed, 3);
+
+            ASSERT(3 == mX->value());
+            ASSERT(1 == defaultAllocator.numBlocksInUse());
+
+            mX.reset();
+            ASSERT(1 == numDestroyed);
+            ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+            Obj mY = bsl::make_local_shared<int>();
+            ASSERT(0 == *mY);
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        if (verbose) printf("\nException neutrality.\n");
+        {
+#ifdef BDE_BUILD_TARGET_EXC
+            bool caught = false;
+            try {
+                bsl::allocate_local_shared<MyThrowingType>(&ta, -1);
+            }
+            catch (int value) {
+                ASSERT(-1 == value);
+                caught = true;
+            }
+            ASSERT(caught);
+            ASSERT(0 == ta.numBlocksInUse());
+#endif
+        }
+
+        if (verbose) printf("\nAllocation failure.\n");
+        {
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(ta) {
+                Obj mX = bsl::allocate_local_shared<int>(&ta, 9);
+                ASSERT(9 == *mX);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // TESTING COMPARISONS AND POINTER CASTS
+        //
+        // Concerns:
+        //: 1 Equality compares the referred-to addresses, not the owners.
+        //:
+        //: 2 'operator<' orders by the referred-to addresses.
+        //:
+        //: 3 Comparison with 'nullptr' tests for emptiness.
+        //:
+        //: 4 The pointer casts share ownership with their source, and a
+        //:   failing 'dynamic_pointer_cast' yields an empty pointer.
+        //
+        // Plan:
+        //: 1 Compare empty, owning, and aliasing local shared pointers.
+        //:   (C-1..3)
+        //:
+        //: 2 Cast between a base and a derived type and verify the reference
+        //:   counts and addresses.  (C-4)
+        //
+        // Testing:
+        //   bool operator==(const lsp<L>&, const lsp<R>&);
+        //   bool operator!=(const lsp<L>&, const lsp<R>&);
+        //   bool operator<(const lsp<L>&, const lsp<R>&);
+        //   bool operator==(const lsp<L>&, nullptr_t);
+        //   bool operator==(nullptr_t, const lsp<R>&);
+        //   bool operator!=(const lsp<L>&, nullptr_t);
+        //   bool operator!=(nullptr_t, const lsp<R>&);
+        //   local_shared_ptr<TO> const_pointer_cast(const lsp<FROM>&);
+        //   local_shared_ptr<TO> dynamic_pointer_cast(const lsp<FROM>&);
+        //   local_shared_ptr<TO> static_pointer_cast(const lsp<FROM>&);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING COMPARISONS AND POINTER CASTS"
+                            "\n=====================================\n");
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+        if (verbose) printf("\nComparisons.\n");
+        {
+            int values[2] = { 1, 2 };
+
+            Obj mA = bsl::allocate_local_shared<int>(&ta, 1);
+            Obj mB(mA, values);
+            Obj mC(mA, values + 1);
+            Obj mE;
+
+            const Obj& A = mA; const Obj& B = mB; const Obj& C = mC;
+            const Obj& E = mE;
+
+            ASSERT(  A == A );
+            ASSERT(!(A == B));
+            ASSERT(  A != B );
+            ASSERT(!(B != B));
+            ASSERT(  B <  C );
+            ASSERT(!(C <  B));
+            ASSERT(!(B <  B));
+
+            ASSERT(  E == 0 );
+            ASSERT(  0 == E );
+            ASSERT(!(E != 0));
+            ASSERT(!(0 != E));
+            ASSERT(!(A == 0));
+            ASSERT(!(0 == A));
+            ASSERT(  A != 0 );
+            ASSERT(  0 != A );
+
+            const bsl::local_shared_ptr<const int> CA(A);
+            ASSERT(CA == A);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) printf("\nPointer casts.\n");
+        {
+            int numDestroyed = 0;
+
+            bsl::local_shared_ptr<MyTestBase> mB =
+                    bsl::allocate_local_shared<MyTestDerived>(&ta,
+                                                              &numDestroyed,
+                                                              11);
+
+            bsl::local_shared_ptr<MyTestDerived> mD =
+                             bsl::static_pointer_cast<MyTestDerived>(mB);
+            ASSERT(mD.get() == mB.get());
+            ASSERT(11       == mD->value());
+            ASSERT(2        == mB.use_count());
+
+            bsl::local_shared_ptr<MyTestDerived> mDD =
+                             bsl::dynamic_pointer_cast<MyTestDerived>(mB);
+            ASSERT(mDD.get() == mB.get());
+            ASSERT(3         == mB.use_count());
+
+            bsl::local_shared_ptr<const MyTestDerived> mCD(mD);
+            bsl::local_shared_ptr<MyTestDerived>       mNC =
+                              bsl::const_pointer_cast<MyTestDerived>(mCD);
+            ASSERT(mNC.get() == mD.get());
+            ASSERT(5         == mB.use_count());
+
+            int otherDestroyed = 0;
+            bsl::local_shared_ptr<MyTestBase> mOther =
+                         bsl::allocate_local_shared<MyTestBase>(&ta,
+                                                                &otherDestroyed);
+
+            bsl::local_shared_ptr<MyTestDerived> mFail =
+                          bsl::dynamic_pointer_cast<MyTestDerived>(mOther);
+            ASSERT(!mFail);
+            ASSERT(0 == mFail.use_count());
+            ASSERT(1 == mOther.use_count());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING CONVERSION TO 'shared_ptr'
+        //
+        // Concerns:
+        //: 1 Converting an empty local shared pointer yields an empty
+        //:   'shared_ptr'.
+        //:
+        //: 2 Conversion acquires one shared reference, and does not change the
+        //:   number of local references.
+        //:
+        //: 3 The object stays alive while either the local or the shared
+        //:   pointers remain, whichever is released last.
+        //:
+        //: 4 A 'weak_ptr' obtained from the converted 'shared_ptr' expires
+        //:   when the last reference of either kind is released.
+        //:
+        //: 5 'owner_before' orders by representation, consistently for local
+        //:   and non-local shared pointers sharing ownership.
+        //:
+        //: 6 Converting to a 'shared_ptr' to a base class converts the
+        //:   pointer, including when the conversion adjusts the address.
+        //:
+        //: 7 Converting to a 'shared_ptr' to a derived class, or from a
+        //:   'local_shared_ptr<void>', fails to compile.
+        //
+        // Plan:
+        //: 1 Convert local shared pointers, release local and shared
+        //:   references in both orders, and check counts, object lifetime,
+        //:   and the state of a 'weak_ptr'.  (C-1..4)
+        //:
+        //: 2 Compare the owners of aliasing and unrelated pointers.  (C-5)
+        //:
+        //: 3 Convert a local shared pointer to an object of a class having
+        //:   'MyTestBase' as its second base class to a 'shared_ptr' to
+        //:   'MyTestBase', and verify the address held.  (C-6)
+        //:
+        //: 4 Provide conversions to a 'shared_ptr' to a derived class and from
+        //:   a 'local_shared_ptr<void>', compiled only if the corresponding
+        //:   'COMPILE_FAIL' macro is defined.  (C-7)
+        //
+        // Testing:
+        //   operator shared_ptr<COMPATIBLE_TYPE>() const;
+        //   bool owner_before(const local_shared_ptr<ANY_TYPE>& other) const;
+        //   bool owner_before(const shared_ptr<ANY_TYPE>& other) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING CONVERSION TO 'shared_ptr'"
+                            "\n==================================\n");
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+        if (verbose) printf("\nEmpty pointer.\n");
+        {
+            const Obj X;
+
+            bsl::shared_ptr<int> mS = X;
+            ASSERT(!mS);
+            ASSERT(0 == mS.use_count());
+        }
+
+        if (verbose) printf("\nLocal references released first.\n");
+        {
+            int numDestroyed = 0;
+
+            bsl::local_shared_ptr<MyTestDerived> mX =
+                    bsl::allocate_local_shared<MyTestDerived>(&ta,
+                                                              &numDestroyed,
+                                                              1);
+            bsl::local_shared_ptr<MyTestDerived> mY(mX);
+
+            bsl::shared_ptr<MyTestBase> mS = mX;
+            ASSERT(mS.get() == mX.get());
+            ASSERT(2        == mX.local_use_count());
+            ASSERT(3        == mX.use_count());
+            ASSERT(2        == mS.use_count());
+            ASSERT(!mX.unique());
+
+            bsl::weak_ptr<MyTestBase> mW(mS);
+
+            mX.reset();
+            mY.reset();
+            ASSERT(0 == numDestroyed);
+            ASSERT(1 == mS.use_count());
+            ASSERT(!mW.expired());
+
+            mS.reset();
+            ASSERT(1 == numDestroyed);
+            ASSERT(mW.expired());
+            ASSERT(1 == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) printf("\nShared reference released first.\n");
+        {
+            int numDestroyed = 0;
+
+            bsl::local_shared_ptr<MyTestBase> mX(
+                                   new (ta) MyTestDerived(&numDestroyed, 2),
+                                   &ta);
+            ASSERT(2 == ta.numBlocksInUse());
+            {
+                bsl::shared_ptr<MyTestBase> mS(mX);
+                ASSERT(2 == mX.use_count());
+            }
+            ASSERT(0 == numDestroyed);
+            ASSERT(1 == mX.use_count());
+            ASSERT(mX.unique());
+
+            mX.reset();
+            ASSERT(1 == numDestroyed);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) printf("\nDerived to base conversion.\n");
+        {
+            int numDestroyed = 0;
+
+            typedef MyTestMultiDerived Multi;
+
+            bsl::local_shared_ptr<Multi> mX =
+                        bsl::allocate_local_shared<Multi>(&ta, &numDestroyed);
+
+            MyTestBase *base = mX.get();
+            ASSERT(static_cast<void *>(base) != static_cast<void *>(mX.get()));
+
+            bsl::shared_ptr<MyTestBase> mS = mX;
+            ASSERT(base == mS.get());
+            ASSERT(2    == mX.use_count());
+
+            mX.reset();
+            ASSERT(0 == numDestroyed);
+
+            mS.reset();
+            ASSERT(1 == numDestroyed);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) printf("\nConversions that do not compile.\n");
+        {
+            int numDestroyed = 0;
+
+            typedef MyTestMultiDerived Multi;
+
+            bsl::local_shared_ptr<Multi> mX =
+                        bsl::allocate_local_shared<Multi>(&ta, &numDestroyed);
+
+            bsl::local_shared_ptr<MyTestBase> mB = mX;
+            bsl::local_shared_ptr<void>       mV = mX;
+
+            ASSERT(3 == mX.local_use_count());
+
+// #define BSLSTL_LOCALSHAREDPTR_COMPILE_FAIL_CONVERT_TO_DERIVED
+#if defined(BSLSTL_LOCALSHAREDPTR_COMPILE_FAIL_CONVERT_TO_DERIVED)
+            bsl::shared_ptr<Multi> mD = mB;
+#endif
+
+// #define BSLSTL_LOCALSHAREDPTR_COMPILE_FAIL_CONVERT_FROM_VOID
+#if defined(BSLSTL_LOCALSHAREDPTR_COMPILE_FAIL_CONVERT_FROM_VOID)
+            bsl::shared_ptr<double> mW = mV;
+#endif
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) printf("\n'owner_before'.\n");
+        {
+            int value = 0;
+
+            Obj mA = bsl::allocate_local_shared<int>(&ta, 1);
+            Obj mB = bsl::allocate_local_shared<int>(&ta, 2);
+            Obj mAA(mA, &value);
+
+            bsl::shared_ptr<int> mSA = mA;
+
+            ASSERT(!mA.owner_before(mAA));
+            ASSERT(!mAA.owner_before(mA));
+            ASSERT(!mA.owner_before(mSA));
+            ASSERT(!mSA.owner_before(bsl::shared_ptr<int>(mAA)));
+            ASSERT(mA.owner_before(mB) != mB.owner_before(mA));
+            ASSERT(mA.owner_before(mB) == mSA.owner_before(
+                                                   bsl::shared_ptr<int>(mB)));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'reset'
+        //
+        // Concerns:
+        //: 1 'reset()' releases the current reference and leaves the pointer
+        //:   empty.
+        //:
+        //: 2 'reset' with a pointer (and optional deleter) releases the
+        //:   current reference and takes ownership of the new object.
+        //:
+        //: 3 'reset' with a source and a pointer makes an alias.
+        //
+        // Plan:
+        //: 1 Call each 'reset' overload and verify the reference counts and
+        //:   the destruction of the objects.  (C-1..3)
+        //
+        // Testing:
+        //   void reset();
+        //   void reset(COMPATIBLE_TYPE *ptr);
+        //   void reset(COMPATIBLE_TYPE *ptr, const DELETER& deleter);
+        //   void reset(const local_shared_ptr<ANY_TYPE>&, ELEMENT_TYPE *);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'reset'"
+                            "\n===============\n");
+
+        int numDestroyed = 0;
+        int numCalls     = 0;
+
+        bsl::local_shared_ptr<MyTestBase> mX;
+
+        mX.reset(new MyTestDerived(&numDestroyed, 1));
+        ASSERT(mX);
+        ASSERT(1 == mX.use_count());
+        ASSERT(1 == defaultAllocator.numBlocksInUse());
+
+        mX.reset(new MyTestDerived(&numDestroyed, 2), MyDeleter(&numCalls));
+        ASSERT(1 == numDestroyed);
+        ASSERT(0 == numCalls);
+        ASSERT(1 == mX.use_count());
+
+        int                        value = 7;
+        bsl::local_shared_ptr<int> mY;
+        mY.reset(mX, &value);
+        ASSERT(&value == mY.get());
+        ASSERT(2      == mX.use_count());
+
+        mX.reset();
+        ASSERT(!mX);
+        ASSERT(0 == mX.use_count());
+        ASSERT(0 == numCalls);
+
+        mY.reset();
+        ASSERT(1 == numCalls);
+        ASSERT(2 == numDestroyed);
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING COPYING, ALIASING, ASSIGNMENT, AND SWAP
+        //
+        // Concerns:
+        //: 1 Copying (including from a compatible type) acquires a local
+        //:   reference without acquiring a shared reference.
+        //:
+        //: 2 An alias shares ownership while referring to another object.
+        //:
+        //: 3 Assignment releases the previous object and acquires a reference
+        //:   to the new one; self-assignment is safe.
+        //:
+        //: 4 'swap' exchanges the pointers and ownership without changing any
+        //:   reference count.
+        //
+        // Plan:
+        //: 1 Copy, alias, assign, and swap local shared pointers, verifying
+        //:   the local and shared counts after each operation.  (C-1..4)
+        //
+        // Testing:
+        //   local_shared_ptr(const local_shared_ptr<ANY>&, ELEMENT_TYPE *);
+        //   local_shared_ptr(const local_shared_ptr& original);
+        //   local_shared_ptr(const local_shared_ptr<COMPATIBLE_TYPE>& other);
+        //   local_shared_ptr& operator=(const local_shared_ptr& rhs);
+        //   local_shared_ptr& operator=(const local_shared_ptr<COMPAT>& rhs);
+        //   void swap(local_shared_ptr& other);
+        //   void swap(local_shared_ptr<ELEMENT_TYPE>&, local_shared_ptr<>&);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING COPYING, ALIASING, ASSIGNMENT, AND SWAP"
+                            "\n==============================================="
+                            "\n");
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+        int numDestroyed = 0;
+        {
+            bsl::local_shared_ptr<MyTestDerived> mD =
+                    bsl::allocate_local_shared<MyTestDerived>(&ta,
+                                                              &numDestroyed,
+                                                              4);
+            const bsl::local_shared_ptr<MyTestDerived>& D = mD;
+
+            bsl::local_shared_ptr<MyTestDerived> mC(D);
+            ASSERT(mC.get() == D.get());
+            ASSERT(2        == D.local_use_count());
+            ASSERT(1        == D.rep()->numReferences());
+
+            bsl::local_shared_ptr<MyTestBase> mB(D);
+            ASSERT(mB.get() == D.get());
+            ASSERT(3        == D.use_count());
+
+            int                        value = 5;
+            bsl::local_shared_ptr<int> mA(D, &value);
+            ASSERT(&value == mA.get());
+            ASSERT(4      == D.use_count());
+            ASSERT(mA.rep() == D.rep());
+
+            bsl::local_shared_ptr<MyTestBase> mE;
+            mE = D;
+            ASSERT(5 == D.use_count());
+
+            mE = mE;
+            ASSERT(5 == D.use_count());
+
+            mC = mC;
+            ASSERT(5 == D.use_count());
+
+            Obj mF = bsl::allocate_local_shared<int>(&ta, 6);
+            mA = mF;
+            ASSERT(6 == *mA);
+            ASSERT(4 == D.use_count());
+            ASSERT(2 == mF.use_count());
+
+            mA.swap(mF);
+            ASSERT(6 == *mA);
+            ASSERT(6 == *mF);
+            ASSERT(2 == mF.use_count());
+
+            Obj mG;
+            bsl::swap(mG, mF);
+            ASSERT(!mF);
+            ASSERT(6 == *mG);
+            ASSERT(2 == mG.use_count());
+            ASSERT(0 == numDestroyed);
+        }
+        ASSERT(1 == numDestroyed);
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING DELETER CONSTRUCTORS
+        //
+        // Concerns:
+        //: 1 A functor deleter is invoked exactly once, when the last reference
+        //:   is released, and the representation is allocated from the
+        //:   default allocator.
+        //:
+        //: 2 An allocator deleter is used both to delete the object and to
+        //:   supply memory for the representation.
+        //:
+        //: 3 A deleter and an explicit allocator may be supplied together.
+        //
+        // Plan:
+        //: 1 Create local shared pointers with each kind of deleter and verify
+        //:   the deleter invocations and allocator usage.  (C-1..3)
+        //
+        // Testing:
+        //   local_shared_ptr(COMPATIBLE_TYPE *ptr, const DELETER& deleter);
+        //   local_shared_ptr(COMPATIBLE_TYPE *, const DELETER&, Allocator *);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING DELETER CONSTRUCTORS"
+                            "\n============================\n");
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+        if (verbose) printf("\nFunctor deleter.\n");
+        {
+            int numCalls = 0;
+            {
+                Obj mX(new int(1), MyDeleter(&numCalls));
+                ASSERT(1 == defaultAllocator.numBlocksInUse());
+                ASSERT(1 == mX.use_count());
+
+                Obj mY(mX);
+                ASSERT(0 == numCalls);
+            }
+            ASSERT(1 == numCalls);
+            ASSERT(0 == defaultAllocator.numBlocksInUse());
+        }
+
+        if (verbose) printf("\nAllocator deleter.\n");
+        {
+            {
+                Obj mX(new (ta) int(2), &ta);
+                ASSERT(2 == *mX);
+                ASSERT(2 == ta.numBlocksInUse());
+                ASSERT(0 == defaultAllocator.numBlocksInUse());
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) printf("\nDeleter and allocator.\n");
+        {
+            int numCalls = 0;
+            {
+                Obj mX(new int(3), MyDeleter(&numCalls), &ta);
+                ASSERT(1 == ta.numBlocksInUse());
+                ASSERT(0 == defaultAllocator.numBlocksInUse());
+            }
+            ASSERT(1 == numCalls);
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING PRIMARY CONSTRUCTORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 A default-constructed or 'nullptr'-constructed object is empty.
+        //:
+        //: 2 Constructing from a raw pointer takes ownership, allocates the
+        //:   representation from the default allocator, and deletes the
+        //:   object (through a pointer to the type it was created with) when
+        //:   the last reference is released.
+        //:
+        //: 3 The accessors report the referred-to object and reference
+        //:   counts.
+        //
+        // Plan:
+        //: 1 Create empty and owning local shared pointers and verify every
+        //:   accessor.  (C-1..3)
+        //
+        // Testing:
+        //   local_shared_ptr();
+        //   local_shared_ptr(bsl::nullptr_t);
+        //   local_shared_ptr(COMPATIBLE_TYPE *ptr);
+        //   ~local_shared_ptr();
+        //   operator BoolType() const;
+        //   add_lvalue_reference<ELEMENT_TYPE>::type operator*() const;
+        //   ELEMENT_TYPE *operator->() const;
+        //   ELEMENT_TYPE *get() const;
+        //   long local_use_count() const;
+        //   LocalSharedPtrRep *rep() const;
+        //   bool unique() const;
+        //   long use_count() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf(
+                         "\nTESTING PRIMARY CONSTRUCTORS AND BASIC ACCESSORS"
+                         "\n================================================"
+                         "\n");
+
+        if (verbose) printf("\nEmpty pointers.\n");
+        {
+            const Obj X;
+            const Obj Y(0);
+
+            ASSERT(!X);
+            ASSERT(0 == X.get());
+            ASSERT(0 == X.rep());
+            ASSERT(0 == X.use_count());
+            ASSERT(0 == X.local_use_count());
+            ASSERT(!X.unique());
+
+            ASSERT(!Y);
+            ASSERT(0 == Y.rep());
+        }
+
+        if (verbose) printf("\nOwning pointer.\n");
+        {
+            int numDestroyed = 0;
+            {
+                MyTestDerived *p = new MyTestDerived(&numDestroyed, 8);
+
+                const bsl::local_shared_ptr<MyTestDerived> X(p);
+
+                ASSERT(X);
+                ASSERT(p == X.get());
+                ASSERT(p == X.operator->());
+                ASSERT(8 == (*X).value());
+                ASSERT(0 != X.rep());
+                ASSERT(1 == X.use_count());
+                ASSERT(1 == X.local_use_count());
+                ASSERT(X.unique());
+                ASSERT(1 == defaultAllocator.numBlocksInUse());
+            }
+            ASSERT(1 == numDestroyed);
+            ASSERT(0 == defaultAllocator.numBlocksInUse());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a local shared pointer, make copies, convert to
+        //:   'shared_ptr', and verify that all memory is returned.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+        {
+            Obj mX = bsl::allocate_local_shared<int>(&ta, 42);
+            const Obj& X = mX;
+
+            ASSERT(42 == *X);
+            ASSERT(1  == X.use_count());
+
+            Obj mY(X);
+            ASSERT(2 == X.use_count());
+            ASSERT(2 == X.local_use_count());
+
+            bsl::shared_ptr<int> mS(X);
+            ASSERT(3  == X.use_count());
+            ASSERT(42 == *mS);
+
+            mY.reset();
+            ASSERT(2 == X.use_count());
+            ASSERT(1 == X.local_use_count());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
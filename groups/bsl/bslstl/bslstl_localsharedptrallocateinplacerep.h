@@ -0,0 +1,274 @@
+// bslstl_localsharedptrallocateinplacerep.h                          -*-C++-*-
+#ifndef INCLUDED_BSLSTL_LOCALSHAREDPTRALLOCATEINPLACEREP
+#define INCLUDED_BSLSTL_LOCALSHAREDPTRALLOCATEINPLACEREP
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id$ $CSID$")
+
+//@PURPOSE: Provide an in-place implementation of 'bslma::LocalSharedPtrRep'.
+//
+//@CLASSES:
+//  bslstl::LocalSharedPtrAllocateInplaceRep: in-place 'local_shared_ptr' rep
+//
+//@SEE_ALSO: bslma_localsharedptrrep, bslstl_sharedptrallocateinplacerep,
+//           bslstl_localsharedptr
+//
+//@DESCRIPTION: This component provides a class template,
+// 'LocalSharedPtrAllocateInplaceRep', providing a concrete implementation of
+// 'bslma::LocalSharedPtrRep' for managing objects of the parameterized 'TYPE'
+// that are stored in-place in the representation, and are allocated by an
+// allocator that satisfies the requirements of an Allocator type in the C++11
+// standard.  Thus, only one memory allocation is required to create both the
+// representation and the managed object.  When all references to the in-place
+// object are released, the destructor of 'TYPE' is invoked.  This component is
+// the single-threaded counterpart of 'bslstl_sharedptrallocateinplacerep', and
+// is used to implement 'bsl::allocate_local_shared'.
+//
+///Thread-Safety
+///-------------
+// 'bslstl::LocalSharedPtrAllocateInplaceRep' provides the thread-safety
+// guarantees of 'bslma::LocalSharedPtrRep': local references must be acquired
+// and released by a single thread, whereas shared and weak references obtained
+// from the base 'bslma::SharedPtrRep' may be released from any thread.  Note
+// that there is no thread safety guarantees for operations on the managed
+// object contained in 'bslstl::LocalSharedPtrAllocateInplaceRep'.
+//
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_ALLOCATORTRAITS
+#include <bslstl_allocatortraits.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_LOCALSHAREDPTRREP
+#include <bslma_localsharedptrrep.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_OBJECTBUFFER
+#include <bsls_objectbuffer.h>
+#endif
+
+#ifndef INCLUDED_TYPEINFO
+#include <typeinfo>
+#define INCLUDED_TYPEINFO
+#endif
+
+namespace BloombergLP {
+namespace bslstl {
+
+                // ======================================
+                // class LocalSharedPtrAllocateInplaceRep
+                // ======================================
+
+template <class TYPE, class ALLOCATOR>
+class LocalSharedPtrAllocateInplaceRep
+                               : public BloombergLP::bslma::LocalSharedPtrRep {
+    // This class provides a concrete implementation of the
+    // 'LocalSharedPtrRep' protocol for in-place instances of the (template
+    // parameter) 'TYPE'.  Upon destruction of this object, the destructor of
+    // 'TYPE' is invoked on the shared object.
+
+    // PRIVATE TYPES
+    typedef typename bsl::allocator_traits<ALLOCATOR>::
+                       template rebind_traits<LocalSharedPtrAllocateInplaceRep>
+                                                                 ReboundTraits;
+
+  public:
+    // PUBLIC TYPES
+    typedef typename ReboundTraits::allocator_type ReboundAllocator;
+
+  private:
+    // DATA
+    ReboundAllocator         d_allocator; // copy of this object's allocator
+    bsls::ObjectBuffer<TYPE> d_instance;  // in-place object buffer
+
+  private:
+    // NOT IMPLEMENTED
+    LocalSharedPtrAllocateInplaceRep(const LocalSharedPtrAllocateInplaceRep&);
+    LocalSharedPtrAllocateInplaceRep& operator=(
+                                      const LocalSharedPtrAllocateInplaceRep&);
+
+    // PRIVATE CREATORS
+    explicit LocalSharedPtrAllocateInplaceRep(
+                                       const ReboundAllocator& basicAllocator);
+        // Create a 'LocalSharedPtrAllocateInplaceRep' object having
+        // uninitialized storage for an in-place instance of the parameterized
+        // 'TYPE'.  Use the specified 'basicAllocator' to supply memory and,
+        // upon a call to 'disposeObject', to destroy the inplace object, and
+        // upon a call to 'disposeRep' to destroy the copy the allocator and
+        // reclaim storage for this object.
+
+    ~LocalSharedPtrAllocateInplaceRep();  // = delete
+        // The destructor for this object should never be called.  The
+        // in-place 'TYPE' object will be destroyed by a call to
+        // 'disposeObject' and the stored allocator for this object will be
+        // destroyed by a call to 'disposeRep', which will then reclaim the
+        // storage occupied by this object.
+
+  public:
+    // CLASS METHODS
+    static LocalSharedPtrAllocateInplaceRep *makeRep(
+                                              ReboundAllocator basicAllocator);
+        // Create a 'LocalSharedPtrAllocateInplaceRep' object having storage
+        // for an in-place uninitialized object of (template parameter) 'TYPE',
+        // and return its address.  Use the specified 'basicAllocator' to
+        // supply memory and, upon a call to 'disposeRep', to destroy this
+        // representation (and the in-place shared object).  Note that the
+        // function members 'ptr' and 'originalPtr' will return the address of
+        // an uninitialized object.  This object should be explicitly
+        // initialized by the caller, and it is undefined behavior to call
+        // 'disposeRep' until this object has been successfully constructed.
+
+    // MANIPULATORS
+    virtual void disposeObject();
+        // Destroy the object being referred to by this representation.  This
+        // method is automatically invoked by 'releaseRef' when the number of
+        // shared references reaches zero and should not be explicitly invoked
+        // otherwise.
+
+    virtual void disposeRep();
+        // Destroy this representation object and deallocate the associated
+        // memory.  This method is automatically invoked by 'releaseRef' and
+        // 'releaseWeakRef' when the number of weak references and the number
+        // of shared references both reach zero and should not be explicitly
+        // invoked otherwise.  The behavior is undefined unless 'disposeObject'
+        // has already been called for this representation.  Note that this
+        // method effectively serves as the representation object's destructor.
+
+    void *getDeleter(const std::type_info& type);
+        // Ignore the specified 'type' and return a null pointer.  Note that
+        // there is no facility for the user to supply a deleter for an
+        // in-place representation for a shared pointer.
+
+    TYPE *ptr();
+        // Return the address of the modifiable shared object to which this
+        // object refers.  Note that in order to return a pointer to a
+        // modifiable object, this function cannot be 'const' qualified as the
+        // referenced object is stored internally as a data member.
+
+    // ACCESSORS
+    virtual void *originalPtr() const;
+        // Return the (untyped) address of the modifiable shared object to
+        // which this object refers.
+};
+
+// ============================================================================
+//                           INLINE DEFINITIONS
+// ============================================================================
+
+                // --------------------------------------
+                // class LocalSharedPtrAllocateInplaceRep
+                // --------------------------------------
+
+// PRIVATE CREATORS
+template <class TYPE, class ALLOCATOR>
+inline
+LocalSharedPtrAllocateInplaceRep<TYPE, ALLOCATOR>::
+LocalSharedPtrAllocateInplaceRep(const ReboundAllocator& basicAllocator)
+: d_allocator(basicAllocator)
+// 'd_instance' is intentionally left uninitialized.
+{
+}
+
+template <class TYPE, class ALLOCATOR>
+LocalSharedPtrAllocateInplaceRep<TYPE, ALLOCATOR>::
+~LocalSharedPtrAllocateInplaceRep()
+{
+    BSLS_ASSERT_OPT(0);
+}
+
+// CLASS METHODS
+template <class TYPE, class ALLOCATOR>
+inline
+LocalSharedPtrAllocateInplaceRep<TYPE, ALLOCATOR> *
+LocalSharedPtrAllocateInplaceRep<TYPE, ALLOCATOR>::makeRep(
+                                               ReboundAllocator basicAllocator)
+{
+    LocalSharedPtrAllocateInplaceRep *rep_p =
+                                    ReboundTraits::allocate(basicAllocator, 1);
+    new(rep_p) LocalSharedPtrAllocateInplaceRep(basicAllocator);
+    return rep_p;
+}
+
+// MANIPULATORS
+template <class TYPE, class ALLOCATOR>
+inline
+void LocalSharedPtrAllocateInplaceRep<TYPE, ALLOCATOR>::disposeObject()
+{
+    ReboundTraits::destroy(d_allocator, ptr());
+}
+
+template <class TYPE, class ALLOCATOR>
+inline
+void LocalSharedPtrAllocateInplaceRep<TYPE, ALLOCATOR>::disposeRep()
+{
+    ReboundAllocator alloc(d_allocator);
+    this->d_allocator.~ReboundAllocator();
+    ReboundTraits::deallocate(alloc, this, 1);
+}
+
+template <class TYPE, class ALLOCATOR>
+inline
+void *LocalSharedPtrAllocateInplaceRep<TYPE, ALLOCATOR>::getDeleter(
+                                                         const std::type_info&)
+{
+    return 0;
+}
+
+template <class TYPE, class ALLOCATOR>
+inline
+TYPE *LocalSharedPtrAllocateInplaceRep<TYPE, ALLOCATOR>::ptr()
+{
+    return reinterpret_cast<TYPE *>(d_instance.buffer());
+}
+
+// ACCESSORS
+template <class TYPE, class ALLOCATOR>
+inline
+void *LocalSharedPtrAllocateInplaceRep<TYPE, ALLOCATOR>::originalPtr() const
+{
+    return const_cast<void *>(static_cast<const void *>(
+                         reinterpret_cast<const TYPE *>(d_instance.buffer())));
+}
+
+}  // close package namespace
+
+// ============================================================================
+//                              TYPE TRAITS
+// ============================================================================
+
+namespace bslma {
+
+template <class TYPE, class ALLOCATOR>
+struct UsesBslmaAllocator<
+                    bslstl::LocalSharedPtrAllocateInplaceRep<TYPE, ALLOCATOR> >
+    : bsl::false_type
+{};
+
+}  // close traits namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,378 @@
+// bslstl_localsharedptrallocateinplacerep.t.cpp                      -*-C++-*-
+#include <bslstl_localsharedptrallocateinplacerep.h>
+
+#include <bslstl_allocator.h>
+#include <bslstl_allocatortraits.h>
+
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_bsltestutil.h>
+
+#include <stdio.h>
+#include <stdlib.h>             // 'atoi'
+
+using namespace BloombergLP;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// 'bslstl::LocalSharedPtrAllocateInplaceRep' is a concrete single-threaded
+// representation holding its shared object in-place.  We verify that a single
+// allocation supplies both the representation and the object, that the object
+// is destroyed when the last (local or shared) reference is released, and that
+// the memory is returned to the allocator when the last reference of any kind
+// is released.
+//-----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] LocalSharedPtrAllocateInplaceRep *makeRep(ReboundAllocator alloc);
+//
+// MANIPULATORS
+// [ 3] void disposeObject();
+// [ 2] void disposeRep();
+// [ 4] void *getDeleter(const std::type_info& type);
+// [ 2] TYPE *ptr();
+//
+// ACCESSORS
+// [ 2] void *originalPtr() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+//-----------------------------------------------------------------------------
+
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACROS
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                     STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+#define ASSERT_SAFE_PASS_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS_RAW(EXPR)
+#define ASSERT_SAFE_FAIL_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL_RAW(EXPR)
+#define ASSERT_PASS_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS_RAW(EXPR)
+#define ASSERT_FAIL_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL_RAW(EXPR)
+#define ASSERT_OPT_PASS_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS_RAW(EXPR)
+
+//=============================================================================
+//             GLOBAL HELPER CLASSES AND FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+                            // ================
+                            // class MyTestType
+                            // ================
+
+class MyTestType {
+    // This class records its destruction in a counter supplied at
+    // construction.
+
+    // DATA
+    int *d_numDestroyed_p;  // destruction counter (held, not owned)
+
+  public:
+    // CREATORS
+    explicit MyTestType(int *numDestroyed)
+    : d_numDestroyed_p(numDestroyed)
+    {
+    }
+
+    ~MyTestType()
+    {
+        ++*d_numDestroyed_p;
+    }
+};
+
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+    bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVerbose;
+    (void)veryVeryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    // Confirm no static intialization locked the global allocator
+    ASSERT(&globalAllocator == bslma::Default::globalAllocator());
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    // Confirm no static intialization locked the default allocator
+    ASSERT(&defaultAllocator == bslma::Default::defaultAllocator());
+
+    bslma::TestAllocator ta;
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'getDeleter'
+        //
+        // Concerns:
+        //: 1 'getDeleter' returns a null pointer for any type.
+        //
+        // Plan:
+        //: 1 Query 'getDeleter' with several types.  (C-1)
+        //
+        // Testing:
+        //   void *getDeleter(const std::type_info& type);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'getDeleter'"
+                            "\n====================\n");
+
+        typedef bslstl::LocalSharedPtrAllocateInplaceRep<int,
+                                                         bsl::allocator<int> >
+                                                                           Obj;
+
+        Obj *rep = Obj::makeRep(bsl::allocator<int>(&ta));
+        *rep->ptr() = 0;
+
+        ASSERT(0 == rep->getDeleter(typeid(int)));
+        ASSERT(0 == rep->getDeleter(typeid(bsl::allocator<int>)));
+        ASSERT(0 == rep->getDeleter(typeid(bslma::Allocator *)));
+
+        rep->releaseLocalRef();
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'disposeObject'
+        //
+        // Concerns:
+        //: 1 The in-place object is destroyed exactly once, when the last
+        //:   local or shared reference is released.
+        //:
+        //: 2 The memory is not returned until the last weak reference is also
+        //:   released.
+        //
+        // Plan:
+        //: 1 Create representations holding a type that counts its
+        //:   destructions, acquire local, shared, and weak references, and
+        //:   release them in several orders.  (C-1..2)
+        //
+        // Testing:
+        //   void disposeObject();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'disposeObject'"
+                            "\n=======================\n");
+
+        typedef bsl::allocator<MyTestType>                       Alloc;
+        typedef bslstl::LocalSharedPtrAllocateInplaceRep<MyTestType, Alloc>
+                                                                           Obj;
+
+        if (verbose) printf("\nShared reference outlives local ones.\n");
+        {
+            int numDestroyed = 0;
+
+            Obj *rep = Obj::makeRep(Alloc(&ta));
+            new (rep->ptr()) MyTestType(&numDestroyed);
+
+            rep->acquireLocalRef();
+            rep->acquireRef();
+            rep->releaseLocalRef();
+            rep->releaseLocalRef();
+            ASSERT(0 == numDestroyed);
+            ASSERT(1 == ta.numBlocksInUse());
+
+            rep->releaseRef();
+            ASSERT(1 == numDestroyed);
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) printf("\nWeak reference outlives local ones.\n");
+        {
+            int numDestroyed = 0;
+
+            Obj *rep = Obj::makeRep(Alloc(&ta));
+            new (rep->ptr()) MyTestType(&numDestroyed);
+
+            rep->acquireWeakRef();
+            rep->releaseLocalRef();
+            ASSERT(1 == numDestroyed);
+            ASSERT(1 == ta.numBlocksInUse());
+
+            rep->releaseWeakRef();
+            ASSERT(1 == numDestroyed);
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'makeRep'
+        //
+        // Concerns:
+        //: 1 'makeRep' obtains a single block of memory from the supplied
+        //:   allocator, holding both the representation and the object.
+        //:
+        //: 2 'ptr' and 'originalPtr' return the address of the in-place
+        //:   object.
+        //:
+        //: 3 The new representation has one local and one shared reference.
+        //:
+        //: 4 'disposeRep' returns the memory to the allocator.
+        //
+        // Plan:
+        //: 1 Create a representation, verify its state and the allocator
+        //:   usage, and then release it.  (C-1..4)
+        //
+        // Testing:
+        //   LocalSharedPtrAllocateInplaceRep *makeRep(ReboundAllocator);
+        //   void disposeRep();
+        //   TYPE *ptr();
+        //   void *originalPtr() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'makeRep'"
+                            "\n=================\n");
+
+        typedef bslstl::LocalSharedPtrAllocateInplaceRep<double,
+                                                      bsl::allocator<double> >
+                                                                           Obj;
+
+        Obj *rep = Obj::makeRep(bsl::allocator<double>(&ta));
+        ASSERT(1 == ta.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+
+        ASSERT(static_cast<void *>(rep->ptr()) == rep->originalPtr());
+        ASSERT(1 == rep->numLocalReferences());
+        ASSERT(1 == rep->numReferences());
+        ASSERT(0 == rep->numWeakReferences());
+
+        *rep->ptr() = 1.5;
+        ASSERT(1.5 == *static_cast<double *>(rep->originalPtr()));
+
+        rep->releaseLocalRef();
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a representation using the default allocator, initialize
+        //:   the in-place object, acquire and release local references, and
+        //:   verify that all memory is returned.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        typedef bslstl::LocalSharedPtrAllocateInplaceRep<int,
+                                                         bsl::allocator<int> >
+                                                                           Obj;
+
+        bsl::allocator<int> alloc;
+
+        Obj *rep = Obj::makeRep(alloc);
+        bsl::allocator_traits<bsl::allocator<int> >::construct(alloc,
+                                                               rep->ptr(),
+                                                               42);
+        ASSERT(42 == *rep->ptr());
+        ASSERT(1  == defaultAllocator.numBlocksInUse());
+
+        rep->acquireLocalRef();
+        ASSERT(2 == rep->numLocalReferences());
+
+        rep->releaseLocalRef();
+        rep->releaseLocalRef();
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
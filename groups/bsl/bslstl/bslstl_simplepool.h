@@ -42,6 +42,13 @@ BSLS_IDENT("$Id: $")
 // each time a chunk is allocated up to an implementation defined maximum
 // number of blocks.
 //
+// When the pool is released (or destroyed), its chunks are returned to the
+// underlying allocator in batches of equally-sized chunks.  If the allocator
+// is a 'bsl::allocator' (i.e., its mechanism is a 'bslma::Allocator'), each
+// batch is returned using a single call to
+// 'bslma::Allocator::deallocateBatch'; otherwise, the chunks are returned one
+// at a time.
+//
 ///Comparison with 'bdema_Pool'
 ///----------------------------
 // There are a few differences between 'bslstl::SimplePool' and 'bdema_Pool':
@@ -213,6 +220,18 @@ BSL_OVERRIDES_STD mode"
 #include <bslalg_swaputil.h>
 #endif
 
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_INTEGRALCONSTANT
+#include <bslmf_integralconstant.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISCONVERTIBLE
+#include <bslmf_isconvertible.h>
+#endif
+
 #ifndef INCLUDED_BSLS_ALIGNMENTFROMTYPE
 #include <bsls_alignmentfromtype.h>
 #endif
@@ -225,6 +244,10 @@ BSL_OVERRIDES_STD mode"
 #include <bsls_assert.h>
 #endif
 
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
 #ifndef INCLUDED_ALGORITHM
 #include <algorithm>       // 'std::swap'
 #define INCLUDED_ALGORITHM
@@ -286,16 +309,30 @@ class SimplePool : public SimplePool_Type<ALLOCATOR>::AllocatorType {
                                             // ensure proper alignment
     };
 
+    union Chunk;
+
+    struct ChunkLink {
+        // This 'struct' holds the data stored in the 'Chunk' at the beginning
+        // of each managed block of allocated memory.
+
+        Chunk *d_next_p;  // pointer to next Chunk
+
+        typename Types::AllocatorTraits::size_type
+               d_numObjects;
+                          // number of 'MaxAlignedType' objects allocated for
+                          // this chunk (needed to deallocate it)
+    };
+
     union Chunk {
         // This 'union' prepends to the beginning of each managed block of
         // allocated memory, implementing a singly-linked list of managed
         // chunks, and thereby enabling constant-time additions to the list of
         // chunks.
 
-        Chunk *d_next_p;  // pointer to next Chunk
+        ChunkLink d_link;  // link to next Chunk, and size of this chunk
 
         typename bsls::AlignmentFromType<Block>::Type d_alignment;
-                          // ensure each block is correctly aligned
+                           // ensure each block is correctly aligned
     };
 
   public:
@@ -338,6 +375,30 @@ class SimplePool : public SimplePool_Type<ALLOCATOR>::AllocatorType {
         // strategy, and use the chunk to replenish the free memory list of
         // this pool.
 
+    void deallocateChunks(void *const *chunks,
+                          int          numChunks,
+                          size_type    numObjects);
+        // Return the specified 'numChunks' chunks whose addresses are held in
+        // the specified 'chunks' array, each consisting of the specified
+        // 'numObjects' number of 'MaxAlignedType' objects, to the allocator
+        // of this pool.
+
+    void deallocateChunks(void *const *chunks,
+                          int          numChunks,
+                          size_type    numObjects,
+                          bsl::true_type);
+    void deallocateChunks(void *const *chunks,
+                          int          numChunks,
+                          size_type    numObjects,
+                          bsl::false_type);
+        // Return the specified 'numChunks' chunks whose addresses are held in
+        // the specified 'chunks' array, each consisting of the specified
+        // 'numObjects' number of 'MaxAlignedType' objects, to the allocator
+        // of this pool, using a single call to 'deallocateBatch' on the
+        // mechanism of the allocator if the last argument is of type
+        // 'bsl::true_type', and one call to 'AllocatorTraits::deallocate' per
+        // chunk otherwise.
+
   public:
     // CREATORS
     explicit SimplePool(const ALLOCATOR& allocator);
@@ -375,6 +436,8 @@ class SimplePool : public SimplePool_Type<ALLOCATOR>::AllocatorType {
 
     void release();
         // Relinquish all memory currently allocated via this pool object.
+        // Chunks of equal size are returned to the underlying allocator in
+        // batches.
 
     void swap(SimplePool& other);
         // Efficiently exchange the memory blocks of this object with those of
@@ -425,8 +488,9 @@ SimplePool<VALUE, ALLOCATOR>::allocateChunk(size_type size)
     BSLS_ASSERT_SAFE(0 ==
              reinterpret_cast<bsls::Types::UintPtr>(chunkPtr) % sizeof(Chunk));
 
-    chunkPtr->d_next_p = d_chunkList_p;
-    d_chunkList_p      = chunkPtr;
+    chunkPtr->d_link.d_next_p     = d_chunkList_p;
+    chunkPtr->d_link.d_numObjects = numMaxAlignedType;
+    d_chunkList_p                 = chunkPtr;
 
     return reinterpret_cast<Block *>(chunkPtr + 1);
 }
@@ -444,6 +508,49 @@ void SimplePool<VALUE, ALLOCATOR>::replenish()
     }
 }
 
+template <class VALUE, class ALLOCATOR>
+inline
+void SimplePool<VALUE, ALLOCATOR>::deallocateChunks(void *const *chunks,
+                                                    int          numChunks,
+                                                    size_type    numObjects)
+{
+    typedef typename bsl::is_convertible<BloombergLP::bslma::Allocator *,
+                                         AllocatorType>::type IsBslma;
+
+    deallocateChunks(chunks, numChunks, numObjects, IsBslma());
+}
+
+template <class VALUE, class ALLOCATOR>
+inline
+void SimplePool<VALUE, ALLOCATOR>::deallocateChunks(void *const *chunks,
+                                                    int          numChunks,
+                                                    size_type    numObjects,
+                                                    bsl::true_type)
+{
+    // Match the size supplied by 'bsl::allocator' to 'allocateSized'.
+
+    typedef typename AllocatorTraits::value_type ObjectType;
+
+    allocator().mechanism()->deallocateBatch(chunks,
+                                             numChunks,
+                                             numObjects * sizeof(ObjectType));
+}
+
+template <class VALUE, class ALLOCATOR>
+void SimplePool<VALUE, ALLOCATOR>::deallocateChunks(void *const *chunks,
+                                                    int          numChunks,
+                                                    size_type    numObjects,
+                                                    bsl::false_type)
+{
+    for (int i = 0; i < numChunks; ++i) {
+        AllocatorTraits::deallocate(
+                      allocator(),
+                      static_cast<typename AllocatorTraits::value_type *>(
+                                                                   chunks[i]),
+                      numObjects);
+    }
+}
+
 // CREATORS
 template <class VALUE, class ALLOCATOR>
 inline
@@ -480,6 +587,12 @@ VALUE *SimplePool<VALUE, ALLOCATOR>::allocate()
     }
     VALUE *block = reinterpret_cast<VALUE *>(d_freeList_p);
     d_freeList_p = d_freeList_p->d_next_p;
+
+    // The next call reads the new head of the free list (which, once
+    // recycled, may be anywhere in memory) and its caller writes it: fetch it
+    // now.  Note that prefetching a null address has no effect.
+
+    bsls::PerformanceHint::prefetchForWriting(d_freeList_p);
     return block;
 }
 
@@ -551,12 +664,31 @@ SimplePool<VALUE, ALLOCATOR>::allocator() const
 template <class VALUE, class ALLOCATOR>
 void SimplePool<VALUE, ALLOCATOR>::release()
 {
+    // Gather runs of equally-sized chunks (all chunks beyond the first few
+    // have the maximum size), and return each run as a single batch.
+
+    enum { MAX_BATCH = 64 };
+
+    void      *batch[MAX_BATCH];
+    int        batchLength  = 0;
+    size_type  batchObjects = 0;
+
     while (d_chunkList_p) {
-        typename AllocatorTraits::value_type *lastChunk =
-                      reinterpret_cast<typename AllocatorTraits::value_type *>(
-                                                                d_chunkList_p);
-        d_chunkList_p   = d_chunkList_p->d_next_p;
-        AllocatorTraits::deallocate(allocator(), lastChunk, 1);
+        Chunk     *chunk      = d_chunkList_p;
+        size_type  numObjects = chunk->d_link.d_numObjects;
+        d_chunkList_p         = chunk->d_link.d_next_p;
+
+        if (MAX_BATCH == batchLength
+         || (0 < batchLength && numObjects != batchObjects)) {
+            deallocateChunks(batch, batchLength, batchObjects);
+            batchLength = 0;
+        }
+        batch[batchLength++] = chunk;
+        batchObjects         = numObjects;
+    }
+
+    if (0 < batchLength) {
+        deallocateChunks(batch, batchLength, batchObjects);
     }
     d_freeList_p = 0;
 }
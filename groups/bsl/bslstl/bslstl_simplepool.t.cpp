@@ -165,6 +165,50 @@ bool expectToAllocate(int n)
 }
 
 
+class BatchCountingAllocator : public bslma::Allocator {
+    // This 'bslma::Allocator' forwards all requests to an allocator supplied
+    // at construction, and counts the calls made to 'deallocateBatch' and the
+    // number of blocks returned by them.
+
+    // DATA
+    bslma::Allocator *d_allocator_p;        // supplies memory (held)
+    int               d_numBatches;         // calls to 'deallocateBatch'
+    int               d_numBatchedBlocks;   // blocks returned in batches
+
+  public:
+    // CREATORS
+    explicit BatchCountingAllocator(bslma::Allocator *allocator)
+    : d_allocator_p(allocator)
+    , d_numBatches(0)
+    , d_numBatchedBlocks(0)
+    {
+    }
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size)
+    {
+        return d_allocator_p->allocate(size);
+    }
+
+    virtual void deallocate(void *address)
+    {
+        d_allocator_p->deallocate(address);
+    }
+
+    virtual void deallocateBatch(void *const *addresses,
+                                 size_type    numBlocks,
+                                 size_type    size)
+    {
+        ++d_numBatches;
+        d_numBatchedBlocks += static_cast<int>(numBlocks);
+        bslma::Allocator::deallocateBatch(addresses, numBlocks, size);
+    }
+
+    // ACCESSORS
+    int numBatches() const       { return d_numBatches; }
+    int numBatchedBlocks() const { return d_numBatchedBlocks; }
+};
+
 class Stack {
     // A fixed sized stack for storing pointers allocated/deallocated by the
     // pool.
@@ -589,6 +633,9 @@ void TestDriver<VALUE>::testCase7()
     //:
     //: 3 No free memory blocks is available after a 'release'.  i.e.,
     //:   subsequent 'allocate' will need to allocate memory from the heap.
+    //:
+    //: 4 Equally-sized chunks are returned to a 'bslma::Allocator' in
+    //:   batches, rather than one at a time.
     //
     // Plan:
     //: 1 Invoke 'allocate' and 'deallocate' various number of time.
@@ -597,6 +644,10 @@ void TestDriver<VALUE>::testCase7()
     //:
     //:   2 Call 'allocate' and verify memory is allocated from the heap.
     //:     (C-3)
+    //:
+    //: 2 Allocate enough blocks to require many maximally-sized chunks from
+    //:   an allocator that counts calls to 'deallocateBatch', call 'release',
+    //:   and verify that all chunks were returned using few batches.  (C-4)
     //
     // Testing:
     //   void release();
@@ -660,6 +711,33 @@ void TestDriver<VALUE>::testCase7()
 
     }
 
+    {
+        const int NUM_BLOCKS = 2000;
+
+        bslma::TestAllocator   oa("object", veryVeryVeryVerbose);
+        BatchCountingAllocator ca(&oa);
+
+        Obj mX(&ca);
+
+        for (int i = 0; i < NUM_BLOCKS; ++i) {
+            mX.allocate();
+        }
+
+        const int NUM_CHUNKS = static_cast<int>(oa.numBlocksInUse());
+
+        mX.release();
+
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+        ASSERTV(NUM_CHUNKS, ca.numBatchedBlocks(),
+                NUM_CHUNKS == ca.numBatchedBlocks());
+
+        // Chunks of the first few (growing) sizes are returned individually;
+        // maximally-sized chunks are returned in batches.
+
+        ASSERTV(NUM_CHUNKS, ca.numBatches(),
+                ca.numBatches() < NUM_CHUNKS / 8);
+    }
+
     // Verify no memory is allocated from the default allocator.
 
     ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
@@ -0,0 +1,450 @@
+// bslstl_staticallocator.h                                           -*-C++-*-
+#ifndef INCLUDED_BSLSTL_STATICALLOCATOR
+#define INCLUDED_BSLSTL_STATICALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an STL allocator statically bound to a concrete mechanism.
+//
+//@CLASSES:
+//  bsl::static_allocator: STL allocator bound to a concrete mechanism type
+//
+//@SEE_ALSO: bslstl_allocator, bslstl_allocatortraits
+//
+//@DESCRIPTION: This component provides an STL-compatible allocator class
+// template, 'bsl::static_allocator', parameterized by the type of the objects
+// it allocates and by the concrete type of the memory mechanism that supplies
+// the memory.  Unlike 'bsl::allocator', which forwards every request through
+// the (virtual) 'bslma::Allocator' protocol, a 'bsl::static_allocator' binds
+// a container to its mechanism at compile time: 'allocate' and 'deallocate'
+// invoke 'MECHANISM::allocate' and 'MECHANISM::deallocate' using qualified
+// (i.e., non-virtual) calls, allowing the compiler to inline the fast path of
+// the mechanism into the container.
+//
+// The (template parameter) 'MECHANISM' type must provide the following two
+// methods (which may, but need not, be virtual):
+//..
+//  void *allocate(size_type size);
+//  void deallocate(void *address);
+//..
+// Because the calls are statically bound, the 'MECHANISM' object supplied at
+// construction must be of the exact type 'MECHANISM' -- *not* of a type
+// derived from it -- whenever 'MECHANISM' declares 'allocate' or 'deallocate'
+// 'virtual'.  Note that this requirement is naturally satisfied by concrete
+// allocators and pools, such as 'bdlma::MultipoolAllocator',
+// 'bdlma::SequentialAllocator', or 'bdlma::Multipool'.
+//
+///Interoperation with 'bslma::UsesBslmaAllocator'
+///-----------------------------------------------
+// If 'MECHANISM' is derived from 'bslma::Allocator', 'bsl::static_allocator'
+// declares the 'bslstl::SuppliesBslmaAllocator' trait, and
+// 'bsl::allocator_traits::construct' passes the mechanism (as a
+// 'bslma::Allocator *') to the constructor of each element having the
+// 'bslma::UsesBslmaAllocator' trait.  The container's own nodes are thereby
+// allocated through statically-bound calls, while the memory owned by its
+// elements (e.g., that of 'bsl::string' keys) comes from the same mechanism
+// through the 'bslma::Allocator' protocol.  Elements of containers that do not
+// use 'bsl::allocator_traits' for element construction (e.g., 'bsl::vector',
+// 'bsl::deque', and 'bsl::string') do *not* receive the mechanism, and use
+// the default allocator instead.
+//
+// If 'MECHANISM' is not derived from 'bslma::Allocator' (e.g.,
+// 'bdlma::Multipool'), 'bsl::static_allocator' is an ordinary C++03 allocator,
+// and elements are constructed without an allocator argument.
+//
+// In either case, a 'bsl::static_allocator' follows the C++03 (rather than the
+// 'bslma') model with respect to copying: a copy-constructed container uses a
+// copy of the allocator of the original container.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Binding a Map to a Concrete Allocator
+/// - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we have a concrete allocator class, 'my_CountingAllocator',
+// derived from 'bslma::Allocator', whose 'allocate' method we would like to be
+// invoked without virtual dispatch.
+//
+// First, we define the allocator:
+//..
+//  class my_CountingAllocator : public bslma::Allocator {
+//      // This concrete allocator counts the number of allocations.
+//
+//      // DATA
+//      int d_numAllocations;  // number of blocks allocated
+//
+//    public:
+//      // CREATORS
+//      my_CountingAllocator() : d_numAllocations(0) {}
+//
+//      // MANIPULATORS
+//      virtual void *allocate(size_type size)
+//      {
+//          ++d_numAllocations;
+//          return ::operator new(size);
+//      }
+//
+//      virtual void deallocate(void *address)
+//      {
+//          ::operator delete(address);
+//      }
+//
+//      // ACCESSORS
+//      int numAllocations() const { return d_numAllocations; }
+//  };
+//..
+// Then, we define a map type that is statically bound to
+// 'my_CountingAllocator':
+//..
+//  typedef bsl::static_allocator<bsl::pair<const int, bsl::string>,
+//                                my_CountingAllocator>    MapAllocator;
+//  typedef bsl::map<int, bsl::string, std::less<int>, MapAllocator> Map;
+//..
+// Next, we create an allocator and a map that uses it:
+//..
+//  my_CountingAllocator countingAllocator;
+//  Map                  map(&countingAllocator);
+//..
+// Now, we insert an element having a string value long enough to require
+// allocation:
+//..
+//  map[1] = "a string that is too long for the short-string buffer";
+//..
+// Finally, we observe that the allocator supplied memory to the map (through
+// statically bound calls), and also to the 'bsl::string' element (which has
+// the 'bslma::UsesBslmaAllocator' trait) through the 'bslma::Allocator'
+// protocol:
+//..
+//  assert(0 < countingAllocator.numAllocations());
+//  assert(&countingAllocator == map[1].get_allocator().mechanism());
+//..
+
+// Prevent 'bslstl' headers from being included directly in 'BSL_OVERRIDES_STD'
+// mode.  Doing so is unsupported, and is likely to cause compilation errors.
+#if defined(BSL_OVERRIDES_STD) && !defined(BSL_STDHDRS_PROLOGUE_IN_EFFECT)
+#error "<bslstl_staticallocator.h> header can't be included directly in \
+BSL_OVERRIDES_STD mode"
+#endif
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_ALLOCATORTRAITS
+#include <bslstl_allocatortraits.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
+#include <bslmf_isbitwisemoveable.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISCONVERTIBLE
+#include <bslmf_isconvertible.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISTRIVIALLYCOPYABLE
+#include <bslmf_istriviallycopyable.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_UTIL
+#include <bsls_util.h>
+#endif
+
+#ifndef INCLUDED_CSTDDEF
+#include <cstddef>
+#define INCLUDED_CSTDDEF
+#endif
+
+#ifndef INCLUDED_NEW
+#include <new>
+#define INCLUDED_NEW
+#endif
+
+namespace bsl {
+
+                          // ======================
+                          // class static_allocator
+                          // ======================
+
+template <class TYPE, class MECHANISM>
+class static_allocator {
+    // An STL-compatible allocator that forwards allocation calls, using
+    // statically bound (non-virtual) calls, to an underlying mechanism object
+    // of the concrete (template parameter) type 'MECHANISM'.  This class
+    // template adheres to the allocator requirements of the C++03 standard
+    // (section 20.1.5 [lib.allocator.requirements]), and may be used to
+    // instantiate any STL container class.  If 'MECHANISM' is derived from
+    // 'bslma::Allocator', the mechanism is supplied (by
+    // 'bsl::allocator_traits') to elements having the
+    // 'bslma::UsesBslmaAllocator' trait.
+
+    // DATA
+    MECHANISM *d_mechanism_p;  // mechanism supplying memory (held, not owned)
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(static_allocator,
+                                   bsl::is_trivially_copyable);
+    BSLMF_NESTED_TRAIT_DECLARATION(static_allocator,
+                                   BloombergLP::bslmf::IsBitwiseMoveable);
+    BSLMF_NESTED_TRAIT_DECLARATION_IF(
+                      static_allocator,
+                      BloombergLP::bslstl::SuppliesBslmaAllocator,
+                      (bsl::is_convertible<MECHANISM *,
+                                           BloombergLP::bslma::Allocator *>::
+                                                                      value));
+
+    // PUBLIC TYPES
+    typedef std::size_t     size_type;
+    typedef std::ptrdiff_t  difference_type;
+    typedef TYPE           *pointer;
+    typedef const TYPE     *const_pointer;
+    typedef TYPE&           reference;
+    typedef const TYPE&     const_reference;
+    typedef TYPE            value_type;
+    typedef MECHANISM       mechanism_type;
+
+    template <class ANY_TYPE>
+    struct rebind {
+        // This nested 'struct' template, parameterized by 'ANY_TYPE', provides
+        // a namespace for an 'other' type alias, which is an allocator type
+        // following the same template as this one but that allocates elements
+        // of 'ANY_TYPE' from the same 'MECHANISM'.
+
+        typedef static_allocator<ANY_TYPE, MECHANISM> other;
+    };
+
+    // CREATORS
+    static_allocator(MECHANISM *mechanism);                         // IMPLICIT
+        // Create a static allocator that will forward allocation calls to the
+        // specified 'mechanism' object.  The behavior is undefined unless
+        // 'mechanism' is not null and, if 'MECHANISM' declares 'allocate' or
+        // 'deallocate' 'virtual', the dynamic type of '*mechanism' is
+        // 'MECHANISM'.  Note that this constructor is implicit, so that a
+        // 'MECHANISM *' may be supplied where a 'static_allocator' is expected
+        // (e.g., to a container constructor).
+
+    //! static_allocator(const static_allocator& original) = default;
+        // Create a static allocator having the same mechanism as the specified
+        // 'original'.
+
+    template <class ANY_TYPE>
+    static_allocator(const static_allocator<ANY_TYPE, MECHANISM>& original);
+        // Create a static allocator having the same mechanism as the specified
+        // 'original', which allocates objects of a different type.
+
+    //! ~static_allocator() = default;
+        // Destroy this object.  Note that this does not delete the object
+        // pointed to by 'mechanism()'.
+
+    //! static_allocator& operator=(const static_allocator& rhs) = default;
+        // Assign to this object the value of the specified 'rhs', and return a
+        // reference providing modifiable access to this object.
+
+    // MANIPULATORS
+    pointer allocate(size_type n, const void *hint = 0);
+        // Allocate enough (properly aligned) space for the specified 'n'
+        // objects of (template parameter) 'TYPE' by calling 'allocate' on the
+        // mechanism object using a statically bound call.  The optionally
+        // specified 'hint' argument is ignored by this allocator type.  The
+        // behavior is undefined unless 'n <= max_size()'.
+
+    void deallocate(pointer p, size_type n = 1);
+        // Return memory previously allocated with 'allocate' to the mechanism
+        // object by calling 'deallocate' on the mechanism object using a
+        // statically bound call, with the specified 'p' as its argument.  The
+        // optionally specified 'n' argument is ignored by this allocator type.
+
+    void construct(pointer p, const TYPE& val);
+        // Copy-construct a 'TYPE' object at the memory address specified by
+        // 'p'.  Do not directly allocate memory.  The behavior is undefined
+        // unless 'p' is not properly aligned for objects of the given 'TYPE'.
+
+    void destroy(pointer p);
+        // Call the 'TYPE' destructor for the object pointed to by the
+        // specified 'p'.  Do not directly deallocate any memory.
+
+    // ACCESSORS
+    pointer address(reference x) const;
+        // Return the address of the object referred to by the specified 'x'
+        // argument, even if the (template parameter) 'TYPE' overloads the
+        // unary 'operator&'.
+
+    const_pointer address(const_reference x) const;
+        // Return the address of the object referred to by the specified 'x'
+        // argument, even if the (template parameter) 'TYPE' overloads the
+        // unary 'operator&'.
+
+    size_type max_size() const;
+        // Return the maximum number of elements of (template parameter) 'TYPE'
+        // that can be allocated using this allocator.  Note that there is no
+        // guarantee that attempts at allocating fewer elements than the value
+        // returned by 'max_size' will not throw.
+
+    MECHANISM *mechanism() const;
+        // Return the address of the mechanism object used by this allocator.
+};
+
+// FREE OPERATORS
+template <class T1, class T2, class MECHANISM>
+bool operator==(const static_allocator<T1, MECHANISM>& lhs,
+                const static_allocator<T2, MECHANISM>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' are proxies for the same
+    // mechanism object, and 'false' otherwise.
+
+template <class T1, class T2, class MECHANISM>
+bool operator!=(const static_allocator<T1, MECHANISM>& lhs,
+                const static_allocator<T2, MECHANISM>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' are not proxies for the
+    // same mechanism object, and 'false' otherwise.
+
+// ============================================================================
+//                  INLINE AND TEMPLATE FUNCTION DEFINITIONS
+// ============================================================================
+
+                          // ----------------------
+                          // class static_allocator
+                          // ----------------------
+
+// CREATORS
+template <class TYPE, class MECHANISM>
+inline
+static_allocator<TYPE, MECHANISM>::static_allocator(MECHANISM *mechanism)
+: d_mechanism_p(mechanism)
+{
+    BSLS_ASSERT_SAFE(mechanism);
+}
+
+template <class TYPE, class MECHANISM>
+template <class ANY_TYPE>
+inline
+static_allocator<TYPE, MECHANISM>::static_allocator(
+                        const static_allocator<ANY_TYPE, MECHANISM>& original)
+: d_mechanism_p(original.mechanism())
+{
+}
+
+// MANIPULATORS
+template <class TYPE, class MECHANISM>
+inline
+typename static_allocator<TYPE, MECHANISM>::pointer
+static_allocator<TYPE, MECHANISM>::allocate(size_type n, const void *hint)
+{
+    BSLS_ASSERT_SAFE(n <= this->max_size());
+
+    (void) hint;  // suppress unused parameter warning
+
+    // The qualified call suppresses virtual dispatch (if any).
+
+    return static_cast<pointer>(
+                       d_mechanism_p->MECHANISM::allocate(n * sizeof(TYPE)));
+}
+
+template <class TYPE, class MECHANISM>
+inline
+void static_allocator<TYPE, MECHANISM>::deallocate(pointer p, size_type)
+{
+    d_mechanism_p->MECHANISM::deallocate(p);
+}
+
+template <class TYPE, class MECHANISM>
+inline
+void static_allocator<TYPE, MECHANISM>::construct(pointer p, const TYPE& val)
+{
+    ::new (static_cast<void *>(p)) TYPE(val);
+}
+
+template <class TYPE, class MECHANISM>
+inline
+void static_allocator<TYPE, MECHANISM>::destroy(pointer p)
+{
+    p->~TYPE();
+}
+
+// ACCESSORS
+template <class TYPE, class MECHANISM>
+inline
+typename static_allocator<TYPE, MECHANISM>::pointer
+static_allocator<TYPE, MECHANISM>::address(reference x) const
+{
+    return BSLS_UTIL_ADDRESSOF(x);
+}
+
+template <class TYPE, class MECHANISM>
+inline
+typename static_allocator<TYPE, MECHANISM>::const_pointer
+static_allocator<TYPE, MECHANISM>::address(const_reference x) const
+{
+    return BSLS_UTIL_ADDRESSOF(x);
+}
+
+template <class TYPE, class MECHANISM>
+inline
+typename static_allocator<TYPE, MECHANISM>::size_type
+static_allocator<TYPE, MECHANISM>::max_size() const
+{
+    static const std::size_t MAX_NUM_BYTES    = ~std::size_t(0);
+    static const std::size_t MAX_NUM_ELEMENTS = MAX_NUM_BYTES / sizeof(TYPE);
+
+    return MAX_NUM_ELEMENTS;
+}
+
+template <class TYPE, class MECHANISM>
+inline
+MECHANISM *static_allocator<TYPE, MECHANISM>::mechanism() const
+{
+    return d_mechanism_p;
+}
+
+// FREE OPERATORS
+template <class T1, class T2, class MECHANISM>
+inline
+bool operator==(const static_allocator<T1, MECHANISM>& lhs,
+                const static_allocator<T2, MECHANISM>& rhs)
+{
+    return lhs.mechanism() == rhs.mechanism();
+}
+
+template <class T1, class T2, class MECHANISM>
+inline
+bool operator!=(const static_allocator<T1, MECHANISM>& lhs,
+                const static_allocator<T2, MECHANISM>& rhs)
+{
+    return lhs.mechanism() != rhs.mechanism();
+}
+
+}  // close namespace bsl
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,850 @@
+// bslstl_staticallocator.t.cpp                                       -*-C++-*-
+#include <bslstl_staticallocator.h>
+
+#include <bslstl_allocatortraits.h>
+#include <bslstl_list.h>
+#include <bslstl_map.h>
+#include <bslstl_string.h>
+#include <bslstl_unorderedmap.h>
+
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_usesbslmaallocator.h>
+#include <bslmf_isbitwisemoveable.h>
+#include <bslmf_issame.h>
+#include <bslmf_istriviallycopyable.h>
+#include <bsls_asserttest.h>
+#include <bsls_bsltestutil.h>
+
+#include <new>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace BloombergLP;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// A 'bsl::static_allocator' is a thin, value-semantic adapter holding a single
+// pointer to a mechanism object of a concrete type.  We must verify that it
+// forwards 'allocate' and 'deallocate' to the mechanism, that it satisfies the
+// allocator requirements well enough to instantiate the standard containers,
+// and that 'bsl::allocator_traits' supplies the mechanism to elements having
+// the 'bslma::UsesBslmaAllocator' trait if (and only if) the mechanism type is
+// derived from 'bslma::Allocator'.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] static_allocator(MECHANISM *mechanism);
+// [ 2] static_allocator(const static_allocator& original);
+// [ 2] static_allocator(const static_allocator<U, MECHANISM>& original);
+//
+// MANIPULATORS
+// [ 3] pointer allocate(size_type n, const void *hint = 0);
+// [ 3] void deallocate(pointer p, size_type n = 1);
+// [ 3] void construct(pointer p, const TYPE& val);
+// [ 3] void destroy(pointer p);
+//
+// ACCESSORS
+// [ 3] pointer address(reference x) const;
+// [ 3] const_pointer address(const_reference x) const;
+// [ 3] size_type max_size() const;
+// [ 2] MECHANISM *mechanism() const;
+//
+// FREE OPERATORS
+// [ 2] bool operator==(static_allocator<T1,M>, static_allocator<T2,M>);
+// [ 2] bool operator!=(static_allocator<T1,M>, static_allocator<T2,M>);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] TRAITS AND 'bsl::allocator_traits' INTEROPERATION
+// [ 5] USE WITH CONTAINERS
+// [ 6] USAGE EXAMPLE
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACROS
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool b, const char *s, int i)
+{
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL HELPER CLASSES FOR TESTING
+//-----------------------------------------------------------------------------
+
+namespace {
+
+                            // ===================
+                            // class PoolMechanism
+                            // ===================
+
+class PoolMechanism {
+    // This concrete mechanism, *not* derived from 'bslma::Allocator', obtains
+    // memory from a 'bslma::TestAllocator' and counts the calls made to its
+    // (non-virtual) 'allocate' and 'deallocate' methods.
+
+    // DATA
+    bslma::TestAllocator *d_allocator_p;       // supplies memory
+    int                   d_numAllocations;    // calls to 'allocate'
+    int                   d_numDeallocations;  // calls to 'deallocate'
+
+  public:
+    // CREATORS
+    explicit PoolMechanism(bslma::TestAllocator *allocator)
+    : d_allocator_p(allocator)
+    , d_numAllocations(0)
+    , d_numDeallocations(0)
+    {
+    }
+
+    // MANIPULATORS
+    void *allocate(std::size_t size)
+    {
+        ++d_numAllocations;
+        return d_allocator_p->allocate(size);
+    }
+
+    void deallocate(void *address)
+    {
+        ++d_numDeallocations;
+        d_allocator_p->deallocate(address);
+    }
+
+    // ACCESSORS
+    int numAllocations() const   { return d_numAllocations; }
+    int numDeallocations() const { return d_numDeallocations; }
+};
+
+                          // =======================
+                          // class CountingAllocator
+                          // =======================
+
+class CountingAllocator : public bslma::Allocator {
+    // This concrete 'bslma::Allocator' obtains memory from a
+    // 'bslma::TestAllocator' and counts the calls made to its 'allocate' and
+    // 'deallocate' methods.
+
+    // DATA
+    bslma::TestAllocator *d_allocator_p;       // supplies memory
+    int                   d_numAllocations;    // calls to 'allocate'
+    int                   d_numDeallocations;  // calls to 'deallocate'
+
+  public:
+    // CREATORS
+    explicit CountingAllocator(bslma::TestAllocator *allocator)
+    : d_allocator_p(allocator)
+    , d_numAllocations(0)
+    , d_numDeallocations(0)
+    {
+    }
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size)
+    {
+        ++d_numAllocations;
+        return d_allocator_p->allocate(size);
+    }
+
+    virtual void deallocate(void *address)
+    {
+        ++d_numDeallocations;
+        d_allocator_p->deallocate(address);
+    }
+
+    // ACCESSORS
+    int numAllocations() const   { return d_numAllocations; }
+    int numDeallocations() const { return d_numDeallocations; }
+};
+
+                            // =================
+                            // class AllocClient
+                            // =================
+
+class AllocClient {
+    // This class records the 'bslma::Allocator' (if any) supplied at
+    // construction.
+
+    // DATA
+    bslma::Allocator *d_allocator_p;  // supplied allocator, or 0
+    int               d_value;        // arbitrary value
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(AllocClient, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit AllocClient(int value, bslma::Allocator *basicAllocator = 0)
+    : d_allocator_p(basicAllocator)
+    , d_value(value)
+    {
+    }
+
+    AllocClient(const AllocClient&  original,
+                bslma::Allocator   *basicAllocator = 0)
+    : d_allocator_p(basicAllocator)
+    , d_value(original.d_value)
+    {
+    }
+
+    // ACCESSORS
+    bslma::Allocator *allocator() const { return d_allocator_p; }
+    int value() const                   { return d_value; }
+};
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                            USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Binding a Map to a Concrete Allocator
+/// - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we have a concrete allocator class, 'my_CountingAllocator',
+// derived from 'bslma::Allocator', whose 'allocate' method we would like to be
+// invoked without virtual dispatch.
+//
+// First, we define the allocator:
+//..
+    class my_CountingAllocator : public bslma::Allocator {
+        // This concrete allocator counts the number of allocations.
+
+        // DATA
+        int d_numAllocations;  // number of blocks allocated
+
+      public:
+        // CREATORS
+        my_CountingAllocator() : d_numAllocations(0) {}
+
+        // MANIPULATORS
+        virtual void *allocate(size_type size)
+        {
+            ++d_numAllocations;
+            return ::operator new(size);
+        }
+
+        virtual void deallocate(void *address)
+        {
+            ::operator delete(address);
+        }
+
+        // ACCESSORS
+        int numAllocations() const { return d_numAllocations; }
+    };
+//..
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+    bool veryVeryVeryVerbose = argc > 5;
+
+    (void) veryVerbose;
+    (void) veryVeryVerbose;
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    setbuf(stdout, NULL);    // Use unbuffered output
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Then, we define a map type that is statically bound to
+// 'my_CountingAllocator':
+//..
+    typedef bsl::static_allocator<bsl::pair<const int, bsl::string>,
+                                  my_CountingAllocator>    MapAllocator;
+    typedef bsl::map<int, bsl::string, std::less<int>, MapAllocator> Map;
+//..
+// Next, we create an allocator and a map that uses it:
+//..
+    my_CountingAllocator countingAllocator;
+    Map                  map(&countingAllocator);
+//..
+// Now, we insert an element having a string value long enough to require
+// allocation:
+//..
+    map[1] = "a string that is too long for the short-string buffer";
+//..
+// Finally, we observe that the allocator supplied memory to the map (through
+// statically bound calls), and also to the 'bsl::string' element (which has
+// the 'bslma::UsesBslmaAllocator' trait) through the 'bslma::Allocator'
+// protocol:
+//..
+    ASSERT(0 < countingAllocator.numAllocations());
+    ASSERT(&countingAllocator == map[1].get_allocator().mechanism());
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // USE WITH CONTAINERS
+        //
+        // Concerns:
+        //: 1 A 'static_allocator' can be used to instantiate node-based
+        //:   containers, and all of their memory is obtained from (and
+        //:   returned to) the mechanism.
+        //:
+        //: 2 If the mechanism is derived from 'bslma::Allocator', elements
+        //:   having the 'bslma::UsesBslmaAllocator' trait are supplied the
+        //:   mechanism; otherwise they are constructed without an allocator.
+        //:
+        //: 3 A copy-constructed container uses the allocator of the original.
+        //:
+        //: 4 No memory is obtained from the default allocator.
+        //
+        // Plan:
+        //: 1 Instantiate 'bsl::list', 'bsl::map', and 'bsl::unordered_map'
+        //:   with 'static_allocator' over both 'PoolMechanism' and
+        //:   'CountingAllocator', insert elements, and verify the counts of
+        //:   the mechanism and the allocator of each element.  Verify that
+        //:   all memory is returned when the containers are destroyed.
+        //:   (C-1..4)
+        //
+        // Testing:
+        //   USE WITH CONTAINERS
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSE WITH CONTAINERS"
+                            "\n===================\n");
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        const int NUM_ELEMENTS = 20;
+
+        if (verbose) printf("\t'bsl::list' with 'CountingAllocator'.\n");
+        {
+            bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+            CountingAllocator    mX(&ta);
+
+            typedef bsl::static_allocator<AllocClient, CountingAllocator> A;
+
+            {
+                bsl::list<AllocClient, A> mL(&mX);
+
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mL.push_back(AllocClient(i));
+                }
+                ASSERTV(mX.numAllocations(), 0 < mX.numAllocations());
+
+                int i = 0;
+                for (bsl::list<AllocClient, A>::const_iterator it =
+                                                                    mL.begin();
+                     it != mL.end();
+                     ++it, ++i) {
+                    ASSERTV(i, it->value(), i == it->value());
+                    ASSERTV(i, &mX == it->allocator());
+                }
+
+                bsl::list<AllocClient, A> mM(mL);
+                ASSERT(&mX == mM.get_allocator().mechanism());
+                ASSERT(&mX == mM.front().allocator());
+            }
+            ASSERTV(mX.numAllocations(), mX.numDeallocations(),
+                    mX.numAllocations() == mX.numDeallocations());
+            ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) printf("\t'bsl::list' with 'PoolMechanism'.\n");
+        {
+            bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+            PoolMechanism        mX(&ta);
+
+            typedef bsl::static_allocator<AllocClient, PoolMechanism> A;
+
+            {
+                bsl::list<AllocClient, A> mL(&mX);
+
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mL.push_back(AllocClient(i));
+                }
+                ASSERTV(mX.numAllocations(), 0 < mX.numAllocations());
+
+                for (bsl::list<AllocClient, A>::const_iterator it =
+                                                                    mL.begin();
+                     it != mL.end();
+                     ++it) {
+                    ASSERT(0 == it->allocator());
+                }
+            }
+            ASSERTV(mX.numAllocations(), mX.numDeallocations(),
+                    mX.numAllocations() == mX.numDeallocations());
+            ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) printf("\t'bsl::map' with 'CountingAllocator'.\n");
+        {
+            bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+            CountingAllocator    mX(&ta);
+
+            typedef bsl::pair<const int, bsl::string>            Value;
+            typedef bsl::static_allocator<Value, CountingAllocator> A;
+            typedef bsl::map<int, bsl::string, std::less<int>, A> Obj;
+
+            {
+                Obj mM(&mX);
+
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mM[i] = "a string that is too long for the short buffer";
+                }
+
+                for (Obj::const_iterator it = mM.begin();
+                     it != mM.end();
+                     ++it) {
+                    ASSERTV(it->first,
+                            &mX == it->second.get_allocator().mechanism());
+                }
+
+                Obj mN(mM);
+                ASSERT(&mX == mN.get_allocator().mechanism());
+                ASSERT(&mX == mN[0].get_allocator().mechanism());
+            }
+            ASSERTV(mX.numAllocations(), mX.numDeallocations(),
+                    mX.numAllocations() == mX.numDeallocations());
+            ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) printf("\t'bsl::unordered_map' with 'PoolMechanism'.\n");
+        {
+            bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+            PoolMechanism        mX(&ta);
+
+            typedef bsl::pair<const int, int>                Value;
+            typedef bsl::static_allocator<Value, PoolMechanism> A;
+            typedef bsl::unordered_map<int,
+                                       int,
+                                       bsl::hash<int>,
+                                       bsl::equal_to<int>,
+                                       A>                     Obj;
+
+            {
+                Obj mM(&mX);
+
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mM[i] = i * i;
+                }
+                ASSERTV(mM.size(),
+                        NUM_ELEMENTS == static_cast<int>(mM.size()));
+                ASSERTV(mX.numAllocations(), 0 < mX.numAllocations());
+
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    ASSERTV(i, i * i == mM[i]);
+                }
+            }
+            ASSERTV(mX.numAllocations(), mX.numDeallocations(),
+                    mX.numAllocations() == mX.numDeallocations());
+            ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        }
+
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TRAITS AND 'bsl::allocator_traits' INTEROPERATION
+        //
+        // Concerns:
+        //: 1 'static_allocator' is trivially copyable and bitwise moveable.
+        //:
+        //: 2 'static_allocator' has the 'bslstl::SuppliesBslmaAllocator'
+        //:   trait if and only if 'MECHANISM' is derived from
+        //:   'bslma::Allocator'.
+        //:
+        //: 3 'bsl::allocator_traits::construct' passes the mechanism to a
+        //:   type having the 'bslma::UsesBslmaAllocator' trait if and only if
+        //:   the mechanism is derived from 'bslma::Allocator'.
+        //:
+        //: 4 'allocator_traits::rebind_traits' yields a 'static_allocator'
+        //:   bound to the same 'MECHANISM' type.
+        //
+        // Plan:
+        //: 1 Check the traits directly.  (C-1..2, 4)
+        //:
+        //: 2 Construct 'AllocClient' objects using 'allocator_traits' for
+        //:   each of the mechanism types, and verify the allocator recorded
+        //:   by each object.  (C-3)
+        //
+        // Testing:
+        //   TRAITS AND 'bsl::allocator_traits' INTEROPERATION
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTRAITS AND 'bsl::allocator_traits' INTEROP"
+                            "\n==========================================\n");
+
+        typedef bsl::static_allocator<int, PoolMechanism>     PA;
+        typedef bsl::static_allocator<int, CountingAllocator> CA;
+
+        ASSERT((bsl::is_trivially_copyable<PA>::value));
+        ASSERT((bsl::is_trivially_copyable<CA>::value));
+        ASSERT((bslmf::IsBitwiseMoveable<PA>::value));
+        ASSERT((bslmf::IsBitwiseMoveable<CA>::value));
+
+        ASSERT(!(bslstl::SuppliesBslmaAllocator<PA>::value));
+        ASSERT( (bslstl::SuppliesBslmaAllocator<CA>::value));
+
+        ASSERT((bsl::is_same<bsl::static_allocator<char, PoolMechanism>,
+                             bsl::allocator_traits<PA>::rebind_traits<char>::
+                                                    allocator_type>::value));
+        ASSERT((bsl::is_same<bsl::static_allocator<char, CountingAllocator>,
+                             bsl::allocator_traits<CA>::rebind_traits<char>::
+                                                    allocator_type>::value));
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        if (verbose) printf("\tMechanism not derived from 'bslma'.\n");
+        {
+            typedef bsl::static_allocator<AllocClient, PoolMechanism> A;
+            typedef bsl::allocator_traits<A>                          Traits;
+
+            PoolMechanism mX(&ta);
+            A             a(&mX);
+
+            AllocClient *p = Traits::allocate(a, 1);
+            ASSERTV(mX.numAllocations(), 1 == mX.numAllocations());
+
+            Traits::construct(a, p, 7);
+            ASSERTV(p->value(), 7 == p->value());
+            ASSERT(0 == p->allocator());
+
+            Traits::destroy(a, p);
+            Traits::deallocate(a, p, 1);
+            ASSERTV(mX.numDeallocations(), 1 == mX.numDeallocations());
+        }
+
+        if (verbose) printf("\tMechanism derived from 'bslma'.\n");
+        {
+            typedef bsl::static_allocator<AllocClient, CountingAllocator> A;
+            typedef bsl::allocator_traits<A>                          Traits;
+
+            CountingAllocator mX(&ta);
+            A                 a(&mX);
+
+            AllocClient *p = Traits::allocate(a, 1);
+            ASSERTV(mX.numAllocations(), 1 == mX.numAllocations());
+
+            Traits::construct(a, p, 7);
+            ASSERTV(p->value(), 7 == p->value());
+            ASSERT(&mX == p->allocator());
+
+            // A copy-constructed container uses a copy of the allocator.
+
+            A b = Traits::select_on_container_copy_construction(a);
+            ASSERT(a == b);
+
+            Traits::destroy(a, p);
+            Traits::deallocate(a, p, 1);
+            ASSERTV(mX.numDeallocations(), 1 == mX.numDeallocations());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // MANIPULATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 'allocate' obtains 'n * sizeof(TYPE)' bytes from the mechanism.
+        //:
+        //: 2 'deallocate' returns the memory to the mechanism.
+        //:
+        //: 3 'construct' and 'destroy' do not allocate or deallocate memory.
+        //:
+        //: 4 'address' returns the address of its argument.
+        //:
+        //: 5 'max_size' returns the maximum number of 'TYPE' objects that
+        //:   can be represented.
+        //
+        // Plan:
+        //: 1 Allocate, construct, destroy, and deallocate objects through a
+        //:   'static_allocator' bound to a 'CountingAllocator', and verify the
+        //:   counts of the mechanism and of the underlying test allocator.
+        //:   (C-1..4)
+        //:
+        //: 2 Compare 'max_size' to the expected value.  (C-5)
+        //
+        // Testing:
+        //   pointer allocate(size_type n, const void *hint = 0);
+        //   void deallocate(pointer p, size_type n = 1);
+        //   void construct(pointer p, const TYPE& val);
+        //   void destroy(pointer p);
+        //   pointer address(reference x) const;
+        //   const_pointer address(const_reference x) const;
+        //   size_type max_size() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nMANIPULATORS AND ACCESSORS"
+                            "\n==========================\n");
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        CountingAllocator    mX(&ta);
+
+        typedef bsl::static_allocator<double, CountingAllocator> Obj;
+
+        Obj mA(&mX);  const Obj& A = mA;
+
+        for (int n = 1; n <= 8; ++n) {
+            Obj::pointer p = mA.allocate(n);
+            ASSERTV(n, mX.numAllocations(), n == mX.numAllocations());
+            ASSERTV(n, ta.lastAllocatedNumBytes(),
+                    n * sizeof(double) == ta.lastAllocatedNumBytes());
+
+            for (int i = 0; i < n; ++i) {
+                mA.construct(p + i, i * 1.5);
+            }
+            ASSERTV(n, ta.numBlocksInUse(), 1 == ta.numBlocksInUse());
+
+            for (int i = 0; i < n; ++i) {
+                ASSERTV(n, i, i * 1.5 == p[i]);
+                ASSERT(p + i == A.address(p[i]));
+                ASSERT(p + i == A.address(static_cast<const double&>(p[i])));
+                mA.destroy(p + i);
+            }
+
+            mA.deallocate(p, n);
+            ASSERTV(n, mX.numDeallocations(), n == mX.numDeallocations());
+            ASSERTV(n, ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        }
+
+        ASSERT(~std::size_t(0) / sizeof(double) == A.max_size());
+
+        bsl::static_allocator<char, CountingAllocator> mC(A);
+        ASSERT(~std::size_t(0) == mC.max_size());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS, 'mechanism', AND EQUALITY OPERATORS
+        //
+        // Concerns:
+        //: 1 The constructor taking a 'MECHANISM *' is implicit and records
+        //:   the mechanism.
+        //:
+        //: 2 The copy constructor and the converting constructor preserve the
+        //:   mechanism.
+        //:
+        //: 3 Two allocators compare equal if and only if they have the same
+        //:   mechanism, irrespective of their value types.
+        //:
+        //: 4 Constructing with a null mechanism is detected in appropriate
+        //:   build modes.
+        //
+        // Plan:
+        //: 1 Create allocators from two mechanisms, copy and convert them, and
+        //:   verify 'mechanism' and the equality operators.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a null mechanism.  (C-4)
+        //
+        // Testing:
+        //   static_allocator(MECHANISM *mechanism);
+        //   static_allocator(const static_allocator& original);
+        //   static_allocator(const static_allocator<U, MECHANISM>& original);
+        //   MECHANISM *mechanism() const;
+        //   bool operator==(static_allocator<T1,M>, static_allocator<T2,M>);
+        //   bool operator!=(static_allocator<T1,M>, static_allocator<T2,M>);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf(
+                         "\nCREATORS, 'mechanism', AND EQUALITY OPERATORS"
+                         "\n=============================================\n");
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        PoolMechanism        mX(&ta);
+        PoolMechanism        mY(&ta);
+
+        typedef bsl::static_allocator<int,  PoolMechanism> IntAlloc;
+        typedef bsl::static_allocator<char, PoolMechanism> CharAlloc;
+
+        const IntAlloc  A = &mX;
+        const IntAlloc  B(&mY);
+        const IntAlloc  C(A);
+        const CharAlloc D(A);
+        const CharAlloc E(B);
+
+        ASSERT(&mX == A.mechanism());
+        ASSERT(&mY == B.mechanism());
+        ASSERT(&mX == C.mechanism());
+        ASSERT(&mX == D.mechanism());
+        ASSERT(&mY == E.mechanism());
+
+        ASSERT(  A == C );    ASSERT(!(A != C));
+        ASSERT(!(A == B));    ASSERT(  A != B );
+        ASSERT(  A == D );    ASSERT(!(A != D));
+        ASSERT(!(D == E));    ASSERT(  D != E );
+        ASSERT(  E == B );    ASSERT(!(E != B));
+
+        IntAlloc mF(B);
+        mF = A;
+        ASSERT(&mX == mF.mechanism());
+
+        ASSERT(0 == mX.numAllocations());
+        ASSERT(0 == ta.numBlocksTotal());
+
+        if (verbose) printf("\tNegative Testing.\n");
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            PoolMechanism *nullMechanism = 0;
+            (void)nullMechanism;
+
+            ASSERT_SAFE_PASS((IntAlloc(&mX)));
+            ASSERT_SAFE_FAIL((IntAlloc(nullMechanism)));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate memory through a 'static_allocator'
+        //:   bound to each of the two mechanism types.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        {
+            PoolMechanism                             mX(&ta);
+            bsl::static_allocator<int, PoolMechanism> mA(&mX);
+
+            int *p = mA.allocate(4);
+            ASSERT(p);
+            ASSERT(1 == mX.numAllocations());
+            ASSERT(1 == ta.numBlocksInUse());
+
+            mA.deallocate(p, 4);
+            ASSERT(1 == mX.numDeallocations());
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        {
+            CountingAllocator                             mX(&ta);
+            bsl::static_allocator<int, CountingAllocator> mA(&mX);
+
+            int *p = mA.allocate(4);
+            ASSERT(p);
+            ASSERT(1 == mX.numAllocations());
+            ASSERT(1 == ta.numBlocksInUse());
+
+            mA.deallocate(p, 4);
+            ASSERT(1 == mX.numDeallocations());
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -1207,6 +1207,15 @@ class basic_string
         // at the specified 'position' with the string represented by the
         // specified 'first' and 'last' iterators.
 
+    bool privateGrowInPlace(size_type newCapacity);
+        // Attempt to extend the allocated buffer of this object in place to
+        // hold the specified 'newCapacity' characters (not counting the
+        // null-terminating character), and update the capacity of this object
+        // accordingly.  Return 'true' on success, and 'false' (with no
+        // effect) otherwise.  The behavior is undefined unless
+        // 'capacity() < newCapacity <= max_size()'.  Note that a string using
+        // the short string buffer cannot be grown in place.
+
     void privateReserveRaw(size_type newCapacity);
         // Update the capacity of this object to be a value greater than or
         // equal to the specified 'newCapacity'.  The behavior is undefined
@@ -1222,14 +1231,16 @@ class basic_string
         // 'newCapacity'.  Upon reallocation, copy the first specified
         // 'numChars' from the previous buffer to the new buffer, and load
         // 'storage' with the new capacity.  If '*storage >= newCapacity', this
-        // method has no effect.  Return the new buffer if reallocation, and 0
-        // otherwise.  The behavior is undefined unless 'numChars <= length()'
-        // and 'newCapacity <= max_size()'.  Note that a null-terminating
-        // character is not counted in '*storage' nor 'newCapacity'.  Also note
-        // that the previous buffer is *not* deallocated, nor is the string
-        // representation changed (in case the previous buffer may contain data
-        // that must be copied): it is the responsibility of the caller to do
-        // so upon reallocation.
+        // method has no effect.  If the current buffer can be grown in place
+        // (see 'privateGrowInPlace'), do so, and load the new capacity into
+        // 'storage' without reallocating.  Return the new buffer if
+        // reallocation, and 0 otherwise.  The behavior is undefined unless
+        // 'numChars <= length()' and 'newCapacity <= max_size()'.  Note that a
+        // null-terminating character is not counted in '*storage' nor
+        // 'newCapacity'.  Also note that the previous buffer is *not*
+        // deallocated, nor is the string representation changed (in case the
+        // previous buffer may contain data that must be copied): it is the
+        // responsibility of the caller to do so upon reallocation.
 
     basic_string& privateResizeRaw(size_type newLength, CHAR_TYPE character);
         // Change the length of this string to the specified 'newLength'.  If
@@ -3181,6 +3192,27 @@ basic_string<CHAR_TYPE,CHAR_TRAITS,ALLOCATOR>::privateReplace(
                           std::forward_iterator_tag());
 }
 
+template <class CHAR_TYPE, class CHAR_TRAITS, class ALLOCATOR>
+inline
+bool basic_string<CHAR_TYPE,CHAR_TRAITS,ALLOCATOR>::privateGrowInPlace(
+                                                         size_type newCapacity)
+{
+    BSLS_ASSERT_SAFE(this->d_capacity < newCapacity);
+    BSLS_ASSERT_SAFE(newCapacity <= max_size());
+
+    if (this->isShortString()) {
+        return false;                                                 // RETURN
+    }
+
+    if (this->expandN(this->d_start_p,
+                      this->d_capacity + 1,
+                      newCapacity + 1)) {
+        this->d_capacity = newCapacity;
+        return true;                                                  // RETURN
+    }
+    return false;
+}
+
 template <class CHAR_TYPE, class CHAR_TRAITS, class ALLOCATOR>
 void basic_string<CHAR_TYPE,CHAR_TRAITS,ALLOCATOR>::privateReserveRaw(
                                                          size_type newCapacity)
@@ -3191,6 +3223,10 @@ void basic_string<CHAR_TYPE,CHAR_TRAITS,ALLOCATOR>::privateReserveRaw(
         size_type newStorage = this->computeNewCapacity(newCapacity,
                                                         this->d_capacity,
                                                         max_size());
+        if (privateGrowInPlace(newStorage)) {
+            return;                                                   // RETURN
+        }
+
         CHAR_TYPE *newBuffer = privateAllocate(newStorage);
 
         CHAR_TRAITS::copy(newBuffer, this->dataPtr(), this->d_length + 1);
@@ -3221,6 +3257,10 @@ basic_string<CHAR_TYPE,CHAR_TRAITS,ALLOCATOR>::privateReserveRaw(
                                         *storage,
                                         max_size());
 
+    if (*storage > this->d_capacity && privateGrowInPlace(*storage)) {
+        return 0;                                                     // RETURN
+    }
+
     CHAR_TYPE *newBuffer = privateAllocate(*storage);
 
     CHAR_TRAITS::copy(newBuffer, this->dataPtr(), numChars);
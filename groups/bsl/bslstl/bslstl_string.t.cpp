@@ -254,6 +254,7 @@ using namespace std;
 // [ 1] BREATHING TEST
 // [11] ALLOCATOR-RELATED CONCERNS
 // [25] CONCERN: 'std::length_error' is used properly
+// [30] CONCERN: growth is in place if the allocator supports it
 //
 // TEST APPARATUS: GENERATOR FUNCTIONS
 // [ 3] int ggg(string *object, const char *spec, int vF = 1);
@@ -13705,6 +13706,91 @@ void TestDriver<TYPE,TRAITS,ALLOC>::testCaseM1(const int /* NITER */,
     // F3) FIND_FIRST_NOT_OF AND FIND_LAST_NOT_OF OPERATIONS
 }
 
+                          // ====================
+                          // class ArenaAllocator
+                          // ====================
+
+class ArenaAllocator : public bslma::Allocator {
+    // This test allocator dispenses maximally-aligned memory sequentially
+    // from a fixed-size internal buffer, never reuses deallocated memory, and
+    // supports in-place expansion (via 'expandSized') of the most recently
+    // allocated block, as a sequential arena would.
+
+    // PRIVATE TYPES
+    enum { k_BUFFER_SIZE = 8192 };
+
+    typedef bsls::AlignmentUtil::MaxAlignedType MaxAlignedType;
+
+    // DATA
+    MaxAlignedType d_buffer[k_BUFFER_SIZE / sizeof(MaxAlignedType)];
+    size_type      d_cursor;          // offset of the first free byte
+    int            d_numAllocations;  // number of blocks allocated
+    int            d_numExpansions;   // number of successful expansions
+
+  private:
+    // PRIVATE ACCESSORS
+    char *base() const
+        // Return the address of the internal buffer.
+    {
+        return reinterpret_cast<char *>(
+                                    const_cast<MaxAlignedType *>(d_buffer));
+    }
+
+  public:
+    // CREATORS
+    ArenaAllocator()
+    : d_cursor(0)
+    , d_numAllocations(0)
+    , d_numExpansions(0)
+    {
+    }
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size)
+    {
+        if (0 == size) {
+            return 0;                                                 // RETURN
+        }
+
+        const size_type offset =
+                     bsls::AlignmentUtil::roundUpToMaximalAlignment(d_cursor);
+        BSLS_ASSERT_OPT(offset + size <= k_BUFFER_SIZE);
+
+        d_cursor = offset + size;
+        ++d_numAllocations;
+        return base() + offset;
+    }
+
+    virtual void deallocate(void *)
+    {
+    }
+
+    virtual bool expandSized(void *address, size_type size, size_type newSize)
+    {
+        if (static_cast<char *>(address) + size != base() + d_cursor
+         || newSize - size > k_BUFFER_SIZE - d_cursor) {
+            return false;                                             // RETURN
+        }
+
+        d_cursor += newSize - size;
+        ++d_numExpansions;
+        return true;
+    }
+
+    // ACCESSORS
+    int numAllocations() const
+        // Return the number of blocks allocated from this allocator.
+    {
+        return d_numAllocations;
+    }
+
+    int numExpansions() const
+        // Return the number of blocks successfully expanded in place.
+    {
+        return d_numExpansions;
+    }
+};
+
 //=============================================================================
 //                                USAGE EXAMPLE
 //-----------------------------------------------------------------------------
@@ -14080,7 +14166,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 30: {
+      case 31: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -14292,6 +14378,89 @@ int main(int argc, char *argv[])
             }
         }
       } break;
+      case 30: {
+        // --------------------------------------------------------------------
+        // TESTING IN-PLACE GROWTH
+        //
+        // Concerns:
+        //: 1 A string whose (non-short) buffer is the most recent allocation
+        //:   from an allocator supporting 'expandSized' grows without
+        //:   reallocating, whether through 'append', 'insert', or 'reserve'.
+        //:
+        //: 2 The value of the string is preserved by in-place growth.
+        //:
+        //: 3 A string whose buffer is not the most recent allocation falls
+        //:   back to reallocation, preserving its value.
+        //
+        // Plan:
+        //: 1 Using an 'ArenaAllocator', grow a string (for both 'char' and
+        //:   'wchar_t') beyond the short string buffer, then by repeated
+        //:   'push_back', 'insert' at the front and 'reserve', and verify that
+        //:   its 'data' address is unchanged, and that it has the expected
+        //:   value.  (C-1..2)
+        //:
+        //: 2 Allocate a second string from the same allocator, grow the first
+        //:   string beyond its capacity, and verify that it was reallocated
+        //:   and has the expected value.  (C-3)
+        //
+        // Testing:
+        //   CONCERN: growth is in place if the allocator supports it
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING IN-PLACE GROWTH"
+                            "\n=======================\n");
+
+        if (verbose) printf("\n... with 'char'.\n");
+        {
+            ArenaAllocator oa;
+
+            bsl::string mX(40, 'x', &oa);  const bsl::string& X = mX;
+            const char *DATA = X.data();
+            LOOP_ASSERT(oa.numAllocations(), 1 == oa.numAllocations());
+
+            for (int i = 0; i < 200; ++i) {
+                mX.push_back('y');
+                LOOP_ASSERT(i, DATA == X.data());
+            }
+            LOOP_ASSERT(oa.numExpansions(), 0 < oa.numExpansions());
+
+            mX.append(X.capacity() - X.length(), 'y');
+            mX.insert(0, "abc");
+            ASSERT(DATA == X.data());
+
+            mX.reserve(X.capacity() + 100);
+            ASSERT(DATA == X.data());
+            LOOP_ASSERT(oa.numAllocations(), 1 == oa.numAllocations());
+
+            const bsl::string::size_type LENGTH = X.length();
+            ASSERT(bsl::string("abc") + bsl::string(40, 'x') +
+                   bsl::string(LENGTH - 43, 'y') == X);
+
+            bsl::string mY(40, 'z', &oa);  const bsl::string& Y = mY;
+
+            mX.append(X.capacity() - X.length() + 1, 'y');
+            ASSERT(DATA != X.data());
+            LOOP_ASSERT(oa.numAllocations(), 3 == oa.numAllocations());
+            ASSERT(bsl::string("abc") + bsl::string(40, 'x') +
+                   bsl::string(X.length() - 43, 'y') == X);
+            ASSERT(bsl::string(40, 'z') == Y);
+        }
+
+        if (verbose) printf("\n... with 'wchar_t'.\n");
+        {
+            ArenaAllocator oa;
+
+            bsl::wstring mX(40, L'x', &oa);  const bsl::wstring& X = mX;
+            const wchar_t *DATA = X.data();
+
+            for (int i = 0; i < 200; ++i) {
+                mX.push_back(L'y');
+                LOOP_ASSERT(i, DATA == X.data());
+            }
+            LOOP_ASSERT(oa.numAllocations(), 1 == oa.numAllocations());
+            ASSERT(bsl::wstring(40, L'x') + bsl::wstring(200, L'y') == X);
+        }
+      } break;
       case 29: {
         // --------------------------------------------------------------------
         // TESTING 'hashAppend'
@@ -908,6 +908,16 @@ class Vector_Imp : public Vector_ImpBase<VALUE_TYPE>
         // duplicate copies after importing from an input iterator into a
         // temporary vector.
 
+    bool privateGrowInPlace(size_type newSize);
+        // Attempt to extend the storage of this vector in place, without
+        // moving its elements, to the capacity that the growth policy of this
+        // vector would choose for the specified 'newSize'.  Return 'true' on
+        // success, and 'false' (with no effect) otherwise.  The behavior is
+        // undefined unless 'capacity() < newSize <= max_size()'.  Note that
+        // only allocators overriding 'bslma::Allocator::expandSized' (e.g.,
+        // sequential arenas) can succeed, and only for the most recently
+        // allocated block.
+
     void privateReserveEmpty(size_type numElements);
         // Reserve exactly the specified 'numElements'.  The behavior is
         // undefined unless this vector is empty and has no capacity.
@@ -2336,7 +2346,7 @@ void Vector_Imp<VALUE_TYPE, ALLOCATOR>::privateInsert(
     }
 
     const size_type newSize = this->size() + n;
-    if (newSize > this->d_capacity) {
+    if (newSize > this->d_capacity && !privateGrowInPlace(newSize)) {
         size_type newCapacity = Vector_Util::computeNewCapacity(
                                                               newSize,
                                                               this->d_capacity,
@@ -2384,7 +2394,7 @@ void Vector_Imp<VALUE_TYPE, ALLOCATOR>::privateMoveInsert(
     }
 
     const size_type newSize = this->size() + n;
-    if (newSize > this->d_capacity) {
+    if (newSize > this->d_capacity && !privateGrowInPlace(newSize)) {
         const size_type newCapacity = Vector_Util::computeNewCapacity(
                                                               newSize,
                                                               this->d_capacity,
@@ -2419,6 +2429,27 @@ void Vector_Imp<VALUE_TYPE, ALLOCATOR>::privateMoveInsert(
     }
 }
 
+template <class VALUE_TYPE, class ALLOCATOR>
+inline
+bool Vector_Imp<VALUE_TYPE, ALLOCATOR>::privateGrowInPlace(size_type newSize)
+{
+    BSLS_ASSERT_SAFE(this->d_capacity < newSize);
+
+    if (0 == this->d_capacity) {
+        return false;                                                 // RETURN
+    }
+
+    const size_type newCapacity = Vector_Util::computeNewCapacity(
+                                                              newSize,
+                                                              this->d_capacity,
+                                                              max_size());
+    if (this->expandN(this->d_dataBegin, this->d_capacity, newCapacity)) {
+        this->d_capacity = newCapacity;
+        return true;                                                  // RETURN
+    }
+    return false;
+}
+
 template <class VALUE_TYPE, class ALLOCATOR>
 inline
 void Vector_Imp<VALUE_TYPE, ALLOCATOR>::privateReserveEmpty(
@@ -2679,6 +2710,11 @@ void Vector_Imp<VALUE_TYPE, ALLOCATOR>::reserve(size_type newCapacity)
         privateReserveEmpty(newCapacity);
     }
     else if (this->d_capacity < newCapacity) {
+        if (this->expandN(this->d_dataBegin, this->d_capacity, newCapacity)) {
+            this->d_capacity = newCapacity;
+            return;                                                   // RETURN
+        }
+
         Vector_Imp temp(this->get_allocator());
         temp.privateReserveEmpty(newCapacity);
 
@@ -2976,7 +3012,7 @@ VALUE_TYPE* Vector_Imp<VALUE_TYPE, ALLOCATOR>::emplace(const_iterator position,
     }
 
     const size_type newSize = this->size() + 1;
-    if (newSize > this->d_capacity) {
+    if (newSize > this->d_capacity && !privateGrowInPlace(newSize)) {
         size_type newCapacity = Vector_Util::computeNewCapacity(
                                                               newSize,
                                                               this->d_capacity,
@@ -3056,7 +3092,7 @@ VALUE_TYPE* Vector_Imp<VALUE_TYPE, ALLOCATOR>::emplace(const_iterator position)
     }
 
     const size_type newSize = this->size() + 1;
-    if (newSize > this->d_capacity) {
+    if (newSize > this->d_capacity && !privateGrowInPlace(newSize)) {
         size_type newCapacity = Vector_Util::computeNewCapacity(
                                                               newSize,
                                                               this->d_capacity,
@@ -3129,7 +3165,7 @@ VALUE_TYPE* Vector_Imp<VALUE_TYPE, ALLOCATOR>::emplace(const_iterator position,
     }
 
     const size_type newSize = this->size() + 1;
-    if (newSize > this->d_capacity) {
+    if (newSize > this->d_capacity && !privateGrowInPlace(newSize)) {
         size_type newCapacity = Vector_Util::computeNewCapacity(
                                                               newSize,
                                                               this->d_capacity,
@@ -3208,7 +3244,7 @@ VALUE_TYPE* Vector_Imp<VALUE_TYPE, ALLOCATOR>::emplace(const_iterator position,
     }
 
     const size_type newSize = this->size() + 1;
-    if (newSize > this->d_capacity) {
+    if (newSize > this->d_capacity && !privateGrowInPlace(newSize)) {
         size_type newCapacity = Vector_Util::computeNewCapacity(
                                                               newSize,
                                                               this->d_capacity,
@@ -3293,7 +3329,7 @@ VALUE_TYPE* Vector_Imp<VALUE_TYPE, ALLOCATOR>::emplace(const_iterator position,
     }
 
     const size_type newSize = this->size() + 1;
-    if (newSize > this->d_capacity) {
+    if (newSize > this->d_capacity && !privateGrowInPlace(newSize)) {
         size_type newCapacity = Vector_Util::computeNewCapacity(
                                                               newSize,
                                                               this->d_capacity,
@@ -3384,7 +3420,7 @@ VALUE_TYPE* Vector_Imp<VALUE_TYPE, ALLOCATOR>::emplace(const_iterator position,
     }
 
     const size_type newSize = this->size() + 1;
-    if (newSize > this->d_capacity) {
+    if (newSize > this->d_capacity && !privateGrowInPlace(newSize)) {
         size_type newCapacity = Vector_Util::computeNewCapacity(
                                                               newSize,
                                                               this->d_capacity,
@@ -3481,7 +3517,7 @@ VALUE_TYPE* Vector_Imp<VALUE_TYPE, ALLOCATOR>::emplace(const_iterator position,
     }
 
     const size_type newSize = this->size() + 1;
-    if (newSize > this->d_capacity) {
+    if (newSize > this->d_capacity && !privateGrowInPlace(newSize)) {
         size_type newCapacity = Vector_Util::computeNewCapacity(
                                                               newSize,
                                                               this->d_capacity,
@@ -3575,7 +3611,7 @@ VALUE_TYPE* Vector_Imp<VALUE_TYPE, ALLOCATOR>::emplace(const_iterator position,
     }
 
     const size_type newSize = this->size() + 1;
-    if (newSize > this->d_capacity) {
+    if (newSize > this->d_capacity && !privateGrowInPlace(newSize)) {
         size_type newCapacity = Vector_Util::computeNewCapacity(
                                                               newSize,
                                                               this->d_capacity,
@@ -3666,7 +3702,7 @@ void Vector_Imp<VALUE_TYPE, ALLOCATOR>::insert(const_iterator    position,
     }
 
     const size_type newSize = this->size() + numElements;
-    if (newSize > this->d_capacity) {
+    if (newSize > this->d_capacity && !privateGrowInPlace(newSize)) {
         size_type newCapacity = Vector_Util::computeNewCapacity(
                                                               newSize,
                                                               this->d_capacity,
@@ -153,10 +153,12 @@ using namespace bsl;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [11] ALLOCATOR-RELATED CONCERNS
-// [25] USAGE EXAMPLE
+// [29] USAGE EXAMPLE
 // [21] CONCERN: 'std::length_error' is used properly
 // [23] DRQS 31711031
 // [24] DRQS 34693876
+// [27] CONCERN: growth is in place if the allocator supports it
+// [28] CONCERN: over-aligned elements are properly aligned
 //
 // TEST APPARATUS: GENERATOR FUNCTIONS
 // [ 3] int ggg(vector<T,A> *object, const char *spec, int vF = 1);
@@ -9097,6 +9099,111 @@ void TestDriver<TYPE,ALLOC>::testCase1()
     ASSERT(  X4 == X4 );          ASSERT(!(X4 != X4));
 }
 
+                          // ====================
+                          // class ArenaAllocator
+                          // ====================
+
+class ArenaAllocator : public bslma::Allocator {
+    // This test allocator dispenses maximally-aligned memory sequentially
+    // from a fixed-size internal buffer, never reuses deallocated memory, and
+    // supports in-place expansion (via 'expandSized') of the most recently
+    // allocated block, as a sequential arena would.
+
+    // PRIVATE TYPES
+    enum { k_BUFFER_SIZE = 8192 };
+
+    typedef bsls::AlignmentUtil::MaxAlignedType MaxAlignedType;
+
+    // DATA
+    MaxAlignedType d_buffer[k_BUFFER_SIZE / sizeof(MaxAlignedType)];
+    size_type      d_cursor;          // offset of the first free byte
+    int            d_numAllocations;  // number of blocks allocated
+    int            d_numExpansions;   // number of successful expansions
+
+  private:
+    // PRIVATE ACCESSORS
+    char *base() const
+        // Return the address of the internal buffer.
+    {
+        return reinterpret_cast<char *>(
+                                    const_cast<MaxAlignedType *>(d_buffer));
+    }
+
+  public:
+    // CREATORS
+    ArenaAllocator()
+    : d_cursor(0)
+    , d_numAllocations(0)
+    , d_numExpansions(0)
+    {
+    }
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size)
+    {
+        if (0 == size) {
+            return 0;                                                 // RETURN
+        }
+
+        const size_type offset =
+                     bsls::AlignmentUtil::roundUpToMaximalAlignment(d_cursor);
+        BSLS_ASSERT_OPT(offset + size <= k_BUFFER_SIZE);
+
+        d_cursor = offset + size;
+        ++d_numAllocations;
+        return base() + offset;
+    }
+
+    virtual void deallocate(void *)
+    {
+    }
+
+    virtual bool expandSized(void *address, size_type size, size_type newSize)
+    {
+        if (static_cast<char *>(address) + size != base() + d_cursor
+         || newSize - size > k_BUFFER_SIZE - d_cursor) {
+            return false;                                             // RETURN
+        }
+
+        d_cursor += newSize - size;
+        ++d_numExpansions;
+        return true;
+    }
+
+    // ACCESSORS
+    int numAllocations() const
+        // Return the number of blocks allocated from this allocator.
+    {
+        return d_numAllocations;
+    }
+
+    int numExpansions() const
+        // Return the number of blocks successfully expanded in place.
+    {
+        return d_numExpansions;
+    }
+};
+
+                          // =====================
+                          // struct OverAlignedType
+                          // =====================
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#define TEST_ALIGNAS_64 __declspec(align(64))
+#else
+#define TEST_ALIGNAS_64 __attribute__((aligned(64)))
+#endif
+
+struct TEST_ALIGNAS_64 OverAlignedType {
+    // This 'struct' has an alignment of 64 bytes, which exceeds the maximal
+    // fundamental alignment on all supported platforms.
+
+    // DATA
+    int d_value;
+};
+
+enum { k_OVER_ALIGNMENT = 64 };
+
 //=============================================================================
 //                                USAGE EXAMPLE
 //-----------------------------------------------------------------------------
@@ -9521,7 +9628,91 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 27: {
+      case 28: {
+        // --------------------------------------------------------------------
+        // TESTING OVER-ALIGNED ELEMENTS
+        //
+        // Concerns:
+        //: 1 The storage of a vector of elements whose alignment exceeds the
+        //:   maximal fundamental alignment is suitably aligned for the element
+        //:   type, before and after reallocation.
+        //:
+        //: 2 Storage for over-aligned elements is returned to the allocator
+        //:   with the same size with which it was obtained.
+        //:
+        //: 3 Storage for over-aligned elements is never grown in place, even
+        //:   if the allocator supports 'expandSized'.
+        //
+        // Plan:
+        //: 1 Using a 'bslma::TestAllocator', grow a vector of
+        //:   'OverAlignedType' by repeated 'push_back', and verify the
+        //:   alignment of its storage and the values of its elements after
+        //:   each insertion.  Verify that, once the vector is destroyed, no
+        //:   memory is in use and no mismatches were reported.  (C-1..2)
+        //:
+        //: 2 Repeat P-1 using an 'ArenaAllocator', and verify that no block
+        //:   was expanded in place.  (C-1, 3)
+        //
+        // Testing:
+        //   CONCERN: over-aligned elements are properly aligned
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING OVER-ALIGNED ELEMENTS"
+                            "\n=============================\n");
+
+        ASSERT(static_cast<int>(bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT)
+                                                          < k_OVER_ALIGNMENT);
+
+        if (verbose) printf("\tUsing 'bslma::TestAllocator'.\n");
+        {
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+            {
+                bsl::vector<OverAlignedType> mX(&oa);
+                const bsl::vector<OverAlignedType>& X = mX;
+
+                for (int i = 0; i < 100; ++i) {
+                    OverAlignedType element;
+                    element.d_value = i;
+                    mX.push_back(element);
+
+                    const bsls::Types::UintPtr ADDRESS =
+                              reinterpret_cast<bsls::Types::UintPtr>(X.data());
+                    ASSERTV(i, 0 == ADDRESS % k_OVER_ALIGNMENT);
+
+                    for (int j = 0; j <= i; ++j) {
+                        ASSERTV(i, j, X[j].d_value, j == X[j].d_value);
+                    }
+                }
+                ASSERTV(oa.numBlocksInUse(), 1 == oa.numBlocksInUse());
+            }
+            ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+            ASSERTV(oa.numMismatches(),  0 == oa.numMismatches());
+        }
+
+        if (verbose) printf("\tUsing 'ArenaAllocator'.\n");
+        {
+            ArenaAllocator oa;
+
+            bsl::vector<OverAlignedType> mX(&oa);
+            const bsl::vector<OverAlignedType>& X = mX;
+
+            for (int i = 0; i < 30; ++i) {
+                OverAlignedType element;
+                element.d_value = i;
+                mX.push_back(element);
+
+                const bsls::Types::UintPtr ADDRESS =
+                              reinterpret_cast<bsls::Types::UintPtr>(X.data());
+                ASSERTV(i, 0 == ADDRESS % k_OVER_ALIGNMENT);
+            }
+            ASSERTV(oa.numExpansions(), 0 == oa.numExpansions());
+
+            for (int i = 0; i < 30; ++i) {
+                ASSERTV(i, X[i].d_value, i == X[i].d_value);
+            }
+        }
+      } break;
+      case 29: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -9565,6 +9756,80 @@ int main(int argc, char *argv[])
             ASSERT(4 == m1.theValue(1, 1));
         }
       } break;
+      case 27: {
+        // --------------------------------------------------------------------
+        // TESTING IN-PLACE GROWTH
+        //
+        // Concerns:
+        //: 1 A vector whose storage is the most recent allocation from an
+        //:   allocator supporting 'expandSized' grows without reallocating,
+        //:   whether through 'push_back', 'insert', or 'reserve'.
+        //:
+        //: 2 The value of the vector is preserved by in-place growth.
+        //:
+        //: 3 A vector whose storage is not the most recent allocation falls
+        //:   back to reallocation, preserving its value.
+        //
+        // Plan:
+        //: 1 Using an 'ArenaAllocator', grow a vector by repeated 'push_back',
+        //:   then by 'insert' at the front and 'reserve', and verify that its
+        //:   'data' address is unchanged, that only one block was allocated,
+        //:   and that the elements have the expected values.  (C-1..2)
+        //:
+        //: 2 Allocate a second vector from the same allocator, grow the first
+        //:   vector beyond its capacity, and verify that it was reallocated
+        //:   and has the expected value.  (C-3)
+        //
+        // Testing:
+        //   CONCERN: growth is in place if the allocator supports it
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING IN-PLACE GROWTH"
+                            "\n=======================\n");
+
+        ArenaAllocator oa;
+
+        bsl::vector<int> mX(&oa);  const bsl::vector<int>& X = mX;
+
+        mX.push_back(0);
+        const int *DATA = X.data();
+        ASSERTV(oa.numAllocations(), 1 == oa.numAllocations());
+
+        for (int i = 1; i < 100; ++i) {
+            mX.push_back(i);
+            ASSERTV(i, DATA == X.data());
+        }
+        ASSERTV(oa.numExpansions(), 0 < oa.numExpansions());
+
+        const int FRONT[] = { -3, -2, -1 };
+        while (X.size() + 3 <= X.capacity()) {
+            mX.push_back(static_cast<int>(X.size()));
+        }
+        mX.insert(mX.begin(), FRONT, FRONT + 3);
+        ASSERT(DATA == X.data());
+
+        mX.reserve(X.capacity() + 100);
+        ASSERT(DATA == X.data());
+        ASSERTV(oa.numAllocations(), 1 == oa.numAllocations());
+
+        for (int i = 0; i < static_cast<int>(X.size()); ++i) {
+            ASSERTV(i, X[i], i - 3 == X[i]);
+        }
+
+        bsl::vector<int> mY(&oa);  const bsl::vector<int>& Y = mY;
+        mY.push_back(42);
+
+        const bsl::vector<int>::size_type CAPACITY = X.capacity();
+        while (X.size() <= CAPACITY) {
+            mX.push_back(static_cast<int>(X.size()) - 3);
+        }
+        ASSERT(DATA != X.data());
+        ASSERTV(oa.numAllocations(), 3 == oa.numAllocations());
+        for (int i = 0; i < static_cast<int>(X.size()); ++i) {
+            ASSERTV(i, X[i], i - 3 == X[i]);
+        }
+        ASSERT(1 == Y.size());    ASSERT(42 == Y[0]);
+      } break;
       case 26: {
         // --------------------------------------------------------------------
         // TESTING HYMAN'S TEST CASE 2